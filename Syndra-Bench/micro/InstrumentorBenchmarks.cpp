@@ -0,0 +1,93 @@
+#include "lpch.h"
+
+#include "Engine/Core/Instrument.h"
+
+#include <benchmark/benchmark.h>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr const char* kScopeName = "MicroBench::Scope";
+
+		// Restores the runtime toggle when a benchmark ends.
+		class ScopedProfilingToggle
+		{
+		public:
+			explicit ScopedProfilingToggle(bool enabled)
+				: m_WasEnabled(Instrumentor::IsEnabled())
+			{
+				Instrumentor::SetEnabled(enabled);
+			}
+
+			~ScopedProfilingToggle()
+			{
+				Instrumentor::SetEnabled(m_WasEnabled);
+			}
+		private:
+			bool m_WasEnabled;
+		};
+
+	}
+
+	// What every SN_PROFILE_SCOPE costs in a build with profiling compiled in but switched off.
+	static void BM_Instrumentor_Scope_Disabled(benchmark::State& state)
+	{
+		ScopedProfilingToggle toggle(false);
+		for (auto _ : state)
+		{
+			InstrumentationTimer timer(kScopeName);
+			benchmark::DoNotOptimize(timer);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Instrumentor_Scope_Disabled);
+
+	// Records into the calling thread's buffer while the drain thread empties it. Scopes recorded
+	// faster than the drain thread keeps up are dropped and reported in the "dropped" counter.
+	static void BM_Instrumentor_Scope_Enabled(benchmark::State& state)
+	{
+		ScopedProfilingToggle toggle(true);
+		const uint64_t droppedBefore = Instrumentor::Get().GetDroppedScopeCount();
+		for (auto _ : state)
+		{
+			InstrumentationTimer timer(kScopeName);
+			benchmark::DoNotOptimize(timer);
+		}
+		state.SetItemsProcessed(state.iterations());
+		state.counters["dropped"] = static_cast<double>(Instrumentor::Get().GetDroppedScopeCount() - droppedBefore);
+	}
+	BENCHMARK(BM_Instrumentor_Scope_Enabled);
+
+	static void BM_Instrumentor_Scope_Nested(benchmark::State& state)
+	{
+		ScopedProfilingToggle toggle(true);
+		const int64_t depth = state.range(0);
+		for (auto _ : state)
+		{
+			auto nest = [depth](auto&& self, int64_t level) -> void
+			{
+				InstrumentationTimer timer(kScopeName);
+				if (level + 1 < depth)
+					self(self, level + 1);
+			};
+			nest(nest, 0);
+		}
+		state.SetItemsProcessed(state.iterations() * depth);
+	}
+	BENCHMARK(BM_Instrumentor_Scope_Nested)->Arg(4)->Arg(16);
+
+	// The Instrumentor's own estimate, on a private buffer without the drain thread.
+	static void BM_Instrumentor_MeasureScopeOverhead(benchmark::State& state)
+	{
+		double overheadNs = 0.0;
+		for (auto _ : state)
+		{
+			overheadNs = Instrumentor::MeasureScopeOverhead(static_cast<uint32_t>(state.range(0)));
+			benchmark::DoNotOptimize(overheadNs);
+		}
+		state.counters["scopeNs"] = overheadNs;
+	}
+	BENCHMARK(BM_Instrumentor_MeasureScopeOverhead)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+}
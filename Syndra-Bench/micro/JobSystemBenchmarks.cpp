@@ -0,0 +1,138 @@
+#include "lpch.h"
+
+#include "Engine/Core/JobSystem.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint32_t kFibonacciN = 24;
+		// Below this the recursion runs serially, so a leaf job is a few microseconds of work.
+		constexpr uint32_t kFibonacciSerialCutoff = 12;
+		constexpr uint32_t kParallelForItems = 1u << 20;
+		constexpr uint32_t kChainLength = 1024;
+
+		// Runs a benchmark on a job system with a given number of workers and restores the one the
+		// application started (if any) afterwards. 0 workers leaves it uninitialized, so every job
+		// runs inline on the calling thread: the serial baseline of the scaling runs.
+		class ScopedJobSystem
+		{
+		public:
+			explicit ScopedJobSystem(uint32_t workerCount)
+				: m_WasInitialized(JobSystem::IsInitialized()),
+				m_PreviousWorkerCount(JobSystem::IsInitialized() ? JobSystem::GetWorkerCount() : 0)
+			{
+				JobSystem::Shutdown();
+				if (workerCount > 0)
+					JobSystem::Init(workerCount);
+			}
+
+			~ScopedJobSystem()
+			{
+				JobSystem::Shutdown();
+				if (m_WasInitialized)
+					JobSystem::Init(m_PreviousWorkerCount);
+			}
+		private:
+			bool m_WasInitialized;
+			uint32_t m_PreviousWorkerCount;
+		};
+
+		// 0 (inline), then powers of two up to one worker per hardware thread besides the caller.
+		void WorkerCountArguments(benchmark::internal::Benchmark* benchmark)
+		{
+			const uint32_t maxWorkers = std::max(1u, std::thread::hardware_concurrency() - 1);
+			benchmark->ArgName("workers");
+			benchmark->Arg(0);
+			for (uint32_t workers = 1; workers < maxWorkers; workers *= 2)
+				benchmark->Arg(workers);
+			benchmark->Arg(maxWorkers);
+		}
+
+		uint64_t FibonacciSerial(uint32_t n)
+		{
+			return n < 2 ? n : FibonacciSerial(n - 1) + FibonacciSerial(n - 2);
+		}
+
+		// Every level schedules both halves and waits for them; waiting threads run other jobs.
+		uint64_t FibonacciJobs(uint32_t n, std::atomic<uint32_t>& jobCount)
+		{
+			if (n < kFibonacciSerialCutoff)
+				return FibonacciSerial(n);
+
+			uint64_t a = 0;
+			uint64_t b = 0;
+			jobCount.fetch_add(2, std::memory_order_relaxed);
+			const JobHandle first = JobSystem::Schedule("MicroBench::Fibonacci", [n, &a, &jobCount]() { a = FibonacciJobs(n - 1, jobCount); });
+			const JobHandle second = JobSystem::Schedule("MicroBench::Fibonacci", [n, &b, &jobCount]() { b = FibonacciJobs(n - 2, jobCount); });
+			JobSystem::Wait(first);
+			JobSystem::Wait(second);
+			return a + b;
+		}
+
+	}
+
+	// Recursive fan-out: nested Schedule/Wait with many small jobs in flight on every queue.
+	static void BM_JobSystem_FibonacciFanOut(benchmark::State& state)
+	{
+		ScopedJobSystem jobSystem(static_cast<uint32_t>(state.range(0)));
+		std::atomic<uint32_t> jobCount{ 0 };
+		for (auto _ : state)
+		{
+			jobCount.store(0, std::memory_order_relaxed);
+			uint64_t result = FibonacciJobs(kFibonacciN, jobCount);
+			benchmark::DoNotOptimize(result);
+		}
+		state.counters["jobs"] = static_cast<double>(jobCount.load(std::memory_order_relaxed));
+		state.SetItemsProcessed(state.iterations() * jobCount.load(std::memory_order_relaxed));
+	}
+	BENCHMARK(BM_JobSystem_FibonacciFanOut)->Apply(WorkerCountArguments)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+	// A cheap per-item kernel over 1M items with the default grain size.
+	static void BM_JobSystem_ParallelFor(benchmark::State& state)
+	{
+		ScopedJobSystem jobSystem(static_cast<uint32_t>(state.range(0)));
+		std::vector<float> input(kParallelForItems);
+		std::vector<float> output(kParallelForItems);
+		for (uint32_t i = 0; i < kParallelForItems; ++i)
+			input[i] = static_cast<float>(i);
+
+		for (auto _ : state)
+		{
+			JobSystem::ParallelFor("MicroBench::ParallelFor", kParallelForItems, 0, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; ++i)
+					output[i] = std::sqrt(input[i]) * 0.5f + 1.0f;
+			});
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * kParallelForItems);
+	}
+	BENCHMARK(BM_JobSystem_ParallelFor)->Apply(WorkerCountArguments)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+	// Each job depends on the one before it, so nothing runs in parallel: the cost is the
+	// scheduling and wake-up latency of releasing a dependent job.
+	static void BM_JobSystem_DependencyChain(benchmark::State& state)
+	{
+		ScopedJobSystem jobSystem(static_cast<uint32_t>(state.range(0)));
+		uint32_t counter = 0;
+		for (auto _ : state)
+		{
+			counter = 0;
+			JobHandle previous = JobSystem::Schedule("MicroBench::Chain", [&counter]() { ++counter; });
+			for (uint32_t i = 1; i < kChainLength; ++i)
+				previous = JobSystem::Then(previous, "MicroBench::Chain", [&counter]() { ++counter; });
+			JobSystem::Wait(previous);
+			benchmark::DoNotOptimize(counter);
+		}
+		state.SetItemsProcessed(state.iterations() * kChainLength);
+	}
+	BENCHMARK(BM_JobSystem_DependencyChain)->Apply(WorkerCountArguments)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Syndra {
+
+	// True when the suite was started with --renderer and a headless device is up. Benchmarks that
+	// upload to the GPU (model import, backend shaders) are only registered then.
+	bool HasRenderDevice();
+
+	void RegisterModelBenchmarks();
+	void RegisterDeviceShaderBenchmarks();
+
+}
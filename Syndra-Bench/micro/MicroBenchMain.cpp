@@ -0,0 +1,171 @@
+#include "lpch.h"
+#include "MicroBench.h"
+
+#include "Engine/Core/Application.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/RendererAPI.h"
+#include "Engine/Renderer/RenderThread.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cctype>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace {
+
+	constexpr const char* kDefaultOutputPath = "SyndraMicroBench.json";
+	constexpr uint32_t kDeviceWindowSize = 64;
+
+	bool s_HasRenderDevice = false;
+
+	std::optional<Syndra::RendererAPI::API> ParseRendererAPI(std::string_view value)
+	{
+		std::string normalized;
+		for (char c : value)
+			normalized.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+
+		if (normalized == "vulkan")
+			return Syndra::RendererAPI::API::Vulkan;
+		if (normalized == "opengl")
+			return Syndra::RendererAPI::API::OpenGL;
+		if (normalized == "null")
+			return Syndra::RendererAPI::API::Null;
+		return std::nullopt;
+	}
+
+	// Removes --renderer=<api> / --renderer <api> from the arguments Google Benchmark sees.
+	std::optional<std::string> TakeRendererArgument(std::vector<char*>& args)
+	{
+		std::optional<std::string> renderer;
+		for (size_t i = 1; i < args.size();)
+		{
+			std::string_view arg = args[i];
+			constexpr std::string_view prefix = "--renderer=";
+			if (arg.rfind(prefix, 0) == 0)
+			{
+				renderer = std::string(arg.substr(prefix.size()));
+				args.erase(args.begin() + i);
+			}
+			else if (arg == "--renderer" && i + 1 < args.size())
+			{
+				renderer = std::string(args[i + 1]);
+				args.erase(args.begin() + i, args.begin() + i + 2);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return renderer;
+	}
+
+	bool HasArgument(const std::vector<char*>& args, std::string_view prefix)
+	{
+		for (size_t i = 1; i < args.size(); ++i)
+		{
+			if (std::string_view(args[i]).rfind(prefix, 0) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	// Device benchmarks read the editor's models and shaders, so they run from the Syndra-Editor
+	// directory like Syndra-Bench does.
+	void ChangeToEditorDirectory()
+	{
+		namespace fs = std::filesystem;
+		if (fs::exists("assets/shaders"))
+			return;
+
+		for (fs::path cursor = fs::current_path(); !cursor.empty(); cursor = cursor.parent_path())
+		{
+			if (fs::exists(cursor / "Syndra-Editor/assets/shaders"))
+			{
+				fs::current_path(cursor / "Syndra-Editor");
+				SN_INFO("Working directory changed to '{}'.", fs::current_path().string());
+				break;
+			}
+			if (cursor == cursor.parent_path())
+				break;
+		}
+
+		std::error_code errorCode;
+		fs::create_directories("assets/cache/shader/opengl", errorCode);
+		fs::create_directories("assets/cache/shader/vulkan", errorCode);
+	}
+
+	// A headless application owns the device, the render thread and the job system the way the
+	// editor does; its Run() loop is never entered.
+	Syndra::Application* CreateRenderDevice(Syndra::RendererAPI::API api)
+	{
+		Syndra::RendererAPI::SelectAPI(api);
+		Syndra::RenderThread::SetLatency(0);
+		auto* app = new Syndra::Application(Syndra::WindowProps("Syndra MicroBench", kDeviceWindowSize, kDeviceWindowSize, true));
+		Syndra::RenderCommand::Init();
+		return app;
+	}
+
+}
+
+namespace Syndra {
+
+	bool HasRenderDevice()
+	{
+		return s_HasRenderDevice;
+	}
+
+}
+
+int main(int argc, char** argv)
+{
+	Syndra::Log::init();
+
+	std::vector<char*> args(argv, argv + argc);
+	const std::optional<std::string> renderer = TakeRendererArgument(args);
+
+	// Results always go to a file (JSON unless --benchmark_out_format says otherwise) so runs can be
+	// collected for trend tracking; the console keeps the readable table.
+	std::string outputArgument;
+	if (!HasArgument(args, "--benchmark_out="))
+	{
+		outputArgument = "--benchmark_out=" + std::filesystem::absolute(kDefaultOutputPath).string();
+		args.push_back(outputArgument.data());
+	}
+
+	Syndra::Application* app = nullptr;
+	if (renderer.has_value())
+	{
+		if (auto api = ParseRendererAPI(*renderer))
+		{
+			ChangeToEditorDirectory();
+			app = CreateRenderDevice(*api);
+			s_HasRenderDevice = true;
+		}
+		else
+		{
+			SN_ERROR("Invalid renderer backend '{}'. Expected 'vulkan', 'opengl' or 'null'; running the CPU benchmarks only.", *renderer);
+		}
+	}
+
+	int benchmarkArgc = static_cast<int>(args.size());
+	benchmark::Initialize(&benchmarkArgc, args.data());
+	if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, args.data()))
+	{
+		delete app;
+		return 1;
+	}
+
+	Syndra::RegisterDeviceShaderBenchmarks();
+	Syndra::RegisterModelBenchmarks();
+	benchmark::RunSpecifiedBenchmarks();
+	// Device benchmarks hold backend objects, which have to go before the device does.
+	benchmark::ClearRegisteredBenchmarks();
+	benchmark::Shutdown();
+
+	delete app;
+	Syndra::Log::flush();
+	return 0;
+}
@@ -0,0 +1,438 @@
+#include "lpch.h"
+#include "MicroBench.h"
+
+#include "Engine/Core/Application.h"
+#include "Engine/Renderer/FrameBuffer.h"
+#include "Engine/Renderer/Frustum.h"
+#include "Engine/Renderer/Material.h"
+#include "Engine/Renderer/Model.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RendererAPI.h"
+#include "Engine/Renderer/UniformBuffer.h"
+#include "Platform/Null/NullShader.h"
+#include "Platform/Null/NullTexture.h"
+#include "Platform/Vulkan/VulkanDrawPacket.h"
+#include "Platform/Vulkan/VulkanRendererAPI.h"
+
+#include <benchmark/benchmark.h>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <random>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint32_t kRandomSeed = 1337;
+		constexpr uint32_t kMaterialSamplerCount = 5;
+		constexpr uint32_t kDrawTargetSize = 256;
+		const std::string kDrawTransformUniform = "push.u_trans";
+		const std::string kDrawIdUniform = "push.id";
+
+		glm::mat4 GetCameraViewProjection()
+		{
+			const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+			const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 30.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+			return projection * view;
+		}
+
+		// The sampler and push constant layout of the geometry pass, which is what materials bind.
+		Ref<Shader> CreateGeometryPassNullShader()
+		{
+			std::vector<Sampler> samplers;
+			for (uint32_t binding = 0; binding < kMaterialSamplerCount; ++binding)
+				samplers.push_back({ "u_Texture" + std::to_string(binding), 0, binding, true });
+
+			PushConstant push;
+			push.name = "push";
+			push.members = { { "u_trans", sizeof(glm::mat4) }, { "material", sizeof(Material::ShaderMaterial) }, { "id", sizeof(int) },
+				{ "HasAlbedoMap", sizeof(int) }, { "HasNormalMap", sizeof(int) }, { "HasRoughnessMap", sizeof(int) },
+				{ "HasMetallicMap", sizeof(int) }, { "HasAOMap", sizeof(int) }, { "tiling", sizeof(float) } };
+			push.size = 0;
+			for (const PCMember& member : push.members)
+				push.size += static_cast<uint32_t>(member.size);
+
+			return CreateRef<NullShader>("GeometryPass", std::move(samplers), std::vector<PushConstant>{ push });
+		}
+
+		void RunMaterialBind(benchmark::State& state, Material& material)
+		{
+			for (auto _ : state)
+				material.Bind();
+			state.SetItemsProcessed(state.iterations());
+		}
+
+		// The per-draw uniforms the renderers set, named the way they name them.
+		void RunDrawUniforms(benchmark::State& state, Shader& shader)
+		{
+			const glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+			shader.Bind();
+			for (auto _ : state)
+			{
+				shader.SetMat4("push.u_trans", transform);
+				shader.SetInt("push.id", 42);
+				shader.SetFloat("push.material.RoughnessFactor", 0.5f);
+				shader.SetFloat4("push.material.color", glm::vec4(1.0f));
+			}
+			shader.Unbind();
+			state.SetItemsProcessed(state.iterations() * 4);
+		}
+
+		// Releases the GPU objects freed by the last iteration, which backends defer to frame boundaries.
+		void PumpFrame()
+		{
+			Window& window = Application::Get().GetWindow();
+			window.BeginFrame();
+			window.EndFrame();
+		}
+
+		// A unit cube: the draw benchmarks measure submission, not geometry.
+		Model CreateCubeModel()
+		{
+			std::vector<Vertex> vertices;
+			for (uint32_t corner = 0; corner < 8; ++corner)
+			{
+				Vertex vertex{};
+				vertex.Position = glm::vec3(corner & 1 ? 0.5f : -0.5f, corner & 2 ? 0.5f : -0.5f, corner & 4 ? 0.5f : -0.5f);
+				vertex.Normal = glm::normalize(vertex.Position);
+				vertex.TexCoords = glm::vec2(vertex.Position.x, vertex.Position.y) + 0.5f;
+				vertices.push_back(vertex);
+			}
+			std::vector<unsigned int> indices = {
+				0, 2, 1, 1, 2, 3,	4, 5, 6, 5, 7, 6,	0, 1, 4, 1, 5, 4,
+				2, 6, 3, 3, 6, 7,	0, 4, 2, 2, 4, 6,	1, 3, 5, 3, 7, 5
+			};
+
+			Model model;
+			model.meshes.emplace_back(std::move(vertices), std::move(indices), std::vector<texture>{});
+			return model;
+		}
+
+		// The attachments of the deferred renderer's geometry pass, which the geometry shader writes.
+		Ref<FrameBuffer> CreateGeometryFrameBuffer()
+		{
+			FramebufferSpecification spec;
+			spec.Attachments =
+			{
+				FramebufferTextureFormat::RGBA16F,
+				FramebufferTextureFormat::RGBA16F,
+				FramebufferTextureFormat::RGBA8,
+				FramebufferTextureFormat::RGBA8,
+				FramebufferTextureFormat::RED_INTEGER,
+				FramebufferTextureFormat::DEPTH24STENCIL8
+			};
+			spec.Width = kDrawTargetSize;
+			spec.Height = kDrawTargetSize;
+			spec.Samples = 1;
+			return FrameBuffer::Create(spec);
+		}
+
+		// Geometry pass draws of one cube per item, submitted the way VulkanDeferredRenderer does:
+		// immediately (uniforms, Renderer::Submit) or by replaying the item's retained draw packet
+		// with its transform and id patched in. Only the submission and Flush() are timed; the frame
+		// around them is not.
+		void RunGeometryDraws(benchmark::State& state, const Ref<Shader>& shader, bool retained)
+		{
+			const uint32_t drawCount = static_cast<uint32_t>(state.range(0));
+			Window& window = Application::Get().GetWindow();
+			VulkanRendererAPI* api = VulkanRendererAPI::GetCurrent();
+			if (retained && api == nullptr)
+			{
+				state.SkipWithError("Draw packets need the Vulkan backend.");
+				return;
+			}
+
+			Ref<Shader> materialShader = shader;
+			Material material(materialShader);
+			Model cube = CreateCubeModel();
+			const Ref<VertexArray> vertexArray = cube.meshes.front().GetVertexArray();
+			Ref<FrameBuffer> target = CreateGeometryFrameBuffer();
+			Ref<UniformBuffer> camera = UniformBuffer::Create(sizeof(glm::mat4) + sizeof(glm::vec4), 0);
+			const glm::mat4 viewProjection = GetCameraViewProjection();
+
+			std::mt19937 random(kRandomSeed);
+			std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+			std::vector<glm::mat4> transforms(drawCount);
+			for (glm::mat4& transform : transforms)
+				transform = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), position(random)));
+
+			std::vector<Scope<VulkanDrawPacket>> packets(retained ? drawCount : 0);
+			VulkanDrawPacket::PushConstantSlot transformSlot;
+			VulkanDrawPacket::PushConstantSlot idSlot;
+			uint32_t packetBuilds = 0;
+			auto buildPacket = [&](uint32_t index)
+			{
+				material.Bind();
+				vertexArray->Bind();
+				packets[index] = CreateScope<VulkanDrawPacket>();
+				if (api->BuildDrawPacket(vertexArray, *packets[index]))
+				{
+					packets[index]->FindPushConstant(kDrawTransformUniform, transformSlot);
+					packets[index]->FindPushConstant(kDrawIdUniform, idSlot);
+				}
+				++packetBuilds;
+			};
+
+			auto beginFrame = [&]()
+			{
+				window.BeginFrame();
+				camera->SetData(glm::value_ptr(viewProjection), sizeof(glm::mat4));
+				target->Bind();
+				shader->Bind();
+			};
+			auto endFrame = [&]()
+			{
+				target->Unbind();
+				window.EndFrame();
+			};
+
+			// Packets are built inside a frame, as the renderer builds them on first use.
+			if (retained)
+			{
+				beginFrame();
+				for (uint32_t i = 0; i < drawCount; ++i)
+					buildPacket(i);
+				RenderCommand::Flush();
+				endFrame();
+				packetBuilds = 0;
+			}
+
+			for (auto _ : state)
+			{
+				state.PauseTiming();
+				beginFrame();
+				state.ResumeTiming();
+
+				for (uint32_t i = 0; i < drawCount; ++i)
+				{
+					// The geometry pass sets these for every item before choosing a path.
+					const int entityID = static_cast<int>(i);
+					shader->SetInt(kDrawIdUniform, entityID);
+					shader->SetMat4(kDrawTransformUniform, transforms[i]);
+					if (!retained)
+					{
+						Renderer::Submit(material, cube);
+						continue;
+					}
+
+					VulkanDrawPacket& packet = *packets[i];
+					packet.SetPushConstant(transformSlot, glm::value_ptr(transforms[i]), sizeof(glm::mat4));
+					packet.SetPushConstant(idSlot, &entityID, sizeof(int));
+					if (api->SubmitDrawPacket(packet))
+						continue;
+
+					// Stale after a uniform ring growth; rebuilt and drawn like DrawRetained does.
+					buildPacket(i);
+					if (!api->SubmitDrawPacket(*packets[i]))
+						RenderCommand::DrawIndexed(vertexArray);
+				}
+				RenderCommand::Flush();
+
+				state.PauseTiming();
+				endFrame();
+				state.ResumeTiming();
+			}
+
+			state.SetItemsProcessed(state.iterations() * drawCount);
+			state.counters["perDraw"] = benchmark::Counter(static_cast<double>(state.iterations() * drawCount),
+				benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+			if (retained)
+				state.counters["packetBuilds"] = static_cast<double>(packetBuilds);
+
+			// The packets' descriptor sets and the buffers go back at a frame boundary.
+			packets.clear();
+			PumpFrame();
+		}
+
+		bool IsModelAsset(const std::filesystem::path& path)
+		{
+			std::string extension = path.extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension == ".obj" || extension == ".fbx" || extension == ".gltf" || extension == ".glb";
+		}
+
+	}
+
+	static void BM_Frustum_BuildPlanes(benchmark::State& state)
+	{
+		glm::mat4 viewProjection = GetCameraViewProjection();
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(viewProjection);
+			FrustumPlanes planes = BuildFrustumPlanes(viewProjection);
+			benchmark::DoNotOptimize(planes);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Frustum_BuildPlanes);
+
+	// The per-item camera test of the deferred renderer once the local bounds are known: move the
+	// bounding sphere into world space and test it against the planes.
+	static void BM_Frustum_CullSpheres(benchmark::State& state)
+	{
+		const FrustumPlanes planes = BuildFrustumPlanes(GetCameraViewProjection());
+		std::mt19937 random(kRandomSeed);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> scale(0.5f, 4.0f);
+
+		std::vector<glm::mat4> transforms(static_cast<size_t>(state.range(0)));
+		for (glm::mat4& transform : transforms)
+		{
+			transform = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), position(random)));
+			transform = glm::scale(transform, glm::vec3(scale(random)));
+		}
+
+		const glm::vec3 localCenter(0.0f);
+		const float localRadius = 1.0f;
+		size_t visible = 0;
+		for (auto _ : state)
+		{
+			visible = 0;
+			for (const glm::mat4& transform : transforms)
+			{
+				const glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(localCenter, 1.0f));
+				const float worldRadius = localRadius * ComputeTransformMaxScale(transform);
+				visible += IsSphereInsideFrustum(planes, worldCenter, worldRadius) ? 1 : 0;
+			}
+			benchmark::DoNotOptimize(visible);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.counters["visible"] = static_cast<double>(visible);
+	}
+	BENCHMARK(BM_Frustum_CullSpheres)->RangeMultiplier(8)->Range(512, 32768);
+
+	// Every sampler has a texture: unbound samplers fall back to Texture::BindTexture, which needs a
+	// backend and is covered by BM_Material_Bind/<api>.
+	static void BM_Material_Bind_NullBackend(benchmark::State& state)
+	{
+		Ref<Shader> shader = CreateGeometryPassNullShader();
+		Material material(shader);
+		for (const Sampler& sampler : material.GetSamplers())
+		{
+			Ref<Texture2D> texture = CreateRef<NullTexture2D>(1u, 1u);
+			material.AddTexture(sampler, texture);
+		}
+		RunMaterialBind(state, material);
+	}
+	BENCHMARK(BM_Material_Bind_NullBackend);
+
+	// Names passed as literals build a std::string per call, like every call site in the renderers.
+	static void BM_Shader_SetUniforms_NullBackend(benchmark::State& state)
+	{
+		Ref<Shader> shader = CreateGeometryPassNullShader();
+		RunDrawUniforms(state, *shader);
+	}
+	BENCHMARK(BM_Shader_SetUniforms_NullBackend);
+
+	// The same calls with names that already are strings, for the share of the name construction.
+	static void BM_Shader_SetUniforms_NullBackend_PrebuiltNames(benchmark::State& state)
+	{
+		Ref<Shader> shader = CreateGeometryPassNullShader();
+		const std::string transformName = "push.u_trans";
+		const std::string idName = "push.id";
+		const std::string roughnessName = "push.material.RoughnessFactor";
+		const std::string colorName = "push.material.color";
+		const glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+		for (auto _ : state)
+		{
+			shader->SetMat4(transformName, transform);
+			shader->SetInt(idName, 42);
+			shader->SetFloat(roughnessName, 0.5f);
+			shader->SetFloat4(colorName, glm::vec4(1.0f));
+		}
+		state.SetItemsProcessed(state.iterations() * 4);
+	}
+	BENCHMARK(BM_Shader_SetUniforms_NullBackend_PrebuiltNames);
+
+	void RegisterDeviceShaderBenchmarks()
+	{
+		if (!HasRenderDevice())
+			return;
+
+		const bool vulkan = RendererAPI::GetAPI() == RendererAPI::API::Vulkan;
+		const std::string api = RendererAPI::APIToString(RendererAPI::GetAPI());
+		Ref<Shader> shader = Shader::Create(vulkan ? "assets/shaders/vulkan/GeometryPass.glsl" : "assets/shaders/GeometryPass.glsl");
+		if (!shader)
+		{
+			SN_ERROR("Could not load the geometry pass shader, skipping the {} shader benchmarks.", api);
+			return;
+		}
+
+		benchmark::RegisterBenchmark(("BM_Shader_SetUniforms/" + api).c_str(), [shader](benchmark::State& state)
+		{
+			RunDrawUniforms(state, *shader);
+		});
+
+		// No textures, so every sampler goes through Texture::BindTexture of the backend.
+		benchmark::RegisterBenchmark(("BM_Material_Bind/" + api).c_str(), [shader](benchmark::State& state)
+		{
+			Ref<Shader> materialShader = shader;
+			Material material(materialShader);
+			RunMaterialBind(state, material);
+		});
+
+		// Immediate versus retained submission of the geometry pass, per draw. Retained draw packets
+		// only exist on Vulkan; other backends get the immediate baseline.
+		benchmark::RegisterBenchmark(("BM_GeometryDraws_Immediate/" + api).c_str(), [shader](benchmark::State& state)
+		{
+			RunGeometryDraws(state, shader, false);
+		})->ArgName("draws")->Arg(256)->Arg(4096)->Unit(benchmark::kMicrosecond);
+		if (vulkan)
+		{
+			benchmark::RegisterBenchmark(("BM_GeometryDraws_Retained/" + api).c_str(), [shader](benchmark::State& state)
+			{
+				RunGeometryDraws(state, shader, true);
+			})->ArgName("draws")->Arg(256)->Arg(4096)->Unit(benchmark::kMicrosecond);
+		}
+	}
+
+	void RegisterModelBenchmarks()
+	{
+		if (!HasRenderDevice())
+			return;
+
+		namespace fs = std::filesystem;
+		const fs::path root = "assets/Models";
+		std::error_code errorCode;
+		std::vector<fs::path> assets;
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root, errorCode))
+		{
+			if (entry.is_regular_file() && IsModelAsset(entry.path()))
+				assets.push_back(entry.path());
+		}
+		std::sort(assets.begin(), assets.end());
+		if (assets.empty())
+			SN_WARN("No sample models found under '{}'.", root.string());
+
+		// The TextureLibrary only holds weak references, so every iteration loads the model's
+		// textures again, as opening a scene does.
+		for (const fs::path& asset : assets)
+		{
+			const std::string name = "BM_Model_Import/" + fs::relative(asset, root, errorCode).generic_string();
+			benchmark::RegisterBenchmark(name.c_str(), [path = asset.string()](benchmark::State& state)
+			{
+				size_t meshCount = 0;
+				for (auto _ : state)
+				{
+					std::string modelPath = path;
+					Scope<Model> model = CreateScope<Model>(modelPath);
+					meshCount = model->meshes.size();
+					benchmark::DoNotOptimize(meshCount);
+
+					state.PauseTiming();
+					model.reset();
+					PumpFrame();
+					state.ResumeTiming();
+				}
+				state.counters["meshes"] = static_cast<double>(meshCount);
+			})->Unit(benchmark::kMillisecond);
+		}
+	}
+
+}
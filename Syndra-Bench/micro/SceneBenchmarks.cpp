@@ -0,0 +1,247 @@
+#include "lpch.h"
+
+#include "Engine/Core/Log.h"
+#include "Engine/Scene/Components.h"
+#include "Engine/Scene/Entity.h"
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/SceneSerializer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <filesystem>
+#include <random>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint32_t kRandomSeed = 1337;
+		constexpr uint32_t kLoggingSceneEntities = 4096;
+
+		enum class LoggingMode : int64_t
+		{
+			Off,
+			// Written and flushed on the loading thread for every message, as logging used to be.
+			SyncFlushAll,
+			Async
+		};
+
+		void RandomizeTransform(TransformComponent& transform, std::mt19937& random)
+		{
+			std::uniform_real_distribution<float> translation(-10.0f, 10.0f);
+			std::uniform_real_distribution<float> rotation(-glm::pi<float>(), glm::pi<float>());
+			std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+			transform.Translation = { translation(random), translation(random), translation(random) };
+			transform.Rotation = { rotation(random), rotation(random), rotation(random) };
+			transform.Scale = { scale(random), scale(random), scale(random) };
+		}
+
+		// A chain of depth entities, each the parent of the next. Returns the leaf.
+		Ref<Entity> BuildDeepHierarchy(Scene& scene, uint32_t depth)
+		{
+			std::mt19937 random(kRandomSeed);
+			Ref<Entity> parent;
+			for (uint32_t i = 0; i < depth; ++i)
+			{
+				Ref<Entity> entity = scene.CreateEntity();
+				RandomizeTransform(entity->GetComponent<TransformComponent>(), random);
+				if (parent)
+					scene.SetParent(*entity, *parent);
+				parent = entity;
+			}
+			return parent;
+		}
+
+		// One root with width children. Returns the children.
+		std::vector<Ref<Entity>> BuildWideHierarchy(Scene& scene, uint32_t width)
+		{
+			std::mt19937 random(kRandomSeed);
+			Ref<Entity> root = scene.CreateEntity("Root");
+			RandomizeTransform(root->GetComponent<TransformComponent>(), random);
+
+			std::vector<Ref<Entity>> children;
+			children.reserve(width);
+			for (uint32_t i = 0; i < width; ++i)
+			{
+				Ref<Entity> child = scene.CreateEntity();
+				RandomizeTransform(child->GetComponent<TransformComponent>(), random);
+				scene.SetParent(*child, *root);
+				children.push_back(child);
+			}
+			return children;
+		}
+
+		// Roughly what the editor saves: a camera, a few directional lights and point lights in
+		// groups of up to eight under a parent.
+		Ref<Scene> BuildSerializableScene(uint32_t entityCount)
+		{
+			std::mt19937 random(kRandomSeed);
+			Ref<Scene> scene = CreateRef<Scene>("MicroBench");
+			scene->CreateEntity("Camera")->AddComponent<CameraComponent>();
+
+			Ref<Entity> group;
+			for (uint32_t i = 0; i < entityCount; ++i)
+			{
+				Ref<Entity> entity = scene->CreateEntity();
+				RandomizeTransform(entity->GetComponent<TransformComponent>(), random);
+				if (i % 8 == 0)
+				{
+					group = entity;
+					continue;
+				}
+
+				scene->SetParent(*entity, *group);
+				if (i % 64 == 1)
+				{
+					Ref<Light> light = CreateRef<DirectionalLight>(glm::vec3(1.0f), 2.0f, glm::vec3(0.0f, -1.0f, 0.0f));
+					entity->AddComponent<LightComponent>(LightType::Directional, light);
+				}
+				else
+				{
+					entity->AddComponent<LightComponent>();
+				}
+			}
+			return scene;
+		}
+
+		std::string GetScratchScenePath()
+		{
+			return (std::filesystem::temp_directory_path() / "SyndraMicroBench.syndra").string();
+		}
+
+	}
+
+	static void BM_TransformComponent_GetTransform(benchmark::State& state)
+	{
+		std::mt19937 random(kRandomSeed);
+		TransformComponent transform;
+		RandomizeTransform(transform, random);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(transform);
+			glm::mat4 matrix = transform.GetTransform();
+			benchmark::DoNotOptimize(matrix);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_TransformComponent_GetTransform);
+
+	// Walks the whole chain from the leaf, so the cost grows with the depth.
+	static void BM_Scene_GetWorldTransform_Deep(benchmark::State& state)
+	{
+		Scene scene;
+		Ref<Entity> leaf = BuildDeepHierarchy(scene, static_cast<uint32_t>(state.range(0)));
+		for (auto _ : state)
+		{
+			glm::mat4 matrix = scene.GetWorldTransform(*leaf);
+			benchmark::DoNotOptimize(matrix);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Scene_GetWorldTransform_Deep)->RangeMultiplier(4)->Range(4, 256);
+
+	// Resolves every child of one parent, the parent's transform is recomputed for each.
+	static void BM_Scene_GetWorldTransform_Wide(benchmark::State& state)
+	{
+		Scene scene;
+		const std::vector<Ref<Entity>> children = BuildWideHierarchy(scene, static_cast<uint32_t>(state.range(0)));
+		for (auto _ : state)
+		{
+			for (const Ref<Entity>& child : children)
+			{
+				glm::mat4 matrix = scene.GetWorldTransform(*child);
+				benchmark::DoNotOptimize(matrix);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Scene_GetWorldTransform_Wide)->RangeMultiplier(8)->Range(64, 16384);
+
+	static void BM_SceneSerializer_Serialize(benchmark::State& state)
+	{
+		Ref<Scene> scene = BuildSerializableScene(static_cast<uint32_t>(state.range(0)));
+		SceneSerializer serializer(scene);
+		const std::string path = GetScratchScenePath();
+		for (auto _ : state)
+			serializer.Serialize(path);
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.counters["bytes"] = static_cast<double>(std::filesystem::file_size(path));
+		std::filesystem::remove(path);
+	}
+	BENCHMARK(BM_SceneSerializer_Serialize)->RangeMultiplier(8)->Range(64, 4096)->Unit(benchmark::kMillisecond);
+
+	static void BM_SceneSerializer_RoundTrip(benchmark::State& state)
+	{
+		Ref<Scene> source = BuildSerializableScene(static_cast<uint32_t>(state.range(0)));
+		const std::string path = GetScratchScenePath();
+		for (auto _ : state)
+		{
+			// Entities resolve their components through the scene created last.
+			Entity::s_Scene = source.get();
+			SceneSerializer(source).Serialize(path);
+
+			Ref<Scene> target = CreateRef<Scene>();
+			const bool loaded = SceneSerializer(target).Deserialize(path);
+			benchmark::DoNotOptimize(loaded);
+
+			state.PauseTiming();
+			target.reset();
+			state.ResumeTiming();
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		Entity::s_Scene = nullptr;
+		std::filesystem::remove(path);
+	}
+	BENCHMARK(BM_SceneSerializer_RoundTrip)->RangeMultiplier(8)->Range(64, 4096)->Unit(benchmark::kMillisecond);
+
+	// Scene load time with the engine's log messages off, written synchronously, and queued. The
+	// per-entity trace is not rate limited here, so every entity logs as it did before limiting.
+	static void BM_SceneSerializer_Deserialize_Logging(benchmark::State& state)
+	{
+		const LoggingMode mode = static_cast<LoggingMode>(state.range(0));
+		LogSettings settings;
+		settings.Async = mode == LoggingMode::Async;
+		settings.RateLimit = false;
+		if (mode == LoggingMode::SyncFlushAll)
+			settings.FlushLevel = spdlog::level::trace;
+		Log::init(settings);
+		if (mode == LoggingMode::Off)
+		{
+			Log::GetCoreLogger()->set_level(spdlog::level::off);
+			Log::GetClientLogger()->set_level(spdlog::level::off);
+		}
+
+		Ref<Scene> source = BuildSerializableScene(kLoggingSceneEntities);
+		const std::string path = GetScratchScenePath();
+		Entity::s_Scene = source.get();
+		SceneSerializer(source).Serialize(path);
+		for (auto _ : state)
+		{
+			Ref<Scene> target = CreateRef<Scene>();
+			const bool loaded = SceneSerializer(target).Deserialize(path);
+			benchmark::DoNotOptimize(loaded);
+			// The async writer would otherwise still be formatting this load during the next one.
+			Log::flush();
+
+			state.PauseTiming();
+			target.reset();
+			state.ResumeTiming();
+		}
+
+		state.SetItemsProcessed(state.iterations() * kLoggingSceneEntities);
+		state.SetLabel(mode == LoggingMode::Off ? "off" : mode == LoggingMode::Async ? "async" : "sync");
+		Entity::s_Scene = nullptr;
+		std::filesystem::remove(path);
+		Log::init();
+	}
+	BENCHMARK(BM_SceneSerializer_Deserialize_Logging)
+		->Arg(static_cast<int64_t>(LoggingMode::Off))
+		->Arg(static_cast<int64_t>(LoggingMode::SyncFlushAll))
+		->Arg(static_cast<int64_t>(LoggingMode::Async))
+		->Unit(benchmark::kMillisecond);
+
+}
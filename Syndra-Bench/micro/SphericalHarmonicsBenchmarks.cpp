@@ -0,0 +1,103 @@
+#include "lpch.h"
+
+#include "Engine/Renderer/SphericalHarmonics.h"
+
+#include <benchmark/benchmark.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint32_t kRandomSeed = 1337;
+		// Environment::kMaxIrradianceRadiance, the clamp the loader projects with.
+		constexpr float kMaxRadiance = 1.0f;
+		constexpr uint32_t kReferenceStride = 8;
+
+		// An equirectangular sky in the row layout ProjectEquirectangular expects: a ground to sky
+		// gradient, a small bright sun and some texel noise.
+		std::vector<float> BuildSyntheticSky(uint32_t width, uint32_t height)
+		{
+			std::mt19937 random(kRandomSeed);
+			std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+			const glm::vec3 ground(0.25f, 0.2f, 0.15f);
+			const glm::vec3 sky(0.35f, 0.55f, 0.9f);
+			const glm::vec3 sunDirection = glm::normalize(glm::vec3(0.4f, 0.6f, 0.3f));
+
+			std::vector<float> pixels(static_cast<size_t>(width) * height * 3);
+			for (uint32_t y = 0; y < height; ++y)
+			{
+				const float latitude = ((static_cast<float>(y) + 0.5f) / static_cast<float>(height) - 0.5f) * glm::pi<float>();
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					const float longitude = ((static_cast<float>(x) + 0.5f) / static_cast<float>(width) - 0.5f) * glm::two_pi<float>();
+					const glm::vec3 direction(std::cos(latitude) * std::cos(longitude), std::sin(latitude), std::cos(latitude) * std::sin(longitude));
+					const float horizon = glm::smoothstep(-0.1f, 0.3f, direction.y);
+					const float sun = std::pow(std::max(glm::dot(direction, sunDirection), 0.0f), 256.0f) * 20.0f;
+					const glm::vec3 color = glm::mix(ground, sky, horizon) * noise(random) + glm::vec3(sun);
+
+					float* texel = &pixels[(static_cast<size_t>(y) * width + x) * 3];
+					texel[0] = color.r;
+					texel[1] = color.g;
+					texel[2] = color.b;
+				}
+			}
+			return pixels;
+		}
+
+		// Largest error of the nine-term fit against a direct hemisphere integral along the cube
+		// axes and diagonals, relative to the reference luminance.
+		float ComputeMaxRelativeError(const std::vector<float>& pixels, uint32_t width, uint32_t height, const SphericalHarmonicsL2& irradiance)
+		{
+			float maxError = 0.0f;
+			for (int x = -1; x <= 1; ++x)
+			{
+				for (int y = -1; y <= 1; ++y)
+				{
+					for (int z = -1; z <= 1; ++z)
+					{
+						if (x == 0 && y == 0 && z == 0)
+							continue;
+
+						const glm::vec3 normal(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+						const glm::vec3 reference = SphericalHarmonics::ComputeReferenceIrradiance(pixels.data(), width, height,
+							kMaxRadiance, normal, kReferenceStride);
+						const glm::vec3 approximation = SphericalHarmonics::Evaluate(irradiance, glm::normalize(normal));
+						const float referenceLuminance = std::max(glm::dot(reference, glm::vec3(0.2126f, 0.7152f, 0.0722f)), 1e-4f);
+						maxError = std::max(maxError, glm::length(approximation - reference) / referenceLuminance);
+					}
+				}
+			}
+			return maxError;
+		}
+
+	}
+
+	// What a cold environment load spends on the CPU for diffuse lighting: projection of the HDR
+	// and the Lambert convolution. The reference comparison runs once, outside the timed loop, and
+	// is reported as "maxError"; L2 SH should stay within a few percent for skies like this one.
+	static void BM_SphericalHarmonics_Project(benchmark::State& state)
+	{
+		const uint32_t width = static_cast<uint32_t>(state.range(0));
+		const uint32_t height = width / 2;
+		const std::vector<float> pixels = BuildSyntheticSky(width, height);
+
+		SphericalHarmonicsL2 irradiance;
+		for (auto _ : state)
+		{
+			irradiance = SphericalHarmonics::ConvolveLambert(
+				SphericalHarmonics::ProjectEquirectangular(pixels.data(), width, height, kMaxRadiance));
+			benchmark::DoNotOptimize(irradiance);
+		}
+
+		state.SetItemsProcessed(state.iterations() * width * height);
+		state.counters["maxError"] = ComputeMaxRelativeError(pixels, width, height, irradiance);
+	}
+	BENCHMARK(BM_SphericalHarmonics_Project)->ArgName("width")->Arg(512)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+}
@@ -0,0 +1,389 @@
+#include "lpch.h"
+#include "BenchLayer.h"
+
+#include "Engine/Core/Instrument.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/TextureStreamer.h"
+#include "Engine/Scene/SceneSerializer.h"
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Vulkan/VulkanRendererAPI.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint32_t kDefaultOrbitKeyframes = 8;
+		constexpr uint32_t kReportVersion = 1;
+
+		std::string EscapeJson(const std::string& value)
+		{
+			std::string escaped;
+			escaped.reserve(value.size());
+			for (char c : value)
+			{
+				if (c == '"' || c == '\\')
+					escaped.push_back('\\');
+				if (static_cast<unsigned char>(c) < 0x20)
+					continue;
+				escaped.push_back(c);
+			}
+			return escaped;
+		}
+
+		// Nearest-rank percentile of sorted values.
+		double Percentile(const std::vector<double>& sorted, double percentile)
+		{
+			if (sorted.empty())
+				return 0.0;
+			const size_t rank = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+			return sorted[std::min(rank, sorted.size() - 1)];
+		}
+
+		void WriteSummary(std::ostream& out, const char* name, std::vector<double> values)
+		{
+			std::sort(values.begin(), values.end());
+			double total = 0.0;
+			for (double value : values)
+				total += value;
+			const double average = values.empty() ? 0.0 : total / static_cast<double>(values.size());
+
+			out << "\t\t\"" << name << "\": { "
+				<< "\"avg\": " << average
+				<< ", \"min\": " << (values.empty() ? 0.0 : values.front())
+				<< ", \"p50\": " << Percentile(values, 50.0)
+				<< ", \"p95\": " << Percentile(values, 95.0)
+				<< ", \"p99\": " << Percentile(values, 99.0)
+				<< ", \"max\": " << (values.empty() ? 0.0 : values.back())
+				<< " }";
+		}
+
+	}
+
+	BenchLayer::BenchLayer(const BenchSettings& settings)
+		: Layer("Bench"), m_Settings(settings)
+	{
+	}
+
+	void BenchLayer::OnAttach()
+	{
+		// The GPU profiler only records while the instrumentor is enabled.
+		RenderThread::SetLatency(m_Settings.RenderThreadLatency);
+		Instrumentor::SetEnabled(true);
+
+		RenderCommand::Init();
+		m_RendererInfo = RenderCommand::GetInfo();
+		if (m_Settings.ParallelRecording)
+		{
+			if (RendererAPI::GetAPI() == RendererAPI::API::Vulkan)
+				VulkanRendererAPI::SetParallelRecording(*m_Settings.ParallelRecording);
+			else
+				SN_WARN("--parallel-recording only applies to Vulkan; ignoring it.");
+		}
+
+		m_ActiveScene = CreateRef<Scene>();
+		SceneRenderer::SetScene(m_ActiveScene);
+		SceneRenderer::InitializeShaders();
+		SceneSerializer serializer(m_ActiveScene);
+		if (!serializer.Deserialize(m_Settings.ScenePath))
+		{
+			// Timings of a partly loaded scene would look like a valid run; fail without a report.
+			SN_ERROR("Could not load scene '{}'.", m_Settings.ScenePath);
+			m_Finished = true;
+			Application::Get().Close(1);
+			return;
+		}
+		SceneRenderer::InitializeEnvironment();
+		SceneRenderer::Initialize();
+		if (m_Settings.HiZOcclusion)
+			SceneRenderer::SetHiZOcclusion(*m_Settings.HiZOcclusion);
+		m_ActiveScene->OnViewportResize(m_Settings.Width, m_Settings.Height);
+
+		if (m_Settings.CameraPath.empty() || !LoadCameraPath())
+			BuildDefaultCameraPath();
+
+		m_Samples.reserve(m_Settings.Frames);
+		SN_INFO("Benchmarking '{}' at {}x{}: {} frames after {} warm-up frames on {}.",
+			m_Settings.ScenePath, m_Settings.Width, m_Settings.Height, m_Settings.Frames, m_Settings.WarmupFrames, m_RendererInfo);
+	}
+
+	void BenchLayer::OnDetach()
+	{
+		SceneRenderer::ShutDown();
+	}
+
+	void BenchLayer::OnUpdate(Timestep ts)
+	{
+		if (m_Finished)
+			return;
+
+		// Frame time, render thread and backend recording statistics of a frame are only known once
+		// it was submitted, so they are filled in at the start of the next one. With a render thread
+		// the backend runs the frame's packet while this one is built: draws are counted as the
+		// render thread issued them since the last sample, and the Null backend's counters and the
+		// memory queries, which need the graphics context, are not sampled.
+		const uint32_t warmup = m_Settings.WarmupFrames;
+		const bool threaded = RenderThread::IsThreaded();
+		const uint32_t drawCount = RenderCommand::GetDrawCount();
+		const uint32_t renderThreadDraws = drawCount - m_LastDrawCount;
+		m_LastDrawCount = drawCount;
+		if (m_Frame > warmup && !m_Samples.empty())
+		{
+			FrameSample& previous = m_Samples.back();
+			previous.FrameMs = ts.GetMilliseconds();
+
+			const RenderThreadStats renderThreadStats = RenderThread::GetStats();
+			previous.MainThreadMs = renderThreadStats.MainThreadMs;
+			previous.WaitMs = renderThreadStats.WaitMs;
+			previous.RenderThreadMs = renderThreadStats.RenderThreadMs;
+			previous.OverlapMs = renderThreadStats.OverlapMs;
+			previous.Synchronizations = renderThreadStats.Synchronizations;
+
+			if (threaded)
+				previous.Draws = renderThreadDraws;
+			else if (RendererAPI::GetAPI() == RendererAPI::API::Vulkan)
+			{
+				const VulkanRendererAPI::RecordingStats stats = VulkanRendererAPI::GetRecordingStats();
+				previous.IndirectDraws = stats.IndirectDraws;
+				previous.Dispatches = stats.Dispatches;
+				previous.RecordMs = stats.RecordMs;
+			}
+			else if (RendererAPI::GetAPI() == RendererAPI::API::Null)
+			{
+				const NullRendererAPI::RecordingStats stats = NullRendererAPI::GetRecordingStats();
+				previous.Dispatches = stats.Dispatches;
+				previous.Binds = stats.ShaderBinds + stats.TextureBinds + stats.VertexArrayBinds + stats.FrameBufferBinds;
+				previous.UploadBytes = stats.BufferBytes + stats.TextureBytes;
+			}
+		}
+		// The Null backend counts until told otherwise; start every frame from zero.
+		if (!threaded && RendererAPI::GetAPI() == RendererAPI::API::Null)
+			NullRendererAPI::ResetRecording();
+
+		if (m_Frame == warmup + m_Settings.Frames)
+		{
+			WriteReport();
+			m_Finished = true;
+			Application::Get().Close();
+			return;
+		}
+
+		const bool measuring = m_Frame >= warmup;
+		const float t = measuring && m_Settings.Frames > 1
+			? static_cast<float>(m_Frame - warmup) / static_cast<float>(m_Settings.Frames - 1)
+			: 0.0f;
+		ApplyCameraPath(t);
+
+		if (!threaded)
+		{
+			RenderCommand::ResetDrawCount();
+			m_LastDrawCount = 0;
+		}
+		const auto updateStart = std::chrono::steady_clock::now();
+		m_ActiveScene->OnUpdateEditor(ts);
+		const double updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
+
+		if (measuring)
+		{
+			FrameSample sample;
+			sample.UpdateMs = updateMs;
+			if (!threaded)
+				sample.Draws = RenderCommand::GetDrawCount();
+
+			const CpuProfileNode gpuFrame = Instrumentor::Get().GetLatestCpuFrameProfile().Gpu;
+			sample.GpuMs = gpuFrame.TotalTimeMs;
+			for (const CpuProfileNode& pass : gpuFrame.Children)
+				sample.GpuPasses.push_back({ pass.Name, pass.TotalTimeMs });
+
+			GPUMemoryInfo memoryInfo;
+			if (!threaded && RenderCommand::GetMemoryInfo(memoryInfo))
+			{
+				sample.MemoryUsage = memoryInfo.Usage;
+				sample.MemoryBudget = memoryInfo.Budget;
+			}
+			sample.TextureResidentBytes = TextureStreamer::GetStats().ResidentBytes;
+			m_Samples.push_back(std::move(sample));
+		}
+
+		++m_Frame;
+	}
+
+	bool BenchLayer::LoadCameraPath()
+	{
+		// One keyframe per line: yaw pitch (degrees) distance focalX focalY focalZ. Keyframes are
+		// spread evenly over the measured frames; '#' starts a comment.
+		std::ifstream input(m_Settings.CameraPath);
+		if (!input)
+		{
+			SN_WARN("Could not open camera path '{}', orbiting instead.", m_Settings.CameraPath);
+			return false;
+		}
+
+		std::vector<CameraKeyframe> keyframes;
+		std::string line;
+		while (std::getline(input, line))
+		{
+			line = line.substr(0, line.find('#'));
+			std::istringstream stream(line);
+			float yaw = 0.0f;
+			float pitch = 0.0f;
+			CameraKeyframe keyframe;
+			if (!(stream >> yaw >> pitch >> keyframe.Distance))
+				continue;
+			stream >> keyframe.FocalPoint.x >> keyframe.FocalPoint.y >> keyframe.FocalPoint.z;
+			keyframe.Yaw = glm::radians(yaw);
+			keyframe.Pitch = glm::radians(pitch);
+			keyframes.push_back(keyframe);
+		}
+
+		if (keyframes.empty())
+		{
+			SN_WARN("Camera path '{}' has no keyframes, orbiting instead.", m_Settings.CameraPath);
+			return false;
+		}
+
+		m_CameraPath = std::move(keyframes);
+		return true;
+	}
+
+	void BenchLayer::BuildDefaultCameraPath()
+	{
+		PerspectiveCamera& camera = m_ActiveScene->GetEditorCamera();
+		m_CameraPath.clear();
+		for (uint32_t i = 0; i <= kDefaultOrbitKeyframes; ++i)
+		{
+			CameraKeyframe keyframe;
+			keyframe.FocalPoint = camera.GetFocalPoint();
+			keyframe.Distance = camera.GetDistance();
+			keyframe.Pitch = camera.GetPitch();
+			keyframe.Yaw = camera.GetYaw() + glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(kDefaultOrbitKeyframes);
+			m_CameraPath.push_back(keyframe);
+		}
+	}
+
+	void BenchLayer::ApplyCameraPath(float t)
+	{
+		if (m_CameraPath.empty())
+			return;
+
+		const float position = t * static_cast<float>(m_CameraPath.size() - 1);
+		const size_t index = std::min(static_cast<size_t>(position), m_CameraPath.size() - 1);
+		const size_t next = std::min(index + 1, m_CameraPath.size() - 1);
+		const float blend = position - static_cast<float>(index);
+		const CameraKeyframe& a = m_CameraPath[index];
+		const CameraKeyframe& b = m_CameraPath[next];
+
+		PerspectiveCamera& camera = m_ActiveScene->GetEditorCamera();
+		camera.SetDistance(glm::mix(a.Distance, b.Distance, blend));
+		camera.SetFocalPoint(glm::mix(a.FocalPoint, b.FocalPoint, blend));
+		camera.SetYawPitch(glm::mix(a.Yaw, b.Yaw, blend), glm::mix(a.Pitch, b.Pitch, blend));
+	}
+
+	void BenchLayer::WriteReport() const
+	{
+		std::ofstream out(m_Settings.OutputPath);
+		if (!out)
+		{
+			SN_ERROR("Could not write benchmark report '{}'.", m_Settings.OutputPath);
+			return;
+		}
+
+		const char* api = RendererAPI::APIToString(RendererAPI::GetAPI());
+		out << std::fixed << std::setprecision(4);
+		out << "{\n";
+		out << "\t\"version\": " << kReportVersion << ",\n";
+		out << "\t\"scene\": \"" << EscapeJson(m_Settings.ScenePath) << "\",\n";
+		out << "\t\"api\": \"" << api << "\",\n";
+		out << "\t\"renderer\": \"" << EscapeJson(m_RendererInfo) << "\",\n";
+		out << "\t\"width\": " << m_Settings.Width << ",\n";
+		out << "\t\"height\": " << m_Settings.Height << ",\n";
+		out << "\t\"warmupFrames\": " << m_Settings.WarmupFrames << ",\n";
+		out << "\t\"workers\": " << JobSystem::GetWorkerCount() << ",\n";
+		out << "\t\"hiZOcclusion\": \"" << (!m_Settings.HiZOcclusion ? "default" : *m_Settings.HiZOcclusion ? "on" : "off") << "\",\n";
+		out << "\t\"renderThreadLatency\": " << RenderThread::GetLatency() << ",\n";
+		const bool vulkan = RendererAPI::GetAPI() == RendererAPI::API::Vulkan;
+		out << "\t\"parallelRecording\": \"" << (!vulkan ? "n/a" : VulkanRendererAPI::IsParallelRecordingEnabled() ? "on" : "off") << "\",\n";
+
+		std::vector<double> frameTimes;
+		std::vector<double> updateTimes;
+		std::vector<double> gpuTimes;
+		std::vector<double> mainThreadTimes;
+		std::vector<double> waitTimes;
+		std::vector<double> renderThreadTimes;
+		std::vector<double> recordTimes;
+		for (const FrameSample& sample : m_Samples)
+		{
+			frameTimes.push_back(sample.FrameMs);
+			updateTimes.push_back(sample.UpdateMs);
+			mainThreadTimes.push_back(sample.MainThreadMs);
+			waitTimes.push_back(sample.WaitMs);
+			renderThreadTimes.push_back(sample.RenderThreadMs);
+			if (vulkan)
+				recordTimes.push_back(sample.RecordMs);
+			if (sample.GpuMs > 0.0)
+				gpuTimes.push_back(sample.GpuMs);
+		}
+
+		out << "\t\"summary\": {\n";
+		out << "\t\t\"frames\": " << m_Samples.size() << ",\n";
+		WriteSummary(out, "frameMs", frameTimes);
+		out << ",\n";
+		WriteSummary(out, "updateMs", updateTimes);
+		out << ",\n";
+		WriteSummary(out, "gpuMs", gpuTimes);
+		out << ",\n";
+		WriteSummary(out, "mainThreadMs", mainThreadTimes);
+		out << ",\n";
+		WriteSummary(out, "waitMs", waitTimes);
+		out << ",\n";
+		WriteSummary(out, "renderThreadMs", renderThreadTimes);
+		out << ",\n";
+		WriteSummary(out, "recordMs", recordTimes);
+		out << "\n\t},\n";
+
+		out << "\t\"frames\": [\n";
+		for (size_t i = 0; i < m_Samples.size(); ++i)
+		{
+			const FrameSample& sample = m_Samples[i];
+			out << "\t\t{ \"frame\": " << i
+				<< ", \"frameMs\": " << sample.FrameMs
+				<< ", \"updateMs\": " << sample.UpdateMs
+				<< ", \"gpuMs\": " << sample.GpuMs
+				<< ", \"gpuPasses\": {";
+			for (size_t pass = 0; pass < sample.GpuPasses.size(); ++pass)
+			{
+				out << (pass == 0 ? " " : ", ") << "\"" << EscapeJson(sample.GpuPasses[pass].Name) << "\": " << sample.GpuPasses[pass].TimeMs;
+			}
+			out << (sample.GpuPasses.empty() ? "}" : " }")
+				<< ", \"draws\": " << sample.Draws
+				<< ", \"indirectDraws\": " << sample.IndirectDraws
+				<< ", \"dispatches\": " << sample.Dispatches
+				<< ", \"recordMs\": " << sample.RecordMs
+				<< ", \"binds\": " << sample.Binds
+				<< ", \"uploadBytes\": " << sample.UploadBytes
+				<< ", \"memoryUsage\": " << sample.MemoryUsage
+				<< ", \"memoryBudget\": " << sample.MemoryBudget
+				<< ", \"textureResidentBytes\": " << sample.TextureResidentBytes
+				<< ", \"mainThreadMs\": " << sample.MainThreadMs
+				<< ", \"waitMs\": " << sample.WaitMs
+				<< ", \"renderThreadMs\": " << sample.RenderThreadMs
+				<< ", \"overlapMs\": " << sample.OverlapMs
+				<< ", \"synchronizations\": " << sample.Synchronizations
+				<< " }" << (i + 1 < m_Samples.size() ? ",\n" : "\n");
+		}
+		out << "\t]\n";
+		out << "}\n";
+
+		SN_INFO("Wrote benchmark report '{}' ({} frames).", m_Settings.OutputPath, m_Samples.size());
+	}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <Engine.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Syndra {
+
+	struct BenchSettings
+	{
+		std::string ScenePath = "assets/Scenes/Default_R.syndra";
+		std::string OutputPath = "bench.json";
+		// Optional keyframe file, see BenchLayer::LoadCameraPath(). Without one the camera orbits
+		// once around the scene camera's focal point.
+		std::string CameraPath;
+		uint32_t Width = 1280;
+		uint32_t Height = 720;
+		uint32_t Frames = 300;
+		// Frames rendered before measuring, while shaders compile and textures stream in.
+		uint32_t WarmupFrames = 30;
+		// JobSystem worker threads; 0, the default, uses one per hardware thread besides the main
+		// thread. --workers only accepts 1 or more, so a run never asks for 0 and gets all of them.
+		uint32_t Workers = 0;
+		// Hi-Z occlusion culling of the pipeline; unset keeps the pipeline's default.
+		std::optional<bool> HiZOcclusion;
+		// Vulkan only: VulkanRendererAPI::SetParallelRecording; unset keeps the backend's default.
+		std::optional<bool> ParallelRecording;
+		// Frames the render thread may lag behind the main thread (RenderThread::SetLatency): 0 runs
+		// every frame inline, 1 overlaps a frame's execution with the main thread's next one. Vulkan
+		// only runs inline.
+		uint32_t RenderThreadLatency = 0;
+	};
+
+	// Renders a scene offscreen along a scripted camera path for a fixed number of frames and
+	// writes per-frame timings, draw counts and memory statistics to a JSON report.
+	class BenchLayer : public Layer
+	{
+	public:
+		BenchLayer(const BenchSettings& settings);
+
+		virtual void OnAttach() override;
+		virtual void OnDetach() override;
+		virtual void OnUpdate(Timestep ts) override;
+
+	private:
+		struct CameraKeyframe
+		{
+			glm::vec3 FocalPoint{ 0.0f };
+			float Distance = 10.0f;
+			float Yaw = 0.0f;		// radians
+			float Pitch = 0.0f;		// radians
+		};
+
+		struct GpuPassSample
+		{
+			std::string Name;
+			double TimeMs = 0.0;
+		};
+
+		struct FrameSample
+		{
+			double FrameMs = 0.0;		// wall clock of the whole frame, submission included
+			double UpdateMs = 0.0;		// main thread: scene update, culling and draw building
+			double GpuMs = 0.0;			// latest frame resolved by the GPU profiler, a few frames behind
+			std::vector<GpuPassSample> GpuPasses;
+			uint32_t Draws = 0;			// RenderCommand::DrawIndexed calls
+			uint32_t IndirectDraws = 0;	// Vulkan only: indirect draw calls and compute dispatches
+			uint32_t Dispatches = 0;
+			double RecordMs = 0.0;		// Vulkan only: RecordingStats::RecordMs, command recording in Flush()
+			uint32_t Binds = 0;			// Null only: shader, texture, vertex array and framebuffer binds
+			uint64_t UploadBytes = 0;	// Null only: buffer and texture bytes a GPU backend would upload
+			uint64_t MemoryUsage = 0;
+			uint64_t MemoryBudget = 0;
+			uint64_t TextureResidentBytes = 0;
+			// RenderThreadStats of the frame, see RenderThread::EndFrame().
+			double MainThreadMs = 0.0;
+			double WaitMs = 0.0;
+			double RenderThreadMs = 0.0;
+			double OverlapMs = 0.0;
+			uint32_t Synchronizations = 0;
+		};
+
+		bool LoadCameraPath();
+		void BuildDefaultCameraPath();
+		void ApplyCameraPath(float t);
+		void WriteReport() const;
+
+	private:
+		BenchSettings m_Settings;
+		Ref<Scene> m_ActiveScene;
+		std::vector<CameraKeyframe> m_CameraPath;
+		std::vector<FrameSample> m_Samples;
+		std::string m_RendererInfo;
+		uint32_t m_Frame = 0;
+		uint32_t m_LastDrawCount = 0;
+		bool m_Finished = false;
+	};
+
+}
@@ -0,0 +1,185 @@
+#include "lpch.h"
+#include <Engine.h>
+#include "Engine/Core/EntryPoint.h"
+#include "Engine/Core/JobSystem.h"
+#include "BenchLayer.h"
+
+#include <array>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+namespace {
+
+	bool IsUsableAssetRoot(const std::filesystem::path& root)
+	{
+		return std::filesystem::exists(root / "assets/shaders")
+			&& std::filesystem::exists(root / "assets/shaders/vulkan");
+	}
+
+	// The benchmark reads the editor's shaders and writes into its shader cache, so it runs from
+	// the Syndra-Editor directory like the editor does. Paths given on the command line stay
+	// relative to where the benchmark was started.
+	void ConfigureBenchWorkingDirectory(Syndra::BenchSettings& settings)
+	{
+		namespace fs = std::filesystem;
+		const fs::path cwd = fs::current_path();
+		settings.OutputPath = fs::absolute(settings.OutputPath).string();
+		if (!settings.CameraPath.empty())
+			settings.CameraPath = fs::absolute(settings.CameraPath).string();
+		if (fs::exists(settings.ScenePath))
+			settings.ScenePath = fs::absolute(settings.ScenePath).string();
+
+		if (!IsUsableAssetRoot(cwd))
+		{
+			for (fs::path cursor = cwd; !cursor.empty(); cursor = cursor.parent_path())
+			{
+				if (IsUsableAssetRoot(cursor / "Syndra-Editor"))
+				{
+					fs::current_path(cursor / "Syndra-Editor");
+					SN_INFO("Working directory changed to '{}'.", fs::current_path().string());
+					break;
+				}
+				if (cursor == cursor.parent_path())
+					break;
+			}
+		}
+
+		const std::array<fs::path, 3> cacheDirectories = {
+			"assets/cache/shader",
+			"assets/cache/shader/opengl",
+			"assets/cache/shader/vulkan"
+		};
+		for (const fs::path& directory : cacheDirectories)
+		{
+			std::error_code errorCode;
+			fs::create_directories(directory, errorCode);
+		}
+	}
+
+	bool ParseUnsigned(std::string_view value, uint32_t& outValue)
+	{
+		try
+		{
+			const unsigned long parsed = std::stoul(std::string(value));
+			outValue = static_cast<uint32_t>(parsed);
+			return true;
+		}
+		catch (const std::exception&)
+		{
+			return false;
+		}
+	}
+
+	// Leaves outValue untouched unless value is a number in [minimum, maximum].
+	bool ParseUnsignedInRange(std::string_view value, uint32_t minimum, uint32_t maximum, uint32_t& outValue)
+	{
+		uint32_t parsed = 0;
+		if (!ParseUnsigned(value, parsed) || parsed < minimum || parsed > maximum)
+			return false;
+		outValue = parsed;
+		return true;
+	}
+
+	bool ParseSwitch(std::string_view value, std::optional<bool>& outValue)
+	{
+		if (value == "on" || value == "1" || value == "true")
+			outValue = true;
+		else if (value == "off" || value == "0" || value == "false")
+			outValue = false;
+		else
+			return false;
+		return true;
+	}
+
+	// Accepts --name=value and --name value. --renderer is handled by the entry point.
+	Syndra::BenchSettings ParseBenchSettings(const Syndra::ApplicationCommandLineArgs& args)
+	{
+		Syndra::BenchSettings settings;
+		for (int i = 1; i < args.Count; ++i)
+		{
+			std::string_view arg = args[i];
+			if (arg.rfind("--", 0) != 0)
+				continue;
+
+			std::string_view name = arg.substr(2);
+			std::string_view value;
+			if (const size_t separator = name.find('='); separator != std::string_view::npos)
+			{
+				value = name.substr(separator + 1);
+				name = name.substr(0, separator);
+			}
+			else if (i + 1 < args.Count)
+			{
+				value = args[++i];
+			}
+
+			bool valid = true;
+			if (name == "scene")
+				settings.ScenePath = std::string(value);
+			else if (name == "output")
+				settings.OutputPath = std::string(value);
+			else if (name == "camera-path")
+				settings.CameraPath = std::string(value);
+			else if (name == "frames")
+				valid = ParseUnsigned(value, settings.Frames);
+			else if (name == "warmup")
+				valid = ParseUnsigned(value, settings.WarmupFrames);
+			else if (name == "workers")
+				valid = ParseUnsignedInRange(value, 1, std::numeric_limits<uint32_t>::max(), settings.Workers);
+			else if (name == "hiz-occlusion")
+				valid = ParseSwitch(value, settings.HiZOcclusion);
+			else if (name == "parallel-recording")
+				valid = ParseSwitch(value, settings.ParallelRecording);
+			else if (name == "latency")
+				valid = ParseUnsignedInRange(value, 0, 1, settings.RenderThreadLatency);
+			else if (name == "width")
+				valid = ParseUnsignedInRange(value, 1, std::numeric_limits<uint32_t>::max(), settings.Width);
+			else if (name == "height")
+				valid = ParseUnsignedInRange(value, 1, std::numeric_limits<uint32_t>::max(), settings.Height);
+			else if (name != "renderer")
+				SN_WARN("Unknown argument '--{}'.", std::string(name));
+
+			if (!valid)
+				SN_ERROR("Invalid value '{}' for '--{}', keeping the default.", std::string(value), std::string(name));
+		}
+
+		settings.Width = std::max(settings.Width, 1u);
+		settings.Height = std::max(settings.Height, 1u);
+		return settings;
+	}
+
+}
+
+namespace Syndra {
+
+	class SyndraBenchApp : public Application
+	{
+	public:
+		SyndraBenchApp(const BenchSettings& settings)
+			:Application(WindowProps("Syndra Bench", settings.Width, settings.Height, true))
+		{
+			PushLayer(new BenchLayer(settings));
+		}
+
+		~SyndraBenchApp() {
+
+		}
+
+	};
+
+	Application* CreateApplication() {
+		BenchSettings settings = ParseBenchSettings(Application::GetCommandLineArgs());
+		ConfigureBenchWorkingDirectory(settings);
+		if (!std::filesystem::exists(settings.ScenePath))
+		{
+			SN_ERROR("Scene '{}' does not exist.", settings.ScenePath);
+			return nullptr;
+		}
+		// The application keeps a job system that is already running instead of starting its own.
+		JobSystem::Init(settings.Workers);
+		return new SyndraBenchApp(settings);
+	}
+
+}
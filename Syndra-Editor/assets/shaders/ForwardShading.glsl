@@ -72,7 +72,11 @@ layout(binding = 6) uniform sampler1D distribution0;
 layout(binding = 10) uniform sampler1D distribution1;
 
 //IBL
-layout(binding = 7) uniform samplerCube irradianceMap;
+layout(binding = 4) uniform EnvironmentSH
+{
+	// L2 irradiance SH (already convolved with the cosine lobe and divided by pi), rgb in xyz.
+	vec4 coefficients[9];
+} envSH;
 layout(binding = 8) uniform samplerCube prefilterMap;
 layout(binding = 9) uniform sampler2D   brdfLUT;  
 
@@ -317,6 +321,21 @@ float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
     return ggx1 * ggx2;
 }
 
+// ----------------------------------------------------------------------------
+vec3 EvaluateIrradianceSH(vec3 n)
+{
+	vec3 irradiance = envSH.coefficients[0].rgb * 0.282095
+		+ envSH.coefficients[1].rgb * (0.488603 * n.y)
+		+ envSH.coefficients[2].rgb * (0.488603 * n.z)
+		+ envSH.coefficients[3].rgb * (0.488603 * n.x)
+		+ envSH.coefficients[4].rgb * (1.092548 * n.x * n.y)
+		+ envSH.coefficients[5].rgb * (1.092548 * n.y * n.z)
+		+ envSH.coefficients[6].rgb * (0.315392 * (3.0 * n.z * n.z - 1.0))
+		+ envSH.coefficients[7].rgb * (1.092548 * n.x * n.z)
+		+ envSH.coefficients[8].rgb * (0.546274 * (n.x * n.x - n.y * n.y));
+	return max(irradiance, vec3(0.0));
+}
+
 // ----------------------------------------------------------------------------
 vec3 FresnelSchlick(float cosTheta, vec3 F0)
 {
@@ -481,7 +500,7 @@ void main(){
 	vec3 Kd = 1.0 - Ks;
 	Kd *= 1.0 - Metallic;
 
-	vec3 irradiance = texture(irradianceMap, N).rgb * push.intensity;
+	vec3 irradiance = EvaluateIrradianceSH(N) * push.intensity;
 	vec3 diffuse    = irradiance * albedo;
 
     const float MAX_REFLECTION_LOD = 4.0;
@@ -0,0 +1,46 @@
+// Compute Shader
+#type compute
+#version 460
+
+// Builds one Hi-Z level of the forward+ depth pre-pass: every texel keeps the farthest depth of the
+// 2x2 texels of the level before it, or of the depth map for level 0. Odd edges clamp, so the last
+// texel of a row or column also covers the texel the source has left over.
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+layout(binding = 0) uniform sampler2D depthMap;
+
+layout(std430, binding = 3) buffer HiZ
+{
+	float depths[];
+};
+
+layout(push_constant) uniform push
+{
+	int sourceWidth;
+	int sourceHeight;
+	int sourceOffset;	// -1 reads depthMap
+	int width;
+	int height;
+	int offset;
+} pc;
+
+float LoadSource(ivec2 texel)
+{
+	texel = min(texel, ivec2(pc.sourceWidth - 1, pc.sourceHeight - 1));
+	if (pc.sourceOffset < 0)
+		return texelFetch(depthMap, texel, 0).r;
+	return depths[pc.sourceOffset + texel.y * pc.sourceWidth + texel.x];
+}
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	if (texel.x >= pc.width || texel.y >= pc.height)
+		return;
+
+	ivec2 source = texel * 2;
+	float depth = max(
+		max(LoadSource(source), LoadSource(source + ivec2(1, 0))),
+		max(LoadSource(source + ivec2(0, 1)), LoadSource(source + ivec2(1, 1))));
+	depths[pc.offset + texel.y * pc.width + texel.x] = depth;
+}
@@ -18,11 +18,11 @@ layout(push_constant) uniform Push
 	mat4 u_trans;
 	int id;
 	float tiling;
-	int HasAlbedoMap;
-	int HasNormalMap;
-	int HasRoughnessMap;
-	int HasMetallicMap;
-	int HasAOMap;
+	int AlbedoMapIndex;
+	int MetallicMapIndex;
+	int NormalMapIndex;
+	int RoughnessMapIndex;
+	int AOMapIndex;
 	vec4 color;
 	float RoughnessFactor;
 	float MetallicFactor;
@@ -61,6 +61,7 @@ void main()
 
 #type fragment
 #version 460
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) out vec4 gPosition;
 layout(location = 1) out vec4 gNormal;
@@ -68,22 +69,19 @@ layout(location = 2) out vec4 gAlbedo;
 layout(location = 3) out vec4 gRoughMetalAO;
 layout(location = 4) out int gEntityID;
 
-layout(set = 1, binding = 0) uniform sampler2D AlbedoMap;
-layout(set = 1, binding = 1) uniform sampler2D MetallicMap;
-layout(set = 1, binding = 2) uniform sampler2D NormalMap;
-layout(set = 1, binding = 3) uniform sampler2D RoughnessMap;
-layout(set = 1, binding = 4) uniform sampler2D AOMap;
+// Bindless texture table; the *MapIndex push constants index into it, -1 when a map is unused.
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
 
 layout(push_constant) uniform Push
 {
 	mat4 u_trans;
 	int id;
 	float tiling;
-	int HasAlbedoMap;
-	int HasNormalMap;
-	int HasRoughnessMap;
-	int HasMetallicMap;
-	int HasAOMap;
+	int AlbedoMapIndex;
+	int MetallicMapIndex;
+	int NormalMapIndex;
+	int RoughnessMapIndex;
+	int AOMapIndex;
 	vec4 color;
 	float RoughnessFactor;
 	float MetallicFactor;
@@ -105,27 +103,27 @@ void main()
 {
 	vec2 uv = fs_in.uv * push.tiling;
 	vec3 normal = normalize(fs_in.worldNormal);
-	if (push.HasNormalMap == 1)
+	if (push.NormalMapIndex >= 0)
 	{
-		vec3 mapNormal = texture(NormalMap, uv).xyz * 2.0 - 1.0;
+		vec3 mapNormal = texture(u_Textures[push.NormalMapIndex], uv).xyz * 2.0 - 1.0;
 		normal = normalize(fs_in.tbn * mapNormal);
 	}
 
 	vec3 albedo = push.color.rgb;
-	if (push.HasAlbedoMap == 1)
-		albedo = texture(AlbedoMap, uv).rgb;
+	if (push.AlbedoMapIndex >= 0)
+		albedo = texture(u_Textures[push.AlbedoMapIndex], uv).rgb;
 
 	float roughness = push.RoughnessFactor;
-	if (push.HasRoughnessMap == 1)
-		roughness *= texture(RoughnessMap, uv).r;
+	if (push.RoughnessMapIndex >= 0)
+		roughness *= texture(u_Textures[push.RoughnessMapIndex], uv).r;
 
 	float metallic = push.MetallicFactor;
-	if (push.HasMetallicMap == 1)
-		metallic *= texture(MetallicMap, uv).r;
+	if (push.MetallicMapIndex >= 0)
+		metallic *= texture(u_Textures[push.MetallicMapIndex], uv).r;
 
 	float ao = push.AO;
-	if (push.HasAOMap == 1)
-		ao *= texture(AOMap, uv).r;
+	if (push.AOMapIndex >= 0)
+		ao *= texture(u_Textures[push.AOMapIndex], uv).r;
 
 	gPosition = vec4(fs_in.worldPos, 1.0);
 	gNormal = vec4(normal, 1.0);
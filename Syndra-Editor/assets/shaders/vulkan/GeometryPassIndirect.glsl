@@ -0,0 +1,148 @@
+#type vertex
+#version 460
+
+layout(location = 0) in vec3 a_pos;
+layout(location = 1) in vec2 a_uv;
+layout(location = 2) in vec3 a_normal;
+layout(location = 3) in vec3 a_tangent;
+layout(location = 4) in vec3 a_bitangent;
+
+layout(set = 0, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+	vec4 cameraPos;
+} cam;
+
+struct Instance
+{
+	mat4 transform;
+	vec4 boundingSphere;
+	uint firstIndex;
+	uint indexCount;
+	int vertexOffset;
+	uint materialIndex;
+	int entityID;
+	uint batch;
+	uint firstCommand;
+	uint padding;
+};
+
+// VulkanGpuScene instances; the culling pass sets firstInstance to the instance index.
+layout(std430, set = 0, binding = 10) readonly buffer Instances
+{
+	Instance instances[];
+};
+
+struct VS_OUT
+{
+	vec3 worldPos;
+	vec3 worldNormal;
+	vec2 uv;
+	mat3 tbn;
+};
+
+layout(location = 0) out VS_OUT vs_out;
+layout(location = 8) out flat int v_entityID;
+layout(location = 9) out flat uint v_materialIndex;
+
+void main()
+{
+	Instance instance = instances[gl_InstanceIndex];
+	vec4 worldPos = instance.transform * vec4(a_pos, 1.0);
+	mat3 normalMatrix = transpose(inverse(mat3(instance.transform)));
+
+	vec3 T = normalize(normalMatrix * a_tangent);
+	vec3 N = normalize(normalMatrix * a_normal);
+	T = normalize(T - dot(T, N) * N);
+	vec3 B = cross(N, T);
+
+	vs_out.worldPos = worldPos.xyz;
+	vs_out.worldNormal = N;
+	vs_out.uv = a_uv;
+	vs_out.tbn = mat3(T, B, N);
+	v_entityID = instance.entityID;
+	v_materialIndex = instance.materialIndex;
+
+	gl_Position = cam.u_ViewProjection * worldPos;
+}
+
+#type fragment
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) out vec4 gPosition;
+layout(location = 1) out vec4 gNormal;
+layout(location = 2) out vec4 gAlbedo;
+layout(location = 3) out vec4 gRoughMetalAO;
+layout(location = 4) out int gEntityID;
+
+struct Material
+{
+	vec4 color;
+	float RoughnessFactor;
+	float MetallicFactor;
+	float AO;
+	float tiling;
+	int AlbedoMapIndex;
+	int MetallicMapIndex;
+	int NormalMapIndex;
+	int RoughnessMapIndex;
+	int AOMapIndex;
+	int padding0;
+	int padding1;
+	int padding2;
+};
+
+layout(std430, set = 0, binding = 11) readonly buffer Materials
+{
+	Material materials[];
+};
+
+// Bindless texture table; the material *MapIndex fields index into it, -1 when a map is unused.
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+
+struct VS_OUT
+{
+	vec3 worldPos;
+	vec3 worldNormal;
+	vec2 uv;
+	mat3 tbn;
+};
+
+layout(location = 0) in VS_OUT fs_in;
+layout(location = 8) in flat int v_entityID;
+layout(location = 9) in flat uint v_materialIndex;
+
+void main()
+{
+	Material material = materials[v_materialIndex];
+	vec2 uv = fs_in.uv * material.tiling;
+	vec3 normal = normalize(fs_in.worldNormal);
+	if (material.NormalMapIndex >= 0)
+	{
+		vec3 mapNormal = texture(u_Textures[nonuniformEXT(material.NormalMapIndex)], uv).xyz * 2.0 - 1.0;
+		normal = normalize(fs_in.tbn * mapNormal);
+	}
+
+	vec3 albedo = material.color.rgb;
+	if (material.AlbedoMapIndex >= 0)
+		albedo = texture(u_Textures[nonuniformEXT(material.AlbedoMapIndex)], uv).rgb;
+
+	float roughness = material.RoughnessFactor;
+	if (material.RoughnessMapIndex >= 0)
+		roughness *= texture(u_Textures[nonuniformEXT(material.RoughnessMapIndex)], uv).r;
+
+	float metallic = material.MetallicFactor;
+	if (material.MetallicMapIndex >= 0)
+		metallic *= texture(u_Textures[nonuniformEXT(material.MetallicMapIndex)], uv).r;
+
+	float ao = material.AO;
+	if (material.AOMapIndex >= 0)
+		ao *= texture(u_Textures[nonuniformEXT(material.AOMapIndex)], uv).r;
+
+	gPosition = vec4(fs_in.worldPos, 1.0);
+	gNormal = vec4(normal, 1.0);
+	gAlbedo = vec4(albedo, 1.0);
+	gRoughMetalAO = vec4(roughness, metallic, ao, 1.0);
+	gEntityID = v_entityID;
+}
@@ -0,0 +1,45 @@
+#type compute
+#version 460
+
+// Builds one level of a VulkanHiZPyramid: every texel keeps the farthest depth of the 2x2 texels
+// of the level before it, or of the depth attachment for level 0. Odd edges clamp, so the last
+// texel of a row or column also covers the texel the source has left over.
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(set = 0, binding = 0) uniform sampler2D depthMap;
+
+layout(std430, set = 0, binding = 14) buffer HiZ
+{
+	float depths[];
+};
+
+layout(push_constant) uniform Push
+{
+	int sourceWidth;
+	int sourceHeight;
+	int sourceOffset;	// -1 reads depthMap
+	int width;
+	int height;
+	int offset;
+} push;
+
+float LoadSource(ivec2 texel)
+{
+	texel = min(texel, ivec2(push.sourceWidth - 1, push.sourceHeight - 1));
+	if (push.sourceOffset < 0)
+		return texelFetch(depthMap, texel, 0).r;
+	return depths[push.sourceOffset + texel.y * push.sourceWidth + texel.x];
+}
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	if (texel.x >= push.width || texel.y >= push.height)
+		return;
+
+	ivec2 source = texel * 2;
+	float depth = max(
+		max(LoadSource(source), LoadSource(source + ivec2(1, 0))),
+		max(LoadSource(source + ivec2(0, 1)), LoadSource(source + ivec2(1, 1))));
+	depths[push.offset + texel.y * push.width + texel.x] = depth;
+}
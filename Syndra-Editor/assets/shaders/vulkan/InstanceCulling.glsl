@@ -0,0 +1,213 @@
+#type compute
+#version 460
+
+// Culls VulkanGpuScene instances against a frustum and appends the survivors to the indirect
+// command range of their batch; counts[batch] ends up as the draw count of that batch.
+//
+// With occlusion culling the geometry pass runs in two phases. The early phase also tests the
+// frustum survivors against the Hi-Z pyramid of the previous frame and flags the ones it hides;
+// the late phase re-tests only the flagged instances against the pyramid of this frame's early
+// depth and draws the ones that became visible. counts[batchCount] and counts[batchCount + 1]
+// accumulate the instances and triangles a phase left occluded.
+layout(local_size_x = 64) in;
+
+const int PhaseFrustum = 0;
+const int PhaseEarly = 1;
+const int PhaseLate = 2;
+
+struct Instance
+{
+	mat4 transform;
+	vec4 boundingSphere;
+	uint firstIndex;
+	uint indexCount;
+	int vertexOffset;
+	uint materialIndex;
+	int entityID;
+	uint batch;
+	uint firstCommand;
+	uint padding;
+};
+
+struct DrawCommand
+{
+	uint indexCount;
+	uint instanceCount;
+	uint firstIndex;
+	int vertexOffset;
+	uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 10) readonly buffer Instances
+{
+	Instance instances[];
+};
+
+layout(std430, set = 0, binding = 12) writeonly buffer DrawCommands
+{
+	DrawCommand commands[];
+};
+
+layout(std430, set = 0, binding = 13) buffer DrawCounts
+{
+	uint counts[];
+};
+
+layout(std430, set = 0, binding = 14) readonly buffer HiZ
+{
+	float depths[];
+};
+
+layout(std430, set = 0, binding = 15) buffer OcclusionFlags
+{
+	uint occluded[];
+};
+
+// See VulkanHiZPyramid::Uniforms.
+layout(std140, set = 0, binding = 9) uniform Occlusion
+{
+	mat4 viewProjection;
+	ivec4 size;
+	ivec4 levels[16];
+} occlusion;
+
+layout(push_constant) uniform Push
+{
+	vec4 plane0;
+	vec4 plane1;
+	vec4 plane2;
+	vec4 plane3;
+	vec4 plane4;
+	vec4 plane5;
+	int instanceCount;
+	int frustumCulling;
+	int phase;
+	int batchCount;
+} push;
+
+// World-space center and radius; 0 radius is never culled.
+vec4 WorldSphere(Instance instance)
+{
+	vec3 center = (instance.transform * vec4(instance.boundingSphere.xyz, 1.0)).xyz;
+	float scale = max(max(length(instance.transform[0].xyz), length(instance.transform[1].xyz)), max(length(instance.transform[2].xyz), 1e-4));
+	return vec4(center, instance.boundingSphere.w <= 1e-6 ? 0.0 : instance.boundingSphere.w * scale);
+}
+
+bool IsVisible(vec4 sphere)
+{
+	if (push.frustumCulling == 0 || sphere.w <= 0.0)
+		return true;
+
+	vec4 planes[6] = vec4[6](push.plane0, push.plane1, push.plane2, push.plane3, push.plane4, push.plane5);
+	for (int i = 0; i < 6; ++i)
+	{
+		if (dot(planes[i].xyz, sphere.xyz) + planes[i].w < -sphere.w)
+			return false;
+	}
+
+	return true;
+}
+
+// True when the box around the sphere is farther than every depth the pyramid holds under it.
+// Boxes crossing the near plane or leaving the screen entirely are never occluded.
+bool IsOccluded(vec4 sphere)
+{
+	if (occlusion.size.w == 0 || sphere.w <= 0.0)
+		return false;
+
+	vec2 uvMin = vec2(1e30);
+	vec2 uvMax = vec2(-1e30);
+	float nearest = 1e30;
+	for (int corner = 0; corner < 8; ++corner)
+	{
+		vec3 offset = vec3(
+			(corner & 1) != 0 ? sphere.w : -sphere.w,
+			(corner & 2) != 0 ? sphere.w : -sphere.w,
+			(corner & 4) != 0 ? sphere.w : -sphere.w);
+		vec4 clip = occlusion.viewProjection * vec4(sphere.xyz + offset, 1.0);
+		if (clip.w <= 1e-5 || clip.z < 0.0)
+			return false;
+
+		vec3 ndc = clip.xyz / clip.w;
+		vec2 uv = ndc.xy * 0.5 + 0.5;
+		uvMin = min(uvMin, uv);
+		uvMax = max(uvMax, uv);
+		nearest = min(nearest, ndc.z);
+	}
+	if (any(greaterThan(uvMin, vec2(1.0))) || any(lessThan(uvMax, vec2(0.0))))
+		return false;
+
+	vec2 depthSize = vec2(occlusion.size.xy);
+	vec2 pixelMin = clamp(uvMin * depthSize, vec2(0.0), depthSize - 1.0);
+	vec2 pixelMax = clamp(uvMax * depthSize, vec2(0.0), depthSize - 1.0);
+	// A texel of level k covers 2^(k + 1) pixels, so the box spans at most 2x2 texels of this level.
+	float extent = max(pixelMax.x - pixelMin.x, pixelMax.y - pixelMin.y);
+	int level = clamp(int(ceil(log2(max(extent, 1.0)))) - 1, 0, occlusion.size.z - 1);
+	ivec4 info = occlusion.levels[level];
+	ivec2 texelMin = min(ivec2(pixelMin) >> (level + 1), info.xy - 1);
+	ivec2 texelMax = min(ivec2(pixelMax) >> (level + 1), info.xy - 1);
+
+	float farthest = 0.0;
+	for (int y = texelMin.y; y <= texelMax.y; ++y)
+	{
+		for (int x = texelMin.x; x <= texelMax.x; ++x)
+			farthest = max(farthest, depths[info.z + y * info.x + x]);
+	}
+
+	return nearest > farthest;
+}
+
+void CountOccluded(Instance instance)
+{
+	atomicAdd(counts[push.batchCount], 1u);
+	atomicAdd(counts[push.batchCount + 1], instance.indexCount / 3u);
+}
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(push.instanceCount))
+		return;
+
+	Instance instance = instances[index];
+	vec4 sphere = WorldSphere(instance);
+	if (push.phase == PhaseLate)
+	{
+		if (occluded[index] == 0u)
+			return;
+		if (IsOccluded(sphere))
+		{
+			CountOccluded(instance);
+			return;
+		}
+	}
+	else
+	{
+		if (!IsVisible(sphere))
+		{
+			if (push.phase == PhaseEarly)
+				occluded[index] = 0u;
+			return;
+		}
+
+		if (push.phase == PhaseEarly)
+		{
+			bool hidden = IsOccluded(sphere);
+			occluded[index] = hidden ? 1u : 0u;
+			if (hidden)
+			{
+				CountOccluded(instance);
+				return;
+			}
+		}
+	}
+
+	uint slot = atomicAdd(counts[instance.batch], 1u);
+	DrawCommand command;
+	command.indexCount = instance.indexCount;
+	command.instanceCount = 1u;
+	command.firstIndex = instance.firstIndex;
+	command.vertexOffset = instance.vertexOffset;
+	command.firstInstance = index;
+	commands[instance.firstCommand + slot] = command;
+}
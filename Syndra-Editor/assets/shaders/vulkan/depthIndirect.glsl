@@ -0,0 +1,41 @@
+#type vertex
+#version 460
+
+layout(location = 0) in vec3 a_pos;
+
+layout(set = 0, binding = 3) uniform ShadowData
+{
+	mat4 lightViewProj;
+} shadowData;
+
+struct Instance
+{
+	mat4 transform;
+	vec4 boundingSphere;
+	uint firstIndex;
+	uint indexCount;
+	int vertexOffset;
+	uint materialIndex;
+	int entityID;
+	uint batch;
+	uint firstCommand;
+	uint padding;
+};
+
+// VulkanGpuScene instances; the culling pass sets firstInstance to the instance index.
+layout(std430, set = 0, binding = 10) readonly buffer Instances
+{
+	Instance instances[];
+};
+
+void main()
+{
+	gl_Position = shadowData.lightViewProj * instances[gl_InstanceIndex].transform * vec4(a_pos, 1.0);
+}
+
+#type fragment
+#version 460
+
+void main()
+{
+}
@@ -6,14 +6,22 @@
 #include "imgui.h"
 #include "ImGuizmo.h"
 
+#include "Engine/Core/AllocationTracker.h"
 #include "Engine/Core/Instrument.h"
+#include "Engine/Core/MemoryTracker.h"
+#include "Engine/Renderer/EnvironmentCache.h"
 #include "Engine/Renderer/RendererAPI.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/TextureLibrary.h"
+#include "Engine/Renderer/TextureStreamer.h"
 #include "Engine/Utils/Math.h"
 #include "Engine/Scene/SceneSerializer.h"
 #include "Engine/Utils/PlatformUtils.h"
 #include "Engine/ImGui/IconsFontAwesome5.h"
 
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 namespace Syndra {
 
@@ -41,11 +49,12 @@ namespace Syndra {
 
 		auto& app = Application::Get();
 		m_ActiveScene->m_Camera->SetViewportSize((float)app.GetWindow().GetWidth(), (float)app.GetWindow().GetHeight());
-		m_FullScreenIcon = Texture2D::Create("assets/Icons/fullscreen.png",false);
-		m_GizmosIcon = Texture2D::Create("assets/Icons/globe.png",false);
-		m_TransformIcon = Texture2D::Create("assets/Icons/Transform.png",false);
-		m_RotationIcon = Texture2D::Create("assets/Icons/Rotation.png",false);
-		m_ScaleIcon = Texture2D::Create("assets/Icons/scale.png",false);
+		m_FullScreenIcon = TextureLibrary::Load("assets/Icons/fullscreen.png", false);
+		m_GizmosIcon = TextureLibrary::Load("assets/Icons/globe.png", false);
+		m_TransformIcon = TextureLibrary::Load("assets/Icons/Transform.png", false);
+		m_RotationIcon = TextureLibrary::Load("assets/Icons/Rotation.png", false);
+		m_ScaleIcon = TextureLibrary::Load("assets/Icons/scale.png", false);
+		app.SetOnDemandRendering(true);
 	}
 
 	void EditorLayer::OnDetach()
@@ -66,12 +75,16 @@ namespace Syndra {
 			m_ActiveScene->OnCameraUpdate(ts);
 		}
 
-		m_ActiveScene->OnUpdateEditor(ts);
-
+		// Between edits the viewport keeps showing its last image and only ImGui is redrawn.
+		if (!Application::Get().IsOnDemandRendering() || m_ActiveScene->IsDirty())
+			m_ActiveScene->OnUpdateEditor(ts);
 	}
 
 	void EditorLayer::OnImGuiRender()
 	{
+		// A widget released this frame (a button or checkbox click) was still active here.
+		const bool widgetWasActive = ImGui::IsAnyItemActive();
+
 		//Dock Space
 		UI::BeginDockSpace();
 
@@ -141,6 +154,17 @@ namespace Syndra {
 
 			ImGui::End();
 		}
+
+		// Panels edit components and renderer settings in place, so any widget interaction
+		// counts as a scene change.
+		if (widgetWasActive ||
+			ImGui::IsAnyItemActive() ||
+			ImGui::GetCurrentContext()->ActiveIdHasBeenEditedThisFrame ||
+			ImGui::GetDragDropPayload() != nullptr ||
+			ImGuizmo::IsUsing())
+		{
+			m_ActiveScene->Invalidate();
+		}
 	}
 
 	void EditorLayer::OnEvent(Event& event)
@@ -257,6 +281,7 @@ namespace Syndra {
 		if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y && !altIsDown && m_ViewportHovered && !ImGuizmo::IsOver())
 		{
 			auto& mousePickFB = m_ActiveScene->GetMainFrameBuffer();
+			RenderThread::Synchronize();
 			mousePickFB->Bind();
 			int pixelData = mousePickFB->ReadPixel(SceneRenderer::GetMouseTextureID(), mouseX, mouseY);
 			if (pixelData != -1) {
@@ -481,9 +506,177 @@ namespace Syndra {
 		ImGui::Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
 		ImGui::Text("%d active windows (%d visible)", io.MetricsActiveWindows, io.MetricsRenderWindows);
 
+		const FrameTimeHistogram& frameTimes = Instrumentor::Get().GetFrameTimeHistogram();
+		const FrameTimeStats frameTimeStats = frameTimes.GetStats();
+		if (frameTimeStats.SampleCount > 0)
+		{
+			ImGui::Text("Frame time p50 %.2f / p95 %.2f / p99 %.2f ms, max %.2f ms (last %u frames)",
+				frameTimeStats.P50Ms, frameTimeStats.P95Ms, frameTimeStats.P99Ms, frameTimeStats.MaxMs, frameTimeStats.SampleCount);
+			// Up to twice the p99, so the spikes beyond it pile up in the last bucket.
+			const double histogramMaxMs = std::max(frameTimeStats.P99Ms * 2.0, 1.0);
+			const std::vector<float> buckets = frameTimes.GetBuckets(64, histogramMaxMs);
+			const std::string histogramLabel = "0 - " + std::to_string(static_cast<int>(std::ceil(histogramMaxMs))) + " ms";
+			ImGui::PlotHistogram("##FrameTimeHistogram", buckets.data(), static_cast<int>(buckets.size()), 0,
+				histogramLabel.c_str(), 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+		}
+		if (AllocationTracker::IsEnabled())
+			ImGui::Text("Heap allocations: %llu last frame", static_cast<unsigned long long>(Application::Get().GetFrameAllocationCount()));
+
+		Application& app = Application::Get();
+		bool onDemand = app.IsOnDemandRendering();
+		if (ImGui::Checkbox("Render on demand", &onDemand))
+			app.SetOnDemandRendering(onDemand);
+		ImGui::SameLine();
+		ImGui::Text("main thread idle %.0f%%", app.GetIdleFraction() * 100.0f);
+		// All threads (render thread, jobs, drivers), so the mode can be compared on and off.
+		ImGui::Text("Process CPU %.1f%% of one core", app.GetProcessCpuUsage() * 100.0f);
+
+		ImGui::Separator();
+		ImGui::Text("Textures");
+		const TextureLibraryStats textureStats = TextureLibrary::GetStats();
+		ImGui::Text("%u unique / %llu requested (%llu shared)",
+			textureStats.UniqueTextures,
+			static_cast<unsigned long long>(textureStats.Requests),
+			static_cast<unsigned long long>(textureStats.CacheHits));
+		ImGui::Text("Loaded %.2f MB, saved %.2f MB",
+			static_cast<double>(textureStats.BytesLoaded) / (1024.0 * 1024.0),
+			static_cast<double>(textureStats.BytesSaved) / (1024.0 * 1024.0));
+
+		ImGui::Separator();
+		ImGui::Text("Texture Streaming");
+		const TextureStreamingStats streamingStats = TextureStreamer::GetStats();
+		if (streamingStats.HasDeviceMemory)
+		{
+			ImGui::Text("Device memory %.1f / %.1f MB",
+				static_cast<double>(streamingStats.DeviceMemory.Usage) / (1024.0 * 1024.0),
+				static_cast<double>(streamingStats.DeviceMemory.Budget) / (1024.0 * 1024.0));
+		}
+		else
+		{
+			ImGui::Text("Device memory: not reported by the driver");
+		}
+		ImGui::Text("Resident %.2f MB, requested %.2f MB, budget %.2f MB",
+			static_cast<double>(streamingStats.ResidentBytes) / (1024.0 * 1024.0),
+			static_cast<double>(streamingStats.RequestedBytes) / (1024.0 * 1024.0),
+			static_cast<double>(streamingStats.Budget) / (1024.0 * 1024.0));
+		ImGui::Text("%u streamed textures, %u loads pending, %u levels trimmed",
+			streamingStats.StreamedTextures, streamingStats.PendingLoads, streamingStats.TrimmedLevels);
+		ImGui::Text("Streamed in %.2f MB", static_cast<double>(streamingStats.StreamedInBytes) / (1024.0 * 1024.0));
+
+		bool streamingEnabled = TextureStreamer::IsEnabled();
+		if (ImGui::Checkbox("Stream mips", &streamingEnabled))
+			TextureStreamer::SetEnabled(streamingEnabled);
+		int budgetMB = static_cast<int>(TextureStreamer::GetBudget() / (1024 * 1024));
+		ImGui::SetNextItemWidth(180.0f);
+		if (ImGui::InputInt("Budget MB (0 = auto)", &budgetMB))
+			TextureStreamer::SetBudget(static_cast<uint64_t>(std::max(budgetMB, 0)) * 1024 * 1024);
+
+		ImGui::Separator();
+		ImGui::Text("Memory");
+		if (streamingStats.DeviceMemory.BlockBytes > 0)
+		{
+			ImGui::Text("Allocator %.1f MB in resources, %.1f MB in blocks",
+				static_cast<double>(streamingStats.DeviceMemory.AllocationBytes) / (1024.0 * 1024.0),
+				static_cast<double>(streamingStats.DeviceMemory.BlockBytes) / (1024.0 * 1024.0));
+		}
+
+		const ImVec4 overBudgetColor = ImVec4(1.0f, 0.35f, 0.3f, 1.0f);
+		auto drawMemoryRow = [&](const char* name, const MemoryUsage& usage)
+		{
+			ImGui::TableNextRow();
+			if (usage.IsOverBudget())
+				ImGui::PushStyleColor(ImGuiCol_Text, overBudgetColor);
+			ImGui::TableSetColumnIndex(0);
+			ImGui::TextUnformatted(name);
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%.2f", static_cast<double>(usage.Bytes) / (1024.0 * 1024.0));
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%.2f", static_cast<double>(usage.PeakBytes) / (1024.0 * 1024.0));
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%u", usage.Allocations);
+			ImGui::TableSetColumnIndex(4);
+			if (usage.BudgetBytes > 0)
+				ImGui::Text("%.2f", static_cast<double>(usage.BudgetBytes) / (1024.0 * 1024.0));
+			else
+				ImGui::TextUnformatted("-");
+			if (usage.IsOverBudget())
+				ImGui::PopStyleColor();
+		};
+
+		const ImGuiTableFlags memoryTableFlags =
+			ImGuiTableFlags_RowBg |
+			ImGuiTableFlags_Borders |
+			ImGuiTableFlags_SizingStretchProp;
+		for (uint32_t domainIndex = 0; domainIndex < static_cast<uint32_t>(MemoryDomain::Count); ++domainIndex)
+		{
+			const MemoryDomain domain = static_cast<MemoryDomain>(domainIndex);
+			const std::string tableID = std::string("MemoryTable") + MemoryTracker::DomainToString(domain);
+			if (!ImGui::BeginTable(tableID.c_str(), 5, memoryTableFlags))
+				continue;
+
+			ImGui::TableSetupColumn(MemoryTracker::DomainToString(domain), ImGuiTableColumnFlags_WidthStretch, 2.0f);
+			ImGui::TableSetupColumn("MB", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+			ImGui::TableSetupColumn("Peak MB", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+			ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthStretch, 0.8f);
+			ImGui::TableSetupColumn("Budget MB", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+			ImGui::TableHeadersRow();
+
+			for (uint32_t categoryIndex = 0; categoryIndex < static_cast<uint32_t>(MemoryCategory::Count); ++categoryIndex)
+			{
+				const MemoryCategory category = static_cast<MemoryCategory>(categoryIndex);
+				const MemoryUsage usage = MemoryTracker::GetUsage(domain, category);
+				if (usage.PeakBytes == 0 && usage.BudgetBytes == 0)
+					continue;
+				drawMemoryRow(MemoryTracker::CategoryToString(category), usage);
+			}
+			drawMemoryRow("Total", MemoryTracker::GetTotal(domain));
+			ImGui::EndTable();
+		}
+		if (ImGui::Button("Reset peaks"))
+			MemoryTracker::ResetPeaks();
+
+		ImGui::Separator();
+		ImGui::Text("Environment");
+		const EnvironmentCacheStats environmentStats = EnvironmentCache::GetStats();
+		if (environmentStats.WarmLoads + environmentStats.ColdLoads > 0)
+		{
+			ImGui::Text("Last switch %.1f ms (%s)", environmentStats.LastLoadMs, environmentStats.LastLoadWarm ? "cached" : "cold");
+			ImGui::Text("Cold: %u loads, avg %.1f ms", environmentStats.ColdLoads,
+				environmentStats.ColdLoads > 0 ? environmentStats.TotalColdMs / environmentStats.ColdLoads : 0.0);
+			ImGui::Text("Warm: %u loads, avg %.1f ms", environmentStats.WarmLoads,
+				environmentStats.WarmLoads > 0 ? environmentStats.TotalWarmMs / environmentStats.WarmLoads : 0.0);
+		}
+		if (environmentStats.LastProjectionMs >= 0.0)
+			ImGui::Text("SH projection %.2f ms", environmentStats.LastProjectionMs);
+		bool environmentCacheEnabled = EnvironmentCache::IsEnabled();
+		if (ImGui::Checkbox("Cache IBL maps", &environmentCacheEnabled))
+			EnvironmentCache::SetEnabled(environmentCacheEnabled);
+
 		ImGui::Separator();
 		ImGui::Text("CPU Timings");
 #if SN_PROFILE
+		bool profilingEnabled = Instrumentor::IsEnabled();
+		if (ImGui::Checkbox("Enabled", &profilingEnabled))
+			Instrumentor::SetEnabled(profilingEnabled);
+		ImGui::SameLine();
+		static int captureFrameCount = 120;
+		const uint32_t captureFramesLeft = Instrumentor::Get().GetCaptureFramesLeft();
+		if (captureFramesLeft > 0)
+		{
+			ImGui::Text("Capturing, %u frames left", captureFramesLeft);
+		}
+		else
+		{
+			if (ImGui::Button("Capture"))
+			{
+				if (!Instrumentor::Get().CaptureFrames(static_cast<uint32_t>(captureFrameCount), "Capture.json"))
+					SN_CORE_WARN("Could not start a profile capture while another session is recording.");
+			}
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(120.0f);
+			ImGui::SliderInt("Frames##Capture", &captureFrameCount, 1, 1000);
+		}
+
 		static bool freezeCpuTimings = false;
 		static bool wasFreezeCpuTimings = false;
 		static CpuFrameProfile frozenCpuFrame = {};
@@ -503,16 +696,20 @@ namespace Syndra {
 			frozenCpuFrame = Instrumentor::Get().GetAveragedCpuFrameProfile(static_cast<size_t>(averageFrameCount));
 		wasFreezeCpuTimings = freezeCpuTimings;
 
-		CpuFrameProfile cpuFrame = freezeCpuTimings
-			? frozenCpuFrame
-			: Instrumentor::Get().GetAveragedCpuFrameProfile(static_cast<size_t>(averageFrameCount));
+		// The frozen snapshot is read in place rather than copied, tree and all, every frame.
+		CpuFrameProfile liveCpuFrame;
+		if (!freezeCpuTimings)
+			liveCpuFrame = Instrumentor::Get().GetAveragedCpuFrameProfile(static_cast<size_t>(averageFrameCount));
+		const CpuFrameProfile& cpuFrame = freezeCpuTimings ? frozenCpuFrame : liveCpuFrame;
 		if (!cpuFrame.Valid || cpuFrame.Root.Name.empty())
 		{
-			ImGui::TextDisabled("Waiting for profiling data...");
+			ImGui::TextDisabled(profilingEnabled ? "Waiting for profiling data..." : "Profiling is disabled.");
 		}
 		else
 		{
 			ImGui::Text("Frame CPU: %.3f ms", cpuFrame.FrameTimeMs);
+			if (!cpuFrame.Gpu.Name.empty())
+				ImGui::Text("Frame GPU: %.3f ms (passes, resolved a few frames late)", cpuFrame.Gpu.TotalTimeMs);
 			ImGui::Text("Source: %s", freezeCpuTimings ? "Frozen snapshot" : "Rolling average");
 
 			const ImVec2 tableSize = ImVec2(0.0f, 320.0f);
@@ -568,9 +765,25 @@ namespace Syndra {
 				};
 
 				drawNode(drawNode, cpuFrame.Root, cpuFrame.Root.TotalTimeMs, "");
+				for (const CpuProfileNode& thread : cpuFrame.Threads)
+					drawNode(drawNode, thread, cpuFrame.Root.TotalTimeMs, "");
+				if (!cpuFrame.Gpu.Name.empty())
+					drawNode(drawNode, cpuFrame.Gpu, cpuFrame.Gpu.TotalTimeMs, "");
 				ImGui::EndTable();
 			}
 		}
+
+		static double scopeOverheadNs = 0.0;
+		if (ImGui::Button("Measure Scope Overhead"))
+			scopeOverheadNs = Instrumentor::MeasureScopeOverhead();
+		if (scopeOverheadNs > 0.0)
+		{
+			ImGui::SameLine();
+			ImGui::Text("%.1f ns per scope", scopeOverheadNs);
+		}
+		const uint64_t droppedScopes = Instrumentor::Get().GetDroppedScopeCount();
+		if (droppedScopes > 0)
+			ImGui::TextDisabled("%llu scopes dropped by full buffers", static_cast<unsigned long long>(droppedScopes));
 #else
 		ImGui::TextDisabled("CPU profiling is disabled in this build.");
 #endif
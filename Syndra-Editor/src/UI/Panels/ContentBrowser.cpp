@@ -1,6 +1,7 @@
 #include "lpch.h"
 #include "ContentBrowser.h"
 #include "Engine/ImGui/ImGuiLayer.h"
+#include "Engine/Renderer/TextureLibrary.h"
 
 namespace Syndra {
 
@@ -8,7 +9,7 @@ namespace Syndra {
 	ContentBrowser::ContentBrowser()
 		:m_Directory("assets")
 	{
-		m_SceneTexture = Texture2D::Create("assets/Icons/globe.png");
+		m_SceneTexture = TextureLibrary::Load("assets/Icons/globe.png");
 		m_DirIterator = std::filesystem::directory_iterator(m_Directory);
 	}
 
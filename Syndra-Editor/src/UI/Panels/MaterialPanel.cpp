@@ -2,13 +2,14 @@
 #include "MaterialPanel.h"
 #include "Engine/Utils/PlatformUtils.h"
 #include "Engine/ImGui/ImGuiLayer.h"
+#include "Engine/Renderer/TextureLibrary.h"
 
 
 namespace Syndra {
 
 	MaterialPanel::MaterialPanel()
 	{
-		m_EmptyTexture = Texture2D::Create("assets/Models/cube/default.png");
+		m_EmptyTexture = TextureLibrary::Load("assets/Models/cube/default.png");
 		m_TextureId = ImGuiLayer::GetTextureID(m_EmptyTexture->GetRendererID());
 	}
 
@@ -67,7 +68,7 @@ namespace Syndra {
 						auto path = FileDialogs::OpenFile("Syndra Texture (*.*)\0*.*\0");
 						if (path) {
 							//Add texture as sRGB color space if it is binded to 0 (diffuse texture binding)
-							materialTextures[sampler.binding] = Texture2D::Create(*path);
+							materialTextures[sampler.binding] = TextureLibrary::Load(*path);
 						}
 					}
 
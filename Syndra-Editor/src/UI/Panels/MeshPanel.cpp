@@ -1,6 +1,7 @@
 #include "lpch.h"
 #include "MeshPanel.h"
 #include "Engine/Utils/PlatformUtils.h"
+#include "Engine/Renderer/RenderThread.h"
 #include "Engine/Scene/Entity.h"
 
 namespace Syndra {
@@ -41,6 +42,8 @@ namespace Syndra {
 					}
 
 					Model loadedModel(*path);
+					// The model is replaced in place; the packet in flight still draws the old meshes.
+					RenderThread::Synchronize();
 					auto& meshComponent = entity.GetComponent<MeshComponent>();
 					Scene* scene = Entity::s_Scene;
 
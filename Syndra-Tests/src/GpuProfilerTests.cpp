@@ -0,0 +1,280 @@
+#include "lpch.h"
+
+#include "Engine/Renderer/GpuProfiler.h"
+
+#include <cstdio>
+#include <string>
+
+// Drives GpuProfiler through a fake query backend: timestamps are whatever the test's GPU clock
+// reads when a query is written, and a slot's queries only resolve once the test marks them done.
+// Returns non-zero when a check fails.
+
+namespace {
+
+	using Syndra::CpuProfileNode;
+	using Syndra::GpuProfiler;
+
+	int s_Failures = 0;
+
+	void Check(bool condition, const char* expression, const char* test, int line)
+	{
+		if (condition)
+			return;
+
+		++s_Failures;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", test, line, expression);
+	}
+
+#define SN_TEST_CHECK(condition) Check((condition), #condition, __func__, __LINE__)
+
+	constexpr uint64_t kMillisecond = 1000000;
+
+	bool IsNear(double value, double expected)
+	{
+		return value > expected - 1.0e-6 && value < expected + 1.0e-6;
+	}
+
+	class FakeGpuProfiler : public GpuProfiler
+	{
+	public:
+		explicit FakeGpuProfiler(uint32_t slotCount)
+			: m_Timestamps(slotCount), m_Done(slotCount, false)
+		{
+		}
+
+		virtual bool IsSupported() const override { return true; }
+
+		// The slot the next BeginFrame records into, like a backend's frame-in-flight index.
+		uint32_t Slot = 0;
+		uint64_t GpuTimeNs = 0;
+		uint32_t Writes = 0;
+		uint32_t Resets = 0;
+		std::vector<CpuProfileNode> Published;
+
+		void MarkDone(uint32_t slot) { m_Done[slot] = true; }
+	protected:
+		virtual uint32_t GetFrameSlot() const override { return Slot; }
+		virtual uint32_t GetFrameSlotCount() const override { return static_cast<uint32_t>(m_Timestamps.size()); }
+
+		virtual bool ReadTimestamps(uint32_t slot, uint32_t queryCount, std::vector<uint64_t>& timestampsNs) override
+		{
+			if (!m_Done[slot] || m_Timestamps[slot].size() < queryCount)
+				return false;
+
+			timestampsNs.assign(m_Timestamps[slot].begin(), m_Timestamps[slot].begin() + queryCount);
+			return true;
+		}
+
+		virtual bool ResetQueries(uint32_t slot) override
+		{
+			++Resets;
+			m_Timestamps[slot].clear();
+			m_Done[slot] = false;
+			return true;
+		}
+
+		virtual void WriteTimestamp(uint32_t slot, uint32_t query) override
+		{
+			++Writes;
+			if (m_Timestamps[slot].size() <= query)
+				m_Timestamps[slot].resize(query + 1);
+			m_Timestamps[slot][query] = GpuTimeNs;
+		}
+
+		virtual void PublishFrame(CpuProfileNode gpuFrame) override
+		{
+			Published.push_back(std::move(gpuFrame));
+		}
+	private:
+		std::vector<std::vector<uint64_t>> m_Timestamps;
+		std::vector<bool> m_Done;
+	};
+
+	// Depth 0-2 ms, then Lighting 3-8 ms with Sky 4-5 ms nested in it.
+	void RecordPasses(FakeGpuProfiler& profiler)
+	{
+		profiler.GpuTimeNs = 0;
+		profiler.BeginScope("Depth");
+		profiler.GpuTimeNs = 2 * kMillisecond;
+		profiler.EndScope();
+		profiler.GpuTimeNs = 3 * kMillisecond;
+		profiler.BeginScope("Lighting");
+		profiler.GpuTimeNs = 4 * kMillisecond;
+		profiler.BeginScope("Sky");
+		profiler.GpuTimeNs = 5 * kMillisecond;
+		profiler.EndScope();
+		profiler.GpuTimeNs = 8 * kMillisecond;
+		profiler.EndScope();
+	}
+
+	// A frame is published when its slot comes around again, as a tree of its nested scopes.
+	void TestNestedScopes()
+	{
+		FakeGpuProfiler profiler(2);
+		profiler.Slot = 0;
+		profiler.BeginFrame();
+		RecordPasses(profiler);
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Writes == 6);
+		SN_TEST_CHECK(profiler.Published.empty());
+		profiler.MarkDone(0);
+
+		// Another slot in between does not touch slot 0's queries.
+		profiler.Slot = 1;
+		profiler.BeginFrame();
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Published.empty());
+
+		profiler.Slot = 0;
+		profiler.BeginFrame();
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Published.size() == 1);
+		if (profiler.Published.size() != 1)
+			return;
+
+		const CpuProfileNode& root = profiler.Published[0];
+		SN_TEST_CHECK(root.Name == "GPU");
+		SN_TEST_CHECK(IsNear(root.TotalTimeMs, 8.0));
+		// The 1 ms gap between the passes.
+		SN_TEST_CHECK(IsNear(root.SelfTimeMs, 1.0));
+		SN_TEST_CHECK(root.Children.size() == 2);
+		if (root.Children.size() != 2)
+			return;
+
+		const CpuProfileNode& depth = root.Children[0];
+		SN_TEST_CHECK(depth.Name == "Depth");
+		SN_TEST_CHECK(IsNear(depth.TotalTimeMs, 2.0));
+		SN_TEST_CHECK(IsNear(depth.SelfTimeMs, 2.0));
+		SN_TEST_CHECK(depth.Children.empty());
+
+		const CpuProfileNode& lighting = root.Children[1];
+		SN_TEST_CHECK(lighting.Name == "Lighting");
+		SN_TEST_CHECK(IsNear(lighting.TotalTimeMs, 5.0));
+		SN_TEST_CHECK(IsNear(lighting.SelfTimeMs, 4.0));
+		SN_TEST_CHECK(lighting.Children.size() == 1);
+		if (lighting.Children.size() == 1)
+		{
+			SN_TEST_CHECK(lighting.Children[0].Name == "Sky");
+			SN_TEST_CHECK(IsNear(lighting.Children[0].TotalTimeMs, 1.0));
+			SN_TEST_CHECK(lighting.Children[0].CallCount == 1);
+		}
+	}
+
+	// A slot whose queries the GPU has not finished is skipped rather than waited on or reset, and
+	// its frame is still published once the queries resolve.
+	void TestPendingSlotSkip()
+	{
+		FakeGpuProfiler profiler(1);
+		profiler.BeginFrame();
+		RecordPasses(profiler);
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Resets == 1);
+		SN_TEST_CHECK(profiler.Writes == 6);
+
+		profiler.BeginFrame();
+		profiler.BeginScope("Skipped");
+		profiler.EndScope();
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Resets == 1);
+		SN_TEST_CHECK(profiler.Writes == 6);
+		SN_TEST_CHECK(profiler.Published.empty());
+
+		profiler.MarkDone(0);
+		profiler.BeginFrame();
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Resets == 2);
+		SN_TEST_CHECK(profiler.Published.size() == 1);
+		if (profiler.Published.size() == 1)
+		{
+			SN_TEST_CHECK(IsNear(profiler.Published[0].TotalTimeMs, 8.0));
+			SN_TEST_CHECK(profiler.Published[0].Children.size() == 2);
+		}
+
+		// The frame that published recorded no scopes, so there is nothing left to resolve.
+		profiler.MarkDone(0);
+		profiler.BeginFrame();
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Published.size() == 1);
+	}
+
+	// EndFrame closes scopes left open, and scopes past MaxScopesPerFrame are dropped along with
+	// their EndScope.
+	void TestScopeLimits()
+	{
+		FakeGpuProfiler profiler(1);
+		profiler.BeginFrame();
+		for (uint32_t i = 0; i < GpuProfiler::MaxScopesPerFrame + 8; ++i)
+		{
+			profiler.BeginScope("Pass");
+			profiler.GpuTimeNs += kMillisecond;
+			profiler.EndScope();
+		}
+		profiler.BeginScope("Unclosed");
+		profiler.GpuTimeNs += kMillisecond;
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Writes == GpuProfiler::MaxQueriesPerFrame);
+
+		profiler.MarkDone(0);
+		profiler.BeginFrame();
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Published.size() == 1);
+		if (profiler.Published.size() == 1)
+		{
+			SN_TEST_CHECK(profiler.Published[0].Children.size() == GpuProfiler::MaxScopesPerFrame);
+			SN_TEST_CHECK(IsNear(profiler.Published[0].TotalTimeMs, static_cast<double>(GpuProfiler::MaxScopesPerFrame)));
+		}
+
+		FakeGpuProfiler unclosed(1);
+		unclosed.BeginFrame();
+		unclosed.BeginScope("Outer");
+		unclosed.GpuTimeNs = kMillisecond;
+		unclosed.BeginScope("Inner");
+		unclosed.GpuTimeNs = 3 * kMillisecond;
+		unclosed.EndFrame();
+		SN_TEST_CHECK(unclosed.Writes == 4);
+
+		unclosed.MarkDone(0);
+		unclosed.BeginFrame();
+		unclosed.EndFrame();
+		SN_TEST_CHECK(unclosed.Published.size() == 1);
+		if (unclosed.Published.size() == 1 && unclosed.Published[0].Children.size() == 1)
+		{
+			const CpuProfileNode& outer = unclosed.Published[0].Children[0];
+			SN_TEST_CHECK(IsNear(outer.TotalTimeMs, 3.0));
+			SN_TEST_CHECK(outer.Children.size() == 1);
+		}
+	}
+
+	// Nothing is recorded while the Instrumentor is disabled.
+	void TestDisabled()
+	{
+		Syndra::Instrumentor::SetEnabled(false);
+		FakeGpuProfiler profiler(1);
+		profiler.BeginFrame();
+		RecordPasses(profiler);
+		profiler.EndFrame();
+		SN_TEST_CHECK(profiler.Resets == 0);
+		SN_TEST_CHECK(profiler.Writes == 0);
+		Syndra::Instrumentor::SetEnabled(true);
+	}
+
+}
+
+int main()
+{
+	Syndra::Instrumentor::SetEnabled(true);
+
+	TestNestedScopes();
+	TestPendingSlotSkip();
+	TestScopeLimits();
+	TestDisabled();
+
+	if (s_Failures > 0)
+	{
+		std::fprintf(stderr, "GpuProfiler: %d check(s) failed\n", s_Failures);
+		return 1;
+	}
+
+	std::printf("GpuProfiler: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,186 @@
+#include "lpch.h"
+
+#include "Engine/Renderer/OcclusionCuller.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdio>
+
+// Checks the software occlusion culler against a few hand-built views. The camera sits at the
+// origin looking down -Z with the culler's 2:1 aspect; occluders are quads passed as raw positions,
+// so no mesh, model or graphics context is involved. Returns non-zero when a check fails.
+
+namespace {
+
+	using Syndra::OcclusionCuller;
+
+	int s_Failures = 0;
+
+	void Check(bool condition, const char* expression, const char* test, int line)
+	{
+		if (condition)
+			return;
+
+		++s_Failures;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", test, line, expression);
+	}
+
+#define SN_TEST_CHECK(condition) Check((condition), #condition, __func__, __LINE__)
+
+	constexpr uint32_t kWidth = 256;
+	constexpr uint32_t kHeight = 128;
+
+	const glm::mat4 kIdentity(1.0f);
+	const uint32_t kQuadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+
+	glm::mat4 CreateViewProjection()
+	{
+		return glm::perspective(glm::radians(60.0f), static_cast<float>(kWidth) / static_cast<float>(kHeight), 0.1f, 100.0f);
+	}
+
+	// A square wall facing the camera at depth z, from -halfSize to halfSize on x and y.
+	struct Quad
+	{
+		glm::vec3 Positions[4];
+
+		Quad(float halfSize, float z)
+			: Positions{ { -halfSize, -halfSize, z }, { halfSize, -halfSize, z }, { halfSize, halfSize, z }, { -halfSize, halfSize, z } }
+		{
+		}
+
+		Quad(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d)
+			: Positions{ a, b, c, d }
+		{
+		}
+	};
+
+	void AddQuad(OcclusionCuller& culler, const Quad& quad)
+	{
+		culler.AddOccluder(kIdentity, quad.Positions, sizeof(glm::vec3), 4, kQuadIndices, 6);
+	}
+
+	bool IsOccluded(const OcclusionCuller& culler, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+	{
+		return culler.IsOccluded(boundsMin, boundsMax, kIdentity);
+	}
+
+	// A box well behind a wall that covers all of it on screen.
+	void TestFullOcclusion()
+	{
+		OcclusionCuller culler(kWidth, kHeight);
+		culler.Begin(CreateViewProjection());
+		const Quad wall(2.0f, -5.0f);
+		AddQuad(culler, wall);
+		culler.Rasterize();
+
+		SN_TEST_CHECK(culler.GetStats().Occluders == 1);
+		SN_TEST_CHECK(culler.GetStats().OccluderTriangles == 2);
+		SN_TEST_CHECK(culler.GetDepth(kWidth / 2, kHeight / 2) < 1.0f);
+		SN_TEST_CHECK(IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -11.0f), glm::vec3(0.5f, 0.5f, -10.0f)));
+
+		// The same box moved by a transform instead of by its bounds.
+		const glm::mat4 offset = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f));
+		SN_TEST_CHECK(culler.IsOccluded(glm::vec3(-0.5f, -0.5f, -1.0f), glm::vec3(0.5f), offset));
+	}
+
+	// Boxes the wall only partly hides, or that are in front of it, stay visible.
+	void TestPartialOcclusion()
+	{
+		OcclusionCuller culler(kWidth, kHeight);
+		culler.Begin(CreateViewProjection());
+		AddQuad(culler, Quad(2.0f, -5.0f));
+		culler.Rasterize();
+
+		// Behind the wall but reaching past its right edge on screen.
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(1.0f, -0.5f, -11.0f), glm::vec3(6.0f, 0.5f, -10.0f)));
+		// Inside the wall's outline on screen, but in front of it.
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -4.0f), glm::vec3(0.5f, 0.5f, -3.0f)));
+		// Cutting through the wall.
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -6.0f), glm::vec3(0.5f, 0.5f, -4.0f)));
+		// Behind the camera.
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, 9.0f), glm::vec3(0.5f, 0.5f, 10.0f)));
+	}
+
+	// Occluder triangles with a vertex in front of the near plane are dropped rather than clipped, and
+	// boxes crossing the near plane are never culled: both only ever keep more items than needed.
+	void TestNearPlaneClipping()
+	{
+		const glm::mat4 viewProjection = CreateViewProjection();
+
+		{
+			OcclusionCuller culler(kWidth, kHeight);
+			culler.Begin(viewProjection);
+			AddQuad(culler, Quad(2.0f, -5.0f));
+			culler.Rasterize();
+
+			// Reaches from behind the wall to behind the camera.
+			SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -20.0f), glm::vec3(0.5f, 0.5f, 1.0f)));
+			// Crosses the near plane without reaching the eye.
+			SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.01f, -0.01f, -0.2f), glm::vec3(0.01f, 0.01f, -0.05f)));
+		}
+
+		{
+			// A slanted wall from behind the camera (z = 1) to z = -9, 4 units in front of the eye at
+			// the center of the view. Both of its triangles cross the near plane.
+			OcclusionCuller culler(kWidth, kHeight);
+			culler.Begin(viewProjection);
+			AddQuad(culler, Quad(
+				glm::vec3(-10.0f, -10.0f, 1.0f), glm::vec3(10.0f, -10.0f, 1.0f),
+				glm::vec3(10.0f, 10.0f, -9.0f), glm::vec3(-10.0f, 10.0f, -9.0f)));
+			culler.Rasterize();
+
+			SN_TEST_CHECK(culler.GetStats().Occluders == 1);
+			SN_TEST_CHECK(culler.GetStats().OccluderTriangles == 0);
+			SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -31.0f), glm::vec3(0.5f, 0.5f, -30.0f)));
+		}
+	}
+
+	// Without occluders, and before Rasterize, nothing is occluded.
+	void TestEmptyDepthBuffer()
+	{
+		OcclusionCuller culler(kWidth, kHeight);
+		culler.Begin(CreateViewProjection());
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -11.0f), glm::vec3(0.5f, 0.5f, -10.0f)));
+
+		culler.Rasterize();
+		SN_TEST_CHECK(culler.GetStats().Occluders == 0);
+		SN_TEST_CHECK(culler.GetStats().OccluderTriangles == 0);
+
+		bool cleared = true;
+		for (uint32_t y = 0; y < culler.GetHeight(); ++y)
+		{
+			for (uint32_t x = 0; x < culler.GetWidth(); ++x)
+				cleared = cleared && culler.GetDepth(x, y) == 1.0f;
+		}
+		SN_TEST_CHECK(cleared);
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -11.0f), glm::vec3(0.5f, 0.5f, -10.0f)));
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -99.0f), glm::vec3(0.5f, 0.5f, -98.0f)));
+
+		// Begin clears what the previous view rasterized.
+		culler.Begin(CreateViewProjection());
+		AddQuad(culler, Quad(2.0f, -5.0f));
+		culler.Rasterize();
+		culler.Begin(CreateViewProjection());
+		culler.Rasterize();
+		SN_TEST_CHECK(culler.GetDepth(kWidth / 2, kHeight / 2) == 1.0f);
+		SN_TEST_CHECK(!IsOccluded(culler, glm::vec3(-0.5f, -0.5f, -11.0f), glm::vec3(0.5f, 0.5f, -10.0f)));
+	}
+
+}
+
+int main()
+{
+	TestFullOcclusion();
+	TestPartialOcclusion();
+	TestNearPlaneClipping();
+	TestEmptyDepthBuffer();
+
+	if (s_Failures > 0)
+	{
+		std::fprintf(stderr, "OcclusionCuller: %d check(s) failed\n", s_Failures);
+		return 1;
+	}
+
+	std::printf("OcclusionCuller: all checks passed\n");
+	return 0;
+}
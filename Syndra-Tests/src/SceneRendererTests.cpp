@@ -0,0 +1,216 @@
+#include "lpch.h"
+
+#include "Engine/Core/Application.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Renderer/Model.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/RendererAPI.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/SceneRenderer.h"
+#include "Engine/Scene/Entity.h"
+#include "Engine/Scene/Scene.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+#include <cstdio>
+#include <filesystem>
+
+// Renders small scenes through SceneRenderer on the Null backend and checks what a frame costs
+// in draws and binds: the fixed cost of the passes, and what every mesh adds to it. The editor's
+// shaders are read from SYNDRA_TEST_ASSETS_DIR; nothing else touches the disk. Returns non-zero
+// when a check fails.
+
+namespace {
+
+	using Syndra::NullRendererAPI;
+
+	int s_Failures = 0;
+
+	void Check(bool condition, const char* expression, const char* test, int line)
+	{
+		if (condition)
+			return;
+
+		++s_Failures;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", test, line, expression);
+	}
+
+#define SN_TEST_CHECK(condition) Check((condition), #condition, __func__, __LINE__)
+
+	constexpr uint32_t kViewportSize = 256;
+	constexpr uint32_t kCubeIndexCount = 36;
+	constexpr uint32_t kCubesPerStep = 4;
+
+	// A unit cube without textures, built in memory instead of loaded through Assimp.
+	Syndra::Model CreateCubeModel()
+	{
+		std::vector<Syndra::Vertex> vertices;
+		for (uint32_t corner = 0; corner < 8; ++corner)
+		{
+			Syndra::Vertex vertex{};
+			vertex.Position = glm::vec3(corner & 1 ? 0.5f : -0.5f, corner & 2 ? 0.5f : -0.5f, corner & 4 ? 0.5f : -0.5f);
+			vertex.Normal = glm::normalize(vertex.Position);
+			vertex.TexCoords = glm::vec2(vertex.Position.x, vertex.Position.y) + 0.5f;
+			vertices.push_back(vertex);
+		}
+		std::vector<unsigned int> indices = {
+			0, 2, 1, 1, 2, 3,	4, 5, 6, 5, 7, 6,	0, 1, 4, 1, 5, 4,
+			2, 6, 3, 3, 6, 7,	0, 4, 2, 2, 4, 6,	1, 3, 5, 3, 7, 5
+		};
+
+		Syndra::Model model;
+		model.meshes.emplace_back(std::move(vertices), std::move(indices), std::vector<Syndra::texture>{});
+		return model;
+	}
+
+	void AddCubes(Syndra::Scene& scene, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Syndra::Entity entity = *scene.CreateEntity("Cube");
+			entity.GetComponent<Syndra::TransformComponent>().Translation = glm::vec3(static_cast<float>(i) * 2.0f, 0.0f, -10.0f);
+			auto& mesh = entity.AddComponent<Syndra::MeshComponent>();
+			mesh.model = CreateCubeModel();
+			// RenderScene skips meshes without a path; this one names the in-memory model.
+			mesh.path = "cube";
+		}
+	}
+
+	NullRendererAPI::RecordingStats RenderFrame(Syndra::Scene& scene)
+	{
+		NullRendererAPI::ResetRecording();
+		Syndra::RenderCommand::ResetDrawCount();
+		scene.OnUpdateEditor(Syndra::Timestep(0.016f));
+		const NullRendererAPI::RecordingStats stats = NullRendererAPI::GetRecordingStats();
+		SN_TEST_CHECK(Syndra::RenderCommand::GetDrawCount() == stats.Draws);
+		return stats;
+	}
+
+	// Per-mesh cost: what a frame with kCubesPerStep more cubes adds to the one before.
+	struct StepCost
+	{
+		int64_t Draws = 0;
+		int64_t Indices = 0;
+		int64_t ShaderBinds = 0;
+		int64_t TextureBinds = 0;
+		int64_t VertexArrayBinds = 0;
+		int64_t FrameBufferBinds = 0;
+		int64_t Clears = 0;
+	};
+
+	StepCost GetStepCost(const NullRendererAPI::RecordingStats& before, const NullRendererAPI::RecordingStats& after)
+	{
+		StepCost cost;
+		cost.Draws = static_cast<int64_t>(after.Draws) - before.Draws;
+		cost.Indices = static_cast<int64_t>(after.Indices) - static_cast<int64_t>(before.Indices);
+		cost.ShaderBinds = static_cast<int64_t>(after.ShaderBinds) - before.ShaderBinds;
+		cost.TextureBinds = static_cast<int64_t>(after.TextureBinds) - before.TextureBinds;
+		cost.VertexArrayBinds = static_cast<int64_t>(after.VertexArrayBinds) - before.VertexArrayBinds;
+		cost.FrameBufferBinds = static_cast<int64_t>(after.FrameBufferBinds) - before.FrameBufferBinds;
+		cost.Clears = static_cast<int64_t>(after.Clears) - before.Clears;
+		return cost;
+	}
+
+	// The deferred pipeline the Null backend runs draws every mesh once into the shadow map and
+	// once into the G-buffer, then one screen quad for lighting (FXAA and occlusion culling are off
+	// by default). Passes and clears do not depend on the mesh count.
+	void TestDrawAndBindCounts(Syndra::Scene& scene)
+	{
+		const NullRendererAPI::RecordingStats empty = RenderFrame(scene);
+		SN_TEST_CHECK(empty.Draws == 1);
+		SN_TEST_CHECK(empty.VertexArrayBinds == 1);
+		SN_TEST_CHECK(empty.Dispatches == 0);
+
+		AddCubes(scene, kCubesPerStep);
+		const NullRendererAPI::RecordingStats first = RenderFrame(scene);
+		AddCubes(scene, kCubesPerStep);
+		const NullRendererAPI::RecordingStats second = RenderFrame(scene);
+
+		const StepCost firstStep = GetStepCost(empty, first);
+		SN_TEST_CHECK(firstStep.Draws == 2 * kCubesPerStep);
+		SN_TEST_CHECK(firstStep.Indices == 2 * kCubesPerStep * kCubeIndexCount);
+		SN_TEST_CHECK(firstStep.VertexArrayBinds == 2 * kCubesPerStep);
+		SN_TEST_CHECK(firstStep.ShaderBinds == 2 * kCubesPerStep);
+		SN_TEST_CHECK(firstStep.FrameBufferBinds == 0);
+		SN_TEST_CHECK(firstStep.Clears == 0);
+
+		// Every further mesh costs the same as the first ones.
+		const StepCost secondStep = GetStepCost(first, second);
+		SN_TEST_CHECK(secondStep.Draws == firstStep.Draws);
+		SN_TEST_CHECK(secondStep.ShaderBinds == firstStep.ShaderBinds);
+		SN_TEST_CHECK(secondStep.TextureBinds == firstStep.TextureBinds);
+		SN_TEST_CHECK(secondStep.VertexArrayBinds == firstStep.VertexArrayBinds);
+		SN_TEST_CHECK(secondStep.FrameBufferBinds == 0);
+
+		// An unchanged scene costs the same every frame.
+		const NullRendererAPI::RecordingStats repeated = RenderFrame(scene);
+		SN_TEST_CHECK(repeated.Draws == second.Draws);
+		SN_TEST_CHECK(repeated.ShaderBinds == second.ShaderBinds);
+		SN_TEST_CHECK(repeated.TextureBinds == second.TextureBinds);
+		SN_TEST_CHECK(repeated.VertexArrayBinds == second.VertexArrayBinds);
+		SN_TEST_CHECK(repeated.FrameBufferBinds == second.FrameBufferBinds);
+		SN_TEST_CHECK(repeated.UniformSets == second.UniformSets);
+	}
+
+	// A mesh without a path is not part of the view and costs nothing.
+	void TestMeshesWithoutPath(Syndra::Scene& scene)
+	{
+		const NullRendererAPI::RecordingStats before = RenderFrame(scene);
+		Syndra::Entity entity = *scene.CreateEntity("Unloaded");
+		entity.AddComponent<Syndra::MeshComponent>().model = CreateCubeModel();
+		const NullRendererAPI::RecordingStats after = RenderFrame(scene);
+		SN_TEST_CHECK(after.Draws == before.Draws);
+		SN_TEST_CHECK(after.VertexArrayBinds == before.VertexArrayBinds);
+	}
+
+	// The shaders are read relative to the editor's directory, like the editor and Syndra-Bench do.
+	bool ChangeToEditorDirectory()
+	{
+		const std::filesystem::path editorDirectory = std::filesystem::path(SYNDRA_TEST_ASSETS_DIR).parent_path();
+		std::error_code error;
+		std::filesystem::current_path(editorDirectory, error);
+		if (error || !std::filesystem::exists("assets/shaders"))
+		{
+			std::fprintf(stderr, "SceneRenderer: no shaders in '%s'\n", editorDirectory.string().c_str());
+			return false;
+		}
+		return true;
+	}
+
+}
+
+int main()
+{
+	Syndra::Log::init();
+	if (!ChangeToEditorDirectory())
+		return 1;
+
+	// A headless application owns the Null device the way the editor owns its device; its Run()
+	// loop is never entered, so frames render inline without a render thread.
+	Syndra::RendererAPI::SelectAPI(Syndra::RendererAPI::API::Null);
+	Syndra::RenderThread::SetLatency(0);
+	auto* app = new Syndra::Application(Syndra::WindowProps("Syndra Tests", kViewportSize, kViewportSize, true));
+	Syndra::RenderCommand::Init();
+	{
+		auto scene = Syndra::CreateRef<Syndra::Scene>();
+		Syndra::SceneRenderer::SetScene(scene);
+		Syndra::SceneRenderer::InitializeShaders();
+		Syndra::SceneRenderer::InitializeEnvironment();
+		Syndra::SceneRenderer::Initialize();
+		scene->OnViewportResize(kViewportSize, kViewportSize);
+
+		TestDrawAndBindCounts(*scene);
+		TestMeshesWithoutPath(*scene);
+
+		Syndra::SceneRenderer::ShutDown();
+	}
+	delete app;
+
+	if (s_Failures > 0)
+	{
+		std::fprintf(stderr, "SceneRenderer: %d check(s) failed\n", s_Failures);
+		return 1;
+	}
+
+	std::printf("SceneRenderer: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,229 @@
+#include "lpch.h"
+
+#include "Engine/Renderer/SphericalHarmonics.h"
+
+#include "stb_image.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+// Checks the nine-term irradiance fit the environment loader uploads against the brute-force
+// hemisphere integral of the same image: Evaluate(ConvolveLambert(ProjectEquirectangular(...)))
+// versus ComputeReferenceIrradiance(...), on synthetic skies and on every HDR in assets/HDRI.
+// Returns non-zero when a check fails.
+
+namespace {
+
+	using Syndra::SphericalHarmonics;
+	using Syndra::SphericalHarmonicsL2;
+
+	int s_Failures = 0;
+
+	void Check(bool condition, const char* expression, const char* test, int line)
+	{
+		if (condition)
+			return;
+
+		++s_Failures;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", test, line, expression);
+	}
+
+#define SN_TEST_CHECK(condition) Check((condition), #condition, __func__, __LINE__)
+
+	constexpr uint32_t kRandomSeed = 1337;
+	// Environment::kMaxIrradianceRadiance, the clamp the loader projects with.
+	constexpr float kMaxRadiance = 1.0f;
+	constexpr uint32_t kReferenceStride = 8;
+	// Largest error of the fit in any of the 26 directions checked, relative to the reference
+	// luminance there. Smooth skies stay within a few percent; a sharp bright disc costs the most
+	// on the dim side facing away from it, which real HDRs with a sun below the clamp can approach.
+	constexpr float kMaxSkyError = 0.08f;
+	constexpr float kMaxSunDiscError = 0.15f;
+	constexpr float kMaxHdriError = 0.2f;
+
+	struct Image
+	{
+		std::vector<float> Pixels;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+	};
+
+	glm::vec3 GetTexelDirection(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		const float latitude = ((static_cast<float>(y) + 0.5f) / static_cast<float>(height) - 0.5f) * glm::pi<float>();
+		const float longitude = ((static_cast<float>(x) + 0.5f) / static_cast<float>(width) - 0.5f) * glm::two_pi<float>();
+		return glm::vec3(std::cos(latitude) * std::cos(longitude), std::sin(latitude), std::cos(latitude) * std::sin(longitude));
+	}
+
+	template<typename Fn>
+	Image BuildImage(uint32_t width, uint32_t height, Fn&& radiance)
+	{
+		Image image;
+		image.Width = width;
+		image.Height = height;
+		image.Pixels.resize(static_cast<size_t>(width) * height * 3);
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				const glm::vec3 color = radiance(GetTexelDirection(x, y, width, height));
+				float* texel = &image.Pixels[(static_cast<size_t>(y) * width + x) * 3];
+				texel[0] = color.x;
+				texel[1] = color.y;
+				texel[2] = color.z;
+			}
+		}
+		return image;
+	}
+
+	SphericalHarmonicsL2 ProjectIrradiance(const Image& image)
+	{
+		return SphericalHarmonics::ConvolveLambert(
+			SphericalHarmonics::ProjectEquirectangular(image.Pixels.data(), image.Width, image.Height, kMaxRadiance));
+	}
+
+	// Largest error along the cube axes and diagonals, relative to the reference luminance.
+	float ComputeMaxRelativeError(const Image& image, const SphericalHarmonicsL2& irradiance)
+	{
+		float maxError = 0.0f;
+		for (int x = -1; x <= 1; ++x)
+		{
+			for (int y = -1; y <= 1; ++y)
+			{
+				for (int z = -1; z <= 1; ++z)
+				{
+					if (x == 0 && y == 0 && z == 0)
+						continue;
+
+					const glm::vec3 normal(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+					const glm::vec3 reference = SphericalHarmonics::ComputeReferenceIrradiance(image.Pixels.data(), image.Width, image.Height,
+						kMaxRadiance, normal, kReferenceStride);
+					const glm::vec3 approximation = SphericalHarmonics::Evaluate(irradiance, normal);
+					const float referenceLuminance = std::max(glm::dot(reference, glm::vec3(0.2126f, 0.7152f, 0.0722f)), 1e-4f);
+					maxError = std::max(maxError, glm::length(approximation - reference) / referenceLuminance);
+				}
+			}
+		}
+		return maxError;
+	}
+
+	// A constant environment has constant irradiance equal to its radiance, after the clamp.
+	void TestConstantEnvironment()
+	{
+		const Image dim = BuildImage(1024, 512, [](const glm::vec3&) { return glm::vec3(0.25f, 0.5f, 0.75f); });
+		const SphericalHarmonicsL2 dimIrradiance = ProjectIrradiance(dim);
+		const Image bright = BuildImage(1024, 512, [](const glm::vec3&) { return glm::vec3(4.0f); });
+		const SphericalHarmonicsL2 brightIrradiance = ProjectIrradiance(bright);
+
+		const glm::vec3 directions[] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, -1.0f, 1.0f } };
+		for (const glm::vec3& direction : directions)
+		{
+			SN_TEST_CHECK(glm::length(SphericalHarmonics::Evaluate(dimIrradiance, direction) - glm::vec3(0.25f, 0.5f, 0.75f)) < 0.01f);
+			SN_TEST_CHECK(glm::length(SphericalHarmonics::Evaluate(brightIrradiance, direction) - glm::vec3(kMaxRadiance)) < 0.01f);
+		}
+		SN_TEST_CHECK(ComputeMaxRelativeError(dim, dimIrradiance) < 0.01f);
+	}
+
+	// The sky BM_SphericalHarmonics_Project measures: a ground to sky gradient, a small sun that
+	// the clamp flattens, and some texel noise.
+	void TestSyntheticSky()
+	{
+		std::mt19937 random(kRandomSeed);
+		std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+		const glm::vec3 ground(0.25f, 0.2f, 0.15f);
+		const glm::vec3 sky(0.35f, 0.55f, 0.9f);
+		const glm::vec3 sunDirection = glm::normalize(glm::vec3(0.4f, 0.6f, 0.3f));
+		const Image image = BuildImage(1024, 512, [&](const glm::vec3& direction)
+			{
+				const float horizon = glm::smoothstep(-0.1f, 0.3f, direction.y);
+				const float sun = std::pow(std::max(glm::dot(direction, sunDirection), 0.0f), 256.0f) * 20.0f;
+				return glm::mix(ground, sky, horizon) * noise(random) + glm::vec3(sun);
+			});
+
+		const float error = ComputeMaxRelativeError(image, ProjectIrradiance(image));
+		std::printf("SphericalHarmonics: synthetic sky max error %.4f\n", error);
+		SN_TEST_CHECK(error < kMaxSkyError);
+	}
+
+	// A large sun disc at the clamp over a dim sky: a hard edge on a small area, which order-2
+	// SH fits worst of the skies the loader sees.
+	void TestSunDisc()
+	{
+		const glm::vec3 sunDirection = glm::normalize(glm::vec3(-0.3f, 0.8f, 0.5f));
+		const float sunCosine = std::cos(glm::radians(20.0f));
+		const Image image = BuildImage(1024, 512, [&](const glm::vec3& direction)
+			{
+				return glm::dot(direction, sunDirection) > sunCosine ? glm::vec3(1.0f) : glm::vec3(0.05f);
+			});
+
+		const float error = ComputeMaxRelativeError(image, ProjectIrradiance(image));
+		std::printf("SphericalHarmonics: sun disc max error %.4f\n", error);
+		SN_TEST_CHECK(error < kMaxSunDiscError);
+	}
+
+	// The HDRs the editor ships with. They are not part of every checkout, so a missing folder
+	// is reported rather than failed.
+	void TestHdriFiles()
+	{
+		const std::filesystem::path directory = std::filesystem::path(SYNDRA_TEST_ASSETS_DIR) / "HDRI";
+		std::error_code error;
+		if (!std::filesystem::is_directory(directory, error))
+		{
+			std::printf("SphericalHarmonics: no HDRs checked, '%s' does not exist\n", directory.string().c_str());
+			return;
+		}
+
+		uint32_t checked = 0;
+		for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+		{
+			if (!entry.is_regular_file() || entry.path().extension() != ".hdr")
+				continue;
+
+			const std::string path = entry.path().string();
+			int width = 0;
+			int height = 0;
+			int channels = 0;
+			float* pixels = stbi_loadf(path.c_str(), &width, &height, &channels, 3);
+			SN_TEST_CHECK(pixels != nullptr);
+			if (pixels == nullptr)
+				continue;
+
+			Image image;
+			image.Width = static_cast<uint32_t>(width);
+			image.Height = static_cast<uint32_t>(height);
+			image.Pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 3);
+			stbi_image_free(pixels);
+
+			const float maxError = ComputeMaxRelativeError(image, ProjectIrradiance(image));
+			std::printf("SphericalHarmonics: %s max error %.4f\n", entry.path().filename().string().c_str(), maxError);
+			SN_TEST_CHECK(maxError < kMaxHdriError);
+			++checked;
+		}
+
+		if (checked == 0)
+			std::printf("SphericalHarmonics: no HDRs found in '%s'\n", directory.string().c_str());
+	}
+
+}
+
+int main()
+{
+	TestConstantEnvironment();
+	TestSyntheticSky();
+	TestSunDisc();
+	TestHdriFiles();
+
+	if (s_Failures > 0)
+	{
+		std::fprintf(stderr, "SphericalHarmonics: %d check(s) failed\n", s_Failures);
+		return 1;
+	}
+
+	std::printf("SphericalHarmonics: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include "lpch.h"
+#include "Engine/Core/AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Syndra {
+
+	namespace {
+
+		std::atomic<uint64_t> s_AllocationCount{ 0 };
+		std::atomic<uint64_t> s_AllocatedBytes{ 0 };
+
+	}
+
+	bool AllocationTracker::IsEnabled()
+	{
+#ifdef SN_DEBUG
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	uint64_t AllocationTracker::GetAllocationCount()
+	{
+		return s_AllocationCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AllocationTracker::GetAllocatedBytes()
+	{
+		return s_AllocatedBytes.load(std::memory_order_relaxed);
+	}
+
+#ifdef SN_DEBUG
+	namespace {
+
+		void* TrackedAllocate(size_t size) noexcept
+		{
+			s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+			s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+			return std::malloc(size ? size : 1);
+		}
+
+	}
+#endif
+
+}
+
+#ifdef SN_DEBUG
+// Replaces the global operators for the whole executable. This file is always linked in because
+// Application reads the counters.
+
+void* operator new(size_t size)
+{
+	if (void* ptr = Syndra::TrackedAllocate(size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (void* ptr = Syndra::TrackedAllocate(size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Syndra::TrackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Syndra::TrackedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+#endif
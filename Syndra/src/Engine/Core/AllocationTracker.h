@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Syndra {
+
+	// Counts heap allocations made through the global operator new. Only debug builds replace the
+	// operator, elsewhere IsEnabled() is false and the counters stay at zero. Over-aligned news
+	// (alignas above the default) are not counted.
+	class AllocationTracker
+	{
+	public:
+		static bool IsEnabled();
+		// Totals since startup, across all threads.
+		static uint64_t GetAllocationCount();
+		static uint64_t GetAllocatedBytes();
+	};
+
+}
@@ -1,26 +1,60 @@
 #include "lpch.h"
 #include "Engine/Core/Application.h"
+#include "Engine/Core/AllocationTracker.h"
+#include "Engine/Core/FrameAllocator.h"
 #include "Engine/Core/Input.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Events/KeyEvent.h"
+#include "Engine/Events/MouseEvent.h"
+#include "Engine/Renderer/FramePacket.h"
 #include "Engine/Renderer/RenderCommand.h"
-#include "GLFW/glfw3.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/SceneRenderer.h"
+#include "Engine/Renderer/TextureStreamer.h"
+#include "Engine/Utils/PlatformUtils.h"
 #include "Instrument.h"
 
 namespace Syndra {
 
+	namespace {
+
+		// Longest the main thread sleeps in on-demand mode; every wake-up produces an ImGui frame.
+		constexpr double kIdleWaitSeconds = 0.5;
+		// ImGui needs a couple of frames after an input to settle hover states and layout.
+		constexpr uint32_t kFramesPerEvent = 3;
+
+	}
+
 	Application* Application::s_Instance = nullptr;
 
 	Application::Application(const std::string& name)
+		: Application(WindowProps(name))
+	{
+	}
+
+	Application::Application(const WindowProps& props)
 	{
 		s_Instance = this;
-		m_window = Window::Create(WindowProps(name));
+		m_StartTime = std::chrono::steady_clock::now();
+		m_IdleWindowStart = m_StartTime;
+		m_IdleWindowCpuTime = ProcessInfo::GetCpuTime();
+		JobSystem::Init();
+		m_window = Window::Create(props);
 		m_window->SetEventCallback(SN_BIND_EVENT_FN(Application::OnEvent));
-		m_ImGuiLayer = new ImGuiLayer();
-		PushOverlay(m_ImGuiLayer);
+		RenderThread::Init(*m_window, [this](FramePacket& packet) { ExecuteFramePacket(packet); });
+		if (!props.Headless && RendererAPI::GetAPI() != RendererAPI::API::Null)
+		{
+			m_ImGuiLayer = new ImGuiLayer();
+			PushOverlay(m_ImGuiLayer);
+		}
 
 	}
 
 	Application::~Application()
 	{
+		RenderThread::Shutdown();
+		TextureStreamer::Shutdown();
+		JobSystem::Shutdown();
 		m_LayerStack.Clear();
 		m_ImGuiLayer = nullptr;
 		RenderCommand::Shutdown();
@@ -28,6 +62,9 @@ namespace Syndra {
 
 	void Application::OnEvent(Event& e)
 	{
+		TrackHeldInputs(e);
+		m_PendingFrames = kFramesPerEvent;
+
 		EventDispatcher dispatcher(e);
 		dispatcher.Dispatch<WindowCloseEvent>(SN_BIND_EVENT_FN(Application::OnWindowClose));
 
@@ -42,25 +79,66 @@ namespace Syndra {
 
 	void Application::Run()
 	{
+		uint64_t frameAllocationStart = AllocationTracker::GetAllocationCount();
 		while (m_Running)
 		{
 			SN_PROFILE_SCOPE("Frame");
+			bool waited = false;
+			if (ShouldWaitForEvents())
+			{
+				SN_PROFILE_SCOPE("Window::WaitEvents");
+				const auto waitStart = std::chrono::steady_clock::now();
+				m_window->WaitEvents(kIdleWaitSeconds);
+				m_IdleTime += std::chrono::steady_clock::now() - waitStart;
+				waited = true;
+			}
+			else
 			{
 				SN_PROFILE_SCOPE("Window::OnUpdate");
 				m_window->OnUpdate();
 			}
 			if (!m_Running)
 				break;
+			if (m_PendingFrames > 0)
+				--m_PendingFrames;
 
-			float time = (float)glfwGetTime();
+			// Not glfwGetTime(): headless applications never initialize GLFW.
+			const auto now = std::chrono::steady_clock::now();
+			float time = std::chrono::duration<float>(now - m_StartTime).count();
 			Timestep ts = time - m_lastFrameTime;
+			// A frame that slept is not slow, so it stays out of the frame time statistics.
+			if (m_lastFrameTime > 0.0f && !waited)
+				Instrumentor::Get().RecordFrameTime(ts.GetMilliseconds());
 			m_lastFrameTime = time;
 
+			if (now - m_IdleWindowStart >= std::chrono::seconds(1))
+			{
+				const float windowSeconds = std::chrono::duration<float>(now - m_IdleWindowStart).count();
+				const double cpuTime = ProcessInfo::GetCpuTime();
+				m_IdleFraction = std::chrono::duration<float>(m_IdleTime).count() / windowSeconds;
+				m_ProcessCpuUsage = static_cast<float>(cpuTime - m_IdleWindowCpuTime) / windowSeconds;
+				m_IdleWindowStart = now;
+				m_IdleWindowCpuTime = cpuTime;
+				m_IdleTime = {};
+			}
+
+			// Threaded: the render thread begins and presents the frame when it executes the packet.
+			const bool threaded = RenderThread::BeginFrame();
+			// The previous frame was handed over; its frame memory stays valid until the next frame.
+			FrameAllocator::BeginFrame();
+			if (!threaded)
 			{
 				SN_PROFILE_SCOPE("Window::BeginFrame");
 				m_window->BeginFrame();
 			}
 
+			{
+				SN_PROFILE_SCOPE("JobSystem::ProcessMainThreadJobs");
+				if (threaded && JobSystem::HasMainThreadJobs())
+					RenderThread::Synchronize();
+				JobSystem::ProcessMainThreadJobs();
+			}
+
 			if (!m_Minimized) {
 				{
 					SN_PROFILE_SCOPE("Layers::OnUpdate");
@@ -68,10 +146,12 @@ namespace Syndra {
 						layer->OnUpdate(ts);
 					}
 				}
+				if (!threaded)
 				{
 					SN_PROFILE_SCOPE("RenderCommand::Flush(Update)");
 					RenderCommand::Flush();
 				}
+				if (m_ImGuiLayer)
 				{
 					SN_PROFILE_SCOPE("ImGui");
 					m_ImGuiLayer->Begin();
@@ -83,18 +163,101 @@ namespace Syndra {
 				}
 			}
 
+			if (!threaded)
 			{
-				SN_PROFILE_SCOPE("RenderCommand::Flush(EndFrame)");
-				RenderCommand::Flush();
-			}
+				{
+					SN_PROFILE_SCOPE("RenderCommand::Flush(EndFrame)");
+					RenderCommand::Flush();
+				}
 
-			{
-				SN_PROFILE_SCOPE("Window::EndFrame");
-				m_window->EndFrame();
+				{
+					SN_PROFILE_SCOPE("Window::EndFrame");
+					m_window->EndFrame();
+				}
 			}
+
+			RenderThread::EndFrame();
+
+			const uint64_t frameAllocationEnd = AllocationTracker::GetAllocationCount();
+			m_FrameAllocationCount = frameAllocationEnd - frameAllocationStart;
+			frameAllocationStart = frameAllocationEnd;
+		}
+	}
+
+	void Application::ExecuteFramePacket(FramePacket& packet)
+	{
+		m_window->BeginFrame();
+		for (const SceneRenderView& view : packet.Views)
+			SceneRenderer::ExecuteView(view);
+		RenderCommand::Flush();
+
+		if (packet.ImGuiDrawData && m_ImGuiLayer)
+		{
+			SN_PROFILE_SCOPE("ImGui::RenderDrawData");
+			m_ImGuiLayer->RenderDrawData(*packet.ImGuiDrawData);
+		}
+		RenderCommand::Flush();
+
+		{
+			SN_PROFILE_SCOPE("Window::EndFrame");
+			m_window->EndFrame();
 		}
 	}
 
+	void Application::SetOnDemandRendering(bool enabled)
+	{
+		m_OnDemandRendering = enabled;
+		RequestRedraw();
+	}
+
+	void Application::RequestRedraw()
+	{
+		Application* app = s_Instance;
+		if (app == nullptr)
+			return;
+
+		app->m_RedrawRequested.store(true, std::memory_order_release);
+		if (app->m_window)
+			app->m_window->PostEmptyEvent();
+	}
+
+	void Application::TrackHeldInputs(Event& e)
+	{
+		// GLFW releases every held key and button when the window loses focus, so the count
+		// cannot get stuck; the clamp covers inputs already held when the window opened.
+		EventDispatcher dispatcher(e);
+		dispatcher.Dispatch<KeyPressedEvent>([this](KeyPressedEvent& event)
+			{
+				if (event.GetRepeatCount() == 0)
+					++m_HeldInputs;
+				return false;
+			});
+		dispatcher.Dispatch<KeyReleasedEvent>([this](KeyReleasedEvent&)
+			{
+				m_HeldInputs = m_HeldInputs > 0 ? m_HeldInputs - 1 : 0;
+				return false;
+			});
+		dispatcher.Dispatch<MouseButtonPressedEvent>([this](MouseButtonPressedEvent&)
+			{
+				++m_HeldInputs;
+				return false;
+			});
+		dispatcher.Dispatch<MouseButtonReleasedEvent>([this](MouseButtonReleasedEvent&)
+			{
+				m_HeldInputs = m_HeldInputs > 0 ? m_HeldInputs - 1 : 0;
+				return false;
+			});
+	}
+
+	bool Application::ShouldWaitForEvents()
+	{
+		if (!m_OnDemandRendering || m_PendingFrames > 0 || m_HeldInputs > 0)
+			return false;
+		if (m_RedrawRequested.exchange(false, std::memory_order_acquire))
+			return false;
+		return !JobSystem::HasMainThreadJobs();
+	}
+
 	void Application::PushLayer(Layer* layer)
 	{
 		m_LayerStack.PushLayer(layer);
@@ -107,10 +270,11 @@ namespace Syndra {
 		layer->OnAttach();
 	}
 
-	void Application::Close()
+	void Application::Close(int exitCode)
 	{
 		SN_INFO("Application closed by user!");
 		m_Running = false;
+		m_ExitCode = exitCode;
 	}
 
 	bool Application::OnWindowClose(WindowCloseEvent& e)
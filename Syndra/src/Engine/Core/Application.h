@@ -8,12 +8,31 @@
 #include "Engine/Events/ApplicationEvent.h"
 #include "Engine/Renderer/Renderer.h"
 
+#include <atomic>
+#include <chrono>
+
 namespace Syndra {
 
+	struct FramePacket;
+
+	struct ApplicationCommandLineArgs
+	{
+		int Count = 0;
+		char** Args = nullptr;
+
+		const char* operator[](int index) const
+		{
+			SN_CORE_ASSERT(index < Count, "Command line argument out of range.");
+			return Args[index];
+		}
+	};
+
 	class Application
 	{
 	public:
 		Application(const std::string& name = "");
+		// A headless application (props.Headless) renders offscreen and has no ImGui layer.
+		Application(const WindowProps& props);
 		virtual ~Application();
 		void OnEvent(Event& e);
 		void Run();
@@ -25,19 +44,59 @@ namespace Syndra {
 		Window& GetWindow() { return *m_window; }
 		ImGuiLayer* GetImGuiLayer() const { return m_ImGuiLayer; }
 
-		void Close();
+		// Set by the entry point before CreateApplication().
+		static void SetCommandLineArgs(const ApplicationCommandLineArgs& args) { s_CommandLineArgs = args; }
+		static const ApplicationCommandLineArgs& GetCommandLineArgs() { return s_CommandLineArgs; }
+
+		// Ends Run() after the current frame; the entry point returns exitCode from main().
+		void Close(int exitCode = 0);
+		int GetExitCode() const { return m_ExitCode; }
+
+		// Heap allocations of the last frame, on all threads. Always 0 unless
+		// AllocationTracker::IsEnabled() (debug builds).
+		uint64_t GetFrameAllocationCount() const { return m_FrameAllocationCount; }
+
+		// On-demand rendering: while there is no input, no redraw request and no main-thread job,
+		// Run() sleeps in Window::WaitEvents() instead of producing frames back to back.
+		void SetOnDemandRendering(bool enabled);
+		bool IsOnDemandRendering() const { return m_OnDemandRendering; }
+		// Produces at least one more frame and wakes the main thread if it sleeps. Thread-safe;
+		// does nothing without an application.
+		static void RequestRedraw();
+		// Share of the last second the main thread spent asleep waiting for events.
+		float GetIdleFraction() const { return m_IdleFraction; }
+		// CPU time the whole process used over the same second, in cores (1.0 is one core busy).
+		float GetProcessCpuUsage() const { return m_ProcessCpuUsage; }
 
 	private:
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
+		void ExecuteFramePacket(FramePacket& packet);
+		void TrackHeldInputs(Event& e);
+		bool ShouldWaitForEvents();
 
 	private:
 		Ref<Window> m_window;
-		ImGuiLayer* m_ImGuiLayer;
+		ImGuiLayer* m_ImGuiLayer = nullptr;
+		std::chrono::steady_clock::time_point m_StartTime;
 		float m_lastFrameTime = 0.0f;
+		uint64_t m_FrameAllocationCount = 0;
+		bool m_OnDemandRendering = false;
+		std::atomic<bool> m_RedrawRequested{ true };
+		// Frames still to produce after the last event, so ImGui can settle hover and layout.
+		uint32_t m_PendingFrames = 0;
+		// Keys and mouse buttons held down; input polled every frame (camera flight) keeps frames coming.
+		uint32_t m_HeldInputs = 0;
+		std::chrono::steady_clock::time_point m_IdleWindowStart;
+		std::chrono::steady_clock::duration m_IdleTime{};
+		float m_IdleFraction = 0.0f;
+		double m_IdleWindowCpuTime = 0.0;
+		float m_ProcessCpuUsage = 0.0f;
 		bool m_Running = true;
+		int m_ExitCode = 0;
 		bool m_Minimized = false;
 		static Application* s_Instance;
+		inline static ApplicationCommandLineArgs s_CommandLineArgs;
 		LayerStack m_LayerStack;
 	};
 
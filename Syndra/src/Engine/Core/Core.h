@@ -36,7 +36,6 @@
 #error "Android is not supported!"
 #elif defined(__linux__)
 #define SN_PLATFORM_LINUX
-#error "Linux is not supported!"
 #else
 	/* Unknown compiler/platform */
 #error "Unknown platform!"
@@ -47,8 +46,8 @@
 #endif
 
 #ifdef SN_ENABLE_ASSERTS
-#define SN_ASSERT(x, ...) { if(!(x)) { SN_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
-#define SN_CORE_ASSERT(x, ...) { if(!(x)) { SN_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
+#define SN_ASSERT(x, ...) { if(!(x)) { SN_ERROR("Assertion Failed: {0}", __VA_ARGS__); SN_DEBUGBREAK(); } }
+#define SN_CORE_ASSERT(x, ...) { if(!(x)) { SN_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); SN_DEBUGBREAK(); } }
 #else
 #define SN_ASSERT(x, ...)
 #define SN_CORE_ASSERT(x, ...)
@@ -58,6 +57,9 @@
 #ifdef SN_DEBUG
 #if defined(SN_PLATFORM_WINDOWS)
 #define SN_DEBUGBREAK() __debugbreak()
+#elif defined(SN_PLATFORM_LINUX)
+#include <signal.h>
+#define SN_DEBUGBREAK() raise(SIGTRAP)
 #else
 #error "Platform doesn't support debugbreak yet!"
 #endif
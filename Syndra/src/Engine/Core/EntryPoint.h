@@ -8,12 +8,14 @@
 #include <optional>
 #include <string_view>
 
-#ifdef SN_PLATFORM_WINDOWS
+#if defined(SN_PLATFORM_WINDOWS) || defined(SN_PLATFORM_LINUX)
 
 extern Syndra::Application* Syndra::CreateApplication();
+#ifdef SN_PLATFORM_WINDOWS
 extern "C" {
 	__declspec(dllexport) uint32_t NvOptimusEnablement = 0x00000001;
 }
+#endif
 
 namespace {
 
@@ -30,6 +32,8 @@ namespace {
 			return Syndra::RendererAPI::API::Vulkan;
 		if (normalized == "opengl")
 			return Syndra::RendererAPI::API::OpenGL;
+		if (normalized == "null")
+			return Syndra::RendererAPI::API::Null;
 		return std::nullopt;
 	}
 
@@ -55,7 +59,7 @@ namespace {
 				if (i + 1 < argc)
 					cliRenderer = argv[++i];
 				else
-					SN_ERROR("Missing value for '--renderer'. Expected 'vulkan' or 'opengl'.");
+					SN_ERROR("Missing value for '--renderer'. Expected 'vulkan', 'opengl' or 'null'.");
 			}
 		}
 
@@ -71,7 +75,7 @@ namespace {
 				}
 				else
 				{
-					SN_ERROR("Invalid renderer backend '{}' from SYNDRA_RENDERER. Expected 'vulkan' or 'opengl'.", *envRendererValue);
+					SN_ERROR("Invalid renderer backend '{}' from SYNDRA_RENDERER. Expected 'vulkan', 'opengl' or 'null'.", *envRendererValue);
 				}
 			}
 		}
@@ -85,7 +89,7 @@ namespace {
 			}
 			else
 			{
-				SN_ERROR("Invalid renderer backend '{}' from command line. Expected 'vulkan' or 'opengl'.", *cliRenderer);
+				SN_ERROR("Invalid renderer backend '{}' from command line. Expected 'vulkan', 'opengl' or 'null'.", *cliRenderer);
 			}
 		}
 
@@ -104,12 +108,20 @@ int main(int argc, char** argv)
 	Syndra::Log::init();
 	SN_WARN("HELLO! Welcome to Syndra!");
 	ConfigureRendererBackend(argc, argv);
+	Syndra::Application::SetCommandLineArgs({ argc, argv });
 
 	auto app = Syndra::CreateApplication();
-	SN_PROFILE_BEGIN_SESSION("Runtime", "Runtime.json");
+	if (!app)
+		return 1;
+	// Builds that start with profiling off record on demand (Instrumentor::CaptureFrames) instead.
+	if (Syndra::Instrumentor::IsEnabled())
+		SN_PROFILE_BEGIN_SESSION("Runtime", "Runtime.json");
 	app->Run();
 	SN_PROFILE_END_SESSION();
+	const int exitCode = app->GetExitCode();
 	delete app;
+	Syndra::Log::flush();
+	return exitCode;
 }
 
-#endif // SN_PLATFORM_WINDOWS
+#endif // SN_PLATFORM_WINDOWS || SN_PLATFORM_LINUX
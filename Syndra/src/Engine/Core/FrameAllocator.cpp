@@ -0,0 +1,143 @@
+#include "lpch.h"
+#include "Engine/Core/FrameAllocator.h"
+
+#include <algorithm>
+
+namespace Syndra {
+
+	std::atomic<uint64_t> FrameAllocator::s_FrameNumber{ 0 };
+
+	namespace {
+
+		struct ThreadFrameArenas
+		{
+			LinearArena Arenas[FrameAllocator::FrameSlots];
+			uint64_t Frames[FrameAllocator::FrameSlots] = {};
+		};
+
+		thread_local ThreadFrameArenas t_FrameArenas;
+
+		LinearArena& GetThreadArena()
+		{
+			const uint64_t frame = FrameAllocator::GetFrameNumber();
+			const uint32_t slot = static_cast<uint32_t>(frame % FrameAllocator::FrameSlots);
+			if (t_FrameArenas.Frames[slot] != frame)
+			{
+				t_FrameArenas.Arenas[slot].Reset();
+				t_FrameArenas.Frames[slot] = frame;
+			}
+			return t_FrameArenas.Arenas[slot];
+		}
+
+	}
+
+	LinearArena::LinearArena(size_t blockSize)
+		: m_BlockSize(blockSize)
+	{
+	}
+
+	void* LinearArena::Allocate(size_t size, size_t alignment)
+	{
+		size = std::max<size_t>(size, 1);
+		while (true)
+		{
+			if (m_BlockIndex < m_Blocks.size())
+			{
+				Block& block = m_Blocks[m_BlockIndex];
+				const uintptr_t base = reinterpret_cast<uintptr_t>(block.Data.get());
+				const uintptr_t aligned = (base + m_Offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+				const size_t end = static_cast<size_t>(aligned - base) + size;
+				if (end <= block.Size)
+				{
+					m_UsedBytes += end - m_Offset;
+					m_Offset = end;
+					return reinterpret_cast<void*>(aligned);
+				}
+				if (m_Offset == 0 && m_BlockIndex + 1 >= m_Blocks.size())
+				{
+					// An empty last block that is too small: replace it rather than keep it around.
+					m_Blocks.erase(m_Blocks.begin() + m_BlockIndex);
+					continue;
+				}
+				++m_BlockIndex;
+				m_Offset = 0;
+				continue;
+			}
+
+			Block block;
+			block.Size = std::max(m_BlockSize, size + alignment);
+			block.Data.reset(new std::byte[block.Size]);
+			m_Blocks.push_back(std::move(block));
+		}
+	}
+
+	void LinearArena::Free(void* ptr, size_t size)
+	{
+		if (!ptr || m_BlockIndex >= m_Blocks.size())
+			return;
+
+		std::byte* top = m_Blocks[m_BlockIndex].Data.get() + m_Offset;
+		if (static_cast<std::byte*>(ptr) + size == top)
+		{
+			const size_t offset = static_cast<size_t>(static_cast<std::byte*>(ptr) - m_Blocks[m_BlockIndex].Data.get());
+			m_UsedBytes -= m_Offset - offset;
+			m_Offset = offset;
+		}
+	}
+
+	void LinearArena::Reset()
+	{
+		if (m_Blocks.size() > 1)
+		{
+			const size_t capacity = GetCapacity();
+			m_Blocks.clear();
+			Block block;
+			block.Size = capacity;
+			block.Data.reset(new std::byte[capacity]);
+			m_Blocks.push_back(std::move(block));
+		}
+		m_BlockIndex = 0;
+		m_Offset = 0;
+		m_UsedBytes = 0;
+	}
+
+	size_t LinearArena::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (const Block& block : m_Blocks)
+			capacity += block.Size;
+		return capacity;
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		s_FrameNumber.fetch_add(1, std::memory_order_release);
+	}
+
+	uint64_t FrameAllocator::GetFrameNumber()
+	{
+		return s_FrameNumber.load(std::memory_order_acquire);
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		return GetThreadArena().Allocate(size, alignment);
+	}
+
+	void FrameAllocator::Free(void* ptr, size_t size)
+	{
+		// A pointer from the other slot never sits at the top of this one, so this is a no-op for it.
+		const uint64_t frame = GetFrameNumber();
+		const uint32_t slot = static_cast<uint32_t>(frame % FrameSlots);
+		if (t_FrameArenas.Frames[slot] == frame)
+			t_FrameArenas.Arenas[slot].Free(ptr, size);
+	}
+
+	size_t FrameAllocator::GetThreadUsedBytes()
+	{
+		const uint64_t frame = GetFrameNumber();
+		const uint32_t slot = static_cast<uint32_t>(frame % FrameSlots);
+		return t_FrameArenas.Frames[slot] == frame ? t_FrameArenas.Arenas[slot].GetUsedBytes() : 0;
+	}
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Syndra {
+
+	// Bump allocator over a list of blocks. Allocating moves an offset forward, Reset() rewinds it
+	// and keeps the memory, so once the blocks have grown to what a frame needs nothing is
+	// allocated from the heap anymore. Not thread-safe.
+	class LinearArena
+	{
+	public:
+		explicit LinearArena(size_t blockSize = 64 * 1024);
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		// Only the most recent allocation is given back (so a vector that grows last can reuse its
+		// space), anything else is released by the next Reset().
+		void Free(void* ptr, size_t size);
+		// Releases every allocation. A frame that needed more than one block is merged into a single
+		// block of the combined size.
+		void Reset();
+
+		size_t GetUsedBytes() const { return m_UsedBytes; }
+		size_t GetCapacity() const;
+
+	private:
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> Data;
+			size_t Size = 0;
+		};
+
+		std::vector<Block> m_Blocks;
+		size_t m_BlockSize;
+		size_t m_BlockIndex = 0;
+		size_t m_Offset = 0;
+		size_t m_UsedBytes = 0;
+	};
+
+	// Memory for data that lives for one frame: visible lists, descriptor writes, scratch strings.
+	// Every thread allocates from its own arenas, one per frame slot. A thread's arena is reset the
+	// first time the thread allocates in a new frame that maps to that slot, so frame memory stays
+	// valid until FrameSlots frames later: the render thread may still read the previous frame's
+	// packet while the main thread builds the next one.
+	// Never keep frame memory past the end of the following frame.
+	class FrameAllocator
+	{
+	public:
+		// The frame being built plus the one the render thread may still execute (latency <= 1).
+		static constexpr uint32_t FrameSlots = 2;
+
+		// Starts a new frame. Called by Application::Run once the previous frame was handed over.
+		static void BeginFrame();
+		static uint64_t GetFrameNumber();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		static void Free(void* ptr, size_t size);
+
+		// Bytes the calling thread allocated in the current frame.
+		static size_t GetThreadUsedBytes();
+
+	private:
+		static std::atomic<uint64_t> s_FrameNumber;
+	};
+
+	// STL allocator over FrameAllocator, see FrameVector.
+	template<typename T>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameStlAllocator() noexcept = default;
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) noexcept {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* ptr, size_t count) noexcept
+		{
+			FrameAllocator::Free(ptr, count * sizeof(T));
+		}
+
+		template<typename U>
+		bool operator==(const FrameStlAllocator<U>&) const noexcept { return true; }
+		template<typename U>
+		bool operator!=(const FrameStlAllocator<U>&) const noexcept { return false; }
+	};
+
+	// Growing leaves the old storage behind until the frame slot is reused, so reserve() up front
+	// when the size is known.
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+}
@@ -0,0 +1,75 @@
+#include "lpch.h"
+#include "Engine/Core/FrameTimeHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Syndra {
+
+	namespace {
+
+		// Nearest-rank percentile of sorted samples.
+		double Percentile(const std::vector<float>& sorted, double percentile)
+		{
+			const size_t rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(sorted.size())));
+			return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+		}
+
+	}
+
+	void FrameTimeHistogram::Record(double frameTimeMs)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Samples[m_Next] = static_cast<float>(frameTimeMs);
+		m_Next = (m_Next + 1) % Capacity;
+		m_Count = std::min(m_Count + 1, Capacity);
+	}
+
+	void FrameTimeHistogram::Reset()
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Next = 0;
+		m_Count = 0;
+	}
+
+	FrameTimeStats FrameTimeHistogram::GetStats() const
+	{
+		std::vector<float> sorted;
+		{
+			std::lock_guard lock(m_Mutex);
+			sorted.assign(m_Samples.begin(), m_Samples.begin() + m_Count);
+		}
+
+		FrameTimeStats stats;
+		if (sorted.empty())
+			return stats;
+
+		std::sort(sorted.begin(), sorted.end());
+		double total = 0.0;
+		for (float sample : sorted)
+			total += sample;
+		stats.AverageMs = total / static_cast<double>(sorted.size());
+		stats.P50Ms = Percentile(sorted, 0.50);
+		stats.P95Ms = Percentile(sorted, 0.95);
+		stats.P99Ms = Percentile(sorted, 0.99);
+		stats.MaxMs = sorted.back();
+		stats.SampleCount = static_cast<uint32_t>(sorted.size());
+		return stats;
+	}
+
+	std::vector<float> FrameTimeHistogram::GetBuckets(uint32_t bucketCount, double maxMs) const
+	{
+		std::vector<float> buckets(bucketCount, 0.0f);
+		if (bucketCount == 0 || maxMs <= 0.0)
+			return buckets;
+
+		std::lock_guard lock(m_Mutex);
+		for (uint32_t i = 0; i < m_Count; ++i)
+		{
+			const uint32_t bucket = static_cast<uint32_t>(static_cast<double>(m_Samples[i]) / maxMs * bucketCount);
+			buckets[std::min(bucket, bucketCount - 1)] += 1.0f;
+		}
+		return buckets;
+	}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Syndra {
+
+	struct FrameTimeStats
+	{
+		double AverageMs = 0.0;
+		double P50Ms = 0.0;
+		double P95Ms = 0.0;
+		double P99Ms = 0.0;
+		double MaxMs = 0.0;
+		uint32_t SampleCount = 0;
+	};
+
+	// Rolling window of the last Capacity frame times. Recording only stores into a ring, so it stays
+	// on in every build; percentiles and buckets are computed when asked for.
+	class FrameTimeHistogram
+	{
+	public:
+		static constexpr uint32_t Capacity = 1024;
+
+		void Record(double frameTimeMs);
+		void Reset();
+
+		FrameTimeStats GetStats() const;
+		// Frame counts of bucketCount equal buckets from 0 to maxMs; the last one also counts slower frames.
+		std::vector<float> GetBuckets(uint32_t bucketCount, double maxMs) const;
+
+	private:
+		mutable std::mutex m_Mutex;
+		std::array<float, Capacity> m_Samples{};
+		uint32_t m_Next = 0;
+		uint32_t m_Count = 0;
+	};
+
+}
@@ -0,0 +1,732 @@
+#include "lpch.h"
+#include "Engine/Core/Instrument.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr char kTraceMagic[4] = { 'S', 'N', 'T', 'R' };
+		constexpr uint32_t kTraceVersion = 1;
+		constexpr auto kDrainInterval = std::chrono::milliseconds(1);	// while scopes are recorded
+
+		// Binary trace records. Names and thread names are written once and referenced by index
+		// afterwards, so a finished scope costs 25 bytes.
+		enum class TraceRecord : uint8_t
+		{
+			Name = 1,	// uint32 name index, string
+			Thread = 2,	// uint32 thread index, string
+			Scope = 3	// uint32 thread index, uint32 name index, uint64 start ns, uint64 duration ns
+		};
+
+		template<typename T>
+		void WriteValue(std::ostream& stream, const T& value)
+		{
+			stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		bool ReadValue(std::istream& stream, T& value)
+		{
+			return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+
+		void WriteString(std::ostream& stream, const std::string& value)
+		{
+			const uint16_t length = static_cast<uint16_t>(std::min<size_t>(value.size(), std::numeric_limits<uint16_t>::max()));
+			WriteValue(stream, length);
+			stream.write(value.data(), length);
+		}
+
+		bool ReadString(std::istream& stream, std::string& value)
+		{
+			uint16_t length = 0;
+			if (!ReadValue(stream, length))
+				return false;
+			value.resize(length);
+			return static_cast<bool>(stream.read(value.data(), length));
+		}
+
+		std::string EscapeJson(const std::string& value)
+		{
+			std::string escaped;
+			escaped.reserve(value.size());
+			for (char c : value)
+			{
+				if (c == '"' || c == '\\')
+					escaped.push_back('\\');
+				escaped.push_back(c);
+			}
+			return escaped;
+		}
+
+		// Owns the calling thread's buffer and retires it when the thread exits.
+		struct ThreadBufferOwner
+		{
+			std::shared_ptr<ProfileEventBuffer> Buffer;
+
+			~ThreadBufferOwner()
+			{
+				if (Buffer)
+					Buffer->Retire();
+			}
+		};
+
+		thread_local ThreadBufferOwner t_BufferOwner;
+
+	}
+
+	Instrumentor::Instrumentor()
+		: m_MainThreadID(std::this_thread::get_id())
+	{
+	}
+
+	Instrumentor::~Instrumentor()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_StopDrain = true;
+		}
+		m_DrainCondition.notify_all();
+		if (m_DrainThread.joinable())
+			m_DrainThread.join();
+		EndSession();
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_LatestCpuFrame = {};
+		m_CpuFrameHistory.clear();
+		m_CpuFrameCounter = 0;
+		InternalBeginSession(name, filepath);
+	}
+
+	bool Instrumentor::InternalBeginSession(const std::string& name, const std::string& filepath)
+	{
+		if (m_CurrentSession)
+		{
+			// If there is already a current session, then close it before beginning new one.
+			// Subsequent profiling output meant for the original session will end up in the
+			// newly opened session instead.  That's better than having badly formatted
+			// profiling output.
+			if (Syndra::Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
+			{
+				SN_CORE_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_CurrentSession->Name);
+			}
+			InternalEndSession();
+		}
+
+		m_JsonPath = filepath;
+		m_TracePath = std::filesystem::path(filepath).replace_extension(".sntrace").string();
+		m_TraceStream.open(m_TracePath, std::ios::binary | std::ios::trunc);
+		if (!m_TraceStream.is_open())
+		{
+			if (Syndra::Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
+			{
+				SN_CORE_ERROR("Instrumentor could not open trace file '{0}'.", m_TracePath);
+			}
+			return false;
+		}
+
+		m_CurrentSession = new InstrumentationSession({ name });
+		m_SessionStart = Now();
+		m_TraceNameIDs.clear();
+		m_TraceStream.write(kTraceMagic, sizeof(kTraceMagic));
+		WriteValue(m_TraceStream, kTraceVersion);
+		WriteString(m_TraceStream, name);
+		for (const auto& thread : m_Threads)
+		{
+			auto it = m_ThreadNames.find(thread->ThreadID);
+			if (it != m_ThreadNames.end())
+				WriteThreadName(*thread, it->second);
+		}
+
+		if (!m_DrainThread.joinable())
+			m_DrainThread = std::thread([this]() { DrainLoop(); });
+		m_DrainCondition.notify_all();
+		return true;
+	}
+
+	void Instrumentor::EndSession()
+	{
+		std::lock_guard lock(m_Mutex);
+		DrainEvents();
+		InternalEndSession();
+	}
+
+	bool Instrumentor::CaptureFrames(uint32_t frameCount, const std::string& filepath)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (frameCount == 0 || m_CurrentSession)
+			return false;
+		if (!InternalBeginSession("Capture", filepath))
+			return false;
+
+		// Recording starts with the frame after this one; the scopes already open are not recorded.
+		m_CaptureFramesLeft = frameCount;
+		m_EnabledBeforeCapture = IsEnabled();
+		s_Enabled.store(true, std::memory_order_relaxed);
+		return true;
+	}
+
+	void Instrumentor::SetEnabled(bool enabled)
+	{
+		s_Enabled.store(enabled, std::memory_order_relaxed);
+		if (!enabled)
+			return;
+
+		// The drain thread checks the flag under the mutex; passing through it here means it either
+		// sees the new value or is already waiting and gets the notification.
+		Instrumentor& instrumentor = Get();
+		{
+			std::lock_guard lock(instrumentor.m_Mutex);
+		}
+		instrumentor.m_DrainCondition.notify_all();
+	}
+
+	uint32_t Instrumentor::GetCaptureFramesLeft()
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_CaptureFramesLeft;
+	}
+
+	void Instrumentor::SetThreadName(const std::string& name)
+	{
+		// Registers the thread, so its trace index exists before the first scope.
+		GetThreadBuffer();
+
+		const std::thread::id threadID = std::this_thread::get_id();
+		std::lock_guard lock(m_Mutex);
+		m_ThreadNames[threadID] = name;
+		ThreadTrace* thread = FindThread(threadID);
+		if (m_CurrentSession && thread)
+			WriteThreadName(*thread, name);
+	}
+
+	CpuFrameProfile Instrumentor::GetLatestCpuFrameProfile()
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_LatestCpuFrame;
+	}
+
+	CpuFrameProfile Instrumentor::GetAveragedCpuFrameProfile(size_t frameCount)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		if (m_CpuFrameHistory.empty())
+			return {};
+
+		const size_t availableFrameCount = m_CpuFrameHistory.size();
+		const size_t sampleCount = std::min(
+			(frameCount == 0) ? availableFrameCount : frameCount,
+			availableFrameCount);
+
+		if (sampleCount == 0)
+			return {};
+
+		const size_t firstSampleIndex = availableFrameCount - sampleCount;
+		const CpuFrameProfile& referenceFrame = m_CpuFrameHistory.back();
+		if (!referenceFrame.Valid)
+			return {};
+
+		std::unordered_map<std::string, CpuAggregateNode> aggregatedNodes;
+		std::unordered_map<std::string, CpuAggregateNode> aggregatedThreadNodes;
+		aggregatedNodes.reserve(256);
+
+		double totalFrameTimeMs = 0.0;
+		for (size_t i = firstSampleIndex; i < availableFrameCount; ++i)
+		{
+			const CpuFrameProfile& frame = m_CpuFrameHistory[i];
+			if (!frame.Valid || frame.Root.Name.empty())
+				continue;
+
+			totalFrameTimeMs += frame.FrameTimeMs;
+			AccumulateCpuNode(frame.Root, "", aggregatedNodes);
+			for (const CpuProfileNode& thread : frame.Threads)
+				AccumulateCpuNode(thread, "", aggregatedThreadNodes);
+		}
+
+		const std::string rootPath = referenceFrame.Root.Name;
+		auto rootIt = aggregatedNodes.find(rootPath);
+		if (rootIt == aggregatedNodes.end())
+			return {};
+
+		CpuFrameProfile averagedFrame{};
+		averagedFrame.Root = BuildAveragedCpuTree(rootPath, aggregatedNodes, static_cast<double>(sampleCount));
+		for (const auto& [threadPath, threadAggregate] : aggregatedThreadNodes)
+		{
+			if (threadAggregate.ParentPath.empty())
+				averagedFrame.Threads.push_back(BuildAveragedCpuTree(threadPath, aggregatedThreadNodes, static_cast<double>(sampleCount)));
+		}
+		std::sort(averagedFrame.Threads.begin(), averagedFrame.Threads.end(), [](const CpuProfileNode& a, const CpuProfileNode& b) {
+			return a.Name < b.Name;
+		});
+
+		const size_t gpuSampleCount = std::min(sampleCount, m_GpuFrameHistory.size());
+		if (gpuSampleCount > 0)
+		{
+			std::unordered_map<std::string, CpuAggregateNode> aggregatedGpuNodes;
+			for (size_t i = m_GpuFrameHistory.size() - gpuSampleCount; i < m_GpuFrameHistory.size(); ++i)
+				AccumulateCpuNode(m_GpuFrameHistory[i], "", aggregatedGpuNodes);
+			averagedFrame.Gpu = BuildAveragedCpuTree(m_GpuFrameHistory.back().Name, aggregatedGpuNodes, static_cast<double>(gpuSampleCount));
+		}
+		averagedFrame.FrameTimeMs = totalFrameTimeMs / static_cast<double>(sampleCount);
+		averagedFrame.FrameIndex = referenceFrame.FrameIndex;
+		averagedFrame.Valid = true;
+		return averagedFrame;
+	}
+
+	uint64_t Instrumentor::GetDroppedScopeCount()
+	{
+		std::lock_guard lock(m_Mutex);
+		uint64_t dropped = m_RetiredDroppedScopes;
+		for (const auto& thread : m_Threads)
+			dropped += thread->Buffer->GetDroppedScopeCount();
+		return dropped;
+	}
+
+	void Instrumentor::SubmitGpuFrame(CpuProfileNode gpuFrame)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_GpuFrameHistory.push_back(std::move(gpuFrame));
+		while (m_GpuFrameHistory.size() > kMaxCpuFrameHistory)
+			m_GpuFrameHistory.pop_front();
+	}
+
+	bool Instrumentor::ConvertTraceToJson(const std::string& tracePath, const std::string& jsonPath)
+	{
+		std::ifstream input(tracePath, std::ios::binary);
+		char magic[sizeof(kTraceMagic)] = {};
+		uint32_t version = 0;
+		std::string sessionName;
+		if (!input.read(magic, sizeof(magic)) || std::memcmp(magic, kTraceMagic, sizeof(magic)) != 0
+			|| !ReadValue(input, version) || version != kTraceVersion || !ReadString(input, sessionName))
+			return false;
+
+		std::ofstream output(jsonPath);
+		if (!output.is_open())
+			return false;
+
+		output << std::setprecision(3) << std::fixed;
+		output << "{\"otherData\": {\"session\":\"" << EscapeJson(sessionName) << "\"},\"traceEvents\":[{}";
+
+		std::vector<std::string> names;
+		TraceRecord record;
+		bool valid = true;
+		while (valid && ReadValue(input, record))
+		{
+			switch (record)
+			{
+			case TraceRecord::Name:
+			{
+				uint32_t index = 0;
+				std::string name;
+				valid = ReadValue(input, index) && ReadString(input, name);
+				if (valid && index >= names.size())
+					names.resize(index + 1);
+				if (valid)
+					names[index] = EscapeJson(name);
+				break;
+			}
+			case TraceRecord::Thread:
+			{
+				uint32_t thread = 0;
+				std::string name;
+				valid = ReadValue(input, thread) && ReadString(input, name);
+				if (valid)
+				{
+					output << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread
+						<< ",\"args\":{\"name\":\"" << EscapeJson(name) << "\"}}";
+				}
+				break;
+			}
+			case TraceRecord::Scope:
+			{
+				uint32_t thread = 0;
+				uint32_t name = 0;
+				uint64_t start = 0;
+				uint64_t duration = 0;
+				valid = ReadValue(input, thread) && ReadValue(input, name) && ReadValue(input, start) && ReadValue(input, duration)
+					&& name < names.size();
+				if (valid)
+				{
+					output << ",{\"cat\":\"function\",\"dur\":" << static_cast<double>(duration) * 0.001
+						<< ",\"name\":\"" << names[name] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+						<< ",\"ts\":" << static_cast<double>(start) * 0.001 << "}";
+				}
+				break;
+			}
+			default:
+				valid = false;
+				break;
+			}
+		}
+
+		output << "]}";
+		return valid;
+	}
+
+	double Instrumentor::MeasureScopeOverhead(uint32_t scopeCount)
+	{
+		// Draining in place stands in for the drain thread between batches.
+		ProfileEventBuffer buffer;
+		std::vector<ProfileEvent> drained;
+		drained.reserve(ProfileEventBuffer::Capacity);
+		const uint32_t batchSize = ProfileEventBuffer::Capacity / 2 - 1;
+
+		uint64_t elapsed = 0;
+		for (uint32_t recorded = 0; recorded < scopeCount;)
+		{
+			const uint32_t batch = std::min(scopeCount - recorded, batchSize);
+			const uint64_t start = Now();
+			for (uint32_t i = 0; i < batch; ++i)
+			{
+				buffer.Begin("Overhead", Now());
+				buffer.End(Now());
+			}
+			elapsed += Now() - start;
+			recorded += batch;
+
+			drained.clear();
+			buffer.Drain(drained);
+		}
+
+		return scopeCount > 0 ? static_cast<double>(elapsed) / static_cast<double>(scopeCount) : 0.0;
+	}
+
+	void Instrumentor::AccumulateCpuNode(
+		const CpuProfileNode& node,
+		const std::string& parentPath,
+		std::unordered_map<std::string, CpuAggregateNode>& aggregatedNodes)
+	{
+		if (node.Name.empty())
+			return;
+
+		const std::string currentPath = parentPath.empty() ? node.Name : parentPath + "/" + node.Name;
+
+		CpuAggregateNode& aggregate = aggregatedNodes[currentPath];
+		if (aggregate.Name.empty())
+		{
+			aggregate.Name = node.Name;
+			aggregate.ParentPath = parentPath;
+		}
+
+		aggregate.TotalTimeMs += node.TotalTimeMs;
+		aggregate.SelfTimeMs += node.SelfTimeMs;
+		aggregate.CallCount += static_cast<double>(node.CallCount);
+
+		for (const CpuProfileNode& child : node.Children)
+			AccumulateCpuNode(child, currentPath, aggregatedNodes);
+	}
+
+	CpuProfileNode Instrumentor::BuildAveragedCpuTree(
+		const std::string& nodePath,
+		const std::unordered_map<std::string, CpuAggregateNode>& aggregatedNodes,
+		double divisor)
+	{
+		auto aggregateIt = aggregatedNodes.find(nodePath);
+		if (aggregateIt == aggregatedNodes.end() || divisor <= 0.0)
+			return {};
+
+		const CpuAggregateNode& aggregate = aggregateIt->second;
+		CpuProfileNode averagedNode{};
+		averagedNode.Name = aggregate.Name;
+		averagedNode.TotalTimeMs = aggregate.TotalTimeMs / divisor;
+		averagedNode.SelfTimeMs = std::max(0.0, aggregate.SelfTimeMs / divisor);
+		averagedNode.CallCount = static_cast<uint32_t>(std::round(std::max(0.0, aggregate.CallCount / divisor)));
+
+		for (const auto& [childPath, childAggregate] : aggregatedNodes)
+		{
+			if (childAggregate.ParentPath != nodePath)
+				continue;
+
+			CpuProfileNode childNode = BuildAveragedCpuTree(childPath, aggregatedNodes, divisor);
+			if (childNode.Name.empty())
+				continue;
+			averagedNode.Children.push_back(std::move(childNode));
+		}
+
+		std::sort(averagedNode.Children.begin(), averagedNode.Children.end(), [](const CpuProfileNode& a, const CpuProfileNode& b) {
+			return a.TotalTimeMs > b.TotalTimeMs;
+		});
+
+		return averagedNode;
+	}
+
+	Instrumentor::CpuProfileNodeAccum* Instrumentor::GetOrCreateChildNode(CpuProfileNodeAccum* parent, const char* name)
+	{
+		if (parent == nullptr || name == nullptr)
+			return nullptr;
+
+		auto it = parent->ChildIndexByName.find(name);
+		if (it != parent->ChildIndexByName.end())
+			return parent->Children[it->second].get();
+
+		CpuProfileNodeAccum childNode{};
+		childNode.Name = name;
+		parent->Children.push_back(std::make_unique<CpuProfileNodeAccum>(std::move(childNode)));
+		const size_t childIndex = parent->Children.size() - 1;
+		parent->ChildIndexByName[parent->Children[childIndex]->Name] = childIndex;
+		return parent->Children[childIndex].get();
+	}
+
+	void Instrumentor::ClearCpuNode(CpuProfileNodeAccum& node)
+	{
+		node.TotalTimeMs = 0.0;
+		node.SelfTimeMs = 0.0;
+		node.CallCount = 0;
+		for (auto& child : node.Children)
+			ClearCpuNode(*child);
+	}
+
+	CpuProfileNode Instrumentor::MakeCpuSnapshot(const CpuProfileNodeAccum& node)
+	{
+		CpuProfileNode snapshot{};
+		snapshot.Name = node.Name;
+		snapshot.TotalTimeMs = node.TotalTimeMs;
+		snapshot.SelfTimeMs = std::max(0.0, node.SelfTimeMs);
+		snapshot.CallCount = node.CallCount;
+		snapshot.Children.reserve(node.Children.size());
+
+		for (const auto& child : node.Children)
+		{
+			if (!child || child->CallCount == 0)
+				continue;
+
+			snapshot.Children.push_back(MakeCpuSnapshot(*child));
+		}
+
+		std::sort(snapshot.Children.begin(), snapshot.Children.end(), [](const CpuProfileNode& a, const CpuProfileNode& b) {
+			return a.TotalTimeMs > b.TotalTimeMs;
+		});
+
+		return snapshot;
+	}
+
+	ProfileEventBuffer& Instrumentor::RegisterThread()
+	{
+		auto buffer = std::make_shared<ProfileEventBuffer>();
+		t_BufferOwner.Buffer = buffer;
+
+		std::lock_guard lock(m_Mutex);
+		auto thread = std::make_unique<ThreadTrace>();
+		thread->Buffer = buffer;
+		thread->ThreadID = std::this_thread::get_id();
+		thread->Index = m_NextThreadIndex++;
+		thread->Root.Name = "Root";
+		m_Threads.push_back(std::move(thread));
+
+		if (!m_DrainThread.joinable() && !m_StopDrain)
+			m_DrainThread = std::thread([this]() { DrainLoop(); });
+		return *buffer;
+	}
+
+	Instrumentor::ThreadTrace* Instrumentor::FindThread(std::thread::id threadID)
+	{
+		for (const auto& thread : m_Threads)
+		{
+			if (thread->ThreadID == threadID)
+				return thread.get();
+		}
+		return nullptr;
+	}
+
+	std::string Instrumentor::GetThreadName(const ThreadTrace& thread) const
+	{
+		auto it = m_ThreadNames.find(thread.ThreadID);
+		return it != m_ThreadNames.end() ? it->second : "Thread " + std::to_string(thread.Index);
+	}
+
+	void Instrumentor::DrainLoop()
+	{
+		std::unique_lock lock(m_Mutex);
+		while (!m_StopDrain)
+		{
+			// Nothing reaches the buffers while profiling is off and no session is open, so the thread
+			// sleeps until SetEnabled() or a session wakes it instead of polling.
+			if (IsEnabled() || m_CurrentSession)
+				m_DrainCondition.wait_for(lock, kDrainInterval, [this]() { return m_StopDrain; });
+			else
+				m_DrainCondition.wait(lock, [this]() { return m_StopDrain || IsEnabled() || m_CurrentSession; });
+			DrainEvents();
+		}
+	}
+
+	void Instrumentor::DrainEvents()
+	{
+		// A buffer retired before it is drained holds every event of its thread.
+		std::vector<bool> retired(m_Threads.size());
+		m_DrainedEvents.resize(m_Threads.size());
+		for (size_t i = 0; i < m_Threads.size(); ++i)
+		{
+			retired[i] = m_Threads[i]->Buffer->IsRetired();
+			m_DrainedEvents[i].clear();
+			m_Threads[i]->Buffer->Drain(m_DrainedEvents[i]);
+		}
+
+		// Each buffer is in timestamp order; merging them lets the scopes of other threads land in
+		// the frame they ended in.
+		std::vector<size_t> cursors(m_Threads.size(), 0);
+		while (true)
+		{
+			size_t next = m_Threads.size();
+			for (size_t i = 0; i < m_Threads.size(); ++i)
+			{
+				if (cursors[i] == m_DrainedEvents[i].size())
+					continue;
+				if (next == m_Threads.size() || m_DrainedEvents[i][cursors[i]].Timestamp < m_DrainedEvents[next][cursors[next]].Timestamp)
+					next = i;
+			}
+			if (next == m_Threads.size())
+				break;
+
+			ProcessEvent(*m_Threads[next], m_DrainedEvents[next][cursors[next]]);
+			++cursors[next];
+		}
+
+		for (size_t i = m_Threads.size(); i-- > 0;)
+		{
+			if (!retired[i])
+				continue;
+			m_RetiredDroppedScopes += m_Threads[i]->Buffer->GetDroppedScopeCount();
+			m_ThreadNames.erase(m_Threads[i]->ThreadID);
+			m_Threads.erase(m_Threads.begin() + i);
+		}
+	}
+
+	void Instrumentor::ProcessEvent(ThreadTrace& thread, const ProfileEvent& event)
+	{
+		const bool mainThread = thread.ThreadID == m_MainThreadID;
+		if (event.Type == ProfileEventType::Begin)
+		{
+			if (mainThread && thread.Stack.empty() && std::strcmp(event.Name, "Frame") == 0)
+			{
+				thread.Root.Children.clear();
+				thread.Root.ChildIndexByName.clear();
+			}
+
+			CpuProfileNodeAccum* parent = thread.Stack.empty() ? &thread.Root : thread.Stack.back().second;
+			thread.Stack.push_back({ event.Timestamp, GetOrCreateChildNode(parent, event.Name) });
+			return;
+		}
+
+		if (thread.Stack.empty())
+			return;
+
+		const auto [start, node] = thread.Stack.back();
+		thread.Stack.pop_back();
+
+		const uint64_t duration = event.Timestamp > start ? event.Timestamp - start : 0;
+		const double elapsedMs = static_cast<double>(duration) * 1e-6;
+		node->TotalTimeMs += elapsedMs;
+		node->SelfTimeMs += elapsedMs;
+		++node->CallCount;
+
+		if (!thread.Stack.empty())
+			thread.Stack.back().second->SelfTimeMs -= elapsedMs;
+
+		if (m_CurrentSession && start >= m_SessionStart)
+			WriteScope(thread, node->Name, start, duration);
+
+		if (mainThread && thread.Stack.empty() && node->Name == "Frame")
+			FinishCpuFrame(*node);
+	}
+
+	void Instrumentor::FinishCpuFrame(const CpuProfileNodeAccum& frameNode)
+	{
+		m_LatestCpuFrame = {};
+		m_LatestCpuFrame.Root = MakeCpuSnapshot(frameNode);
+		m_LatestCpuFrame.FrameTimeMs = frameNode.TotalTimeMs;
+		m_LatestCpuFrame.FrameIndex = ++m_CpuFrameCounter;
+		m_LatestCpuFrame.Valid = true;
+		if (!m_GpuFrameHistory.empty())
+			m_LatestCpuFrame.Gpu = m_GpuFrameHistory.back();
+
+		// Other threads keep their nodes, which open scopes still point at, and only restart counting.
+		for (const auto& thread : m_Threads)
+		{
+			if (thread->ThreadID == m_MainThreadID)
+				continue;
+
+			CpuProfileNode threadNode = MakeCpuSnapshot(thread->Root);
+			ClearCpuNode(thread->Root);
+			if (threadNode.Children.empty())
+				continue;
+
+			threadNode.Name = GetThreadName(*thread);
+			threadNode.SelfTimeMs = 0.0;
+			threadNode.CallCount = 1;
+			for (const CpuProfileNode& child : threadNode.Children)
+				threadNode.TotalTimeMs += child.TotalTimeMs;
+			m_LatestCpuFrame.Threads.push_back(std::move(threadNode));
+		}
+		std::sort(m_LatestCpuFrame.Threads.begin(), m_LatestCpuFrame.Threads.end(), [](const CpuProfileNode& a, const CpuProfileNode& b) {
+			return a.Name < b.Name;
+		});
+
+		m_CpuFrameHistory.push_back(m_LatestCpuFrame);
+		while (m_CpuFrameHistory.size() > kMaxCpuFrameHistory)
+			m_CpuFrameHistory.pop_front();
+
+		if (m_CaptureFramesLeft > 0 && --m_CaptureFramesLeft == 0)
+		{
+			InternalEndSession();
+			s_Enabled.store(m_EnabledBeforeCapture, std::memory_order_relaxed);
+		}
+	}
+
+	void Instrumentor::WriteThreadName(const ThreadTrace& thread, const std::string& name)
+	{
+		WriteValue(m_TraceStream, TraceRecord::Thread);
+		WriteValue(m_TraceStream, thread.Index);
+		WriteString(m_TraceStream, name);
+	}
+
+	void Instrumentor::WriteScope(const ThreadTrace& thread, const std::string& name, uint64_t start, uint64_t duration)
+	{
+		auto it = m_TraceNameIDs.find(name);
+		if (it == m_TraceNameIDs.end())
+		{
+			const uint32_t nameID = static_cast<uint32_t>(m_TraceNameIDs.size());
+			it = m_TraceNameIDs.emplace(name, nameID).first;
+			WriteValue(m_TraceStream, TraceRecord::Name);
+			WriteValue(m_TraceStream, nameID);
+			WriteString(m_TraceStream, name);
+		}
+
+		WriteValue(m_TraceStream, TraceRecord::Scope);
+		WriteValue(m_TraceStream, thread.Index);
+		WriteValue(m_TraceStream, it->second);
+		WriteValue(m_TraceStream, start - m_SessionStart);
+		WriteValue(m_TraceStream, duration);
+	}
+
+	// Note: you must already own lock on m_Mutex before
+	// calling InternalEndSession()
+	void Instrumentor::InternalEndSession()
+	{
+		if (!m_CurrentSession)
+			return;
+
+		m_TraceStream.close();
+		if (!ConvertTraceToJson(m_TracePath, m_JsonPath) && Syndra::Log::GetCoreLogger())
+		{
+			SN_CORE_ERROR("Instrumentor could not convert trace '{0}' into '{1}'.", m_TracePath, m_JsonPath);
+		}
+		delete m_CurrentSession;
+		m_CurrentSession = nullptr;
+		if (m_CaptureFramesLeft > 0)
+		{
+			m_CaptureFramesLeft = 0;
+			s_Enabled.store(m_EnabledBeforeCapture, std::memory_order_relaxed);
+		}
+	}
+
+}
@@ -4,35 +4,47 @@
 
 
 #include "Log.h"
+#include "FrameTimeHistogram.h"
 
-#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <fstream>
-#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
-#include <mutex>
-#include <sstream>
-#include <cmath>
-#include <cstdint>
-#include <cstring>
-#include <memory>
 #include <unordered_map>
+#include <type_traits>
 #include <vector>
 
-namespace Syndra {
+// Profiling is built into every configuration and records while Instrumentor::IsEnabled(), which
+// debug builds start with and release builds leave to the user. Define SN_PROFILE 0 to compile it out.
+#ifndef SN_PROFILE
+	#define SN_PROFILE 1
+#endif
 
-	using FloatingPointMicroseconds = std::chrono::duration<double, std::micro>;
+#ifndef SN_PROFILE_ENABLED_BY_DEFAULT
+	#if SN_DEBUG
+		#define SN_PROFILE_ENABLED_BY_DEFAULT 1
+	#else
+		#define SN_PROFILE_ENABLED_BY_DEFAULT 0
+	#endif
+#endif
 
-	struct ProfileResult
-	{
-		std::string Name;
+// Scope categories. SN_PROFILE_CATEGORIES selects the ones compiled in, scopes of the others cost nothing.
+#define SN_PROFILE_CATEGORY_GENERAL		(1u << 0)
+#define SN_PROFILE_CATEGORY_RENDERER	(1u << 1)
+#define SN_PROFILE_CATEGORY_JOBS		(1u << 2)
+#define SN_PROFILE_CATEGORY_ALL			0xffffffffu
 
-		FloatingPointMicroseconds Start;
-		std::chrono::microseconds ElapsedTime;
-		std::thread::id ThreadID;
-	};
+#ifndef SN_PROFILE_CATEGORIES
+	#define SN_PROFILE_CATEGORIES SN_PROFILE_CATEGORY_ALL
+#endif
+
+namespace Syndra {
 
 	struct CpuProfileNode
 	{
@@ -46,6 +58,10 @@ namespace Syndra {
 	struct CpuFrameProfile
 	{
 		CpuProfileNode Root;
+		// Scopes other threads ended during the frame, one root per thread named after it.
+		std::vector<CpuProfileNode> Threads;
+		// Render passes timed on the GPU (see GpuProfiler), named "GPU"; empty without GPU timings.
+		CpuProfileNode Gpu;
 		double FrameTimeMs = 0.0;
 		uint64_t FrameIndex = 0;
 		bool Valid = false;
@@ -56,180 +72,154 @@ namespace Syndra {
 		std::string Name;
 	};
 
-	class Instrumentor
+	enum class ProfileEventType : uint32_t
 	{
-	public:
-		Instrumentor(const Instrumentor&) = delete;
-		Instrumentor(Instrumentor&&) = delete;
-
-		void BeginSession(const std::string& name, const std::string& filepath = "results.json")
-		{
-			std::lock_guard lock(m_Mutex);
-			ResetCpuFrameState();
-			m_LatestCpuFrame = {};
-			m_CpuFrameHistory.clear();
-			m_CpuFrameCounter = 0;
+		Begin, End
+	};
 
-			if (m_CurrentSession)
-			{
-				// If there is already a current session, then close it before beginning new one.
-				// Subsequent profiling output meant for the original session will end up in the
-				// newly opened session instead.  That's better than having badly formatted
-				// profiling output.
-				if (Syndra::Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
-				{
-					SN_CORE_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_CurrentSession->Name);
-				}
-				InternalEndSession();
-			}
-			m_OutputStream.open(filepath);
+	// One scope boundary of a thread. Name has to outlive the session, SN_PROFILE_SCOPE names are static.
+	struct ProfileEvent
+	{
+		uint64_t Timestamp = 0;	// steady clock nanoseconds
+		const char* Name = nullptr;
+		ProfileEventType Type = ProfileEventType::Begin;
+	};
 
-			if (m_OutputStream.is_open())
-			{
-				m_CurrentSession = new InstrumentationSession({ name });
-				WriteHeader();
-			}
-			else
-			{
-				if (Syndra::Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
-				{
-					SN_CORE_ERROR("Instrumentor could not open results file '{0}'.", filepath);
-				}
-			}
-		}
+	// Single-producer, single-consumer ring of one thread's scope events. The owning thread pushes
+	// without locks and the Instrumentor's drain thread pops. A Begin is only accepted while the ring
+	// also has room for the End of every open scope, so a full ring drops whole scopes (and everything
+	// nested in them) instead of unbalancing the consumer's scope stack.
+	class ProfileEventBuffer
+	{
+	public:
+		static constexpr uint32_t Capacity = 1 << 15;
 
-		void EndSession()
+		ProfileEventBuffer()
+			: m_Events(std::make_unique<ProfileEvent[]>(Capacity))
 		{
-			std::lock_guard lock(m_Mutex);
-			InternalEndSession();
 		}
 
-		void WriteProfile(const ProfileResult& result)
+		void Begin(const char* name, uint64_t timestamp)
 		{
-			std::stringstream json;
-
-			json << std::setprecision(3) << std::fixed;
-			json << ",{";
-			json << "\"cat\":\"function\",";
-			json << "\"dur\":" << (result.ElapsedTime.count()) << ',';
-			json << "\"name\":\"" << result.Name << "\",";
-			json << "\"ph\":\"X\",";
-			json << "\"pid\":0,";
-			json << "\"tid\":" << result.ThreadID << ",";
-			json << "\"ts\":" << result.Start.count();
-			json << "}";
-
-			std::lock_guard lock(m_Mutex);
-			if (m_CurrentSession)
+			++m_Depth;
+			if (m_SkipDepth != 0)
+				return;
+
+			const uint64_t head = m_Head.load(std::memory_order_relaxed);
+			if (Capacity - (head - m_Tail.load(std::memory_order_acquire)) < m_Depth + 1)
 			{
-				m_OutputStream << json.str();
-				m_OutputStream.flush();
+				m_SkipDepth = m_Depth;
+				m_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
 			}
+			Push({ timestamp, name, ProfileEventType::Begin });
 		}
 
-		void BeginCpuScope(const char* name, std::thread::id threadID)
+		void End(uint64_t timestamp)
 		{
-			if (name == nullptr || threadID != m_MainThreadID)
+			if (m_SkipDepth != 0)
+			{
+				if (m_Depth == m_SkipDepth)
+					m_SkipDepth = 0;
+				--m_Depth;
 				return;
-
-			std::lock_guard lock(m_Mutex);
-
-			if (std::strcmp(name, "Frame") == 0 && m_CpuScopeStack.empty())
-				ResetCpuFrameState();
-
-			CpuProfileNodeAccum* parent = m_CpuScopeStack.empty() ? &m_CpuRoot : m_CpuScopeStack.back();
-			CpuProfileNodeAccum* child = GetOrCreateChildNode(parent, name);
-			if (child != nullptr)
-				m_CpuScopeStack.push_back(child);
+			}
+			--m_Depth;
+			// The matching Begin reserved this slot.
+			Push({ timestamp, nullptr, ProfileEventType::End });
 		}
 
-		void EndCpuScope(const char* name, std::chrono::microseconds elapsedTime, std::thread::id threadID)
+		// Consumer side: appends every event pushed so far to outEvents.
+		void Drain(std::vector<ProfileEvent>& outEvents)
 		{
-			if (name == nullptr || threadID != m_MainThreadID)
-				return;
-
-			std::lock_guard lock(m_Mutex);
-			if (m_CpuScopeStack.empty())
-				return;
-
-			CpuProfileNodeAccum* node = m_CpuScopeStack.back();
-			m_CpuScopeStack.pop_back();
-
-			const double elapsedMs = static_cast<double>(elapsedTime.count()) * 0.001;
-			node->TotalTimeMs += elapsedMs;
-			node->SelfTimeMs += elapsedMs;
-			++node->CallCount;
-
-			if (!m_CpuScopeStack.empty())
-				m_CpuScopeStack.back()->SelfTimeMs -= elapsedMs;
-
-			if (std::strcmp(name, "Frame") == 0 && m_CpuScopeStack.empty())
-			{
-				m_LatestCpuFrame = {};
-				m_LatestCpuFrame.Root = MakeCpuSnapshot(*node);
-				m_LatestCpuFrame.FrameTimeMs = node->TotalTimeMs;
-				m_LatestCpuFrame.FrameIndex = ++m_CpuFrameCounter;
-				m_LatestCpuFrame.Valid = true;
-
-				m_CpuFrameHistory.push_back(m_LatestCpuFrame);
-				while (m_CpuFrameHistory.size() > kMaxCpuFrameHistory)
-					m_CpuFrameHistory.pop_front();
-			}
+			uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+			const uint64_t head = m_Head.load(std::memory_order_acquire);
+			for (; tail != head; ++tail)
+				outEvents.push_back(m_Events[tail & (Capacity - 1)]);
+			m_Tail.store(tail, std::memory_order_release);
 		}
 
-		CpuFrameProfile GetLatestCpuFrameProfile()
+		// Called once the owning thread exits; events pushed before stay drainable.
+		void Retire() { m_Retired.store(true, std::memory_order_release); }
+		bool IsRetired() const { return m_Retired.load(std::memory_order_acquire); }
+		uint64_t GetDroppedScopeCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+	private:
+		void Push(const ProfileEvent& event)
 		{
-			std::lock_guard lock(m_Mutex);
-			return m_LatestCpuFrame;
+			const uint64_t head = m_Head.load(std::memory_order_relaxed);
+			m_Events[head & (Capacity - 1)] = event;
+			m_Head.store(head + 1, std::memory_order_release);
 		}
 
-		CpuFrameProfile GetAveragedCpuFrameProfile(size_t frameCount)
-		{
-			std::lock_guard lock(m_Mutex);
+	private:
+		std::unique_ptr<ProfileEvent[]> m_Events;
+		alignas(64) std::atomic<uint64_t> m_Head{ 0 };
+		// Producer-only: nesting depth, and the depth of the dropped scope being skipped (0 if none).
+		uint32_t m_Depth = 0;
+		uint32_t m_SkipDepth = 0;
+		std::atomic<uint64_t> m_Dropped{ 0 };
+		alignas(64) std::atomic<uint64_t> m_Tail{ 0 };
+		std::atomic<bool> m_Retired{ false };
+	};
+
+	// Every thread records its scopes into its own ProfileEventBuffer. A background thread drains
+	// the buffers about once a millisecond, rebuilds the scope hierarchy of each thread into the
+	// CpuFrameProfile aggregation (frames are delimited by the main thread's "Frame" scope) and, during
+	// a session, appends the finished scopes to a compact binary trace that EndSession converts into
+	// chrome://tracing / Perfetto JSON.
+	class Instrumentor
+	{
+	public:
+		Instrumentor(const Instrumentor&) = delete;
+		Instrumentor(Instrumentor&&) = delete;
 
-			if (m_CpuFrameHistory.empty())
-				return {};
+		// The binary trace is written next to filepath with the .sntrace extension, the JSON to filepath.
+		void BeginSession(const std::string& name, const std::string& filepath = "results.json");
+		void EndSession();
 
-			const size_t availableFrameCount = m_CpuFrameHistory.size();
-			const size_t sampleCount = std::min(
-				(frameCount == 0) ? availableFrameCount : frameCount,
-				availableFrameCount);
+		// Records the next frameCount frames into a session written to filepath, with recording
+		// enabled until the capture ends. Fails while another session is open.
+		bool CaptureFrames(uint32_t frameCount, const std::string& filepath);
+		// Frames the running capture still records, 0 when none runs.
+		uint32_t GetCaptureFramesLeft();
 
-			if (sampleCount == 0)
-				return {};
+		// Labels the calling thread's lane in the trace (chrome://tracing thread_name metadata).
+		void SetThreadName(const std::string& name);
 
-			const size_t firstSampleIndex = availableFrameCount - sampleCount;
-			const CpuFrameProfile& referenceFrame = m_CpuFrameHistory.back();
-			if (!referenceFrame.Valid)
-				return {};
+		CpuFrameProfile GetLatestCpuFrameProfile();
+		CpuFrameProfile GetAveragedCpuFrameProfile(size_t frameCount);
+		// Scopes lost to full buffers since startup.
+		uint64_t GetDroppedScopeCount();
 
-			std::unordered_map<std::string, CpuAggregateNode> aggregatedNodes;
-			aggregatedNodes.reserve(256);
+		// Adds the pass tree of a frame the GPU finished. GPU frames resolve a few frames after the
+		// CPU frames that recorded them, so averaged profiles pair the latest of each.
+		void SubmitGpuFrame(CpuProfileNode gpuFrame);
 
-			double totalFrameTimeMs = 0.0;
-			for (size_t i = firstSampleIndex; i < availableFrameCount; ++i)
-			{
-				const CpuFrameProfile& frame = m_CpuFrameHistory[i];
-				if (!frame.Valid || frame.Root.Name.empty())
-					continue;
+		// Scopes are only recorded while enabled; a disabled scope costs one predictable branch.
+		static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+		static void SetEnabled(bool enabled);
 
-				totalFrameTimeMs += frame.FrameTimeMs;
-				AccumulateCpuNode(frame.Root, "", aggregatedNodes);
-			}
+		// Frame times are recorded whether scopes are enabled or not.
+		void RecordFrameTime(double frameTimeMs) { m_FrameTimes.Record(frameTimeMs); }
+		const FrameTimeHistogram& GetFrameTimeHistogram() const { return m_FrameTimes; }
+
+		// Records a scope boundary of the calling thread; lock-free after the thread's first scope.
+		static void BeginScope(const char* name) { GetThreadBuffer().Begin(name, Now()); }
+		static void EndScope() { GetThreadBuffer().End(Now()); }
 
-			const std::string rootPath = referenceFrame.Root.Name;
-			auto rootIt = aggregatedNodes.find(rootPath);
-			if (rootIt == aggregatedNodes.end())
-				return {};
-
-			CpuFrameProfile averagedFrame{};
-			averagedFrame.Root = BuildAveragedCpuTree(rootPath, aggregatedNodes, static_cast<double>(sampleCount));
-			averagedFrame.FrameTimeMs = totalFrameTimeMs / static_cast<double>(sampleCount);
-			averagedFrame.FrameIndex = referenceFrame.FrameIndex;
-			averagedFrame.Valid = true;
-			return averagedFrame;
+		static uint64_t Now()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
 		}
 
+		// Writes the chrome://tracing / Perfetto JSON of a binary trace written by a session.
+		static bool ConvertTraceToJson(const std::string& tracePath, const std::string& jsonPath);
+		// Average cost in nanoseconds of recording one empty scope, measured on a private buffer so
+		// the samples stay out of the profile.
+		static double MeasureScopeOverhead(uint32_t scopeCount = 1000000);
+
 		static Instrumentor& Get()
 		{
 			static Instrumentor instance;
@@ -255,172 +245,94 @@ namespace Syndra {
 			std::unordered_map<std::string, size_t> ChildIndexByName;
 		};
 
-		static void AccumulateCpuNode(
-			const CpuProfileNode& node,
-			const std::string& parentPath,
-			std::unordered_map<std::string, CpuAggregateNode>& aggregatedNodes)
+		// Drain-side state of one registered thread.
+		struct ThreadTrace
 		{
-			if (node.Name.empty())
-				return;
-
-			const std::string currentPath = parentPath.empty() ? node.Name : parentPath + "/" + node.Name;
-
-			CpuAggregateNode& aggregate = aggregatedNodes[currentPath];
-			if (aggregate.Name.empty())
-			{
-				aggregate.Name = node.Name;
-				aggregate.ParentPath = parentPath;
-			}
-
-			aggregate.TotalTimeMs += node.TotalTimeMs;
-			aggregate.SelfTimeMs += node.SelfTimeMs;
-			aggregate.CallCount += static_cast<double>(node.CallCount);
+			std::shared_ptr<ProfileEventBuffer> Buffer;
+			std::thread::id ThreadID;
+			uint32_t Index = 0;
+			// Open scopes as (start timestamp, node).
+			std::vector<std::pair<uint64_t, CpuProfileNodeAccum*>> Stack;
+			CpuProfileNodeAccum Root;
+		};
 
-			for (const CpuProfileNode& child : node.Children)
-				AccumulateCpuNode(child, currentPath, aggregatedNodes);
+		static ProfileEventBuffer& GetThreadBuffer()
+		{
+			static thread_local ProfileEventBuffer* s_Buffer = nullptr;
+			if (s_Buffer == nullptr)
+				s_Buffer = &Get().RegisterThread();
+			return *s_Buffer;
 		}
 
+		static void AccumulateCpuNode(
+			const CpuProfileNode& node,
+			const std::string& parentPath,
+			std::unordered_map<std::string, CpuAggregateNode>& aggregatedNodes);
 		static CpuProfileNode BuildAveragedCpuTree(
 			const std::string& nodePath,
 			const std::unordered_map<std::string, CpuAggregateNode>& aggregatedNodes,
-			double divisor)
-		{
-			auto aggregateIt = aggregatedNodes.find(nodePath);
-			if (aggregateIt == aggregatedNodes.end() || divisor <= 0.0)
-				return {};
-
-			const CpuAggregateNode& aggregate = aggregateIt->second;
-			CpuProfileNode averagedNode{};
-			averagedNode.Name = aggregate.Name;
-			averagedNode.TotalTimeMs = aggregate.TotalTimeMs / divisor;
-			averagedNode.SelfTimeMs = std::max(0.0, aggregate.SelfTimeMs / divisor);
-			averagedNode.CallCount = static_cast<uint32_t>(std::round(std::max(0.0, aggregate.CallCount / divisor)));
-
-			for (const auto& [childPath, childAggregate] : aggregatedNodes)
-			{
-				if (childAggregate.ParentPath != nodePath)
-					continue;
-
-				CpuProfileNode childNode = BuildAveragedCpuTree(childPath, aggregatedNodes, divisor);
-				if (childNode.Name.empty())
-					continue;
-				averagedNode.Children.push_back(std::move(childNode));
-			}
-
-			std::sort(averagedNode.Children.begin(), averagedNode.Children.end(), [](const CpuProfileNode& a, const CpuProfileNode& b) {
-				return a.TotalTimeMs > b.TotalTimeMs;
-			});
-
-			return averagedNode;
-		}
-
-		CpuProfileNodeAccum* GetOrCreateChildNode(CpuProfileNodeAccum* parent, const char* name)
-		{
-			if (parent == nullptr || name == nullptr)
-				return nullptr;
-
-			auto it = parent->ChildIndexByName.find(name);
-			if (it != parent->ChildIndexByName.end())
-				return parent->Children[it->second].get();
-
-			CpuProfileNodeAccum childNode{};
-			childNode.Name = name;
-			parent->Children.push_back(std::make_unique<CpuProfileNodeAccum>(std::move(childNode)));
-			const size_t childIndex = parent->Children.size() - 1;
-			parent->ChildIndexByName[parent->Children[childIndex]->Name] = childIndex;
-			return parent->Children[childIndex].get();
-		}
-
-		void ResetCpuFrameState()
-		{
-			m_CpuScopeStack.clear();
-			m_CpuRoot.TotalTimeMs = 0.0;
-			m_CpuRoot.SelfTimeMs = 0.0;
-			m_CpuRoot.CallCount = 0;
-			m_CpuRoot.Children.clear();
-			m_CpuRoot.ChildIndexByName.clear();
-		}
-
-		static CpuProfileNode MakeCpuSnapshot(const CpuProfileNodeAccum& node)
-		{
-			CpuProfileNode snapshot{};
-			snapshot.Name = node.Name;
-			snapshot.TotalTimeMs = node.TotalTimeMs;
-			snapshot.SelfTimeMs = std::max(0.0, node.SelfTimeMs);
-			snapshot.CallCount = node.CallCount;
-			snapshot.Children.reserve(node.Children.size());
-
-			for (const auto& child : node.Children)
-			{
-				if (!child || child->CallCount == 0)
-					continue;
-
-				snapshot.Children.push_back(MakeCpuSnapshot(*child));
-			}
-
-			std::sort(snapshot.Children.begin(), snapshot.Children.end(), [](const CpuProfileNode& a, const CpuProfileNode& b) {
-				return a.TotalTimeMs > b.TotalTimeMs;
-			});
-
-			return snapshot;
-		}
-
-		Instrumentor()
-			: m_CurrentSession(nullptr), m_MainThreadID(std::this_thread::get_id())
-		{
-			m_CpuRoot.Name = "Root";
-		}
-
-		~Instrumentor()
-		{
-			EndSession();
-		}
-
-		void WriteHeader()
-		{
-			m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
-			m_OutputStream.flush();
-		}
-
-		void WriteFooter()
-		{
-			m_OutputStream << "]}";
-			m_OutputStream.flush();
-		}
-
-		// Note: you must already own lock on m_Mutex before
-		// calling InternalEndSession()
-		void InternalEndSession()
-		{
-			if (m_CurrentSession)
-			{
-				WriteFooter();
-				m_OutputStream.close();
-				delete m_CurrentSession;
-				m_CurrentSession = nullptr;
-			}
-		}
+			double divisor);
+		static CpuProfileNodeAccum* GetOrCreateChildNode(CpuProfileNodeAccum* parent, const char* name);
+		static void ClearCpuNode(CpuProfileNodeAccum& node);
+		static CpuProfileNode MakeCpuSnapshot(const CpuProfileNodeAccum& node);
+
+		Instrumentor();
+		~Instrumentor();
+
+		ProfileEventBuffer& RegisterThread();
+		ThreadTrace* FindThread(std::thread::id threadID);
+		std::string GetThreadName(const ThreadTrace& thread) const;
+
+		// The members below are guarded by m_Mutex.
+		void DrainLoop();
+		void DrainEvents();
+		void ProcessEvent(ThreadTrace& thread, const ProfileEvent& event);
+		void FinishCpuFrame(const CpuProfileNodeAccum& frameNode);
+
+		void WriteThreadName(const ThreadTrace& thread, const std::string& name);
+		void WriteScope(const ThreadTrace& thread, const std::string& name, uint64_t start, uint64_t duration);
+		bool InternalBeginSession(const std::string& name, const std::string& filepath);
+		void InternalEndSession();
 	private:
 		static constexpr size_t kMaxCpuFrameHistory = 240;
+		inline static std::atomic<bool> s_Enabled{ SN_PROFILE_ENABLED_BY_DEFAULT != 0 };
 		std::mutex m_Mutex;
-		InstrumentationSession* m_CurrentSession;
-		std::ofstream m_OutputStream;
+		std::condition_variable m_DrainCondition;
+		std::thread m_DrainThread;
+		bool m_StopDrain = false;
 		std::thread::id m_MainThreadID;
-		CpuProfileNodeAccum m_CpuRoot;
-		std::vector<CpuProfileNodeAccum*> m_CpuScopeStack;
+		std::vector<std::unique_ptr<ThreadTrace>> m_Threads;
+		std::vector<std::vector<ProfileEvent>> m_DrainedEvents;
+		std::unordered_map<std::thread::id, std::string> m_ThreadNames;
+		uint32_t m_NextThreadIndex = 0;
+		uint64_t m_RetiredDroppedScopes = 0;
+
 		CpuFrameProfile m_LatestCpuFrame;
 		std::deque<CpuFrameProfile> m_CpuFrameHistory;
+		std::deque<CpuProfileNode> m_GpuFrameHistory;
 		uint64_t m_CpuFrameCounter = 0;
+
+		InstrumentationSession* m_CurrentSession = nullptr;
+		std::ofstream m_TraceStream;
+		std::string m_TracePath;
+		std::string m_JsonPath;
+		uint64_t m_SessionStart = 0;
+		std::unordered_map<std::string, uint32_t> m_TraceNameIDs;
+		uint32_t m_CaptureFramesLeft = 0;
+		bool m_EnabledBeforeCapture = false;
+
+		FrameTimeHistogram m_FrameTimes;
 	};
 
 	class InstrumentationTimer
 	{
 	public:
+		// name has to outlive the profiling session, see ProfileEvent.
 		InstrumentationTimer(const char* name)
-			: m_Name(name), m_Stopped(false)
+			: m_Name(name ? name : "Unnamed"), m_Stopped(!Instrumentor::IsEnabled())
 		{
-			m_StartTimepoint = std::chrono::steady_clock::now();
-			Instrumentor::Get().BeginCpuScope(m_Name, std::this_thread::get_id());
+			if (!m_Stopped)
+				Instrumentor::BeginScope(m_Name);
 		}
 
 		~InstrumentationTimer()
@@ -431,21 +343,24 @@ namespace Syndra {
 
 		void Stop()
 		{
-			auto endTimepoint = std::chrono::steady_clock::now();
-			auto highResStart = FloatingPointMicroseconds{ m_StartTimepoint.time_since_epoch() };
-			auto elapsedTime = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch() - std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch();
-
-			Instrumentor::Get().EndCpuScope(m_Name, elapsedTime, std::this_thread::get_id());
-			Instrumentor::Get().WriteProfile({ m_Name, highResStart, elapsedTime, std::this_thread::get_id() });
-
+			Instrumentor::EndScope();
 			m_Stopped = true;
 		}
 	private:
 		const char* m_Name;
-		std::chrono::time_point<std::chrono::steady_clock> m_StartTimepoint;
 		bool m_Stopped;
 	};
 
+	// Stands in for InstrumentationTimer in categories left out of SN_PROFILE_CATEGORIES.
+	class DisabledInstrumentationTimer
+	{
+	public:
+		constexpr explicit DisabledInstrumentationTimer(const char*) {}
+	};
+
+	template<uint32_t Category>
+	using CategoryInstrumentationTimer = std::conditional_t<(SN_PROFILE_CATEGORIES & Category) != 0, InstrumentationTimer, DisabledInstrumentationTimer>;
+
 	namespace InstrumentorUtils {
 
 		template <size_t N>
@@ -475,12 +390,6 @@ namespace Syndra {
 		}
 	}
 }
-#if SN_DEBUG
-	#define SN_PROFILE 1
-#else
-	#define SN_PROFILE 0
-#endif
-
 #if SN_PROFILE
 // Resolve which function signature macro will be used. Note that this only
 // is resolved when the (pre)compiler starts, so the syntax highlighting
@@ -505,14 +414,16 @@ namespace Syndra {
 
 #define SN_PROFILE_BEGIN_SESSION(name, filepath) ::Syndra::Instrumentor::Get().BeginSession(name, filepath)
 #define SN_PROFILE_END_SESSION() ::Syndra::Instrumentor::Get().EndSession()
-#define SN_PROFILE_SCOPE_LINE2(name, line) constexpr auto fixedName##line = ::Syndra::InstrumentorUtils::CleanupOutputString(name, "__cdecl ");\
-											   ::Syndra::InstrumentationTimer timer##line(fixedName##line.Data)
-#define SN_PROFILE_SCOPE_LINE(name, line) SN_PROFILE_SCOPE_LINE2(name, line)
-#define SN_PROFILE_SCOPE(name) SN_PROFILE_SCOPE_LINE(name, __LINE__)
+#define SN_PROFILE_SCOPE_LINE2(category, name, line) static constexpr auto fixedName##line = ::Syndra::InstrumentorUtils::CleanupOutputString(name, "__cdecl ");\
+											   ::Syndra::CategoryInstrumentationTimer<category> timer##line(fixedName##line.Data)
+#define SN_PROFILE_SCOPE_LINE(category, name, line) SN_PROFILE_SCOPE_LINE2(category, name, line)
+#define SN_PROFILE_CATEGORY_SCOPE(category, name) SN_PROFILE_SCOPE_LINE(category, name, __LINE__)
+#define SN_PROFILE_SCOPE(name) SN_PROFILE_CATEGORY_SCOPE(SN_PROFILE_CATEGORY_GENERAL, name)
 #define SN_PROFILE_FUNCTION() SN_PROFILE_SCOPE(SN_FUNC_SIG)
 #else
 #define SN_PROFILE_BEGIN_SESSION(name, filepath)
 #define SN_PROFILE_END_SESSION()
+#define SN_PROFILE_CATEGORY_SCOPE(category, name)
 #define SN_PROFILE_SCOPE(name)
 #define SN_PROFILE_FUNCTION()
 #endif
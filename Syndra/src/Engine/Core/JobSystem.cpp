@@ -0,0 +1,380 @@
+#include "lpch.h"
+#include "Engine/Core/JobSystem.h"
+
+#include "Engine/Core/Instrument.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Syndra {
+
+	struct JobState
+	{
+		JobSystem::JobFunction Function;
+		const char* Name = "Job";
+		JobAffinity Affinity = JobAffinity::Any;
+		// Starts at one so the job cannot run while Schedule() is still registering dependencies.
+		std::atomic<uint32_t> PendingDependencies{ 1 };
+		std::atomic<bool> Complete{ false };
+		std::mutex Mutex;	// guards Continuations against Complete
+		std::vector<std::shared_ptr<JobState>> Continuations;
+	};
+
+}
+
+namespace {
+
+	using JobPtr = std::shared_ptr<Syndra::JobState>;
+
+	struct WorkerQueue
+	{
+		std::mutex Mutex;
+		std::deque<JobPtr> Jobs;
+	};
+
+	struct JobSystemData
+	{
+		std::vector<std::unique_ptr<WorkerQueue>> Queues;
+		std::vector<std::thread> Workers;
+		std::atomic<bool> Running{ false };
+		std::atomic<uint32_t> QueuedJobs{ 0 };
+		std::atomic<uint32_t> NextQueue{ 0 };
+
+		std::mutex SleepMutex;
+		std::condition_variable WakeCondition;
+
+		std::mutex MainThreadMutex;
+		std::deque<JobPtr> MainThreadJobs;
+		std::thread::id MainThreadID = std::this_thread::get_id();
+	};
+
+	JobSystemData& GetData()
+	{
+		static JobSystemData s_Data;
+		return s_Data;
+	}
+
+	// Index of the worker owning the current thread, -1 for the main thread and foreign threads.
+	thread_local int t_WorkerIndex = -1;
+
+	void Execute(const JobPtr& job);
+
+	void Enqueue(const JobPtr& job)
+	{
+		auto& data = GetData();
+		if (job->Affinity == Syndra::JobAffinity::MainThread)
+		{
+			if (!data.Running && Syndra::JobSystem::IsMainThread())
+			{
+				Execute(job);
+				return;
+			}
+			std::lock_guard<std::mutex> lock(data.MainThreadMutex);
+			data.MainThreadJobs.push_back(job);
+			return;
+		}
+
+		if (!data.Running)
+		{
+			Execute(job);
+			return;
+		}
+
+		// Workers keep their own jobs local; everyone else spreads them round-robin.
+		const uint32_t queueCount = static_cast<uint32_t>(data.Queues.size());
+		const uint32_t index = t_WorkerIndex >= 0 ? static_cast<uint32_t>(t_WorkerIndex) : data.NextQueue.fetch_add(1) % queueCount;
+		{
+			std::lock_guard<std::mutex> lock(data.Queues[index]->Mutex);
+			data.Queues[index]->Jobs.push_back(job);
+		}
+		data.QueuedJobs.fetch_add(1);
+		// Taking the sleep mutex orders the notify after a worker's predicate check.
+		{
+			std::lock_guard<std::mutex> lock(data.SleepMutex);
+		}
+		data.WakeCondition.notify_one();
+	}
+
+	bool TryPop(JobPtr& outJob)
+	{
+		auto& data = GetData();
+		const uint32_t queueCount = static_cast<uint32_t>(data.Queues.size());
+		if (queueCount == 0 || data.QueuedJobs.load() == 0)
+			return false;
+
+		const int own = t_WorkerIndex;
+		if (own >= 0)
+		{
+			auto& queue = *data.Queues[own];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				outJob = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				data.QueuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		// Steal the oldest job of another queue; old jobs tend to be the large ones.
+		const uint32_t start = own >= 0 ? static_cast<uint32_t>(own) + 1 : data.NextQueue.load();
+		for (uint32_t i = 0; i < queueCount; ++i)
+		{
+			const uint32_t victim = (start + i) % queueCount;
+			if (static_cast<int>(victim) == own)
+				continue;
+
+			auto& queue = *data.Queues[victim];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				outJob = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				data.QueuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool TryPopMainThread(JobPtr& outJob)
+	{
+		auto& data = GetData();
+		std::lock_guard<std::mutex> lock(data.MainThreadMutex);
+		if (data.MainThreadJobs.empty())
+			return false;
+		outJob = std::move(data.MainThreadJobs.front());
+		data.MainThreadJobs.pop_front();
+		return true;
+	}
+
+	void Execute(const JobPtr& job)
+	{
+		{
+#if SN_PROFILE
+			Syndra::CategoryInstrumentationTimer<SN_PROFILE_CATEGORY_JOBS> timer(job->Name);
+#endif
+			job->Function();
+		}
+		job->Function = nullptr;
+
+		std::vector<JobPtr> continuations;
+		{
+			std::lock_guard<std::mutex> lock(job->Mutex);
+			job->Complete.store(true, std::memory_order_release);
+			continuations.swap(job->Continuations);
+		}
+		for (const auto& continuation : continuations)
+		{
+			if (continuation->PendingDependencies.fetch_sub(1) == 1)
+				Enqueue(continuation);
+		}
+	}
+
+	void WorkerLoop(int index)
+	{
+		t_WorkerIndex = index;
+		Syndra::Instrumentor::Get().SetThreadName("Worker " + std::to_string(index));
+
+		auto& data = GetData();
+		while (data.Running)
+		{
+			JobPtr job;
+			if (TryPop(job))
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(data.SleepMutex);
+			data.WakeCondition.wait(lock, [&data]() { return !data.Running || data.QueuedJobs.load() > 0; });
+		}
+		t_WorkerIndex = -1;
+	}
+
+}
+
+namespace Syndra {
+
+	bool JobHandle::IsComplete() const
+	{
+		return !m_State || m_State->Complete.load(std::memory_order_acquire);
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		auto& data = GetData();
+		if (data.Running)
+			return;
+
+		if (workerCount == 0)
+			workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+		workerCount = std::max(workerCount, 1u);
+
+		data.MainThreadID = std::this_thread::get_id();
+		Instrumentor::Get().SetThreadName("Main Thread");
+
+		data.Queues.clear();
+		for (uint32_t i = 0; i < workerCount; ++i)
+			data.Queues.push_back(std::make_unique<WorkerQueue>());
+
+		data.Running = true;
+		data.Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i)
+			data.Workers.emplace_back(WorkerLoop, static_cast<int>(i));
+
+		SN_CORE_INFO("JobSystem: {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		auto& data = GetData();
+		if (!data.Running)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(data.SleepMutex);
+			data.Running = false;
+		}
+		data.WakeCondition.notify_all();
+		for (auto& worker : data.Workers)
+			worker.join();
+		data.Workers.clear();
+
+		// Nothing is left to steal from us now; finish the remaining jobs here so that no handle
+		// stays incomplete. Continuations they release run inline.
+		JobPtr job;
+		while (TryPop(job))
+			Execute(job);
+		ProcessMainThreadJobs();
+		data.Queues.clear();
+	}
+
+	bool JobSystem::IsInitialized()
+	{
+		return GetData().Running;
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return static_cast<uint32_t>(GetData().Workers.size());
+	}
+
+	JobHandle JobSystem::Schedule(const char* name, JobFunction job, const std::vector<JobHandle>& dependencies, JobAffinity affinity)
+	{
+		auto state = std::make_shared<JobState>();
+		state->Function = std::move(job);
+		state->Name = name;
+		state->Affinity = affinity;
+
+		for (const auto& dependency : dependencies)
+		{
+			if (!dependency.m_State)
+				continue;
+
+			std::lock_guard<std::mutex> lock(dependency.m_State->Mutex);
+			if (!dependency.m_State->Complete.load(std::memory_order_acquire))
+			{
+				state->PendingDependencies.fetch_add(1);
+				dependency.m_State->Continuations.push_back(state);
+			}
+		}
+
+		// Drop the self reference; if every dependency already completed the job is runnable now.
+		if (state->PendingDependencies.fetch_sub(1) == 1)
+			Enqueue(state);
+		return JobHandle(std::move(state));
+	}
+
+	JobHandle JobSystem::Then(const JobHandle& dependency, const char* name, JobFunction job, JobAffinity affinity)
+	{
+		return Schedule(name, std::move(job), { dependency }, affinity);
+	}
+
+	JobHandle JobSystem::RunOnMainThread(const char* name, JobFunction job)
+	{
+		return Schedule(name, std::move(job), {}, JobAffinity::MainThread);
+	}
+
+	void JobSystem::Wait(const JobHandle& handle)
+	{
+		if (!handle.m_State)
+			return;
+
+		const bool mainThread = IsMainThread();
+		while (!handle.IsComplete())
+		{
+			JobPtr job;
+			if ((mainThread && TryPopMainThread(job)) || TryPop(job))
+			{
+				Execute(job);
+				continue;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::WaitAll(const std::vector<JobHandle>& handles)
+	{
+		for (const auto& handle : handles)
+			Wait(handle);
+	}
+
+	void JobSystem::ParallelFor(const char* name, uint32_t count, uint32_t grainSize, const RangeFunction& function)
+	{
+		if (count == 0)
+			return;
+
+		const uint32_t threadCount = GetWorkerCount() + 1;
+		if (grainSize == 0)
+			grainSize = std::max(1u, count / (threadCount * 4));
+		if (!IsInitialized() || count <= grainSize)
+		{
+			function(0, count);
+			return;
+		}
+
+		std::vector<JobHandle> chunks;
+		chunks.reserve((count + grainSize - 1) / grainSize);
+		for (uint32_t begin = 0; begin < count; begin += grainSize)
+		{
+			const uint32_t end = std::min(count, begin + grainSize);
+			chunks.push_back(Schedule(name, [&function, begin, end]() { function(begin, end); }));
+		}
+		WaitAll(chunks);
+	}
+
+	void JobSystem::ProcessMainThreadJobs()
+	{
+		// Only what is queued now; jobs these schedule for the main thread wait for the next call.
+		std::deque<JobPtr> jobs;
+		{
+			auto& data = GetData();
+			std::lock_guard<std::mutex> lock(data.MainThreadMutex);
+			jobs.swap(data.MainThreadJobs);
+		}
+		for (const auto& job : jobs)
+			Execute(job);
+	}
+
+	bool JobSystem::HasMainThreadJobs()
+	{
+		auto& data = GetData();
+		std::lock_guard<std::mutex> lock(data.MainThreadMutex);
+		return !data.MainThreadJobs.empty();
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return std::this_thread::get_id() == GetData().MainThreadID;
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return static_cast<uint32_t>(t_WorkerIndex + 1);
+	}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Syndra {
+
+	struct JobState;
+
+	enum class JobAffinity : uint8_t
+	{
+		Any = 0,
+		MainThread	// graphics API calls and anything else that must run on the main thread
+	};
+
+	// Reference to a scheduled job. Cheap to copy; an empty handle counts as complete.
+	class JobHandle
+	{
+	public:
+		JobHandle() = default;
+
+		bool IsValid() const { return m_State != nullptr; }
+		bool IsComplete() const;
+
+	private:
+		explicit JobHandle(std::shared_ptr<JobState> state)
+			: m_State(std::move(state)) {}
+
+		std::shared_ptr<JobState> m_State;
+
+		friend class JobSystem;
+	};
+
+	// Work-stealing job system. Every worker owns a deque: it pushes and pops its own jobs at the
+	// back and steals from the front of the others when it runs dry. Jobs may depend on other jobs
+	// and only become runnable once all of them completed. Threads that wait on a job keep running
+	// other jobs instead of blocking. Without Init() (tools, tests) everything runs inline.
+	class JobSystem
+	{
+	public:
+		using JobFunction = std::function<void()>;
+		using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+		// 0 uses one worker per hardware thread, minus the main thread.
+		static void Init(uint32_t workerCount = 0);
+		// Runs whatever is still queued, then stops the workers.
+		static void Shutdown();
+		static bool IsInitialized();
+		static uint32_t GetWorkerCount();
+
+		// 'name' must outlive the job (use a string literal); it labels the job in the profiler.
+		static JobHandle Schedule(const char* name, JobFunction job, const std::vector<JobHandle>& dependencies = {}, JobAffinity affinity = JobAffinity::Any);
+		static JobHandle Then(const JobHandle& dependency, const char* name, JobFunction job, JobAffinity affinity = JobAffinity::Any);
+		static JobHandle RunOnMainThread(const char* name, JobFunction job);
+
+		static void Wait(const JobHandle& handle);
+		static void WaitAll(const std::vector<JobHandle>& handles);
+
+		// Calls 'function' over [0, count) in chunks of at most 'grainSize' indices (0 picks a
+		// size that gives every thread a few chunks) and returns once all chunks are done.
+		static void ParallelFor(const char* name, uint32_t count, uint32_t grainSize, const RangeFunction& function);
+
+		// Runs the queued main-thread jobs. Called once per frame by Application::Run.
+		static void ProcessMainThreadJobs();
+		static bool HasMainThreadJobs();
+		static bool IsMainThread();
+		// 0 on the main thread (and any other non-worker thread), 1..GetWorkerCount() on workers.
+		// Lets systems keep per-thread state in a vector of GetWorkerCount() + 1 entries.
+		static uint32_t GetThreadIndex();
+	};
+
+}
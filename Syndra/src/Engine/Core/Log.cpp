@@ -1,34 +1,109 @@
 #include "lpch.h"
 #include "Engine/Core/Log.h"
 #include "spdlog/spdlog.h"
+#include "spdlog/async_logger.h"
 #include "spdlog/sinks/stdout_sinks.h"
 #include "spdlog/sinks/base_sink.h"
 #include "spdlog/fmt/ostr.h"
 #include "spdlog/sinks/ostream_sink.h"
+#ifdef SN_PLATFORM_WINDOWS
+#include "spdlog/sinks/wincolor_sink.h"
+#else
+#include "spdlog/sinks/ansicolor_sink.h"
+#endif
 
 namespace Syndra {
 
 	std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 	std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
 
-	void Log::init() {
+	namespace {
+
+		constexpr const char* kCoreLoggerName = "ENGINE";
+		constexpr const char* kClientLoggerName = "APP";
+
+		std::shared_ptr<spdlog::logger> CreateLogger(const char* name, const std::vector<spdlog::sink_ptr>& sinks, const LogSettings& settings)
+		{
+			std::shared_ptr<spdlog::logger> logger;
+			if (settings.Async)
+			{
+				// block_retry: a full queue holds the caller back rather than losing messages.
+				logger = std::make_shared<spdlog::async_logger>(name, begin(sinks), end(sinks), settings.QueueSize,
+					spdlog::async_overflow_policy::block_retry, nullptr, settings.FlushInterval);
+			}
+			else
+			{
+				logger = std::make_shared<spdlog::logger>(name, begin(sinks), end(sinks));
+			}
+
+			spdlog::drop(name);
+			spdlog::register_logger(logger);
+#ifdef SN_DIST
+			logger->set_level(spdlog::level::info);
+#else
+			logger->set_level(spdlog::level::trace);
+#endif
+			logger->flush_on(settings.FlushLevel);
+			return logger;
+		}
+
+	}
+
+	void Log::init(const LogSettings& settings) {
+
+		flush();
+		LogRateLimiter::SetEnabled(settings.RateLimit);
 
 		std::vector<spdlog::sink_ptr> logSinks;
+#ifdef SN_PLATFORM_WINDOWS
 		logSinks.emplace_back(std::make_shared<spdlog::sinks::wincolor_stderr_sink_mt>());
+#else
+		logSinks.emplace_back(std::make_shared<spdlog::sinks::ansicolor_stderr_sink_mt>());
+#endif
 		logSinks.emplace_back(std::make_shared<spdlog::sinks::simple_file_sink_mt>("Syndra-Debug.log", true));
 
-		s_CoreLogger = std::make_shared<spdlog::logger>("ENGINE", begin(logSinks), end(logSinks));
-		spdlog::register_logger(s_CoreLogger);
-		s_CoreLogger->set_level(spdlog::level::trace);
+		s_CoreLogger = CreateLogger(kCoreLoggerName, logSinks, settings);
 		s_CoreLogger->set_pattern("%^[%T] %n: %v%$");
-		s_CoreLogger->flush_on(spdlog::level::trace);
 
-		s_ClientLogger = std::make_shared<spdlog::logger>("APP", begin(logSinks), end(logSinks));
-		spdlog::register_logger(s_ClientLogger);
-		s_ClientLogger->set_level(spdlog::level::trace);
+		s_ClientLogger = CreateLogger(kClientLoggerName, logSinks, settings);
 		s_ClientLogger->set_pattern("[%T] [%l] %n: %v");
-		s_ClientLogger->flush_on(spdlog::level::trace);
 
 	}
 
-}
\ No newline at end of file
+	void Log::flush()
+	{
+		// Async loggers wait until their queue is written.
+		if (s_CoreLogger)
+			s_CoreLogger->flush();
+		if (s_ClientLogger)
+			s_ClientLogger->flush();
+	}
+
+	bool LogRateLimiter::Allow(uint32_t& suppressed)
+	{
+		if (!s_Enabled.load(std::memory_order_relaxed))
+		{
+			suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+			return true;
+		}
+
+		const int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+		int64_t windowStartMs = m_WindowStartMs.load(std::memory_order_relaxed);
+		if (nowMs - windowStartMs >= Window.count()
+			&& m_WindowStartMs.compare_exchange_strong(windowStartMs, nowMs, std::memory_order_relaxed))
+		{
+			m_Count.store(0, std::memory_order_relaxed);
+		}
+
+		if (m_Count.fetch_add(1, std::memory_order_relaxed) < MaxPerWindow)
+		{
+			suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+			return true;
+		}
+
+		m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+}
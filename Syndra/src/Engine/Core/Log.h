@@ -1,17 +1,44 @@
 #pragma once
 
 #include "Core.h"
+#ifdef _MSC_VER
 #pragma warning(push, 0)
+#endif
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
+#ifdef _MSC_VER
 #pragma warning(pop)
+#endif
+
+#include <atomic>
+#include <chrono>
 
 namespace Syndra {
+
+	struct LogSettings
+	{
+		// Records go through a lock-free queue to a background thread that formats and writes them,
+		// so the calling thread never waits on the console or the log file. When false, records
+		// are written on the calling thread.
+		bool Async = true;
+		// Records the queue holds, a power of two. A full queue makes the calling thread wait.
+		size_t QueueSize = 8192;
+		// Records at or above this level are flushed right away.
+		spdlog::level::level_enum FlushLevel = spdlog::level::warn;
+		// Async only: the writer thread also flushes once it was idle for this long.
+		std::chrono::milliseconds FlushInterval{ 1000 };
+		// When false the *_LIMITED macros let every message through, e.g. to see all of a load.
+		bool RateLimit = true;
+	};
+
 	class Log
 	{
 	public:
 
-		static void init();
+		// Can be called again to apply other settings; the previous loggers are flushed and replaced.
+		static void init(const LogSettings& settings = LogSettings());
+		// Writes out everything still queued.
+		static void flush();
 		inline static std::shared_ptr<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
 		inline static std::shared_ptr<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
 
@@ -20,21 +47,68 @@ namespace Syndra {
 		static std::shared_ptr<spdlog::logger> s_ClientLogger;
 
 	};
+
+	// Limits one call site to MaxPerWindow messages per Window. Dropped messages are counted and
+	// reported with the next message that gets through. Used by the *_LIMITED macros for messages
+	// inside loops, such as one per entity or texture while loading.
+	class LogRateLimiter
+	{
+	public:
+		static constexpr uint32_t MaxPerWindow = 16;
+		static constexpr std::chrono::milliseconds Window{ 1000 };
+
+		// suppressed receives the number of messages dropped since the last one let through.
+		bool Allow(uint32_t& suppressed);
+
+		// Set by Log::init() from LogSettings::RateLimit.
+		static void SetEnabled(bool enabled) { s_Enabled.store(enabled, std::memory_order_relaxed); }
+	private:
+		inline static std::atomic<bool> s_Enabled{ true };
+
+		std::atomic<int64_t> m_WindowStartMs{ 0 };
+		std::atomic<uint32_t> m_Count{ 0 };
+		std::atomic<uint32_t> m_Suppressed{ 0 };
+	};
 }
 
+#define SN_LOG_LIMITED(logger, severity, ...) \
+	do { \
+		if ((logger)->should_log(spdlog::level::severity)) \
+		{ \
+			static ::Syndra::LogRateLimiter snLogRateLimiter; \
+			uint32_t snLogSuppressed = 0; \
+			if (snLogRateLimiter.Allow(snLogSuppressed)) \
+			{ \
+				if (snLogSuppressed > 0) \
+					(logger)->severity("({0} similar messages suppressed)", snLogSuppressed); \
+				(logger)->severity(__VA_ARGS__); \
+			} \
+		} \
+	} while (0)
+
 // core log macros
 #define SN_CORE_ERROR(...)  ::Syndra::Log::GetCoreLogger()->error(__VA_ARGS__)
 #define SN_CORE_WARN(...)	::Syndra::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define SN_CORE_TRACE(...)	::Syndra::Log::GetCoreLogger()->trace(__VA_ARGS__)
 #define SN_CORE_INFO(...)	::Syndra::Log::GetCoreLogger()->info(__VA_ARGS__)
 #define SN_CORE_FATAL(...)	::Syndra::Log::GetCoreLogger()->fatal(__VA_ARGS__)
-			 
-// client log macros		 
+#define SN_CORE_WARN_LIMITED(...)	SN_LOG_LIMITED(::Syndra::Log::GetCoreLogger(), warn, __VA_ARGS__)
+
+// client log macros
 #define SN_ERROR(...)		::Syndra::Log::GetClientLogger()->error(__VA_ARGS__)
 #define SN_WARN(...)		::Syndra::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define SN_TRACE(...)		::Syndra::Log::GetClientLogger()->trace(__VA_ARGS__)
 #define SN_INFO(...)		::Syndra::Log::GetClientLogger()->info(__VA_ARGS__)
 #define SN_FATAL(...)		::Syndra::Log::GetClientLogger()->fatal(__VA_ARGS__)
+#define SN_WARN_LIMITED(...)		SN_LOG_LIMITED(::Syndra::Log::GetClientLogger(), warn, __VA_ARGS__)
 
-
-
+// Dist builds compile trace messages out, arguments included.
+#ifdef SN_DIST
+#define SN_CORE_TRACE(...)			((void)0)
+#define SN_CORE_TRACE_LIMITED(...)	((void)0)
+#define SN_TRACE(...)				((void)0)
+#define SN_TRACE_LIMITED(...)		((void)0)
+#else
+#define SN_CORE_TRACE(...)			::Syndra::Log::GetCoreLogger()->trace(__VA_ARGS__)
+#define SN_CORE_TRACE_LIMITED(...)	SN_LOG_LIMITED(::Syndra::Log::GetCoreLogger(), trace, __VA_ARGS__)
+#define SN_TRACE(...)				::Syndra::Log::GetClientLogger()->trace(__VA_ARGS__)
+#define SN_TRACE_LIMITED(...)		SN_LOG_LIMITED(::Syndra::Log::GetClientLogger(), trace, __VA_ARGS__)
+#endif
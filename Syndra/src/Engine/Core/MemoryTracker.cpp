@@ -0,0 +1,225 @@
+#include "lpch.h"
+#include "Engine/Core/MemoryTracker.h"
+
+#include <atomic>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr size_t kDomainCount = static_cast<size_t>(MemoryDomain::Count);
+		constexpr size_t kCategoryCount = static_cast<size_t>(MemoryCategory::Count);
+
+		struct UsageCounters
+		{
+			std::atomic<uint64_t> Bytes{ 0 };
+			std::atomic<uint64_t> PeakBytes{ 0 };
+			std::atomic<uint32_t> Allocations{ 0 };
+			std::atomic<uint64_t> BudgetBytes{ 0 };
+		};
+
+		struct TrackerData
+		{
+			UsageCounters Categories[kDomainCount][kCategoryCount];
+			UsageCounters Totals[kDomainCount];
+		};
+
+		TrackerData& GetData()
+		{
+			static TrackerData data;
+			return data;
+		}
+
+		UsageCounters& GetCounters(MemoryDomain domain, MemoryCategory category)
+		{
+			return GetData().Categories[static_cast<size_t>(domain)][static_cast<size_t>(category)];
+		}
+
+		UsageCounters& GetTotalCounters(MemoryDomain domain)
+		{
+			return GetData().Totals[static_cast<size_t>(domain)];
+		}
+
+		// Returns the new byte count.
+		uint64_t Add(UsageCounters& counters, uint64_t bytes)
+		{
+			const uint64_t current = counters.Bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+			uint64_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+			while (current > peak && !counters.PeakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+			{
+			}
+			return current;
+		}
+
+		void Subtract(UsageCounters& counters, uint64_t bytes)
+		{
+			counters.Bytes.fetch_sub(bytes, std::memory_order_relaxed);
+			counters.Allocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		MemoryUsage ToUsage(const UsageCounters& counters)
+		{
+			MemoryUsage usage;
+			usage.Bytes = counters.Bytes.load(std::memory_order_relaxed);
+			usage.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+			usage.Allocations = counters.Allocations.load(std::memory_order_relaxed);
+			usage.BudgetBytes = counters.BudgetBytes.load(std::memory_order_relaxed);
+			return usage;
+		}
+
+		double ToMegabytes(uint64_t bytes)
+		{
+			return static_cast<double>(bytes) / (1024.0 * 1024.0);
+		}
+
+	}
+
+	void MemoryTracker::Allocate(MemoryDomain domain, MemoryCategory category, uint64_t bytes)
+	{
+		if (bytes == 0)
+			return;
+
+		UsageCounters& counters = GetCounters(domain, category);
+		const uint64_t current = Add(counters, bytes);
+		const uint64_t budget = counters.BudgetBytes.load(std::memory_order_relaxed);
+		if (budget > 0 && current > budget)
+		{
+			SN_CORE_WARN_LIMITED("Memory: {0} {1} at {2:.1f} MB, over its budget of {3:.1f} MB",
+				DomainToString(domain), CategoryToString(category), ToMegabytes(current), ToMegabytes(budget));
+		}
+
+		UsageCounters& totals = GetTotalCounters(domain);
+		const uint64_t total = Add(totals, bytes);
+		const uint64_t totalBudget = totals.BudgetBytes.load(std::memory_order_relaxed);
+		if (totalBudget > 0 && total > totalBudget)
+		{
+			SN_CORE_WARN_LIMITED("Memory: {0} total at {1:.1f} MB, over its budget of {2:.1f} MB",
+				DomainToString(domain), ToMegabytes(total), ToMegabytes(totalBudget));
+		}
+	}
+
+	void MemoryTracker::Free(MemoryDomain domain, MemoryCategory category, uint64_t bytes)
+	{
+		if (bytes == 0)
+			return;
+
+		Subtract(GetCounters(domain, category), bytes);
+		Subtract(GetTotalCounters(domain), bytes);
+	}
+
+	MemoryUsage MemoryTracker::GetUsage(MemoryDomain domain, MemoryCategory category)
+	{
+		return ToUsage(GetCounters(domain, category));
+	}
+
+	MemoryUsage MemoryTracker::GetTotal(MemoryDomain domain)
+	{
+		return ToUsage(GetTotalCounters(domain));
+	}
+
+	void MemoryTracker::ResetPeaks()
+	{
+		TrackerData& data = GetData();
+		for (size_t domain = 0; domain < kDomainCount; ++domain)
+		{
+			for (UsageCounters& counters : data.Categories[domain])
+				counters.PeakBytes.store(counters.Bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			data.Totals[domain].PeakBytes.store(data.Totals[domain].Bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+
+	void MemoryTracker::SetBudget(MemoryDomain domain, MemoryCategory category, uint64_t bytes)
+	{
+		GetCounters(domain, category).BudgetBytes.store(bytes, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::SetTotalBudget(MemoryDomain domain, uint64_t bytes)
+	{
+		GetTotalCounters(domain).BudgetBytes.store(bytes, std::memory_order_relaxed);
+	}
+
+	const char* MemoryTracker::DomainToString(MemoryDomain domain)
+	{
+		switch (domain)
+		{
+		case MemoryDomain::Cpu: return "CPU";
+		case MemoryDomain::Gpu: return "GPU";
+		default: return "Unknown";
+		}
+	}
+
+	const char* MemoryTracker::CategoryToString(MemoryCategory category)
+	{
+		switch (category)
+		{
+		case MemoryCategory::Meshes: return "Meshes";
+		case MemoryCategory::Textures: return "Textures";
+		case MemoryCategory::FrameBuffers: return "Framebuffers";
+		case MemoryCategory::UniformBuffers: return "Uniform buffers";
+		case MemoryCategory::StorageBuffers: return "Storage buffers";
+		case MemoryCategory::Staging: return "Staging";
+		case MemoryCategory::Shaders: return "Shaders";
+		case MemoryCategory::Components: return "Components";
+		default: return "Unknown";
+		}
+	}
+
+	TrackedMemory::TrackedMemory(MemoryDomain domain, MemoryCategory category, uint64_t bytes)
+		: m_Domain(domain), m_Category(category)
+	{
+		Set(bytes);
+	}
+
+	TrackedMemory::~TrackedMemory()
+	{
+		Set(0);
+	}
+
+	TrackedMemory::TrackedMemory(const TrackedMemory& other)
+		: TrackedMemory(other.m_Domain, other.m_Category, other.m_Bytes)
+	{
+	}
+
+	TrackedMemory::TrackedMemory(TrackedMemory&& other) noexcept
+		: m_Domain(other.m_Domain), m_Category(other.m_Category), m_Bytes(other.m_Bytes)
+	{
+		other.m_Bytes = 0;
+	}
+
+	TrackedMemory& TrackedMemory::operator=(const TrackedMemory& other)
+	{
+		if (this != &other)
+		{
+			Set(0);
+			m_Domain = other.m_Domain;
+			m_Category = other.m_Category;
+			Set(other.m_Bytes);
+		}
+		return *this;
+	}
+
+	TrackedMemory& TrackedMemory::operator=(TrackedMemory&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Set(0);
+			m_Domain = other.m_Domain;
+			m_Category = other.m_Category;
+			m_Bytes = other.m_Bytes;
+			other.m_Bytes = 0;
+		}
+		return *this;
+	}
+
+	void TrackedMemory::Set(uint64_t bytes)
+	{
+		if (bytes == m_Bytes)
+			return;
+
+		MemoryTracker::Free(m_Domain, m_Category, m_Bytes);
+		MemoryTracker::Allocate(m_Domain, m_Category, bytes);
+		m_Bytes = bytes;
+	}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Syndra {
+
+	enum class MemoryDomain : uint8_t
+	{
+		Cpu = 0,	// heap memory held by the engine
+		Gpu,		// device memory (VMA allocations on Vulkan, storage sizes on OpenGL)
+		Count
+	};
+
+	enum class MemoryCategory : uint8_t
+	{
+		Meshes = 0,		// geometry: CPU copies kept by Mesh, vertex and index buffers
+		Textures,
+		FrameBuffers,	// render targets and their attachments
+		UniformBuffers,
+		StorageBuffers,	// GPU scene, indirect arguments, culling output
+		Staging,		// upload and readback buffers, only alive during a transfer
+		Shaders,		// SPIR-V and other shader binaries kept after loading
+		Components,		// ECS component storage
+		Count
+	};
+
+	struct MemoryUsage
+	{
+		uint64_t Bytes = 0;
+		// Highest Bytes since startup or the last ResetPeaks().
+		uint64_t PeakBytes = 0;
+		uint32_t Allocations = 0;
+		// 0 when no budget is set.
+		uint64_t BudgetBytes = 0;
+
+		bool IsOverBudget() const { return BudgetBytes > 0 && Bytes > BudgetBytes; }
+	};
+
+	// Engine-wide memory accounting by domain and category. Owners report what they allocate and
+	// free, usually through a TrackedMemory member. Thread-safe. Going over a budget logs a
+	// warning; allocations are never refused.
+	class MemoryTracker
+	{
+	public:
+		static void Allocate(MemoryDomain domain, MemoryCategory category, uint64_t bytes);
+		static void Free(MemoryDomain domain, MemoryCategory category, uint64_t bytes);
+
+		static MemoryUsage GetUsage(MemoryDomain domain, MemoryCategory category);
+		// All categories of domain together; the peak is the peak of the sum.
+		static MemoryUsage GetTotal(MemoryDomain domain);
+		static void ResetPeaks();
+
+		// 0 removes the budget.
+		static void SetBudget(MemoryDomain domain, MemoryCategory category, uint64_t bytes);
+		static void SetTotalBudget(MemoryDomain domain, uint64_t bytes);
+
+		static const char* DomainToString(MemoryDomain domain);
+		static const char* CategoryToString(MemoryCategory category);
+	};
+
+	// A tracked amount of memory owned by an object: Set() reports the current size and the
+	// destructor gives it back. Copies report the same amount again, as copying the owner
+	// duplicates the memory.
+	class TrackedMemory
+	{
+	public:
+		TrackedMemory(MemoryDomain domain, MemoryCategory category, uint64_t bytes = 0);
+		~TrackedMemory();
+
+		TrackedMemory(const TrackedMemory& other);
+		TrackedMemory(TrackedMemory&& other) noexcept;
+		TrackedMemory& operator=(const TrackedMemory& other);
+		TrackedMemory& operator=(TrackedMemory&& other) noexcept;
+
+		void Set(uint64_t bytes);
+		void Reset() { Set(0); }
+		uint64_t GetBytes() const { return m_Bytes; }
+
+	private:
+		MemoryDomain m_Domain;
+		MemoryCategory m_Category;
+		uint64_t m_Bytes = 0;
+	};
+
+}
@@ -1,7 +1,9 @@
 #include "lpch.h"
 #include "Engine/Core/Window.h"
 
-#ifdef SN_PLATFORM_WINDOWS
+#include "Engine/Renderer/RendererAPI.h"
+#include "Platform/Headless/HeadlessWindow.h"
+#if defined(SN_PLATFORM_WINDOWS) || defined(SN_PLATFORM_LINUX)
 #include "Platform/Windows/WindowsWindow.h"
 #endif
 
@@ -9,7 +11,12 @@ namespace Syndra
 {
 	Scope<Window> Window::Create(const WindowProps& props)
 	{
-#ifdef SN_PLATFORM_WINDOWS
+		// The Null renderer has nothing to present to.
+		if (props.Headless || RendererAPI::GetAPI() == RendererAPI::API::Null)
+			return CreateScope<HeadlessWindow>(props);
+
+#if defined(SN_PLATFORM_WINDOWS) || defined(SN_PLATFORM_LINUX)
+		// The GLFW window is portable; only its file name is Windows specific.
 		return CreateScope<WindowsWindow>(props);
 #else
 		//SN_CORE_ASSERT(false, "Unknown platform!");
@@ -17,4 +24,4 @@ namespace Syndra
 #endif
 	}
 
-}
\ No newline at end of file
+}
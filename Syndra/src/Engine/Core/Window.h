@@ -12,11 +12,14 @@ namespace Syndra {
 		std::string Title;
 		uint32_t Width;
 		uint32_t Height;
+		// No native window: the graphics context renders offscreen only (benchmarks, CI).
+		bool Headless;
 
 		WindowProps(const std::string& title = "Syndra Engine",
 			uint32_t width = 1600,
-			uint32_t height = 900)
-			: Title(title), Width(width), Height(height)
+			uint32_t height = 900,
+			bool headless = false)
+			: Title(title), Width(width), Height(height), Headless(headless)
 		{
 		}
 	};
@@ -30,8 +33,16 @@ namespace Syndra {
 		virtual ~Window() = default;
 
 		virtual void OnUpdate() = 0;
+		// Like OnUpdate(), but sleeps until an event arrives or timeoutSeconds passed. Windows
+		// without an event queue (headless) return right away.
+		virtual void WaitEvents(double timeoutSeconds) { OnUpdate(); }
+		// Wakes a WaitEvents() call on the main thread. Thread-safe.
+		virtual void PostEmptyEvent() {}
 		virtual void BeginFrame() = 0;
 		virtual void EndFrame() = 0;
+		// Moves the graphics context between the main and the render thread (see RenderThread).
+		virtual void MakeContextCurrent() {}
+		virtual void ReleaseContext() {}
 
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
@@ -6,6 +6,8 @@
 
 #include "Engine/Core/Application.h"
 #include "Engine/Renderer/RendererAPI.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/FramePacket.h"
 #include "Engine/Utils/AssetPath.h"
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanImGuiTextureRegistry.h"
@@ -224,7 +226,20 @@ namespace Syndra {
 
 		ImGui::Render();
 
-		if (m_Backend == Backend::OpenGL)
+		if (m_Backend == Backend::OpenGL && RenderThread::IsThreaded())
+		{
+			RenderThread::GetCurrentPacket().ImGuiDrawData = CreateRef<ImGuiDrawSnapshot>(ImGui::GetDrawData());
+			if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+			{
+				// Platform windows have their own contexts and are drawn right away.
+				RenderThread::Synchronize();
+				GLFWwindow* backupCurrentContext = glfwGetCurrentContext();
+				ImGui::UpdatePlatformWindows();
+				ImGui::RenderPlatformWindowsDefault();
+				glfwMakeContextCurrent(backupCurrentContext);
+			}
+		}
+		else if (m_Backend == Backend::OpenGL)
 		{
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 			if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -245,6 +260,25 @@ namespace Syndra {
 		}
 	}
 
+	void ImGuiLayer::RenderDrawData(ImGuiDrawSnapshot& snapshot)
+	{
+		SN_CORE_ASSERT(m_Backend == Backend::OpenGL, "ImGui snapshots are only drawn by the OpenGL backend!");
+		ImGui_ImplOpenGL3_RenderDrawData(snapshot.Get());
+	}
+
+	ImGuiDrawSnapshot::ImGuiDrawSnapshot(const ImDrawData* source)
+		: m_DrawData(*source)
+	{
+		for (int i = 0; i < m_DrawData.CmdListsCount; ++i)
+			m_DrawData.CmdLists[i] = source->CmdLists[i]->CloneOutput();
+	}
+
+	ImGuiDrawSnapshot::~ImGuiDrawSnapshot()
+	{
+		for (int i = 0; i < m_DrawData.CmdListsCount; ++i)
+			IM_DELETE(m_DrawData.CmdLists[i]);
+	}
+
 	ImTextureID ImGuiLayer::GetTextureID(uint32_t rendererID)
 	{
 		if (s_Instance == nullptr)
@@ -268,7 +302,7 @@ namespace Syndra {
 		auto descriptorIterator = m_VulkanTextureCache.find(rendererID);
 		if (descriptorIterator != m_VulkanTextureCache.end())
 		{
-			return ToImGuiTextureID(descriptorIterator->second);
+			return ToImGuiTextureID(descriptorIterator->second.DescriptorSet);
 		}
 
 		VulkanImGuiTextureInfo textureInfo{};
@@ -282,7 +316,7 @@ namespace Syndra {
 		}
 
 		const VkDescriptorSet descriptorSet = ImGui_ImplVulkan_AddTexture(textureInfo.Sampler, textureInfo.ImageView, textureInfo.ImageLayout);
-		m_VulkanTextureCache[rendererID] = descriptorSet;
+		m_VulkanTextureCache[rendererID] = VulkanTextureDescriptor{ descriptorSet, textureInfo.ImageView };
 		m_MissingVulkanTextureWarnings.erase(rendererID);
 		return ToImGuiTextureID(descriptorSet);
 	}
@@ -303,9 +337,12 @@ namespace Syndra {
 	{
 		for (auto iterator = m_VulkanTextureCache.begin(); iterator != m_VulkanTextureCache.end();)
 		{
-			if (!VulkanImGuiTextureRegistry::ContainsTexture(iterator->first))
+			// Streamed textures keep their renderer ID but swap the image view when their resident mips change.
+			VulkanImGuiTextureInfo textureInfo{};
+			if (!VulkanImGuiTextureRegistry::TryGetTextureInfo(iterator->first, textureInfo) ||
+				textureInfo.ImageView != iterator->second.ImageView)
 			{
-				ImGui_ImplVulkan_RemoveTexture(iterator->second);
+				ImGui_ImplVulkan_RemoveTexture(iterator->second.DescriptorSet);
 				m_MissingVulkanTextureWarnings.erase(iterator->first);
 				iterator = m_VulkanTextureCache.erase(iterator);
 				continue;
@@ -317,9 +354,9 @@ namespace Syndra {
 
 	void ImGuiLayer::RemoveAllVulkanTextureDescriptors()
 	{
-		for (const auto& [rendererID, descriptorSet] : m_VulkanTextureCache)
+		for (const auto& [rendererID, descriptor] : m_VulkanTextureCache)
 		{
-			ImGui_ImplVulkan_RemoveTexture(descriptorSet);
+			ImGui_ImplVulkan_RemoveTexture(descriptor.DescriptorSet);
 			m_MissingVulkanTextureWarnings.erase(rendererID);
 		}
 
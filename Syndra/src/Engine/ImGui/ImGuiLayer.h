@@ -14,6 +14,23 @@
 
 namespace Syndra {
 
+	// Deep copy of a frame's ImDrawData, so a packet can be drawn on the render thread while the
+	// main thread already builds the next UI frame.
+	class ImGuiDrawSnapshot
+	{
+	public:
+		explicit ImGuiDrawSnapshot(const ImDrawData* source);
+		~ImGuiDrawSnapshot();
+
+		ImGuiDrawSnapshot(const ImGuiDrawSnapshot&) = delete;
+		ImGuiDrawSnapshot& operator=(const ImGuiDrawSnapshot&) = delete;
+
+		ImDrawData* Get() { return &m_DrawData; }
+
+	private:
+		ImDrawData m_DrawData;
+	};
+
 	class ImGuiLayer : public Layer
 	{
 	public:
@@ -26,6 +43,8 @@ namespace Syndra {
 
 		void Begin();
 		void End();
+		// Draws a snapshot taken by End() in threaded mode; called on the render thread.
+		void RenderDrawData(ImGuiDrawSnapshot& snapshot);
 		static ImTextureID GetTextureID(uint32_t rendererID);
 
 		void SetDarkThemeColors();
@@ -51,7 +70,12 @@ namespace Syndra {
 		Backend m_Backend = Backend::None;
 		bool m_BlockEvents = true;
 		uint32_t m_LastVulkanMinImageCount = 0;
-		std::unordered_map<uint32_t, VkDescriptorSet> m_VulkanTextureCache;
+		struct VulkanTextureDescriptor
+		{
+			VkDescriptorSet DescriptorSet = VK_NULL_HANDLE;
+			VkImageView ImageView = VK_NULL_HANDLE;
+		};
+		std::unordered_map<uint32_t, VulkanTextureDescriptor> m_VulkanTextureCache;
 		std::unordered_set<uint32_t> m_MissingVulkanTextureWarnings;
 	};
 
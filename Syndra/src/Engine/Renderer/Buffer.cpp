@@ -1,6 +1,8 @@
 #include "lpch.h"
 #include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Platform/Null/NullBuffer.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
 #include "Platform/Vulkan/VulkanBuffer.h"
 
@@ -9,6 +11,7 @@ namespace Syndra {
 
 	Ref<VertexBuffer> VertexBuffer::Create(float* vertices, uint32_t size)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:
@@ -18,6 +21,8 @@ namespace Syndra {
 			return CreateRef<VulkanVertexBuffer>(vertices, size);
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLVertexBuffer>(vertices, size);
+		case RendererAPI::API::Null:
+			return CreateRef<NullVertexBuffer>(vertices, size);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown API!");
@@ -26,6 +31,7 @@ namespace Syndra {
 
 	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* vertices, uint32_t count)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:
@@ -35,6 +41,8 @@ namespace Syndra {
 			return CreateRef<VulkanIndexBuffer>(vertices, count);
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLIndexBuffer>(vertices, count);
+		case RendererAPI::API::Null:
+			return CreateRef<NullIndexBuffer>(vertices, count);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown API!");
@@ -3,6 +3,9 @@
 #include "imgui.h"
 #include "imgui_internal.h"
 #include "Engine/ImGui/ImGuiLayer.h"
+#include "Engine/Renderer/OcclusionCuller.h"
+#include "Engine/Renderer/TextureLibrary.h"
+#include "Engine/Renderer/TextureStreamer.h"
 #include "Engine/Utils/PlatformUtils.h"
 #include "Engine/Core/Application.h"
 
@@ -123,32 +126,36 @@ namespace Syndra {
 
 		//Light uniform Buffer layout: -- point lights -- spotlights -- directional light--Binding point 2
 		r_Data.lightManager = CreateRef<LightManager>(2);
+		r_Data.occlusionCuller = CreateRef<OcclusionCuller>();
 
 		float dSize = r_Data.orthoSize;
 		r_Data.lightProj = glm::ortho(-dSize, dSize, -dSize, dSize, r_Data.lightNear, r_Data.lightFar);
 		//r_Data.lightProj = glm::perspective(45.0f, 1.0f, r_Data.lightNear, r_Data.lightFar);
 		r_Data.ShadowBuffer = UniformBuffer::Create(sizeof(glm::mat4) * 25, 3);
+		r_Data.EnvironmentSHBuffer = UniformBuffer::Create(sizeof(SphericalHarmonicsUniform), 4);
 		r_Data.lightManager->IntitializeLights();
 	}
 
-	void DeferredRenderer::Render()
+	void DeferredRenderer::Render(const SceneRenderView& view)
 	{
-		auto view = r_Data.scene->m_Registry.view<TransformComponent, MeshComponent>();
+		// Occlusion is only known for the camera, so the shadow pass keeps every item.
+		RenderItemList cameraItems;
+		cameraItems.reserve(view.Items.size());
+		for (const auto& item : view.Items)
+			cameraItems.push_back(&item);
+		if (r_Data.useOcclusionCulling && r_Data.occlusionCuller)
+			r_Data.occlusionCuller->Cull(view.Camera.GetViewProjection(), cameraItems, cameraItems);
+
 		//---------------------------------------------------------SHADOW PASS------------------------------------------//
 		r_Data.shadowPass->BindTargetFrameBuffer();
 		RenderCommand::SetState(RenderState::DEPTH_TEST, true);
 		RenderCommand::SetClearColor(r_Data.shadowPass->GetSpecification().TargetFrameBuffer->GetSpecification().ClearColor);
 		r_Data.depth->Bind();
 		RenderCommand::Clear();
-		for (auto ent : view)
+		for (const auto& item : view.Items)
 		{
-			auto& mc = view.get<MeshComponent>(ent);
-			if (!mc.path.empty())
-			{
-				const glm::mat4 worldTransform = r_Data.scene->GetWorldTransform(Entity{ ent });
-				r_Data.depth->SetMat4("transform.u_trans", worldTransform);
-				Renderer::Submit(r_Data.depth, mc.model);
-			}
+			r_Data.depth->SetMat4("transform.u_trans", item.WorldTransform);
+			Renderer::Submit(r_Data.depth, item.Mesh->model);
 		}
 		r_Data.shadowPass->UnbindTargetFrameBuffer();
 
@@ -159,33 +166,28 @@ namespace Syndra {
 		r_Data.geoPass->GetSpecification().TargetFrameBuffer->ClearAttachment(4, -1);
 		r_Data.geoShader->Bind();
 		RenderCommand::Clear();
-		for (auto ent : view)
+		for (const RenderItem* item : cameraItems)
 		{
-			auto& mc = view.get<MeshComponent>(ent);
-			if (!mc.path.empty())
+			TextureStreamer::RequestModelTextures(item->Mesh->model, item->Material.get(), item->WorldTransform);
+			if (item->Material) {
+				r_Data.geoShader->SetInt("transform.id", (uint32_t)item->EntityHandle);
+				r_Data.geoShader->SetMat4("transform.u_trans", item->WorldTransform);
+				Renderer::Submit(*item->Material, item->Mesh->model);
+			}
+			else
 			{
-				const glm::mat4 worldTransform = r_Data.scene->GetWorldTransform(Entity{ ent });
-				if (r_Data.scene->m_Registry.has<MaterialComponent>(ent)) {
-					auto& mat = r_Data.scene->m_Registry.get<MaterialComponent>(ent);
-					r_Data.geoShader->SetInt("transform.id", (uint32_t)ent);
-					r_Data.geoShader->SetMat4("transform.u_trans", worldTransform);
-					Renderer::Submit(mat.m_Material, mc.model);
-				}
-				else
-				{
-					r_Data.geoShader->SetInt("push.HasAlbedoMap", 1);
-					r_Data.geoShader->SetFloat("push.tiling", 1.0f);
-					r_Data.geoShader->SetInt("push.HasNormalMap", 0);
-					r_Data.geoShader->SetInt("push.HasMetallicMap", 0);
-					r_Data.geoShader->SetInt("push.HasRoughnessMap", 0);
-					r_Data.geoShader->SetInt("push.HasAOMap", 0);
-					r_Data.geoShader->SetFloat("push.material.MetallicFactor", 0);
-					r_Data.geoShader->SetFloat("push.material.RoughnessFactor", 1);
-					r_Data.geoShader->SetFloat("push.material.AO", 1);
-					r_Data.geoShader->SetMat4("transform.u_trans", worldTransform);
-					r_Data.geoShader->SetInt("transform.id", (uint32_t)ent);
-					Renderer::Submit(r_Data.geoShader, mc.model);
-				}
+				r_Data.geoShader->SetInt("push.HasAlbedoMap", 1);
+				r_Data.geoShader->SetFloat("push.tiling", 1.0f);
+				r_Data.geoShader->SetInt("push.HasNormalMap", 0);
+				r_Data.geoShader->SetInt("push.HasMetallicMap", 0);
+				r_Data.geoShader->SetInt("push.HasRoughnessMap", 0);
+				r_Data.geoShader->SetInt("push.HasAOMap", 0);
+				r_Data.geoShader->SetFloat("push.material.MetallicFactor", 0);
+				r_Data.geoShader->SetFloat("push.material.RoughnessFactor", 1);
+				r_Data.geoShader->SetFloat("push.material.AO", 1);
+				r_Data.geoShader->SetMat4("transform.u_trans", item->WorldTransform);
+				r_Data.geoShader->SetInt("transform.id", (uint32_t)item->EntityHandle);
+				Renderer::Submit(r_Data.geoShader, item->Mesh->model);
 			}
 		}
 		r_Data.geoShader->Unbind();
@@ -223,7 +225,7 @@ namespace Syndra {
 		Texture2D::BindTexture(r_Data.geoPass->GetFrameBufferTextureID(3), 6);
 		if (r_Data.environment) {
 			r_Data.environment->SetIntensity(r_Data.intensity);
-			r_Data.environment->BindIrradianceMap(7);
+			r_Data.EnvironmentSHBuffer->SetData(r_Data.environment->GetIrradianceSH().data(), sizeof(SphericalHarmonicsUniform));
 			r_Data.environment->BindPreFilterMap(8);
 			r_Data.environment->BindBRDFMap(9);
 		}
@@ -232,16 +234,19 @@ namespace Syndra {
 		r_Data.deferredLighting->Unbind();
 
 		r_Data.lightingPass->BindTargetFrameBuffer();
-		glBindFramebuffer(GL_READ_FRAMEBUFFER, r_Data.geoPass->GetSpecification().TargetFrameBuffer->GetRendererID());
-		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, r_Data.lightingPass->GetSpecification().TargetFrameBuffer->GetRendererID()); // write to default framebuffer
-		auto w = r_Data.lightingPass->GetSpecification().TargetFrameBuffer->GetSpecification().Width;
-		auto h = r_Data.lightingPass->GetSpecification().TargetFrameBuffer->GetSpecification().Height;
-		glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-		if (r_Data.environment) {
-			glEnable(GL_DEPTH_TEST);
-			glDepthFunc(GL_LEQUAL);
-			r_Data.environment->RenderBackground();
-			glDepthFunc(GL_LESS);
+		// The depth copy and the skybox go straight to GL; the Null backend has neither.
+		if (Renderer::GetAPI() == RendererAPI::API::OpenGL) {
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, r_Data.geoPass->GetSpecification().TargetFrameBuffer->GetRendererID());
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, r_Data.lightingPass->GetSpecification().TargetFrameBuffer->GetRendererID()); // write to default framebuffer
+			auto w = r_Data.lightingPass->GetSpecification().TargetFrameBuffer->GetSpecification().Width;
+			auto h = r_Data.lightingPass->GetSpecification().TargetFrameBuffer->GetSpecification().Height;
+			glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+			if (r_Data.environment) {
+				glEnable(GL_DEPTH_TEST);
+				glDepthFunc(GL_LEQUAL);
+				r_Data.environment->RenderBackground();
+				glDepthFunc(GL_LESS);
+			}
 		}
 
 		r_Data.lightingPass->UnbindTargetFrameBuffer();
@@ -330,14 +335,23 @@ namespace Syndra {
 			ImGui::Separator();
 			//V-Sync
 			static bool vSync = true;
-			ImGui::Checkbox("V-Sync", &vSync);
-			Application::Get().GetWindow().SetVSync(vSync);
+			if (ImGui::Checkbox("V-Sync", &vSync))
+				Application::Get().GetWindow().SetVSync(vSync);
 			ImGui::Separator();
 
 			ImGui::Text("Anti Aliasing");
 			ImGui::Checkbox("FXAA", &r_Data.useFxaa);
 			ImGui::Separator();
 
+			ImGui::Checkbox("Occlusion Culling", &r_Data.useOcclusionCulling);
+			if (r_Data.useOcclusionCulling)
+			{
+				const OcclusionCuller::Stats& occlusionStats = r_Data.occlusionCuller->GetStats();
+				ImGui::Text("Occluded: %u of %u by %u occluders", occlusionStats.Occluded, occlusionStats.Tested, occlusionStats.Occluders);
+				ImGui::Text("Raster %.2f ms, test %.2f ms", occlusionStats.RasterMs, occlusionStats.TestMs);
+			}
+			ImGui::Separator();
+
 			//Exposure
 			ImGui::DragFloat("exposure", &r_Data.exposure, 0.01f, -2, 4);
 
@@ -381,7 +395,7 @@ namespace Syndra {
 				auto path = FileDialogs::OpenFile("HDR (*.hdr)\0*.hdr\0");
 				if (path) {
 					//Add texture as sRGB color space if it is binded to 0 (diffuse texture binding)
-					r_Data.environment = CreateRef<Environment>(Texture2D::CreateHDR(*path, false, true));
+					r_Data.environment = CreateRef<Environment>(TextureLibrary::LoadHDR(*path));
 					r_Data.scene->m_EnvironmentPath = *path;
 					SceneRenderer::SetEnvironment(r_Data.environment);
 				}
@@ -405,22 +419,20 @@ namespace Syndra {
 		r_Data.aaPass->GetSpecification().TargetFrameBuffer->Resize(width, height);
 	}
 
-	void DeferredRenderer::UpdateLights()
+	void DeferredRenderer::UpdateLights(const SceneRenderView& view)
 	{
 		r_Data.lightManager->IntitializeLights();
-		auto viewLights = r_Data.scene->m_Registry.view<TransformComponent, LightComponent>();
 		//point light index
 		int pIndex = 0;
 		//spot light index
 		int sIndex = 0;
 		//Set light values for each entity that has a light component
-		for (auto ent : viewLights)
+		for (const auto& lc : view.Lights)
 		{
-			auto& lc = viewLights.get<LightComponent>(ent);
-			const glm::vec3 worldTranslation = r_Data.scene->GetWorldTranslation(Entity{ ent });
+			const glm::vec3& worldTranslation = lc.Position;
 
-			if (lc.type == LightType::Directional) {
-				auto p = dynamic_cast<DirectionalLight*>(lc.light.get());
+			if (lc.Type == LightType::Directional) {
+				auto p = dynamic_cast<DirectionalLight*>(lc.Light.get());
 				r_Data.lightManager->UpdateDirLight(p, worldTranslation);
 				//shadow
 				r_Data.lightView = glm::lookAt(-(glm::normalize(p->GetDirection()) * r_Data.lightFar / 4.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
@@ -428,17 +440,17 @@ namespace Syndra {
 				r_Data.ShadowBuffer->SetData(&r_Data.shadowData, sizeof(glm::mat4));
 				p = nullptr;
 			}
-			if (lc.type == LightType::Point) {
+			if (lc.Type == LightType::Point) {
 				if (pIndex < 4) {
-					auto p = dynamic_cast<PointLight*>(lc.light.get());
+					auto p = dynamic_cast<PointLight*>(lc.Light.get());
 					r_Data.lightManager->UpdatePointLights(p, worldTranslation, pIndex);
 					pIndex++;
 					p = nullptr;
 				}
 			}
-			if (lc.type == LightType::Spot) {
+			if (lc.Type == LightType::Spot) {
 				if (sIndex < 4) {
-					auto p = dynamic_cast<SpotLight*>(lc.light.get());
+					auto p = dynamic_cast<SpotLight*>(lc.Light.get());
 					r_Data.lightManager->UpdateSpotLights(p, worldTranslation, sIndex);
 					sIndex++;
 					p = nullptr;
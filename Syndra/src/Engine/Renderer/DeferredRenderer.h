@@ -4,18 +4,20 @@
 
 namespace Syndra {
 
+	class OcclusionCuller;
+
 	class DeferredRenderer : public RenderPipeline {
 		
 	public:
 		virtual void Init(const Ref<Scene>& scene, const ShaderLibrary& shaders, const Ref<Environment>& env) override;
 
-		virtual void Render() override;
+		virtual void Render(const SceneRenderView& view) override;
 
 		virtual void End() override;
 
 		virtual void ShutDown() override;
 
-		virtual void UpdateLights() override;
+		virtual void UpdateLights(const SceneRenderView& view) override;
 
 		virtual uint32_t GetFinalTextureID(int index) override;
 
@@ -43,6 +45,9 @@ namespace Syndra {
 			Ref<Environment> environment;
 			//Anti ALiasing
 			bool useFxaa = false;
+			//Occlusion culling of the geometry pass
+			bool useOcclusionCulling = false;
+			Ref<OcclusionCuller> occlusionCuller;
 
 			//Light and shadow
 			bool softShadow = false;
@@ -51,6 +56,7 @@ namespace Syndra {
 			float exposure, gamma, lightSize, orthoSize, lightNear, lightFar;
 			Ref<LightManager> lightManager;
 			Ref<UniformBuffer> ShadowBuffer;
+			Ref<UniformBuffer> EnvironmentSHBuffer;
 			glm::mat4 lightProj;
 			glm::mat4 lightView;
 			ShadowData shadowData;
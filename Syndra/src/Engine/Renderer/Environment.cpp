@@ -2,20 +2,21 @@
 #include "Engine/Renderer/Environment.h"
 #include "glad/glad.h"
 
+#include <chrono>
+
 namespace Syndra {
 
 	Environment::Environment(const Ref<Texture2D>& hdri)
 		:m_HDRSkyMap(hdri)
 	{
+		const auto loadStart = std::chrono::steady_clock::now();
+
 		m_EquirectangularToCube = Shader::Create("assets/shaders/EquirectangularToCube.glsl");
 		m_BackgroundShader = Shader::Create("assets/shaders/BackgroundSky.glsl");
-		m_PrefilterShader = Shader::Create("assets/shaders/Prefilter.glsl");
-		m_BRDFLutShader = Shader::Create("assets/shaders/BRDFLut.glsl");
 
 		m_BackgroundShader->Bind();
 		m_BackgroundShader->SetFloat("push.intensity", 0.5f);
 		m_BackgroundShader->Unbind();
-		m_IrradianceConvShader = Shader::Create("assets/shaders/IrradianceConvolution.glsl");
 		SetupCube();
 		//SetupFrameBuffer();
 		glm::mat4 captureProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
@@ -29,27 +30,6 @@ namespace Syndra {
 			glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))
 		};
 
-		m_QuadVAO = VertexArray::Create();
-		float quad[] = {
-			 1.0f,  1.0f, 0.0f,    1.0f, 1.0f,   // top right
-			 1.0f, -1.0f, 0.0f,    1.0f, 0.0f,   // bottom right
-			-1.0f, -1.0f, 0.0f,    0.0f, 0.0f,   // bottom left
-			-1.0f,  1.0f, 0.0f,    0.0f, 1.0f    // top left 
-		};
-		Ref<VertexBuffer> quadVBO = VertexBuffer::Create(quad, sizeof(quad));
-		BufferLayout quadLayout = {
-			{ShaderDataType::Float3,"a_pos"},
-			{ShaderDataType::Float2,"a_uv"},
-		};
-		quadVBO->SetLayout(quadLayout);
-		m_QuadVAO->AddVertexBuffer(quadVBO);
-		unsigned int quadIndices[] = {
-			0, 3, 1, // first triangle
-			1, 3, 2  // second triangle
-		};
-		Ref<IndexBuffer> quadEBO = IndexBuffer::Create(quadIndices, sizeof(quadIndices) / sizeof(uint32_t));
-		m_QuadVAO->SetIndexBuffer(quadEBO);
-		
 		//m_CaptureFBO->Bind();
 
 		unsigned int captureFBO;
@@ -97,39 +77,64 @@ namespace Syndra {
 		glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
-		// ------------------------------- Irradiance cube map Convolution-----------------------------------------//
-
-		glGenTextures(1, &irradianceMap);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
-		for (unsigned int i = 0; i < 6; ++i)
+		// The irradiance SH and prefiltered cube only depend on the HDR, so reuse them from the cache
+		// when this HDR was opened before; otherwise compute them and store the result.
+		const EnvironmentCacheSettings settings;
+		const std::string cachePath = EnvironmentCache::GetCachePath(m_HDRSkyMap->GetPath(), settings);
+		EnvironmentMaps maps;
+		const bool warm = EnvironmentCache::ReadMaps(cachePath, settings, maps);
+		if (warm)
 		{
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 32, 32, 0, GL_RGB, GL_FLOAT, nullptr);
+			UploadMaps(maps);
+		}
+		else
+		{
+			ProjectIrradiance(maps);
+			PrefilterEnvironment(captureFBO, captureRBO, captureProjection, captureViews, settings);
+			if (EnvironmentCache::IsEnabled() && !cachePath.empty())
+			{
+				ReadBackMaps(settings, maps);
+				if (!EnvironmentCache::WriteMaps(cachePath, maps))
+					SN_CORE_WARN("Failed to write environment cache '{}'.", cachePath);
+			}
 		}
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-		glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 32, 32);
+		m_IrradianceSH = SphericalHarmonics::ToUniform(maps.Irradiance);
 
-		m_IrradianceConvShader->Bind();
-		m_IrradianceConvShader->SetMat4("cam.projection", captureProjection);
-		Texture2D::BindTexture(envCubemap, 0);
+		glDeleteRenderbuffers(1, &captureRBO);
+		glDeleteFramebuffers(1, &captureFBO);
 
-		glViewport(0, 0, 32, 32); // don't forget to configure the viewport to the capture dimensions.
-		glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-		for (unsigned int i = 0; i < 6; ++i)
-		{
-			m_IrradianceConvShader->SetMat4("cam.view", captureViews[i]);
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, irradianceMap, 0);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		CreateBRDFLut();
 
-			RenderCube();
-		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		const double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+		EnvironmentCache::RecordLoad(warm, loadMs);
+		SN_CORE_INFO("Environment '{}' ready in {:.1f} ms ({}).", m_HDRSkyMap->GetPath(), loadMs, warm ? "cached IBL" : "computed IBL");
+	}
+
+	void Environment::ProjectIrradiance(EnvironmentMaps& maps)
+	{
+		// Project the HDR as the GPU sees it, so the SH matches the cube the background samples.
+		const uint32_t width = m_HDRSkyMap->GetWidth();
+		const uint32_t height = m_HDRSkyMap->GetHeight();
+		std::vector<float> pixels(static_cast<size_t>(width) * height * 3);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glBindTexture(GL_TEXTURE_2D, m_HDRSkyMap->GetRendererID());
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_FLOAT, pixels.data());
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+		const auto projectionStart = std::chrono::steady_clock::now();
+		maps.Irradiance = SphericalHarmonics::ConvolveLambert(
+			SphericalHarmonics::ProjectEquirectangular(pixels.data(), width, height, kMaxIrradianceRadiance));
+		const double projectionMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - projectionStart).count();
+
+		// The fit is checked against the reference integral by Syndra-Test-SphericalHarmonics, not here.
+		EnvironmentCache::RecordProjection(projectionMs);
+		SN_CORE_INFO("Projected {}x{} HDR to L2 SH in {:.2f} ms.", width, height, projectionMs);
+	}
+
+	void Environment::PrefilterEnvironment(uint32_t captureFBO, uint32_t captureRBO, const glm::mat4& captureProjection, const glm::mat4* captureViews, const EnvironmentCacheSettings& settings)
+	{
+		m_PrefilterShader = Shader::Create("assets/shaders/Prefilter.glsl");
 
 	// pbr: create a pre-filter cube map, and re-scale capture FBO to pre-filter scale.
 	// --------------------------------------------------------------------------------
@@ -137,13 +142,9 @@ namespace Syndra {
 		glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
 		for (unsigned int i = 0; i < 6; ++i)
 		{
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 512, 512, 0, GL_RGB, GL_FLOAT, nullptr);
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, settings.PrefilterSize, settings.PrefilterSize, 0, GL_RGB, GL_FLOAT, nullptr);
 		}
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR); // be sure to set minification filter to mip_linear 
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		SetCubeMapParameters(GL_LINEAR_MIPMAP_LINEAR, settings.PrefilterLevels - 1); // be sure to set minification filter to mip_linear 
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
 		// ----------------------------------------------------------------------------------------------------
@@ -152,12 +153,12 @@ namespace Syndra {
 		Texture2D::BindTexture(envCubemap, 0);
 
 		glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-		unsigned int maxMipLevels = 5;
+		const unsigned int maxMipLevels = settings.PrefilterLevels;
 		for (unsigned int mip = 0; mip < maxMipLevels; ++mip)
 		{
 			// resize framebuffer according to mip-level size.
-			unsigned int mipWidth = 512 * std::pow(0.5, mip);
-			unsigned int mipHeight = 512 * std::pow(0.5, mip);
+			unsigned int mipWidth = std::max(1u, settings.PrefilterSize >> mip);
+			unsigned int mipHeight = std::max(1u, settings.PrefilterSize >> mip);
 			glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
 			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
 			glViewport(0, 0, mipWidth, mipHeight);
@@ -174,29 +175,71 @@ namespace Syndra {
 			}
 		}
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		
-		glGenTextures(1, &brdfLUTTexture);
+	}
 
-		// pre-allocate enough memory for the LUT texture.
+	void Environment::UploadMaps(const EnvironmentMaps& maps)
+	{
+		auto uploadLevel = [](const EnvironmentCubeLevel& level, int mip)
+		{
+			const size_t faceElements = static_cast<size_t>(level.Size) * level.Size * 3;
+			for (unsigned int i = 0; i < 6; ++i)
+			{
+				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, GL_RGB16F, level.Size, level.Size, 0, GL_RGB, GL_HALF_FLOAT,
+					level.Data.data() + faceElements * i);
+			}
+		};
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glGenTextures(1, &prefilterMap);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+		for (size_t mip = 0; mip < maps.Prefilter.size(); ++mip)
+			uploadLevel(maps.Prefilter[mip], static_cast<int>(mip));
+		SetCubeMapParameters(GL_LINEAR_MIPMAP_LINEAR, static_cast<int>(maps.Prefilter.size()) - 1);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	void Environment::ReadBackMaps(const EnvironmentCacheSettings& settings, EnvironmentMaps& outMaps)
+	{
+		auto readLevel = [](EnvironmentCubeLevel& level, uint32_t size, int mip)
+		{
+			const size_t faceElements = static_cast<size_t>(size) * size * 3;
+			level.Size = size;
+			level.Data.resize(faceElements * 6);
+			for (unsigned int i = 0; i < 6; ++i)
+				glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, GL_RGB, GL_HALF_FLOAT, level.Data.data() + faceElements * i);
+		};
+
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+		outMaps.Prefilter.resize(settings.PrefilterLevels);
+		for (uint32_t mip = 0; mip < settings.PrefilterLevels; ++mip)
+			readLevel(outMaps.Prefilter[mip], std::max(1u, settings.PrefilterSize >> mip), static_cast<int>(mip));
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	}
+
+	void Environment::CreateBRDFLut()
+	{
+		// The LUT does not depend on the environment, so it comes from the CPU-side cache.
+		const std::vector<float>& lut = EnvironmentCache::GetBRDFLut(kBRDFLutSize);
+
+		glGenTextures(1, &brdfLUTTexture);
 		glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, 512, 512, 0, GL_RG, GL_FLOAT, 0);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, kBRDFLutSize, kBRDFLutSize, 0, GL_RG, GL_FLOAT, lut.data());
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
 
-		glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-		glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, brdfLUTTexture, 0);
-
-		glViewport(0, 0, 512, 512);
-		m_BRDFLutShader->Bind();
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		RenderQuad();
-
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
+	void Environment::SetCubeMapParameters(int minFilter, int maxLevel)
+	{
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, minFilter);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, maxLevel);
 	}
 
 	void Environment::RenderCube()
@@ -205,12 +248,6 @@ namespace Syndra {
 		glDrawArrays(GL_TRIANGLES, 0, 36);
 	}
 
-	void Environment::RenderQuad()
-	{
-		m_QuadVAO->Bind();
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	}
-
 	void Environment::RenderBackground()
 	{
 		m_BackgroundShader->Bind();
@@ -234,11 +271,6 @@ namespace Syndra {
 		return m_HDRSkyMap->GetRendererID();
 	}
 
-	void Environment::BindIrradianceMap(uint32_t slot)
-	{
-		Texture2D::BindTexture(irradianceMap, slot);
-	}
-
 	void Environment::BindPreFilterMap(uint32_t slot)
 	{
 		Texture2D::BindTexture(prefilterMap, slot);
@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/EnvironmentCache.h"
 #include "Engine/Renderer/Texture.h"
 #include "Engine/Renderer/FrameBuffer.h"
 
@@ -19,9 +20,10 @@ namespace Syndra {
 		void SetIntensity(float intensity);
 
 		uint32_t GetBackgroundTextureID() const;
+		// L2 SH diffuse irradiance, laid out for the EnvironmentSH uniform block.
+		const SphericalHarmonicsUniform& GetIrradianceSH() const { return m_IrradianceSH; }
 		std::string GetPath() { return m_HDRSkyMap->GetPath(); }
 
-		void BindIrradianceMap(uint32_t slot);
 		void BindPreFilterMap(uint32_t slot);
 		void BindBRDFMap(uint32_t slot);
 
@@ -29,19 +31,29 @@ namespace Syndra {
 		void SetupCube();
 		void SetupFrameBuffer();
 
+		void ProjectIrradiance(EnvironmentMaps& maps);
+		void PrefilterEnvironment(uint32_t captureFBO, uint32_t captureRBO, const glm::mat4& captureProjection, const glm::mat4* captureViews, const EnvironmentCacheSettings& settings);
+		void UploadMaps(const EnvironmentMaps& maps);
+		void ReadBackMaps(const EnvironmentCacheSettings& settings, EnvironmentMaps& outMaps);
+		void CreateBRDFLut();
+		void SetCubeMapParameters(int minFilter, int maxLevel);
+
 		void RenderCube();
-		void RenderQuad();
 
 	private:
+		static constexpr uint32_t kBRDFLutSize = 512;
+		// Radiance clamp applied before projecting, as the old convolution shader did.
+		static constexpr float kMaxIrradianceRadiance = 1.0f;
+
 		unsigned int envCubemap;
 		unsigned int brdfLUTTexture;
 		unsigned int prefilterMap;
-		unsigned int irradianceMap;
 		Ref<Texture2D> m_HDRSkyMap;
-		Ref<Shader> m_EquirectangularToCube, m_BackgroundShader, m_IrradianceConvShader, m_PrefilterShader, m_BRDFLutShader;
-		Ref<VertexArray> m_CubeVAO, m_QuadVAO;
+		Ref<Shader> m_EquirectangularToCube, m_BackgroundShader, m_PrefilterShader;
+		Ref<VertexArray> m_CubeVAO;
 		Ref<FrameBuffer> m_IrradianceFBO, m_PrefilterFBO;
 		glm::mat4 m_View, m_Projection;
+		SphericalHarmonicsUniform m_IrradianceSH{};
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,378 @@
+#include "lpch.h"
+#include "Engine/Renderer/EnvironmentCache.h"
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Utils/AssetPath.h"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+namespace {
+
+	// Bump whenever the cached output for identical inputs changes.
+	constexpr uint32_t kEnvironmentCacheVersion = 2;
+	constexpr uint32_t kMapsMagic = 0x4C424953; // "SIBL"
+	constexpr uint32_t kLutMagic = 0x54554C53; // "SLUT"
+	constexpr uint32_t kBRDFSampleCount = 1024;
+	constexpr float kPi = 3.14159265359f;
+
+	struct MapsHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t PrefilterSize;
+		uint32_t PrefilterLevels;
+	};
+
+	struct LutHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Size;
+		uint32_t SampleCount;
+	};
+
+	std::mutex s_SettingsMutex;
+	std::string s_CacheDirectory;
+	std::atomic<bool> s_Enabled{ true };
+
+	std::mutex s_LutMutex;
+	std::unordered_map<uint32_t, std::vector<float>> s_BRDFLuts;
+
+	std::mutex s_StatsMutex;
+	Syndra::EnvironmentCacheStats s_Stats;
+
+	uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& outBytes)
+	{
+		std::ifstream stream(path, std::ios::binary | std::ios::ate);
+		if (!stream)
+			return false;
+
+		const std::streamsize size = stream.tellg();
+		if (size <= 0)
+			return false;
+
+		outBytes.resize(static_cast<size_t>(size));
+		stream.seekg(0, std::ios::beg);
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(outBytes.data()), size));
+	}
+
+	// Writes through a temporary file so a crash never leaves a truncated cache entry.
+	template<typename WriteFn>
+	bool WriteCacheFile(const std::string& path, WriteFn&& write)
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), errorCode);
+
+		const std::string tempPath = path + ".tmp";
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+				return false;
+
+			write(stream);
+			if (!stream)
+				return false;
+		}
+
+		std::filesystem::rename(tempPath, path, errorCode);
+		if (errorCode)
+		{
+			std::filesystem::remove(tempPath, errorCode);
+			return false;
+		}
+		return true;
+	}
+
+	size_t GetCubeLevelElementCount(uint32_t size)
+	{
+		return static_cast<size_t>(size) * size * 3 * 6;
+	}
+
+	template<typename Fn>
+	void ParallelForRows(uint32_t rowCount, Fn&& fn)
+	{
+		Syndra::JobSystem::ParallelFor("EnvironmentCache::Rows", rowCount, 0, [&fn](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t row = begin; row < end; ++row)
+				fn(row);
+		});
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// BRDF LUT, a CPU port of BRDFLut.glsl
+	//////////////////////////////////////////////////////////////////////////
+
+	float RadicalInverseVdC(uint32_t bits)
+	{
+		bits = (bits << 16u) | (bits >> 16u);
+		bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+		bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+		bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+		bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+		return static_cast<float>(bits) * 2.3283064365386963e-10f;
+	}
+
+	float GeometrySchlickGGX(float NdotV, float roughness)
+	{
+		const float k = (roughness * roughness) / 2.0f;
+		return NdotV / (NdotV * (1.0f - k) + k);
+	}
+
+	void IntegrateBRDF(float NdotV, float roughness, float& outA, float& outB)
+	{
+		// N = +Z, V in the XZ plane, so the tangent frame of ImportanceSampleGGX is the identity.
+		const glm::vec3 V(std::sqrt(1.0f - NdotV * NdotV), 0.0f, NdotV);
+		const float a = roughness * roughness;
+
+		float A = 0.0f;
+		float B = 0.0f;
+		for (uint32_t i = 0; i < kBRDFSampleCount; ++i)
+		{
+			const float xiX = static_cast<float>(i) / static_cast<float>(kBRDFSampleCount);
+			const float xiY = RadicalInverseVdC(i);
+
+			const float phi = 2.0f * kPi * xiX;
+			const float cosTheta = std::sqrt((1.0f - xiY) / (1.0f + (a * a - 1.0f) * xiY));
+			const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+			const glm::vec3 H(std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta);
+			const glm::vec3 L = glm::normalize(2.0f * glm::dot(V, H) * H - V);
+
+			const float NdotL = std::max(L.z, 0.0f);
+			const float NdotH = std::max(H.z, 0.0f);
+			const float VdotH = std::max(glm::dot(V, H), 0.0f);
+			if (NdotL > 0.0f)
+			{
+				const float G = GeometrySchlickGGX(NdotL, roughness) * GeometrySchlickGGX(NdotV, roughness);
+				const float GVis = (G * VdotH) / (NdotH * NdotV);
+				const float Fc = std::pow(1.0f - VdotH, 5.0f);
+
+				A += (1.0f - Fc) * GVis;
+				B += Fc * GVis;
+			}
+		}
+
+		outA = A / static_cast<float>(kBRDFSampleCount);
+		outB = B / static_cast<float>(kBRDFSampleCount);
+	}
+
+	std::vector<float> ComputeBRDFLut(uint32_t size)
+	{
+		std::vector<float> lut(static_cast<size_t>(size) * size * 2);
+		ParallelForRows(size, [&](uint32_t y)
+			{
+				const float roughness = (static_cast<float>(y) + 0.5f) / static_cast<float>(size);
+				for (uint32_t x = 0; x < size; ++x)
+				{
+					const float NdotV = (static_cast<float>(x) + 0.5f) / static_cast<float>(size);
+					float* texel = &lut[(static_cast<size_t>(y) * size + x) * 2];
+					IntegrateBRDF(NdotV, roughness, texel[0], texel[1]);
+				}
+			});
+		return lut;
+	}
+
+	bool ReadBRDFLut(const std::string& path, uint32_t size, std::vector<float>& outLut)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+
+		LutHeader header{};
+		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!stream || header.Magic != kLutMagic || header.Version != kEnvironmentCacheVersion ||
+			header.Size != size || header.SampleCount != kBRDFSampleCount)
+			return false;
+
+		outLut.resize(static_cast<size_t>(size) * size * 2);
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(outLut.data()), static_cast<std::streamsize>(outLut.size() * sizeof(float))));
+	}
+
+	std::string BuildLutPath(uint32_t size)
+	{
+		char fileName[32];
+		std::snprintf(fileName, sizeof(fileName), "brdf_lut_%u.bin", size);
+		return (std::filesystem::path(Syndra::EnvironmentCache::GetCacheDirectory()) / fileName).string();
+	}
+
+}
+
+namespace Syndra {
+
+	std::string EnvironmentCache::GetCachePath(const std::string& hdrPath, const EnvironmentCacheSettings& settings)
+	{
+		std::vector<uint8_t> sourceBytes;
+		if (!ReadFileBytes(hdrPath, sourceBytes))
+			return {};
+
+		const uint32_t settingsKey[3] = { settings.PrefilterSize, settings.PrefilterLevels, kEnvironmentCacheVersion };
+		uint64_t hash = HashBytes(sourceBytes.data(), sourceBytes.size());
+		hash = HashBytes(settingsKey, sizeof(settingsKey), hash);
+
+		char fileName[32];
+		std::snprintf(fileName, sizeof(fileName), "%016llx.ibl", static_cast<unsigned long long>(hash));
+		return (std::filesystem::path(GetCacheDirectory()) / fileName).string();
+	}
+
+	bool EnvironmentCache::ReadMaps(const std::string& cachePath, const EnvironmentCacheSettings& settings, EnvironmentMaps& outMaps)
+	{
+		if (!IsEnabled() || cachePath.empty())
+			return false;
+
+		std::ifstream stream(cachePath, std::ios::binary);
+		if (!stream)
+			return false;
+
+		MapsHeader header{};
+		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!stream || header.Magic != kMapsMagic || header.Version != kEnvironmentCacheVersion ||
+			header.PrefilterSize != settings.PrefilterSize ||
+			header.PrefilterLevels != settings.PrefilterLevels)
+			return false;
+
+		EnvironmentMaps maps;
+		auto readLevel = [&](EnvironmentCubeLevel& level, uint32_t size)
+		{
+			level.Size = size;
+			level.Data.resize(GetCubeLevelElementCount(size));
+			stream.read(reinterpret_cast<char*>(level.Data.data()), static_cast<std::streamsize>(level.Data.size() * sizeof(uint16_t)));
+			return static_cast<bool>(stream);
+		};
+
+		stream.read(reinterpret_cast<char*>(maps.Irradiance.Coefficients.data()), sizeof(maps.Irradiance.Coefficients));
+		if (!stream)
+			return false;
+
+		maps.Prefilter.resize(header.PrefilterLevels);
+		for (uint32_t mip = 0; mip < header.PrefilterLevels; ++mip)
+		{
+			if (!readLevel(maps.Prefilter[mip], std::max(1u, header.PrefilterSize >> mip)))
+				return false;
+		}
+
+		outMaps = std::move(maps);
+		return true;
+	}
+
+	bool EnvironmentCache::WriteMaps(const std::string& cachePath, const EnvironmentMaps& maps)
+	{
+		if (!IsEnabled() || cachePath.empty() || !maps.IsValid())
+			return false;
+
+		const MapsHeader header{ kMapsMagic, kEnvironmentCacheVersion, maps.Prefilter[0].Size,
+			static_cast<uint32_t>(maps.Prefilter.size()) };
+		return WriteCacheFile(cachePath, [&](std::ofstream& stream)
+			{
+				auto writeLevel = [&](const EnvironmentCubeLevel& level)
+				{
+					stream.write(reinterpret_cast<const char*>(level.Data.data()), static_cast<std::streamsize>(level.Data.size() * sizeof(uint16_t)));
+				};
+
+				stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				stream.write(reinterpret_cast<const char*>(maps.Irradiance.Coefficients.data()), sizeof(maps.Irradiance.Coefficients));
+				for (const auto& level : maps.Prefilter)
+					writeLevel(level);
+			});
+	}
+
+	const std::vector<float>& EnvironmentCache::GetBRDFLut(uint32_t size)
+	{
+		std::lock_guard lock(s_LutMutex);
+		auto& lut = s_BRDFLuts[size];
+		if (!lut.empty())
+			return lut;
+
+		const std::string path = BuildLutPath(size);
+		if (IsEnabled() && ReadBRDFLut(path, size, lut))
+			return lut;
+
+		const auto start = std::chrono::steady_clock::now();
+		lut = ComputeBRDFLut(size);
+		const double computeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		SN_CORE_INFO("Computed {}x{} BRDF LUT in {:.1f} ms.", size, size, computeMs);
+
+		if (IsEnabled())
+		{
+			const LutHeader header{ kLutMagic, kEnvironmentCacheVersion, size, kBRDFSampleCount };
+			const bool written = WriteCacheFile(path, [&](std::ofstream& stream)
+				{
+					stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+					stream.write(reinterpret_cast<const char*>(lut.data()), static_cast<std::streamsize>(lut.size() * sizeof(float)));
+				});
+			if (!written)
+				SN_CORE_WARN("Failed to write BRDF LUT cache '{}'.", path);
+		}
+		return lut;
+	}
+
+	void EnvironmentCache::SetCacheDirectory(const std::string& directory)
+	{
+		std::lock_guard lock(s_SettingsMutex);
+		s_CacheDirectory = directory;
+	}
+
+	std::string EnvironmentCache::GetCacheDirectory()
+	{
+		std::lock_guard lock(s_SettingsMutex);
+		if (s_CacheDirectory.empty())
+			s_CacheDirectory = (std::filesystem::path(AssetPath::ResolveEditorAssetPath("assets")) / ".cache" / "environments").lexically_normal().string();
+		return s_CacheDirectory;
+	}
+
+	void EnvironmentCache::SetEnabled(bool enabled)
+	{
+		s_Enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool EnvironmentCache::IsEnabled()
+	{
+		return s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	void EnvironmentCache::RecordLoad(bool warm, double milliseconds)
+	{
+		std::lock_guard lock(s_StatsMutex);
+		s_Stats.LastLoadMs = milliseconds;
+		s_Stats.LastLoadWarm = warm;
+		if (warm)
+		{
+			++s_Stats.WarmLoads;
+			s_Stats.TotalWarmMs += milliseconds;
+		}
+		else
+		{
+			++s_Stats.ColdLoads;
+			s_Stats.TotalColdMs += milliseconds;
+		}
+	}
+
+	void EnvironmentCache::RecordProjection(double milliseconds)
+	{
+		std::lock_guard lock(s_StatsMutex);
+		s_Stats.LastProjectionMs = milliseconds;
+	}
+
+	EnvironmentCacheStats EnvironmentCache::GetStats()
+	{
+		std::lock_guard lock(s_StatsMutex);
+		return s_Stats;
+	}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Engine/Renderer/SphericalHarmonics.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Syndra {
+
+	struct EnvironmentCacheSettings
+	{
+		uint32_t PrefilterSize = 512;
+		uint32_t PrefilterLevels = 5;
+	};
+
+	// One level of a cube map: six square RGB16F faces in +X, -X, +Y, -Y, +Z, -Z order.
+	struct EnvironmentCubeLevel
+	{
+		uint32_t Size = 0;
+		std::vector<uint16_t> Data;
+	};
+
+	struct EnvironmentMaps
+	{
+		SphericalHarmonicsL2 Irradiance;	// already convolved, see SphericalHarmonics::ConvolveLambert
+		std::vector<EnvironmentCubeLevel> Prefilter;
+
+		bool IsValid() const { return !Prefilter.empty(); }
+	};
+
+	struct EnvironmentCacheStats
+	{
+		uint32_t WarmLoads = 0;		// environments whose IBL maps came from the cache
+		uint32_t ColdLoads = 0;		// environments that had to project/convolve from the HDR
+		double LastLoadMs = 0.0;
+		bool LastLoadWarm = false;
+		double TotalWarmMs = 0.0;
+		double TotalColdMs = 0.0;
+		double LastProjectionMs = -1.0;	// CPU SH projection of the last cold load, -1 before the first
+	};
+
+	// Disk cache for the image-based-lighting inputs built by Environment. The irradiance SH and
+	// the prefiltered specular cube are keyed by the HDR's content hash and the capture settings;
+	// the BRDF LUT depends on nothing but its size, so it is computed once on the CPU (split over
+	// worker threads) and shared by every environment.
+	class EnvironmentCache
+	{
+	public:
+		// Empty if the HDR cannot be read.
+		static std::string GetCachePath(const std::string& hdrPath, const EnvironmentCacheSettings& settings);
+		static bool ReadMaps(const std::string& cachePath, const EnvironmentCacheSettings& settings, EnvironmentMaps& outMaps);
+		static bool WriteMaps(const std::string& cachePath, const EnvironmentMaps& maps);
+
+		// Split-sum BRDF LUT as interleaved RG floats, row 0 = roughness 0. Loaded from the cache
+		// or computed on the CPU, and kept in memory for the rest of the session.
+		static const std::vector<float>& GetBRDFLut(uint32_t size);
+
+		static void SetCacheDirectory(const std::string& directory);
+		static std::string GetCacheDirectory();
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		static void RecordLoad(bool warm, double milliseconds);
+		static void RecordProjection(double milliseconds);
+		static EnvironmentCacheStats GetStats();
+	};
+
+}
@@ -3,6 +3,12 @@
 #include "imgui.h"
 #include "imgui_internal.h"
 #include "Engine/ImGui/ImGuiLayer.h"
+#include "Engine/Renderer/GpuProfiler.h"
+#include "Engine/Renderer/OcclusionCuller.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/SceneRenderer.h"
+#include "Engine/Renderer/TextureLibrary.h"
+#include "Engine/Renderer/TextureStreamer.h"
 #include "Engine/Utils/PlatformUtils.h"
 #include "Engine/Core/Application.h"
 #include "Engine/Scene/Entity.h"
@@ -10,10 +16,329 @@
 #include "Engine/Core/Instrument.h"
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
 namespace Syndra {
 
 	static ForwardPlusRenderer::RenderData r_Data;
 
+	namespace {
+
+		// The Hi-Z is built down to the first level no wider or taller than this, which is read back.
+		constexpr uint32_t kHiZReadbackSize = 64;
+		constexpr uint32_t kHiZWorkgroupSize = 8;
+		constexpr uint32_t kHiZBinding = 3;
+
+		double MillisecondsSince(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		bool ComputeModelBounds(const Model& model, glm::vec3& outMin, glm::vec3& outMax)
+		{
+			bool hasBounds = false;
+			for (const auto& mesh : model.meshes)
+			{
+				if (!mesh.HasBounds())
+					continue;
+
+				if (!hasBounds)
+				{
+					outMin = mesh.GetBoundsMin();
+					outMax = mesh.GetBoundsMax();
+					hasBounds = true;
+					continue;
+				}
+
+				outMin = glm::min(outMin, mesh.GetBoundsMin());
+				outMax = glm::max(outMax, mesh.GetBoundsMax());
+			}
+
+			return hasBounds;
+		}
+
+		uint64_t CountTriangles(const Model& model)
+		{
+			uint64_t triangles = 0;
+			for (const auto& mesh : model.meshes)
+				triangles += mesh.indices.size() / 3;
+			return triangles;
+		}
+
+		// Copies the coarsest Hi-Z level into a free readback buffer and fences it. With every slot
+		// still in flight the copy is skipped: the CPU never waits for the GPU here.
+		void QueueHiZReadback(const ForwardPlusRenderer::HiZReadback& info, uint32_t sourceOffset)
+		{
+			ForwardPlusRenderer::HiZReadbackSlot* slot = nullptr;
+			for (auto& candidate : r_Data.hiZReadbacks)
+			{
+				if (!candidate.fence)
+				{
+					slot = &candidate;
+					break;
+				}
+			}
+			if (!slot)
+				return;
+
+			const uint32_t bytes = info.width * info.height * sizeof(float);
+			if (slot->bufferSize < bytes)
+			{
+				glDeleteBuffers(1, &slot->buffer);
+				glCreateBuffers(1, &slot->buffer);
+				glNamedBufferData(slot->buffer, bytes, nullptr, GL_STREAM_READ);
+				slot->bufferSize = bytes;
+			}
+			glCopyNamedBufferSubData(r_Data.hiZBuffer, slot->buffer, sourceOffset * sizeof(float), 0, bytes);
+			slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			slot->info = info;
+		}
+
+		// Moves the newest readback the GPU has finished into r_Data.hiZ. Fences are only polled, so
+		// reading the buffer afterwards does not stall either.
+		void CollectHiZReadbacks()
+		{
+			auto& hiZ = r_Data.hiZ;
+			for (auto& slot : r_Data.hiZReadbacks)
+			{
+				if (!slot.fence)
+					continue;
+
+				const GLsync fence = static_cast<GLsync>(slot.fence);
+				const GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+				if (status == GL_TIMEOUT_EXPIRED)
+					continue;
+
+				glDeleteSync(fence);
+				slot.fence = nullptr;
+				if (status == GL_WAIT_FAILED || (hiZ.valid && slot.info.frame <= hiZ.frame))
+					continue;
+
+				std::vector<float> depths = std::move(hiZ.depths);
+				hiZ = slot.info;
+				hiZ.depths = std::move(depths);
+				hiZ.depths.resize(static_cast<size_t>(hiZ.width) * hiZ.height);
+				glGetNamedBufferSubData(slot.buffer, 0, hiZ.depths.size() * sizeof(float), hiZ.depths.data());
+				hiZ.valid = true;
+			}
+		}
+
+		void ReleaseHiZReadbacks()
+		{
+			for (auto& slot : r_Data.hiZReadbacks)
+			{
+				if (slot.fence)
+					glDeleteSync(static_cast<GLsync>(slot.fence));
+				slot.fence = nullptr;
+			}
+		}
+
+		// Downsamples the depth pre-pass into the packed Hi-Z buffer, each level keeping the farthest
+		// depth of 2x2 texels of the one before it, and queues the last level for readback.
+		void BuildHiZ(const glm::mat4& viewProjection)
+		{
+			SN_PROFILE_SCOPE("Hi-Z Build");
+			const auto& target = r_Data.depthPass->GetSpecification().TargetFrameBuffer;
+			const uint32_t depthWidth = target->GetSpecification().Width;
+			const uint32_t depthHeight = target->GetSpecification().Height;
+
+			struct Level
+			{
+				int32_t width, height, offset;
+			};
+			std::vector<Level> levels;
+			uint32_t width = depthWidth;
+			uint32_t height = depthHeight;
+			uint32_t texelCount = 0;
+			do
+			{
+				width = (width + 1) / 2;
+				height = (height + 1) / 2;
+				levels.push_back({ static_cast<int32_t>(width), static_cast<int32_t>(height), static_cast<int32_t>(texelCount) });
+				texelCount += width * height;
+			} while (std::max(width, height) > kHiZReadbackSize);
+
+			const uint32_t requiredBytes = texelCount * sizeof(float);
+			if (r_Data.hiZBufferSize < requiredBytes)
+			{
+				glDeleteBuffers(1, &r_Data.hiZBuffer);
+				glCreateBuffers(1, &r_Data.hiZBuffer);
+				glNamedBufferData(r_Data.hiZBuffer, requiredBytes, nullptr, GL_DYNAMIC_COPY);
+				r_Data.hiZBufferSize = requiredBytes;
+			}
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kHiZBinding, r_Data.hiZBuffer);
+
+			r_Data.hiZShader->Bind();
+			Texture2D::BindTexture(target->GetDepthAttachmentRendererID(), 0);
+			for (size_t level = 0; level < levels.size(); ++level)
+			{
+				const Level source = (level == 0)
+					? Level{ static_cast<int32_t>(depthWidth), static_cast<int32_t>(depthHeight), -1 }
+					: levels[level - 1];
+				const Level& destination = levels[level];
+				r_Data.hiZShader->SetInt("pc.sourceWidth", source.width);
+				r_Data.hiZShader->SetInt("pc.sourceHeight", source.height);
+				r_Data.hiZShader->SetInt("pc.sourceOffset", source.offset);
+				r_Data.hiZShader->SetInt("pc.width", destination.width);
+				r_Data.hiZShader->SetInt("pc.height", destination.height);
+				r_Data.hiZShader->SetInt("pc.offset", destination.offset);
+				r_Data.hiZShader->DispatchCompute(
+					(destination.width + kHiZWorkgroupSize - 1) / kHiZWorkgroupSize,
+					(destination.height + kHiZWorkgroupSize - 1) / kHiZWorkgroupSize,
+					1);
+				glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+			}
+			r_Data.hiZShader->Unbind();
+
+			const Level& last = levels.back();
+			ForwardPlusRenderer::HiZReadback info;
+			info.viewProjection = viewProjection;
+			info.depthWidth = depthWidth;
+			info.depthHeight = depthHeight;
+			info.level = static_cast<uint32_t>(levels.size() - 1);
+			info.width = last.width;
+			info.height = last.height;
+			info.frame = r_Data.hiZFrame;
+			QueueHiZReadback(info, static_cast<uint32_t>(last.offset));
+		}
+
+		// A new readback was requested for the view being drawn, but the Hi-Z the items were tested
+		// against belongs to another one.
+		bool IsHiZReadbackPending(const glm::mat4& viewProjection)
+		{
+			if (r_Data.hiZ.valid && r_Data.hiZ.viewProjection == viewProjection)
+				return false;
+
+			for (const auto& slot : r_Data.hiZReadbacks)
+			{
+				if (slot.fence && slot.info.viewProjection == viewProjection)
+					return true;
+			}
+			return false;
+		}
+
+		// Unit box from (0, 0, 0) to (1, 1, 1), scaled onto an item's bounds by the late test.
+		Ref<VertexArray> CreateBoundsVertexArray()
+		{
+			float corners[8 * 3];
+			for (uint32_t corner = 0; corner < 8; ++corner)
+			{
+				corners[corner * 3 + 0] = (corner & 1) ? 1.0f : 0.0f;
+				corners[corner * 3 + 1] = (corner & 2) ? 1.0f : 0.0f;
+				corners[corner * 3 + 2] = (corner & 4) ? 1.0f : 0.0f;
+			}
+			uint32_t indices[] = {
+				0, 2, 3, 0, 3, 1,	// -z
+				4, 5, 7, 4, 7, 6,	// +z
+				0, 4, 6, 0, 6, 2,	// -x
+				1, 3, 7, 1, 7, 5,	// +x
+				0, 1, 5, 0, 5, 4,	// -y
+				2, 6, 7, 2, 7, 3	// +y
+			};
+
+			auto vertexArray = VertexArray::Create();
+			auto vb = VertexBuffer::Create(corners, sizeof(corners));
+			vb->SetLayout({ { ShaderDataType::Float3, "a_pos" } });
+			vertexArray->AddVertexBuffer(vb);
+			vertexArray->SetIndexBuffer(IndexBuffer::Create(indices, sizeof(indices) / sizeof(uint32_t)));
+			return vertexArray;
+		}
+
+		// Late test of the items the Hi-Z culled, into the bound depth pre-pass. Their bounding boxes
+		// are drawn against this frame's depth with an occlusion query each, then the items under
+		// conditional rendering of their query: the GPU skips the ones still hidden and the CPU never
+		// waits for a result. The lighting pass draws them under the same queries.
+		void DrawHiZLateDepth(const RenderItemList& lateItems)
+		{
+			auto& queries = r_Data.hiZQueries;
+			if (queries.size() < lateItems.size())
+			{
+				const size_t created = queries.size();
+				queries.resize(lateItems.size());
+				glGenQueries(static_cast<GLsizei>(queries.size() - created), queries.data() + created);
+			}
+
+			r_Data.depthShader->Bind();
+			glDepthMask(GL_FALSE);
+			for (size_t i = 0; i < lateItems.size(); ++i)
+			{
+				glm::vec3 boundsMin, boundsMax;
+				ComputeModelBounds(lateItems[i]->Mesh->model, boundsMin, boundsMax);
+				const glm::mat4 boundsTransform = glm::scale(glm::translate(lateItems[i]->WorldTransform, boundsMin), boundsMax - boundsMin);
+				r_Data.depthShader->SetMat4("transform.u_trans", boundsTransform);
+				glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, queries[i]);
+				Renderer::Submit(r_Data.depthShader, r_Data.boundsVao);
+				glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+			}
+			glDepthMask(GL_TRUE);
+
+			for (size_t i = 0; i < lateItems.size(); ++i)
+			{
+				glBeginConditionalRender(queries[i], GL_QUERY_WAIT);
+				r_Data.depthShader->SetMat4("transform.u_trans", lateItems[i]->WorldTransform);
+				Renderer::Submit(r_Data.depthShader, lateItems[i]->Mesh->model);
+				glEndConditionalRender();
+			}
+		}
+
+		// True when the item's bounding box lies behind the read back Hi-Z level. Items without
+		// bounds, boxes crossing the near plane and tests without a readback count as visible.
+		bool IsHiZOccluded(const ForwardPlusRenderer::HiZReadback& hiZ, const RenderItem& item)
+		{
+			glm::vec3 boundsMin, boundsMax;
+			if (!hiZ.valid || !item.Mesh || !ComputeModelBounds(item.Mesh->model, boundsMin, boundsMax))
+				return false;
+
+			const glm::mat4 transform = hiZ.viewProjection * item.WorldTransform;
+			const glm::vec2 depthSize(static_cast<float>(hiZ.depthWidth), static_cast<float>(hiZ.depthHeight));
+			glm::vec2 screenMin(std::numeric_limits<float>::max());
+			glm::vec2 screenMax(std::numeric_limits<float>::lowest());
+			float nearestDepth = std::numeric_limits<float>::max();
+			for (uint32_t corner = 0; corner < 8; ++corner)
+			{
+				const glm::vec4 clip = transform * glm::vec4(
+					(corner & 1) ? boundsMax.x : boundsMin.x,
+					(corner & 2) ? boundsMax.y : boundsMin.y,
+					(corner & 4) ? boundsMax.z : boundsMin.z,
+					1.0f);
+				if (clip.w <= 1e-5f || clip.z < -clip.w)
+					return false;
+
+				const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+				const glm::vec2 screen = (glm::vec2(ndc) * 0.5f + 0.5f) * depthSize;
+				screenMin = glm::min(screenMin, screen);
+				screenMax = glm::max(screenMax, screen);
+				nearestDepth = std::min(nearestDepth, ndc.z * 0.5f + 0.5f);
+			}
+			if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= depthSize.x || screenMin.y >= depthSize.y)
+				return false;
+
+			// A texel of level L covers 2^(L+1) pixels, the last one of a row or column also the rest.
+			const uint32_t shift = hiZ.level + 1;
+			const auto toTexel = [shift](float pixel, float pixelLimit, uint32_t texelLimit)
+			{
+				const uint32_t texel = static_cast<uint32_t>(std::clamp(pixel, 0.0f, pixelLimit - 1.0f)) >> shift;
+				return std::min(texel, texelLimit - 1);
+			};
+			const uint32_t minX = toTexel(screenMin.x, depthSize.x, hiZ.width);
+			const uint32_t maxX = toTexel(screenMax.x, depthSize.x, hiZ.width);
+			const uint32_t minY = toTexel(screenMin.y, depthSize.y, hiZ.height);
+			const uint32_t maxY = toTexel(screenMax.y, depthSize.y, hiZ.height);
+			for (uint32_t y = minY; y <= maxY; ++y)
+			{
+				for (uint32_t x = minX; x <= maxX; ++x)
+				{
+					if (hiZ.depths[y * hiZ.width + x] >= nearestDepth)
+						return false;
+				}
+			}
+			return true;
+		}
+
+	}
+
 	void ForwardPlusRenderer::Init(const Ref<Scene>& scene, const ShaderLibrary& shaders, const Ref<Environment>& env)
 	{
 		r_Data.scene = scene;
@@ -110,7 +435,7 @@ namespace Syndra {
 		r_Data.postProcShader = r_Data.shaders.Get("ForwardPostProc");
 		r_Data.compShader = r_Data.shaders.Get("computeShader");
 		r_Data.forwardLightingShader = r_Data.shaders.Get("ForwardShading");
-
+		r_Data.hiZShader = r_Data.shaders.Get("HiZBuild");
 
 		Syndra::Math::GeneratePoissonDisk(r_Data.distributionSampler0, 64);
 		Syndra::Math::GeneratePoissonDisk(r_Data.distributionSampler1, 64);
@@ -135,48 +460,119 @@ namespace Syndra {
 		float dSize = r_Data.orthoSize;
 		r_Data.lightProj = glm::ortho(-dSize, dSize, -dSize, dSize, r_Data.lightNear, r_Data.lightFar);
 		r_Data.ShadowBuffer = UniformBuffer::Create(sizeof(glm::mat4), 3);
+		r_Data.EnvironmentSHBuffer = UniformBuffer::Create(sizeof(SphericalHarmonicsUniform), 4);
+		r_Data.occlusionCuller = CreateRef<OcclusionCuller>();
+		r_Data.boundsVao = CreateBoundsVertexArray();
+		r_Data.gpuProfiler = GpuProfiler::Create();
 	}
 
-	void ForwardPlusRenderer::Render()
+	void ForwardPlusRenderer::Render(const SceneRenderView& view)
 	{
-		auto view = r_Data.scene->m_Registry.view<TransformComponent, MeshComponent>();
+		if (r_Data.gpuProfiler)
+			r_Data.gpuProfiler->BeginFrame();
+
+		// Occlusion is only known for the camera, so the shadow pass keeps every item.
+		RenderItemList cameraItems;
+		cameraItems.reserve(view.Items.size());
+		for (const auto& item : view.Items)
+			cameraItems.push_back(&item);
+		if (r_Data.useOcclusionCulling && r_Data.occlusionCuller)
+		{
+			SN_PROFILE_SCOPE("Occlusion Culling");
+			r_Data.occlusionCuller->Cull(view.Camera.GetViewProjection(), cameraItems, cameraItems);
+		}
+
+		// Hi-Z occlusion tests items against the newest depth pre-pass the GPU has finished and read
+		// back, usually a frame or two old. The hidden ones are not drawn with the others but by the
+		// late test (DrawHiZLateDepth) against this frame's depth, so items coming out from behind an
+		// occluder show up in the frame they do.
+		const bool hiZOcclusion = r_Data.useHiZOcclusion && r_Data.hiZShader;
+		HiZStats hiZStats;
+		RenderItemList lateItems;
+		if (hiZOcclusion)
+		{
+			SN_PROFILE_SCOPE("Hi-Z Test");
+			const auto start = std::chrono::steady_clock::now();
+			++r_Data.hiZFrame;
+			CollectHiZReadbacks();
+			hiZStats.tested = static_cast<uint32_t>(cameraItems.size());
+			RenderItemList visibleItems;
+			visibleItems.reserve(cameraItems.size());
+			for (const RenderItem* item : cameraItems)
+			{
+				if (IsHiZOccluded(r_Data.hiZ, *item))
+				{
+					lateItems.push_back(item);
+					hiZStats.occludedTriangles += CountTriangles(item->Mesh->model);
+				}
+				else
+				{
+					visibleItems.push_back(item);
+				}
+			}
+			cameraItems = std::move(visibleItems);
+			hiZStats.occluded = static_cast<uint32_t>(lateItems.size());
+			hiZStats.readbackAge = r_Data.hiZ.valid ? static_cast<uint32_t>(r_Data.hiZFrame - r_Data.hiZ.frame) : 0;
+			hiZStats.testMs = MillisecondsSince(start);
+		}
+
 		//-----------------------------------------------Depth Pre Pass--------------------------------------------//
 		{
 			SN_PROFILE_SCOPE("Depth pass");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Depth pass");
 			r_Data.depthPass->BindTargetFrameBuffer();
 			RenderCommand::SetState(RenderState::DEPTH_TEST, true);
 			RenderCommand::SetClearColor(r_Data.depthPass->GetSpecification().TargetFrameBuffer->GetSpecification().ClearColor);
 			r_Data.depthShader->Bind();
 			RenderCommand::Clear();
-			for (auto ent : view)
+			for (const RenderItem* item : cameraItems)
 			{
-				auto& mc = view.get<MeshComponent>(ent);
-				if (!mc.path.empty())
-				{
-					const glm::mat4 worldTransform = r_Data.scene->GetWorldTransform(Entity{ ent });
-					r_Data.depthShader->SetMat4("transform.u_trans", worldTransform);
-					Renderer::Submit(r_Data.depthShader, mc.model);
-				}
+				r_Data.depthShader->SetMat4("transform.u_trans", item->WorldTransform);
+				Renderer::Submit(r_Data.depthShader, item->Mesh->model);
 			}
 			r_Data.depthPass->UnbindTargetFrameBuffer();
 		}
+		if (!lateItems.empty())
+		{
+			SN_PROFILE_SCOPE("Hi-Z Late Test");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Hi-Z Late Test");
+			r_Data.depthPass->BindTargetFrameBuffer();
+			DrawHiZLateDepth(lateItems);
+			r_Data.depthPass->UnbindTargetFrameBuffer();
+		}
+		if (hiZOcclusion)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			{
+				SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Hi-Z Build");
+				BuildHiZ(view.Camera.GetViewProjection());
+			}
+			hiZStats.buildMs = MillisecondsSince(start);
+			r_Data.hiZStats = hiZStats;
+
+			// Rendering on demand, nothing would draw the frame that picks up the readback of this
+			// view, and the items would keep being tested against the depth of the one before.
+			if (IsHiZReadbackPending(view.Camera.GetViewProjection()))
+				SceneRenderer::Invalidate();
+		}
+		else
+		{
+			ReleaseHiZReadbacks();
+			r_Data.hiZ.valid = false;
+		}
 		//----------------------------------------Directional Light Shadow Pass-----------------------------------//
 		{
 			SN_PROFILE_SCOPE("Shadow Pass");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Shadow Pass");
 			r_Data.shadowPass->BindTargetFrameBuffer();
 			RenderCommand::SetState(RenderState::DEPTH_TEST, true);
 			RenderCommand::SetClearColor(r_Data.shadowPass->GetSpecification().TargetFrameBuffer->GetSpecification().ClearColor);
 			r_Data.shadowDepthShader->Bind();
 			RenderCommand::Clear();
-			for (auto ent : view)
+			for (const auto& item : view.Items)
 			{
-				auto& mc = view.get<MeshComponent>(ent);
-				if (!mc.path.empty())
-				{
-					const glm::mat4 worldTransform = r_Data.scene->GetWorldTransform(Entity{ ent });
-					r_Data.shadowDepthShader->SetMat4("transform.u_trans", worldTransform);
-					Renderer::Submit(r_Data.shadowDepthShader, mc.model);
-				}
+				r_Data.shadowDepthShader->SetMat4("transform.u_trans", item.WorldTransform);
+				Renderer::Submit(r_Data.shadowDepthShader, item.Mesh->model);
 			}
 			r_Data.shadowPass->UnbindTargetFrameBuffer();
 		}
@@ -184,11 +580,12 @@ namespace Syndra {
 		//Compute pass to calculate light indices
 		{
 			SN_PROFILE_SCOPE("Light Culling");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Light Culling");
 			r_Data.compShader->Bind();
 			//Attaching depth map from previous pass
 			Texture2D::BindTexture(r_Data.depthPass->GetSpecification().TargetFrameBuffer->GetDepthAttachmentRendererID(), 2);
-			r_Data.compShader->SetMat4("pc.view", r_Data.scene->m_Camera->GetViewMatrix());
-			r_Data.compShader->SetMat4("pc.projection", r_Data.scene->m_Camera->GetProjection());
+			r_Data.compShader->SetMat4("pc.view", view.Camera.GetViewMatrix());
+			r_Data.compShader->SetMat4("pc.projection", view.Camera.GetProjection());
 			r_Data.compShader->SetFloat("pc.width", (float)r_Data.depthPass->GetSpecification().TargetFrameBuffer->GetSpecification().Width);
 			r_Data.compShader->SetFloat("pc.height", (float)r_Data.depthPass->GetSpecification().TargetFrameBuffer->GetSpecification().Height);
 			r_Data.compShader->SetInt("pc.lightCount", r_Data.numLights);
@@ -200,6 +597,7 @@ namespace Syndra {
 		//---------------------------------------Lighting Accumulation--------------------------------------------//
 		{
 			SN_PROFILE_SCOPE("Light Accumulation");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Light Accumulation");
 			r_Data.lightingPass->BindTargetFrameBuffer();
 			RenderCommand::Clear();
 			//RenderCommand::SetState(RenderState::DEPTH_TEST, true);
@@ -222,39 +620,42 @@ namespace Syndra {
 			//Environment samplers
 			if (r_Data.environment) {
 				r_Data.environment->SetIntensity(r_Data.intensity);
-				r_Data.environment->BindIrradianceMap(7);
+				r_Data.EnvironmentSHBuffer->SetData(r_Data.environment->GetIrradianceSH().data(), sizeof(SphericalHarmonicsUniform));
 				r_Data.environment->BindPreFilterMap(8);
 				r_Data.environment->BindBRDFMap(9);
 			}
 			r_Data.forwardLightingShader->Bind();
-			for (auto ent : view)
+			const auto drawItem = [](const RenderItem* item)
 			{
-				auto& mc = view.get<MeshComponent>(ent);
-				if (!mc.path.empty())
+				TextureStreamer::RequestModelTextures(item->Mesh->model, item->Material.get(), item->WorldTransform);
+				if (item->Material) {
+					r_Data.forwardLightingShader->SetInt("transform.id", (uint32_t)item->EntityHandle);
+					r_Data.forwardLightingShader->SetMat4("transform.u_trans", item->WorldTransform);
+					Renderer::Submit(*item->Material, item->Mesh->model);
+				}
+				else
 				{
-					const glm::mat4 worldTransform = r_Data.scene->GetWorldTransform(Entity{ ent });
-					if (r_Data.scene->m_Registry.has<MaterialComponent>(ent)) {
-						auto& mat = r_Data.scene->m_Registry.get<MaterialComponent>(ent);
-						r_Data.forwardLightingShader->SetInt("transform.id", (uint32_t)ent);
-						r_Data.forwardLightingShader->SetMat4("transform.u_trans", worldTransform);
-						Renderer::Submit(mat.m_Material, mc.model);
-					}
-					else
-					{
-						r_Data.forwardLightingShader->SetInt("push.HasAlbedoMap", 1);
-						r_Data.forwardLightingShader->SetFloat("push.tiling", 1.0f);
-						r_Data.forwardLightingShader->SetInt("push.HasNormalMap", 0);
-						r_Data.forwardLightingShader->SetInt("push.HasMetallicMap", 0);
-						r_Data.forwardLightingShader->SetInt("push.HasRoughnessMap", 0);
-						r_Data.forwardLightingShader->SetInt("push.HasAOMap", 0);
-						r_Data.forwardLightingShader->SetFloat("push.material.MetallicFactor", 0);
-						r_Data.forwardLightingShader->SetFloat("push.material.RoughnessFactor", 1);
-						r_Data.forwardLightingShader->SetFloat("push.material.AO", 1);
-						r_Data.forwardLightingShader->SetMat4("transform.u_trans", worldTransform);
-						r_Data.forwardLightingShader->SetInt("transform.id", (uint32_t)ent);
-						Renderer::Submit(r_Data.forwardLightingShader, mc.model);
-					}
+					r_Data.forwardLightingShader->SetInt("push.HasAlbedoMap", 1);
+					r_Data.forwardLightingShader->SetFloat("push.tiling", 1.0f);
+					r_Data.forwardLightingShader->SetInt("push.HasNormalMap", 0);
+					r_Data.forwardLightingShader->SetInt("push.HasMetallicMap", 0);
+					r_Data.forwardLightingShader->SetInt("push.HasRoughnessMap", 0);
+					r_Data.forwardLightingShader->SetInt("push.HasAOMap", 0);
+					r_Data.forwardLightingShader->SetFloat("push.material.MetallicFactor", 0);
+					r_Data.forwardLightingShader->SetFloat("push.material.RoughnessFactor", 1);
+					r_Data.forwardLightingShader->SetFloat("push.material.AO", 1);
+					r_Data.forwardLightingShader->SetMat4("transform.u_trans", item->WorldTransform);
+					r_Data.forwardLightingShader->SetInt("transform.id", (uint32_t)item->EntityHandle);
+					Renderer::Submit(r_Data.forwardLightingShader, item->Mesh->model);
 				}
+			};
+			for (const RenderItem* item : cameraItems)
+				drawItem(item);
+			for (size_t i = 0; i < lateItems.size(); ++i)
+			{
+				glBeginConditionalRender(r_Data.hiZQueries[i], GL_QUERY_WAIT);
+				drawItem(lateItems[i]);
+				glEndConditionalRender();
 			}
 			r_Data.forwardLightingShader->Unbind();
 
@@ -273,6 +674,7 @@ namespace Syndra {
 		//-------------------------------------Post Processing and Depth Debug------------------------------------//
 		{
 			SN_PROFILE_SCOPE("Post Processing");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Post Processing");
 			r_Data.postProcPass->BindTargetFrameBuffer();
 			RenderCommand::Clear();
 			r_Data.postProcShader->Bind();
@@ -286,12 +688,30 @@ namespace Syndra {
 			r_Data.postProcShader->Unbind();
 			r_Data.postProcPass->UnbindTargetFrameBuffer();
 		}
+
+		if (r_Data.gpuProfiler)
+			r_Data.gpuProfiler->EndFrame();
 	}
 
 	void ForwardPlusRenderer::ShutDown()
 	{
 		glDeleteBuffers(1, &r_Data.lightBuffer);
 		glDeleteBuffers(1, &r_Data.visibleLightIndicesBuffer);
+		glDeleteBuffers(1, &r_Data.hiZBuffer);
+		r_Data.hiZBuffer = 0;
+		r_Data.hiZBufferSize = 0;
+		ReleaseHiZReadbacks();
+		for (auto& slot : r_Data.hiZReadbacks)
+		{
+			glDeleteBuffers(1, &slot.buffer);
+			slot.buffer = 0;
+			slot.bufferSize = 0;
+		}
+		r_Data.hiZ.valid = false;
+		glDeleteQueries(static_cast<GLsizei>(r_Data.hiZQueries.size()), r_Data.hiZQueries.data());
+		r_Data.hiZQueries.clear();
+		r_Data.boundsVao = nullptr;
+		r_Data.gpuProfiler = nullptr;
 	}
 
 	void ForwardPlusRenderer::SetupLights()
@@ -319,10 +739,9 @@ namespace Syndra {
 		glNamedBufferSubData(r_Data.lightBuffer, 0, sizeof(r_Data.pLights), &r_Data.pLights);
 	}
 
-	void ForwardPlusRenderer::UpdateLights()
+	void ForwardPlusRenderer::UpdateLights(const SceneRenderView& view)
 	{
 		SN_PROFILE_FUNCTION();
-		auto viewLights = r_Data.scene->m_Registry.view<TransformComponent, LightComponent>();
 		//point light index
 		int pIndex = 0;
 		//spot light index
@@ -337,13 +756,12 @@ namespace Syndra {
 			light.paddingAndRadius = glm::vec4(glm::vec3(0), 00.0f);
 		}
 
-		for (auto ent : viewLights)
+		for (const auto& lc : view.Lights)
 		{
-			auto& lc = viewLights.get<LightComponent>(ent);
-			const glm::vec3 worldTranslation = r_Data.scene->GetWorldTranslation(Entity{ ent });
+			const glm::vec3& worldTranslation = lc.Position;
 
-			if (lc.type == LightType::Directional) {
-				auto p = dynamic_cast<DirectionalLight*>(lc.light.get());
+			if (lc.Type == LightType::Directional) {
+				auto p = dynamic_cast<DirectionalLight*>(lc.Light.get());
 				r_Data.dirLight.color = glm::vec4(p->GetColor(), 0) * p->GetIntensity();
 				r_Data.dirLight.direction = glm::vec4(p->GetDirection(), 0);
 				r_Data.dirLight.position = glm::vec4(worldTranslation, 0);
@@ -354,9 +772,9 @@ namespace Syndra {
 				r_Data.dirLightBuffer->SetData(&r_Data.dirLight, sizeof(r_Data.dirLight));
 				p = nullptr;
 			}
-			if (lc.type == LightType::Point) {
+			if (lc.Type == LightType::Point) {
 				if (pIndex < 256) {
-					auto p = dynamic_cast<PointLight*>(lc.light.get());
+					auto p = dynamic_cast<PointLight*>(lc.Light.get());
 
 					pointLight& light = r_Data.pLights.lights[pIndex];
 					light.color = glm::vec4(p->GetColor(), 1) * p->GetIntensity();
@@ -367,9 +785,9 @@ namespace Syndra {
 					p = nullptr;
 				}
 			}
-			//if (lc.type == LightType::Spot) {
+			//if (lc.Type == LightType::Spot) {
 			//	if (sIndex < 4) {
-			//		auto p = dynamic_cast<SpotLight*>(lc.light.get());
+			//		auto p = dynamic_cast<SpotLight*>(lc.Light.get());
 			//		r_Data.lightManager->UpdateSpotLights(p, tc.Translation, sIndex);
 			//		sIndex++;
 			//		p = nullptr;
@@ -436,14 +854,62 @@ namespace Syndra {
 			ImGui::Separator();
 			//V-Sync
 			static bool vSync = true;
-			ImGui::Checkbox("V-Sync", &vSync);
-			Application::Get().GetWindow().SetVSync(vSync);
+			if (ImGui::Checkbox("V-Sync", &vSync))
+				Application::Get().GetWindow().SetVSync(vSync);
+
+			//Render thread
+			bool renderThread = RenderThread::GetLatency() > 0;
+			if (ImGui::Checkbox("Render thread (1 frame latency)", &renderThread))
+				RenderThread::SetLatency(renderThread ? 1 : 0);
+			if (RenderThread::IsThreaded())
+			{
+				const RenderThreadStats stats = RenderThread::GetStats();
+				ImGui::Text("main %.2f ms  render %.2f ms", stats.MainThreadMs, stats.RenderThreadMs);
+				ImGui::Text("wait %.2f ms  overlap %.2f ms  syncs %u", stats.WaitMs, stats.OverlapMs, stats.Synchronizations);
+			}
 			ImGui::Separator();
 
 			ImGui::Text("Anti Aliasing");
 			ImGui::Checkbox("FXAA", &r_Data.useFxaa);
 			ImGui::Separator();
 
+			ImGui::Checkbox("Occlusion Culling", &r_Data.useOcclusionCulling);
+			if (r_Data.useOcclusionCulling)
+			{
+				const OcclusionCuller::Stats& occlusionStats = r_Data.occlusionCuller->GetStats();
+				ImGui::Text("Occluded: %u of %u by %u occluders", occlusionStats.Occluded, occlusionStats.Tested, occlusionStats.Occluders);
+				ImGui::Text("Raster %.2f ms, test %.2f ms", occlusionStats.RasterMs, occlusionStats.TestMs);
+			}
+			ImGui::Checkbox("Hi-Z Occlusion Culling", &r_Data.useHiZOcclusion);
+			if (r_Data.useHiZOcclusion)
+			{
+				const HiZStats& hiZStats = r_Data.hiZStats;
+				ImGui::Text("Occluded: %u of %u (%llu triangles left to the late test)", hiZStats.occluded, hiZStats.tested, (unsigned long long)hiZStats.occludedTriangles);
+				ImGui::Text("Tested against depth from %u frames ago", hiZStats.readbackAge);
+				ImGui::Text("CPU: build %.2f ms, test %.2f ms", hiZStats.buildMs, hiZStats.testMs);
+				// Compare with the culling off to see what it saves on the passes it shortens.
+				const CpuProfileNode gpuFrame = Instrumentor::Get().GetLatestCpuFrameProfile().Gpu;
+				if (gpuFrame.Children.empty())
+				{
+					ImGui::TextDisabled("GPU pass timings need the profiler enabled");
+				}
+				else
+				{
+					const auto passMs = [&gpuFrame](const char* name)
+					{
+						for (const CpuProfileNode& pass : gpuFrame.Children)
+						{
+							if (pass.Name == name)
+								return pass.TotalTimeMs;
+						}
+						return 0.0;
+					};
+					ImGui::Text("GPU: depth %.2f ms, late test %.2f ms, Hi-Z build %.2f ms, lighting %.2f ms",
+						passMs("Depth pass"), passMs("Hi-Z Late Test"), passMs("Hi-Z Build"), passMs("Light Accumulation"));
+				}
+			}
+			ImGui::Separator();
+
 			//Exposure
 			ImGui::DragFloat("exposure", &r_Data.exposure, 0.01f, -2, 4);
 
@@ -488,7 +954,7 @@ namespace Syndra {
 				auto path = FileDialogs::OpenFile("HDR (*.hdr)\0*.hdr\0");
 				if (path) {
 					//Add texture as sRGB color space if it is binded to 0 (diffuse texture binding)
-					r_Data.environment = CreateRef<Environment>(Texture2D::CreateHDR(*path, false, true));
+					r_Data.environment = CreateRef<Environment>(TextureLibrary::LoadHDR(*path));
 					r_Data.scene->m_EnvironmentPath = *path;
 					SceneRenderer::SetEnvironment(r_Data.environment);
 				}
@@ -505,11 +971,17 @@ namespace Syndra {
 		}
 	}
 
+	void ForwardPlusRenderer::SetHiZOcclusion(bool enabled)
+	{
+		r_Data.useHiZOcclusion = enabled;
+	}
+
 	void ForwardPlusRenderer::OnResize(uint32_t width, uint32_t height)
 	{
 		r_Data.depthPass->GetSpecification().TargetFrameBuffer->Resize(width, height);
 		r_Data.lightingPass->GetSpecification().TargetFrameBuffer->Resize(width, height);
 		r_Data.postProcPass->GetSpecification().TargetFrameBuffer->Resize(width, height);
+		r_Data.hiZ.valid = false;
 		//change the number of work groups in the compute shader
 		r_Data.workGroupsX = (width + (width % 16)) / 16;
 		r_Data.workGroupsY = (height + (height % 16)) / 16;
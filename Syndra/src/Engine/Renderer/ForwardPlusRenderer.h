@@ -5,6 +5,8 @@
 namespace Syndra {
 
 	class Entity;
+	class GpuProfiler;
+	class OcclusionCuller;
 	class Scene;
 
 	class ForwardPlusRenderer : public RenderPipeline {
@@ -12,13 +14,13 @@ namespace Syndra {
 	public:
 		virtual void Init(const Ref<Scene>& scene, const ShaderLibrary& shaders, const Ref<Environment>& env) override;
 
-		virtual void Render() override;
+		virtual void Render(const SceneRenderView& view) override;
 
 		virtual void End() override;
 
 		virtual void ShutDown() override;
 
-		virtual void UpdateLights() override;
+		virtual void UpdateLights(const SceneRenderView& view) override;
 
 		virtual uint32_t GetFinalTextureID(int index) override;
 
@@ -29,6 +31,8 @@ namespace Syndra {
 		virtual void OnImGuiRender(bool* rendererOpen, bool* environmentOpen) override;
 
 		virtual void OnResize(uint32_t width, uint32_t height) override;
+
+		virtual void SetHiZOcclusion(bool enabled) override;
 	
 	private:
 		void SetupLights();
@@ -71,6 +75,35 @@ namespace Syndra {
 			glm::vec4 color;
 		};
 
+		//Coarsest Hi-Z level of the depth pre-pass, read back for the CPU occlusion tests
+		struct HiZReadback
+		{
+			glm::mat4 viewProjection;
+			uint32_t depthWidth = 0, depthHeight = 0;
+			uint32_t level = 0, width = 0, height = 0;
+			uint64_t frame = 0;
+			std::vector<float> depths;
+			bool valid = false;
+		};
+
+		//A copy of the coarsest Hi-Z level in flight to the CPU, read once its fence has signaled
+		struct HiZReadbackSlot
+		{
+			uint32_t buffer = 0, bufferSize = 0;
+			void* fence = nullptr; //GLsync, null while the slot is free
+			HiZReadback info; //everything but the depths
+		};
+
+		static constexpr uint32_t HiZReadbackSlotCount = 3;
+
+		struct HiZStats
+		{
+			uint32_t tested = 0, occluded = 0; //occluded items are left to the late test
+			uint64_t occludedTriangles = 0;
+			uint32_t readbackAge = 0; //frames between the tested depth and this frame
+			double buildMs = 0.0, testMs = 0.0;
+		};
+
 		struct RenderData
 		{
 			//Scene object
@@ -93,6 +126,7 @@ namespace Syndra {
 			pointLightData pLights;
 			//Directional light data
 			Ref<UniformBuffer> ShadowBuffer;
+			Ref<UniformBuffer> EnvironmentSHBuffer;
 			glm::mat4 lightProj;
 			glm::mat4 lightView;
 			ShadowData shadowData;
@@ -102,6 +136,22 @@ namespace Syndra {
 			Ref<Texture1D> distributionSampler0, distributionSampler1;
 			//Anti ALiasing
 			bool useFxaa = false;
+			//Occlusion culling of the depth pre-pass and lighting pass
+			bool useOcclusionCulling = false;
+			Ref<OcclusionCuller> occlusionCuller;
+			//Hi-Z occlusion culling against the previous frame's depth pre-pass
+			bool useHiZOcclusion = false;
+			Ref<Shader> hiZShader;
+			uint32_t hiZBuffer = 0, hiZBufferSize = 0;
+			HiZReadbackSlot hiZReadbacks[HiZReadbackSlotCount];
+			uint64_t hiZFrame = 0;
+			HiZReadback hiZ;
+			HiZStats hiZStats;
+			//Occlusion queries of the late test, one per item the Hi-Z culled, and the unit box they draw
+			std::vector<uint32_t> hiZQueries;
+			Ref<VertexArray> boundsVao;
+			//GPU timestamps around every pass
+			Ref<GpuProfiler> gpuProfiler;
 			//Render passes containing respective frameBuffers
 			Ref<RenderPass> depthPass, shadowPass, lightingPass, postProcPass;
 			//Scene quad VBO
@@ -1,6 +1,8 @@
 #include "lpch.h"
 #include "Engine/Renderer/FrameBuffer.h"
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Platform/Null/NullFrameBuffer.h"
 #include "Platform/OpenGL/OpenGLFrameBuffer.h"
 #include "Platform/Vulkan/VulkanFrameBuffer.h"
 
@@ -8,6 +10,7 @@ namespace Syndra {
 
 	Ref<FrameBuffer> FrameBuffer::Create(const FramebufferSpecification& spec)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:
@@ -17,6 +20,8 @@ namespace Syndra {
 			return CreateRef<VulkanFrameBuffer>(spec);
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLFrameBuffer>(spec);
+		case RendererAPI::API::Null:
+			return CreateRef<NullFrameBuffer>(spec);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown API!");
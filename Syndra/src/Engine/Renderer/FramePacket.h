@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Engine/Core/FrameAllocator.h"
+#include "Engine/Renderer/PerspectiveCamera.h"
+#include "Engine/Scene/Components.h"
+
+#include "entt.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Syndra {
+
+	class Scene;
+	class ImGuiDrawSnapshot;
+
+	// A mesh entity as the main thread saw it when the packet was built. The mesh component lives in
+	// the scene's registry; the view keeps that scene alive, and structural registry changes and model
+	// replacements wait for the render thread (see RenderThread::Synchronize). The material is a
+	// snapshot that the main thread never modifies, so panels can keep editing the component's copy.
+	struct RenderItem
+	{
+		entt::entity EntityHandle = entt::null;
+		MeshComponent* Mesh = nullptr;
+		Ref<Material> Material;	// null draws with the pipeline's default material
+		glm::mat4 WorldTransform = glm::mat4(1.0f);
+	};
+
+	// Per-view selections of items (visible, occluders, ...). Frame memory, built and dropped
+	// within the pipeline's Render().
+	using RenderItemList = FrameVector<const RenderItem*>;
+
+	struct RenderLight
+	{
+		LightType Type = LightType::Point;
+		Ref<Light> Light;
+		glm::vec3 Position = glm::vec3(0.0f);	// world translation of the owning entity
+	};
+
+	// Everything a RenderPipeline needs to draw one camera view of a scene.
+	struct SceneRenderView
+	{
+		Ref<Scene> SceneRef;
+		PerspectiveCamera Camera;
+		std::vector<RenderItem> Items;
+		std::vector<RenderLight> Lights;
+	};
+
+	// One frame as built by the main thread. It is not modified after RenderThread::EndFrame()
+	// hands it to the render thread.
+	struct FramePacket
+	{
+		uint64_t FrameIndex = 0;
+		std::vector<SceneRenderView> Views;
+		Ref<ImGuiDrawSnapshot> ImGuiDrawData;
+	};
+
+}
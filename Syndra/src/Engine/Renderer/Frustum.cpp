@@ -0,0 +1,93 @@
+#include "lpch.h"
+#include "Engine/Renderer/Frustum.h"
+
+#include <algorithm>
+
+namespace Syndra {
+
+	namespace {
+
+		enum FrustumPlaneIndex : size_t
+		{
+			Left = 0,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far
+		};
+
+		FrustumPlane NormalizePlane(const glm::vec4& plane)
+		{
+			FrustumPlane result{};
+			const glm::vec3 normal = glm::vec3(plane);
+			const float length = glm::length(normal);
+			if (length <= 1e-6f)
+				return result;
+
+			result.Normal = normal / length;
+			result.Distance = plane.w / length;
+			return result;
+		}
+
+	}
+
+	FrustumPlanes BuildFrustumPlanes(const glm::mat4& viewProjection)
+	{
+		FrustumPlanes planes{};
+
+		planes[FrustumPlaneIndex::Left] = NormalizePlane(glm::vec4(
+			viewProjection[0][3] + viewProjection[0][0],
+			viewProjection[1][3] + viewProjection[1][0],
+			viewProjection[2][3] + viewProjection[2][0],
+			viewProjection[3][3] + viewProjection[3][0]));
+		planes[FrustumPlaneIndex::Right] = NormalizePlane(glm::vec4(
+			viewProjection[0][3] - viewProjection[0][0],
+			viewProjection[1][3] - viewProjection[1][0],
+			viewProjection[2][3] - viewProjection[2][0],
+			viewProjection[3][3] - viewProjection[3][0]));
+		planes[FrustumPlaneIndex::Bottom] = NormalizePlane(glm::vec4(
+			viewProjection[0][3] + viewProjection[0][1],
+			viewProjection[1][3] + viewProjection[1][1],
+			viewProjection[2][3] + viewProjection[2][1],
+			viewProjection[3][3] + viewProjection[3][1]));
+		planes[FrustumPlaneIndex::Top] = NormalizePlane(glm::vec4(
+			viewProjection[0][3] - viewProjection[0][1],
+			viewProjection[1][3] - viewProjection[1][1],
+			viewProjection[2][3] - viewProjection[2][1],
+			viewProjection[3][3] - viewProjection[3][1]));
+		planes[FrustumPlaneIndex::Near] = NormalizePlane(glm::vec4(
+			viewProjection[0][3] + viewProjection[0][2],
+			viewProjection[1][3] + viewProjection[1][2],
+			viewProjection[2][3] + viewProjection[2][2],
+			viewProjection[3][3] + viewProjection[3][2]));
+		planes[FrustumPlaneIndex::Far] = NormalizePlane(glm::vec4(
+			viewProjection[0][3] - viewProjection[0][2],
+			viewProjection[1][3] - viewProjection[1][2],
+			viewProjection[2][3] - viewProjection[2][2],
+			viewProjection[3][3] - viewProjection[3][2]));
+
+		return planes;
+	}
+
+	bool IsSphereInsideFrustum(const FrustumPlanes& planes, const glm::vec3& center, float radius)
+	{
+		for (const auto& plane : planes)
+		{
+			const float distanceToPlane = glm::dot(plane.Normal, center) + plane.Distance;
+			if (distanceToPlane < -radius)
+				return false;
+		}
+
+		return true;
+	}
+
+	float ComputeTransformMaxScale(const glm::mat4& transform)
+	{
+		const glm::vec3 xAxis = glm::vec3(transform[0]);
+		const glm::vec3 yAxis = glm::vec3(transform[1]);
+		const glm::vec3 zAxis = glm::vec3(transform[2]);
+		return std::max({ glm::length(xAxis), glm::length(yAxis), glm::length(zAxis), 1e-4f });
+	}
+
+}
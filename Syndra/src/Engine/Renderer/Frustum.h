@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace Syndra {
+
+	// A point p is inside the plane when dot(Normal, p) + Distance >= 0.
+	struct FrustumPlane
+	{
+		glm::vec3 Normal = glm::vec3(0.0f);
+		float Distance = 0.0f;
+	};
+
+	// Left, right, bottom, top, near, far.
+	using FrustumPlanes = std::array<FrustumPlane, 6>;
+
+	// Extracts normalized planes from an OpenGL-style view projection matrix.
+	FrustumPlanes BuildFrustumPlanes(const glm::mat4& viewProjection);
+	bool IsSphereInsideFrustum(const FrustumPlanes& planes, const glm::vec3& center, float radius);
+	// Largest axis scale of transform, used to grow local bounding spheres into world space.
+	float ComputeTransformMaxScale(const glm::mat4& transform);
+
+}
@@ -0,0 +1,170 @@
+#include "lpch.h"
+#include "Engine/Renderer/GpuProfiler.h"
+
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Platform/Null/NullGpuProfiler.h"
+#include "Platform/OpenGL/OpenGLGpuProfiler.h"
+#include "Platform/Vulkan/VulkanGpuProfiler.h"
+
+#include <algorithm>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr double kNanosecondsToMilliseconds = 1.0e-6;
+
+	}
+
+	Ref<GpuProfiler> GpuProfiler::Create()
+	{
+		RenderThread::Synchronize();
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::Vulkan: return CreateRef<VulkanGpuProfiler>();
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLGpuProfiler>();
+		case RendererAPI::API::Null:    return CreateRef<NullGpuProfiler>();
+		}
+
+		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	void GpuProfiler::BeginFrame()
+	{
+		m_Recording = false;
+		m_Stack.clear();
+		if (!Instrumentor::IsEnabled() || !IsSupported())
+			return;
+
+		if (m_Frames.size() != GetFrameSlotCount())
+			m_Frames.assign(GetFrameSlotCount(), {});
+
+		const uint32_t slot = GetFrameSlot();
+		FrameRecord& frame = m_Frames[slot];
+		if (frame.Pending)
+		{
+			// The queries are still in flight; reusing them would wait for the GPU.
+			if (!ReadTimestamps(slot, frame.QueryCount, m_Timestamps))
+				return;
+			SubmitFrame(frame, m_Timestamps);
+			frame.Pending = false;
+		}
+
+		frame.Scopes.clear();
+		frame.QueryCount = 0;
+		if (!ResetQueries(slot))
+			return;
+		m_Slot = slot;
+		m_Recording = true;
+	}
+
+	void GpuProfiler::EndFrame()
+	{
+		if (!m_Recording)
+			return;
+
+		while (!m_Stack.empty())
+			EndScope();
+
+		FrameRecord& frame = m_Frames[m_Slot];
+		frame.Pending = frame.QueryCount > 0;
+		++m_RecordedFrames;
+		m_Recording = false;
+	}
+
+	void GpuProfiler::BeginScope(const char* name)
+	{
+		if (!m_Recording)
+			return;
+
+		FrameRecord& frame = m_Frames[m_Slot];
+		if (frame.Scopes.size() >= MaxScopesPerFrame)
+		{
+			m_Stack.push_back(-1);
+			return;
+		}
+
+		ScopeRecord scope;
+		scope.Name = name ? name : "Unnamed";
+		scope.Parent = m_Stack.empty() ? -1 : m_Stack.back();
+		scope.BeginQuery = frame.QueryCount++;
+		WriteTimestamp(m_Slot, scope.BeginQuery);
+		m_Stack.push_back(static_cast<int32_t>(frame.Scopes.size()));
+		frame.Scopes.push_back(scope);
+	}
+
+	void GpuProfiler::EndScope()
+	{
+		if (!m_Recording || m_Stack.empty())
+			return;
+
+		const int32_t index = m_Stack.back();
+		m_Stack.pop_back();
+		if (index < 0)
+			return;
+
+		FrameRecord& frame = m_Frames[m_Slot];
+		ScopeRecord& scope = frame.Scopes[static_cast<size_t>(index)];
+		scope.EndQuery = frame.QueryCount++;
+		WriteTimestamp(m_Slot, scope.EndQuery);
+	}
+
+	void GpuProfiler::SubmitFrame(const FrameRecord& frame, const std::vector<uint64_t>& timestampsNs)
+	{
+		if (frame.Scopes.empty() || timestampsNs.size() < frame.QueryCount)
+			return;
+
+		auto scopeTimeMs = [&](const ScopeRecord& scope)
+		{
+			const uint64_t begin = timestampsNs[scope.BeginQuery];
+			const uint64_t end = timestampsNs[scope.EndQuery];
+			return end > begin ? static_cast<double>(end - begin) * kNanosecondsToMilliseconds : 0.0;
+		};
+
+		// Scopes are recorded parent first, so every child comes after its parent.
+		auto buildNode = [&](auto&& self, int32_t parent, CpuProfileNode& node) -> void
+		{
+			double childTimeMs = 0.0;
+			for (size_t i = 0; i < frame.Scopes.size(); ++i)
+			{
+				const ScopeRecord& scope = frame.Scopes[i];
+				if (scope.Parent != parent)
+					continue;
+
+				CpuProfileNode child;
+				child.Name = scope.Name;
+				child.TotalTimeMs = scopeTimeMs(scope);
+				child.CallCount = 1;
+				self(self, static_cast<int32_t>(i), child);
+				childTimeMs += child.TotalTimeMs;
+				node.Children.push_back(std::move(child));
+			}
+			node.SelfTimeMs = std::max(0.0, node.TotalTimeMs - childTimeMs);
+		};
+
+		// The root spans the frame's passes, so the gaps between them show up as its self time.
+		uint64_t frameBegin = UINT64_MAX;
+		uint64_t frameEnd = 0;
+		for (const ScopeRecord& scope : frame.Scopes)
+		{
+			frameBegin = std::min(frameBegin, timestampsNs[scope.BeginQuery]);
+			frameEnd = std::max(frameEnd, timestampsNs[scope.EndQuery]);
+		}
+
+		CpuProfileNode root;
+		root.Name = "GPU";
+		root.TotalTimeMs = frameEnd > frameBegin ? static_cast<double>(frameEnd - frameBegin) * kNanosecondsToMilliseconds : 0.0;
+		root.CallCount = 1;
+		buildNode(buildNode, -1, root);
+		PublishFrame(std::move(root));
+	}
+
+	void GpuProfiler::PublishFrame(CpuProfileNode gpuFrame)
+	{
+		Instrumentor::Get().SubmitGpuFrame(std::move(gpuFrame));
+	}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+#include "Engine/Core/Instrument.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Syndra {
+
+	// Measures render passes on the GPU with timestamp queries. A frame's queries are resolved when
+	// its slot comes around again, a few frames later, and only once the GPU has finished them: a
+	// frame that is still in flight skips profiling instead of stalling. Resolved frames are handed
+	// to the Instrumentor as a "GPU" tree, shown next to the CPU scopes.
+	//
+	// Scopes nest like CPU scopes and are only recorded while Instrumentor::IsEnabled().
+	class GpuProfiler
+	{
+	public:
+		static constexpr uint32_t MaxScopesPerFrame = 64;
+		static constexpr uint32_t MaxQueriesPerFrame = MaxScopesPerFrame * 2;
+
+		virtual ~GpuProfiler() = default;
+
+		// Call outside of any pass, before the first scope of the frame.
+		void BeginFrame();
+		void EndFrame();
+		// name has to outlive the profiler, like the names of CPU scopes.
+		void BeginScope(const char* name);
+		void EndScope();
+
+		// False when the device has no usable timestamps; every call is then a no-op.
+		virtual bool IsSupported() const = 0;
+
+		static Ref<GpuProfiler> Create();
+	protected:
+		// Slot the next frame records into, below GetFrameSlotCount().
+		virtual uint32_t GetFrameSlot() const = 0;
+		virtual uint32_t GetFrameSlotCount() const = 0;
+		// Reads the first queryCount timestamps of slot in nanoseconds, without waiting. Returns false
+		// when the GPU has not written them yet.
+		virtual bool ReadTimestamps(uint32_t slot, uint32_t queryCount, std::vector<uint64_t>& timestampsNs) = 0;
+		// Prepares the queries of slot for a new frame; the frame is not profiled when this fails.
+		virtual bool ResetQueries(uint32_t slot) { (void)slot; return true; }
+		virtual void WriteTimestamp(uint32_t slot, uint32_t query) = 0;
+
+		// Receives the pass tree of every resolved frame; forwards it to the Instrumentor by default.
+		virtual void PublishFrame(CpuProfileNode gpuFrame);
+
+		// Frames recorded so far, for backends that pick their slots in a ring.
+		uint64_t GetRecordedFrameCount() const { return m_RecordedFrames; }
+	private:
+		struct ScopeRecord
+		{
+			const char* Name = nullptr;
+			int32_t Parent = -1;
+			uint32_t BeginQuery = 0;
+			uint32_t EndQuery = 0;
+		};
+
+		struct FrameRecord
+		{
+			std::vector<ScopeRecord> Scopes;
+			uint32_t QueryCount = 0;
+			bool Pending = false;
+		};
+
+		void SubmitFrame(const FrameRecord& frame, const std::vector<uint64_t>& timestampsNs);
+	private:
+		std::vector<FrameRecord> m_Frames;
+		// Open scopes of the recording frame, -1 for the ones past MaxScopesPerFrame.
+		std::vector<int32_t> m_Stack;
+		std::vector<uint64_t> m_Timestamps;
+		uint32_t m_Slot = 0;
+		uint64_t m_RecordedFrames = 0;
+		bool m_Recording = false;
+	};
+
+	class GpuProfileScope
+	{
+	public:
+		GpuProfileScope(const Ref<GpuProfiler>& profiler, const char* name)
+			: m_Profiler(profiler.get())
+		{
+			if (m_Profiler)
+				m_Profiler->BeginScope(name);
+		}
+
+		~GpuProfileScope()
+		{
+			if (m_Profiler)
+				m_Profiler->EndScope();
+		}
+
+		GpuProfileScope(const GpuProfileScope&) = delete;
+		GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+	private:
+		GpuProfiler* m_Profiler;
+	};
+
+}
+
+#if SN_PROFILE
+#define SN_GPU_PROFILE_SCOPE_LINE2(profiler, name, line) ::Syndra::GpuProfileScope gpuScope##line(profiler, name)
+#define SN_GPU_PROFILE_SCOPE_LINE(profiler, name, line) SN_GPU_PROFILE_SCOPE_LINE2(profiler, name, line)
+#define SN_GPU_PROFILE_SCOPE(profiler, name) SN_GPU_PROFILE_SCOPE_LINE(profiler, name, __LINE__)
+#else
+#define SN_GPU_PROFILE_SCOPE(profiler, name)
+#endif
@@ -16,6 +16,9 @@ namespace Syndra{
 			EndFrame();
 		}
 		virtual void SetVSync(bool) {}
+		// Binds the context to / unbinds it from the calling thread, for APIs that have that notion.
+		virtual void MakeCurrent() {}
+		virtual void ReleaseCurrent() {}
 	};
 
 }
@@ -4,6 +4,24 @@
 
 namespace Syndra {
 
+	namespace {
+
+		// Bind() runs per draw; the names are built once instead of as a std::string per call.
+		const std::string kHasMapUniforms[] = {
+			"push.HasAlbedoMap",
+			"push.HasMetallicMap",
+			"push.HasNormalMap",
+			"push.HasRoughnessMap",
+			"push.HasAOMap"
+		};
+		const std::string kMetallicFactorUniform = "push.material.MetallicFactor";
+		const std::string kRoughnessFactorUniform = "push.material.RoughnessFactor";
+		const std::string kAOUniform = "push.material.AO";
+		const std::string kColorUniform = "push.material.color";
+		const std::string kTilingUniform = "push.tiling";
+
+	}
+
 	Material::Material(Ref<Shader>& shader)
 	{
 		m_Shader = shader;
@@ -90,31 +108,15 @@ namespace Syndra {
 			auto& texture = m_Textures[sampler.binding];
 			if (sampler.isUsed && texture) {
 
-				if (sampler.binding == 0)
-					m_Shader->SetInt("push.HasAlbedoMap", 1);
-				if (sampler.binding == 1)
-					m_Shader->SetInt("push.HasMetallicMap", 1);
-				if (sampler.binding == 2)
-					m_Shader->SetInt("push.HasNormalMap", 1);
-				if (sampler.binding == 3)
-					m_Shader->SetInt("push.HasRoughnessMap", 1);
-				if (sampler.binding == 4)
-					m_Shader->SetInt("push.HasAOMap", 1);
+				if (sampler.binding < std::size(kHasMapUniforms))
+					m_Shader->SetInt(kHasMapUniforms[sampler.binding], 1);
 				texture->Bind(sampler.binding);
 			}
 			else
 			{
 				Texture2D::BindTexture(0, sampler.binding);
-				if (sampler.binding == 0)
-					m_Shader->SetInt("push.HasAlbedoMap", 0);
-				if (sampler.binding == 1)
-					m_Shader->SetInt("push.HasMetallicMap", 0);
-				if (sampler.binding == 2)
-					m_Shader->SetInt("push.HasNormalMap", 0);
-				if (sampler.binding == 3)
-					m_Shader->SetInt("push.HasRoughnessMap", 0);
-				if (sampler.binding == 4)
-					m_Shader->SetInt("push.HasAOMap", 0);
+				if (sampler.binding < std::size(kHasMapUniforms))
+					m_Shader->SetInt(kHasMapUniforms[sampler.binding], 0);
 			}
 		}
 
@@ -140,14 +142,43 @@ namespace Syndra {
 
 		if (hasMaterialConstants || m_PushConstants.empty())
 		{
-			m_Shader->SetFloat("push.material.MetallicFactor", m_Cbuffer.material.MetallicFactor);
-			m_Shader->SetFloat("push.material.RoughnessFactor", m_Cbuffer.material.RoughnessFactor);
-			m_Shader->SetFloat("push.material.AO", m_Cbuffer.material.AO);
-			m_Shader->SetFloat4("push.material.color", m_Cbuffer.material.color);
-			m_Shader->SetFloat("push.tiling", m_Cbuffer.tiling);
+			m_Shader->SetFloat(kMetallicFactorUniform, m_Cbuffer.material.MetallicFactor);
+			m_Shader->SetFloat(kRoughnessFactorUniform, m_Cbuffer.material.RoughnessFactor);
+			m_Shader->SetFloat(kAOUniform, m_Cbuffer.material.AO);
+			m_Shader->SetFloat4(kColorUniform, m_Cbuffer.material.color);
+			m_Shader->SetFloat(kTilingUniform, m_Cbuffer.tiling);
 		}
 	}
 
+	size_t Material::GetBindingHash() const
+	{
+		auto combine = [](size_t& hash, size_t value)
+		{
+			hash ^= (value + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+		};
+
+		size_t hash = std::hash<const void*>{}(m_Shader.get());
+		for (const auto& sampler : m_Samplers)
+		{
+			combine(hash, sampler.binding);
+			combine(hash, sampler.isUsed);
+
+			const auto it = m_Textures.find(sampler.binding);
+			const Texture2D* texture = (it != m_Textures.end()) ? it->second.get() : nullptr;
+			combine(hash, std::hash<const void*>{}(texture));
+			combine(hash, texture ? texture->GetRendererID() : 0);
+		}
+
+		const float constants[] = {
+			m_Cbuffer.material.color.r, m_Cbuffer.material.color.g, m_Cbuffer.material.color.b, m_Cbuffer.material.color.a,
+			m_Cbuffer.material.RoughnessFactor, m_Cbuffer.material.MetallicFactor, m_Cbuffer.material.AO, m_Cbuffer.tiling
+		};
+		for (float constant : constants)
+			combine(hash, std::hash<float>{}(constant));
+
+		return hash;
+	}
+
 	void Material::AddTexture(const Sampler& sampler, Ref<Texture2D>& texture)
 	{
 		m_Textures.insert(std::pair(sampler.binding, texture));
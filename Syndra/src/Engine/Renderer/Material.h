@@ -42,6 +42,9 @@ namespace Syndra {
 		Material(Ref<Shader>& shader);
 
 		void Bind();
+		// Changes whenever Bind() would bind different textures or material constants; lets renderers
+		// that retain resolved draws notice edits made through GetTextures() or Set().
+		size_t GetBindingHash() const;
 
 		std::vector<PushConstant>& GetPushConstants() { return m_PushConstants; }
 		std::vector<Sampler>& GetSamplers() { return m_Samplers; }
@@ -13,6 +13,7 @@ namespace Syndra {
 		this->indices = indices;
 		this->textures = textures;
 		this->materialData = materialData;
+		m_CpuMemory.Set(this->vertices.capacity() * sizeof(Vertex) + this->indices.capacity() * sizeof(unsigned int));
 
 		if (!this->vertices.empty())
 		{
@@ -25,6 +26,22 @@ namespace Syndra {
 			}
 		}
 
+		// Ratio of surface area to UV area, used by texture streaming to estimate texel density on screen.
+		double positionArea = 0.0;
+		double uvArea = 0.0;
+		for (size_t i = 0; i + 2 < this->indices.size(); i += 3)
+		{
+			const Vertex& v0 = this->vertices[this->indices[i]];
+			const Vertex& v1 = this->vertices[this->indices[i + 1]];
+			const Vertex& v2 = this->vertices[this->indices[i + 2]];
+			positionArea += 0.5 * glm::length(glm::cross(v1.Position - v0.Position, v2.Position - v0.Position));
+			const glm::vec2 uv1 = v1.TexCoords - v0.TexCoords;
+			const glm::vec2 uv2 = v2.TexCoords - v0.TexCoords;
+			uvArea += 0.5 * std::abs(uv1.x * uv2.y - uv1.y * uv2.x);
+		}
+		if (uvArea > 0.0)
+			m_WorldUnitsPerUV = static_cast<float>(std::sqrt(positionArea / uvArea));
+
 		setupMesh();
 	}
 
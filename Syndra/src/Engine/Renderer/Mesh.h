@@ -2,6 +2,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/VertexArray.h"
 
@@ -56,6 +57,8 @@ namespace Syndra {
 		const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
 		const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
 		bool HasBounds() const { return !vertices.empty(); }
+		// Average object-space distance covered by one unit of UV, 0 if the mesh has no usable UVs.
+		float GetWorldUnitsPerUV() const { return m_WorldUnitsPerUV; }
 		void BindVertexArray() const { m_VertexArray->Bind(); }
 
 	private:
@@ -64,6 +67,9 @@ namespace Syndra {
 		Ref<IndexBuffer> m_IndexBuffer;
 		glm::vec3 m_BoundsMin = glm::vec3(0.0f);
 		glm::vec3 m_BoundsMax = glm::vec3(0.0f);
+		float m_WorldUnitsPerUV = 0.0f;
+		// The CPU copy of vertices and indices kept for bounds and picking.
+		TrackedMemory m_CpuMemory{ MemoryDomain::Cpu, MemoryCategory::Meshes };
 		void setupMesh();
 	};
 
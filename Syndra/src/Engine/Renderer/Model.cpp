@@ -1,5 +1,6 @@
 #include "lpch.h"
 #include "Engine/Renderer/Model.h"
+#include "Engine/Renderer/TextureLibrary.h"
 
 #include <fastgltf/core.hpp>
 #include <fastgltf/glm_element_traits.hpp>
@@ -117,6 +118,7 @@ namespace Syndra {
 	{
 		meshes.clear();
 		textures_loaded.clear();
+		m_LoadedTextureIndices.clear();
 		syndraTextures.clear();
 		directory.clear();
 		m_Scene = nullptr;
@@ -651,18 +653,12 @@ namespace Syndra {
 		{
 			aiString str;
 			mat->GetTexture(type, i, &str);
-			SN_CORE_TRACE(str.C_Str());
-			bool skip = false;
-			for (unsigned int j = 0; j < textures_loaded.size(); j++)
+			SN_CORE_TRACE_LIMITED("Material texture '{0}'", str.C_Str());
+			if (const auto loadedIt = m_LoadedTextureIndices.find(str.C_Str()); loadedIt != m_LoadedTextureIndices.end())
 			{
-				if (std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
-				{
-					textures.push_back(textures_loaded[j]);
-					skip = true;
-					break;
-				}
+				textures.push_back(textures_loaded[loadedIt->second]);
 			}
-			if (!skip)
+			else
 			{   // if texture hasn't been loaded already, load it
 				texture texture;
 				std::string filename = str.C_Str();
@@ -695,7 +691,7 @@ namespace Syndra {
 				}
 				else
 				{
-					syndraTexture = Texture2D::Create(filename, isColorTexture);
+					syndraTexture = TextureLibrary::Load(filename, isColorTexture);
 				}
 				if (syndraTexture) {
 					syndraTextures.push_back(syndraTexture);
@@ -703,6 +699,7 @@ namespace Syndra {
 					texture.type = typeName;
 					texture.path = str.C_Str();
 					textures.push_back(texture);
+					m_LoadedTextureIndices.emplace(texture.path, textures_loaded.size());
 					textures_loaded.push_back(texture); // add to loaded textures
 				}
 			}
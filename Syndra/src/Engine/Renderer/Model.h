@@ -21,6 +21,7 @@ namespace Syndra {
 
 	private:
 		const aiScene* m_Scene;
+		std::unordered_map<std::string, size_t> m_LoadedTextureIndices;
 		void loadModel(std::string const& path);
 		void loadAssimpModel(std::string const& path);
 		void loadGltfModel(std::string const& path);
@@ -0,0 +1,480 @@
+#include "lpch.h"
+#include "Engine/Renderer/OcclusionCuller.h"
+
+#include "Engine/Core/Instrument.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Renderer/Mesh.h"
+#include "Engine/Renderer/Model.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SN_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Syndra {
+
+	namespace {
+
+		// Clip-space w below which a vertex counts as behind the eye.
+		constexpr float MinClipW = 1e-5f;
+
+		double MillisecondsSince(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		int32_t ClampToPixel(float value, int32_t limit)
+		{
+			return static_cast<int32_t>(std::clamp(value, 0.0f, static_cast<float>(limit)));
+		}
+
+		bool ComputeModelBounds(const Model& model, glm::vec3& outMin, glm::vec3& outMax)
+		{
+			bool hasBounds = false;
+			for (const auto& mesh : model.meshes)
+			{
+				if (!mesh.HasBounds())
+					continue;
+
+				if (!hasBounds)
+				{
+					outMin = mesh.GetBoundsMin();
+					outMax = mesh.GetBoundsMax();
+					hasBounds = true;
+					continue;
+				}
+
+				outMin = glm::min(outMin, mesh.GetBoundsMin());
+				outMax = glm::max(outMax, mesh.GetBoundsMax());
+			}
+
+			return hasBounds;
+		}
+
+	}
+
+	OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+	{
+		m_TilesX = std::max(1u, (width + TileWidth - 1) / TileWidth);
+		m_TilesY = std::max(1u, (height + TileHeight - 1) / TileHeight);
+		m_Width = m_TilesX * TileWidth;
+		m_Height = m_TilesY * TileHeight;
+		m_Depth.assign(static_cast<size_t>(m_Width) * m_Height, 1.0f);
+		m_TileMaxDepth.assign(static_cast<size_t>(m_TilesX) * m_TilesY, 1.0f);
+		m_Bins.resize(m_TileMaxDepth.size());
+	}
+
+	void OcclusionCuller::Begin(const glm::mat4& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		std::fill(m_Depth.begin(), m_Depth.end(), 1.0f);
+		std::fill(m_TileMaxDepth.begin(), m_TileMaxDepth.end(), 1.0f);
+		m_Occluders.clear();
+		m_Rasterized = false;
+		m_Stats = Stats{};
+	}
+
+	void OcclusionCuller::AddOccluder(const glm::mat4& worldTransform, const void* positions, uint32_t positionStride, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+	{
+		if (positions == nullptr || indices == nullptr || vertexCount == 0 || indexCount < 3)
+			return;
+
+		Occluder occluder;
+		occluder.Transform = m_ViewProjection * worldTransform;
+		occluder.Positions = static_cast<const uint8_t*>(positions);
+		occluder.PositionStride = positionStride;
+		occluder.VertexCount = vertexCount;
+		occluder.Indices = indices;
+		occluder.IndexCount = indexCount;
+		m_Occluders.push_back(occluder);
+	}
+
+	void OcclusionCuller::AddOccluder(const glm::mat4& worldTransform, const Mesh& mesh)
+	{
+		static_assert(sizeof(unsigned int) == sizeof(uint32_t), "Mesh indices are passed as 32-bit indices.");
+		if (mesh.vertices.empty())
+			return;
+
+		AddOccluder(
+			worldTransform,
+			&mesh.vertices[0].Position,
+			sizeof(Vertex),
+			static_cast<uint32_t>(mesh.vertices.size()),
+			reinterpret_cast<const uint32_t*>(mesh.indices.data()),
+			static_cast<uint32_t>(mesh.indices.size()));
+	}
+
+	void OcclusionCuller::SelectOccluders(const RenderItemList& items)
+	{
+		SN_PROFILE_SCOPE("OcclusionCuller::SelectOccluders");
+		struct Choice
+		{
+			float Area;
+			const glm::mat4* Transform;
+			const Mesh* Source;
+		};
+
+		FrameVector<Choice> choices;
+		choices.reserve(items.size());
+		const float screenArea = static_cast<float>(m_Width) * static_cast<float>(m_Height);
+		for (const RenderItem* item : items)
+		{
+			if (!item || !item->Mesh)
+				continue;
+
+			for (const auto& mesh : item->Mesh->model.meshes)
+			{
+				if (!mesh.HasBounds() || mesh.indices.size() < 3 || mesh.indices.size() / 3 > m_Settings.MaxOccluderTriangles)
+					continue;
+
+				ScreenBounds bounds;
+				if (!ProjectBounds(mesh.GetBoundsMin(), mesh.GetBoundsMax(), item->WorldTransform, bounds))
+					continue;
+
+				const glm::vec2 screenMin = glm::clamp(bounds.Min, glm::vec2(0.0f), glm::vec2(m_Width, m_Height));
+				const glm::vec2 screenMax = glm::clamp(bounds.Max, glm::vec2(0.0f), glm::vec2(m_Width, m_Height));
+				const float area = (screenMax.x - screenMin.x) * (screenMax.y - screenMin.y) / screenArea;
+				if (area >= m_Settings.MinOccluderArea)
+					choices.push_back({ area, &item->WorldTransform, &mesh });
+			}
+		}
+
+		const size_t count = std::min<size_t>(choices.size(), m_Settings.MaxOccluders);
+		std::partial_sort(choices.begin(), choices.begin() + count, choices.end(), [](const Choice& left, const Choice& right)
+		{
+			return left.Area > right.Area;
+		});
+		for (size_t i = 0; i < count; ++i)
+			AddOccluder(*choices[i].Transform, *choices[i].Source);
+	}
+
+	void OcclusionCuller::Rasterize()
+	{
+		SN_PROFILE_SCOPE("OcclusionCuller::Rasterize");
+		const auto start = std::chrono::steady_clock::now();
+
+		uint32_t triangleCount = 0;
+		for (auto& occluder : m_Occluders)
+		{
+			occluder.FirstTriangle = triangleCount;
+			triangleCount += occluder.IndexCount / 3;
+		}
+		m_Triangles.resize(triangleCount);
+
+		JobSystem::ParallelFor("OcclusionCuller::Setup", static_cast<uint32_t>(m_Occluders.size()), 1, [this](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+				SetupTriangles(m_Occluders[i]);
+		});
+
+		// Binning is cheap next to rasterization and keeps every tile's triangles in submission order.
+		for (auto& bin : m_Bins)
+			bin.clear();
+
+		uint32_t rasterizedTriangles = 0;
+		for (uint32_t index = 0; index < triangleCount; ++index)
+		{
+			const Triangle& triangle = m_Triangles[index];
+			if (triangle.MinX >= triangle.MaxX || triangle.MinY >= triangle.MaxY)
+				continue;
+
+			++rasterizedTriangles;
+			const uint32_t tileX0 = static_cast<uint32_t>(triangle.MinX) / TileWidth;
+			const uint32_t tileX1 = static_cast<uint32_t>(triangle.MaxX - 1) / TileWidth;
+			const uint32_t tileY0 = static_cast<uint32_t>(triangle.MinY) / TileHeight;
+			const uint32_t tileY1 = static_cast<uint32_t>(triangle.MaxY - 1) / TileHeight;
+			for (uint32_t tileY = tileY0; tileY <= tileY1; ++tileY)
+			{
+				for (uint32_t tileX = tileX0; tileX <= tileX1; ++tileX)
+					m_Bins[tileY * m_TilesX + tileX].push_back(index);
+			}
+		}
+
+		JobSystem::ParallelFor("OcclusionCuller::RasterizeTiles", m_TilesX * m_TilesY, 1, [this](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t tile = begin; tile < end; ++tile)
+				RasterizeTile(tile);
+		});
+
+		m_Rasterized = true;
+		m_Stats.Occluders = static_cast<uint32_t>(m_Occluders.size());
+		m_Stats.OccluderTriangles = rasterizedTriangles;
+		m_Stats.RasterMs = MillisecondsSince(start);
+	}
+
+	void OcclusionCuller::SetupTriangles(const Occluder& occluder)
+	{
+		std::vector<glm::vec4> clip(occluder.VertexCount);
+		for (uint32_t i = 0; i < occluder.VertexCount; ++i)
+		{
+			const glm::vec3& position = *reinterpret_cast<const glm::vec3*>(occluder.Positions + static_cast<size_t>(i) * occluder.PositionStride);
+			clip[i] = occluder.Transform * glm::vec4(position, 1.0f);
+		}
+
+		const float width = static_cast<float>(m_Width);
+		const float height = static_cast<float>(m_Height);
+		const uint32_t triangleCount = occluder.IndexCount / 3;
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			Triangle& triangle = m_Triangles[occluder.FirstTriangle + i];
+			triangle.MinX = triangle.MaxX = 0;
+			triangle.MinY = triangle.MaxY = 0;
+
+			glm::vec3 screen[3];
+			bool valid = true;
+			for (uint32_t corner = 0; corner < 3 && valid; ++corner)
+			{
+				const uint32_t index = occluder.Indices[i * 3 + corner];
+				if (index >= occluder.VertexCount)
+				{
+					valid = false;
+					break;
+				}
+
+				// Clipping would only add occluder area near the camera; dropping the triangle is conservative.
+				const glm::vec4& position = clip[index];
+				if (position.w < MinClipW || position.z < -position.w)
+				{
+					valid = false;
+					break;
+				}
+
+				const glm::vec3 ndc = glm::vec3(position) / position.w;
+				screen[corner] = glm::vec3((ndc.x * 0.5f + 0.5f) * width, (ndc.y * 0.5f + 0.5f) * height, ndc.z * 0.5f + 0.5f);
+			}
+			if (!valid)
+				continue;
+
+			float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) - (screen[1].y - screen[0].y) * (screen[2].x - screen[0].x);
+			if (std::abs(area) < 1e-8f)
+				continue;
+			if (area < 0.0f)
+			{
+				std::swap(screen[1], screen[2]);
+				area = -area;
+			}
+
+			const glm::vec3 screenMin = glm::min(screen[0], glm::min(screen[1], screen[2]));
+			const glm::vec3 screenMax = glm::max(screen[0], glm::max(screen[1], screen[2]));
+			triangle.MinX = ClampToPixel(std::floor(screenMin.x), static_cast<int32_t>(m_Width));
+			triangle.MinY = ClampToPixel(std::floor(screenMin.y), static_cast<int32_t>(m_Height));
+			triangle.MaxX = ClampToPixel(std::ceil(screenMax.x), static_cast<int32_t>(m_Width));
+			triangle.MaxY = ClampToPixel(std::ceil(screenMax.y), static_cast<int32_t>(m_Height));
+
+			for (uint32_t edge = 0; edge < 3; ++edge)
+			{
+				const glm::vec3& from = screen[edge];
+				const glm::vec3& to = screen[(edge + 1) % 3];
+				triangle.EdgeA[edge] = from.y - to.y;
+				triangle.EdgeB[edge] = to.x - from.x;
+				triangle.EdgeC[edge] = -(triangle.EdgeA[edge] * from.x + triangle.EdgeB[edge] * from.y);
+			}
+
+			// NDC depth is affine in screen space, so the depth of a pixel is a plane equation.
+			const float deltaX1 = screen[1].x - screen[0].x;
+			const float deltaY1 = screen[1].y - screen[0].y;
+			const float deltaX2 = screen[2].x - screen[0].x;
+			const float deltaY2 = screen[2].y - screen[0].y;
+			const float deltaZ1 = screen[1].z - screen[0].z;
+			const float deltaZ2 = screen[2].z - screen[0].z;
+			triangle.DepthX = (deltaZ1 * deltaY2 - deltaZ2 * deltaY1) / area;
+			triangle.DepthY = (deltaZ2 * deltaX1 - deltaZ1 * deltaX2) / area;
+			triangle.DepthC = screen[0].z - triangle.DepthX * screen[0].x - triangle.DepthY * screen[0].y;
+		}
+	}
+
+	void OcclusionCuller::RasterizeTile(uint32_t tile)
+	{
+		const int32_t tileX0 = static_cast<int32_t>((tile % m_TilesX) * TileWidth);
+		const int32_t tileY0 = static_cast<int32_t>((tile / m_TilesX) * TileHeight);
+		const int32_t tileX1 = tileX0 + static_cast<int32_t>(TileWidth);
+		const int32_t tileY1 = tileY0 + static_cast<int32_t>(TileHeight);
+
+		for (const uint32_t index : m_Bins[tile])
+		{
+			const Triangle& triangle = m_Triangles[index];
+			// Tiles start on a multiple of 4, so the aligned groups of 4 pixels never leave the tile.
+			const int32_t x0 = std::max(triangle.MinX, tileX0) & ~3;
+			const int32_t x1 = std::min(triangle.MaxX, tileX1);
+			const int32_t y0 = std::max(triangle.MinY, tileY0);
+			const int32_t y1 = std::min(triangle.MaxY, tileY1);
+
+#if defined(SN_OCCLUSION_SSE2)
+			const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 edgeA0 = _mm_set1_ps(triangle.EdgeA[0]);
+			const __m128 edgeA1 = _mm_set1_ps(triangle.EdgeA[1]);
+			const __m128 edgeA2 = _mm_set1_ps(triangle.EdgeA[2]);
+			const __m128 depthX = _mm_set1_ps(triangle.DepthX);
+			for (int32_t y = y0; y < y1; ++y)
+			{
+				const float pixelY = static_cast<float>(y) + 0.5f;
+				const __m128 edgeRow0 = _mm_set1_ps(triangle.EdgeB[0] * pixelY + triangle.EdgeC[0]);
+				const __m128 edgeRow1 = _mm_set1_ps(triangle.EdgeB[1] * pixelY + triangle.EdgeC[1]);
+				const __m128 edgeRow2 = _mm_set1_ps(triangle.EdgeB[2] * pixelY + triangle.EdgeC[2]);
+				const __m128 depthRow = _mm_set1_ps(triangle.DepthY * pixelY + triangle.DepthC);
+				float* row = &m_Depth[static_cast<size_t>(y) * m_Width];
+				for (int32_t x = x0; x < x1; x += 4)
+				{
+					const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), pixelOffsets);
+					const __m128 edge0 = _mm_add_ps(_mm_mul_ps(edgeA0, pixelX), edgeRow0);
+					const __m128 edge1 = _mm_add_ps(_mm_mul_ps(edgeA1, pixelX), edgeRow1);
+					const __m128 edge2 = _mm_add_ps(_mm_mul_ps(edgeA2, pixelX), edgeRow2);
+					const __m128 inside = _mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_and_ps(_mm_cmpge_ps(edge1, zero), _mm_cmpge_ps(edge2, zero)));
+					if (_mm_movemask_ps(inside) == 0)
+						continue;
+
+					const __m128 depth = _mm_add_ps(_mm_mul_ps(depthX, pixelX), depthRow);
+					const __m128 stored = _mm_loadu_ps(row + x);
+					const __m128 nearest = _mm_min_ps(stored, depth);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, stored)));
+				}
+			}
+#else
+			for (int32_t y = y0; y < y1; ++y)
+			{
+				const float pixelY = static_cast<float>(y) + 0.5f;
+				float* row = &m_Depth[static_cast<size_t>(y) * m_Width];
+				for (int32_t x = x0; x < x1; ++x)
+				{
+					const float pixelX = static_cast<float>(x) + 0.5f;
+					bool inside = true;
+					for (uint32_t edge = 0; edge < 3 && inside; ++edge)
+						inside = triangle.EdgeA[edge] * pixelX + triangle.EdgeB[edge] * pixelY + triangle.EdgeC[edge] >= 0.0f;
+					if (inside)
+						row[x] = std::min(row[x], triangle.DepthX * pixelX + triangle.DepthY * pixelY + triangle.DepthC);
+				}
+			}
+#endif
+		}
+
+		float farthest = 0.0f;
+		for (int32_t y = tileY0; y < tileY1; ++y)
+		{
+			const float* row = &m_Depth[static_cast<size_t>(y) * m_Width];
+			for (int32_t x = tileX0; x < tileX1; ++x)
+				farthest = std::max(farthest, row[x]);
+		}
+		m_TileMaxDepth[tile] = farthest;
+	}
+
+	bool OcclusionCuller::ProjectBounds(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& worldTransform, ScreenBounds& outBounds) const
+	{
+		const glm::mat4 transform = m_ViewProjection * worldTransform;
+		outBounds.Min = glm::vec2(std::numeric_limits<float>::max());
+		outBounds.Max = glm::vec2(std::numeric_limits<float>::lowest());
+		outBounds.NearestDepth = std::numeric_limits<float>::max();
+
+		for (uint32_t corner = 0; corner < 8; ++corner)
+		{
+			const glm::vec3 position(
+				(corner & 1) ? boundsMax.x : boundsMin.x,
+				(corner & 2) ? boundsMax.y : boundsMin.y,
+				(corner & 4) ? boundsMax.z : boundsMin.z);
+			const glm::vec4 clip = transform * glm::vec4(position, 1.0f);
+			if (clip.w < MinClipW || clip.z < -clip.w)
+				return false;
+
+			const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			const glm::vec2 screen((ndc.x * 0.5f + 0.5f) * static_cast<float>(m_Width), (ndc.y * 0.5f + 0.5f) * static_cast<float>(m_Height));
+			outBounds.Min = glm::min(outBounds.Min, screen);
+			outBounds.Max = glm::max(outBounds.Max, screen);
+			outBounds.NearestDepth = std::min(outBounds.NearestDepth, ndc.z * 0.5f + 0.5f);
+		}
+
+		return true;
+	}
+
+	bool OcclusionCuller::IsOccluded(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& worldTransform) const
+	{
+		if (!m_Rasterized)
+			return false;
+
+		ScreenBounds bounds;
+		if (!ProjectBounds(boundsMin, boundsMax, worldTransform, bounds))
+			return false;
+
+		// One pixel of slack covers the rasterizer sampling only pixel centers.
+		const int32_t x0 = ClampToPixel(std::floor(bounds.Min.x) - 1.0f, static_cast<int32_t>(m_Width));
+		const int32_t y0 = ClampToPixel(std::floor(bounds.Min.y) - 1.0f, static_cast<int32_t>(m_Height));
+		const int32_t x1 = ClampToPixel(std::ceil(bounds.Max.x) + 1.0f, static_cast<int32_t>(m_Width));
+		const int32_t y1 = ClampToPixel(std::ceil(bounds.Max.y) + 1.0f, static_cast<int32_t>(m_Height));
+		if (x0 >= x1 || y0 >= y1)
+			return false;
+
+		for (int32_t tileY = y0 / static_cast<int32_t>(TileHeight); tileY <= (y1 - 1) / static_cast<int32_t>(TileHeight); ++tileY)
+		{
+			for (int32_t tileX = x0 / static_cast<int32_t>(TileWidth); tileX <= (x1 - 1) / static_cast<int32_t>(TileWidth); ++tileX)
+			{
+				if (bounds.NearestDepth > m_TileMaxDepth[tileY * m_TilesX + tileX])
+					continue;
+
+				const int32_t pixelX0 = std::max(x0, tileX * static_cast<int32_t>(TileWidth));
+				const int32_t pixelX1 = std::min(x1, (tileX + 1) * static_cast<int32_t>(TileWidth));
+				const int32_t pixelY0 = std::max(y0, tileY * static_cast<int32_t>(TileHeight));
+				const int32_t pixelY1 = std::min(y1, (tileY + 1) * static_cast<int32_t>(TileHeight));
+				for (int32_t y = pixelY0; y < pixelY1; ++y)
+				{
+					const float* row = &m_Depth[static_cast<size_t>(y) * m_Width];
+					for (int32_t x = pixelX0; x < pixelX1; ++x)
+					{
+						if (row[x] >= bounds.NearestDepth)
+							return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void OcclusionCuller::Cull(RenderItemList& items)
+	{
+		SN_PROFILE_SCOPE("OcclusionCuller::Cull");
+		const auto start = std::chrono::steady_clock::now();
+		m_Stats.Tested = static_cast<uint32_t>(items.size());
+		m_Stats.Occluded = 0;
+		if (!m_Rasterized || m_Stats.OccluderTriangles == 0 || items.empty())
+		{
+			m_Stats.TestMs = MillisecondsSince(start);
+			return;
+		}
+
+		FrameVector<uint8_t> occluded(items.size(), 0);
+		JobSystem::ParallelFor("OcclusionCuller::Test", static_cast<uint32_t>(items.size()), 64, [this, &items, &occluded](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				const RenderItem* item = items[i];
+				glm::vec3 boundsMin;
+				glm::vec3 boundsMax;
+				if (item && item->Mesh && ComputeModelBounds(item->Mesh->model, boundsMin, boundsMax))
+					occluded[i] = IsOccluded(boundsMin, boundsMax, item->WorldTransform) ? 1 : 0;
+			}
+		});
+
+		size_t kept = 0;
+		for (size_t i = 0; i < items.size(); ++i)
+		{
+			if (!occluded[i])
+				items[kept++] = items[i];
+		}
+		m_Stats.Occluded = static_cast<uint32_t>(items.size() - kept);
+		items.resize(kept);
+		m_Stats.TestMs = MillisecondsSince(start);
+	}
+
+	void OcclusionCuller::Cull(const glm::mat4& viewProjection, const RenderItemList& occluders, RenderItemList& items)
+	{
+		Begin(viewProjection);
+		SelectOccluders(occluders);
+		Rasterize();
+		Cull(items);
+	}
+
+}
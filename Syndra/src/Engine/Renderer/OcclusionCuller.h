@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Engine/Renderer/FramePacket.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Syndra {
+
+	class Mesh;
+
+	// Software occlusion culling for one camera view. A few large occluders are rasterized into a
+	// small depth buffer split into tiles, each tile on its own job and with an SSE inner loop where
+	// available, and every tile keeps the farthest depth it holds. A candidate is occluded when its
+	// screen-space bounding box lies behind that buffer: tiles whose farthest depth is nearer than the
+	// box's nearest depth reject it without touching pixels, the rest are checked per pixel.
+	//
+	// Everything runs on the CPU, so the culler needs no graphics context. Depth follows the OpenGL
+	// clip conventions of PerspectiveCamera (0 near, 1 far after the viewport transform).
+	class OcclusionCuller
+	{
+	public:
+		static constexpr uint32_t TileWidth = 32;
+		static constexpr uint32_t TileHeight = 16;
+
+		struct Settings
+		{
+			uint32_t MaxOccluders = 24;
+			uint32_t MaxOccluderTriangles = 4096;	// meshes with more triangles are never occluders
+			float MinOccluderArea = 0.02f;			// screen fraction covered by an occluder's bounding box
+		};
+
+		struct Stats
+		{
+			uint32_t Occluders = 0;
+			uint32_t OccluderTriangles = 0;
+			uint32_t Tested = 0;
+			uint32_t Occluded = 0;
+			double RasterMs = 0.0;
+			double TestMs = 0.0;
+		};
+
+		// The resolution is rounded up to whole tiles.
+		OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+		// Clears the depth buffer and the occluders for a new view.
+		void Begin(const glm::mat4& viewProjection);
+		// positions points at the first vertex position, positionStride bytes apart. The data must
+		// stay alive until Rasterize() returns.
+		void AddOccluder(const glm::mat4& worldTransform, const void* positions, uint32_t positionStride, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+		void AddOccluder(const glm::mat4& worldTransform, const Mesh& mesh);
+		// Adds the meshes of items covering the most screen area as occluders, within the settings' budget.
+		void SelectOccluders(const RenderItemList& items);
+		void Rasterize();
+
+		// True when the box (in the space of worldTransform) is hidden behind the rasterized occluders.
+		// Boxes crossing the near plane or outside the screen are never occluded.
+		bool IsOccluded(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& worldTransform) const;
+		// Removes the occluded items, keeping the order of the rest. Tests run in parallel.
+		void Cull(RenderItemList& items);
+		// Begin, SelectOccluders(occluders), Rasterize and Cull(items) in one call. occluders may be items.
+		void Cull(const glm::mat4& viewProjection, const RenderItemList& occluders, RenderItemList& items);
+
+		float GetDepth(uint32_t x, uint32_t y) const { return m_Depth[y * m_Width + x]; }
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+
+		Settings& GetSettings() { return m_Settings; }
+		const Stats& GetStats() const { return m_Stats; }
+
+	private:
+		struct Occluder
+		{
+			glm::mat4 Transform = glm::mat4(1.0f);	// view-projection * world
+			const uint8_t* Positions = nullptr;
+			uint32_t PositionStride = 0;
+			uint32_t VertexCount = 0;
+			const uint32_t* Indices = nullptr;
+			uint32_t IndexCount = 0;
+			uint32_t FirstTriangle = 0;
+		};
+
+		// Edge functions (A * x + B * y + C, positive inside) and depth plane of a screen-space
+		// triangle, with its pixel bounds. Empty bounds mark triangles that were rejected.
+		struct Triangle
+		{
+			float EdgeA[3];
+			float EdgeB[3];
+			float EdgeC[3];
+			float DepthX, DepthY, DepthC;
+			int32_t MinX, MinY, MaxX, MaxY;	// inclusive min, exclusive max
+		};
+
+		struct ScreenBounds
+		{
+			glm::vec2 Min;
+			glm::vec2 Max;
+			float NearestDepth;
+		};
+
+		bool ProjectBounds(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& worldTransform, ScreenBounds& outBounds) const;
+		void SetupTriangles(const Occluder& occluder);
+		void RasterizeTile(uint32_t tile);
+
+	private:
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint32_t m_TilesX = 0;
+		uint32_t m_TilesY = 0;
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		std::vector<float> m_Depth;
+		std::vector<float> m_TileMaxDepth;
+		std::vector<Occluder> m_Occluders;
+		std::vector<Triangle> m_Triangles;
+		std::vector<std::vector<uint32_t>> m_Bins;
+		bool m_Rasterized = false;
+		Settings m_Settings;
+		Stats m_Stats;
+	};
+
+}
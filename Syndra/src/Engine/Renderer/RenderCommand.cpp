@@ -2,6 +2,7 @@
 
 #include "Engine/Renderer/RenderCommand.h"
 
+#include "Platform/Null/NullRendererAPI.h"
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
 #include "Platform/Vulkan/VulkanRendererAPI.h"
 
@@ -27,6 +28,8 @@ namespace {
 			return std::make_unique<Syndra::VulkanRendererAPI>();
 		case Syndra::RendererAPI::API::OpenGL:
 			return std::make_unique<Syndra::OpenGLRendererAPI>();
+		case Syndra::RendererAPI::API::Null:
+			return std::make_unique<Syndra::NullRendererAPI>();
 		case Syndra::RendererAPI::API::NONE:
 		default:
 			return nullptr;
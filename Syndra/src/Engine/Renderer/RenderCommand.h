@@ -1,6 +1,8 @@
 #pragma once
 #include "Engine/Renderer/RendererAPI.h"
 
+#include <atomic>
+
 namespace Syndra {
 
 	class RenderCommand
@@ -28,9 +30,15 @@ namespace Syndra {
 
 		static void DrawIndexed(const Ref<VertexArray>& vertexArray)
 		{
+			s_DrawCount.fetch_add(1, std::memory_order_relaxed);
 			GetRendererAPI().DrawIndexed(vertexArray);
 		}
 
+		// DrawIndexed() calls since the last reset, on any backend. GPU-driven draws that bypass it
+		// show up in the backend's own statistics (VulkanRendererAPI::GetRecordingStats()).
+		static uint32_t GetDrawCount() { return s_DrawCount.load(std::memory_order_relaxed); }
+		static void ResetDrawCount() { s_DrawCount.store(0, std::memory_order_relaxed); }
+
 		static void SetState(RenderState stateID, bool on)
 		{
 			GetRendererAPI().SetState(stateID, on);
@@ -51,9 +59,16 @@ namespace Syndra {
 			return GetRendererAPI().GetRendererInfo();
 		}
 
+		static bool GetMemoryInfo(GPUMemoryInfo& outInfo)
+		{
+			return GetRendererAPI().GetMemoryInfo(outInfo);
+		}
+
 		static void Shutdown();
 	private:
 		static RendererAPI& GetRendererAPI();
 
+		inline static std::atomic<uint32_t> s_DrawCount{ 0 };
+
 	};
 }
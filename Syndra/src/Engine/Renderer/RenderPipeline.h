@@ -1,5 +1,6 @@
 #pragma once
 #include "Engine/Renderer/PerspectiveCamera.h"
+#include "Engine/Renderer/FramePacket.h"
 #include "Engine/Scene/Components.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Engine/Renderer/FrameBuffer.h"
@@ -29,8 +30,8 @@ namespace Syndra {
 		// Initializing Render Pipeline (scene is required to render mesh entities later)
 		virtual void Init(const Ref<Scene>& scene, const ShaderLibrary& shaders, const Ref<Environment>& env) = 0;
 
-		// Rendering the scene
-		virtual void Render() = 0;
+		// Rendering the scene view built by SceneRenderer (may run on the render thread)
+		virtual void Render(const SceneRenderView& view) = 0;
 
 		// Lighting(in deferred rendering), Post processing and etc.
 		virtual void End() = 0;
@@ -39,7 +40,7 @@ namespace Syndra {
 		virtual void ShutDown() = 0;
 
 		// Updating all the lights and their respective shadow maps
-		virtual void UpdateLights() = 0;
+		virtual void UpdateLights(const SceneRenderView& view) = 0;
 
 		// Final colored texture ID required by ImGui
 		virtual uint32_t GetFinalTextureID(int index) = 0;
@@ -55,6 +56,9 @@ namespace Syndra {
 	
 		// UI related to the render pipeline debuging (e.g. GBuffer)
 		virtual void OnImGuiRender(bool* rendererOpen, bool* environmentOpen) = 0;
+
+		// Hi-Z occlusion culling of the camera view, for pipelines that have it
+		virtual void SetHiZOcclusion(bool enabled) { (void)enabled; }
 		
 	};
 	
@@ -0,0 +1,298 @@
+#include "lpch.h"
+#include "Engine/Renderer/RenderThread.h"
+
+#include "Engine/Core/Instrument.h"
+#include "Engine/Core/Window.h"
+#include "Engine/Renderer/FramePacket.h"
+#include "Engine/Renderer/Renderer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+	using Clock = std::chrono::steady_clock;
+
+	double ToMilliseconds(Clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	struct RenderThreadData
+	{
+		Syndra::Window* TargetWindow = nullptr;
+		Syndra::RenderThread::ExecuteFunction Execute;
+		std::thread::id MainThreadID;
+
+		uint32_t Latency = 0;
+		uint32_t RequestedLatency = 0;
+		std::atomic<bool> Threaded{ false };
+		std::thread Thread;
+		std::thread::id RenderThreadID;
+
+		// Shared with the render thread, guarded by Mutex.
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		Syndra::Scope<Syndra::FramePacket> Pending;
+		bool Busy = false;
+		bool Stop = false;
+		bool ReleaseRequested = false;
+		Clock::time_point RenderStart;
+		Clock::time_point RenderEnd;
+
+		// Main thread only.
+		Syndra::Scope<Syndra::FramePacket> Current;
+		uint64_t FrameIndex = 0;
+		bool MainOwnsContext = true;
+		Clock::time_point FrameStart;
+		double FrameWaitMs = 0.0;
+		uint32_t FrameSynchronizations = 0;
+		Syndra::RenderThreadStats Stats;
+	};
+
+	RenderThreadData& GetData()
+	{
+		static RenderThreadData s_Data;
+		return s_Data;
+	}
+
+	void RenderLoop()
+	{
+		auto& data = GetData();
+		Syndra::Instrumentor::Get().SetThreadName("Render Thread");
+		bool ownsContext = false;
+
+		std::unique_lock<std::mutex> lock(data.Mutex);
+		while (true)
+		{
+			data.Condition.wait(lock, [&data]() { return data.Pending || data.ReleaseRequested || data.Stop; });
+
+			// A pending packet is always drawn before a release or stop request is honoured.
+			if (data.Pending)
+			{
+				Syndra::Scope<Syndra::FramePacket> packet = std::move(data.Pending);
+				data.Busy = true;
+				lock.unlock();
+
+				if (!ownsContext)
+				{
+					data.TargetWindow->MakeContextCurrent();
+					ownsContext = true;
+				}
+
+				const Clock::time_point start = Clock::now();
+				{
+					SN_PROFILE_CATEGORY_SCOPE(SN_PROFILE_CATEGORY_RENDERER, "RenderThread::Execute");
+					data.Execute(*packet);
+					// Dropped here so whatever the packet kept alive is destroyed with the context current.
+					packet.reset();
+				}
+				const Clock::time_point end = Clock::now();
+
+				lock.lock();
+				data.RenderStart = start;
+				data.RenderEnd = end;
+				data.Busy = false;
+				data.Condition.notify_all();
+				continue;
+			}
+
+			if (ownsContext)
+			{
+				data.TargetWindow->ReleaseContext();
+				ownsContext = false;
+			}
+			data.ReleaseRequested = false;
+			data.Condition.notify_all();
+			if (data.Stop)
+				break;
+		}
+	}
+
+	void StartThread()
+	{
+		auto& data = GetData();
+		data.Stop = false;
+		data.ReleaseRequested = false;
+		data.MainOwnsContext = true;
+		data.RenderStart = data.RenderEnd = Clock::now();
+		data.Thread = std::thread(RenderLoop);
+		data.RenderThreadID = data.Thread.get_id();
+		data.Threaded = true;
+		SN_CORE_INFO("RenderThread: started with {0} frame of latency", data.Latency);
+	}
+
+	void StopThread()
+	{
+		auto& data = GetData();
+		if (!data.Threaded)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(data.Mutex);
+			data.Stop = true;
+		}
+		data.Condition.notify_all();
+		data.Thread.join();
+		data.Threaded = false;
+		data.RenderThreadID = {};
+
+		if (!data.MainOwnsContext)
+		{
+			data.TargetWindow->MakeContextCurrent();
+			data.MainOwnsContext = true;
+		}
+		SN_CORE_INFO("RenderThread: stopped, packets run inline");
+	}
+
+}
+
+namespace Syndra {
+
+	void RenderThread::Init(Window& window, const ExecuteFunction& execute)
+	{
+		auto& data = GetData();
+		data.TargetWindow = &window;
+		data.Execute = execute;
+		data.MainThreadID = std::this_thread::get_id();
+		data.Current = CreateScope<FramePacket>();
+	}
+
+	void RenderThread::Shutdown()
+	{
+		auto& data = GetData();
+		StopThread();
+		data.Latency = data.RequestedLatency = 0;
+		data.Current.reset();
+		data.Execute = nullptr;
+		data.TargetWindow = nullptr;
+	}
+
+	void RenderThread::SetLatency(uint32_t frames)
+	{
+		frames = std::min(frames, 1u);
+		if (frames > 0 && Renderer::GetAPI() == RendererAPI::API::Vulkan)
+		{
+			SN_CORE_WARN("RenderThread: a dedicated render thread is not supported on Vulkan");
+			frames = 0;
+		}
+		GetData().RequestedLatency = frames;
+	}
+
+	uint32_t RenderThread::GetLatency()
+	{
+		return GetData().RequestedLatency;
+	}
+
+	bool RenderThread::IsThreaded()
+	{
+		return GetData().Threaded;
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		const auto& data = GetData();
+		return data.Threaded && std::this_thread::get_id() == data.RenderThreadID;
+	}
+
+	bool RenderThread::BeginFrame()
+	{
+		auto& data = GetData();
+		if (data.RequestedLatency != data.Latency && data.TargetWindow)
+		{
+			data.Latency = data.RequestedLatency;
+			if (data.Latency > 0)
+				StartThread();
+			else
+				StopThread();
+		}
+
+		data.Current = CreateScope<FramePacket>();
+		data.Current->FrameIndex = ++data.FrameIndex;
+		data.FrameStart = Clock::now();
+		data.FrameWaitMs = 0.0;
+		data.FrameSynchronizations = 0;
+		return data.Threaded;
+	}
+
+	FramePacket& RenderThread::GetCurrentPacket()
+	{
+		return *GetData().Current;
+	}
+
+	void RenderThread::EndFrame()
+	{
+		SN_PROFILE_SCOPE("RenderThread::EndFrame");
+		auto& data = GetData();
+		const Clock::time_point mainEnd = Clock::now();
+		Scope<FramePacket> packet = std::move(data.Current);
+
+		RenderThreadStats& stats = data.Stats;
+		stats.Threaded = data.Threaded;
+		stats.Latency = data.Latency;
+		stats.MainThreadMs = std::max(0.0, ToMilliseconds(mainEnd - data.FrameStart) - data.FrameWaitMs);
+		stats.Synchronizations = data.FrameSynchronizations;
+		if (!data.Threaded)
+		{
+			// Inline mode: the views were drawn as they ended, the frame is already presented.
+			stats.WaitMs = data.FrameWaitMs;
+			stats.RenderThreadMs = 0.0;
+			stats.OverlapMs = 0.0;
+			return;
+		}
+
+		if (data.MainOwnsContext)
+		{
+			data.TargetWindow->ReleaseContext();
+			data.MainOwnsContext = false;
+		}
+
+		const Clock::time_point waitStart = Clock::now();
+		std::unique_lock<std::mutex> lock(data.Mutex);
+		data.Condition.wait(lock, [&data]() { return !data.Pending && !data.Busy; });
+		const double waitMs = ToMilliseconds(Clock::now() - waitStart);
+
+		// The previous packet ran in [RenderStart, RenderEnd]; the part of that window in which the
+		// main thread was working on this frame (not waiting in Synchronize) is the overlap.
+		const Clock::time_point overlapStart = std::max(data.RenderStart, data.FrameStart);
+		const Clock::time_point overlapEnd = std::min(data.RenderEnd, mainEnd);
+		const double overlapMs = overlapEnd > overlapStart ? ToMilliseconds(overlapEnd - overlapStart) : 0.0;
+		stats.RenderThreadMs = ToMilliseconds(data.RenderEnd - data.RenderStart);
+		stats.OverlapMs = std::max(0.0, overlapMs - data.FrameWaitMs);
+		stats.WaitMs = data.FrameWaitMs + waitMs;
+
+		data.Pending = std::move(packet);
+		lock.unlock();
+		data.Condition.notify_all();
+	}
+
+	void RenderThread::Synchronize()
+	{
+		auto& data = GetData();
+		if (!data.Threaded || data.MainOwnsContext || std::this_thread::get_id() != data.MainThreadID)
+			return;
+
+		SN_PROFILE_SCOPE("RenderThread::Synchronize");
+		const Clock::time_point start = Clock::now();
+		{
+			std::unique_lock<std::mutex> lock(data.Mutex);
+			data.Condition.wait(lock, [&data]() { return !data.Pending && !data.Busy; });
+			data.ReleaseRequested = true;
+			data.Condition.notify_all();
+			data.Condition.wait(lock, [&data]() { return !data.ReleaseRequested; });
+		}
+		data.TargetWindow->MakeContextCurrent();
+		data.MainOwnsContext = true;
+		data.FrameWaitMs += ToMilliseconds(Clock::now() - start);
+		++data.FrameSynchronizations;
+	}
+
+	RenderThreadStats RenderThread::GetStats()
+	{
+		return GetData().Stats;
+	}
+
+}
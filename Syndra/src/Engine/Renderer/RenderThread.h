@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+
+#include <cstdint>
+#include <functional>
+
+namespace Syndra {
+
+	class Window;
+	struct FramePacket;
+
+	struct RenderThreadStats
+	{
+		bool Threaded = false;
+		uint32_t Latency = 0;
+		double MainThreadMs = 0.0;		// main thread: events, update, packet and UI build, without waits
+		double WaitMs = 0.0;			// main thread blocked on the render thread
+		double RenderThreadMs = 0.0;	// render thread: execution of the last packet, including present
+		double OverlapMs = 0.0;			// share of RenderThreadMs that ran while the main thread was busy
+		uint32_t Synchronizations = 0;	// Synchronize() calls that had to wait in the last frame
+	};
+
+	// Splits a frame between the main thread, which builds an immutable FramePacket, and a render
+	// thread that records and submits it while the main thread works on the next frame. With a
+	// latency of 0 there is no render thread and packets are executed inline, which is also the only
+	// mode the Vulkan backend supports (its ImGui texture registry and frame command buffers are
+	// main-thread bound).
+	//
+	// The graphics API is owned by one thread at a time. Main-thread code that touches it outside
+	// packet building (resource creation, readbacks, resizes, structural scene edits) calls
+	// Synchronize() first; the main thread then keeps the context until the frame is handed off.
+	class RenderThread
+	{
+	public:
+		using ExecuteFunction = std::function<void(FramePacket& packet)>;
+
+		static void Init(Window& window, const ExecuteFunction& execute);
+		static void Shutdown();
+
+		// Frames the render thread may lag behind the main thread: 0 or 1. Applied in BeginFrame().
+		static void SetLatency(uint32_t frames);
+		static uint32_t GetLatency();
+		static bool IsThreaded();
+		static bool IsRenderThread();
+
+		// Main thread, once per frame. BeginFrame() returns IsThreaded().
+		static bool BeginFrame();
+		static FramePacket& GetCurrentPacket();
+		static void EndFrame();
+
+		static void Synchronize();
+
+		static RenderThreadStats GetStats();
+	};
+
+}
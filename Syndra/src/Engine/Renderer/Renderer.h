@@ -17,6 +17,8 @@ namespace Syndra {
 		static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray);
 		static void Submit(const Ref<Shader>& shader, const Model& model);
 		static void Submit(Material& material, const Model& model);
+		// Binds the textures and material constants a mesh carries from its source model.
+		static void BindMeshMaterial(const Ref<Shader>& shader, const Mesh& mesh);
 
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
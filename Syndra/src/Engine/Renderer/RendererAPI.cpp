@@ -12,6 +12,7 @@ namespace Syndra {
 		{
 		case API::OpenGL: return true;
 		case API::Vulkan: return true;
+		case API::Null: return true;
 		case API::NONE: return false;
 		}
 
@@ -25,6 +26,7 @@ namespace Syndra {
 		case API::NONE: return "none";
 		case API::Vulkan: return "vulkan";
 		case API::OpenGL: return "opengl";
+		case API::Null: return "null";
 		}
 
 		return "unknown";
@@ -12,13 +12,23 @@ namespace Syndra {
 		SRGB
 	};
 
+	struct GPUMemoryInfo
+	{
+		uint64_t Usage = 0;		// bytes of device memory currently in use by this process
+		uint64_t Budget = 0;	// bytes available to this process before the driver starts evicting
+		// Allocator statistics over all heaps, 0 where the backend has no allocator (OpenGL).
+		uint64_t AllocationBytes = 0;	// bytes handed out to resources
+		uint64_t BlockBytes = 0;		// bytes of device memory blocks the allocator holds
+	};
+
 	class RendererAPI {
 
 	public:
 		enum class API {
 			NONE = 0,
 			Vulkan = 1,
-			OpenGL = 2
+			OpenGL = 2,
+			Null = 3
 		};
 
 	public:
@@ -34,6 +44,8 @@ namespace Syndra {
 		virtual void WaitForIdle() {}
 
 		virtual std::string GetRendererInfo() = 0;
+		// Returns false when the backend/driver cannot report device memory.
+		virtual bool GetMemoryInfo(GPUMemoryInfo& outInfo) { return false; }
 
 		static API GetAPI() { return s_API; }
 		static API GetRequestedAPI() { return s_RequestedAPI; }
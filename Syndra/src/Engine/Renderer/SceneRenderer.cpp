@@ -2,12 +2,17 @@
 
 #include "Engine/Renderer/SceneRenderer.h"
 
+#include "Engine/Core/Application.h"
 #include "Engine/Core/Instrument.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/TextureLibrary.h"
+#include "Engine/Renderer/TextureStreamer.h"
 #include "Engine/Scene/Entity.h"
 #include "Engine/Scene/Scene.h"
 #include "imgui.h"
 
 #include <array>
+#include <atomic>
 #include <unordered_map>
 
 namespace Syndra {
@@ -16,6 +21,25 @@ namespace Syndra {
 
 	namespace {
 
+		std::atomic<uint64_t> s_InvalidationCount{ 0 };
+
+		// The render thread may still be drawing the previous packet, so it gets a copy of the material
+		// that is only replaced, never written; the copy is made again only after an edit.
+		Ref<Material> GetMaterialSnapshot(MaterialComponent* component)
+		{
+			if (!component)
+				return nullptr;
+
+			const size_t bindingHash = component->m_Material.GetBindingHash();
+			if (!component->RenderSnapshot || component->RenderSnapshotHash != bindingHash)
+			{
+				component->RenderSnapshot = CreateRef<Material>(component->m_Material);
+				component->RenderSnapshotHash = bindingHash;
+			}
+
+			return component->RenderSnapshot;
+		}
+
 		Ref<Shader> FindFirstExistingShader(const std::initializer_list<const char*> names)
 		{
 			for (const char* name : names)
@@ -47,8 +71,12 @@ namespace Syndra {
 		if (s_Data.renderPipeline)
 			s_Data.renderPipeline->ShutDown();
 
+		// Forward+ drives its light-culling buffers through GL directly, so the Null backend runs
+		// the deferred pipeline, which only goes through the renderer abstractions.
 		if (Renderer::GetAPI() == RendererAPI::API::Vulkan)
 			s_Data.renderPipeline = CreateRef<VulkanDeferredRenderer>();
+		else if (Renderer::GetAPI() == RendererAPI::API::Null)
+			s_Data.renderPipeline = CreateRef<DeferredRenderer>();
 		else
 			s_Data.renderPipeline = CreateRef<ForwardPlusRenderer>();
 
@@ -58,7 +86,7 @@ namespace Syndra {
 		//----------------------------------------------Uniform BUffers---------------------------------------------//
 		//TODO Should be moved to a different class?
 		s_Data.CameraUniformBuffer = UniformBuffer::Create(sizeof(CameraData), 0);
-
+		Invalidate();
 	}
 
 	void SceneRenderer::InitializeShaders()
@@ -73,12 +101,18 @@ namespace Syndra {
 				s_Data.shaders.Load("DeferredLighting", "assets/shaders/vulkan/DeferredLighting.glsl");
 				s_Data.shaders.Load("depth", "assets/shaders/vulkan/depth.glsl");
 				s_Data.shaders.Load("FXAA", "assets/shaders/vulkan/FXAA.glsl");
+				// GPU-driven path: instance culling and the shaders that read culled instances.
+				s_Data.shaders.Load("InstanceCulling", "assets/shaders/vulkan/InstanceCulling.glsl");
+				s_Data.shaders.Load("GeometryPassIndirect", "assets/shaders/vulkan/GeometryPassIndirect.glsl");
+				s_Data.shaders.Load("depthIndirect", "assets/shaders/vulkan/depthIndirect.glsl");
+				s_Data.shaders.Load("HiZBuild", "assets/shaders/vulkan/HiZBuild.glsl");
 				s_Data.shaders.Add("main", s_Data.shaders.Get("DeferredLighting"));
 				s_Data.shaders.Add("ForwardShading", s_Data.shaders.Get("GeometryPass"));
 			}
 			else
 			{
 				s_Data.shaders.Load("assets/shaders/computeShader.cs");
+				s_Data.shaders.Load("assets/shaders/HiZBuild.cs");
 				s_Data.shaders.Load("assets/shaders/diffuse.glsl");
 				s_Data.shaders.Load("assets/shaders/FXAA.glsl");
 				s_Data.shaders.Load("assets/shaders/main.glsl");
@@ -108,6 +142,12 @@ namespace Syndra {
 			s_Data.environment = nullptr;
 			return;
 		}
+		if (Renderer::GetAPI() == RendererAPI::API::Null)
+		{
+			// The environment bakes its maps with raw GL calls.
+			s_Data.environment = nullptr;
+			return;
+		}
 
 		//Initializing the environment map
 		auto path = s_Data.scene->m_EnvironmentPath;
@@ -115,14 +155,62 @@ namespace Syndra {
 			s_Data.scene->m_EnvironmentPath = s_Data.environment->GetPath();
 		}
 		if (!path.empty()) {
-			s_Data.environment = CreateRef<Environment>(Texture2D::CreateHDR(path, false, true));
+			s_Data.environment = CreateRef<Environment>(TextureLibrary::LoadHDR(path));
 		}
 	}
 
-	//Initializing camera, uniform buffers and environment map
+	// Starts a view of the current scene from 'camera'. BeginScene/RenderScene/EndScene only read
+	// the scene; the GPU work happens in ExecuteView, inline or on the render thread.
 	void SceneRenderer::BeginScene(const PerspectiveCamera& camera)
 	{
 		SN_PROFILE_SCOPE("SceneRenderer::BeginScene");
+		s_Data.currentView = {};
+		s_Data.currentView.SceneRef = s_Data.scene;
+		s_Data.currentView.Camera = camera;
+	}
+
+	// Collects the mesh entities and lights of the scene with their world transforms.
+	void SceneRenderer::RenderScene()
+	{
+		SN_PROFILE_SCOPE("SceneRenderer::RenderScene");
+		if (!s_Data.scene)
+			return;
+
+		Scene& scene = *s_Data.scene;
+		auto meshes = scene.m_Registry.view<TransformComponent, MeshComponent>();
+		s_Data.currentView.Items.reserve(meshes.size_hint());
+		for (auto ent : meshes)
+		{
+			auto& mc = meshes.get<MeshComponent>(ent);
+			if (mc.path.empty())
+				continue;
+
+			s_Data.currentView.Items.push_back(RenderItem{ ent, &mc, GetMaterialSnapshot(scene.m_Registry.try_get<MaterialComponent>(ent)), scene.GetWorldTransform(Entity{ ent }) });
+		}
+
+		auto lights = scene.m_Registry.view<TransformComponent, LightComponent>();
+		for (auto ent : lights)
+		{
+			const auto& lc = lights.get<LightComponent>(ent);
+			s_Data.currentView.Lights.push_back(RenderLight{ lc.type, lc.light, scene.GetWorldTranslation(Entity{ ent }) });
+		}
+	}
+
+	void SceneRenderer::EndScene()
+	{
+		SN_PROFILE_SCOPE("SceneRenderer::EndScene");
+		if (RenderThread::IsThreaded())
+			RenderThread::GetCurrentPacket().Views.push_back(std::move(s_Data.currentView));
+		else
+			ExecuteView(s_Data.currentView);
+		s_Data.currentView = {};
+	}
+
+	// Initializing camera, uniform buffers and environment map, then running the pipeline
+	void SceneRenderer::ExecuteView(const SceneRenderView& view)
+	{
+		SN_PROFILE_SCOPE("SceneRenderer::ExecuteView");
+		const PerspectiveCamera& camera = view.Camera;
 		if (s_Data.environment)
 		{
 			s_Data.environment->SetViewProjection(camera.GetViewMatrix(), camera.GetProjection());
@@ -135,29 +223,29 @@ namespace Syndra {
 		if (s_Data.CameraUniformBuffer)
 			s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(CameraData));
 
-		Renderer::BeginScene(camera);
-	}
-
-	void SceneRenderer::RenderScene()
-	{
-		SN_PROFILE_SCOPE("SceneRenderer::RenderScene");
-		if (!s_Data.renderPipeline)
-			return;
-
-		s_Data.renderPipeline->UpdateLights();
-		s_Data.renderPipeline->Render();
+		uint32_t viewportHeight = 0;
+		if (s_Data.renderPipeline)
+		{
+			if (const Ref<FrameBuffer> mainFrameBuffer = s_Data.renderPipeline->GetMainFrameBuffer())
+				viewportHeight = mainFrameBuffer->GetSpecification().Height;
+		}
+		TextureStreamer::BeginFrame(camera.GetPosition(), camera.GetProjection(), viewportHeight);
 
-	}
+		Renderer::BeginScene(camera);
 
-	void SceneRenderer::EndScene()
-	{
-		SN_PROFILE_SCOPE("SceneRenderer::EndScene");
 		if (s_Data.renderPipeline)
+		{
+			s_Data.renderPipeline->UpdateLights(view);
+			s_Data.renderPipeline->Render(view);
 			s_Data.renderPipeline->End();
+		}
+
+		TextureStreamer::Update();
 	}
 
 	void SceneRenderer::ShutDown()
 	{
+		RenderThread::Synchronize();
 		if (s_Data.renderPipeline)
 		{
 			s_Data.renderPipeline->ShutDown();
@@ -173,13 +261,36 @@ namespace Syndra {
 
 	void SceneRenderer::Reload(const Ref<Shader>& shader)
 	{
+		RenderThread::Synchronize();
 		shader->Reload();
+		Invalidate();
+	}
+
+	void SceneRenderer::Invalidate()
+	{
+		s_InvalidationCount.fetch_add(1, std::memory_order_release);
+		Application::RequestRedraw();
+	}
+
+	uint64_t SceneRenderer::GetInvalidationCount()
+	{
+		return s_InvalidationCount.load(std::memory_order_acquire);
 	}
 
 	void SceneRenderer::OnViewPortResize(uint32_t width, uint32_t height)
 	{
+		RenderThread::Synchronize();
 		if (s_Data.renderPipeline)
 			s_Data.renderPipeline->OnResize(width, height);
+		Invalidate();
+	}
+
+	void SceneRenderer::SetHiZOcclusion(bool enabled)
+	{
+		RenderThread::Synchronize();
+		if (s_Data.renderPipeline)
+			s_Data.renderPipeline->SetHiZOcclusion(enabled);
+		Invalidate();
 	}
 
 	void SceneRenderer::OnImGuiRender(bool* rendererOpen, bool* environmentOpen)
@@ -217,12 +328,16 @@ namespace Syndra {
 
 	void SceneRenderer::SetScene(const Ref<Scene>& scene)
 	{
+		RenderThread::Synchronize();
 		s_Data.scene = scene;
+		Invalidate();
 	}
 
 	void SceneRenderer::SetEnvironment(const Ref<Environment>& env)
 	{
+		RenderThread::Synchronize();
 		s_Data.environment = env;
+		Invalidate();
 	}
 
 	uint32_t SceneRenderer::GetMouseTextureID()
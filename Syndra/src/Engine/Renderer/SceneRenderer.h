@@ -19,13 +19,23 @@ namespace Syndra {
 		static void RenderScene();
 
 		static void EndScene();
+		// Draws a view built by BeginScene/RenderScene/EndScene. Render thread (or main thread when inline).
+		static void ExecuteView(const SceneRenderView& view);
 		static void ShutDown();
 
 		static void Reload(const Ref<Shader>& shader);
 
+		// Marks the rendered image of every scene as out of date (shader reloads, environment
+		// changes, streamed mips arriving) and requests a redraw. Thread-safe.
+		static void Invalidate();
+		// Incremented by Invalidate(); Scene compares it against the value it last rendered with.
+		static uint64_t GetInvalidationCount();
+
 		static void OnViewPortResize(uint32_t width, uint32_t height);
 
 		static void OnImGuiRender(bool* rendererOpen, bool* environmentOpen);
+		// Turns the active pipeline's Hi-Z occlusion culling on or off (no-op without one).
+		static void SetHiZOcclusion(bool enabled);
 
 		static void SetScene(const Ref<Scene>& scene);
 		static void SetEnvironment(const Ref<Environment>& env);
@@ -69,6 +79,8 @@ namespace Syndra {
 			//shaders
 			ShaderLibrary shaders;
 			Ref<Shader> main;
+			//view being built between BeginScene and EndScene
+			SceneRenderView currentView;
 		};
 
 	};
@@ -1,6 +1,8 @@
 #include <lpch.h>
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Platform/Null/NullShader.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 #include "Platform/Vulkan/VulkanShader.h"
 #include "glad/glad.h"
@@ -9,11 +11,13 @@ namespace Syndra {
 
 	Ref<Shader> Shader::Create(const std::string& filepath)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanShader>(filepath);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(filepath);
+		case RendererAPI::API::Null:    return CreateRef<NullShader>(filepath);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -22,11 +26,13 @@ namespace Syndra {
 
 	Ref<Shader> Shader::Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanShader>(name, vertexSrc, fragmentSrc);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+		case RendererAPI::API::Null:    return CreateRef<NullShader>(name, vertexSrc, fragmentSrc);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
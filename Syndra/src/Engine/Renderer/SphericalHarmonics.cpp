@@ -0,0 +1,179 @@
+#include "lpch.h"
+#include "Engine/Renderer/SphericalHarmonics.h"
+
+#include "Engine/Core/JobSystem.h"
+
+#include <cmath>
+
+namespace {
+
+	constexpr float kPi = 3.14159265359f;
+
+	void EvaluateBasis(const glm::vec3& d, float* outBasis)
+	{
+		outBasis[0] = 0.282095f;
+		outBasis[1] = 0.488603f * d.y;
+		outBasis[2] = 0.488603f * d.z;
+		outBasis[3] = 0.488603f * d.x;
+		outBasis[4] = 1.092548f * d.x * d.y;
+		outBasis[5] = 1.092548f * d.y * d.z;
+		outBasis[6] = 0.315392f * (3.0f * d.z * d.z - 1.0f);
+		outBasis[7] = 1.092548f * d.x * d.z;
+		outBasis[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+	}
+
+	// Direction of texel (x, y) under the SampleSphericalMap() mapping of EquirectangularToCube.glsl.
+	struct RowAngles
+	{
+		float SinLatitude = 0.0f;
+		float CosLatitude = 0.0f;
+	};
+
+	RowAngles GetRowAngles(uint32_t y, uint32_t height)
+	{
+		const float latitude = ((static_cast<float>(y) + 0.5f) / static_cast<float>(height) - 0.5f) * kPi;
+		return { std::sin(latitude), std::cos(latitude) };
+	}
+
+	void BuildLongitudeTable(uint32_t width, std::vector<float>& outCos, std::vector<float>& outSin)
+	{
+		outCos.resize(width);
+		outSin.resize(width);
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			const float longitude = ((static_cast<float>(x) + 0.5f) / static_cast<float>(width) - 0.5f) * 2.0f * kPi;
+			outCos[x] = std::cos(longitude);
+			outSin[x] = std::sin(longitude);
+		}
+	}
+
+	template<typename Fn>
+	void ParallelForRows(uint32_t rowCount, Fn&& fn)
+	{
+		Syndra::JobSystem::ParallelFor("SphericalHarmonics::Rows", rowCount, 0, [&fn](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t row = begin; row < end; ++row)
+				fn(row);
+		});
+	}
+
+}
+
+namespace Syndra {
+
+	SphericalHarmonicsL2 SphericalHarmonics::ProjectEquirectangular(const float* rgb, uint32_t width, uint32_t height, float maxRadiance)
+	{
+		SphericalHarmonicsL2 result;
+		if (!rgb || width == 0 || height == 0)
+			return result;
+
+		std::vector<float> cosLongitude;
+		std::vector<float> sinLongitude;
+		BuildLongitudeTable(width, cosLongitude, sinLongitude);
+
+		// One partial sum per row, reduced serially afterwards so the result does not depend on
+		// how rows were scheduled across threads.
+		std::vector<std::array<float, 27>> rowSums(height);
+		const float texelArea = (2.0f * kPi / static_cast<float>(width)) * (kPi / static_cast<float>(height));
+		ParallelForRows(height, [&](uint32_t y)
+			{
+				const RowAngles angles = GetRowAngles(y, height);
+				const float weight = texelArea * angles.CosLatitude;
+				const float* row = rgb + static_cast<size_t>(y) * width * 3;
+
+				std::array<float, 27> sums{};
+				float basis[9];
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					const glm::vec3 direction(angles.CosLatitude * cosLongitude[x], angles.SinLatitude, angles.CosLatitude * sinLongitude[x]);
+					EvaluateBasis(direction, basis);
+
+					const float r = std::min(row[x * 3 + 0], maxRadiance) * weight;
+					const float g = std::min(row[x * 3 + 1], maxRadiance) * weight;
+					const float b = std::min(row[x * 3 + 2], maxRadiance) * weight;
+					for (uint32_t i = 0; i < 9; ++i)
+					{
+						sums[i * 3 + 0] += basis[i] * r;
+						sums[i * 3 + 1] += basis[i] * g;
+						sums[i * 3 + 2] += basis[i] * b;
+					}
+				}
+				rowSums[y] = sums;
+			});
+
+		std::array<double, 27> total{};
+		for (const auto& sums : rowSums)
+		{
+			for (uint32_t i = 0; i < 27; ++i)
+				total[i] += sums[i];
+		}
+		for (uint32_t i = 0; i < 9; ++i)
+			result.Coefficients[i] = glm::vec3(total[i * 3 + 0], total[i * 3 + 1], total[i * 3 + 2]);
+		return result;
+	}
+
+	SphericalHarmonicsL2 SphericalHarmonics::ConvolveLambert(const SphericalHarmonicsL2& radiance)
+	{
+		// Cosine lobe band factors (pi, 2pi/3, pi/4) divided by pi.
+		constexpr float kBandFactors[3] = { 1.0f, 2.0f / 3.0f, 0.25f };
+		SphericalHarmonicsL2 irradiance;
+		for (uint32_t i = 0; i < 9; ++i)
+		{
+			const uint32_t band = i == 0 ? 0 : (i < 4 ? 1 : 2);
+			irradiance.Coefficients[i] = radiance.Coefficients[i] * kBandFactors[band];
+		}
+		return irradiance;
+	}
+
+	glm::vec3 SphericalHarmonics::Evaluate(const SphericalHarmonicsL2& sh, const glm::vec3& direction)
+	{
+		float basis[9];
+		EvaluateBasis(glm::normalize(direction), basis);
+
+		glm::vec3 value(0.0f);
+		for (uint32_t i = 0; i < 9; ++i)
+			value += sh.Coefficients[i] * basis[i];
+		return glm::max(value, glm::vec3(0.0f));
+	}
+
+	SphericalHarmonicsUniform SphericalHarmonics::ToUniform(const SphericalHarmonicsL2& sh)
+	{
+		SphericalHarmonicsUniform uniform{};
+		for (uint32_t i = 0; i < 9; ++i)
+			uniform[i] = glm::vec4(sh.Coefficients[i], 0.0f);
+		return uniform;
+	}
+
+	glm::vec3 SphericalHarmonics::ComputeReferenceIrradiance(const float* rgb, uint32_t width, uint32_t height, float maxRadiance,
+		const glm::vec3& normal, uint32_t stride)
+	{
+		if (!rgb || width == 0 || height == 0)
+			return glm::vec3(0.0f);
+
+		stride = std::max(stride, 1u);
+		std::vector<float> cosLongitude;
+		std::vector<float> sinLongitude;
+		BuildLongitudeTable(width, cosLongitude, sinLongitude);
+
+		const glm::vec3 n = glm::normalize(normal);
+		const float texelArea = (2.0f * kPi / static_cast<float>(width)) * (kPi / static_cast<float>(height)) * static_cast<float>(stride * stride);
+		glm::dvec3 irradiance(0.0);
+		for (uint32_t y = stride / 2; y < height; y += stride)
+		{
+			const RowAngles angles = GetRowAngles(y, height);
+			const float* row = rgb + static_cast<size_t>(y) * width * 3;
+			for (uint32_t x = stride / 2; x < width; x += stride)
+			{
+				const glm::vec3 direction(angles.CosLatitude * cosLongitude[x], angles.SinLatitude, angles.CosLatitude * sinLongitude[x]);
+				const float cosine = glm::dot(n, direction);
+				if (cosine <= 0.0f)
+					continue;
+
+				const glm::vec3 radiance = glm::min(glm::vec3(row[x * 3 + 0], row[x * 3 + 1], row[x * 3 + 2]), glm::vec3(maxRadiance));
+				irradiance += glm::dvec3(radiance * (cosine * texelArea * angles.CosLatitude));
+			}
+		}
+		return glm::vec3(irradiance / static_cast<double>(kPi));
+	}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace Syndra {
+
+	// RGB coefficients of an order-2 (nine term) real spherical-harmonics expansion, in the
+	// order Y00, Y1-1, Y10, Y11, Y2-2, Y2-1, Y20, Y21, Y22.
+	struct SphericalHarmonicsL2
+	{
+		std::array<glm::vec3, 9> Coefficients{};
+	};
+
+	// std140 layout of the EnvironmentSH uniform block in ForwardShading/DeferredLighting.
+	using SphericalHarmonicsUniform = std::array<glm::vec4, 9>;
+
+	class SphericalHarmonics
+	{
+	public:
+		// Projects an RGB float equirectangular image (rows in GL texture order, sampled the way
+		// EquirectangularToCube.glsl samples it) onto the SH basis, weighting each texel by its
+		// solid angle. Channels are clamped to 'maxRadiance' first. Rows are split over threads.
+		static SphericalHarmonicsL2 ProjectEquirectangular(const float* rgb, uint32_t width, uint32_t height, float maxRadiance);
+		// Convolves a radiance projection with the clamped cosine lobe and divides by pi, giving
+		// the same quantity the irradiance cube used to store (diffuse = value * albedo).
+		static SphericalHarmonicsL2 ConvolveLambert(const SphericalHarmonicsL2& radiance);
+		static glm::vec3 Evaluate(const SphericalHarmonicsL2& sh, const glm::vec3& direction);
+		static SphericalHarmonicsUniform ToUniform(const SphericalHarmonicsL2& sh);
+
+		// Brute-force hemisphere integral of the same image around 'normal', for validating the
+		// projection. Only every 'stride'-th texel in each direction is visited.
+		static glm::vec3 ComputeReferenceIrradiance(const float* rgb, uint32_t width, uint32_t height, float maxRadiance,
+			const glm::vec3& normal, uint32_t stride);
+	};
+
+}
@@ -1,7 +1,11 @@
 #include "lpch.h"
 #include "Engine/Renderer/Texture.h"
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/TextureCooker.h"
+#include "Engine/Renderer/TextureStreamer.h"
 #include "Engine/Utils/AssetPath.h"
+#include "Platform/Null/NullTexture.h"
 #include "Platform/OpenGL/OpenGLTexture2D.h"
 #include "Platform/OpenGL/OpenGLTexture1D.h"
 #include "Platform/Vulkan/VulkanTexture.h"
@@ -10,11 +14,13 @@ namespace Syndra {
 
 	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanTexture2D>(width, height);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(width, height);
+		case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(width, height);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -23,12 +29,37 @@ namespace Syndra {
 
 	Ref<Texture2D> Texture2D::Create(const std::string& path, bool sRGB)
 	{
+		RenderThread::Synchronize();
 		const std::string resolvedPath = AssetPath::ResolveTexturePath(path);
+
+		// Prefer the cooked (pre-mipped, block-compressed) cache entry; fall back to decoding the source.
+		CookedTexture cookedTexture;
+		auto loadCooked = [&](bool supportsBlockCompression)
+		{
+			if (!TextureCooker::IsEnabled())
+				return false;
+
+			TextureCookSettings settings;
+			settings.SRGB = sRGB;
+			settings.Compression = supportsBlockCompression ? TextureCompression::Auto : TextureCompression::None;
+			// Streamed textures start at a small mip; TextureStreamer brings in the rest on demand.
+			return TextureCooker::LoadOrCook(resolvedPath, settings, cookedTexture, TextureStreamer::GetFallbackDimension());
+		};
+
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-		case RendererAPI::API::Vulkan: return CreateRef<VulkanTexture2D>(resolvedPath, sRGB, false);
-		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(resolvedPath, sRGB, false);
+		case RendererAPI::API::Vulkan:
+			if (loadCooked(VulkanTexture2D::SupportsBlockCompression()))
+				return TextureStreamer::Register(CreateRef<VulkanTexture2D>(resolvedPath, cookedTexture), cookedTexture);
+			return CreateRef<VulkanTexture2D>(resolvedPath, sRGB, false);
+		case RendererAPI::API::OpenGL:
+			if (loadCooked(OpenGLTexture2D::SupportsBlockCompression()))
+				return TextureStreamer::Register(CreateRef<OpenGLTexture2D>(resolvedPath, cookedTexture), cookedTexture);
+			return CreateRef<OpenGLTexture2D>(resolvedPath, sRGB, false);
+		case RendererAPI::API::Null:
+			// Nothing is uploaded, so there is nothing to cook or stream.
+			return CreateRef<NullTexture2D>(resolvedPath, sRGB, false);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -37,11 +68,13 @@ namespace Syndra {
 
 	Ref<Syndra::Texture2D> Texture2D::Create(uint32_t width, uint32_t height,const unsigned char* data, bool sRGB)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanTexture2D>(width, height, data, sRGB);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(width,height,data,sRGB);
+		case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(width, height, data, sRGB);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -50,12 +83,14 @@ namespace Syndra {
 
 	Ref<Texture2D> Texture2D::CreateHDR(const std::string& path, bool sRGB, bool HDR)
 	{
+		RenderThread::Synchronize();
 		const std::string resolvedPath = AssetPath::ResolveTexturePath(path);
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanTexture2D>(resolvedPath, sRGB, HDR);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(resolvedPath, sRGB, HDR);
+		case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(resolvedPath, sRGB, HDR);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -75,16 +110,21 @@ namespace Syndra {
 		case RendererAPI::API::OpenGL:
 			OpenGLTexture2D::BindTexture(rendererID,slot);
 			return;
+		case RendererAPI::API::Null:
+			NullTexture2D::BindTexture(rendererID, slot);
+			return;
 		}
 	}
 
 	Ref<Texture1D> Texture1D::Create(uint32_t size)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanTexture1D>(size);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture1D>(size);
+		case RendererAPI::API::Null:    return CreateRef<NullTexture1D>(size);
 		}
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
@@ -92,11 +132,13 @@ namespace Syndra {
 
 	Ref<Syndra::Texture1D> Texture1D::Create(uint32_t size, void* data)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanTexture1D>(size, data);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture1D>(size,data);
+		case RendererAPI::API::Null:    return CreateRef<NullTexture1D>(size, data);
 		}
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
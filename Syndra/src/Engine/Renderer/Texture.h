@@ -6,6 +6,8 @@
 
 namespace Syndra{
 
+	struct CookedTexture;
+
 	class Texture
 	{
 	public:
@@ -23,6 +25,9 @@ namespace Syndra{
 
 		virtual std::string GetPath() const = 0;
 
+		// Approximate GPU memory used by all mip levels of this texture.
+		virtual uint64_t GetSizeInBytes() const { return 0; }
+
 		static void BindTexture(uint32_t rendererID, uint32_t slot);
 	};
 
@@ -40,6 +45,14 @@ namespace Syndra{
 		static Ref<Texture2D> Create(const std::string& path, bool sRGB = false);
 		static Ref<Texture2D> CreateHDR(const std::string& path, bool sRGB = false, bool HDR = false);
 		static Ref<Texture2D> Create(uint32_t width, uint32_t height, const unsigned char* data, bool sRGB = false);
+
+		// Mip streaming. Only textures created from the cooked cache support it; level 0 is the
+		// full-resolution mip and GetWidth()/GetHeight() always report level 0.
+		virtual uint32_t GetMipLevelCount() const { return 1; }
+		virtual uint32_t GetFirstResidentLevel() const { return 0; }
+		// Makes levels.FirstLevel the most detailed resident mip. 'levels' must hold the chain from
+		// that level down to the smallest mip in the texture's own format.
+		virtual bool UpdateResidentLevels(const CookedTexture& levels) { return false; }
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,947 @@
+#include "lpch.h"
+#include "Engine/Renderer/TextureCooker.h"
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Utils/AssetPath.h"
+#include "stb_image.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+
+namespace {
+
+	using Syndra::TextureCompression;
+
+	// Bump whenever the cooked output for identical inputs changes.
+	constexpr uint32_t kCookerVersion = 1;
+
+	constexpr uint32_t kDDSMagic = 0x20534444; // "DDS "
+	constexpr uint32_t kDDSFourCCDX10 = 0x30315844; // "DX10"
+	constexpr uint32_t kDDSFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;
+	constexpr uint32_t kDDSCaps = 0x1000 | 0x400000 | 0x8;
+	constexpr uint32_t kDDSPixelFormatFourCC = 0x4;
+	constexpr uint32_t kDXGIResourceDimensionTexture2D = 3;
+
+	enum DXGIFormat : uint32_t
+	{
+		DXGI_R8G8B8A8_UNORM = 28,
+		DXGI_R8G8B8A8_UNORM_SRGB = 29,
+		DXGI_BC1_UNORM = 71,
+		DXGI_BC1_UNORM_SRGB = 72,
+		DXGI_BC3_UNORM = 77,
+		DXGI_BC3_UNORM_SRGB = 78,
+		DXGI_BC5_UNORM = 83,
+		DXGI_BC7_UNORM = 98,
+		DXGI_BC7_UNORM_SRGB = 99
+	};
+
+#pragma pack(push, 1)
+	struct DDSPixelFormat
+	{
+		uint32_t Size;
+		uint32_t Flags;
+		uint32_t FourCC;
+		uint32_t RGBBitCount;
+		uint32_t RBitMask;
+		uint32_t GBitMask;
+		uint32_t BBitMask;
+		uint32_t ABitMask;
+	};
+
+	struct DDSHeader
+	{
+		uint32_t Size;
+		uint32_t Flags;
+		uint32_t Height;
+		uint32_t Width;
+		uint32_t PitchOrLinearSize;
+		uint32_t Depth;
+		uint32_t MipMapCount;
+		uint32_t Reserved1[11];
+		DDSPixelFormat PixelFormat;
+		uint32_t Caps;
+		uint32_t Caps2;
+		uint32_t Caps3;
+		uint32_t Caps4;
+		uint32_t Reserved2;
+	};
+
+	struct DDSHeaderDX10
+	{
+		uint32_t DXGIFormat;
+		uint32_t ResourceDimension;
+		uint32_t MiscFlag;
+		uint32_t ArraySize;
+		uint32_t MiscFlags2;
+	};
+#pragma pack(pop)
+
+	static_assert(sizeof(DDSHeader) == 124, "DDS header must be 124 bytes.");
+	static_assert(sizeof(DDSHeaderDX10) == 20, "DDS DX10 header must be 20 bytes.");
+
+	std::mutex s_SettingsMutex;
+	std::string s_CacheDirectory;
+	std::atomic<bool> s_Enabled{ true };
+
+	uint32_t ToDXGIFormat(TextureCompression compression, bool sRGB)
+	{
+		switch (compression)
+		{
+		case TextureCompression::BC1: return sRGB ? DXGI_BC1_UNORM_SRGB : DXGI_BC1_UNORM;
+		case TextureCompression::BC3: return sRGB ? DXGI_BC3_UNORM_SRGB : DXGI_BC3_UNORM;
+		case TextureCompression::BC5: return DXGI_BC5_UNORM;
+		case TextureCompression::BC7: return sRGB ? DXGI_BC7_UNORM_SRGB : DXGI_BC7_UNORM;
+		default:                      return sRGB ? DXGI_R8G8B8A8_UNORM_SRGB : DXGI_R8G8B8A8_UNORM;
+		}
+	}
+
+	bool FromDXGIFormat(uint32_t format, TextureCompression& compression, bool& sRGB)
+	{
+		switch (format)
+		{
+		case DXGI_R8G8B8A8_UNORM:      compression = TextureCompression::None; sRGB = false; return true;
+		case DXGI_R8G8B8A8_UNORM_SRGB: compression = TextureCompression::None; sRGB = true; return true;
+		case DXGI_BC1_UNORM:           compression = TextureCompression::BC1; sRGB = false; return true;
+		case DXGI_BC1_UNORM_SRGB:      compression = TextureCompression::BC1; sRGB = true; return true;
+		case DXGI_BC3_UNORM:           compression = TextureCompression::BC3; sRGB = false; return true;
+		case DXGI_BC3_UNORM_SRGB:      compression = TextureCompression::BC3; sRGB = true; return true;
+		case DXGI_BC5_UNORM:           compression = TextureCompression::BC5; sRGB = false; return true;
+		case DXGI_BC7_UNORM:           compression = TextureCompression::BC7; sRGB = false; return true;
+		case DXGI_BC7_UNORM_SRGB:      compression = TextureCompression::BC7; sRGB = true; return true;
+		default:                       return false;
+		}
+	}
+
+	uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	uint64_t HashCookInputs(const std::vector<uint8_t>& sourceBytes, const Syndra::TextureCookSettings& settings)
+	{
+		const uint8_t settingsKey[4] = {
+			static_cast<uint8_t>(settings.SRGB),
+			static_cast<uint8_t>(settings.GenerateMips),
+			static_cast<uint8_t>(settings.Compression),
+			static_cast<uint8_t>(kCookerVersion)
+		};
+		uint64_t hash = HashBytes(sourceBytes.data(), sourceBytes.size());
+		return HashBytes(settingsKey, sizeof(settingsKey), hash);
+	}
+
+	bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& outBytes)
+	{
+		std::ifstream stream(path, std::ios::binary | std::ios::ate);
+		if (!stream)
+			return false;
+
+		const std::streamsize size = stream.tellg();
+		if (size <= 0)
+			return false;
+
+		outBytes.resize(static_cast<size_t>(size));
+		stream.seekg(0, std::ios::beg);
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(outBytes.data()), size));
+	}
+
+	std::string BuildCachePath(uint64_t hash)
+	{
+		char fileName[32];
+		std::snprintf(fileName, sizeof(fileName), "%016llx.dds", static_cast<unsigned long long>(hash));
+		return (std::filesystem::path(Syndra::TextureCooker::GetCacheDirectory()) / fileName).string();
+	}
+
+	template<typename Fn>
+	void ParallelForRows(uint32_t rowCount, Fn&& fn)
+	{
+		Syndra::JobSystem::ParallelFor("TextureCooker::Rows", rowCount, 0, [&fn](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t row = begin; row < end; ++row)
+				fn(row);
+		});
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Mip generation
+	//////////////////////////////////////////////////////////////////////////
+
+	struct FloatImage
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<float> Pixels; // linear RGBA
+	};
+
+	const float* GetSRGBToLinearTable()
+	{
+		static const auto table = []()
+		{
+			std::array<float, 256> values{};
+			for (uint32_t i = 0; i < 256; ++i)
+			{
+				const float c = static_cast<float>(i) / 255.0f;
+				values[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			return values;
+		}();
+		return table.data();
+	}
+
+	uint8_t LinearToSRGB8(float value)
+	{
+		value = std::clamp(value, 0.0f, 1.0f);
+		const float c = (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+		return static_cast<uint8_t>(std::lround(c * 255.0f));
+	}
+
+	uint8_t LinearToUNorm8(float value)
+	{
+		return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+	}
+
+	FloatImage ToFloatImage(const uint8_t* pixels, uint32_t width, uint32_t height, bool sRGB)
+	{
+		const float* srgbTable = GetSRGBToLinearTable();
+		FloatImage image;
+		image.Width = width;
+		image.Height = height;
+		image.Pixels.resize(static_cast<size_t>(width) * height * 4);
+		for (size_t i = 0; i < image.Pixels.size(); ++i)
+		{
+			const bool isAlpha = (i & 3) == 3;
+			image.Pixels[i] = (sRGB && !isAlpha) ? srgbTable[pixels[i]] : static_cast<float>(pixels[i]) / 255.0f;
+		}
+		return image;
+	}
+
+	FloatImage Downsample(const FloatImage& source)
+	{
+		FloatImage result;
+		result.Width = std::max(1u, source.Width / 2);
+		result.Height = std::max(1u, source.Height / 2);
+		result.Pixels.resize(static_cast<size_t>(result.Width) * result.Height * 4);
+
+		ParallelForRows(result.Height, [&](uint32_t y)
+		{
+			const uint32_t y0 = std::min(y * 2, source.Height - 1);
+			const uint32_t y1 = std::min(y * 2 + 1, source.Height - 1);
+			for (uint32_t x = 0; x < result.Width; ++x)
+			{
+				const uint32_t x0 = std::min(x * 2, source.Width - 1);
+				const uint32_t x1 = std::min(x * 2 + 1, source.Width - 1);
+				const float* p00 = &source.Pixels[(static_cast<size_t>(y0) * source.Width + x0) * 4];
+				const float* p01 = &source.Pixels[(static_cast<size_t>(y0) * source.Width + x1) * 4];
+				const float* p10 = &source.Pixels[(static_cast<size_t>(y1) * source.Width + x0) * 4];
+				const float* p11 = &source.Pixels[(static_cast<size_t>(y1) * source.Width + x1) * 4];
+				float* dst = &result.Pixels[(static_cast<size_t>(y) * result.Width + x) * 4];
+				for (uint32_t c = 0; c < 4; ++c)
+					dst[c] = (p00[c] + p01[c] + p10[c] + p11[c]) * 0.25f;
+			}
+		});
+
+		return result;
+	}
+
+	std::vector<uint8_t> ToRGBA8(const FloatImage& image, bool sRGB)
+	{
+		std::vector<uint8_t> pixels(image.Pixels.size());
+		for (size_t i = 0; i < pixels.size(); ++i)
+		{
+			const bool isAlpha = (i & 3) == 3;
+			pixels[i] = (sRGB && !isAlpha) ? LinearToSRGB8(image.Pixels[i]) : LinearToUNorm8(image.Pixels[i]);
+		}
+		return pixels;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Block encoders
+	//////////////////////////////////////////////////////////////////////////
+
+	void FetchBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t outBlock[64])
+	{
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			const uint32_t srcY = std::min(blockY * 4 + y, height - 1);
+			for (uint32_t x = 0; x < 4; ++x)
+			{
+				const uint32_t srcX = std::min(blockX * 4 + x, width - 1);
+				std::memcpy(&outBlock[(y * 4 + x) * 4], &pixels[(static_cast<size_t>(srcY) * width + srcX) * 4], 4);
+			}
+		}
+	}
+
+	// Principal axis of the block's colour distribution (first 'channels' components).
+	void ComputePrincipalAxis(const uint8_t block[64], uint32_t channels, float outMean[4], float outAxis[4])
+	{
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			outMean[c] = 0.0f;
+			outAxis[c] = 0.0f;
+		}
+
+		for (uint32_t i = 0; i < 16; ++i)
+			for (uint32_t c = 0; c < channels; ++c)
+				outMean[c] += block[i * 4 + c];
+		for (uint32_t c = 0; c < channels; ++c)
+			outMean[c] /= 16.0f;
+
+		float covariance[4][4] = {};
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			float d[4] = {};
+			for (uint32_t c = 0; c < channels; ++c)
+				d[c] = block[i * 4 + c] - outMean[c];
+			for (uint32_t a = 0; a < channels; ++a)
+				for (uint32_t b = 0; b < channels; ++b)
+					covariance[a][b] += d[a] * d[b];
+		}
+
+		float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		for (uint32_t iteration = 0; iteration < 8; ++iteration)
+		{
+			float next[4] = {};
+			for (uint32_t a = 0; a < channels; ++a)
+				for (uint32_t b = 0; b < channels; ++b)
+					next[a] += covariance[a][b] * axis[b];
+
+			float length = 0.0f;
+			for (uint32_t c = 0; c < channels; ++c)
+				length = std::max(length, std::abs(next[c]));
+			if (length <= 1e-6f)
+				break;
+			for (uint32_t c = 0; c < channels; ++c)
+				axis[c] = next[c] / length;
+		}
+
+		float lengthSq = 0.0f;
+		for (uint32_t c = 0; c < channels; ++c)
+			lengthSq += axis[c] * axis[c];
+		const float invLength = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+		for (uint32_t c = 0; c < channels; ++c)
+			outAxis[c] = axis[c] * invLength;
+	}
+
+	void ComputeEndpoints(const uint8_t block[64], uint32_t channels, float outE0[4], float outE1[4])
+	{
+		float mean[4];
+		float axis[4];
+		ComputePrincipalAxis(block, channels, mean, axis);
+
+		float minT = 0.0f;
+		float maxT = 0.0f;
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			float t = 0.0f;
+			for (uint32_t c = 0; c < channels; ++c)
+				t += (block[i * 4 + c] - mean[c]) * axis[c];
+			minT = std::min(minT, t);
+			maxT = std::max(maxT, t);
+		}
+
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			outE0[c] = (c < channels) ? std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f) : 255.0f;
+			outE1[c] = (c < channels) ? std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f) : 255.0f;
+		}
+	}
+
+	uint16_t PackRGB565(const float color[4])
+	{
+		const uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+		const uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+		const uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	void UnpackRGB565(uint16_t packed, int outColor[3])
+	{
+		const int r = (packed >> 11) & 31;
+		const int g = (packed >> 5) & 63;
+		const int b = packed & 31;
+		outColor[0] = (r << 3) | (r >> 2);
+		outColor[1] = (g << 2) | (g >> 4);
+		outColor[2] = (b << 3) | (b >> 2);
+	}
+
+	void EncodeBC1Block(const uint8_t block[64], uint8_t out[8])
+	{
+		float e0[4];
+		float e1[4];
+		ComputeEndpoints(block, 3, e0, e1);
+
+		// Four-colour mode requires c0 > c1.
+		uint16_t c0 = PackRGB565(e1);
+		uint16_t c1 = PackRGB565(e0);
+		if (c0 < c1)
+			std::swap(c0, c1);
+
+		uint32_t indices = 0;
+		if (c0 != c1)
+		{
+			int palette[4][3];
+			UnpackRGB565(c0, palette[0]);
+			UnpackRGB565(c1, palette[1]);
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				uint32_t bestIndex = 0;
+				int bestError = std::numeric_limits<int>::max();
+				for (uint32_t p = 0; p < 4; ++p)
+				{
+					int error = 0;
+					for (uint32_t c = 0; c < 3; ++c)
+					{
+						const int d = static_cast<int>(block[i * 4 + c]) - palette[p][c];
+						error += d * d;
+					}
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = p;
+					}
+				}
+				indices |= bestIndex << (i * 2);
+			}
+		}
+
+		out[0] = static_cast<uint8_t>(c0 & 0xFF);
+		out[1] = static_cast<uint8_t>(c0 >> 8);
+		out[2] = static_cast<uint8_t>(c1 & 0xFF);
+		out[3] = static_cast<uint8_t>(c1 >> 8);
+		std::memcpy(&out[4], &indices, sizeof(indices));
+	}
+
+	// BC4-style single channel block, used for BC3 alpha and both BC5 channels.
+	void EncodeSingleChannelBlock(const uint8_t block[64], uint32_t channel, uint8_t out[8])
+	{
+		uint8_t minValue = 255;
+		uint8_t maxValue = 0;
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			minValue = std::min(minValue, block[i * 4 + channel]);
+			maxValue = std::max(maxValue, block[i * 4 + channel]);
+		}
+
+		out[0] = maxValue;
+		out[1] = minValue;
+
+		uint64_t indices = 0;
+		if (maxValue != minValue)
+		{
+			int palette[8];
+			palette[0] = maxValue;
+			palette[1] = minValue;
+			for (int code = 2; code < 8; ++code)
+				palette[code] = ((8 - code) * maxValue + (code - 1) * minValue) / 7;
+
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				uint64_t bestIndex = 0;
+				int bestError = std::numeric_limits<int>::max();
+				for (uint32_t p = 0; p < 8; ++p)
+				{
+					const int error = std::abs(static_cast<int>(block[i * 4 + channel]) - palette[p]);
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = p;
+					}
+				}
+				indices |= bestIndex << (i * 3);
+			}
+		}
+
+		for (uint32_t byte = 0; byte < 6; ++byte)
+			out[2 + byte] = static_cast<uint8_t>((indices >> (byte * 8)) & 0xFF);
+	}
+
+	void EncodeBC3Block(const uint8_t block[64], uint8_t out[16])
+	{
+		EncodeSingleChannelBlock(block, 3, out);
+		EncodeBC1Block(block, out + 8);
+	}
+
+	void EncodeBC5Block(const uint8_t block[64], uint8_t out[16])
+	{
+		EncodeSingleChannelBlock(block, 0, out);
+		EncodeSingleChannelBlock(block, 1, out + 8);
+	}
+
+	struct BitWriter
+	{
+		uint8_t* Data;
+		uint32_t Position = 0;
+
+		void Write(uint32_t value, uint32_t bitCount)
+		{
+			for (uint32_t i = 0; i < bitCount; ++i, ++Position)
+				Data[Position >> 3] |= static_cast<uint8_t>(((value >> i) & 1u) << (Position & 7));
+		}
+	};
+
+	// BC7 mode 6: one subset, RGBA 7.7.7.7 endpoints with a p-bit each and 4-bit indices.
+	void EncodeBC7Block(const uint8_t block[64], uint8_t out[16])
+	{
+		static constexpr int kWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		float e[2][4];
+		ComputeEndpoints(block, 4, e[0], e[1]);
+
+		uint32_t quantized[2][4];
+		uint32_t pBits[2];
+		int endpoints[2][4];
+		for (uint32_t endpoint = 0; endpoint < 2; ++endpoint)
+		{
+			float bestError = std::numeric_limits<float>::max();
+			for (uint32_t p = 0; p < 2; ++p)
+			{
+				float error = 0.0f;
+				uint32_t candidate[4];
+				for (uint32_t c = 0; c < 4; ++c)
+				{
+					candidate[c] = static_cast<uint32_t>(std::clamp(std::lround((e[endpoint][c] - static_cast<float>(p)) * 0.5f), 0l, 127l));
+					const float d = static_cast<float>((candidate[c] << 1) | p) - e[endpoint][c];
+					error += d * d;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					pBits[endpoint] = p;
+					std::memcpy(quantized[endpoint], candidate, sizeof(candidate));
+				}
+			}
+			for (uint32_t c = 0; c < 4; ++c)
+				endpoints[endpoint][c] = static_cast<int>((quantized[endpoint][c] << 1) | pBits[endpoint]);
+		}
+
+		uint32_t indices[16] = {};
+		int direction[4];
+		int directionLengthSq = 0;
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			direction[c] = endpoints[1][c] - endpoints[0][c];
+			directionLengthSq += direction[c] * direction[c];
+		}
+
+		if (directionLengthSq > 0)
+		{
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				int dot = 0;
+				for (uint32_t c = 0; c < 4; ++c)
+					dot += (static_cast<int>(block[i * 4 + c]) - endpoints[0][c]) * direction[c];
+				const int estimate = std::clamp(static_cast<int>(std::lround(static_cast<float>(dot) * 15.0f / static_cast<float>(directionLengthSq))), 0, 15);
+
+				// The weight table is only approximately linear, so check the neighbours too.
+				int bestError = std::numeric_limits<int>::max();
+				for (int candidate = std::max(0, estimate - 1); candidate <= std::min(15, estimate + 1); ++candidate)
+				{
+					int error = 0;
+					for (uint32_t c = 0; c < 4; ++c)
+					{
+						const int value = ((64 - kWeights[candidate]) * endpoints[0][c] + kWeights[candidate] * endpoints[1][c] + 32) >> 6;
+						const int d = static_cast<int>(block[i * 4 + c]) - value;
+						error += d * d;
+					}
+					if (error < bestError)
+					{
+						bestError = error;
+						indices[i] = static_cast<uint32_t>(candidate);
+					}
+				}
+			}
+		}
+
+		// The anchor index is stored with an implicit zero MSB; flip the endpoints if needed.
+		if (indices[0] & 0x8)
+		{
+			std::swap(quantized[0], quantized[1]);
+			std::swap(pBits[0], pBits[1]);
+			for (uint32_t i = 0; i < 16; ++i)
+				indices[i] = 15 - indices[i];
+		}
+
+		std::memset(out, 0, 16);
+		BitWriter writer{ out };
+		writer.Write(1u << 6, 7);
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			writer.Write(quantized[0][c], 7);
+			writer.Write(quantized[1][c], 7);
+		}
+		writer.Write(pBits[0], 1);
+		writer.Write(pBits[1], 1);
+		writer.Write(indices[0], 3);
+		for (uint32_t i = 1; i < 16; ++i)
+			writer.Write(indices[i], 4);
+	}
+
+	std::vector<uint8_t> EncodeLevel(const uint8_t* pixels, uint32_t width, uint32_t height, TextureCompression compression)
+	{
+		const uint32_t blocksX = std::max(1u, (width + 3) / 4);
+		const uint32_t blocksY = std::max(1u, (height + 3) / 4);
+		const uint32_t blockBytes = Syndra::TextureCooker::GetBlockSize(compression);
+		std::vector<uint8_t> encoded(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+		ParallelForRows(blocksY, [&](uint32_t blockY)
+		{
+			uint8_t block[64];
+			for (uint32_t blockX = 0; blockX < blocksX; ++blockX)
+			{
+				FetchBlock(pixels, width, height, blockX, blockY, block);
+				uint8_t* out = &encoded[(static_cast<size_t>(blockY) * blocksX + blockX) * blockBytes];
+				switch (compression)
+				{
+				case TextureCompression::BC1: EncodeBC1Block(block, out); break;
+				case TextureCompression::BC3: EncodeBC3Block(block, out); break;
+				case TextureCompression::BC5: EncodeBC5Block(block, out); break;
+				case TextureCompression::BC7: EncodeBC7Block(block, out); break;
+				default: break;
+				}
+			}
+		});
+
+		return encoded;
+	}
+
+	TextureCompression ResolveAutoCompression(const uint8_t* pixels, uint32_t width, uint32_t height, bool sRGB)
+	{
+		const size_t pixelCount = static_cast<size_t>(width) * height;
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			if (pixels[i * 4 + 3] != 255)
+				return TextureCompression::BC7;
+		}
+
+		// Opaque colour maps tolerate BC1; linear data (normals, ORM) keeps BC7 precision.
+		return sRGB ? TextureCompression::BC1 : TextureCompression::BC7;
+	}
+
+	bool CookFromMemory(const std::vector<uint8_t>& sourceBytes, const std::string& name, const Syndra::TextureCookSettings& settings, Syndra::CookedTexture& outTexture)
+	{
+		if (stbi_is_hdr_from_memory(sourceBytes.data(), static_cast<int>(sourceBytes.size())))
+			return false;
+
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		stbi_set_flip_vertically_on_load(1);
+		stbi_uc* data = stbi_load_from_memory(sourceBytes.data(), static_cast<int>(sourceBytes.size()), &width, &height, &channels, STBI_rgb_alpha);
+		if (data == nullptr || width <= 0 || height <= 0)
+		{
+			SN_CORE_WARN("Texture cooker could not decode '{}'.", name);
+			if (data)
+				stbi_image_free(data);
+			return false;
+		}
+
+		const bool cooked = Syndra::TextureCooker::Cook(data, static_cast<uint32_t>(width), static_cast<uint32_t>(height), settings, outTexture);
+		stbi_image_free(data);
+		return cooked;
+	}
+
+}
+
+namespace Syndra {
+
+	uint64_t CookedTexture::GetSizeInBytes() const
+	{
+		uint64_t size = 0;
+		for (const auto& level : Levels)
+			size += level.Data.size();
+		return size;
+	}
+
+	bool TextureCooker::LoadOrCook(const std::string& sourcePath, const TextureCookSettings& settings, CookedTexture& outTexture, uint32_t maxDimension)
+	{
+		std::vector<uint8_t> sourceBytes;
+		if (!ReadFileBytes(sourcePath, sourceBytes))
+			return false;
+
+		const std::string cachePath = BuildCachePath(HashCookInputs(sourceBytes, settings));
+		if (ReadDDS(cachePath, outTexture, maxDimension))
+			return true;
+
+		const auto cookStart = std::chrono::steady_clock::now();
+		if (!CookFromMemory(sourceBytes, sourcePath, settings, outTexture))
+			return false;
+		const double cookMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cookStart).count();
+
+		SN_CORE_INFO("Cooked texture '{}' ({}x{}, {} mips, {}) in {:.1f} ms.",
+			sourcePath, outTexture.Width, outTexture.Height, outTexture.Levels.size(),
+			GetCompressionName(outTexture.Compression), cookMs);
+
+		if (!WriteDDS(cachePath, outTexture))
+		{
+			// Without a cache file the upper mips could never be streamed back in, so keep them all.
+			SN_CORE_WARN("Failed to write cooked texture cache '{}'.", cachePath);
+			return true;
+		}
+
+		outTexture.CachePath = cachePath;
+		const uint32_t firstLevel = GetFirstLevelForDimension(outTexture.Width, outTexture.Height, outTexture.GetLevelCount(), maxDimension);
+		if (firstLevel > 0)
+		{
+			outTexture.Levels.erase(outTexture.Levels.begin(), outTexture.Levels.begin() + firstLevel);
+			outTexture.FirstLevel = firstLevel;
+		}
+		return true;
+	}
+
+	bool TextureCooker::Cook(const std::string& sourcePath, const TextureCookSettings& settings, CookedTexture& outTexture)
+	{
+		std::vector<uint8_t> sourceBytes;
+		if (!ReadFileBytes(sourcePath, sourceBytes))
+			return false;
+
+		return CookFromMemory(sourceBytes, sourcePath, settings, outTexture);
+	}
+
+	bool TextureCooker::Cook(const uint8_t* rgbaPixels, uint32_t width, uint32_t height, const TextureCookSettings& settings, CookedTexture& outTexture)
+	{
+		if (rgbaPixels == nullptr || width == 0 || height == 0)
+			return false;
+
+		TextureCompression compression = settings.Compression;
+		if (compression == TextureCompression::Auto)
+			compression = ResolveAutoCompression(rgbaPixels, width, height, settings.SRGB);
+
+		outTexture = {};
+		outTexture.Width = width;
+		outTexture.Height = height;
+		outTexture.Compression = compression;
+		outTexture.SRGB = settings.SRGB && compression != TextureCompression::BC5;
+
+		const uint32_t levelCount = settings.GenerateMips
+			? static_cast<uint32_t>(std::floor(std::log2(static_cast<float>(std::max(width, height))))) + 1
+			: 1;
+		outTexture.Levels.resize(levelCount);
+
+		auto storeLevel = [&](uint32_t level, const uint8_t* pixels, uint32_t levelWidth, uint32_t levelHeight)
+		{
+			CookedTextureLevel& target = outTexture.Levels[level];
+			target.Width = levelWidth;
+			target.Height = levelHeight;
+			if (compression == TextureCompression::None)
+				target.Data.assign(pixels, pixels + static_cast<size_t>(levelWidth) * levelHeight * 4);
+			else
+				target.Data = EncodeLevel(pixels, levelWidth, levelHeight, compression);
+		};
+
+		// Level 0 keeps the source bytes untouched; lower levels are filtered in linear space.
+		storeLevel(0, rgbaPixels, width, height);
+		if (levelCount > 1)
+		{
+			FloatImage current = ToFloatImage(rgbaPixels, width, height, settings.SRGB);
+			for (uint32_t level = 1; level < levelCount; ++level)
+			{
+				current = Downsample(current);
+				const std::vector<uint8_t> pixels = ToRGBA8(current, settings.SRGB);
+				storeLevel(level, pixels.data(), current.Width, current.Height);
+			}
+		}
+
+		return true;
+	}
+
+	bool TextureCooker::WriteDDS(const std::string& path, const CookedTexture& texture)
+	{
+		if (!texture.IsValid() || texture.FirstLevel != 0)
+			return false;
+
+		std::error_code errorCode;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), errorCode);
+
+		DDSHeader header{};
+		header.Size = sizeof(DDSHeader);
+		header.Flags = kDDSFlags;
+		header.Height = texture.Height;
+		header.Width = texture.Width;
+		header.PitchOrLinearSize = static_cast<uint32_t>(texture.Levels[0].Data.size());
+		header.MipMapCount = static_cast<uint32_t>(texture.Levels.size());
+		header.PixelFormat.Size = sizeof(DDSPixelFormat);
+		header.PixelFormat.Flags = kDDSPixelFormatFourCC;
+		header.PixelFormat.FourCC = kDDSFourCCDX10;
+		header.Caps = kDDSCaps;
+
+		DDSHeaderDX10 headerDX10{};
+		headerDX10.DXGIFormat = ToDXGIFormat(texture.Compression, texture.SRGB);
+		headerDX10.ResourceDimension = kDXGIResourceDimensionTexture2D;
+		headerDX10.ArraySize = 1;
+
+		// Write to a temporary file first so a crash never leaves a truncated cache entry.
+		const std::string tempPath = path + ".tmp";
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+				return false;
+
+			stream.write(reinterpret_cast<const char*>(&kDDSMagic), sizeof(kDDSMagic));
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			stream.write(reinterpret_cast<const char*>(&headerDX10), sizeof(headerDX10));
+			for (const auto& level : texture.Levels)
+				stream.write(reinterpret_cast<const char*>(level.Data.data()), static_cast<std::streamsize>(level.Data.size()));
+			if (!stream)
+				return false;
+		}
+
+		std::filesystem::rename(tempPath, path, errorCode);
+		if (errorCode)
+		{
+			std::filesystem::remove(tempPath, errorCode);
+			return false;
+		}
+		return true;
+	}
+
+	bool TextureCooker::ReadDDS(const std::string& path, CookedTexture& outTexture, uint32_t maxDimension)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+			return false;
+
+		uint32_t magic = 0;
+		DDSHeader header{};
+		DDSHeaderDX10 headerDX10{};
+		stream.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!stream || magic != kDDSMagic || header.Size != sizeof(DDSHeader) || header.PixelFormat.FourCC != kDDSFourCCDX10)
+			return false;
+
+		stream.read(reinterpret_cast<char*>(&headerDX10), sizeof(headerDX10));
+		if (!stream || headerDX10.ResourceDimension != kDXGIResourceDimensionTexture2D || headerDX10.ArraySize != 1)
+			return false;
+
+		CookedTexture texture;
+		if (!FromDXGIFormat(headerDX10.DXGIFormat, texture.Compression, texture.SRGB))
+			return false;
+
+		texture.Width = header.Width;
+		texture.Height = header.Height;
+		if (texture.Width == 0 || texture.Height == 0)
+			return false;
+
+		const uint32_t levelCount = std::max(1u, header.MipMapCount);
+		texture.FirstLevel = GetFirstLevelForDimension(texture.Width, texture.Height, levelCount, maxDimension);
+
+		uint64_t skippedBytes = 0;
+		for (uint32_t level = 0; level < texture.FirstLevel; ++level)
+			skippedBytes += GetLevelSize(texture.Compression, std::max(1u, texture.Width >> level), std::max(1u, texture.Height >> level));
+		if (skippedBytes > 0)
+			stream.seekg(static_cast<std::streamoff>(skippedBytes), std::ios::cur);
+
+		texture.Levels.resize(levelCount - texture.FirstLevel);
+		for (uint32_t level = texture.FirstLevel; level < levelCount; ++level)
+		{
+			CookedTextureLevel& target = texture.Levels[level - texture.FirstLevel];
+			target.Width = std::max(1u, texture.Width >> level);
+			target.Height = std::max(1u, texture.Height >> level);
+			target.Data.resize(static_cast<size_t>(GetLevelSize(texture.Compression, target.Width, target.Height)));
+			stream.read(reinterpret_cast<char*>(target.Data.data()), static_cast<std::streamsize>(target.Data.size()));
+			if (!stream)
+				return false;
+		}
+
+		texture.CachePath = path;
+		outTexture = std::move(texture);
+		return true;
+	}
+
+	std::string TextureCooker::GetCachePath(const std::string& sourcePath, const TextureCookSettings& settings)
+	{
+		std::vector<uint8_t> sourceBytes;
+		if (!ReadFileBytes(sourcePath, sourceBytes))
+			return {};
+
+		return BuildCachePath(HashCookInputs(sourceBytes, settings));
+	}
+
+	void TextureCooker::SetCacheDirectory(const std::string& directory)
+	{
+		std::lock_guard lock(s_SettingsMutex);
+		s_CacheDirectory = directory;
+	}
+
+	std::string TextureCooker::GetCacheDirectory()
+	{
+		std::lock_guard lock(s_SettingsMutex);
+		if (s_CacheDirectory.empty())
+			s_CacheDirectory = (std::filesystem::path(AssetPath::ResolveEditorAssetPath("assets")) / ".cache" / "textures").lexically_normal().string();
+		return s_CacheDirectory;
+	}
+
+	void TextureCooker::SetEnabled(bool enabled)
+	{
+		s_Enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool TextureCooker::IsEnabled()
+	{
+		return s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	uint32_t TextureCooker::GetBlockSize(TextureCompression compression)
+	{
+		switch (compression)
+		{
+		case TextureCompression::BC1: return 8;
+		case TextureCompression::BC3:
+		case TextureCompression::BC5:
+		case TextureCompression::BC7: return 16;
+		default:                      return 0;
+		}
+	}
+
+	uint32_t TextureCooker::GetFirstLevelForDimension(uint32_t width, uint32_t height, uint32_t levelCount, uint32_t maxDimension)
+	{
+		if (maxDimension == 0 || levelCount == 0)
+			return 0;
+
+		uint32_t level = 0;
+		while (level + 1 < levelCount && std::max(1u, std::max(width, height) >> level) > maxDimension)
+			++level;
+		return level;
+	}
+
+	uint64_t TextureCooker::GetLevelSize(TextureCompression compression, uint32_t width, uint32_t height)
+	{
+		if (compression == TextureCompression::None || compression == TextureCompression::Auto)
+			return static_cast<uint64_t>(width) * height * 4;
+
+		const uint64_t blocksX = std::max(1u, (width + 3) / 4);
+		const uint64_t blocksY = std::max(1u, (height + 3) / 4);
+		return blocksX * blocksY * GetBlockSize(compression);
+	}
+
+	const char* TextureCooker::GetCompressionName(TextureCompression compression)
+	{
+		switch (compression)
+		{
+		case TextureCompression::None: return "RGBA8";
+		case TextureCompression::Auto: return "Auto";
+		case TextureCompression::BC1:  return "BC1";
+		case TextureCompression::BC3:  return "BC3";
+		case TextureCompression::BC5:  return "BC5";
+		case TextureCompression::BC7:  return "BC7";
+		}
+		return "Unknown";
+	}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Syndra {
+
+	enum class TextureCompression : uint8_t
+	{
+		None = 0,	// RGBA8, mips still precomputed
+		Auto,		// BC1 for opaque colour, BC7 for alpha and linear data
+		BC1,
+		BC3,
+		BC5,		// two channel (RG), intended for tangent-space normals
+		BC7
+	};
+
+	struct TextureCookSettings
+	{
+		bool SRGB = false;
+		bool GenerateMips = true;
+		TextureCompression Compression = TextureCompression::Auto;
+	};
+
+	struct CookedTextureLevel
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<uint8_t> Data;
+	};
+
+	struct CookedTexture
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		bool SRGB = false;
+		// Never Auto once cooked.
+		TextureCompression Compression = TextureCompression::None;
+		// Mip index of Levels[0]. Non-zero when the top of the chain was skipped for streaming;
+		// Width/Height always describe level 0 of the full chain.
+		uint32_t FirstLevel = 0;
+		std::vector<CookedTextureLevel> Levels;
+		// Cache file the levels came from, empty if the texture only exists in memory.
+		std::string CachePath;
+
+		bool IsValid() const { return Width > 0 && Height > 0 && !Levels.empty(); }
+		bool IsCompressed() const { return Compression != TextureCompression::None; }
+		uint32_t GetLevelCount() const { return FirstLevel + static_cast<uint32_t>(Levels.size()); }
+		uint64_t GetSizeInBytes() const;
+	};
+
+	// Offline/first-load texture cooker. Decodes an 8-bit source image, builds a gamma-correct
+	// mip chain, block-compresses every level and stores the result as a DDS (DX10 header) in
+	// a cache directory keyed by source content hash and cook settings. Subsequent loads read
+	// the cached mips straight from disk and skip decoding and runtime mip generation.
+	class TextureCooker
+	{
+	public:
+		// Returns the cooked texture for 'sourcePath', cooking and caching it if needed. A non-zero
+		// 'maxDimension' drops leading mips larger than that, see ReadDDS.
+		static bool LoadOrCook(const std::string& sourcePath, const TextureCookSettings& settings, CookedTexture& outTexture, uint32_t maxDimension = 0);
+		static bool Cook(const std::string& sourcePath, const TextureCookSettings& settings, CookedTexture& outTexture);
+		static bool Cook(const uint8_t* rgbaPixels, uint32_t width, uint32_t height, const TextureCookSettings& settings, CookedTexture& outTexture);
+
+		static bool WriteDDS(const std::string& path, const CookedTexture& texture);
+		// Reads the mip chain starting at the first level whose larger side is <= 'maxDimension'
+		// (0 reads every level); skipped levels are seeked over, never read.
+		static bool ReadDDS(const std::string& path, CookedTexture& outTexture, uint32_t maxDimension = 0);
+
+		static std::string GetCachePath(const std::string& sourcePath, const TextureCookSettings& settings);
+		static void SetCacheDirectory(const std::string& directory);
+		static std::string GetCacheDirectory();
+
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		static uint32_t GetBlockSize(TextureCompression compression);
+		// First mip of a width x height chain whose larger side fits in 'maxDimension' (0 = level 0).
+		static uint32_t GetFirstLevelForDimension(uint32_t width, uint32_t height, uint32_t levelCount, uint32_t maxDimension);
+		static uint64_t GetLevelSize(TextureCompression compression, uint32_t width, uint32_t height);
+		static const char* GetCompressionName(TextureCompression compression);
+	};
+
+}
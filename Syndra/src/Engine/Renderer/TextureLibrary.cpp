@@ -0,0 +1,155 @@
+#include "lpch.h"
+#include "Engine/Renderer/TextureLibrary.h"
+
+#include "Engine/Utils/AssetPath.h"
+
+#include <mutex>
+
+namespace {
+
+	struct TextureKey
+	{
+		std::string ResolvedPath;
+		bool SRGB = false;
+		bool HDR = false;
+
+		bool operator==(const TextureKey& other) const
+		{
+			return SRGB == other.SRGB && HDR == other.HDR && ResolvedPath == other.ResolvedPath;
+		}
+	};
+
+	struct TextureKeyHasher
+	{
+		std::size_t operator()(const TextureKey& key) const
+		{
+			std::size_t hash = std::hash<std::string>{}(key.ResolvedPath);
+			hash ^= (static_cast<std::size_t>(key.SRGB) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+			hash ^= (static_cast<std::size_t>(key.HDR) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+			return hash;
+		}
+	};
+
+	// Sweep expired entries once the map has grown by this many insertions.
+	constexpr size_t kGarbageCollectInterval = 64;
+
+	struct TextureLibraryData
+	{
+		std::mutex Mutex;
+		std::unordered_map<TextureKey, std::weak_ptr<Syndra::Texture2D>, TextureKeyHasher> Textures;
+		Syndra::TextureLibraryStats Stats;
+		size_t InsertionsSinceCollect = 0;
+	};
+
+	TextureLibraryData& GetData()
+	{
+		static TextureLibraryData data;
+		return data;
+	}
+
+	void CollectGarbageLocked(TextureLibraryData& data)
+	{
+		for (auto it = data.Textures.begin(); it != data.Textures.end();)
+		{
+			if (it->second.expired())
+				it = data.Textures.erase(it);
+			else
+				++it;
+		}
+		data.InsertionsSinceCollect = 0;
+	}
+
+	Syndra::Ref<Syndra::Texture2D> LoadCached(const TextureKey& key, const std::function<Syndra::Ref<Syndra::Texture2D>()>& create)
+	{
+		TextureLibraryData& data = GetData();
+		{
+			std::lock_guard lock(data.Mutex);
+			++data.Stats.Requests;
+			const auto it = data.Textures.find(key);
+			if (it != data.Textures.end())
+			{
+				if (Syndra::Ref<Syndra::Texture2D> texture = it->second.lock())
+				{
+					++data.Stats.CacheHits;
+					data.Stats.BytesSaved += texture->GetSizeInBytes();
+					return texture;
+				}
+			}
+		}
+
+		// Create outside the lock: decoding/uploading is slow and must not block other lookups.
+		Syndra::Ref<Syndra::Texture2D> texture = create();
+		if (!texture)
+			return nullptr;
+
+		std::lock_guard lock(data.Mutex);
+		auto& slot = data.Textures[key];
+		if (Syndra::Ref<Syndra::Texture2D> existing = slot.lock())
+			return existing;
+
+		slot = texture;
+		data.Stats.BytesLoaded += texture->GetSizeInBytes();
+		if (++data.InsertionsSinceCollect >= kGarbageCollectInterval)
+			CollectGarbageLocked(data);
+		return texture;
+	}
+
+}
+
+namespace Syndra {
+
+	Ref<Texture2D> TextureLibrary::Load(const std::string& path, bool sRGB)
+	{
+		if (path.empty())
+			return nullptr;
+
+		const TextureKey key{ AssetPath::ResolveTexturePath(path), sRGB, false };
+		return LoadCached(key, [&]() { return Texture2D::Create(key.ResolvedPath, sRGB); });
+	}
+
+	Ref<Texture2D> TextureLibrary::LoadHDR(const std::string& path)
+	{
+		if (path.empty())
+			return nullptr;
+
+		const TextureKey key{ AssetPath::ResolveTexturePath(path), false, true };
+		return LoadCached(key, [&]() { return Texture2D::CreateHDR(key.ResolvedPath, false, true); });
+	}
+
+	void TextureLibrary::CollectGarbage()
+	{
+		TextureLibraryData& data = GetData();
+		std::lock_guard lock(data.Mutex);
+		CollectGarbageLocked(data);
+	}
+
+	void TextureLibrary::Clear()
+	{
+		TextureLibraryData& data = GetData();
+		std::lock_guard lock(data.Mutex);
+		data.Textures.clear();
+		data.InsertionsSinceCollect = 0;
+	}
+
+	TextureLibraryStats TextureLibrary::GetStats()
+	{
+		TextureLibraryData& data = GetData();
+		std::lock_guard lock(data.Mutex);
+		TextureLibraryStats stats = data.Stats;
+		stats.UniqueTextures = 0;
+		for (const auto& [key, texture] : data.Textures)
+		{
+			if (!texture.expired())
+				++stats.UniqueTextures;
+		}
+		return stats;
+	}
+
+	void TextureLibrary::ResetStats()
+	{
+		TextureLibraryData& data = GetData();
+		std::lock_guard lock(data.Mutex);
+		data.Stats = {};
+	}
+
+}
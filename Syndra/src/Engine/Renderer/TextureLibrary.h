@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+#include "Engine/Renderer/Texture.h"
+
+#include <string>
+
+namespace Syndra {
+
+	struct TextureLibraryStats
+	{
+		uint64_t Requests = 0;
+		uint64_t CacheHits = 0;
+		uint32_t UniqueTextures = 0;	// entries still referenced by someone
+		uint64_t BytesLoaded = 0;		// GPU bytes of textures actually created
+		uint64_t BytesSaved = 0;		// GPU bytes avoided by returning a shared texture
+	};
+
+	// Process-wide cache of file-backed textures. Entries are keyed by resolved path, colour
+	// space and format options and only hold weak references, so a texture is released as soon
+	// as the last material/model using it goes away and is reloaded on the next request.
+	class TextureLibrary
+	{
+	public:
+		static Ref<Texture2D> Load(const std::string& path, bool sRGB = false);
+		static Ref<Texture2D> LoadHDR(const std::string& path);
+
+		// Drops entries whose texture has already been destroyed.
+		static void CollectGarbage();
+		static void Clear();
+
+		static TextureLibraryStats GetStats();
+		static void ResetStats();
+	};
+
+}
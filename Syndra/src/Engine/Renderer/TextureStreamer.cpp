@@ -0,0 +1,513 @@
+#include "lpch.h"
+#include "Engine/Renderer/TextureStreamer.h"
+
+#include "Engine/Core/Instrument.h"
+#include "Engine/Renderer/Material.h"
+#include "Engine/Renderer/Model.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/SceneRenderer.h"
+#include "Engine/Renderer/TextureCooker.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+	using Syndra::Texture2D;
+
+	constexpr uint32_t kFallbackDimension = 128;
+	constexpr uint32_t kWorkerThreadCount = 2;
+	constexpr uint32_t kMaxLoadsInFlight = 8;
+	constexpr uint32_t kNoPendingLevel = ~0u;
+	// Frames a texture keeps its detail mips after the render list last asked for them.
+	constexpr uint64_t kUnusedFrameCount = 120;
+	// Automatic budget: at most this share of the device budget, and never past the headroom
+	// left by everything else that lives in device memory.
+	constexpr double kAutoBudgetFraction = 0.5;
+	constexpr double kDeviceHeadroomFraction = 0.9;
+	constexpr uint64_t kDefaultBudget = 512ull * 1024 * 1024;
+	constexpr float kMinDistance = 0.01f;
+
+	struct StreamedTexture
+	{
+		std::weak_ptr<Texture2D> Texture;
+		std::string CachePath;
+		uint32_t MaxDimension = 1;
+		uint32_t LevelCount = 1;
+		uint32_t FallbackLevel = 0;
+		uint32_t ResidentLevel = 0;
+		uint32_t RequestedLevel = 0;
+		uint32_t TargetLevel = 0;
+		uint32_t PendingLevel = kNoPendingLevel;
+		uint64_t LastRequestFrame = 0;
+		// ChainBytes[level] = GPU size of the chain from 'level' down to the smallest mip.
+		std::vector<uint64_t> ChainBytes;
+	};
+
+	struct LoadRequest
+	{
+		const Texture2D* Key = nullptr;
+		std::string CachePath;
+		uint32_t Level = 0;
+		uint32_t MaxDimension = 0;
+	};
+
+	struct LoadResult
+	{
+		const Texture2D* Key = nullptr;
+		uint32_t Level = 0;
+		bool Success = false;
+		Syndra::CookedTexture Levels;
+	};
+
+	struct StreamerData
+	{
+		std::unordered_map<const Texture2D*, StreamedTexture> Textures;
+		glm::vec3 CameraPosition = glm::vec3(0.0f);
+		float PixelsPerUnitAtUnitDistance = 0.0f;
+		uint64_t FrameIndex = 0;
+		Syndra::TextureStreamingStats Stats;	// render thread only; published at the end of Update()
+
+		std::mutex QueueMutex;
+		Syndra::TextureStreamingStats PublishedStats;	// guarded by QueueMutex, read by GetStats()
+		std::condition_variable QueueCondition;
+		std::deque<LoadRequest> Requests;
+		std::vector<LoadResult> Results;
+		std::vector<std::thread> Workers;
+		bool StopWorkers = false;
+	};
+
+	std::atomic<bool> s_Enabled{ true };
+	std::atomic<uint64_t> s_BudgetOverride{ 0 };
+
+	StreamerData& GetData()
+	{
+		static StreamerData data;
+		return data;
+	}
+
+	void WorkerLoop(StreamerData& data)
+	{
+		while (true)
+		{
+			LoadRequest request;
+			{
+				std::unique_lock lock(data.QueueMutex);
+				data.QueueCondition.wait(lock, [&]() { return data.StopWorkers || !data.Requests.empty(); });
+				if (data.StopWorkers)
+					return;
+
+				request = std::move(data.Requests.front());
+				data.Requests.pop_front();
+			}
+
+			LoadResult result;
+			result.Key = request.Key;
+			result.Level = request.Level;
+			result.Success = Syndra::TextureCooker::ReadDDS(request.CachePath, result.Levels, request.MaxDimension) &&
+				result.Levels.FirstLevel == request.Level;
+
+			{
+				std::lock_guard lock(data.QueueMutex);
+				data.Results.push_back(std::move(result));
+			}
+			// Results are applied by the next Update(), which only runs while the scene renders.
+			Syndra::SceneRenderer::Invalidate();
+		}
+	}
+
+	void EnsureWorkers(StreamerData& data)
+	{
+		if (!data.Workers.empty())
+			return;
+
+		data.StopWorkers = false;
+		for (uint32_t i = 0; i < kWorkerThreadCount; ++i)
+			data.Workers.emplace_back(WorkerLoop, std::ref(data));
+	}
+
+	void PublishStats(StreamerData& data)
+	{
+		std::lock_guard lock(data.QueueMutex);
+		data.PublishedStats = data.Stats;
+	}
+
+	uint64_t ComputeBudget(StreamerData& data, uint64_t residentBytes)
+	{
+		data.Stats.HasDeviceMemory = Syndra::RenderCommand::GetMemoryInfo(data.Stats.DeviceMemory);
+		const uint64_t budgetOverride = s_BudgetOverride.load(std::memory_order_relaxed);
+		if (budgetOverride > 0)
+			return budgetOverride;
+		if (!data.Stats.HasDeviceMemory)
+			return kDefaultBudget;
+
+		const Syndra::GPUMemoryInfo& memory = data.Stats.DeviceMemory;
+		const uint64_t poolLimit = static_cast<uint64_t>(static_cast<double>(memory.Budget) * kAutoBudgetFraction);
+		const uint64_t deviceLimit = static_cast<uint64_t>(static_cast<double>(memory.Budget) * kDeviceHeadroomFraction);
+		const uint64_t headroom = deviceLimit > memory.Usage ? deviceLimit - memory.Usage : 0;
+		return std::min(poolLimit, residentBytes + headroom);
+	}
+
+	void ApplyLoadResults(StreamerData& data)
+	{
+		std::vector<LoadResult> results;
+		{
+			std::lock_guard lock(data.QueueMutex);
+			results.swap(data.Results);
+		}
+
+		bool applied = false;
+		for (LoadResult& result : results)
+		{
+			const auto it = data.Textures.find(result.Key);
+			if (it == data.Textures.end() || it->second.PendingLevel != result.Level)
+				continue;
+
+			StreamedTexture& entry = it->second;
+			entry.PendingLevel = kNoPendingLevel;
+			const Syndra::Ref<Texture2D> texture = entry.Texture.lock();
+			if (!texture)
+				continue;
+
+			if (!result.Success || !texture->UpdateResidentLevels(result.Levels))
+			{
+				// The cache entry is gone or stale; keep whatever is resident and stop streaming it.
+				SN_CORE_WARN("Texture streaming disabled for '{}': failed to read mip {} from '{}'.",
+					texture->GetPath(), result.Level, entry.CachePath);
+				data.Textures.erase(it);
+				continue;
+			}
+
+			entry.ResidentLevel = texture->GetFirstResidentLevel();
+			data.Stats.StreamedInBytes += result.Levels.GetSizeInBytes();
+			applied = true;
+		}
+
+		// The new mips show up from the next frame on.
+		if (applied)
+			Syndra::SceneRenderer::Invalidate();
+	}
+
+	// Raises TargetLevel (drops detail) until the requested total fits in 'budget'. Textures the
+	// render list did not ask for this frame go first, oldest first; visible textures then lose one
+	// level per pass, largest first, so detail degrades evenly across the frame.
+	uint64_t FitToBudget(StreamerData& data, uint64_t requestedBytes, uint64_t budget)
+	{
+		std::vector<StreamedTexture*> stale;
+		std::vector<StreamedTexture*> visible;
+		for (auto& [key, entry] : data.Textures)
+		{
+			if (entry.TargetLevel >= entry.FallbackLevel)
+				continue;
+			(entry.LastRequestFrame == data.FrameIndex ? visible : stale).push_back(&entry);
+		}
+
+		auto dropLevel = [&](StreamedTexture& entry)
+		{
+			requestedBytes -= entry.ChainBytes[entry.TargetLevel] - entry.ChainBytes[entry.TargetLevel + 1];
+			++entry.TargetLevel;
+			++data.Stats.TrimmedLevels;
+		};
+
+		std::sort(stale.begin(), stale.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+			{
+				return a->LastRequestFrame < b->LastRequestFrame;
+			});
+		for (StreamedTexture* entry : stale)
+		{
+			while (requestedBytes > budget && entry->TargetLevel < entry->FallbackLevel)
+				dropLevel(*entry);
+		}
+
+		bool dropped = true;
+		while (requestedBytes > budget && dropped)
+		{
+			std::sort(visible.begin(), visible.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+				{
+					return a->ChainBytes[a->TargetLevel] > b->ChainBytes[b->TargetLevel];
+				});
+
+			dropped = false;
+			for (StreamedTexture* entry : visible)
+			{
+				if (requestedBytes <= budget)
+					break;
+				if (entry->TargetLevel >= entry->FallbackLevel)
+					continue;
+
+				dropLevel(*entry);
+				dropped = true;
+			}
+		}
+		return requestedBytes;
+	}
+
+	void IssueLoads(StreamerData& data)
+	{
+		uint32_t inFlight = 0;
+		std::vector<StreamedTexture*> evictions;
+		std::vector<StreamedTexture*> upgrades;
+		for (auto& [key, entry] : data.Textures)
+		{
+			if (entry.PendingLevel != kNoPendingLevel)
+				++inFlight;
+			else if (entry.TargetLevel > entry.ResidentLevel)
+				evictions.push_back(&entry);
+			else if (entry.TargetLevel < entry.ResidentLevel)
+				upgrades.push_back(&entry);
+		}
+
+		// Evictions free memory, so they go first; then the blurriest textures.
+		std::sort(upgrades.begin(), upgrades.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+			{
+				return (a->ResidentLevel - a->TargetLevel) > (b->ResidentLevel - b->TargetLevel);
+			});
+		evictions.insert(evictions.end(), upgrades.begin(), upgrades.end());
+
+		std::vector<LoadRequest> requests;
+		for (StreamedTexture* entry : evictions)
+		{
+			if (inFlight >= kMaxLoadsInFlight)
+				break;
+
+			const Syndra::Ref<Texture2D> texture = entry->Texture.lock();
+			if (!texture)
+				continue;
+
+			entry->PendingLevel = entry->TargetLevel;
+			requests.push_back(LoadRequest{ texture.get(), entry->CachePath, entry->TargetLevel,
+				std::max(1u, entry->MaxDimension >> entry->TargetLevel) });
+			++inFlight;
+		}
+
+		if (requests.empty())
+			return;
+
+		{
+			std::lock_guard lock(data.QueueMutex);
+			for (LoadRequest& request : requests)
+				data.Requests.push_back(std::move(request));
+		}
+		data.QueueCondition.notify_all();
+	}
+
+}
+
+namespace Syndra {
+
+	Ref<Texture2D> TextureStreamer::Register(const Ref<Texture2D>& texture, const CookedTexture& cookedTexture)
+	{
+		if (!texture || !IsEnabled() || cookedTexture.CachePath.empty() || cookedTexture.FirstLevel == 0)
+			return texture;
+
+		StreamerData& data = GetData();
+		EnsureWorkers(data);
+
+		StreamedTexture entry;
+		entry.Texture = texture;
+		entry.CachePath = cookedTexture.CachePath;
+		entry.MaxDimension = std::max(cookedTexture.Width, cookedTexture.Height);
+		entry.LevelCount = cookedTexture.GetLevelCount();
+		entry.FallbackLevel = cookedTexture.FirstLevel;
+		entry.ResidentLevel = cookedTexture.FirstLevel;
+		entry.RequestedLevel = cookedTexture.FirstLevel;
+		entry.TargetLevel = cookedTexture.FirstLevel;
+		entry.LastRequestFrame = data.FrameIndex;
+
+		entry.ChainBytes.assign(entry.LevelCount + 1, 0);
+		for (uint32_t level = entry.LevelCount; level-- > 0;)
+		{
+			entry.ChainBytes[level] = entry.ChainBytes[level + 1] + TextureCooker::GetLevelSize(cookedTexture.Compression,
+				std::max(1u, cookedTexture.Width >> level), std::max(1u, cookedTexture.Height >> level));
+		}
+
+		data.Textures[texture.get()] = std::move(entry);
+		return texture;
+	}
+
+	uint32_t TextureStreamer::GetFallbackDimension()
+	{
+		return IsEnabled() ? kFallbackDimension : 0;
+	}
+
+	void TextureStreamer::BeginFrame(const glm::vec3& cameraPosition, const glm::mat4& projection, uint32_t viewportHeight)
+	{
+		StreamerData& data = GetData();
+		++data.FrameIndex;
+		data.CameraPosition = cameraPosition;
+		// projection[1][1] = 1 / tan(fovY / 2): pixels covered by one world unit at distance 1.
+		data.PixelsPerUnitAtUnitDistance = 0.5f * static_cast<float>(viewportHeight) * std::abs(projection[1][1]);
+	}
+
+	void TextureStreamer::RequestLevel(const Ref<Texture2D>& texture, uint32_t level)
+	{
+		if (!texture)
+			return;
+
+		StreamerData& data = GetData();
+		const auto it = data.Textures.find(texture.get());
+		if (it == data.Textures.end())
+			return;
+
+		StreamedTexture& entry = it->second;
+		level = std::min(level, entry.LevelCount - 1);
+		if (entry.LastRequestFrame != data.FrameIndex)
+			entry.RequestedLevel = level;
+		else
+			entry.RequestedLevel = std::min(entry.RequestedLevel, level);
+		entry.LastRequestFrame = data.FrameIndex;
+	}
+
+	void TextureStreamer::RequestModelTextures(const Model& model, Material* material, const glm::mat4& worldTransform)
+	{
+		StreamerData& data = GetData();
+		if (data.Textures.empty() || data.PixelsPerUnitAtUnitDistance <= 0.0f)
+			return;
+
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+		float worldUnitsPerUV = std::numeric_limits<float>::max();
+		for (const Mesh& mesh : model.meshes)
+		{
+			if (!mesh.HasBounds())
+				continue;
+
+			boundsMin = glm::min(boundsMin, mesh.GetBoundsMin());
+			boundsMax = glm::max(boundsMax, mesh.GetBoundsMax());
+			if (mesh.GetWorldUnitsPerUV() > 0.0f)
+				worldUnitsPerUV = std::min(worldUnitsPerUV, mesh.GetWorldUnitsPerUV());
+		}
+		if (boundsMin.x > boundsMax.x || worldUnitsPerUV == std::numeric_limits<float>::max())
+			return;
+
+		const float scale = std::max({ glm::length(glm::vec3(worldTransform[0])),
+			glm::length(glm::vec3(worldTransform[1])),
+			glm::length(glm::vec3(worldTransform[2])) });
+		const glm::vec3 center = glm::vec3(worldTransform * glm::vec4(0.5f * (boundsMin + boundsMax), 1.0f));
+		const float radius = 0.5f * glm::length(boundsMax - boundsMin) * scale;
+		const float distance = std::max(glm::length(center - data.CameraPosition) - radius, kMinDistance);
+
+		const float tiling = material ? std::max(material->GetCBuffer().tiling, 0.0001f) : 1.0f;
+		// Screen pixels spanned by one unit of UV at the closest point of the model.
+		const float pixelsPerUV = data.PixelsPerUnitAtUnitDistance / distance * worldUnitsPerUV * scale / tiling;
+
+		auto request = [&](const Ref<Texture2D>& texture)
+		{
+			if (!texture)
+				return;
+
+			const float texelsPerPixel = static_cast<float>(std::max(texture->GetWidth(), texture->GetHeight())) / pixelsPerUV;
+			const uint32_t level = texelsPerPixel > 1.0f ? static_cast<uint32_t>(std::floor(std::log2(texelsPerPixel))) : 0;
+			RequestLevel(texture, level);
+		};
+
+		for (const Ref<Texture2D>& texture : model.syndraTextures)
+			request(texture);
+		if (material)
+		{
+			for (const auto& [binding, texture] : material->GetTextures())
+				request(texture);
+		}
+	}
+
+	void TextureStreamer::Update()
+	{
+		SN_PROFILE_SCOPE("TextureStreamer::Update");
+		StreamerData& data = GetData();
+		ApplyLoadResults(data);
+
+		const bool enabled = IsEnabled();
+		uint64_t residentBytes = 0;
+		uint64_t requestedBytes = 0;
+		for (auto it = data.Textures.begin(); it != data.Textures.end();)
+		{
+			StreamedTexture& entry = it->second;
+			if (entry.Texture.expired())
+			{
+				it = data.Textures.erase(it);
+				continue;
+			}
+
+			if (!enabled)
+				entry.TargetLevel = 0;
+			else if (entry.LastRequestFrame == data.FrameIndex)
+				entry.TargetLevel = std::min(entry.RequestedLevel, entry.FallbackLevel);
+			else if (data.FrameIndex - entry.LastRequestFrame > kUnusedFrameCount)
+				entry.TargetLevel = entry.FallbackLevel;
+
+			residentBytes += entry.ChainBytes[entry.ResidentLevel];
+			requestedBytes += entry.ChainBytes[entry.TargetLevel];
+			++it;
+		}
+
+		data.Stats.StreamedTextures = static_cast<uint32_t>(data.Textures.size());
+		data.Stats.ResidentBytes = residentBytes;
+		data.Stats.RequestedBytes = requestedBytes;
+		data.Stats.TrimmedLevels = 0;
+		data.Stats.Budget = ComputeBudget(data, residentBytes);
+		if (enabled && requestedBytes > data.Stats.Budget)
+			FitToBudget(data, requestedBytes, data.Stats.Budget);
+
+		IssueLoads(data);
+
+		uint32_t pending = 0;
+		for (const auto& [key, entry] : data.Textures)
+		{
+			if (entry.PendingLevel != kNoPendingLevel)
+				++pending;
+		}
+		data.Stats.PendingLoads = pending;
+		PublishStats(data);
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		StreamerData& data = GetData();
+		{
+			std::lock_guard lock(data.QueueMutex);
+			data.StopWorkers = true;
+			data.Requests.clear();
+		}
+		data.QueueCondition.notify_all();
+		for (std::thread& worker : data.Workers)
+			worker.join();
+
+		data.Workers.clear();
+		data.Results.clear();
+		data.Textures.clear();
+		data.Stats = {};
+		PublishStats(data);
+	}
+
+	void TextureStreamer::SetEnabled(bool enabled)
+	{
+		s_Enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool TextureStreamer::IsEnabled()
+	{
+		return s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	void TextureStreamer::SetBudget(uint64_t bytes)
+	{
+		s_BudgetOverride.store(bytes, std::memory_order_relaxed);
+	}
+
+	uint64_t TextureStreamer::GetBudget()
+	{
+		return s_BudgetOverride.load(std::memory_order_relaxed);
+	}
+
+	TextureStreamingStats TextureStreamer::GetStats()
+	{
+		StreamerData& data = GetData();
+		std::lock_guard lock(data.QueueMutex);
+		return data.PublishedStats;
+	}
+
+}
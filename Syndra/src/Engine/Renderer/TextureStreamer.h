@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+#include "Engine/Renderer/RendererAPI.h"
+#include "Engine/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+namespace Syndra {
+
+	class Material;
+	class Model;
+	struct CookedTexture;
+
+	struct TextureStreamingStats
+	{
+		uint32_t StreamedTextures = 0;
+		uint32_t PendingLoads = 0;
+		uint64_t ResidentBytes = 0;		// GPU bytes of streamed textures at their current mips
+		uint64_t RequestedBytes = 0;	// GPU bytes if every texture got the mip the render list asked for
+		uint64_t Budget = 0;			// texture budget used for the last update
+		uint64_t StreamedInBytes = 0;	// total bytes uploaded by the streamer
+		uint32_t TrimmedLevels = 0;		// levels dropped to fit the budget in the last update
+		bool HasDeviceMemory = false;
+		GPUMemoryInfo DeviceMemory;
+	};
+
+	// Streams the detail mips of cooked textures in and out under a VRAM budget. A texture starts
+	// with only its small mips resident, the render list reports the mip each texture needs from
+	// its on-screen texel density, and Update() reads missing levels from the cooked cache on
+	// worker threads and trims the least recently used textures when the budget is exceeded.
+	// Everything except the worker threads runs on the render thread; SetEnabled, SetBudget and
+	// GetStats may also be called from the main thread.
+	class TextureStreamer
+	{
+	public:
+		// Starts tracking 'texture' if it was created from a cache file with mips to stream.
+		static Ref<Texture2D> Register(const Ref<Texture2D>& texture, const CookedTexture& cookedTexture);
+		// Largest mip dimension a streamed texture is created with and never drops below.
+		static uint32_t GetFallbackDimension();
+
+		static void BeginFrame(const glm::vec3& cameraPosition, const glm::mat4& projection, uint32_t viewportHeight);
+		static void RequestLevel(const Ref<Texture2D>& texture, uint32_t level);
+		// Requests the mips needed to draw 'model' (and the textures of 'material', if any) at 'worldTransform'.
+		static void RequestModelTextures(const Model& model, Material* material, const glm::mat4& worldTransform);
+		static void Update();
+		static void Shutdown();
+
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+		// 0 derives the budget from the device memory budget reported by the renderer backend.
+		static void SetBudget(uint64_t bytes);
+		static uint64_t GetBudget();
+
+		static TextureStreamingStats GetStats();
+	};
+
+}
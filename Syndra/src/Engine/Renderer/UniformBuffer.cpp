@@ -2,6 +2,8 @@
 #include "Engine/Renderer/UniformBuffer.h"
 
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Platform/Null/NullUniformBuffer.h"
 #include "Platform/OpenGL/OpenGLUniformBuffer.h"
 #include "Platform/Vulkan/VulkanUniformBuffer.h"
 
@@ -9,11 +11,13 @@ namespace Syndra {
 
 	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding)
 	{
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::NONE:    SN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::Vulkan: return CreateRef<VulkanUniformBuffer>(size, binding);
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLUniformBuffer>(size, binding);
+		case RendererAPI::API::Null:    return CreateRef<NullUniformBuffer>(size, binding);
 		}
 
 		SN_CORE_ASSERT(false, "Unknown RendererAPI!");
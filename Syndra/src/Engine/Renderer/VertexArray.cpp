@@ -1,17 +1,21 @@
 #include "lpch.h"
 #include "Engine/Renderer/VertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
 #include "Platform/Vulkan/VulkanVertexArray.h"
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
 
 namespace Syndra {
 
 	Ref<VertexArray> VertexArray::Create() {
+		RenderThread::Synchronize();
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::NONE: SN_CORE_ASSERT(false, "RendererAPI::NONE is not supported yet!"); return nullptr;
 			case RendererAPI::API::Vulkan: return CreateRef<VulkanVertexArray>();
 			case RendererAPI::API::OpenGL: return CreateRef<OpenGLVertexArray>();
+			case RendererAPI::API::Null: return CreateRef<NullVertexArray>();
 		}
 
 		SN_CORE_ASSERT(false, "Unknown API!");
@@ -4,36 +4,40 @@
 
 #include "Engine/Core/Instrument.h"
 #include "Engine/ImGui/ImGuiLayer.h"
+#include "Engine/Renderer/Frustum.h"
+#include "Engine/Renderer/GpuProfiler.h"
+#include "Engine/Renderer/OcclusionCuller.h"
+#include "Engine/Renderer/TextureLibrary.h"
+#include "Engine/Renderer/TextureStreamer.h"
 #include "Engine/Scene/Entity.h"
 #include "Engine/Scene/Scene.h"
 #include "Engine/Utils/PlatformUtils.h"
+#include "Platform/Vulkan/VulkanBindlessTextureTable.h"
+#include "Platform/Vulkan/VulkanDrawPacket.h"
+#include "Platform/Vulkan/VulkanGeometryPool.h"
+#include "Platform/Vulkan/VulkanGpuScene.h"
+#include "Platform/Vulkan/VulkanRendererAPI.h"
 #include "imgui.h"
 
 #include <algorithm>
 #include <array>
 #include <filesystem>
+#include <unordered_map>
 
 namespace Syndra {
 
 	namespace {
 
-		struct FrustumPlane
-		{
-			glm::vec3 Normal = glm::vec3(0.0f);
-			float Distance = 0.0f;
-		};
-
-		using FrustumPlanes = std::array<FrustumPlane, 6>;
-
-		enum FrustumPlaneIndex : size_t
-		{
-			Left = 0,
-			Right,
-			Bottom,
-			Top,
-			Near,
-			Far
-		};
+		// Uniforms set per item; built once instead of as a std::string per call.
+		const std::string kShadowTransformUniform = "push.u_trans";
+		const std::string kShadowIdUniform = "push.id";
+		const std::string kTransformUniform = "transform.u_trans";
+		const std::string kTransformIdUniform = "transform.id";
+		const std::string kMaterialColorUniform = "push.material.color";
+		const std::string kMaterialRoughnessUniform = "push.material.RoughnessFactor";
+		const std::string kMaterialMetallicUniform = "push.material.MetallicFactor";
+		const std::string kMaterialAOUniform = "push.material.AO";
+		const std::string kTilingUniform = "push.tiling";
 
 		glm::mat4 ConvertOpenGLClipToVulkanClip(const glm::mat4& matrix)
 		{
@@ -44,69 +48,6 @@ namespace Syndra {
 			return clip * matrix;
 		}
 
-		FrustumPlane NormalizePlane(const glm::vec4& plane)
-		{
-			FrustumPlane result{};
-			const glm::vec3 normal = glm::vec3(plane);
-			const float length = glm::length(normal);
-			if (length <= 1e-6f)
-				return result;
-
-			result.Normal = normal / length;
-			result.Distance = plane.w / length;
-			return result;
-		}
-
-		FrustumPlanes BuildFrustumPlanes(const glm::mat4& viewProjection)
-		{
-			FrustumPlanes planes{};
-
-			planes[FrustumPlaneIndex::Left] = NormalizePlane(glm::vec4(
-				viewProjection[0][3] + viewProjection[0][0],
-				viewProjection[1][3] + viewProjection[1][0],
-				viewProjection[2][3] + viewProjection[2][0],
-				viewProjection[3][3] + viewProjection[3][0]));
-			planes[FrustumPlaneIndex::Right] = NormalizePlane(glm::vec4(
-				viewProjection[0][3] - viewProjection[0][0],
-				viewProjection[1][3] - viewProjection[1][0],
-				viewProjection[2][3] - viewProjection[2][0],
-				viewProjection[3][3] - viewProjection[3][0]));
-			planes[FrustumPlaneIndex::Bottom] = NormalizePlane(glm::vec4(
-				viewProjection[0][3] + viewProjection[0][1],
-				viewProjection[1][3] + viewProjection[1][1],
-				viewProjection[2][3] + viewProjection[2][1],
-				viewProjection[3][3] + viewProjection[3][1]));
-			planes[FrustumPlaneIndex::Top] = NormalizePlane(glm::vec4(
-				viewProjection[0][3] - viewProjection[0][1],
-				viewProjection[1][3] - viewProjection[1][1],
-				viewProjection[2][3] - viewProjection[2][1],
-				viewProjection[3][3] - viewProjection[3][1]));
-			planes[FrustumPlaneIndex::Near] = NormalizePlane(glm::vec4(
-				viewProjection[0][3] + viewProjection[0][2],
-				viewProjection[1][3] + viewProjection[1][2],
-				viewProjection[2][3] + viewProjection[2][2],
-				viewProjection[3][3] + viewProjection[3][2]));
-			planes[FrustumPlaneIndex::Far] = NormalizePlane(glm::vec4(
-				viewProjection[0][3] - viewProjection[0][2],
-				viewProjection[1][3] - viewProjection[1][2],
-				viewProjection[2][3] - viewProjection[2][2],
-				viewProjection[3][3] - viewProjection[3][2]));
-
-			return planes;
-		}
-
-		bool IsSphereInsideFrustum(const FrustumPlanes& planes, const glm::vec3& center, float radius)
-		{
-			for (const auto& plane : planes)
-			{
-				const float distanceToPlane = glm::dot(plane.Normal, center) + plane.Distance;
-				if (distanceToPlane < -radius)
-					return false;
-			}
-
-			return true;
-		}
-
 		bool ComputeModelBounds(const Model& model, glm::vec3& outMin, glm::vec3& outMax)
 		{
 			bool hasBounds = false;
@@ -130,14 +71,6 @@ namespace Syndra {
 			return hasBounds;
 		}
 
-		float ComputeTransformMaxScale(const glm::mat4& transform)
-		{
-			const glm::vec3 xAxis = glm::vec3(transform[0]);
-			const glm::vec3 yAxis = glm::vec3(transform[1]);
-			const glm::vec3 zAxis = glm::vec3(transform[2]);
-			return std::max({ glm::length(xAxis), glm::length(yAxis), glm::length(zAxis), 1e-4f });
-		}
-
 		bool IsModelVisibleInCameraFrustum(const Model& model, const glm::mat4& worldTransform, const FrustumPlanes& cameraFrustum)
 		{
 			glm::vec3 localMin(0.0f);
@@ -156,6 +89,518 @@ namespace Syndra {
 			return IsSphereInsideFrustum(cameraFrustum, worldCenter, worldRadius);
 		}
 
+		enum class RetainedPass : uint32_t
+		{
+			Shadow = 0,
+			Geometry
+		};
+
+		struct RetainedItemKey
+		{
+			entt::entity Entity = entt::null;
+			RetainedPass Pass = RetainedPass::Geometry;
+
+			bool operator==(const RetainedItemKey& other) const
+			{
+				return Entity == other.Entity && Pass == other.Pass;
+			}
+		};
+
+		struct RetainedItemKeyHasher
+		{
+			size_t operator()(const RetainedItemKey& key) const
+			{
+				size_t hash = std::hash<uint32_t>{}(static_cast<uint32_t>(key.Entity));
+				hash ^= std::hash<uint32_t>{}(static_cast<uint32_t>(key.Pass)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				return hash;
+			}
+		};
+
+		// The draw packets of one render item in one pass, one per mesh of its model.
+		struct RetainedItemDraws
+		{
+			std::vector<Ref<VertexArray>> VertexArrays;
+			std::vector<Scope<VulkanDrawPacket>> Packets;
+			size_t BindingHash = 0;
+			VulkanDrawPacket::PushConstantSlot TransformSlot;
+			VulkanDrawPacket::PushConstantSlot IdSlot;
+			// False when the shader has no transform to patch; such items keep the immediate path.
+			bool Retainable = true;
+			uint64_t LastUsedFrame = 0;
+		};
+
+		struct RetainedDrawCache
+		{
+			std::unordered_map<RetainedItemKey, RetainedItemDraws, RetainedItemKeyHasher> Items;
+			uint64_t Frame = 0;
+		};
+
+		// Entries of items that stopped rendering are dropped after this many frames.
+		constexpr uint64_t kRetainedDrawMaxIdleFrames = 120;
+
+		RetainedDrawCache& GetRetainedDrawCache()
+		{
+			static RetainedDrawCache cache;
+			return cache;
+		}
+
+		size_t HashMeshMaterials(const Model& model)
+		{
+			size_t hash = model.meshes.size();
+			auto combine = [&hash](size_t value)
+			{
+				hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			};
+
+			for (const auto& mesh : model.meshes)
+			{
+				const auto& materialData = mesh.GetMaterialData();
+				combine(materialData.AlbedoTextureID);
+				combine(materialData.MetallicTextureID);
+				combine(materialData.NormalTextureID);
+				combine(materialData.RoughnessTextureID);
+				combine(materialData.AOTextureID);
+				for (const auto& texture : mesh.textures)
+					combine(texture.id);
+			}
+
+			return hash;
+		}
+
+		bool IsRetainedDrawCurrent(const RetainedItemDraws& draws, const Model& model, size_t bindingHash)
+		{
+			if (draws.BindingHash != bindingHash || draws.VertexArrays.size() != model.meshes.size())
+				return false;
+
+			for (size_t i = 0; i < model.meshes.size(); ++i)
+			{
+				if (draws.VertexArrays[i] != model.meshes[i].GetVertexArray())
+					return false;
+				if (draws.Retainable && !draws.Packets[i]->IsValid())
+					return false;
+			}
+
+			return true;
+		}
+
+		// Replays the packets with the item's current transform and id; nothing else is re-resolved.
+		bool SubmitRetainedDraws(VulkanRendererAPI& api, RetainedItemDraws& draws, const RenderItem& item)
+		{
+			const int entityID = static_cast<int>(static_cast<uint32_t>(item.EntityHandle));
+			for (auto& packet : draws.Packets)
+			{
+				packet->SetPushConstant(draws.TransformSlot, glm::value_ptr(item.WorldTransform), sizeof(glm::mat4));
+				packet->SetPushConstant(draws.IdSlot, &entityID, sizeof(int));
+				if (!api.SubmitDrawPacket(*packet))
+					return false;
+			}
+
+			return true;
+		}
+
+		// Binds and draws exactly like Renderer::Submit, capturing a packet from each mesh draw on the way.
+		void BuildRetainedDraws(
+			VulkanRendererAPI& api,
+			RetainedItemDraws& draws,
+			const Ref<Shader>& shader,
+			Material* material,
+			const Model& model,
+			size_t bindingHash,
+			const std::string& transformName,
+			const std::string& idName)
+		{
+			draws.VertexArrays.clear();
+			draws.Packets.clear();
+			draws.BindingHash = bindingHash;
+			draws.TransformSlot = {};
+			draws.IdSlot = {};
+			draws.Retainable = true;
+
+			if (material)
+				material->Bind();
+			else
+				shader->Bind();
+
+			for (const auto& mesh : model.meshes)
+			{
+				if (!material)
+					Renderer::BindMeshMaterial(shader, mesh);
+
+				auto vertexArray = mesh.GetVertexArray();
+				vertexArray->Bind();
+
+				auto packet = CreateScope<VulkanDrawPacket>();
+				if (api.BuildDrawPacket(vertexArray, *packet))
+				{
+					if (draws.TransformSlot.Size == 0 && !packet->FindPushConstant(transformName, draws.TransformSlot))
+						draws.Retainable = false;
+					if (draws.IdSlot.Size == 0)
+						packet->FindPushConstant(idName, draws.IdSlot);
+				}
+
+				if (!api.SubmitDrawPacket(*packet))
+					RenderCommand::DrawIndexed(vertexArray);
+
+				draws.VertexArrays.push_back(vertexArray);
+				draws.Packets.push_back(std::move(packet));
+			}
+
+			if (!draws.Retainable)
+				draws.Packets.clear();
+		}
+
+		// Draws one render item through its retained packets, rebuilding them when anything they
+		// captured has changed. Returns false when the caller should use the immediate path.
+		bool DrawRetained(
+			RetainedPass pass,
+			const RenderItem& item,
+			const Ref<Shader>& shader,
+			Material* material,
+			const std::string& transformName,
+			const std::string& idName)
+		{
+			VulkanRendererAPI* api = VulkanRendererAPI::GetCurrent();
+			if (api == nullptr)
+				return false;
+
+			RetainedDrawCache& cache = GetRetainedDrawCache();
+			RetainedItemDraws& draws = cache.Items[RetainedItemKey{ item.EntityHandle, pass }];
+			draws.LastUsedFrame = cache.Frame;
+
+			const Model& model = item.Mesh->model;
+			const size_t bindingHash = material ? material->GetBindingHash() : HashMeshMaterials(model);
+			if (IsRetainedDrawCurrent(draws, model, bindingHash))
+			{
+				if (!draws.Retainable)
+					return false;
+				if (SubmitRetainedDraws(*api, draws, item))
+					return true;
+			}
+
+			BuildRetainedDraws(*api, draws, shader, material, model, bindingHash, transformName, idName);
+			return true;
+		}
+
+		void SweepRetainedDraws()
+		{
+			RetainedDrawCache& cache = GetRetainedDrawCache();
+			++cache.Frame;
+			if (cache.Frame % kRetainedDrawMaxIdleFrames != 0)
+				return;
+
+			for (auto iterator = cache.Items.begin(); iterator != cache.Items.end();)
+			{
+				if (cache.Frame - iterator->second.LastUsedFrame > kRetainedDrawMaxIdleFrames)
+					iterator = cache.Items.erase(iterator);
+				else
+					++iterator;
+			}
+		}
+
+		VulkanGpuScene::Planes ToGpuPlanes(const FrustumPlanes& planes)
+		{
+			VulkanGpuScene::Planes result{};
+			for (size_t i = 0; i < planes.size(); ++i)
+				result[i] = glm::vec4(planes[i].Normal, planes[i].Distance);
+			return result;
+		}
+
+		glm::vec4 ComputeMeshBoundingSphere(const Mesh& mesh)
+		{
+			if (!mesh.HasBounds())
+				return glm::vec4(0.0f);
+
+			const glm::vec3 center = (mesh.GetBoundsMin() + mesh.GetBoundsMax()) * 0.5f;
+			const float radius = glm::length((mesh.GetBoundsMax() - mesh.GetBoundsMin()) * 0.5f);
+			return glm::vec4(center, radius);
+		}
+
+		int32_t GetBindlessTextureIndex(uint32_t rendererID)
+		{
+			return (rendererID != 0) ? VulkanBindlessTextureTable::GetIndex(rendererID) : VulkanBindlessTextureTable::InvalidIndex;
+		}
+
+		// The geometry pass defaults as overridden by Renderer::BindMeshMaterial.
+		VulkanGpuScene::Material MakeMeshMaterial(const Mesh& mesh)
+		{
+			VulkanGpuScene::Material result{};
+			const auto& materialData = mesh.GetMaterialData();
+			if (materialData.IsPBR)
+			{
+				result.Color = materialData.BaseColorFactor;
+				result.Metallic = materialData.MetallicFactor;
+				result.Roughness = materialData.RoughnessFactor;
+				result.AO = materialData.AOFactor;
+				result.AlbedoMapIndex = GetBindlessTextureIndex(materialData.AlbedoTextureID);
+				result.MetallicMapIndex = GetBindlessTextureIndex(materialData.MetallicTextureID);
+				result.NormalMapIndex = GetBindlessTextureIndex(materialData.NormalTextureID);
+				result.RoughnessMapIndex = GetBindlessTextureIndex(materialData.RoughnessTextureID);
+				result.AOMapIndex = GetBindlessTextureIndex(materialData.AOTextureID);
+				return result;
+			}
+
+			for (const auto& texture : mesh.textures)
+			{
+				if (texture.type == "texture_diffuse")
+					result.AlbedoMapIndex = GetBindlessTextureIndex(texture.id);
+				else if (texture.type == "texture_specular")
+					result.MetallicMapIndex = GetBindlessTextureIndex(texture.id);
+				else if (texture.type == "texture_normal")
+					result.NormalMapIndex = GetBindlessTextureIndex(texture.id);
+			}
+
+			return result;
+		}
+
+		// What Material::Bind passes to the geometry shader.
+		VulkanGpuScene::Material MakeComponentMaterial(Material& material)
+		{
+			VulkanGpuScene::Material result{};
+			const Material::CBuffer cbuffer = material.GetCBuffer();
+			result.Color = cbuffer.material.color;
+			result.Roughness = cbuffer.material.RoughnessFactor;
+			result.Metallic = cbuffer.material.MetallicFactor;
+			result.AO = cbuffer.material.AO;
+			result.Tiling = cbuffer.tiling;
+
+			const auto& textures = material.GetTextures();
+			for (const auto& sampler : material.GetSamplers())
+			{
+				const auto textureIt = textures.find(sampler.binding);
+				if (!sampler.isUsed || textureIt == textures.end() || !textureIt->second)
+					continue;
+
+				const int32_t index = GetBindlessTextureIndex(textureIt->second->GetRendererID());
+				switch (sampler.binding)
+				{
+				case 0: result.AlbedoMapIndex = index; break;
+				case 1: result.MetallicMapIndex = index; break;
+				case 2: result.NormalMapIndex = index; break;
+				case 3: result.RoughnessMapIndex = index; break;
+				case 4: result.AOMapIndex = index; break;
+				default: break;
+				}
+			}
+
+			return result;
+		}
+
+		// Items drawn with the default material or a material of the geometry shader can be drawn by
+		// GeometryPassIndirect; anything else keeps the CPU path.
+		bool IsGpuDrivable(const RenderItem& item, const Ref<Shader>& geometryShader)
+		{
+			return !item.Material || item.Material->GetShader() == geometryShader;
+		}
+
+		// GPU scene state of one GPU-driven entity. Its instances are updated when the entity's
+		// transform or material snapshot changes and rebuilt when its model does.
+		struct GpuSceneEntity
+		{
+			// One per mesh; they also keep the pool ranges the instances point into alive.
+			std::vector<Ref<VertexArray>> VertexArrays;
+			std::vector<uint32_t> Instances;
+			std::vector<const void*> MaterialKeys;
+			Ref<Material> ComponentMaterial;
+			glm::mat4 Transform = glm::mat4(1.0f);
+			uint64_t LastSeenFrame = 0;
+		};
+
+		// A GPU scene material, shared per material snapshot and per mesh drawn with its own textures.
+		struct GpuSceneMaterial
+		{
+			uint32_t Index = 0;
+			uint32_t References = 0;
+			// Keeps the snapshot, and with it the key, alive; null for mesh materials.
+			Ref<Material> ComponentMaterial;
+			const Mesh* MeshMaterial = nullptr;
+		};
+
+		struct GpuSceneCache
+		{
+			std::unordered_map<entt::entity, GpuSceneEntity> Entities;
+			std::unordered_map<const void*, GpuSceneMaterial> Materials;
+			uint64_t Frame = 0;
+			uint64_t BindlessRevision = 0;
+			size_t TextureRequestCursor = 0;
+		};
+
+		// GPU-driven entities skip the per-frame texture requests; each one asks for its mips every
+		// this many frames, well within the streamer's request window.
+		constexpr uint32_t kGpuTextureRequestInterval = 8;
+
+		GpuSceneCache& GetGpuSceneCache()
+		{
+			static GpuSceneCache cache;
+			return cache;
+		}
+
+		VulkanGpuScene::Material MakeGpuSceneMaterial(const GpuSceneMaterial& material)
+		{
+			return material.ComponentMaterial ? MakeComponentMaterial(*material.ComponentMaterial) : MakeMeshMaterial(*material.MeshMaterial);
+		}
+
+		const void* AcquireGpuSceneMaterial(VulkanGpuScene& gpuScene, GpuSceneCache& cache, const Ref<Material>& material, const Mesh& mesh)
+		{
+			const void* key = material ? static_cast<const void*>(material.get()) : static_cast<const void*>(&mesh);
+			auto [materialIt, inserted] = cache.Materials.try_emplace(key);
+			GpuSceneMaterial& entry = materialIt->second;
+			if (inserted)
+			{
+				entry.ComponentMaterial = material;
+				entry.MeshMaterial = material ? nullptr : &mesh;
+				entry.Index = gpuScene.AddMaterial(MakeGpuSceneMaterial(entry));
+			}
+			++entry.References;
+			return key;
+		}
+
+		void ReleaseGpuSceneMaterial(VulkanGpuScene& gpuScene, GpuSceneCache& cache, const void* key)
+		{
+			const auto materialIt = cache.Materials.find(key);
+			if (materialIt == cache.Materials.end() || --materialIt->second.References > 0)
+				return;
+
+			gpuScene.RemoveMaterial(materialIt->second.Index);
+			cache.Materials.erase(materialIt);
+		}
+
+		void RemoveGpuSceneEntity(VulkanGpuScene& gpuScene, GpuSceneCache& cache, GpuSceneEntity& entity)
+		{
+			for (uint32_t instance : entity.Instances)
+				gpuScene.RemoveInstance(instance);
+			for (const void* key : entity.MaterialKeys)
+				ReleaseGpuSceneMaterial(gpuScene, cache, key);
+			entity.VertexArrays.clear();
+			entity.Instances.clear();
+			entity.MaterialKeys.clear();
+			entity.ComponentMaterial = nullptr;
+		}
+
+		// Adds one instance per mesh of the item.
+		void AddGpuSceneEntity(VulkanGpuScene& gpuScene, GpuSceneCache& cache, GpuSceneEntity& entity, const RenderItem& item)
+		{
+			const int32_t entityID = static_cast<int32_t>(static_cast<uint32_t>(item.EntityHandle));
+			entity.ComponentMaterial = item.Material;
+			entity.Transform = item.WorldTransform;
+			for (const auto& mesh : item.Mesh->model.meshes)
+			{
+				const void* key = AcquireGpuSceneMaterial(gpuScene, cache, item.Material, mesh);
+				entity.VertexArrays.push_back(mesh.GetVertexArray());
+				entity.MaterialKeys.push_back(key);
+				entity.Instances.push_back(gpuScene.AddInstance(
+					entity.VertexArrays.back(), item.WorldTransform, ComputeMeshBoundingSphere(mesh), cache.Materials[key].Index, entityID));
+			}
+		}
+
+		// False when the model's meshes were replaced, or a mesh had no pool range to draw from yet.
+		bool IsGpuSceneEntityCurrent(const GpuSceneEntity& entity, const Model& model)
+		{
+			if (entity.VertexArrays.size() != model.meshes.size())
+				return false;
+
+			for (size_t i = 0; i < model.meshes.size(); ++i)
+			{
+				if (entity.Instances[i] == VulkanGpuScene::InvalidHandle || entity.VertexArrays[i] != model.meshes[i].GetVertexArray())
+					return false;
+			}
+
+			return true;
+		}
+
+		void UpdateGpuSceneEntity(VulkanGpuScene& gpuScene, GpuSceneCache& cache, GpuSceneEntity& entity, const RenderItem& item)
+		{
+			if (entity.ComponentMaterial != item.Material)
+			{
+				const auto& meshes = item.Mesh->model.meshes;
+				for (size_t i = 0; i < meshes.size(); ++i)
+				{
+					const void* key = AcquireGpuSceneMaterial(gpuScene, cache, item.Material, meshes[i]);
+					ReleaseGpuSceneMaterial(gpuScene, cache, entity.MaterialKeys[i]);
+					entity.MaterialKeys[i] = key;
+				}
+				entity.ComponentMaterial = item.Material;
+			}
+			else if (entity.Transform == item.WorldTransform)
+			{
+				return;
+			}
+
+			entity.Transform = item.WorldTransform;
+			for (size_t i = 0; i < entity.Instances.size(); ++i)
+				gpuScene.UpdateInstance(entity.Instances[i], entity.Transform, cache.Materials[entity.MaterialKeys[i]].Index);
+		}
+
+		// Brings the GPU scene in line with this frame's GPU-driven items. Only entities that were
+		// added, removed or changed touch the scene, and Upload() only writes what they changed.
+		void SyncGpuScene(VulkanGpuScene& gpuScene, const RenderItemList& items)
+		{
+			SN_PROFILE_SCOPE("VulkanDeferredRenderer::SyncGpuScene");
+			GpuSceneCache& cache = GetGpuSceneCache();
+			++cache.Frame;
+			for (const RenderItem* item : items)
+			{
+				auto [entityIt, inserted] = cache.Entities.try_emplace(item->EntityHandle);
+				GpuSceneEntity& entity = entityIt->second;
+				entity.LastSeenFrame = cache.Frame;
+				if (inserted || !IsGpuSceneEntityCurrent(entity, item->Mesh->model))
+				{
+					RemoveGpuSceneEntity(gpuScene, cache, entity);
+					AddGpuSceneEntity(gpuScene, cache, entity, *item);
+					// New geometry asks for its textures right away rather than on its next turn.
+					TextureStreamer::RequestModelTextures(item->Mesh->model, item->Material.get(), item->WorldTransform);
+					continue;
+				}
+				UpdateGpuSceneEntity(gpuScene, cache, entity, *item);
+			}
+
+			// Entities missing from this frame were destroyed or left the GPU-driven path.
+			if (cache.Entities.size() > items.size())
+			{
+				for (auto entityIt = cache.Entities.begin(); entityIt != cache.Entities.end();)
+				{
+					if (entityIt->second.LastSeenFrame == cache.Frame)
+					{
+						++entityIt;
+						continue;
+					}
+					RemoveGpuSceneEntity(gpuScene, cache, entityIt->second);
+					entityIt = cache.Entities.erase(entityIt);
+				}
+			}
+
+			// Streamed textures move to new bindless slots, which the materials hold.
+			const uint64_t bindlessRevision = VulkanBindlessTextureTable::GetRevision();
+			if (cache.BindlessRevision != bindlessRevision)
+			{
+				for (const auto& [key, material] : cache.Materials)
+					gpuScene.UpdateMaterial(material.Index, MakeGpuSceneMaterial(material));
+				cache.BindlessRevision = bindlessRevision;
+			}
+
+			gpuScene.Upload();
+		}
+
+		// Requests the textures of a rotating slice of the GPU-driven items that are in the frustum,
+		// so that every item is visited once every kGpuTextureRequestInterval frames.
+		void RequestGpuSceneTextures(const RenderItemList& items, const FrustumPlanes& cameraFrustum)
+		{
+			SN_PROFILE_SCOPE("VulkanDeferredRenderer::RequestGpuSceneTextures");
+			if (items.empty())
+				return;
+
+			GpuSceneCache& cache = GetGpuSceneCache();
+			const size_t count = (items.size() + kGpuTextureRequestInterval - 1) / kGpuTextureRequestInterval;
+			size_t cursor = cache.TextureRequestCursor % items.size();
+			for (size_t i = 0; i < count; ++i)
+			{
+				const RenderItem& item = *items[cursor];
+				if (IsModelVisibleInCameraFrustum(item.Mesh->model, item.WorldTransform, cameraFrustum))
+					TextureStreamer::RequestModelTextures(item.Mesh->model, item.Material.get(), item.WorldTransform);
+				cursor = (cursor + 1) % items.size();
+			}
+			cache.TextureRequestCursor = cursor;
+		}
+
 	}
 
 	static VulkanDeferredRenderer::RenderData r_Data;
@@ -230,6 +675,19 @@ namespace Syndra {
 			r_Data.shadowShader = r_Data.shaders.Get("depth");
 		if (r_Data.shaders.Exists("FXAA"))
 			r_Data.fxaaShader = r_Data.shaders.Get("FXAA");
+		if (r_Data.shaders.Exists("InstanceCulling"))
+			r_Data.cullingShader = r_Data.shaders.Get("InstanceCulling");
+		if (r_Data.shaders.Exists("GeometryPassIndirect"))
+			r_Data.geometryIndirectShader = r_Data.shaders.Get("GeometryPassIndirect");
+		if (r_Data.shaders.Exists("depthIndirect"))
+			r_Data.shadowIndirectShader = r_Data.shaders.Get("depthIndirect");
+		if (r_Data.shaders.Exists("HiZBuild"))
+			r_Data.hiZBuildShader = r_Data.shaders.Get("HiZBuild");
+		// The instances the cache refers to belong to the scene being replaced.
+		GetGpuSceneCache() = {};
+		r_Data.gpuScene = CreateRef<VulkanGpuScene>();
+		r_Data.occlusionCuller = CreateRef<OcclusionCuller>();
+		r_Data.gpuProfiler = GpuProfiler::Create();
 
 		// Vulkan IBL uses an HDR equirectangular environment texture directly in the lighting pass.
 		auto LoadEnvironment = [&](const std::string& environmentPath)
@@ -237,7 +695,7 @@ namespace Syndra {
 			if (environmentPath.empty())
 				return;
 
-			r_Data.environmentMap = Texture2D::CreateHDR(environmentPath, false, true);
+			r_Data.environmentMap = TextureLibrary::LoadHDR(environmentPath);
 		};
 
 		if (r_Data.scene)
@@ -282,53 +740,84 @@ namespace Syndra {
 		r_Data.screenVao->SetIndexBuffer(ib);
 	}
 
-	void VulkanDeferredRenderer::Render()
+	void VulkanDeferredRenderer::Render(const SceneRenderView& view)
 	{
 		SN_PROFILE_SCOPE("VulkanDeferredRenderer::Render");
 		if (!r_Data.scene || !r_Data.geometryPass)
 			return;
 
-		auto view = r_Data.scene->m_Registry.view<TransformComponent, MeshComponent>();
-		struct RenderItem
-		{
-			entt::entity EntityHandle = entt::null;
-			MeshComponent* Mesh = nullptr;
-			MaterialComponent* Material = nullptr;
-			glm::mat4 WorldTransform = glm::mat4(1.0f);
-		};
-
-		std::vector<RenderItem> visibleItems;
-		visibleItems.reserve(view.size_hint());
+		if (r_Data.gpuProfiler)
+			r_Data.gpuProfiler->BeginFrame();
+
+		const bool gpuDriven = r_Data.useGpuDriven &&
+			r_Data.gpuScene &&
+			r_Data.cullingShader &&
+			r_Data.geometryIndirectShader &&
+			VulkanGpuScene::IsSupported();
+
+		// CPU-path items are culled here. GPU-driven items are all handed to the culling pass and only
+		// frustum tested here when they may occlude CPU-path items; their texture requests are spread
+		// over several frames (RequestGpuSceneTextures).
+		RenderItemList visibleItems;
+		RenderItemList gpuItems;
+		RenderItemList occluderItems;
+		// Frame memory: reserve up front, growing would leave the old storage behind.
+		visibleItems.reserve(view.Items.size());
+		if (gpuDriven)
+			gpuItems.reserve(view.Items.size());
+		if (r_Data.useOcclusionCulling)
+			occluderItems.reserve(view.Items.size());
 		r_Data.visibleMeshEntityCount = 0;
 		r_Data.culledMeshEntityCount = 0;
 
-		FrustumPlanes cameraFrustum{};
-		if (r_Data.scene->m_Camera)
-			cameraFrustum = BuildFrustumPlanes(r_Data.scene->m_Camera->GetViewProjection());
-
-		for (auto ent : view)
+		const FrustumPlanes cameraFrustum = BuildFrustumPlanes(view.Camera.GetViewProjection());
+		for (const auto& item : view.Items)
 		{
-			auto& meshComponent = view.get<MeshComponent>(ent);
-			if (meshComponent.path.empty())
-				continue;
+			const bool onGpu = gpuDriven && IsGpuDrivable(item, r_Data.geometryShader);
+			if (onGpu)
+			{
+				gpuItems.push_back(&item);
+				if (!r_Data.useOcclusionCulling)
+					continue;
+			}
 
-			const glm::mat4 worldTransform = r_Data.scene->GetWorldTransform(Entity{ ent });
-			if (r_Data.useFrustumCulling && r_Data.scene->m_Camera &&
-				!IsModelVisibleInCameraFrustum(meshComponent.model, worldTransform, cameraFrustum))
+			if (r_Data.useFrustumCulling &&
+				!IsModelVisibleInCameraFrustum(item.Mesh->model, item.WorldTransform, cameraFrustum))
 			{
-				++r_Data.culledMeshEntityCount;
+				if (!onGpu)
+					++r_Data.culledMeshEntityCount;
 				continue;
 			}
 
-			MaterialComponent* materialComponent = r_Data.scene->m_Registry.try_get<MaterialComponent>(ent);
-			visibleItems.push_back(RenderItem{ ent, &meshComponent, materialComponent, worldTransform });
+			if (r_Data.useOcclusionCulling)
+				occluderItems.push_back(&item);
+			if (onGpu)
+				continue;
+
+			visibleItems.push_back(&item);
+			++r_Data.visibleMeshEntityCount;
+			TextureStreamer::RequestModelTextures(item.Mesh->model, item.Material.get(), item.WorldTransform);
 		}
 
-		r_Data.visibleMeshEntityCount = static_cast<uint32_t>(visibleItems.size());
+		// Occlusion is only known for the camera, so the shadow pass keeps every visible item.
+		RenderItemList geometryItems = visibleItems;
+		if (r_Data.useOcclusionCulling && r_Data.occlusionCuller)
+			r_Data.occlusionCuller->Cull(view.Camera.GetViewProjection(), occluderItems, geometryItems);
+
+		r_Data.gpuDrivenMeshEntityCount = static_cast<uint32_t>(gpuItems.size());
+		SweepRetainedDraws();
+
+		if (gpuDriven)
+		{
+			r_Data.gpuScene->SetValidation(r_Data.validateGpuCulling);
+			SyncGpuScene(*r_Data.gpuScene, gpuItems);
+			RequestGpuSceneTextures(gpuItems, cameraFrustum);
+		}
 
 		if (r_Data.useShadows && r_Data.shadowPass && r_Data.shadowShader && r_Data.shadowUniformBuffer)
 		{
 			SN_PROFILE_SCOPE("VulkanDeferredRenderer::ShadowPass");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Shadow Pass");
 			glm::vec3 lightDirection = glm::vec3(r_Data.lightsData.dLight.direction);
 			if (glm::length(lightDirection) < 0.0001f)
 				lightDirection = glm::vec3(-0.6f, -1.0f, -0.35f);
@@ -355,24 +844,44 @@ namespace Syndra {
 			r_Data.shadowViewProjection = ConvertOpenGLClipToVulkanClip(lightViewProjection);
 			r_Data.shadowUniformBuffer->SetData(glm::value_ptr(r_Data.shadowViewProjection), sizeof(glm::mat4));
 
+			const bool gpuShadows = gpuDriven && r_Data.shadowIndirectShader;
+			if (gpuShadows)
+				r_Data.gpuScene->Cull(VulkanGpuScene::Pass::Shadow, r_Data.cullingShader, ToGpuPlanes(BuildFrustumPlanes(lightViewProjection)), r_Data.useFrustumCulling);
+
 			r_Data.shadowPass->BindTargetFrameBuffer();
 			RenderCommand::SetState(RenderState::DEPTH_TEST, true);
 			RenderCommand::SetClearColor(glm::vec4(1.0f));
 			RenderCommand::Clear();
 
 			r_Data.shadowShader->Bind();
-			for (const auto& item : visibleItems)
+			for (const RenderItem* item : visibleItems)
 			{
-				r_Data.shadowShader->SetMat4("push.u_trans", item.WorldTransform);
-				r_Data.shadowShader->SetInt("push.id", static_cast<uint32_t>(item.EntityHandle));
-				Renderer::Submit(r_Data.shadowShader, item.Mesh->model);
+				r_Data.shadowShader->SetMat4(kShadowTransformUniform, item->WorldTransform);
+				r_Data.shadowShader->SetInt(kShadowIdUniform, static_cast<uint32_t>(item->EntityHandle));
+				if (!r_Data.useDrawPackets ||
+					!DrawRetained(RetainedPass::Shadow, *item, r_Data.shadowShader, nullptr, kShadowTransformUniform, kShadowIdUniform))
+					Renderer::Submit(r_Data.shadowShader, item->Mesh->model);
 			}
 			r_Data.shadowShader->Unbind();
+
+			if (gpuShadows)
+			{
+				r_Data.shadowIndirectShader->Bind();
+				r_Data.gpuScene->Draw(VulkanGpuScene::Pass::Shadow);
+				r_Data.shadowIndirectShader->Unbind();
+			}
 			r_Data.shadowPass->UnbindTargetFrameBuffer();
 		}
 
 		{
 			SN_PROFILE_SCOPE("VulkanDeferredRenderer::GeometryPass");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Geometry Pass");
+			// The early phase tests against the pyramid of the previous frame; whatever it wrongly
+			// hides is recovered by the late phase below, so a stale pyramid only costs a second draw.
+			const bool hiZOcclusion = gpuDriven && r_Data.useHiZOcclusion && r_Data.hiZBuildShader;
+			if (gpuDriven)
+				r_Data.gpuScene->Cull(VulkanGpuScene::Pass::Geometry, r_Data.cullingShader, ToGpuPlanes(cameraFrustum), r_Data.useFrustumCulling, hiZOcclusion);
+
 			r_Data.geometryPass->BindTargetFrameBuffer();
 			RenderCommand::SetState(RenderState::DEPTH_TEST, true);
 			RenderCommand::SetClearColor(r_Data.geometryPass->GetSpecification().TargetFrameBuffer->GetSpecification().ClearColor);
@@ -382,38 +891,66 @@ namespace Syndra {
 			if (r_Data.geometryShader)
 				r_Data.geometryShader->Bind();
 
-			for (const auto& item : visibleItems)
+			for (const RenderItem* item : geometryItems)
 			{
-				if (item.Material)
+				if (item->Material)
 				{
 					if (r_Data.geometryShader)
 					{
-						r_Data.geometryShader->SetInt("transform.id", static_cast<uint32_t>(item.EntityHandle));
-						r_Data.geometryShader->SetMat4("transform.u_trans", item.WorldTransform);
+						r_Data.geometryShader->SetInt(kTransformIdUniform, static_cast<uint32_t>(item->EntityHandle));
+						r_Data.geometryShader->SetMat4(kTransformUniform, item->WorldTransform);
 					}
-					Renderer::Submit(item.Material->m_Material, item.Mesh->model);
+					Material& material = *item->Material;
+					if (!r_Data.useDrawPackets ||
+						!DrawRetained(RetainedPass::Geometry, *item, material.GetShader(), &material, kTransformUniform, kTransformIdUniform))
+						Renderer::Submit(material, item->Mesh->model);
 				}
 				else if (r_Data.geometryShader)
 				{
-					r_Data.geometryShader->SetInt("transform.id", static_cast<uint32_t>(item.EntityHandle));
-					r_Data.geometryShader->SetMat4("transform.u_trans", item.WorldTransform);
-					r_Data.geometryShader->SetFloat4("push.material.color", glm::vec4(0.8f, 0.8f, 0.8f, 1.0f));
-					r_Data.geometryShader->SetFloat("push.material.RoughnessFactor", 0.6f);
-					r_Data.geometryShader->SetFloat("push.material.MetallicFactor", 0.0f);
-					r_Data.geometryShader->SetFloat("push.material.AO", 1.0f);
-					r_Data.geometryShader->SetFloat("push.tiling", 1.0f);
-					r_Data.geometryShader->SetInt("push.HasAlbedoMap", 0);
-					r_Data.geometryShader->SetInt("push.HasNormalMap", 0);
-					r_Data.geometryShader->SetInt("push.HasRoughnessMap", 0);
-					r_Data.geometryShader->SetInt("push.HasMetallicMap", 0);
-					r_Data.geometryShader->SetInt("push.HasAOMap", 0);
-					Renderer::Submit(r_Data.geometryShader, item.Mesh->model);
+					r_Data.geometryShader->SetInt(kTransformIdUniform, static_cast<uint32_t>(item->EntityHandle));
+					r_Data.geometryShader->SetMat4(kTransformUniform, item->WorldTransform);
+					r_Data.geometryShader->SetFloat4(kMaterialColorUniform, glm::vec4(0.8f, 0.8f, 0.8f, 1.0f));
+					r_Data.geometryShader->SetFloat(kMaterialRoughnessUniform, 0.6f);
+					r_Data.geometryShader->SetFloat(kMaterialMetallicUniform, 0.0f);
+					r_Data.geometryShader->SetFloat(kMaterialAOUniform, 1.0f);
+					r_Data.geometryShader->SetFloat(kTilingUniform, 1.0f);
+					if (!r_Data.useDrawPackets ||
+						!DrawRetained(RetainedPass::Geometry, *item, r_Data.geometryShader, nullptr, kTransformUniform, kTransformIdUniform))
+						Renderer::Submit(r_Data.geometryShader, item->Mesh->model);
 				}
 			}
 
 			if (r_Data.geometryShader)
 				r_Data.geometryShader->Unbind();
+
+			if (gpuDriven)
+			{
+				r_Data.geometryIndirectShader->Bind();
+				r_Data.gpuScene->Draw(VulkanGpuScene::Pass::Geometry);
+				r_Data.geometryIndirectShader->Unbind();
+			}
 			r_Data.geometryPass->UnbindTargetFrameBuffer();
+
+			if (hiZOcclusion)
+			{
+				SN_PROFILE_SCOPE("VulkanDeferredRenderer::LateGeometryPass");
+				SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "Late Geometry Pass");
+				const Ref<FrameBuffer>& geometryTarget = r_Data.geometryPass->GetSpecification().TargetFrameBuffer;
+				r_Data.gpuScene->GetHiZ().Build(
+					r_Data.hiZBuildShader,
+					geometryTarget->GetDepthAttachmentRendererID(),
+					geometryTarget->GetSpecification().Width,
+					geometryTarget->GetSpecification().Height,
+					ConvertOpenGLClipToVulkanClip(view.Camera.GetViewProjection()));
+				r_Data.gpuScene->Cull(VulkanGpuScene::Pass::GeometryLate, r_Data.cullingShader, ToGpuPlanes(cameraFrustum), r_Data.useFrustumCulling);
+
+				// Drawn on top of the early phase, without clearing.
+				r_Data.geometryPass->BindTargetFrameBuffer();
+				r_Data.geometryIndirectShader->Bind();
+				r_Data.gpuScene->Draw(VulkanGpuScene::Pass::GeometryLate);
+				r_Data.geometryIndirectShader->Unbind();
+				r_Data.geometryPass->UnbindTargetFrameBuffer();
+			}
 		}
 	}
 
@@ -423,6 +960,8 @@ namespace Syndra {
 		if (!r_Data.lightingPass)
 			return;
 
+		if (r_Data.gpuProfiler)
+			r_Data.gpuProfiler->BeginScope("Lighting Pass");
 		r_Data.lightingPass->BindTargetFrameBuffer();
 		RenderCommand::SetState(RenderState::DEPTH_TEST, false);
 		RenderCommand::SetClearColor(r_Data.lightingPass->GetSpecification().TargetFrameBuffer->GetSpecification().ClearColor);
@@ -456,10 +995,13 @@ namespace Syndra {
 		}
 
 		r_Data.lightingPass->UnbindTargetFrameBuffer();
+		if (r_Data.gpuProfiler)
+			r_Data.gpuProfiler->EndScope();
 
 		if (r_Data.useFxaa && r_Data.aaPass && r_Data.fxaaShader && r_Data.screenVao)
 		{
 			SN_PROFILE_SCOPE("VulkanDeferredRenderer::FXAAPass");
+			SN_GPU_PROFILE_SCOPE(r_Data.gpuProfiler, "FXAA Pass");
 			r_Data.aaPass->BindTargetFrameBuffer();
 			RenderCommand::SetState(RenderState::DEPTH_TEST, false);
 			RenderCommand::SetClearColor(r_Data.aaPass->GetSpecification().TargetFrameBuffer->GetSpecification().ClearColor);
@@ -476,15 +1018,19 @@ namespace Syndra {
 			r_Data.aaPass->UnbindTargetFrameBuffer();
 		}
 
+		if (r_Data.gpuProfiler)
+			r_Data.gpuProfiler->EndFrame();
 		Renderer::EndScene();
 	}
 
 	void VulkanDeferredRenderer::ShutDown()
 	{
+		GetRetainedDrawCache().Items.clear();
+		GetGpuSceneCache() = {};
 		r_Data = {};
 	}
 
-	void VulkanDeferredRenderer::UpdateLights()
+	void VulkanDeferredRenderer::UpdateLights(const SceneRenderView& view)
 	{
 		SN_PROFILE_SCOPE("VulkanDeferredRenderer::UpdateLights");
 		r_Data.directionalLightCount = 0;
@@ -494,15 +1040,13 @@ namespace Syndra {
 		if (!r_Data.scene)
 			return;
 
-		auto viewLights = r_Data.scene->m_Registry.view<TransformComponent, LightComponent>();
 		uint32_t pointIndex = 0;
-		for (auto ent : viewLights)
+		for (const auto& light : view.Lights)
 		{
-			const auto& light = viewLights.get<LightComponent>(ent);
-			const glm::vec3 worldTranslation = r_Data.scene->GetWorldTranslation(Entity{ ent });
-			if (light.type == LightType::Directional)
+			const glm::vec3& worldTranslation = light.Position;
+			if (light.Type == LightType::Directional)
 			{
-				auto directional = reinterpret_cast<DirectionalLight*>(light.light.get());
+				auto directional = reinterpret_cast<DirectionalLight*>(light.Light.get());
 				if (directional)
 				{
 					r_Data.lightsData.dLight.direction = glm::vec4(directional->GetDirection(), 0.0f);
@@ -510,9 +1054,9 @@ namespace Syndra {
 				}
 				++r_Data.directionalLightCount;
 			}
-			if (light.type == LightType::Point)
+			if (light.Type == LightType::Point)
 			{
-				auto point = reinterpret_cast<PointLight*>(light.light.get());
+				auto point = reinterpret_cast<PointLight*>(light.Light.get());
 				if (point && pointIndex < 4)
 				{
 					r_Data.lightsData.pLight[pointIndex].position = glm::vec4(worldTranslation, 1.0f);
@@ -561,6 +1105,11 @@ namespace Syndra {
 			r_Data.aaPass->GetSpecification().TargetFrameBuffer->Resize(width, height);
 	}
 
+	void VulkanDeferredRenderer::SetHiZOcclusion(bool enabled)
+	{
+		r_Data.useHiZOcclusion = enabled;
+	}
+
 	void VulkanDeferredRenderer::OnImGuiRender(bool* rendererOpen, bool* environmentOpen)
 	{
 		if (rendererOpen && *rendererOpen)
@@ -569,11 +1118,85 @@ namespace Syndra {
 			ImGui::Text("Vulkan Deferred Renderer");
 			ImGui::Text("Directional lights: %u", r_Data.directionalLightCount);
 			ImGui::Text("Point lights: %u", r_Data.pointLightCount);
-			ImGui::Text("Visible mesh entities: %u", r_Data.visibleMeshEntityCount);
-			ImGui::Text("Culled mesh entities: %u", r_Data.culledMeshEntityCount);
+			ImGui::Text("Visible mesh entities (CPU path): %u", r_Data.visibleMeshEntityCount);
+			ImGui::Text("Culled mesh entities (CPU path): %u", r_Data.culledMeshEntityCount);
 			ImGui::Checkbox("Shadows", &r_Data.useShadows);
 			ImGui::Checkbox("FXAA", &r_Data.useFxaa);
 			ImGui::Checkbox("Frustum Culling", &r_Data.useFrustumCulling);
+			ImGui::Checkbox("Occlusion Culling", &r_Data.useOcclusionCulling);
+			if (r_Data.useOcclusionCulling && r_Data.occlusionCuller)
+			{
+				const OcclusionCuller::Stats& occlusionStats = r_Data.occlusionCuller->GetStats();
+				ImGui::Text("Occluded: %u of %u by %u occluders (%u triangles)", occlusionStats.Occluded, occlusionStats.Tested, occlusionStats.Occluders, occlusionStats.OccluderTriangles);
+				ImGui::Text("Occlusion raster %.2f ms, test %.2f ms", occlusionStats.RasterMs, occlusionStats.TestMs);
+			}
+			bool parallelRecording = VulkanRendererAPI::IsParallelRecordingEnabled();
+			if (ImGui::Checkbox("Parallel Command Recording", &parallelRecording))
+				VulkanRendererAPI::SetParallelRecording(parallelRecording);
+			const VulkanRendererAPI::RecordingStats recordingStats = VulkanRendererAPI::GetRecordingStats();
+			ImGui::Text("Recorded draws: %u in %u batches (%u parallel)", recordingStats.Draws, recordingStats.Batches, recordingStats.ParallelBatches);
+			ImGui::Text("Secondary command buffers: %u, recording %.2f ms", recordingStats.SecondaryCommandBuffers, recordingStats.RecordMs);
+			ImGui::Checkbox("Retained Draw Packets", &r_Data.useDrawPackets);
+			ImGui::Text("Packet draws: %u, rebuilt: %u", recordingStats.PacketDraws, recordingStats.PacketBuilds);
+			ImGui::Text("Uniform ring: %.1f KiB this frame", static_cast<double>(recordingStats.UniformBytes) / 1024.0);
+			ImGui::Text("Descriptor set allocations: %u", recordingStats.DescriptorSetAllocations);
+			ImGui::Text("Bindless textures: %u / %u", VulkanBindlessTextureTable::GetResidentCount(), VulkanBindlessTextureTable::GetCapacity());
+			if (VulkanGpuScene::IsSupported())
+			{
+				ImGui::Checkbox("GPU-Driven Rendering", &r_Data.useGpuDriven);
+				ImGui::Checkbox("Validate GPU Culling", &r_Data.validateGpuCulling);
+				ImGui::Checkbox("Hi-Z Occlusion Culling", &r_Data.useHiZOcclusion);
+				if (r_Data.gpuScene)
+				{
+					const VulkanGpuScene::Stats& gpuStats = r_Data.gpuScene->GetStats();
+					ImGui::Text("GPU-driven entities: %u, instances: %u in %u batches, %u indirect draws",
+						r_Data.gpuDrivenMeshEntityCount,
+						gpuStats.Instances,
+						gpuStats.Batches,
+						recordingStats.IndirectDraws);
+					ImGui::Text("Uploaded this frame: %u instances, %u materials", gpuStats.UploadedInstances, gpuStats.UploadedMaterials);
+					if (r_Data.validateGpuCulling)
+					{
+						ImGui::Text("GPU/CPU visible: shadow %u/%u, geometry %u/%u (%u of %u frames differ)",
+							gpuStats.GpuVisible[0], gpuStats.CpuVisible[0],
+							gpuStats.GpuVisible[1], gpuStats.CpuVisible[1],
+							gpuStats.MismatchedFrames, gpuStats.ValidatedFrames);
+					}
+					if (r_Data.useHiZOcclusion)
+					{
+						VulkanHiZPyramid& hiZ = r_Data.gpuScene->GetHiZ();
+						ImGui::Text("Hi-Z occluded: %u instances, %llu triangles not drawn",
+							gpuStats.Occluded,
+							static_cast<unsigned long long>(gpuStats.OccludedTriangles));
+						ImGui::Text("Early phase hid %u, late phase recovered %u; pyramid %u levels, %.1f MiB",
+							gpuStats.EarlyOccluded,
+							gpuStats.LateVisible,
+							hiZ.GetLevelCount(),
+							static_cast<double>(hiZ.GetSize()) / (1024.0 * 1024.0));
+					}
+				}
+			}
+			else
+			{
+				ImGui::TextDisabled("GPU-driven rendering: indirect count draws unsupported");
+			}
+			const auto showGeometryPool = [](const char* label, const VulkanGeometryPool::Stats& stats)
+			{
+				ImGui::Text("%s pool: %.1f / %.1f MiB in %u blocks, %u ranges, fragmentation %.0f%%",
+					label,
+					static_cast<double>(stats.Used) / (1024.0 * 1024.0),
+					static_cast<double>(stats.Capacity) / (1024.0 * 1024.0),
+					stats.Blocks,
+					stats.Allocations,
+					stats.Fragmentation * 100.0f);
+			};
+			showGeometryPool("Vertex", VulkanGeometryPool::GetVertexPool().GetStats());
+			showGeometryPool("Index", VulkanGeometryPool::GetIndexPool().GetStats());
+			if (ImGui::Button("Defragment Geometry"))
+			{
+				VulkanGeometryPool::GetVertexPool().Defragment();
+				VulkanGeometryPool::GetIndexPool().Defragment();
+			}
 			ImGui::DragFloat("Exposure", &r_Data.exposure, 0.01f, 0.01f, 8.0f);
 			ImGui::DragFloat("Gamma", &r_Data.gamma, 0.01f, 0.5f, 4.0f);
 			ImGui::DragFloat("Intensity", &r_Data.intensity, 0.01f, 0.0f, 8.0f);
@@ -607,7 +1230,7 @@ namespace Syndra {
 				auto path = FileDialogs::OpenFile("HDR (*.hdr)\0*.hdr\0");
 				if (path)
 				{
-					r_Data.environmentMap = Texture2D::CreateHDR(*path, false, true);
+					r_Data.environmentMap = TextureLibrary::LoadHDR(*path);
 					if (r_Data.scene)
 						r_Data.scene->m_EnvironmentPath = *path;
 				}
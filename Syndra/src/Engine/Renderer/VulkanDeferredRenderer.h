@@ -4,19 +4,24 @@
 
 namespace Syndra {
 
+	class GpuProfiler;
+	class OcclusionCuller;
+	class VulkanGpuScene;
+
 	class VulkanDeferredRenderer : public RenderPipeline
 	{
 	public:
 		void Init(const Ref<Scene>& scene, const ShaderLibrary& shaders, const Ref<Environment>& env) override;
-		void Render() override;
+		void Render(const SceneRenderView& view) override;
 		void End() override;
 		void ShutDown() override;
-		void UpdateLights() override;
+		void UpdateLights(const SceneRenderView& view) override;
 		uint32_t GetFinalTextureID(int index) override;
 		uint32_t GetMouseTextureID() override;
 		Ref<FrameBuffer> GetMainFrameBuffer() override;
 		void OnResize(uint32_t width, uint32_t height) override;
 		void OnImGuiRender(bool* rendererOpen, bool* environmentOpen) override;
+		void SetHiZOcclusion(bool enabled) override;
 
 	public:
 		struct RenderData
@@ -45,10 +50,19 @@ namespace Syndra {
 			bool useShadows = true;
 			bool useIBL = true;
 			bool useFrustumCulling = true;
+			// Drop CPU-path items hidden behind large occluders from the geometry pass.
+			bool useOcclusionCulling = false;
+			bool useDrawPackets = true;
+			// Cull and draw on the GPU with indirect count draws where the device supports it.
+			bool useGpuDriven = true;
+			bool validateGpuCulling = false;
+			// Two-phase occlusion culling of GPU-driven instances against a Hi-Z pyramid of the G-buffer depth.
+			bool useHiZOcclusion = true;
 			uint32_t directionalLightCount = 0;
 			uint32_t pointLightCount = 0;
 			uint32_t visibleMeshEntityCount = 0;
 			uint32_t culledMeshEntityCount = 0;
+			uint32_t gpuDrivenMeshEntityCount = 0;
 			uint32_t shadowMapSize = 2048;
 			float exposure = 1.0f;
 			float gamma = 2.2f;
@@ -63,6 +77,13 @@ namespace Syndra {
 			Ref<Shader> lightingShader;
 			Ref<Shader> shadowShader;
 			Ref<Shader> fxaaShader;
+			Ref<Shader> cullingShader;
+			Ref<Shader> geometryIndirectShader;
+			Ref<Shader> shadowIndirectShader;
+			Ref<Shader> hiZBuildShader;
+			Ref<VulkanGpuScene> gpuScene;
+			Ref<OcclusionCuller> occlusionCuller;
+			Ref<GpuProfiler> gpuProfiler;
 			Ref<UniformBuffer> lightsUniformBuffer;
 			Ref<UniformBuffer> shadowUniformBuffer;
 			LightsData lightsData;
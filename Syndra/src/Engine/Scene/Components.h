@@ -122,6 +122,10 @@ namespace Syndra {
 	struct MaterialComponent
 	{
 		Material m_Material;
+		// Copy of m_Material handed to the render thread; SceneRenderer replaces it whenever the
+		// binding hash of m_Material changes.
+		Ref<Material> RenderSnapshot;
+		size_t RenderSnapshotHash = 0;
 
 		MaterialComponent() = default;
 		MaterialComponent(const MaterialComponent& material) = default;
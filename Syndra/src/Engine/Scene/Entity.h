@@ -1,7 +1,8 @@
 #pragma once
 
 #include "entt.hpp"
-#include "Engine/Scene/scene.h"
+#include "Engine/Scene/Scene.h"
+#include "Engine/Renderer/RenderThread.h"
 
 namespace Syndra {
 
@@ -20,8 +21,11 @@ namespace Syndra {
 		T& AddComponent(Args&&... args)
 		{
 			SN_CORE_ASSERT(!HasComponent<T>(), "Entity already has component!");
+			// Frame packets point into the component pools, which may grow here.
+			RenderThread::Synchronize();
 			T& component = s_Scene->m_Registry.emplace<T>(m_EntityID, std::forward<Args>(args)...);
 			s_Scene->OnComponentAdded<T>(*this, component);
+			s_Scene->Invalidate();
 			return component;
 		}
 
@@ -42,7 +46,9 @@ namespace Syndra {
 		void RemoveComponent()
 		{
 			SN_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			RenderThread::Synchronize();
 			s_Scene->m_Registry.remove<T>(m_EntityID);
+			s_Scene->Invalidate();
 		}
 
 		bool operator ==(const Entity& other) const {
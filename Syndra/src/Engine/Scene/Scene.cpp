@@ -3,8 +3,10 @@
 
 #include "Engine/Scene/Entity.h"
 #include "Engine/Scene/Components.h"
+#include "Engine/Core/Application.h"
 #include "Engine/Core/Instrument.h"
 #include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/RenderThread.h"
 
 #include <algorithm>
 
@@ -12,6 +14,13 @@ namespace Syndra {
 
 	namespace
 	{
+		// Dense storage of each pool: the packed entity array plus the components themselves.
+		template<typename... Component>
+		uint64_t GetComponentStorageBytes(const entt::registry& registry)
+		{
+			return (... + (static_cast<uint64_t>(registry.capacity<Component>()) * (sizeof(Component) + sizeof(entt::entity))));
+		}
+
 		void RemoveChildReference(RelationshipComponent& relationship, entt::entity child)
 		{
 			auto it = std::remove(relationship.Children.begin(), relationship.Children.end(), child);
@@ -135,6 +144,7 @@ namespace Syndra {
 		const auto it = std::find(m_EntitiesPendingDestroy.begin(), m_EntitiesPendingDestroy.end(), handle);
 		if (it == m_EntitiesPendingDestroy.end())
 			m_EntitiesPendingDestroy.push_back(handle);
+		Invalidate();
 	}
 
 	void Scene::DestroyEntityRecursive(const Entity& entity)
@@ -223,6 +233,7 @@ namespace Syndra {
 			}
 		}
 
+		RenderThread::Synchronize();
 		if (requiresGpuIdle)
 			RenderCommand::WaitForIdle();
 
@@ -264,6 +275,7 @@ namespace Syndra {
 		auto& parentRelationship = m_Registry.get<RelationshipComponent>(parent);
 		childRelationship.Parent = static_cast<entt::entity>(parent);
 		parentRelationship.Children.push_back(static_cast<entt::entity>(child));
+		Invalidate();
 	}
 
 	void Scene::Unparent(const Entity& child)
@@ -284,6 +296,7 @@ namespace Syndra {
 		}
 
 		childRelationship.Parent = entt::null;
+		Invalidate();
 	}
 
 	Entity Scene::GetParent(const Entity& entity) const
@@ -328,6 +341,7 @@ namespace Syndra {
 	void Scene::OnUpdateRuntime(Timestep ts)
 	{
 		ProcessPendingEntityDestruction();
+		UpdateComponentMemory();
 
 	}
 
@@ -335,11 +349,39 @@ namespace Syndra {
 	{
 		SN_PROFILE_SCOPE("Scene::OnUpdateEditor");
 		ProcessPendingEntityDestruction();
+		UpdateComponentMemory();
+		// Read before rendering: an invalidation while the frame is built must cause another one.
+		m_RenderedInvalidationCount = SceneRenderer::GetInvalidationCount();
+		m_RenderedViewProjection = m_Camera->GetViewProjection();
+		m_Dirty = false;
 		SceneRenderer::BeginScene(*m_Camera);
 		SceneRenderer::RenderScene();
 		SceneRenderer::EndScene();
 	}
 
+	void Scene::Invalidate()
+	{
+		m_Dirty = true;
+		Application::RequestRedraw();
+	}
+
+	bool Scene::IsDirty() const
+	{
+		return m_Dirty ||
+			!m_EntitiesPendingDestroy.empty() ||
+			m_RenderedInvalidationCount != SceneRenderer::GetInvalidationCount() ||
+			m_RenderedViewProjection != m_Camera->GetViewProjection();
+	}
+
+	void Scene::UpdateComponentMemory()
+	{
+		const uint64_t bytes =
+			GetComponentStorageBytes<TagComponent, TransformComponent, RelationshipComponent, MeshComponent,
+				CameraComponent, LightComponent, MaterialComponent>(m_Registry) +
+			static_cast<uint64_t>(m_Registry.capacity()) * sizeof(entt::entity);
+		m_ComponentMemory.Set(bytes);
+	}
+
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
 	{
 		m_ViewportWidth = width;
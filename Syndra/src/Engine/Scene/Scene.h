@@ -1,5 +1,6 @@
 #pragma once
 #include "entt.hpp"
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Core/Timestep.h"
 #include "Engine/Renderer/PerspectiveCamera.h"
 #include "Engine/Renderer/FrameBuffer.h"
@@ -41,8 +42,17 @@ namespace Syndra {
 
 		void OnUpdateRuntime(Timestep ts);
 		void OnUpdateEditor(Timestep ts);
+		// On-demand rendering: the editor redraws the viewport only while the scene is dirty.
+		// Adding or removing components, destroying entities and reparenting invalidate the scene
+		// themselves; code that edits component data in place calls Invalidate().
+		void Invalidate();
+		// True when the last image OnUpdateEditor() rendered is out of date: the scene was
+		// invalidated, the editor camera moved or SceneRenderer::Invalidate() was called since.
+		bool IsDirty() const;
 		void OnViewportResize(uint32_t width, uint32_t height);
 		void OnCameraUpdate(Timestep ts) { m_Camera->OnUpdate(ts); }
+		// The editor camera OnUpdateEditor() renders with; tools drive it directly (Syndra-Bench).
+		PerspectiveCamera& GetEditorCamera() { return *m_Camera; }
 
 		uint32_t GetMainTextureID() { return SceneRenderer::GetTextureID(0); }
 		Ref<FrameBuffer> GetMainFrameBuffer() { return SceneRenderer::GetMainFrameBuffer(); }
@@ -57,9 +67,16 @@ namespace Syndra {
 		void DestroyEntityRecursive(const Entity& entity);
 		bool HasRenderableResourcesInHierarchy(const Entity& entity) const;
 		void ProcessPendingEntityDestruction();
+		// Reports the registry's storage to the memory tracker, once a frame.
+		void UpdateComponentMemory();
 
 	private:
 		entt::registry m_Registry;
+		TrackedMemory m_ComponentMemory{ MemoryDomain::Cpu, MemoryCategory::Components };
+
+		bool m_Dirty = true;
+		uint64_t m_RenderedInvalidationCount = 0;
+		glm::mat4 m_RenderedViewProjection = glm::mat4(0.0f);
 
 		std::vector<Ref<Entity>> m_Entities;
 		std::vector<entt::entity> m_EntitiesPendingDestroy;
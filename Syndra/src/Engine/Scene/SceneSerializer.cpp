@@ -3,6 +3,7 @@
 
 #include "Engine/Scene/Entity.h"
 #include "Engine/Scene/Components.h"
+#include "Engine/Renderer/TextureLibrary.h"
 #include "Engine/Utils/PlatformUtils.h"
 
 #include <fstream>
@@ -347,7 +348,7 @@ namespace Syndra {
 				if (tagComponent)
 					name = tagComponent["Tag"].as<std::string>();
 
-				SN_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
+				SN_CORE_TRACE_LIMITED("Deserialized entity with ID = {0}, name = {1}", uuid, name);
 
 				auto deserializedEntity = m_Scene->CreateEntity(name);
 				deserializedEntitiesById[uuid] = *deserializedEntity;
@@ -488,7 +489,7 @@ namespace Syndra {
 							auto binding = texture["binding"].as<uint32_t>();
 							auto texturePath = texture["path"].as<std::string>();
 							if (!texturePath.empty()) {
-								materialTextures[binding] = Texture2D::Create(texturePath);
+								materialTextures[binding] = TextureLibrary::Load(texturePath);
 							}
 						}
 					}
@@ -12,4 +12,11 @@ namespace Syndra {
 		static std::optional<std::string> SaveFile(const char* filter);
 	};
 
+	class ProcessInfo
+	{
+	public:
+		// CPU time the process has used on all of its threads, user and kernel, in seconds.
+		static double GetCpuTime();
+	};
+
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "lpch.h"
+#include "Platform/Headless/HeadlessWindow.h"
+
+#include "Engine/Core/Instrument.h"
+#include "Engine/Renderer/RendererAPI.h"
+#include "Platform/Null/NullContext.h"
+#include "Platform/Vulkan/VulkanContext.h"
+#ifdef SN_PLATFORM_LINUX
+#include "Platform/OpenGL/OpenGLHeadlessContext.h"
+#endif
+
+namespace Syndra {
+
+	HeadlessWindow::HeadlessWindow(const WindowProps& props)
+	{
+		m_Data.Title = props.Title;
+		m_Data.Width = props.Width;
+		m_Data.Height = props.Height;
+		SN_CORE_INFO("Creating headless window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+#ifdef SN_PLATFORM_LINUX
+			m_Context = new OpenGLHeadlessContext();
+#else
+			SN_CORE_ERROR("Headless OpenGL needs a surfaceless EGL display, which is only set up on Linux.");
+#endif
+			break;
+		case RendererAPI::API::Vulkan:
+			m_Context = new VulkanContext(nullptr);
+			break;
+		case RendererAPI::API::Null:
+			m_Context = new NullContext();
+			break;
+		case RendererAPI::API::NONE:
+		default:
+			SN_CORE_ASSERT(false, "Unsupported RendererAPI for window context.");
+			break;
+		}
+		SN_CORE_ASSERT(m_Context, "Could not create graphics context.");
+
+		if (m_Context)
+			m_Context->Init();
+	}
+
+	HeadlessWindow::~HeadlessWindow()
+	{
+		delete m_Context;
+		m_Context = nullptr;
+	}
+
+	void HeadlessWindow::BeginFrame()
+	{
+		if (m_Context)
+			m_Context->BeginFrame();
+	}
+
+	void HeadlessWindow::EndFrame()
+	{
+		if (m_Context)
+		{
+			SN_PROFILE_SCOPE("swap buffers");
+			m_Context->EndFrame();
+		}
+	}
+
+	void HeadlessWindow::MakeContextCurrent()
+	{
+		if (m_Context)
+			m_Context->MakeCurrent();
+	}
+
+	void HeadlessWindow::ReleaseContext()
+	{
+		if (m_Context)
+			m_Context->ReleaseCurrent();
+	}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Engine/Core/Window.h"
+#include "Engine/Renderer/GraphicsContext.h"
+
+namespace Syndra {
+
+	// A window without a native surface, for running the renderer offscreen. It owns a headless
+	// graphics context (Vulkan without a surface, or a surfaceless EGL context for OpenGL), never
+	// sends events and keeps the size it was created with.
+	class HeadlessWindow : public Window
+	{
+	public:
+		HeadlessWindow(const WindowProps& props);
+		virtual ~HeadlessWindow();
+
+		void OnUpdate() override {}
+		void BeginFrame() override;
+		void EndFrame() override;
+		void MakeContextCurrent() override;
+		void ReleaseContext() override;
+
+		unsigned int GetWidth() const override { return m_Data.Width; }
+		unsigned int GetHeight() const override { return m_Data.Height; }
+
+		void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
+		void SetVSync(bool enabled) override { m_Data.VSync = enabled; }
+		bool IsVSync() const override { return m_Data.VSync; }
+
+		void* GetNativeWindow() const override { return nullptr; }
+
+		void SetTitle(const std::string& title) override { m_Data.Title = title; }
+
+	private:
+		GraphicsContext* m_Context = nullptr;
+
+		struct WindowData
+		{
+			std::string Title;
+			unsigned int Width, Height;
+			bool VSync = false;
+
+			EventCallbackFn EventCallback;
+		};
+
+		WindowData m_Data;
+	};
+
+}
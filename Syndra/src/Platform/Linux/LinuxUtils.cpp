@@ -0,0 +1,37 @@
+#include "lpch.h"
+#include "Engine/Utils/PlatformUtils.h"
+
+#include <sys/resource.h>
+
+namespace Syndra {
+
+	// There is no native file dialog on Linux yet; the tools that run there (Syndra-Bench) take
+	// their paths from the command line.
+	std::optional<std::string> FileDialogs::OpenFile(const char* filter)
+	{
+		(void)filter;
+		SN_CORE_WARN("File dialogs are not implemented on Linux.");
+		return std::nullopt;
+	}
+
+	std::optional<std::string> FileDialogs::SaveFile(const char* filter)
+	{
+		(void)filter;
+		SN_CORE_WARN("File dialogs are not implemented on Linux.");
+		return std::nullopt;
+	}
+
+	double ProcessInfo::GetCpuTime()
+	{
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0.0;
+
+		const auto seconds = [](const timeval& time)
+		{
+			return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) * 1e-6;
+		};
+		return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+	}
+
+}
@@ -0,0 +1,19 @@
+#include "lpch.h"
+#include "Platform/Null/NullBuffer.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+namespace Syndra {
+
+	NullVertexBuffer::NullVertexBuffer(float* vertices, uint32_t size)
+		: m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::UploadBuffer, m_RendererID, size);
+	}
+
+	NullIndexBuffer::NullIndexBuffer(uint32_t* indices, uint32_t count)
+		: m_RendererID(NullRendererAPI::AllocateRendererID()), m_Count(count)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::UploadBuffer, m_RendererID, static_cast<uint64_t>(count) * sizeof(uint32_t));
+	}
+
+}
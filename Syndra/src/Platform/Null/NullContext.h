@@ -0,0 +1,18 @@
+#pragma once
+#include "Engine/Renderer/GraphicsContext.h"
+
+namespace Syndra {
+
+	// Context of the Null renderer: there is no device or surface, so frames begin and end
+	// immediately. Used by headless windows only.
+	class NullContext : public GraphicsContext
+	{
+	public:
+		NullContext() = default;
+
+		virtual void Init() override {}
+		virtual void BeginFrame() override {}
+		virtual void EndFrame() override {}
+	};
+
+}
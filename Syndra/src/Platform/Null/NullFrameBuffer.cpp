@@ -0,0 +1,74 @@
+#include "lpch.h"
+#include "Platform/Null/NullFrameBuffer.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+namespace Syndra {
+
+	static const uint32_t s_MaxFramebufferSize = 8192;
+
+	NullFrameBuffer::NullFrameBuffer(const FramebufferSpecification& spec)
+		: m_RendererID(NullRendererAPI::AllocateRendererID()), m_Specification(spec)
+	{
+		for (const FramebufferTextureSpecification& attachment : m_Specification.Attachments.Attachments)
+		{
+			switch (attachment.TextureFormat)
+			{
+			case FramebufferTextureFormat::DEPTH24STENCIL8:
+			case FramebufferTextureFormat::DEPTH32:
+				m_DepthAttachment = NullRendererAPI::AllocateRendererID();
+				break;
+			case FramebufferTextureFormat::Cubemap:
+				m_CubemapAttachment = NullRendererAPI::AllocateRendererID();
+				break;
+			case FramebufferTextureFormat::None:
+				break;
+			default:
+				m_ColorAttachments.push_back(NullRendererAPI::AllocateRendererID());
+				break;
+			}
+		}
+	}
+
+	void NullFrameBuffer::Bind()
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::BindFrameBuffer, m_RendererID);
+	}
+
+	void NullFrameBuffer::Unbind()
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::BindFrameBuffer, 0);
+	}
+
+	void NullFrameBuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
+		{
+			SN_CORE_ERROR("Attempted to rezize framebuffer to {0}, {1}", width, height);
+			return;
+		}
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+	}
+
+	void NullFrameBuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+	{
+		SN_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment index should be less than size!");
+		NullRendererAPI::Record(NullRendererAPI::CommandType::ClearAttachment, m_ColorAttachments[attachmentIndex], static_cast<uint32_t>(value));
+	}
+
+	uint32_t NullFrameBuffer::GetColorAttachmentRendererID(uint32_t index) const
+	{
+		if (m_ColorAttachments.empty())
+			return m_CubemapAttachment;
+
+		SN_CORE_ASSERT(index < m_ColorAttachments.size(), "Framebuffer color attachment index should be less than attachments' size");
+		return m_ColorAttachments[index];
+	}
+
+	int NullFrameBuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		SN_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment index should be less than size!");
+		return -1;
+	}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "Engine/Renderer/FrameBuffer.h"
+
+namespace Syndra {
+
+	// Hands out renderer IDs for its attachments so they can be bound as textures, but owns no
+	// memory. ReadPixel() has nothing to read and always returns -1, the value of "no entity".
+	class NullFrameBuffer : public FrameBuffer
+	{
+	public:
+		NullFrameBuffer(const FramebufferSpecification& spec);
+
+		virtual void Bind() override;
+		virtual void Unbind() override;
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override;
+		virtual uint32_t GetDepthAttachmentRendererID() const override { return m_DepthAttachment; }
+
+		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+
+		virtual void BindCubemapFace(uint32_t index) const override {}
+
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+	private:
+		uint32_t m_RendererID;
+		FramebufferSpecification m_Specification;
+
+		std::vector<uint32_t> m_ColorAttachments;
+		uint32_t m_DepthAttachment = 0;
+		uint32_t m_CubemapAttachment = 0;
+	};
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Engine/Renderer/GpuProfiler.h"
+
+namespace Syndra {
+
+	// There is no GPU to time, so the Null backend never records GPU scopes.
+	class NullGpuProfiler : public GpuProfiler
+	{
+	public:
+		virtual bool IsSupported() const override { return false; }
+	protected:
+		virtual uint32_t GetFrameSlot() const override { return 0; }
+		virtual uint32_t GetFrameSlotCount() const override { return 1; }
+		virtual bool ReadTimestamps(uint32_t, uint32_t, std::vector<uint64_t>&) override { return false; }
+		virtual void WriteTimestamp(uint32_t, uint32_t) override {}
+	};
+
+}
@@ -0,0 +1,117 @@
+#include "lpch.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+#include <atomic>
+
+namespace Syndra {
+
+	namespace {
+
+		struct NullRecording
+		{
+			NullRendererAPI::RecordingStats Stats;
+			std::vector<NullRendererAPI::Command> Commands;
+			bool RecordCommands = false;
+		};
+
+		NullRecording& GetRecording()
+		{
+			static NullRecording recording;
+			return recording;
+		}
+
+		std::atomic<uint32_t> s_NextRendererID{ 1 };
+
+	}
+
+	void NullRendererAPI::Init()
+	{
+		SN_CORE_INFO("Null renderer: commands are recorded, nothing is drawn.");
+	}
+
+	void NullRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		Record(CommandType::SetViewport, 0, (static_cast<uint64_t>(width) << 32) | height);
+	}
+
+	void NullRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		Record(CommandType::SetClearColor);
+	}
+
+	void NullRendererAPI::Clear()
+	{
+		Record(CommandType::Clear);
+	}
+
+	void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray)
+	{
+		const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+		Record(CommandType::DrawIndexed, 0, indexBuffer ? indexBuffer->GetCount() : 0);
+	}
+
+	void NullRendererAPI::SetState(RenderState stateID, bool on)
+	{
+		Record(CommandType::SetState, static_cast<uint32_t>(stateID), on ? 1 : 0);
+	}
+
+	std::string NullRendererAPI::GetRendererInfo()
+	{
+		return "Null renderer (no GPU)";
+	}
+
+	void NullRendererAPI::Record(CommandType type, uint32_t object, uint64_t value)
+	{
+		NullRecording& recording = GetRecording();
+		RecordingStats& stats = recording.Stats;
+		switch (type)
+		{
+		case CommandType::SetViewport:
+		case CommandType::SetClearColor:
+		case CommandType::SetState:        ++stats.StateChanges; break;
+		case CommandType::Clear:
+		case CommandType::ClearAttachment: ++stats.Clears; break;
+		case CommandType::DrawIndexed:     ++stats.Draws; stats.Indices += value; break;
+		case CommandType::BindShader:      ++stats.ShaderBinds; break;
+		case CommandType::SetUniform:      ++stats.UniformSets; break;
+		case CommandType::Dispatch:        ++stats.Dispatches; break;
+		case CommandType::MemoryBarrier:   break;
+		case CommandType::BindTexture:     ++stats.TextureBinds; break;
+		case CommandType::BindVertexArray: ++stats.VertexArrayBinds; break;
+		case CommandType::BindFrameBuffer: ++stats.FrameBufferBinds; break;
+		case CommandType::UploadBuffer:    ++stats.BufferUploads; stats.BufferBytes += value; break;
+		case CommandType::UploadTexture:   ++stats.TextureUploads; stats.TextureBytes += value; break;
+		}
+
+		if (recording.RecordCommands)
+			recording.Commands.push_back({ type, object, value });
+	}
+
+	NullRendererAPI::RecordingStats NullRendererAPI::GetRecordingStats()
+	{
+		return GetRecording().Stats;
+	}
+
+	void NullRendererAPI::ResetRecording()
+	{
+		NullRecording& recording = GetRecording();
+		recording.Stats = {};
+		recording.Commands.clear();
+	}
+
+	void NullRendererAPI::SetCommandRecording(bool enabled)
+	{
+		GetRecording().RecordCommands = enabled;
+	}
+
+	const std::vector<NullRendererAPI::Command>& NullRendererAPI::GetRecordedCommands()
+	{
+		return GetRecording().Commands;
+	}
+
+	uint32_t NullRendererAPI::AllocateRendererID()
+	{
+		return s_NextRendererID.fetch_add(1, std::memory_order_relaxed);
+	}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "Engine/Renderer/RendererAPI.h"
+
+#include <vector>
+
+namespace Syndra {
+
+	// Does no GPU work. Every call the engine makes into the backend is counted and, while command
+	// recording is on, appended to a command stream, so the CPU side of a frame can be measured and
+	// checked on machines without a GPU.
+	//
+	// The recording belongs to the thread that owns the context, like a command buffer: read it on
+	// the main thread after RenderThread::Synchronize() or with the render thread off.
+	class NullRendererAPI : public RendererAPI {
+
+	public:
+		enum class CommandType : uint8_t
+		{
+			SetViewport,
+			SetClearColor,
+			Clear,
+			SetState,
+			DrawIndexed,
+			BindShader,
+			SetUniform,
+			Dispatch,
+			MemoryBarrier,
+			BindTexture,
+			BindVertexArray,
+			BindFrameBuffer,
+			ClearAttachment,
+			UploadBuffer,
+			UploadTexture
+		};
+
+		struct Command
+		{
+			CommandType Type = CommandType::Clear;
+			uint32_t Object = 0;	// renderer ID of the shader, texture, buffer, vertex array or framebuffer
+			uint64_t Value = 0;		// index count, slot, state, group count or bytes, depending on Type
+		};
+
+		struct RecordingStats
+		{
+			uint32_t Draws = 0;
+			uint64_t Indices = 0;
+			uint32_t Clears = 0;				// Clear() and ClearAttachment()
+			uint32_t StateChanges = 0;			// SetState(), SetViewport() and SetClearColor()
+			uint32_t ShaderBinds = 0;
+			uint32_t UniformSets = 0;			// Shader::Set*() calls
+			uint32_t TextureBinds = 0;
+			uint32_t VertexArrayBinds = 0;
+			uint32_t FrameBufferBinds = 0;
+			uint32_t Dispatches = 0;
+			uint32_t BufferUploads = 0;			// vertex, index and uniform buffer writes
+			uint64_t BufferBytes = 0;
+			uint32_t TextureUploads = 0;
+			uint64_t TextureBytes = 0;
+		};
+
+		virtual void Init() override;
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		virtual void SetClearColor(const glm::vec4& color) override;
+		virtual void Clear() override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) override;
+		virtual void SetState(RenderState stateID, bool on) override;
+
+		virtual std::string GetRendererInfo() override;
+
+		static void Record(CommandType type, uint32_t object = 0, uint64_t value = 0);
+		// Totals since the last ResetRecording().
+		static RecordingStats GetRecordingStats();
+		// Clears the totals and the command stream.
+		static void ResetRecording();
+		// Off by default: counting alone keeps the backend's own cost out of CPU measurements.
+		static void SetCommandRecording(bool enabled);
+		static const std::vector<Command>& GetRecordedCommands();
+
+		// IDs for null backend objects. Never 0, which stays "nothing bound".
+		static uint32_t AllocateRendererID();
+	};
+
+}
@@ -0,0 +1,146 @@
+#include "lpch.h"
+#include "Platform/Null/NullShader.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace Syndra {
+
+	namespace {
+
+		std::string ReadSource(const std::string& filepath)
+		{
+			std::ifstream in(filepath, std::ios::in | std::ios::binary);
+			if (!in)
+			{
+				SN_CORE_WARN("Null shader could not open '{0}', it has no samplers.", filepath);
+				return std::string();
+			}
+
+			std::ostringstream source;
+			source << in.rdbuf();
+			return source.str();
+		}
+
+	}
+
+	NullShader::NullShader(const std::string& filepath)
+		: m_RendererID(NullRendererAPI::AllocateRendererID()), m_FilePath(filepath)
+	{
+		auto lastSlash = filepath.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = filepath.rfind('.');
+		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filepath.substr(lastSlash, count);
+
+		ReflectSamplers(ReadSource(filepath));
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_RendererID(NullRendererAPI::AllocateRendererID()), m_Name(name)
+	{
+		ReflectSamplers(vertexSrc + "\n" + fragmentSrc);
+	}
+
+	NullShader::NullShader(const std::string& name, std::vector<Sampler> samplers, std::vector<PushConstant> pushConstants)
+		: m_RendererID(NullRendererAPI::AllocateRendererID()), m_Name(name),
+		m_PushConstants(std::move(pushConstants)), m_Samplers(std::move(samplers))
+	{
+	}
+
+	void NullShader::Bind() const
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::BindShader, m_RendererID);
+	}
+
+	void NullShader::Unbind() const
+	{
+	}
+
+	void NullShader::SetInt(const std::string& name, int value)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::SetUniform, m_RendererID, sizeof(value));
+	}
+
+	void NullShader::SetIntArray(const std::string& name, int* values, uint32_t count)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::SetUniform, m_RendererID, sizeof(int) * count);
+	}
+
+	void NullShader::SetFloat(const std::string& name, float value)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::SetUniform, m_RendererID, sizeof(value));
+	}
+
+	void NullShader::SetFloat3(const std::string& name, const glm::vec3& value)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::SetUniform, m_RendererID, sizeof(value));
+	}
+
+	void NullShader::SetFloat4(const std::string& name, const glm::vec4& value)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::SetUniform, m_RendererID, sizeof(value));
+	}
+
+	void NullShader::SetMat4(const std::string& name, const glm::mat4& value)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::SetUniform, m_RendererID, sizeof(value));
+	}
+
+	void NullShader::DispatchCompute(uint32_t x, uint32_t y, uint32_t z)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::Dispatch, m_RendererID, static_cast<uint64_t>(x) * y * z);
+	}
+
+	void NullShader::SetMemoryBarrier(MemoryBarrierMode mode)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::MemoryBarrier, m_RendererID, static_cast<uint64_t>(mode));
+	}
+
+	void NullShader::Reload()
+	{
+		if (m_FilePath.empty())
+			return;
+
+		m_Samplers.clear();
+		ReflectSamplers(ReadSource(m_FilePath));
+	}
+
+	void NullShader::ReflectSamplers(const std::string& source)
+	{
+		std::istringstream lines(source);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			const size_t uniform = line.find("uniform sampler");
+			const size_t binding = line.find("binding");
+			if (uniform == std::string::npos || binding == std::string::npos)
+				continue;
+
+			const size_t equals = line.find('=', binding);
+			const size_t nameEnd = line.find_last_not_of(" \t\r;");
+			if (equals == std::string::npos || nameEnd == std::string::npos)
+				continue;
+			const size_t nameBegin = line.find_last_of(" \t", nameEnd) + 1;
+
+			Sampler sampler;
+			sampler.name = line.substr(nameBegin, nameEnd + 1 - nameBegin);
+			sampler.set = 0;
+			sampler.binding = static_cast<uint32_t>(std::strtoul(line.c_str() + equals + 1, nullptr, 10));
+			sampler.isUsed = true;
+			m_Samplers.push_back(sampler);
+		}
+
+		std::sort(m_Samplers.begin(), m_Samplers.end(), [](const Sampler& first, const Sampler& second) {
+			return first.binding < second.binding;
+		});
+		// A sampler declared in several stages is one binding.
+		m_Samplers.erase(std::unique(m_Samplers.begin(), m_Samplers.end(), [](const Sampler& first, const Sampler& second) {
+			return first.binding == second.binding;
+		}), m_Samplers.end());
+	}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Engine/Renderer/Shader.h"
+
+namespace Syndra {
+
+	// Compiles nothing. Samplers are read from the "layout(binding = N) uniform sampler..." lines of
+	// the source so materials bind their textures as they would on a real backend; push constants
+	// are not reflected.
+	class NullShader : public Shader {
+
+	public:
+		NullShader(const std::string& filepath);
+		NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		// For tests and benchmarks that need a given resource layout.
+		NullShader(const std::string& name, std::vector<Sampler> samplers, std::vector<PushConstant> pushConstants);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void SetInt(const std::string& name, int value) override;
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override;
+		virtual void SetFloat(const std::string& name, float value) override;
+		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override;
+		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override;
+		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
+
+		virtual void DispatchCompute(uint32_t x, uint32_t y, uint32_t z) override;
+		virtual void SetMemoryBarrier(MemoryBarrierMode mode) override;
+
+		virtual std::vector<PushConstant> GetPushConstants() override { return m_PushConstants; }
+		virtual std::vector<Sampler> GetSamplers() override { return m_Samplers; }
+
+		virtual const std::string& GetName() const override { return m_Name; }
+		virtual void Reload() override;
+
+	private:
+		void ReflectSamplers(const std::string& source);
+	private:
+		uint32_t m_RendererID;
+		std::string m_FilePath;
+		std::string m_Name;
+
+		std::vector<PushConstant> m_PushConstants;
+		std::vector<Sampler> m_Samplers;
+	};
+
+}
@@ -0,0 +1,95 @@
+#include "lpch.h"
+#include "Platform/Null/NullTexture.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+#include "stb_image.h"
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint64_t kBytesPerPixel = 4;
+		constexpr uint64_t kBytesPerHDRPixel = 4 * sizeof(float);
+		// Poisson disk samplers are RG32F.
+		constexpr uint64_t kBytesPerTexel1D = 2 * sizeof(float);
+
+	}
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height), m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+		m_SizeInBytes = kBytesPerPixel * width * height;
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path, bool sRGB, bool HDR)
+		: m_Path(path), m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+		int width = 0, height = 0, channels = 0;
+		if (!stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			SN_CORE_ERROR("Failed to load texture: {}", path);
+			return;
+		}
+
+		m_Width = static_cast<uint32_t>(width);
+		m_Height = static_cast<uint32_t>(height);
+		m_SizeInBytes = (HDR ? kBytesPerHDRPixel : kBytesPerPixel) * m_Width * m_Height;
+		NullRendererAPI::Record(NullRendererAPI::CommandType::UploadTexture, m_RendererID, m_SizeInBytes);
+	}
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height, const unsigned char* data, bool sRGB)
+		: m_Width(width), m_Height(height), m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+		m_SizeInBytes = kBytesPerPixel * width * height;
+		if (data)
+			NullRendererAPI::Record(NullRendererAPI::CommandType::UploadTexture, m_RendererID, m_SizeInBytes);
+	}
+
+	void NullTexture2D::SetData(void* data, uint32_t size)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::UploadTexture, m_RendererID, size);
+	}
+
+	bool NullTexture2D::operator==(const Texture& other) const
+	{
+		return m_RendererID == other.GetRendererID();
+	}
+
+	void NullTexture2D::Bind(uint32_t slot) const
+	{
+		BindTexture(m_RendererID, slot);
+	}
+
+	void NullTexture2D::BindTexture(uint32_t rendererID, uint32_t slot)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::BindTexture, rendererID, slot);
+	}
+
+	NullTexture1D::NullTexture1D(uint32_t size)
+		: m_Size(size), m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+	}
+
+	NullTexture1D::NullTexture1D(uint32_t size, void* data)
+		: m_Size(size), m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+		if (data)
+			NullRendererAPI::Record(NullRendererAPI::CommandType::UploadTexture, m_RendererID, kBytesPerTexel1D * size);
+	}
+
+	void NullTexture1D::SetData(void* data, uint32_t size)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::UploadTexture, m_RendererID, size);
+	}
+
+	bool NullTexture1D::operator==(const Texture& other) const
+	{
+		return m_RendererID == other.GetRendererID();
+	}
+
+	void NullTexture1D::Bind(uint32_t slot) const
+	{
+		NullTexture2D::BindTexture(m_RendererID, slot);
+	}
+
+}
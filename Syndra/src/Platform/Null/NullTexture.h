@@ -0,0 +1,58 @@
+#pragma once
+#include "Engine/Renderer/Texture.h"
+
+namespace Syndra {
+
+	// Holds no pixels. File-backed textures only read the image header for their size, and every
+	// texture reports the bytes a real backend would upload for it as an UploadTexture command.
+	class NullTexture2D : public Texture2D {
+
+	public:
+		NullTexture2D(uint32_t width, uint32_t height);
+		NullTexture2D(const std::string& path, bool sRGB, bool HDR);
+		NullTexture2D(uint32_t width, uint32_t height, const unsigned char* data, bool sRGB);
+
+		virtual uint32_t GetWidth() const override { return m_Width; }
+		virtual uint32_t GetHeight() const override { return m_Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+		virtual bool operator==(const Texture& other) const override;
+
+		virtual std::string GetPath() const override { return m_Path; }
+		virtual uint64_t GetSizeInBytes() const override { return m_SizeInBytes; }
+
+		virtual void Bind(uint32_t slot = 0) const override;
+
+		static void BindTexture(uint32_t rendererID, uint32_t slot);
+
+	private:
+		std::string m_Path;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_RendererID;
+		uint64_t m_SizeInBytes = 0;
+	};
+
+	class NullTexture1D : public Texture1D {
+
+	public:
+		NullTexture1D(uint32_t size);
+		NullTexture1D(uint32_t size, void* data);
+
+		virtual uint32_t GetWidth() const override { return m_Size; }
+		virtual uint32_t GetHeight() const override { return m_Size; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+		virtual bool operator==(const Texture& other) const override;
+
+		virtual void Bind(uint32_t slot = 0) const override;
+
+		virtual std::string GetPath() const override { return std::string(); }
+
+	private:
+		uint32_t m_Size;
+		uint32_t m_RendererID;
+	};
+
+}
@@ -0,0 +1,17 @@
+#include "lpch.h"
+#include "Platform/Null/NullUniformBuffer.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+namespace Syndra {
+
+	NullUniformBuffer::NullUniformBuffer(uint32_t size, uint32_t binding)
+		: m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+	}
+
+	void NullUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::UploadBuffer, m_RendererID, size);
+	}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Engine/Renderer/UniformBuffer.h"
+
+namespace Syndra {
+
+	class NullUniformBuffer : public UniformBuffer
+	{
+	public:
+		NullUniformBuffer(uint32_t size, uint32_t binding);
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+	private:
+		uint32_t m_RendererID = 0;
+	};
+}
@@ -0,0 +1,22 @@
+#include "lpch.h"
+#include "Platform/Null/NullVertexArray.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+namespace Syndra {
+
+	NullVertexArray::NullVertexArray()
+		: m_RendererID(NullRendererAPI::AllocateRendererID())
+	{
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		NullRendererAPI::Record(NullRendererAPI::CommandType::BindVertexArray, m_RendererID);
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+}
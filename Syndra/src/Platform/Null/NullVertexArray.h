@@ -0,0 +1,26 @@
+#pragma once
+#include "Engine/Renderer/VertexArray.h"
+
+namespace Syndra {
+
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override {}
+
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override { m_IndexBuffer = indexBuffer; }
+
+		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; };
+		virtual const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; };
+
+	private:
+		uint32_t m_RendererID;
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+
+}
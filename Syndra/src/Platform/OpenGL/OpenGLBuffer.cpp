@@ -7,6 +7,7 @@ namespace Syndra {
 	//=============================================VERTEX BUFFER=================================================\\
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
+		: m_GpuMemory(MemoryDomain::Gpu, MemoryCategory::Meshes, size)
 	{
 		glGenBuffers(1, &m_RendererID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
@@ -31,7 +32,7 @@ namespace Syndra {
 	//=============================================INDEX BUFFER=================================================\\
 
 	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
-		: m_Count(count)
+		: m_Count(count), m_GpuMemory(MemoryDomain::Gpu, MemoryCategory::Meshes, static_cast<uint64_t>(count) * sizeof(uint32_t))
 	{
 		glGenBuffers(1, &m_RendererID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
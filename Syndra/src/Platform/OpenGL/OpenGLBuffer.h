@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/Buffer.h"
 
 namespace Syndra {
@@ -19,6 +20,7 @@ namespace Syndra {
 	private:
 		uint32_t m_RendererID;
 		BufferLayout m_Layout;
+		TrackedMemory m_GpuMemory;
 	};
 
 	class OpenGLIndexBuffer : public IndexBuffer
@@ -35,6 +37,7 @@ namespace Syndra {
 	private:
 		uint32_t m_RendererID;
 		uint32_t m_Count;
+		TrackedMemory m_GpuMemory;
 	};
 
 }
@@ -15,6 +15,8 @@ namespace Syndra {
 		virtual void EndFrame() override;
 		virtual void SwapBuffers() override;
 		virtual void SetVSync(bool enabled) override;
+		virtual void MakeCurrent() override;
+		virtual void ReleaseCurrent() override;
 	private:
 		GLFWwindow* m_WindowHandle;
 	};
@@ -102,6 +102,18 @@ namespace Syndra {
 		return false;
 	}
 
+	// What the driver stores per texel, padded formats included (RGB16F is kept as RGBA16F).
+	static uint64_t FormatBytesPerTexel(FramebufferTextureFormat format)
+	{
+		switch (format)
+		{
+			case FramebufferTextureFormat::RGBA16F:	return 8;
+			case FramebufferTextureFormat::None:	return 0;
+		}
+
+		return 4;
+	}
+
 	OpenGLFrameBuffer::OpenGLFrameBuffer(const FramebufferSpecification& spec)
 		:m_Specification(spec)
 	{
@@ -216,6 +228,13 @@ namespace Syndra {
 
 		SN_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		const uint64_t texels = static_cast<uint64_t>(m_Specification.Width) * m_Specification.Height * std::max(m_Specification.Samples, 1u);
+		uint64_t bytes = texels * FormatBytesPerTexel(m_DepthAttachmentSpecification.TextureFormat);
+		bytes += static_cast<uint64_t>(m_Specification.Width) * m_Specification.Height * 6 * FormatBytesPerTexel(m_CubeMapAttachmentSpecification.TextureFormat);
+		for (const auto& attachment : m_ColorAttachmentSpecifications)
+			bytes += texels * FormatBytesPerTexel(attachment.TextureFormat);
+		m_GpuMemory.Set(bytes);
 	}
 
 	void OpenGLFrameBuffer::Bind()
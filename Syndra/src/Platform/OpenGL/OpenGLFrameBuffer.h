@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/FrameBuffer.h"
 
 namespace Syndra {
@@ -41,6 +42,7 @@ namespace Syndra {
 		std::vector<uint32_t> m_ColorAttachments;
 		uint32_t m_DepthAttachment = 0;
 		uint32_t m_CubemapAttachment = 0;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::FrameBuffers };
 	};
 }
 
@@ -0,0 +1,54 @@
+#include "lpch.h"
+#include "Platform/OpenGL/OpenGLGpuProfiler.h"
+#include <glad/glad.h>
+
+namespace Syndra {
+
+	OpenGLGpuProfiler::OpenGLGpuProfiler()
+	{
+		// Implementations may report zero counter bits, in which case timestamps are meaningless.
+		GLint counterBits = 0;
+		glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+		m_Supported = counterBits > 0;
+		if (!m_Supported)
+		{
+			SN_CORE_WARN("GL_TIMESTAMP queries are not supported, GPU pass timings are disabled.");
+			return;
+		}
+
+		for (auto& queries : m_Queries)
+			glGenQueries(MaxQueriesPerFrame, queries.data());
+	}
+
+	OpenGLGpuProfiler::~OpenGLGpuProfiler()
+	{
+		if (!m_Supported)
+			return;
+
+		for (auto& queries : m_Queries)
+			glDeleteQueries(MaxQueriesPerFrame, queries.data());
+	}
+
+	bool OpenGLGpuProfiler::ReadTimestamps(uint32_t slot, uint32_t queryCount, std::vector<uint64_t>& timestampsNs)
+	{
+		const auto& queries = m_Queries[slot];
+		for (uint32_t i = 0; i < queryCount; ++i)
+		{
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available == GL_FALSE)
+				return false;
+		}
+
+		timestampsNs.resize(queryCount);
+		for (uint32_t i = 0; i < queryCount; ++i)
+			glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &timestampsNs[i]);
+		return true;
+	}
+
+	void OpenGLGpuProfiler::WriteTimestamp(uint32_t slot, uint32_t query)
+	{
+		glQueryCounter(m_Queries[slot][query], GL_TIMESTAMP);
+	}
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Engine/Renderer/GpuProfiler.h"
+
+#include <array>
+
+namespace Syndra {
+
+	// GL_TIMESTAMP query counters, one set per frame in a ring of FrameLatency frames.
+	class OpenGLGpuProfiler : public GpuProfiler
+	{
+	public:
+		static constexpr uint32_t FrameLatency = 4;
+
+		OpenGLGpuProfiler();
+		virtual ~OpenGLGpuProfiler();
+
+		virtual bool IsSupported() const override { return m_Supported; }
+	protected:
+		virtual uint32_t GetFrameSlot() const override { return static_cast<uint32_t>(GetRecordedFrameCount() % FrameLatency); }
+		virtual uint32_t GetFrameSlotCount() const override { return FrameLatency; }
+		virtual bool ReadTimestamps(uint32_t slot, uint32_t queryCount, std::vector<uint64_t>& timestampsNs) override;
+		virtual void WriteTimestamp(uint32_t slot, uint32_t query) override;
+	private:
+		std::array<std::array<uint32_t, MaxQueriesPerFrame>, FrameLatency> m_Queries = {};
+		bool m_Supported = false;
+	};
+
+}
@@ -0,0 +1,112 @@
+#include "lpch.h"
+
+#include "OpenGLHeadlessContext.h"
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace Syndra {
+
+	OpenGLHeadlessContext::~OpenGLHeadlessContext()
+	{
+		if (m_Display == nullptr)
+			return;
+
+		EGLDisplay display = static_cast<EGLDisplay>(m_Display);
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (m_Context != nullptr)
+			eglDestroyContext(display, static_cast<EGLContext>(m_Context));
+		eglTerminate(display);
+	}
+
+	void OpenGLHeadlessContext::Init()
+	{
+		// Without the surfaceless platform EGL falls back to the default display, which needs X or Wayland.
+		auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		EGLDisplay display = getPlatformDisplay
+			? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)
+			: eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+		EGLint major = 0;
+		EGLint minor = 0;
+		if (display == EGL_NO_DISPLAY || eglInitialize(display, &major, &minor) != EGL_TRUE)
+		{
+			SN_CORE_ERROR("Failed to initialize a surfaceless EGL display (0x{:x}).", eglGetError());
+			return;
+		}
+		m_Display = display;
+
+		const EGLint configAttributes[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE, 8,
+			EGL_GREEN_SIZE, 8,
+			EGL_BLUE_SIZE, 8,
+			EGL_ALPHA_SIZE, 8,
+			EGL_NONE
+		};
+		EGLConfig config = nullptr;
+		EGLint configCount = 0;
+		if (eglChooseConfig(display, configAttributes, &config, 1, &configCount) != EGL_TRUE || configCount == 0)
+		{
+			SN_CORE_ERROR("No EGL config supports desktop OpenGL.");
+			return;
+		}
+
+		if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+		{
+			SN_CORE_ERROR("EGL does not support desktop OpenGL.");
+			return;
+		}
+
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 5,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+		if (context == EGL_NO_CONTEXT)
+		{
+			SN_CORE_ERROR("Failed to create an OpenGL 4.5 core context through EGL (0x{:x}).", eglGetError());
+			return;
+		}
+		m_Context = context;
+
+		MakeCurrent();
+		int status = gladLoadGLLoader((GLADloadproc)eglGetProcAddress);
+		if (status == 0)
+		{
+			SN_CORE_ERROR("Failed to initialize GLAD for OpenGL context.");
+		}
+		SN_CORE_INFO("Headless OpenGL context initialized (EGL {}.{}).", major, minor);
+	}
+
+	void OpenGLHeadlessContext::BeginFrame()
+	{
+	}
+
+	void OpenGLHeadlessContext::EndFrame()
+	{
+		glFlush();
+	}
+
+	void OpenGLHeadlessContext::SwapBuffers()
+	{
+		EndFrame();
+	}
+
+	void OpenGLHeadlessContext::MakeCurrent()
+	{
+		if (m_Display != nullptr)
+			eglMakeCurrent(static_cast<EGLDisplay>(m_Display), EGL_NO_SURFACE, EGL_NO_SURFACE, static_cast<EGLContext>(m_Context));
+	}
+
+	void OpenGLHeadlessContext::ReleaseCurrent()
+	{
+		if (m_Display != nullptr)
+			eglMakeCurrent(static_cast<EGLDisplay>(m_Display), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Engine/Renderer/GraphicsContext.h"
+
+namespace Syndra {
+
+	// OpenGL 4.5 core context without any surface, created on Mesa's surfaceless EGL platform so it
+	// runs without a display server (llvmpipe on CI machines). Linux only. Nothing is ever shown:
+	// the renderers draw into their own framebuffers and EndFrame() only flushes.
+	class OpenGLHeadlessContext : public GraphicsContext
+	{
+	public:
+		OpenGLHeadlessContext() = default;
+		~OpenGLHeadlessContext() override;
+
+		virtual void Init() override;
+		virtual void BeginFrame() override;
+		virtual void EndFrame() override;
+		virtual void SwapBuffers() override;
+		virtual void MakeCurrent() override;
+		virtual void ReleaseCurrent() override;
+	private:
+		// EGLDisplay and EGLContext, kept opaque so EGL headers stay out of the engine.
+		void* m_Display = nullptr;
+		void* m_Context = nullptr;
+	};
+
+}
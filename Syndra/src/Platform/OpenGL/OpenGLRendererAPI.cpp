@@ -3,6 +3,7 @@
 #include "glad/glad.h"
 #include <vulkan/vulkan.h>
 #include <cstdlib>
+#include <cstring>
 
 namespace {
 
@@ -121,6 +122,39 @@ namespace {
 		return version;
 	}
 
+	// Core GL has no memory query; NVIDIA and AMD expose vendor extensions instead.
+	constexpr GLenum kGPUMemoryInfoTotalAvailableNVX = 0x9048;
+	constexpr GLenum kGPUMemoryInfoCurrentAvailableNVX = 0x9049;
+	constexpr GLenum kTextureFreeMemoryATI = 0x87FC;
+
+	enum class GLMemoryInfoExtension
+	{
+		None,
+		NVX,
+		ATI
+	};
+
+	GLMemoryInfoExtension GetMemoryInfoExtension()
+	{
+		static const GLMemoryInfoExtension s_Extension = []()
+		{
+			GLint extensionCount = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+			for (GLint i = 0; i < extensionCount; ++i)
+			{
+				const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+				if (extension == nullptr)
+					continue;
+				if (std::strcmp(extension, "GL_NVX_gpu_memory_info") == 0)
+					return GLMemoryInfoExtension::NVX;
+				if (std::strcmp(extension, "GL_ATI_meminfo") == 0)
+					return GLMemoryInfoExtension::ATI;
+			}
+			return GLMemoryInfoExtension::None;
+		}();
+		return s_Extension;
+	}
+
 }
 
 namespace Syndra {
@@ -229,4 +263,32 @@ namespace Syndra {
 		return info;
 	}
 
+	bool OpenGLRendererAPI::GetMemoryInfo(GPUMemoryInfo& outInfo)
+	{
+		switch (GetMemoryInfoExtension())
+		{
+		case GLMemoryInfoExtension::NVX:
+		{
+			GLint totalKB = 0;
+			GLint availableKB = 0;
+			glGetIntegerv(kGPUMemoryInfoTotalAvailableNVX, &totalKB);
+			glGetIntegerv(kGPUMemoryInfoCurrentAvailableNVX, &availableKB);
+			outInfo.Budget = static_cast<uint64_t>(totalKB) * 1024;
+			outInfo.Usage = static_cast<uint64_t>(std::max(0, totalKB - availableKB)) * 1024;
+			return true;
+		}
+		case GLMemoryInfoExtension::ATI:
+		{
+			// Only the free pool size is reported, so usage is unknown and the budget is what is left.
+			GLint freeKB[4] = {};
+			glGetIntegerv(kTextureFreeMemoryATI, freeKB);
+			outInfo.Budget = static_cast<uint64_t>(freeKB[0]) * 1024;
+			outInfo.Usage = 0;
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
 }
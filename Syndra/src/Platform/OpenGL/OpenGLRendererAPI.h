@@ -16,6 +16,7 @@ namespace Syndra {
 		virtual void SetState(RenderState stateID, bool on) override;
 
 		virtual std::string GetRendererInfo() override;
+		virtual bool GetMemoryInfo(GPUMemoryInfo& outInfo) override;
 
 	};
 
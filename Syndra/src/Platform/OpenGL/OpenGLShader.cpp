@@ -252,6 +252,15 @@ namespace Syndra {
 		}
 
 		Compile(m_OpenGLSourceCode);
+
+		uint64_t keptBytes = 0;
+		for (const auto& [stage, source] : m_OpenGLSourceCode)
+			keptBytes += source.capacity();
+		for (const auto& [stage, spirv] : m_VulkanSPIRV)
+			keptBytes += spirv.capacity() * sizeof(uint32_t);
+		for (const auto& [stage, spirv] : m_OpenGLSPIRV)
+			keptBytes += spirv.capacity() * sizeof(uint32_t);
+		m_BinaryMemory.Set(keptBytes);
 	}
 
 	void OpenGLShader::Reflect(GLenum stage, const std::vector<uint32_t>& shaderData)
@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/Shader.h"
 #include "glm/glm.hpp"
 
@@ -66,6 +67,8 @@ namespace Syndra {
 		std::unordered_map<GLenum, std::vector<uint32_t>> m_OpenGLSPIRV;
 
 		std::unordered_map<GLenum, std::string> m_OpenGLSourceCode;
+		// SPIR-V and generated GLSL kept after the program is linked.
+		TrackedMemory m_BinaryMemory{ MemoryDomain::Cpu, MemoryCategory::Shaders };
 	};
 
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace Syndra {
 		glCreateTextures(GL_TEXTURE_1D, 1, &m_RendererID);
 		glBindTexture(GL_TEXTURE_1D, m_RendererID);
 		glTextureStorage1D(m_RendererID, 1, GL_RG32F, size);
+		m_GpuMemory.Set(static_cast<uint64_t>(size) * 2 * sizeof(float));
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -23,6 +24,7 @@ namespace Syndra {
 		glCreateTextures(GL_TEXTURE_1D, 1, &m_RendererID);
 		glBindTexture(GL_TEXTURE_1D, m_RendererID);
 		glTextureStorage1D(m_RendererID, 1, GL_RG32F, size);
+		m_GpuMemory.Set(static_cast<uint64_t>(size) * 2 * sizeof(float));
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
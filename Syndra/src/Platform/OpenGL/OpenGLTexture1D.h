@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/Texture.h"
 #include "glad/glad.h"
 
@@ -26,6 +27,7 @@ namespace Syndra {
 	private:
 		uint32_t m_Size;
 		uint32_t m_RendererID;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::Textures };
 	};
 
 }
\ No newline at end of file
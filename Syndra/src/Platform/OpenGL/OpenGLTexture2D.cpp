@@ -2,6 +2,41 @@
 #include "Platform/OpenGL/OpenGLTexture2D.h"
 #include "stb_image.h"
 
+#include <cstring>
+
+namespace {
+
+	// S3TC is an extension on desktop GL; BPTC and RGTC are core since 4.2 / 3.0.
+	constexpr GLenum kCompressedRGBAS3TCDXT1 = 0x83F1;
+	constexpr GLenum kCompressedSRGBAlphaS3TCDXT1 = 0x8C4D;
+	constexpr GLenum kCompressedRGBAS3TCDXT5 = 0x83F3;
+	constexpr GLenum kCompressedSRGBAlphaS3TCDXT5 = 0x8C4F;
+	constexpr GLenum kCompressedRGRGTC2 = 0x8DBD;
+	constexpr GLenum kCompressedRGBABPTCUnorm = 0x8E8C;
+	constexpr GLenum kCompressedSRGBAlphaBPTCUnorm = 0x8E8D;
+
+	uint64_t CalculateMipChainSize(uint32_t width, uint32_t height, uint32_t levels, uint32_t bytesPerPixel)
+	{
+		uint64_t size = 0;
+		for (uint32_t level = 0; level < levels; ++level)
+			size += static_cast<uint64_t>(std::max(1u, width >> level)) * std::max(1u, height >> level) * bytesPerPixel;
+		return size;
+	}
+
+	GLenum PickCookedInternalFormat(Syndra::TextureCompression compression, bool sRGB)
+	{
+		switch (compression)
+		{
+		case Syndra::TextureCompression::BC1: return sRGB ? kCompressedSRGBAlphaS3TCDXT1 : kCompressedRGBAS3TCDXT1;
+		case Syndra::TextureCompression::BC3: return sRGB ? kCompressedSRGBAlphaS3TCDXT5 : kCompressedRGBAS3TCDXT5;
+		case Syndra::TextureCompression::BC5: return kCompressedRGRGTC2;
+		case Syndra::TextureCompression::BC7: return sRGB ? kCompressedSRGBAlphaBPTCUnorm : kCompressedRGBABPTCUnorm;
+		default:                              return sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+		}
+	}
+
+}
+
 namespace Syndra {
 
 	//For use in compute shaders
@@ -16,6 +51,7 @@ namespace Syndra {
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		m_GpuMemory.Set(CalculateMipChainSize(m_Width, m_Height, 1, 4));
 
 		glBindImageTexture(0, m_RendererID, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA8);
 	}
@@ -50,6 +86,7 @@ namespace Syndra {
 				glBindTexture(GL_TEXTURE_2D, m_RendererID);
 				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 				glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+				m_GpuMemory.Set(CalculateMipChainSize(m_Width, m_Height, 1, 4));
 				glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 				glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -69,6 +106,8 @@ namespace Syndra {
 			glBindTexture(GL_TEXTURE_2D, m_RendererID);
 			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 			glTextureStorage2D(m_RendererID, mipmapLevels, internalFormat, m_Width, m_Height);
+			m_GpuMemory.Set(CalculateMipChainSize(m_Width, m_Height, mipmapLevels, 4));
+			m_TotalMipLevels = mipmapLevels;
 
 			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -99,6 +138,8 @@ namespace Syndra {
 		glBindTexture(GL_TEXTURE_2D, m_RendererID);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 		glTextureStorage2D(m_RendererID, mipmapLevels, internalFormat, m_Width, m_Height);
+		m_GpuMemory.Set(CalculateMipChainSize(m_Width, m_Height, mipmapLevels, 4));
+		m_TotalMipLevels = mipmapLevels;
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -111,6 +152,94 @@ namespace Syndra {
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 	}
 
+	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, const CookedTexture& cookedTexture)
+		: m_Path(path), m_Width(cookedTexture.Width), m_Height(cookedTexture.Height)
+	{
+		SN_CORE_ASSERT(cookedTexture.IsValid(), "OpenGLTexture2D requires a valid cooked texture.");
+		m_InternalFormat = PickCookedInternalFormat(cookedTexture.Compression, cookedTexture.SRGB);
+		m_DataFormat = GL_RGBA;
+		m_Compressed = cookedTexture.IsCompressed();
+		m_Streamable = !cookedTexture.CachePath.empty();
+		m_TotalMipLevels = cookedTexture.GetLevelCount();
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_TotalMipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_TotalMipLevels) - 1);
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		// Every level is precomputed by the cooker, so glGenerateTextureMipmap is not needed.
+		UploadLevels(cookedTexture, cookedTexture.FirstLevel, m_TotalMipLevels);
+		m_FirstResidentLevel = cookedTexture.FirstLevel;
+		glTextureParameteri(m_RendererID, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(m_FirstResidentLevel));
+		m_GpuMemory.Set(cookedTexture.GetSizeInBytes());
+	}
+
+	bool OpenGLTexture2D::UpdateResidentLevels(const CookedTexture& levels)
+	{
+		if (!m_Streamable || !levels.IsValid())
+			return false;
+
+		if (levels.Width != m_Width || levels.Height != m_Height || levels.GetLevelCount() != m_TotalMipLevels ||
+			PickCookedInternalFormat(levels.Compression, levels.SRGB) != m_InternalFormat)
+		{
+			SN_CORE_WARN("Streamed mips for '{}' do not match the resident texture.", m_Path);
+			return false;
+		}
+
+		const uint32_t firstLevel = levels.FirstLevel;
+		if (firstLevel == m_FirstResidentLevel)
+			return true;
+
+		// Mutable storage keeps the texture name (and every cached renderer ID) stable: new detail
+		// levels are specified before lowering the base level, dropped ones after raising it.
+		if (firstLevel < m_FirstResidentLevel)
+		{
+			UploadLevels(levels, firstLevel, m_FirstResidentLevel);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(firstLevel));
+		}
+		else
+		{
+			glTextureParameteri(m_RendererID, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(firstLevel));
+			glBindTexture(GL_TEXTURE_2D, m_RendererID);
+			for (uint32_t mip = m_FirstResidentLevel; mip < firstLevel; ++mip)
+			{
+				// A zero-sized image releases the level's storage.
+				if (m_Compressed)
+					glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(mip), m_InternalFormat, 0, 0, 0, 0, nullptr);
+				else
+					glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(mip), m_InternalFormat, 0, 0, 0, m_DataFormat, GL_UNSIGNED_BYTE, nullptr);
+			}
+		}
+
+		m_FirstResidentLevel = firstLevel;
+		m_GpuMemory.Set(levels.GetSizeInBytes());
+		return true;
+	}
+
+	void OpenGLTexture2D::UploadLevels(const CookedTexture& levels, uint32_t beginLevel, uint32_t endLevel)
+	{
+		glBindTexture(GL_TEXTURE_2D, m_RendererID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (uint32_t mip = beginLevel; mip < endLevel; ++mip)
+		{
+			const CookedTextureLevel& level = levels.Levels[mip - levels.FirstLevel];
+			if (m_Compressed)
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(mip), m_InternalFormat, level.Width, level.Height, 0,
+					static_cast<GLsizei>(level.Data.size()), level.Data.data());
+			}
+			else
+			{
+				glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(mip), m_InternalFormat, level.Width, level.Height, 0,
+					m_DataFormat, GL_UNSIGNED_BYTE, level.Data.data());
+			}
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
 		glDeleteTextures(1, &m_RendererID);
@@ -118,6 +247,12 @@ namespace Syndra {
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
 	{
+		if (m_Compressed || m_FirstResidentLevel != 0)
+		{
+			SN_CORE_WARN("OpenGLTexture2D::SetData is not supported for block-compressed or streamed texture '{}'.", m_Path);
+			return;
+		}
+
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		SN_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
@@ -134,6 +269,23 @@ namespace Syndra {
 		glBindTextureUnit(slot, rendererID);
 	}
 
+	bool OpenGLTexture2D::SupportsBlockCompression()
+	{
+		static const bool s_Supported = []()
+		{
+			GLint extensionCount = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+			for (GLint i = 0; i < extensionCount; ++i)
+			{
+				const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+				if (extension != nullptr && std::strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0)
+					return true;
+			}
+			return false;
+		}();
+		return s_Supported;
+	}
+
 	void OpenGLTexture2D::LoadHDR()
 	{
 		int width, height, channels;
@@ -142,6 +294,7 @@ namespace Syndra {
 		glBindTexture(GL_TEXTURE_2D, m_RendererID);
 
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, data);
+		m_GpuMemory.Set(CalculateMipChainSize(width, height, 1, 6));
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
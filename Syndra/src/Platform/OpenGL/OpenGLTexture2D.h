@@ -1,5 +1,7 @@
 #pragma once
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/TextureCooker.h"
 #include "glad/glad.h"
 
 namespace Syndra {
@@ -10,6 +12,7 @@ namespace Syndra {
 		OpenGLTexture2D(uint32_t width, uint32_t height);
 		OpenGLTexture2D(const std::string& path, bool sRGB, bool HDR);
 		OpenGLTexture2D(uint32_t mWidth, uint32_t mHeight,const unsigned char* data, bool sRGB);
+		OpenGLTexture2D(const std::string& path, const CookedTexture& cookedTexture);
 		virtual ~OpenGLTexture2D();
 
 		virtual uint32_t GetWidth() const override { return m_Width; };
@@ -20,19 +23,32 @@ namespace Syndra {
 		virtual bool operator ==(const Texture& other) const override;
 
 		virtual std::string GetPath() const override { return m_Path; }
+		virtual uint64_t GetSizeInBytes() const override { return m_GpuMemory.GetBytes(); }
+
+		virtual uint32_t GetMipLevelCount() const override { return m_TotalMipLevels; }
+		virtual uint32_t GetFirstResidentLevel() const override { return m_FirstResidentLevel; }
+		virtual bool UpdateResidentLevels(const CookedTexture& levels) override;
 
 		virtual void Bind(uint32_t slot = 0) const override;
 
 		static void BindTexture(uint32_t rendererID, uint32_t slot);
+		static bool SupportsBlockCompression();
 
 	private:
 		void LoadHDR();
+		// Specifies mips [beginLevel, endLevel) from 'levels' (mutable storage, streamed textures only).
+		void UploadLevels(const CookedTexture& levels, uint32_t beginLevel, uint32_t endLevel);
 	private:
 		
 		std::string m_Path;
 		uint32_t m_Width, m_Height;
 		uint32_t m_RendererID;
 		GLenum m_InternalFormat, m_DataFormat;
+		bool m_Compressed = false;
+		bool m_Streamable = false;
+		uint32_t m_TotalMipLevels = 1;
+		uint32_t m_FirstResidentLevel = 0;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::Textures };
 	};
 
 }
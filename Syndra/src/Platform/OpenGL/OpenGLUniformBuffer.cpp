@@ -5,6 +5,7 @@
 namespace Syndra {
 
 	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+		: m_GpuMemory(MemoryDomain::Gpu, MemoryCategory::UniformBuffers, size)
 	{
 		glCreateBuffers(1, &m_RendererID);
 		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/UniformBuffer.h"
 
 namespace Syndra {
@@ -13,5 +14,6 @@ namespace Syndra {
 		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
 	private:
 		uint32_t m_RendererID = 0;
+		TrackedMemory m_GpuMemory;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanBindlessTextureTable.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint32_t kMaxBindlessTextures = 4096;
+
+		struct BindlessTableState
+		{
+			VkDevice Device = VK_NULL_HANDLE;
+			VkDescriptorSetLayout Layout = VK_NULL_HANDLE;
+			VkDescriptorPool Pool = VK_NULL_HANDLE;
+			VkDescriptorSet Set = VK_NULL_HANDLE;
+			uint32_t Capacity = 0;
+			uint32_t NextIndex = 0;
+			std::vector<uint32_t> FreeIndices;
+			std::unordered_map<uint32_t, uint32_t> Indices;
+			// Bumped by Shutdown so releases deferred past it do not leak into a new table.
+			uint64_t Epoch = 0;
+			// Bumped whenever a texture gets a new index or loses its index.
+			uint64_t Revision = 0;
+			bool CreationFailed = false;
+		};
+
+		BindlessTableState& GetTableState()
+		{
+			static BindlessTableState state;
+			return state;
+		}
+
+		bool EnsureTableCreated(BindlessTableState& state)
+		{
+			if (state.Set != VK_NULL_HANDLE)
+				return true;
+			if (state.CreationFailed)
+				return false;
+
+			VulkanContext* context = VulkanContext::GetCurrent();
+			if (context == nullptr || context->GetDevice() == VK_NULL_HANDLE)
+				return false;
+
+			VkPhysicalDeviceVulkan12Properties vulkan12Properties{};
+			vulkan12Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+			VkPhysicalDeviceProperties2 properties{};
+			properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties.pNext = &vulkan12Properties;
+			vkGetPhysicalDeviceProperties2(context->GetPhysicalDevice(), &properties);
+
+			const uint32_t capacity = std::min({
+				kMaxBindlessTextures,
+				vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages,
+				vulkan12Properties.maxDescriptorSetUpdateAfterBindSamplers,
+				vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+				vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSamplers });
+
+			const VkDevice device = context->GetDevice();
+
+			VkDescriptorSetLayoutBinding binding{};
+			binding.binding = 0;
+			binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			binding.descriptorCount = capacity;
+			binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT;
+
+			// Slots of released textures stay stale until reused, and are rewritten while earlier
+			// frames still have the set bound.
+			const VkDescriptorBindingFlags bindingFlags =
+				VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+				VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+				VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+			VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+			bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+			bindingFlagsInfo.bindingCount = 1;
+			bindingFlagsInfo.pBindingFlags = &bindingFlags;
+
+			VkDescriptorSetLayoutCreateInfo layoutInfo{};
+			layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			layoutInfo.pNext = &bindingFlagsInfo;
+			layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+			layoutInfo.bindingCount = 1;
+			layoutInfo.pBindings = &binding;
+
+			const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, capacity };
+			VkDescriptorPoolCreateInfo poolInfo{};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+			poolInfo.maxSets = 1;
+			poolInfo.poolSizeCount = 1;
+			poolInfo.pPoolSizes = &poolSize;
+
+			if (capacity == 0 ||
+				vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &state.Layout) != VK_SUCCESS ||
+				vkCreateDescriptorPool(device, &poolInfo, nullptr, &state.Pool) != VK_SUCCESS)
+			{
+				SN_CORE_ERROR("Failed to create the Vulkan bindless texture table.");
+				if (state.Layout != VK_NULL_HANDLE)
+					vkDestroyDescriptorSetLayout(device, state.Layout, nullptr);
+				state.Layout = VK_NULL_HANDLE;
+				state.Pool = VK_NULL_HANDLE;
+				state.CreationFailed = true;
+				return false;
+			}
+
+			VkDescriptorSetAllocateInfo allocInfo{};
+			allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocInfo.descriptorPool = state.Pool;
+			allocInfo.descriptorSetCount = 1;
+			allocInfo.pSetLayouts = &state.Layout;
+			if (vkAllocateDescriptorSets(device, &allocInfo, &state.Set) != VK_SUCCESS)
+			{
+				SN_CORE_ERROR("Failed to allocate the Vulkan bindless texture set.");
+				vkDestroyDescriptorPool(device, state.Pool, nullptr);
+				vkDestroyDescriptorSetLayout(device, state.Layout, nullptr);
+				state.Pool = VK_NULL_HANDLE;
+				state.Layout = VK_NULL_HANDLE;
+				state.Set = VK_NULL_HANDLE;
+				state.CreationFailed = true;
+				return false;
+			}
+
+			state.Device = device;
+			state.Capacity = capacity;
+			state.NextIndex = 0;
+			state.FreeIndices.clear();
+			SN_CORE_INFO("Vulkan bindless texture table created with {} slots.", capacity);
+			return true;
+		}
+
+		void ReleaseIndex(BindlessTableState& state, uint32_t index)
+		{
+			VulkanContext* context = VulkanContext::GetCurrent();
+			if (context == nullptr)
+			{
+				state.FreeIndices.push_back(index);
+				return;
+			}
+
+			context->DeferRelease([index, epoch = state.Epoch]()
+			{
+				BindlessTableState& deferredState = GetTableState();
+				if (deferredState.Epoch == epoch)
+					deferredState.FreeIndices.push_back(index);
+			});
+		}
+
+	}
+
+	int32_t VulkanBindlessTextureTable::Register(uint32_t rendererID, VkSampler sampler, VkImageView imageView)
+	{
+		if (rendererID == 0 || sampler == VK_NULL_HANDLE || imageView == VK_NULL_HANDLE)
+			return InvalidIndex;
+
+		BindlessTableState& state = GetTableState();
+		if (!EnsureTableCreated(state))
+			return InvalidIndex;
+
+		uint32_t index = 0;
+		if (!state.FreeIndices.empty())
+		{
+			index = state.FreeIndices.back();
+			state.FreeIndices.pop_back();
+		}
+		else if (state.NextIndex < state.Capacity)
+		{
+			index = state.NextIndex++;
+		}
+		else
+		{
+			SN_CORE_WARN("Vulkan bindless texture table is full ({} slots); texture {} will sample as unbound.", state.Capacity, rendererID);
+			Unregister(rendererID);
+			return InvalidIndex;
+		}
+
+		VkDescriptorImageInfo imageInfo{};
+		imageInfo.sampler = sampler;
+		imageInfo.imageView = imageView;
+		imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		VkWriteDescriptorSet write{};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = state.Set;
+		write.dstBinding = 0;
+		write.dstArrayElement = index;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		write.descriptorCount = 1;
+		write.pImageInfo = &imageInfo;
+		vkUpdateDescriptorSets(state.Device, 1, &write, 0, nullptr);
+
+		// Frames in flight may still sample the previous view through the old slot.
+		auto [iterator, inserted] = state.Indices.try_emplace(rendererID, index);
+		if (!inserted)
+		{
+			ReleaseIndex(state, iterator->second);
+			iterator->second = index;
+		}
+		++state.Revision;
+
+		return static_cast<int32_t>(index);
+	}
+
+	void VulkanBindlessTextureTable::Unregister(uint32_t rendererID)
+	{
+		BindlessTableState& state = GetTableState();
+		const auto iterator = state.Indices.find(rendererID);
+		if (iterator == state.Indices.end())
+			return;
+
+		ReleaseIndex(state, iterator->second);
+		state.Indices.erase(iterator);
+		++state.Revision;
+	}
+
+	int32_t VulkanBindlessTextureTable::GetIndex(uint32_t rendererID)
+	{
+		const BindlessTableState& state = GetTableState();
+		const auto iterator = state.Indices.find(rendererID);
+		if (iterator == state.Indices.end())
+			return InvalidIndex;
+
+		return static_cast<int32_t>(iterator->second);
+	}
+
+	VkDescriptorSetLayout VulkanBindlessTextureTable::GetSetLayout()
+	{
+		BindlessTableState& state = GetTableState();
+		return EnsureTableCreated(state) ? state.Layout : VK_NULL_HANDLE;
+	}
+
+	VkDescriptorSet VulkanBindlessTextureTable::GetDescriptorSet()
+	{
+		BindlessTableState& state = GetTableState();
+		return EnsureTableCreated(state) ? state.Set : VK_NULL_HANDLE;
+	}
+
+	uint32_t VulkanBindlessTextureTable::GetCapacity()
+	{
+		return GetTableState().Capacity;
+	}
+
+	uint32_t VulkanBindlessTextureTable::GetResidentCount()
+	{
+		return static_cast<uint32_t>(GetTableState().Indices.size());
+	}
+
+	uint64_t VulkanBindlessTextureTable::GetRevision()
+	{
+		return GetTableState().Revision;
+	}
+
+	void VulkanBindlessTextureTable::Shutdown()
+	{
+		BindlessTableState& state = GetTableState();
+		if (state.Device != VK_NULL_HANDLE)
+		{
+			// Freeing the pool frees the set with it.
+			vkDestroyDescriptorPool(state.Device, state.Pool, nullptr);
+			vkDestroyDescriptorSetLayout(state.Device, state.Layout, nullptr);
+		}
+
+		state.Device = VK_NULL_HANDLE;
+		state.Layout = VK_NULL_HANDLE;
+		state.Pool = VK_NULL_HANDLE;
+		state.Set = VK_NULL_HANDLE;
+		state.Capacity = 0;
+		state.NextIndex = 0;
+		state.FreeIndices.clear();
+		state.Indices.clear();
+		state.CreationFailed = false;
+		++state.Epoch;
+		++state.Revision;
+	}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <volk.h>
+
+#include <cstdint>
+
+namespace Syndra {
+
+	// One descriptor set holding every sampled 2D texture in a single unsized sampler2D array.
+	// Textures register their view when it is created and keep that index until the view changes;
+	// shaders that declare the array (see VulkanShader::GetBindlessTextureSet) receive indices as
+	// push constants, so switching materials never allocates or rebinds a descriptor set.
+	// Freed indices are recycled only after the frames that could still sample them have retired.
+	class VulkanBindlessTextureTable
+	{
+	public:
+		static constexpr int32_t InvalidIndex = -1;
+
+		// Writes the view into a free slot; a texture registered again moves to a new slot and its
+		// old one is released with the frames in flight.
+		static int32_t Register(uint32_t rendererID, VkSampler sampler, VkImageView imageView);
+		static void Unregister(uint32_t rendererID);
+		static int32_t GetIndex(uint32_t rendererID);
+
+		// Created on first use; VK_NULL_HANDLE when the device cannot provide the table.
+		static VkDescriptorSetLayout GetSetLayout();
+		static VkDescriptorSet GetDescriptorSet();
+		static uint32_t GetCapacity();
+		static uint32_t GetResidentCount();
+		// Changes whenever GetIndex() may return something else for some texture, so callers that
+		// cache indices know when to look them up again.
+		static uint64_t GetRevision();
+
+		// Destroys the pool and layout. The device must be idle.
+		static void Shutdown();
+	};
+
+}
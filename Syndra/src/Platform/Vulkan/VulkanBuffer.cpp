@@ -2,79 +2,61 @@
 
 #include "Platform/Vulkan/VulkanBuffer.h"
 
-#include "Platform/Vulkan/VulkanContext.h"
-#include "vk_mem_alloc.h"
-
-namespace {
-
-	void CreateHostVisibleBuffer(
-		Syndra::VulkanContext* context,
-		VkDeviceSize size,
-		VkBufferUsageFlags usage,
-		VkBuffer& outBuffer,
-		Syndra::VmaAllocation& outAllocation,
-		VmaAllocationInfo& outAllocationInfo)
-	{
-		SN_CORE_ASSERT(context != nullptr, "Vulkan context is required to allocate buffers.");
-
-		VkBufferCreateInfo bufferInfo{};
-		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bufferInfo.size = size;
-		bufferInfo.usage = usage;
-		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-		VmaAllocationCreateInfo allocationCreateInfo{};
-		allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-		allocationCreateInfo.flags =
-			VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-			VMA_ALLOCATION_CREATE_MAPPED_BIT;
-
-		const VkResult result = vmaCreateBuffer(
-			context->GetAllocator(),
-			&bufferInfo,
-			&allocationCreateInfo,
-			&outBuffer,
-			&outAllocation,
-			&outAllocationInfo);
-
-		SN_CORE_ASSERT(result == VK_SUCCESS, "Failed to create Vulkan buffer.");
-	}
-
-}
-
 namespace Syndra {
 
 	VulkanVertexBuffer::VulkanVertexBuffer(float* vertices, uint32_t size)
 		: m_Size(size)
 	{
-		VulkanContext* context = VulkanContext::GetCurrent();
-		VmaAllocationInfo allocationInfo{};
-		CreateHostVisibleBuffer(
-			context,
-			size,
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-			m_Buffer,
-			m_Allocation,
-			allocationInfo);
-
 		if (vertices != nullptr && size > 0)
 		{
-			SN_CORE_ASSERT(allocationInfo.pMappedData != nullptr, "Mapped buffer allocation was expected for vertex buffer.");
-			memcpy(allocationInfo.pMappedData, vertices, static_cast<size_t>(size));
-			vmaFlushAllocation(context->GetAllocator(), m_Allocation, 0, size);
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(vertices);
+			m_PendingData.assign(bytes, bytes + size);
+		}
+		else
+		{
+			m_PendingData.resize(size, 0);
 		}
 	}
 
 	VulkanVertexBuffer::~VulkanVertexBuffer()
 	{
-		VulkanContext* context = VulkanContext::GetCurrent();
-		if (context != nullptr && context->GetAllocator() != nullptr && m_Buffer != VK_NULL_HANDLE)
+		VulkanGeometryPool::GetVertexPool().Free(m_Allocation);
+		m_Allocation = VulkanGeometryPool::InvalidAllocation;
+	}
+
+	void VulkanVertexBuffer::SetLayout(const BufferLayout& layout)
+	{
+		m_Layout = layout;
+		const uint32_t stride = m_Layout.GetStride() > 0 ? m_Layout.GetStride() : sizeof(float);
+
+		VulkanGeometryPool& pool = VulkanGeometryPool::GetVertexPool();
+		if (m_Allocation != VulkanGeometryPool::InvalidAllocation)
 		{
-			vmaDestroyBuffer(context->GetAllocator(), m_Buffer, m_Allocation);
+			SN_CORE_ASSERT(pool.GetRange(m_Allocation).Offset % stride == 0, "Vertex buffer layout changed to a stride its pool range is not aligned to.");
+			return;
 		}
 
-		m_Buffer = VK_NULL_HANDLE;
-		m_Allocation = nullptr;
+		if (m_Size == 0)
+			return;
+
+		m_Allocation = pool.Allocate(m_PendingData.data(), m_Size, stride);
+		SN_CORE_ASSERT(m_Allocation != VulkanGeometryPool::InvalidAllocation, "Failed to place vertex buffer in the geometry pool.");
+		m_PendingData.clear();
+		m_PendingData.shrink_to_fit();
+	}
+
+	VkBuffer VulkanVertexBuffer::GetBuffer() const
+	{
+		return VulkanGeometryPool::GetVertexPool().GetRange(m_Allocation).Buffer;
+	}
+
+	int32_t VulkanVertexBuffer::GetBaseVertex() const
+	{
+		const uint32_t stride = m_Layout.GetStride();
+		if (stride == 0)
+			return 0;
+
+		return static_cast<int32_t>(VulkanGeometryPool::GetVertexPool().GetRange(m_Allocation).Offset / stride);
 	}
 
 	void VulkanVertexBuffer::Bind() const
@@ -89,34 +71,31 @@ namespace Syndra {
 		: m_Count(count)
 	{
 		const VkDeviceSize size = static_cast<VkDeviceSize>(count) * sizeof(uint32_t);
-		VulkanContext* context = VulkanContext::GetCurrent();
-		VmaAllocationInfo allocationInfo{};
-		CreateHostVisibleBuffer(
-			context,
-			size,
-			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-			m_Buffer,
-			m_Allocation,
-			allocationInfo);
-
-		if (indices != nullptr && size > 0)
-		{
-			SN_CORE_ASSERT(allocationInfo.pMappedData != nullptr, "Mapped buffer allocation was expected for index buffer.");
-			memcpy(allocationInfo.pMappedData, indices, static_cast<size_t>(size));
-			vmaFlushAllocation(context->GetAllocator(), m_Allocation, 0, size);
-		}
+		if (size == 0)
+			return;
+
+		std::vector<uint32_t> zeroes;
+		if (indices == nullptr)
+			zeroes.resize(count, 0);
+
+		m_Allocation = VulkanGeometryPool::GetIndexPool().Allocate(indices != nullptr ? indices : zeroes.data(), size, sizeof(uint32_t));
+		SN_CORE_ASSERT(m_Allocation != VulkanGeometryPool::InvalidAllocation, "Failed to place index buffer in the geometry pool.");
 	}
 
 	VulkanIndexBuffer::~VulkanIndexBuffer()
 	{
-		VulkanContext* context = VulkanContext::GetCurrent();
-		if (context != nullptr && context->GetAllocator() != nullptr && m_Buffer != VK_NULL_HANDLE)
-		{
-			vmaDestroyBuffer(context->GetAllocator(), m_Buffer, m_Allocation);
-		}
+		VulkanGeometryPool::GetIndexPool().Free(m_Allocation);
+		m_Allocation = VulkanGeometryPool::InvalidAllocation;
+	}
 
-		m_Buffer = VK_NULL_HANDLE;
-		m_Allocation = nullptr;
+	VkBuffer VulkanIndexBuffer::GetBuffer() const
+	{
+		return VulkanGeometryPool::GetIndexPool().GetRange(m_Allocation).Buffer;
+	}
+
+	uint32_t VulkanIndexBuffer::GetFirstIndex() const
+	{
+		return static_cast<uint32_t>(VulkanGeometryPool::GetIndexPool().GetRange(m_Allocation).Offset / sizeof(uint32_t));
 	}
 
 	void VulkanIndexBuffer::Bind() const
@@ -1,15 +1,14 @@
 #pragma once
 
 #include "Engine/Renderer/Buffer.h"
+#include "Platform/Vulkan/VulkanGeometryPool.h"
 
 #include <volk.h>
 
-struct VmaAllocation_T;
+#include <vector>
 
 namespace Syndra {
 
-	using VmaAllocation = VmaAllocation_T*;
-
 	class VulkanVertexBuffer : public VertexBuffer
 	{
 	public:
@@ -20,14 +19,19 @@ namespace Syndra {
 		void Unbind() const override;
 
 		const BufferLayout& GetLayout() const override { return m_Layout; }
-		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		// Places the vertices in the shared vertex pool on a whole-vertex boundary, so draws address
+		// them through a base vertex instead of a buffer offset.
+		void SetLayout(const BufferLayout& layout) override;
 
-		VkBuffer GetBuffer() const { return m_Buffer; }
+		// The pool buffer, which is shared with other meshes; VK_NULL_HANDLE until the layout is set.
+		VkBuffer GetBuffer() const;
+		int32_t GetBaseVertex() const;
 		uint32_t GetSize() const { return m_Size; }
 
 	private:
-		VkBuffer m_Buffer = VK_NULL_HANDLE;
-		VmaAllocation m_Allocation = nullptr;
+		// Kept only until the first SetLayout() places the data.
+		std::vector<uint8_t> m_PendingData;
+		VulkanGeometryPool::AllocationID m_Allocation = VulkanGeometryPool::InvalidAllocation;
 		uint32_t m_Size = 0;
 		BufferLayout m_Layout;
 	};
@@ -42,11 +46,12 @@ namespace Syndra {
 		void Unbind() const override;
 
 		uint32_t GetCount() const override { return m_Count; }
-		VkBuffer GetBuffer() const { return m_Buffer; }
+		// The pool buffer, which is shared with other meshes.
+		VkBuffer GetBuffer() const;
+		uint32_t GetFirstIndex() const;
 
 	private:
-		VkBuffer m_Buffer = VK_NULL_HANDLE;
-		VmaAllocation m_Allocation = nullptr;
+		VulkanGeometryPool::AllocationID m_Allocation = VulkanGeometryPool::InvalidAllocation;
 		uint32_t m_Count = 0;
 	};
 
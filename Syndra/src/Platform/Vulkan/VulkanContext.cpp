@@ -81,6 +81,7 @@ namespace Syndra {
 		}
 
 		CleanupSwapchain();
+		RunDeferredReleases(true);
 
 		for (uint32_t i = 0; i < kMaxFramesInFlight; ++i)
 		{
@@ -127,19 +128,23 @@ namespace Syndra {
 		volkLoadInstance(m_Instance);
 
 		SetupDebugMessenger();
-		CreateSurface();
+		if (!IsHeadless())
+			CreateSurface();
 		PickPhysicalDevice();
 		CreateLogicalDevice();
 		CreateAllocator();
-		CreateSwapchain();
-		CreateImageViews();
+		if (!IsHeadless())
+		{
+			CreateSwapchain();
+			CreateImageViews();
+		}
 		CreateCommandPool();
 		CreateCommandBuffers();
 		CreateSyncObjects();
 
 		s_CurrentContext = this;
 		m_Initialized = true;
-		SN_CORE_INFO("Vulkan context initialized (API 1.4, dynamic rendering + synchronization2).");
+		SN_CORE_INFO("Vulkan context initialized (API 1.4, dynamic rendering + synchronization2{}).", IsHeadless() ? ", headless" : "");
 	}
 
 	VkCommandBuffer VulkanContext::BeginSingleTimeCommands() const
@@ -189,6 +194,12 @@ namespace Syndra {
 		if (m_FrameInProgress)
 			return;
 
+		if (IsHeadless())
+		{
+			BeginHeadlessFrame();
+			return;
+		}
+
 		if (glfwWindowShouldClose(m_WindowHandle))
 			return;
 
@@ -206,6 +217,7 @@ namespace Syndra {
 			SN_PROFILE_SCOPE("vkWaitForFences(frame)");
 			ValidateVulkanResult(vkWaitForFences(m_Device, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX), "vkWaitForFences");
 		}
+		RunDeferredReleases(false);
 
 		VkResult acquireResult = VK_SUCCESS;
 		{
@@ -256,6 +268,7 @@ namespace Syndra {
 
 		m_FrameInProgress = true;
 		++m_FrameNumber;
+		vmaSetCurrentFrameIndex(m_Allocator, static_cast<uint32_t>(m_FrameNumber));
 	}
 
 	void VulkanContext::EndFrame()
@@ -264,6 +277,12 @@ namespace Syndra {
 		if (!m_Initialized || !m_FrameInProgress)
 			return;
 
+		if (IsHeadless())
+		{
+			EndHeadlessFrame();
+			return;
+		}
+
 		{
 			SN_PROFILE_SCOPE("RecordCommandBuffer");
 			RecordCommandBuffer(m_CommandBuffers[m_CurrentFrame], m_AcquiredImageIndex);
@@ -326,6 +345,51 @@ namespace Syndra {
 		m_FrameInProgress = false;
 	}
 
+	void VulkanContext::BeginHeadlessFrame()
+	{
+		// Without a swapchain a frame is just the frame's command buffer, fenced like a windowed one
+		// so the frames-in-flight bookkeeping (deferred releases, timestamp slots) stays the same.
+		{
+			SN_PROFILE_SCOPE("vkWaitForFences(frame)");
+			ValidateVulkanResult(vkWaitForFences(m_Device, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX), "vkWaitForFences");
+		}
+		RunDeferredReleases(false);
+
+		ValidateVulkanResult(vkResetFences(m_Device, 1, &m_InFlightFences[m_CurrentFrame]), "vkResetFences");
+		ValidateVulkanResult(vkResetCommandBuffer(m_CommandBuffers[m_CurrentFrame], 0), "vkResetCommandBuffer");
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		ValidateVulkanResult(vkBeginCommandBuffer(m_CommandBuffers[m_CurrentFrame], &beginInfo), "vkBeginCommandBuffer(frame)");
+
+		m_FrameInProgress = true;
+		++m_FrameNumber;
+		vmaSetCurrentFrameIndex(m_Allocator, static_cast<uint32_t>(m_FrameNumber));
+	}
+
+	void VulkanContext::EndHeadlessFrame()
+	{
+		ValidateVulkanResult(vkEndCommandBuffer(m_CommandBuffers[m_CurrentFrame]), "vkEndCommandBuffer(frame)");
+
+		VkCommandBufferSubmitInfo commandBufferInfo{};
+		commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+		commandBufferInfo.commandBuffer = m_CommandBuffers[m_CurrentFrame];
+
+		VkSubmitInfo2 submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+		submitInfo.commandBufferInfoCount = 1;
+		submitInfo.pCommandBufferInfos = &commandBufferInfo;
+
+		{
+			SN_PROFILE_SCOPE("vkQueueSubmit2(frame)");
+			ValidateVulkanResult(vkQueueSubmit2(m_GraphicsQueue, 1, &submitInfo, m_InFlightFences[m_CurrentFrame]), "vkQueueSubmit2");
+		}
+
+		m_CurrentFrame = (m_CurrentFrame + 1) % kMaxFramesInFlight;
+		m_FrameInProgress = false;
+	}
+
 	void VulkanContext::SwapBuffers()
 	{
 		BeginFrame();
@@ -339,7 +403,7 @@ namespace Syndra {
 
 		m_VSync = enabled;
 
-		if (m_Initialized)
+		if (m_Initialized && !IsHeadless())
 		{
 			RecreateSwapchain();
 		}
@@ -350,12 +414,17 @@ namespace Syndra {
 		if (kEnableValidationLayers && !CheckValidationLayerSupport())
 			throw std::runtime_error("Requested Vulkan validation layers are not available.");
 
-		uint32_t requiredExtensionCount = 0;
-		const char** requiredExtensions = glfwGetRequiredInstanceExtensions(&requiredExtensionCount);
-		if (requiredExtensions == nullptr)
-			throw std::runtime_error("GLFW did not report required Vulkan instance extensions.");
+		// A headless context renders offscreen only and needs no surface extensions.
+		std::vector<const char*> extensions;
+		if (!IsHeadless())
+		{
+			uint32_t requiredExtensionCount = 0;
+			const char** requiredExtensions = glfwGetRequiredInstanceExtensions(&requiredExtensionCount);
+			if (requiredExtensions == nullptr)
+				throw std::runtime_error("GLFW did not report required Vulkan instance extensions.");
 
-		std::vector<const char*> extensions(requiredExtensions, requiredExtensions + requiredExtensionCount);
+			extensions.assign(requiredExtensions, requiredExtensions + requiredExtensionCount);
+		}
 		if (kEnableValidationLayers)
 			extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 
@@ -483,15 +552,43 @@ namespace Syndra {
 		VkPhysicalDeviceVulkan12Features vulkan12Features{};
 		vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
 		vulkan12Features.separateDepthStencilLayouts = VK_TRUE;
+		// Bindless texture table (VulkanBindlessTextureTable).
+		vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+		vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+		vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		vulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
 
 		VkPhysicalDeviceVulkan14Features vulkan14Features{};
 		vulkan14Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_4_FEATURES;
 		vulkan14Features.pNext = &vulkan13Features;
 		vulkan13Features.pNext = &vulkan12Features;
 
+		VkPhysicalDeviceFeatures supportedFeatures{};
+		vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &supportedFeatures);
+		m_SupportsTextureCompressionBC = supportedFeatures.textureCompressionBC == VK_TRUE;
+
+		// GPU-driven rendering (VulkanGpuScene) reads draw counts and first-instance offsets from buffers,
+		// and indexes the bindless table with per-instance material indices.
+		VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+		supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		VkPhysicalDeviceFeatures2 supportedFeatures2{};
+		supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		supportedFeatures2.pNext = &supportedVulkan12Features;
+		vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supportedFeatures2);
+		m_SupportsIndirectDrawCount =
+			supportedVulkan12Features.drawIndirectCount == VK_TRUE &&
+			supportedFeatures.multiDrawIndirect == VK_TRUE &&
+			supportedFeatures.drawIndirectFirstInstance == VK_TRUE &&
+			supportedVulkan12Features.shaderSampledImageArrayNonUniformIndexing == VK_TRUE;
+		vulkan12Features.drawIndirectCount = m_SupportsIndirectDrawCount ? VK_TRUE : VK_FALSE;
+		vulkan12Features.shaderSampledImageArrayNonUniformIndexing = m_SupportsIndirectDrawCount ? VK_TRUE : VK_FALSE;
+
 		VkPhysicalDeviceFeatures2 deviceFeatures{};
 		deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
 		deviceFeatures.features.independentBlend = VK_TRUE;
+		deviceFeatures.features.textureCompressionBC = m_SupportsTextureCompressionBC ? VK_TRUE : VK_FALSE;
+		deviceFeatures.features.multiDrawIndirect = m_SupportsIndirectDrawCount ? VK_TRUE : VK_FALSE;
+		deviceFeatures.features.drawIndirectFirstInstance = m_SupportsIndirectDrawCount ? VK_TRUE : VK_FALSE;
 		deviceFeatures.pNext = &vulkan14Features;
 
 		VkDeviceCreateInfo createInfo{};
@@ -499,8 +596,24 @@ namespace Syndra {
 		createInfo.pNext = &deviceFeatures;
 		createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 		createInfo.pQueueCreateInfos = queueCreateInfos.data();
-		createInfo.enabledExtensionCount = static_cast<uint32_t>(kDeviceExtensions.size());
-		createInfo.ppEnabledExtensionNames = kDeviceExtensions.data();
+		std::vector<const char*> enabledExtensions;
+		if (!IsHeadless())
+			enabledExtensions.assign(kDeviceExtensions.begin(), kDeviceExtensions.end());
+		{
+			uint32_t extensionCount = 0;
+			vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &extensionCount, nullptr);
+			std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+			vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &extensionCount, availableExtensions.data());
+			m_SupportsMemoryBudget = std::any_of(availableExtensions.begin(), availableExtensions.end(), [](const VkExtensionProperties& extension)
+				{
+					return std::strcmp(extension.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0;
+				});
+			if (m_SupportsMemoryBudget)
+				enabledExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+		}
+
+		createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+		createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
 		if (kEnableValidationLayers)
 		{
@@ -524,7 +637,8 @@ namespace Syndra {
 		VmaVulkanFunctions vulkanFunctions{};
 
 		VmaAllocatorCreateInfo allocatorInfo{};
-		allocatorInfo.flags = VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+		// Without the extension VMA still tracks its own allocations and estimates the budget as a fraction of the heap.
+		allocatorInfo.flags = m_SupportsMemoryBudget ? VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT : 0;
 		allocatorInfo.physicalDevice = m_PhysicalDevice;
 		allocatorInfo.device = m_Device;
 		allocatorInfo.instance = m_Instance;
@@ -669,6 +783,81 @@ namespace Syndra {
 		}
 	}
 
+	void VulkanContext::GetDeviceLocalMemoryBudget(uint64_t& outUsage, uint64_t& outBudget) const
+	{
+		outUsage = 0;
+		outBudget = 0;
+		if (m_Allocator == nullptr)
+			return;
+
+		const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+		vmaGetMemoryProperties(m_Allocator, &memoryProperties);
+
+		std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+		vmaGetHeapBudgets(m_Allocator, budgets.data());
+		for (uint32_t heap = 0; heap < memoryProperties->memoryHeapCount; ++heap)
+		{
+			if ((memoryProperties->memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0)
+				continue;
+
+			outUsage += budgets[heap].usage;
+			outBudget += budgets[heap].budget;
+		}
+	}
+
+	uint64_t VulkanContext::GetAllocationSize(VmaAllocation allocation) const
+	{
+		if (m_Allocator == nullptr || allocation == nullptr)
+			return 0;
+
+		VmaAllocationInfo allocationInfo{};
+		vmaGetAllocationInfo(m_Allocator, allocation, &allocationInfo);
+		return allocationInfo.size;
+	}
+
+	void VulkanContext::GetAllocatorStatistics(uint64_t& outAllocationBytes, uint64_t& outBlockBytes) const
+	{
+		outAllocationBytes = 0;
+		outBlockBytes = 0;
+		if (m_Allocator == nullptr)
+			return;
+
+		const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+		vmaGetMemoryProperties(m_Allocator, &memoryProperties);
+
+		std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+		vmaGetHeapBudgets(m_Allocator, budgets.data());
+		for (uint32_t heap = 0; heap < memoryProperties->memoryHeapCount; ++heap)
+		{
+			outAllocationBytes += budgets[heap].statistics.allocationBytes;
+			outBlockBytes += budgets[heap].statistics.blockBytes;
+		}
+	}
+
+	void VulkanContext::DeferRelease(std::function<void()>&& release)
+	{
+		if (!release)
+			return;
+
+		// The frame currently being recorded (or the last one submitted) may still use the resource.
+		m_DeferredReleases.push_back(DeferredRelease{ m_FrameNumber, std::move(release) });
+	}
+
+	void VulkanContext::RunDeferredReleases(bool force)
+	{
+		// Called right after waiting on the fence of the frame kMaxFramesInFlight back, so every
+		// frame up to (m_FrameNumber + 1 - kMaxFramesInFlight) has completed.
+		while (!m_DeferredReleases.empty())
+		{
+			DeferredRelease& entry = m_DeferredReleases.front();
+			if (!force && entry.FrameNumber + kMaxFramesInFlight > m_FrameNumber + 1)
+				break;
+
+			entry.Release();
+			m_DeferredReleases.pop_front();
+		}
+	}
+
 	void VulkanContext::DestroyRenderFinishedSemaphores()
 	{
 		for (VkSemaphore semaphore : m_RenderFinishedSemaphores)
@@ -701,7 +890,7 @@ namespace Syndra {
 
 	void VulkanContext::RecreateSwapchain()
 	{
-		if (glfwWindowShouldClose(m_WindowHandle))
+		if (IsHeadless() || glfwWindowShouldClose(m_WindowHandle))
 			return;
 
 		WaitForValidFramebufferSize();
@@ -842,6 +1031,15 @@ namespace Syndra {
 			if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)
 				indices.GraphicsFamily = i;
 
+			// Nothing is presented without a surface; the graphics queue stands in for the present queue.
+			if (IsHeadless())
+			{
+				indices.PresentFamily = indices.GraphicsFamily;
+				if (indices.IsComplete())
+					break;
+				continue;
+			}
+
 			VkBool32 presentSupport = VK_FALSE;
 			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
 			if (presentSupport == VK_TRUE)
@@ -949,6 +1147,10 @@ namespace Syndra {
 		if (vulkan13Features.dynamicRendering != VK_TRUE ||
 			vulkan13Features.synchronization2 != VK_TRUE ||
 			vulkan12Features.separateDepthStencilLayouts != VK_TRUE ||
+			vulkan12Features.runtimeDescriptorArray != VK_TRUE ||
+			vulkan12Features.descriptorBindingPartiallyBound != VK_TRUE ||
+			vulkan12Features.descriptorBindingSampledImageUpdateAfterBind != VK_TRUE ||
+			vulkan12Features.descriptorBindingUpdateUnusedWhilePending != VK_TRUE ||
 			features2.features.independentBlend != VK_TRUE)
 		{
 			return false;
@@ -958,6 +1160,9 @@ namespace Syndra {
 		if (!indices.IsComplete())
 			return false;
 
+		if (IsHeadless())
+			return true;
+
 		if (!CheckDeviceExtensionSupport(device))
 			return false;
 
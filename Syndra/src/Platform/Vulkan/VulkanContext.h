@@ -5,6 +5,7 @@
 #include <volk.h>
 
 #include <array>
+#include <deque>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -19,6 +20,8 @@ namespace Syndra {
 	class VulkanContext : public GraphicsContext
 	{
 	public:
+		// A null windowHandle creates a headless context: no surface or swapchain, frames are submitted
+		// without presenting and everything renders into offscreen framebuffers.
 		explicit VulkanContext(GLFWwindow* windowHandle);
 		~VulkanContext() override;
 
@@ -28,6 +31,7 @@ namespace Syndra {
 		void SwapBuffers() override;
 		void SetVSync(bool enabled) override;
 
+		bool IsHeadless() const { return m_WindowHandle == nullptr; }
 		VkInstance GetInstance() const { return m_Instance; }
 		VkPhysicalDevice GetPhysicalDevice() const { return m_PhysicalDevice; }
 		VkDevice GetDevice() const { return m_Device; }
@@ -45,6 +49,17 @@ namespace Syndra {
 		uint32_t GetFramesInFlight() const { return static_cast<uint32_t>(m_CommandBuffers.size()); }
 		uint64_t GetFrameNumber() const { return m_FrameNumber; }
 		VmaAllocator GetAllocator() const { return m_Allocator; }
+		bool SupportsTextureCompressionBC() const { return m_SupportsTextureCompressionBC; }
+		bool SupportsIndirectDrawCount() const { return m_SupportsIndirectDrawCount; }
+		bool SupportsMemoryBudget() const { return m_SupportsMemoryBudget; }
+		// Device-local heap usage and budget as tracked by VMA (VK_EXT_memory_budget when available).
+		void GetDeviceLocalMemoryBudget(uint64_t& outUsage, uint64_t& outBudget) const;
+		// Bytes VMA set aside for allocation (0 for null); what MemoryTracker is told about.
+		uint64_t GetAllocationSize(VmaAllocation allocation) const;
+		// Bytes in live VMA allocations and in the device memory blocks holding them, over all heaps.
+		void GetAllocatorStatistics(uint64_t& outAllocationBytes, uint64_t& outBlockBytes) const;
+		// Runs 'release' once every frame that may still reference the resource has finished on the GPU.
+		void DeferRelease(std::function<void()>&& release);
 		void SetOverlayRenderCallback(const std::function<void(VkCommandBuffer, uint32_t)>& callback) { m_OverlayRenderCallback = callback; }
 
 		VkCommandBuffer BeginSingleTimeCommands() const;
@@ -85,6 +100,9 @@ namespace Syndra {
 		void CreateSyncObjects();
 		void CreateRenderFinishedSemaphores();
 		void DestroyRenderFinishedSemaphores();
+		void RunDeferredReleases(bool force);
+		void BeginHeadlessFrame();
+		void EndHeadlessFrame();
 
 		void CleanupSwapchain();
 		void RecreateSwapchain();
@@ -113,6 +131,9 @@ namespace Syndra {
 		bool m_FramebufferResized = false;
 		bool m_VSync = true;
 		bool m_FrameInProgress = false;
+		bool m_SupportsTextureCompressionBC = false;
+		bool m_SupportsIndirectDrawCount = false;
+		bool m_SupportsMemoryBudget = false;
 		uint32_t m_AcquiredImageIndex = 0;
 		uint32_t m_CurrentFrame = 0;
 		uint64_t m_FrameNumber = 0;
@@ -146,6 +167,13 @@ namespace Syndra {
 		VmaAllocator m_Allocator = nullptr;
 		std::function<void(VkCommandBuffer, uint32_t)> m_OverlayRenderCallback;
 
+		struct DeferredRelease
+		{
+			uint64_t FrameNumber = 0;
+			std::function<void()> Release;
+		};
+		std::deque<DeferredRelease> m_DeferredReleases;
+
 		static VulkanContext* s_CurrentContext;
 	};
 
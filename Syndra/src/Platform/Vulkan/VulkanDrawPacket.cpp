@@ -0,0 +1,80 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanDrawPacket.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanShader.h"
+
+namespace Syndra {
+
+	std::atomic<uint64_t> VulkanDrawPacket::s_Generation{ 1 };
+
+	VulkanPacketDescriptorPool::~VulkanPacketDescriptorPool()
+	{
+		if (Device != VK_NULL_HANDLE && Pool != VK_NULL_HANDLE)
+			vkDestroyDescriptorPool(Device, Pool, nullptr);
+	}
+
+	VulkanDrawPacket::~VulkanDrawPacket()
+	{
+		Release();
+	}
+
+	bool VulkanDrawPacket::FindPushConstant(const std::string& name, PushConstantSlot& outSlot) const
+	{
+		if (m_Shader == nullptr)
+			return false;
+
+		uint32_t offset = 0;
+		uint32_t size = 0;
+		if (!m_Shader->TryGetPushConstantMember(name, offset, size) || offset + size > m_PushConstants.size())
+			return false;
+
+		outSlot.Offset = offset;
+		outSlot.Size = size;
+		return true;
+	}
+
+	void VulkanDrawPacket::SetPushConstant(const PushConstantSlot& slot, const void* data, uint32_t size)
+	{
+		if (data == nullptr || size == 0 || slot.Size == 0)
+			return;
+
+		SN_CORE_ASSERT(slot.Offset + slot.Size <= m_PushConstants.size(), "Push constant slot does not belong to this packet.");
+		memcpy(m_PushConstants.data() + slot.Offset, data, std::min(size, slot.Size));
+	}
+
+	void VulkanDrawPacket::Release()
+	{
+		if (m_BindlessSetIndex < m_DescriptorSets.size())
+			m_DescriptorSets.erase(m_DescriptorSets.begin() + m_BindlessSetIndex);
+
+		if (!m_DescriptorSets.empty() && m_DescriptorPool)
+		{
+			// Without a context the device is gone, and its pools with it.
+			VulkanContext* context = VulkanContext::GetCurrent();
+			if (context != nullptr)
+			{
+				context->DeferRelease([pool = m_DescriptorPool, sets = std::move(m_DescriptorSets)]()
+				{
+					vkFreeDescriptorSets(pool->Device, pool->Pool, static_cast<uint32_t>(sets.size()), sets.data());
+				});
+			}
+			else
+			{
+				m_DescriptorPool->Device = VK_NULL_HANDLE;
+			}
+		}
+
+		m_DescriptorSets.clear();
+		m_BindlessSetIndex = UINT32_MAX;
+		m_DescriptorPool = nullptr;
+		m_Shader = nullptr;
+		m_FrameBuffer = nullptr;
+		m_Pipeline = VK_NULL_HANDLE;
+		m_PushConstants.clear();
+		m_UniformBuffers.clear();
+		m_Generation = 0;
+	}
+
+}
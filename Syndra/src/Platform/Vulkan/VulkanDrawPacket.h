@@ -0,0 +1,84 @@
+#pragma once
+
+#include <volk.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Syndra {
+
+	class VulkanFrameBuffer;
+	class VulkanShader;
+	class VulkanUniformBuffer;
+
+	// Descriptor pool owned jointly by the draw packets holding sets from it.
+	struct VulkanPacketDescriptorPool
+	{
+		VkDevice Device = VK_NULL_HANDLE;
+		VkDescriptorPool Pool = VK_NULL_HANDLE;
+
+		~VulkanPacketDescriptorPool();
+	};
+
+	// A draw resolved once by VulkanRendererAPI::BuildDrawPacket() and replayed every frame with
+	// SubmitDrawPacket(): pipeline, vertex/index buffers, viewport, descriptor sets from a persistent
+	// pool and a copy of the shader's push constants. Uniform data is not captured: each submit binds
+	// the slices the uniform buffers hold in the current frame. Anything that can change the captured
+	// state (shader reload, texture registration, uniform buffer lifetime, uniform ring growth,
+	// framebuffer resize) calls InvalidateAll(); owners rebuild packets that are no longer valid.
+	class VulkanDrawPacket
+	{
+	public:
+		struct PushConstantSlot
+		{
+			uint32_t Offset = 0;
+			uint32_t Size = 0;
+		};
+
+		VulkanDrawPacket() = default;
+		~VulkanDrawPacket();
+
+		VulkanDrawPacket(const VulkanDrawPacket&) = delete;
+		VulkanDrawPacket& operator=(const VulkanDrawPacket&) = delete;
+
+		bool IsValid() const { return m_Shader != nullptr && m_Generation == s_Generation.load(std::memory_order_relaxed); }
+
+		// Resolve a member once after building, then patch per-frame values (transforms, ids).
+		bool FindPushConstant(const std::string& name, PushConstantSlot& outSlot) const;
+		void SetPushConstant(const PushConstantSlot& slot, const void* data, uint32_t size);
+
+		static void InvalidateAll() { s_Generation.fetch_add(1, std::memory_order_relaxed); }
+
+	private:
+		// Frees the descriptor sets once the frames that may still use them have completed.
+		void Release();
+
+	private:
+		const VulkanShader* m_Shader = nullptr;
+		VulkanFrameBuffer* m_FrameBuffer = nullptr;
+		VkPipeline m_Pipeline = VK_NULL_HANDLE;
+		VkBuffer m_VertexBuffer = VK_NULL_HANDLE;
+		VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
+		uint32_t m_IndexCount = 0;
+		int32_t m_VertexOffset = 0;
+		uint32_t m_FirstIndex = 0;
+		VkViewport m_Viewport{};
+		VkRect2D m_Scissor{};
+		std::vector<VkDescriptorSet> m_DescriptorSets;
+		// Entry of m_DescriptorSets holding the shared bindless texture set, which is not freed.
+		uint32_t m_BindlessSetIndex = UINT32_MAX;
+		std::shared_ptr<VulkanPacketDescriptorPool> m_DescriptorPool;
+		std::vector<uint8_t> m_PushConstants;
+		// Dynamic uniform bindings in set/binding order; their slices are resolved on every submit.
+		std::vector<VulkanUniformBuffer*> m_UniformBuffers;
+		uint64_t m_Generation = 0;
+
+		static std::atomic<uint64_t> s_Generation;
+
+		friend class VulkanRendererAPI;
+	};
+
+}
@@ -237,7 +237,7 @@ namespace {
 			VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
 			VK_PIPELINE_STAGE_2_NONE,
 			0,
-			VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
+			VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
 			VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
 			layerCount);
 		context->EndSingleTimeCommands(commandBuffer);
@@ -292,7 +292,7 @@ namespace {
 			srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
 			break;
 		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
-			srcStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT;
+			srcStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT;
 			srcAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
 			break;
 		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
@@ -334,7 +334,7 @@ namespace {
 			dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
 			break;
 		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
-			dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT;
+			dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT;
 			dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
 			break;
 		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
@@ -455,6 +455,7 @@ namespace Syndra {
 			&allocationInfo);
 		if (stagingResult != VK_SUCCESS || allocationInfo.pMappedData == nullptr)
 			return -1;
+		const TrackedMemory stagingMemory(MemoryDomain::Gpu, MemoryCategory::Staging, allocationInfo.size);
 
 		const VkCommandBuffer commandBuffer = context->BeginSingleTimeCommands();
 		TransitionTrackedImageLayout(
@@ -932,6 +933,11 @@ namespace Syndra {
 				m_CubemapImageView,
 				m_CubemapImageLayout);
 		}
+
+		uint64_t allocatedBytes = context->GetAllocationSize(m_DepthAllocation) + context->GetAllocationSize(m_CubemapAllocation);
+		for (const auto& attachment : m_ColorAttachments)
+			allocatedBytes += context->GetAllocationSize(attachment.Allocation);
+		m_GpuMemory.Set(allocatedBytes);
 	}
 
 	void VulkanFrameBuffer::ReleaseResources()
@@ -945,6 +951,7 @@ namespace Syndra {
 		}
 		VulkanImGuiTextureRegistry::UnregisterTexture(m_DepthAttachmentRendererID);
 		VulkanImGuiTextureRegistry::UnregisterTexture(m_CubemapAttachmentRendererID);
+		m_GpuMemory.Reset();
 
 		VulkanContext* context = VulkanContext::GetCurrent();
 		if (context == nullptr)
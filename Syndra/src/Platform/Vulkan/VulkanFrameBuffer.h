@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/FrameBuffer.h"
 
 #include <volk.h>
@@ -85,6 +86,7 @@ namespace Syndra {
 		uint32_t m_CubemapAttachmentRendererID = 0;
 
 		VkSampler m_AttachmentSampler = VK_NULL_HANDLE;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::FrameBuffers };
 		static VulkanFrameBuffer* s_BoundFrameBuffer;
 	};
 
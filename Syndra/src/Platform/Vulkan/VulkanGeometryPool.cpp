@@ -0,0 +1,433 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanGeometryPool.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanDrawPacket.h"
+#include "vk_mem_alloc.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr VkDeviceSize kVertexBlockSize = 32ull * 1024 * 1024;
+		constexpr VkDeviceSize kIndexBlockSize = 8ull * 1024 * 1024;
+
+		VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+		{
+			return ((value + alignment - 1) / alignment) * alignment;
+		}
+
+		// Makes transfer writes visible to the vertex input stage of later submissions.
+		void RecordTransferToVertexInputBarrier(VkCommandBuffer commandBuffer)
+		{
+			VkMemoryBarrier2 barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+			barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+			barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+			barrier.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+			barrier.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT;
+
+			VkDependencyInfo dependencyInfo{};
+			dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+			dependencyInfo.memoryBarrierCount = 1;
+			dependencyInfo.pMemoryBarriers = &barrier;
+			vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+		}
+
+	}
+
+	VulkanGeometryPool& VulkanGeometryPool::GetVertexPool()
+	{
+		static VulkanGeometryPool pool(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kVertexBlockSize, "vertex");
+		return pool;
+	}
+
+	VulkanGeometryPool& VulkanGeometryPool::GetIndexPool()
+	{
+		static VulkanGeometryPool pool(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, kIndexBlockSize, "index");
+		return pool;
+	}
+
+	VulkanGeometryPool::VulkanGeometryPool(VkBufferUsageFlags usage, VkDeviceSize blockSize, const char* name)
+		: m_Usage(usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT), m_BlockSize(blockSize), m_Name(name)
+	{
+	}
+
+	VulkanGeometryPool::AllocationID VulkanGeometryPool::Allocate(const void* data, VkDeviceSize size, VkDeviceSize alignment)
+	{
+		if (size == 0 || VulkanContext::GetCurrent() == nullptr)
+			return InvalidAllocation;
+
+		alignment = std::max<VkDeviceSize>(alignment, 1);
+
+		Block* bestBlock = nullptr;
+		VkDeviceSize bestOffset = 0;
+		VkDeviceSize bestWaste = std::numeric_limits<VkDeviceSize>::max();
+		for (const auto& block : m_Blocks)
+		{
+			VkDeviceSize offset = 0;
+			VkDeviceSize waste = 0;
+			if (TryPlace(*block, size, alignment, offset, waste) && waste < bestWaste)
+			{
+				bestBlock = block.get();
+				bestOffset = offset;
+				bestWaste = waste;
+			}
+		}
+
+		if (bestBlock == nullptr)
+		{
+			bestBlock = CreateBlock(size + alignment);
+			VkDeviceSize waste = 0;
+			if (bestBlock == nullptr || !TryPlace(*bestBlock, size, alignment, bestOffset, waste))
+				return InvalidAllocation;
+		}
+
+		// Carve the range out of the free range holding it; the alignment gap stays free.
+		auto freeIt = std::prev(bestBlock->FreeRanges.upper_bound(bestOffset));
+		const VkDeviceSize freeStart = freeIt->first;
+		const VkDeviceSize freeEnd = freeIt->first + freeIt->second;
+		bestBlock->FreeRanges.erase(freeIt);
+		if (bestOffset > freeStart)
+			bestBlock->FreeRanges.emplace(freeStart, bestOffset - freeStart);
+		if (bestOffset + size < freeEnd)
+			bestBlock->FreeRanges.emplace(bestOffset + size, freeEnd - (bestOffset + size));
+
+		bestBlock->Used += size;
+		++bestBlock->LiveAllocations;
+		if (data != nullptr)
+			Upload(*bestBlock, bestOffset, data, size);
+
+		AllocationID id = InvalidAllocation;
+		if (!m_FreeAllocationIDs.empty())
+		{
+			id = m_FreeAllocationIDs.back();
+			m_FreeAllocationIDs.pop_back();
+		}
+		else
+		{
+			id = static_cast<AllocationID>(m_Allocations.size());
+			m_Allocations.emplace_back();
+		}
+
+		m_Allocations[id] = AllocationRecord{ bestBlock, bestOffset, size, alignment };
+		return id;
+	}
+
+	void VulkanGeometryPool::Free(AllocationID allocation)
+	{
+		if (allocation >= m_Allocations.size() || m_Allocations[allocation].Owner == nullptr)
+			return;
+
+		AllocationRecord& record = m_Allocations[allocation];
+		Block* block = record.Owner;
+		block->Used -= record.Size;
+		--block->LiveAllocations;
+
+		if (block->LiveAllocations == 0)
+		{
+			RetireBlock(block);
+		}
+		else if (VulkanContext* context = VulkanContext::GetCurrent())
+		{
+			// The range may be reused once the frames that could still read it are done.
+			context->DeferRelease([this, serial = block->Serial, offset = record.Offset, size = record.Size]()
+			{
+				if (Block* owner = FindBlock(serial))
+					ReleaseRange(*owner, offset, size);
+			});
+		}
+		else
+		{
+			ReleaseRange(*block, record.Offset, record.Size);
+		}
+
+		record = {};
+		m_FreeAllocationIDs.push_back(allocation);
+	}
+
+	VulkanGeometryPool::Range VulkanGeometryPool::GetRange(AllocationID allocation) const
+	{
+		if (allocation >= m_Allocations.size() || m_Allocations[allocation].Owner == nullptr)
+			return {};
+
+		const AllocationRecord& record = m_Allocations[allocation];
+		return Range{ record.Owner->Buffer, record.Offset, record.Size };
+	}
+
+	uint32_t VulkanGeometryPool::Defragment(float minFragmentation)
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr)
+			return 0;
+
+		std::vector<Block*> fragmentedBlocks;
+		for (const auto& block : m_Blocks)
+		{
+			if (block->LiveAllocations > 0 && block->FreeRanges.size() > 1 && GetFragmentation(*block) >= minFragmentation)
+				fragmentedBlocks.push_back(block.get());
+		}
+
+		uint32_t compactedBlocks = 0;
+		for (Block* oldBlock : fragmentedBlocks)
+		{
+			std::vector<AllocationRecord*> records;
+			records.reserve(oldBlock->LiveAllocations);
+			for (AllocationRecord& record : m_Allocations)
+			{
+				if (record.Owner == oldBlock)
+					records.push_back(&record);
+			}
+			std::sort(records.begin(), records.end(), [](const AllocationRecord* a, const AllocationRecord* b) {
+				return a->Offset < b->Offset;
+				});
+
+			Block* newBlock = CreateBlock(oldBlock->Used + oldBlock->Size / 16);
+			if (newBlock == nullptr)
+				break;
+
+			// Packed in their old order, so the copies never overlap and keep their relative layout.
+			std::vector<VkBufferCopy> copies;
+			copies.reserve(records.size());
+			VkDeviceSize head = 0;
+			for (AllocationRecord* record : records)
+			{
+				const VkDeviceSize offset = AlignUp(head, record->Alignment);
+				copies.push_back(VkBufferCopy{ record->Offset, offset, record->Size });
+				record->Owner = newBlock;
+				record->Offset = offset;
+				head = offset + record->Size;
+				newBlock->Used += record->Size;
+				++newBlock->LiveAllocations;
+			}
+
+			newBlock->FreeRanges.clear();
+			if (head < newBlock->Size)
+				newBlock->FreeRanges.emplace(head, newBlock->Size - head);
+
+			VkCommandBuffer commandBuffer = context->BeginSingleTimeCommands();
+			vkCmdCopyBuffer(commandBuffer, oldBlock->Buffer, newBlock->Buffer, static_cast<uint32_t>(copies.size()), copies.data());
+			RecordTransferToVertexInputBarrier(commandBuffer);
+			context->EndSingleTimeCommands(commandBuffer);
+
+			// Draws already recorded this frame keep reading the old block until it retires.
+			oldBlock->LiveAllocations = 0;
+			RetireBlock(oldBlock);
+			++compactedBlocks;
+		}
+
+		if (compactedBlocks > 0)
+		{
+			VulkanDrawPacket::InvalidateAll();
+			SN_CORE_TRACE("Compacted {} Vulkan {} geometry blocks.", compactedBlocks, m_Name);
+		}
+
+		return compactedBlocks;
+	}
+
+	VulkanGeometryPool::Stats VulkanGeometryPool::GetStats() const
+	{
+		Stats stats;
+		VkDeviceSize totalFree = 0;
+		for (const auto& block : m_Blocks)
+		{
+			++stats.Blocks;
+			stats.Allocations += block->LiveAllocations;
+			stats.FreeRanges += static_cast<uint32_t>(block->FreeRanges.size());
+			stats.Capacity += block->Size;
+			stats.Used += block->Used;
+			for (const auto& [_, size] : block->FreeRanges)
+			{
+				totalFree += size;
+				stats.LargestFreeRange = std::max(stats.LargestFreeRange, size);
+			}
+		}
+
+		if (totalFree > 0)
+			stats.Fragmentation = 1.0f - static_cast<float>(static_cast<double>(stats.LargestFreeRange) / static_cast<double>(totalFree));
+		return stats;
+	}
+
+	VulkanGeometryPool::Block* VulkanGeometryPool::CreateBlock(VkDeviceSize minSize)
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr || context->GetAllocator() == nullptr)
+			return nullptr;
+
+		const VkDeviceSize size = AlignUp(std::max(m_BlockSize, minSize), 256);
+
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = m_Usage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		// Device-local; written directly when that memory is also host visible (ReBAR, UMA),
+		// through a staging copy otherwise.
+		VmaAllocationCreateInfo allocationCreateInfo{};
+		allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+		allocationCreateInfo.flags =
+			VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+			VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
+			VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		auto block = std::make_unique<Block>();
+		VmaAllocationInfo allocationInfo{};
+		if (vmaCreateBuffer(context->GetAllocator(), &bufferInfo, &allocationCreateInfo, &block->Buffer, &block->Allocation, &allocationInfo) != VK_SUCCESS)
+		{
+			SN_CORE_ERROR("Failed to allocate a {} MiB Vulkan {} geometry block.", size / (1024 * 1024), m_Name);
+			return nullptr;
+		}
+
+		VkMemoryPropertyFlags memoryProperties = 0;
+		vmaGetAllocationMemoryProperties(context->GetAllocator(), block->Allocation, &memoryProperties);
+		if ((memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0)
+			block->MappedData = static_cast<uint8_t*>(allocationInfo.pMappedData);
+
+		block->Serial = m_NextBlockSerial++;
+		block->Size = size;
+		block->GpuMemory.Set(allocationInfo.size);
+		block->FreeRanges.emplace(0, size);
+		SN_CORE_TRACE("Allocated a {} MiB Vulkan {} geometry block ({}).", size / (1024 * 1024), m_Name, block->MappedData != nullptr ? "mapped" : "staged");
+
+		m_Blocks.push_back(std::move(block));
+		return m_Blocks.back().get();
+	}
+
+	void VulkanGeometryPool::RetireBlock(Block* block)
+	{
+		const auto it = std::find_if(m_Blocks.begin(), m_Blocks.end(), [block](const std::unique_ptr<Block>& candidate) {
+			return candidate.get() == block;
+			});
+		if (it == m_Blocks.end())
+			return;
+
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context != nullptr && context->GetAllocator() != nullptr)
+		{
+			context->DeferRelease([allocator = context->GetAllocator(), buffer = block->Buffer, allocation = block->Allocation]()
+			{
+				vmaDestroyBuffer(allocator, buffer, allocation);
+			});
+		}
+
+		m_Blocks.erase(it);
+	}
+
+	VulkanGeometryPool::Block* VulkanGeometryPool::FindBlock(uint64_t serial) const
+	{
+		for (const auto& block : m_Blocks)
+		{
+			if (block->Serial == serial)
+				return block.get();
+		}
+
+		return nullptr;
+	}
+
+	bool VulkanGeometryPool::TryPlace(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset, VkDeviceSize& outWaste)
+	{
+		bool found = false;
+		for (const auto& [start, length] : block.FreeRanges)
+		{
+			const VkDeviceSize offset = AlignUp(start, alignment);
+			if (offset + size > start + length)
+				continue;
+
+			const VkDeviceSize waste = length - size;
+			if (!found || waste < outWaste)
+			{
+				outOffset = offset;
+				outWaste = waste;
+				found = true;
+				if (waste == 0)
+					break;
+			}
+		}
+
+		return found;
+	}
+
+	void VulkanGeometryPool::ReleaseRange(Block& block, VkDeviceSize offset, VkDeviceSize size)
+	{
+		auto& freeRanges = block.FreeRanges;
+		auto it = freeRanges.emplace(offset, size).first;
+
+		// Merge with the following range, then with the preceding one.
+		auto next = std::next(it);
+		if (next != freeRanges.end() && it->first + it->second == next->first)
+		{
+			it->second += next->second;
+			freeRanges.erase(next);
+		}
+
+		if (it != freeRanges.begin())
+		{
+			auto previous = std::prev(it);
+			if (previous->first + previous->second == it->first)
+			{
+				previous->second += it->second;
+				freeRanges.erase(it);
+			}
+		}
+	}
+
+	void VulkanGeometryPool::Upload(Block& block, VkDeviceSize offset, const void* data, VkDeviceSize size)
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (block.MappedData != nullptr)
+		{
+			memcpy(block.MappedData + offset, data, static_cast<size_t>(size));
+			vmaFlushAllocation(context->GetAllocator(), block.Allocation, offset, size);
+			return;
+		}
+
+		VkBufferCreateInfo stagingInfo{};
+		stagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		stagingInfo.size = size;
+		stagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		stagingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo stagingAllocationInfo{};
+		stagingAllocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+		stagingAllocationInfo.flags =
+			VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+			VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		VkBuffer stagingBuffer = VK_NULL_HANDLE;
+		VmaAllocation stagingAllocation = nullptr;
+		VmaAllocationInfo allocationInfo{};
+		const VkResult result = vmaCreateBuffer(context->GetAllocator(), &stagingInfo, &stagingAllocationInfo, &stagingBuffer, &stagingAllocation, &allocationInfo);
+		SN_CORE_ASSERT(result == VK_SUCCESS, "Failed to create Vulkan geometry staging buffer.");
+		const TrackedMemory stagingMemory(MemoryDomain::Gpu, MemoryCategory::Staging, allocationInfo.size);
+
+		memcpy(allocationInfo.pMappedData, data, static_cast<size_t>(size));
+		vmaFlushAllocation(context->GetAllocator(), stagingAllocation, 0, VK_WHOLE_SIZE);
+
+		VkCommandBuffer commandBuffer = context->BeginSingleTimeCommands();
+		const VkBufferCopy copy{ 0, offset, size };
+		vkCmdCopyBuffer(commandBuffer, stagingBuffer, block.Buffer, 1, &copy);
+		RecordTransferToVertexInputBarrier(commandBuffer);
+		context->EndSingleTimeCommands(commandBuffer);
+
+		vmaDestroyBuffer(context->GetAllocator(), stagingBuffer, stagingAllocation);
+	}
+
+	float VulkanGeometryPool::GetFragmentation(const Block& block)
+	{
+		VkDeviceSize totalFree = 0;
+		VkDeviceSize largestFree = 0;
+		for (const auto& [_, size] : block.FreeRanges)
+		{
+			totalFree += size;
+			largestFree = std::max(largestFree, size);
+		}
+
+		return totalFree > 0 ? 1.0f - static_cast<float>(static_cast<double>(largestFree) / static_cast<double>(totalFree)) : 0.0f;
+	}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Engine/Core/MemoryTracker.h"
+
+#include <volk.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+struct VmaAllocation_T;
+
+namespace Syndra {
+
+	using VmaAllocation = VmaAllocation_T*;
+
+	// Sub-allocates immutable geometry out of a few large buffers, one pool for vertices and one for
+	// indices. Ranges are placed best-fit in a free list that coalesces on release; a block whose
+	// last range is released is destroyed. Allocations are handles rather than offsets so that
+	// Defragment() can move them: callers resolve the range each time they record a draw.
+	// Released ranges and replaced blocks are recycled only once the frames in flight retire.
+	class VulkanGeometryPool
+	{
+	public:
+		using AllocationID = uint32_t;
+		static constexpr AllocationID InvalidAllocation = UINT32_MAX;
+
+		struct Range
+		{
+			VkBuffer Buffer = VK_NULL_HANDLE;
+			VkDeviceSize Offset = 0;
+			VkDeviceSize Size = 0;
+		};
+
+		struct Stats
+		{
+			uint32_t Blocks = 0;
+			uint32_t Allocations = 0;
+			uint32_t FreeRanges = 0;
+			VkDeviceSize Capacity = 0;
+			VkDeviceSize Used = 0;
+			VkDeviceSize LargestFreeRange = 0;
+			// 1 - largest free range / total free bytes: 0 when all free space is contiguous.
+			float Fragmentation = 0.0f;
+		};
+
+		static VulkanGeometryPool& GetVertexPool();
+		static VulkanGeometryPool& GetIndexPool();
+
+		VulkanGeometryPool(const VulkanGeometryPool&) = delete;
+		VulkanGeometryPool& operator=(const VulkanGeometryPool&) = delete;
+
+		// Copies 'size' bytes into a range whose offset is a multiple of 'alignment' (which need not
+		// be a power of two, so vertex ranges can start on a whole vertex).
+		AllocationID Allocate(const void* data, VkDeviceSize size, VkDeviceSize alignment);
+		void Free(AllocationID allocation);
+		Range GetRange(AllocationID allocation) const;
+
+		// Compacts every block whose fragmentation reaches 'minFragmentation' into a fresh block and
+		// invalidates draw packets. Returns the number of blocks compacted.
+		uint32_t Defragment(float minFragmentation = 0.25f);
+		Stats GetStats() const;
+
+	private:
+		struct Block
+		{
+			uint64_t Serial = 0;
+			VkBuffer Buffer = VK_NULL_HANDLE;
+			VmaAllocation Allocation = nullptr;
+			TrackedMemory GpuMemory{ MemoryDomain::Gpu, MemoryCategory::Meshes };
+			uint8_t* MappedData = nullptr;
+			VkDeviceSize Size = 0;
+			VkDeviceSize Used = 0;
+			uint32_t LiveAllocations = 0;
+			// Free ranges by offset.
+			std::map<VkDeviceSize, VkDeviceSize> FreeRanges;
+		};
+
+		struct AllocationRecord
+		{
+			Block* Owner = nullptr;
+			VkDeviceSize Offset = 0;
+			VkDeviceSize Size = 0;
+			VkDeviceSize Alignment = 1;
+		};
+
+		explicit VulkanGeometryPool(VkBufferUsageFlags usage, VkDeviceSize blockSize, const char* name);
+
+		Block* CreateBlock(VkDeviceSize minSize);
+		// Removes the block from the pool; its buffer is destroyed once the GPU is done with it.
+		void RetireBlock(Block* block);
+		Block* FindBlock(uint64_t serial) const;
+		static bool TryPlace(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset, VkDeviceSize& outWaste);
+		static void ReleaseRange(Block& block, VkDeviceSize offset, VkDeviceSize size);
+		void Upload(Block& block, VkDeviceSize offset, const void* data, VkDeviceSize size);
+		static float GetFragmentation(const Block& block);
+
+	private:
+		VkBufferUsageFlags m_Usage = 0;
+		VkDeviceSize m_BlockSize = 0;
+		const char* m_Name = "";
+		std::vector<std::unique_ptr<Block>> m_Blocks;
+		std::vector<AllocationRecord> m_Allocations;
+		std::vector<AllocationID> m_FreeAllocationIDs;
+		uint64_t m_NextBlockSerial = 1;
+	};
+
+}
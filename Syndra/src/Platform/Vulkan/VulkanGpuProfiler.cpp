@@ -0,0 +1,126 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanGpuProfiler.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanRendererAPI.h"
+
+namespace Syndra {
+
+	VulkanGpuProfiler::VulkanGpuProfiler()
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr || context->GetDevice() == VK_NULL_HANDLE)
+			return;
+
+		VkPhysicalDeviceProperties properties{};
+		vkGetPhysicalDeviceProperties(context->GetPhysicalDevice(), &properties);
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(context->GetPhysicalDevice(), &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(context->GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+		const uint32_t graphicsFamily = context->GetGraphicsQueueFamily();
+		const uint32_t validBits = (graphicsFamily < queueFamilyCount) ? queueFamilies[graphicsFamily].timestampValidBits : 0;
+		if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f)
+		{
+			SN_CORE_WARN("The graphics queue does not support timestamps, GPU pass timings are disabled.");
+			return;
+		}
+
+		m_TimestampPeriod = static_cast<double>(properties.limits.timestampPeriod);
+		m_TimestampMask = (validBits >= 64) ? UINT64_MAX : ((uint64_t(1) << validBits) - 1);
+		m_FrameCount = context->GetFramesInFlight();
+
+		VkQueryPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		poolInfo.queryCount = m_FrameCount * MaxQueriesPerFrame;
+		if (vkCreateQueryPool(context->GetDevice(), &poolInfo, nullptr, &m_QueryPool) != VK_SUCCESS)
+		{
+			SN_CORE_WARN("Failed to create the Vulkan timestamp query pool, GPU pass timings are disabled.");
+			m_QueryPool = VK_NULL_HANDLE;
+		}
+	}
+
+	VulkanGpuProfiler::~VulkanGpuProfiler()
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context != nullptr && m_QueryPool != VK_NULL_HANDLE)
+		{
+			context->DeferRelease([device = context->GetDevice(), queryPool = m_QueryPool]()
+			{
+				vkDestroyQueryPool(device, queryPool, nullptr);
+			});
+		}
+		m_QueryPool = VK_NULL_HANDLE;
+	}
+
+	uint32_t VulkanGpuProfiler::GetFrameSlot() const
+	{
+		// The context waited for the previous frame of this slot before handing out its command buffer.
+		return VulkanContext::GetCurrent()->GetCurrentFrameIndex() % m_FrameCount;
+	}
+
+	bool VulkanGpuProfiler::ReadTimestamps(uint32_t slot, uint32_t queryCount, std::vector<uint64_t>& timestampsNs)
+	{
+		m_RawTimestamps.resize(queryCount);
+		const VkResult result = vkGetQueryPoolResults(
+			VulkanContext::GetCurrent()->GetDevice(),
+			m_QueryPool,
+			slot * MaxQueriesPerFrame,
+			queryCount,
+			m_RawTimestamps.size() * sizeof(uint64_t),
+			m_RawTimestamps.data(),
+			sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT);
+		if (result != VK_SUCCESS)
+		{
+			// The slot's fence was waited on, so missing results were never written and never will be:
+			// drop the frame instead of skipping this slot forever.
+			timestampsNs.clear();
+			return true;
+		}
+
+		// Relative to the frame's first timestamp, so that counters narrower than 64 bits may wrap.
+		timestampsNs.resize(queryCount);
+		const uint64_t first = m_RawTimestamps[0];
+		for (uint32_t i = 0; i < queryCount; ++i)
+		{
+			const uint64_t ticks = (m_RawTimestamps[i] - first) & m_TimestampMask;
+			timestampsNs[i] = static_cast<uint64_t>(static_cast<double>(ticks) * m_TimestampPeriod);
+		}
+		return true;
+	}
+
+	bool VulkanGpuProfiler::ResetQueries(uint32_t slot)
+	{
+		const VkCommandBuffer commandBuffer = BeginRecording();
+		if (commandBuffer == VK_NULL_HANDLE)
+			return false;
+
+		vkCmdResetQueryPool(commandBuffer, m_QueryPool, slot * MaxQueriesPerFrame, MaxQueriesPerFrame);
+		return true;
+	}
+
+	void VulkanGpuProfiler::WriteTimestamp(uint32_t slot, uint32_t query)
+	{
+		const VkCommandBuffer commandBuffer = BeginRecording();
+		if (commandBuffer == VK_NULL_HANDLE)
+			return;
+
+		vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_QueryPool, slot * MaxQueriesPerFrame + query);
+	}
+
+	VkCommandBuffer VulkanGpuProfiler::BeginRecording() const
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		VulkanRendererAPI* api = VulkanRendererAPI::GetCurrent();
+		if (context == nullptr || api == nullptr)
+			return VK_NULL_HANDLE;
+
+		api->Flush();
+		return context->GetActiveFrameCommandBuffer();
+	}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Engine/Renderer/GpuProfiler.h"
+
+#include <volk.h>
+
+namespace Syndra {
+
+	// vkCmdWriteTimestamp2 queries in one pool with a range of MaxQueriesPerFrame per frame in flight.
+	// A range is read back when its frame slot comes around again, after the frame's fence was waited
+	// on, and reset on the frame's command buffer before it is written again.
+	class VulkanGpuProfiler : public GpuProfiler
+	{
+	public:
+		VulkanGpuProfiler();
+		virtual ~VulkanGpuProfiler();
+
+		virtual bool IsSupported() const override { return m_QueryPool != VK_NULL_HANDLE; }
+	protected:
+		virtual uint32_t GetFrameSlot() const override;
+		virtual uint32_t GetFrameSlotCount() const override { return m_FrameCount; }
+		virtual bool ReadTimestamps(uint32_t slot, uint32_t queryCount, std::vector<uint64_t>& timestampsNs) override;
+		virtual bool ResetQueries(uint32_t slot) override;
+		virtual void WriteTimestamp(uint32_t slot, uint32_t query) override;
+	private:
+		// Records the pending draws, so the timestamps land between the right commands.
+		VkCommandBuffer BeginRecording() const;
+	private:
+		VkQueryPool m_QueryPool = VK_NULL_HANDLE;
+		uint32_t m_FrameCount = 0;
+		// Nanoseconds per timestamp tick and the bits a timestamp actually holds.
+		double m_TimestampPeriod = 1.0;
+		uint64_t m_TimestampMask = UINT64_MAX;
+		std::vector<uint64_t> m_RawTimestamps;
+	};
+
+}
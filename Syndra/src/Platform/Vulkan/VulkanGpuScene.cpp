@@ -0,0 +1,565 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanGpuScene.h"
+
+#include "Engine/Core/Instrument.h"
+#include "Platform/Vulkan/VulkanBuffer.h"
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanRendererAPI.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Syndra {
+
+	namespace {
+
+		static_assert(sizeof(VulkanGpuScene::Instance) == 112, "VulkanGpuScene::Instance must match the std430 layout of the shaders.");
+		static_assert(sizeof(VulkanGpuScene::Material) == 64, "VulkanGpuScene::Material must match the std430 layout of the shaders.");
+
+		constexpr uint32_t kCullWorkgroupSize = 64;
+		constexpr VkDeviceSize kMinInstanceCapacity = 1024;
+		constexpr VkDeviceSize kMinMaterialCapacity = 64;
+		constexpr VkDeviceSize kMinBatchCapacity = 16;
+		// Past the batch counts: instances and triangles a pass left occluded.
+		constexpr uint32_t kOcclusionCountSlots = 2;
+
+		enum CullPhase : int
+		{
+			CullPhaseFrustum = 0,
+			CullPhaseEarly = 1,
+			CullPhaseLate = 2
+		};
+
+		// Replaces buffer with a larger one when 'required' bytes do not fit, doubling to amortize growth.
+		void EnsureCapacity(Scope<VulkanStorageBuffer>& buffer, VkDeviceSize required, VkDeviceSize minimum, VkBufferUsageFlags extraUsage, bool hostVisible)
+		{
+			if (buffer && buffer->GetSize() >= required)
+				return;
+
+			VkDeviceSize size = buffer ? buffer->GetSize() : minimum;
+			while (size < required)
+				size *= 2;
+			buffer = CreateScope<VulkanStorageBuffer>(size, extraUsage, hostVisible);
+		}
+
+		void RecordBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess, VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess)
+		{
+			VkMemoryBarrier2 barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+			barrier.srcStageMask = srcStage;
+			barrier.srcAccessMask = srcAccess;
+			barrier.dstStageMask = dstStage;
+			barrier.dstAccessMask = dstAccess;
+
+			VkDependencyInfo dependencyInfo{};
+			dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+			dependencyInfo.memoryBarrierCount = 1;
+			dependencyInfo.pMemoryBarriers = &barrier;
+			vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+		}
+
+		// Mirrors InstanceCulling.glsl.
+		bool IsInstanceVisible(const VulkanGpuScene::Instance& instance, const VulkanGpuScene::Planes& planes)
+		{
+			const float localRadius = instance.BoundingSphere.w;
+			if (localRadius <= 1e-6f)
+				return true;
+
+			const glm::vec3 center = glm::vec3(instance.Transform * glm::vec4(glm::vec3(instance.BoundingSphere), 1.0f));
+			const float scale = std::max({
+				glm::length(glm::vec3(instance.Transform[0])),
+				glm::length(glm::vec3(instance.Transform[1])),
+				glm::length(glm::vec3(instance.Transform[2])),
+				1e-4f });
+			const float radius = localRadius * scale;
+			for (const glm::vec4& plane : planes)
+			{
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+					return false;
+			}
+
+			return true;
+		}
+
+	}
+
+	bool VulkanGpuScene::IsSupported()
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		return context != nullptr && context->SupportsIndirectDrawCount();
+	}
+
+	VulkanGpuScene::~VulkanGpuScene()
+	{
+		for (uint32_t binding : { InstanceBinding, MaterialBinding, CommandBinding, CountBinding, OcclusionFlagBinding })
+			VulkanStorageBuffer::Unbind(binding);
+	}
+
+	uint32_t VulkanGpuScene::AddMaterial(const Material& material)
+	{
+		++m_MaterialRevision;
+		if (!m_FreeMaterials.empty())
+		{
+			const uint32_t index = m_FreeMaterials.back();
+			m_FreeMaterials.pop_back();
+			m_Materials[index] = material;
+			return index;
+		}
+
+		m_Materials.push_back(material);
+		return static_cast<uint32_t>(m_Materials.size() - 1);
+	}
+
+	void VulkanGpuScene::UpdateMaterial(uint32_t index, const Material& material)
+	{
+		if (index >= m_Materials.size() || memcmp(&m_Materials[index], &material, sizeof(Material)) == 0)
+			return;
+
+		m_Materials[index] = material;
+		++m_MaterialRevision;
+	}
+
+	void VulkanGpuScene::RemoveMaterial(uint32_t index)
+	{
+		if (index < m_Materials.size())
+			m_FreeMaterials.push_back(index);
+	}
+
+	uint32_t VulkanGpuScene::AddInstance(const Ref<VertexArray>& vertexArray, const glm::mat4& transform, const glm::vec4& boundingSphere, uint32_t materialIndex, int32_t entityID)
+	{
+		if (vertexArray == nullptr || vertexArray->GetVertexBuffers().empty() || !vertexArray->GetIndexBuffer())
+			return InvalidHandle;
+
+		auto vertexBuffer = std::dynamic_pointer_cast<VulkanVertexBuffer>(vertexArray->GetVertexBuffers()[0]);
+		auto indexBuffer = std::dynamic_pointer_cast<VulkanIndexBuffer>(vertexArray->GetIndexBuffer());
+		if (!vertexBuffer || !indexBuffer || indexBuffer->GetCount() == 0)
+			return InvalidHandle;
+
+		const BatchKey key{ vertexBuffer->GetBuffer(), indexBuffer->GetBuffer(), vertexBuffer->GetLayout().GetStride() };
+		if (key.VertexBuffer == VK_NULL_HANDLE || key.IndexBuffer == VK_NULL_HANDLE || key.Stride == 0)
+			return InvalidHandle;
+
+		auto [batchIt, inserted] = m_BatchLookup.try_emplace(key, static_cast<uint32_t>(m_Batches.size()));
+		if (inserted)
+			m_Batches.push_back({ vertexArray, 0, 0 });
+
+		Batch& batch = m_Batches[batchIt->second];
+		++batch.InstanceCount;
+
+		uint32_t handle = static_cast<uint32_t>(m_HandleIndices.size());
+		if (!m_FreeHandles.empty())
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+		else
+		{
+			m_HandleIndices.push_back(InvalidHandle);
+		}
+		m_HandleIndices[handle] = static_cast<uint32_t>(m_Instances.size());
+		m_InstanceHandles.push_back(handle);
+
+		Instance& instance = m_Instances.emplace_back();
+		instance.Transform = transform;
+		instance.BoundingSphere = boundingSphere;
+		instance.FirstIndex = indexBuffer->GetFirstIndex();
+		instance.IndexCount = indexBuffer->GetCount();
+		instance.VertexOffset = vertexBuffer->GetBaseVertex();
+		instance.MaterialIndex = materialIndex;
+		instance.EntityID = entityID;
+		instance.Batch = batchIt->second;
+		++m_LayoutRevision;
+		return handle;
+	}
+
+	void VulkanGpuScene::UpdateInstance(uint32_t handle, const glm::mat4& transform, uint32_t materialIndex)
+	{
+		if (handle >= m_HandleIndices.size() || m_HandleIndices[handle] == InvalidHandle)
+			return;
+
+		Instance& instance = m_Instances[m_HandleIndices[handle]];
+		instance.Transform = transform;
+		instance.MaterialIndex = materialIndex;
+		m_DirtyInstances.push_back(handle);
+	}
+
+	void VulkanGpuScene::RemoveInstance(uint32_t handle)
+	{
+		if (handle >= m_HandleIndices.size() || m_HandleIndices[handle] == InvalidHandle)
+			return;
+
+		const uint32_t index = m_HandleIndices[handle];
+		--m_Batches[m_Instances[index].Batch].InstanceCount;
+		const uint32_t last = static_cast<uint32_t>(m_Instances.size() - 1);
+		if (index != last)
+		{
+			m_Instances[index] = m_Instances[last];
+			m_InstanceHandles[index] = m_InstanceHandles[last];
+			m_HandleIndices[m_InstanceHandles[index]] = index;
+		}
+		m_Instances.pop_back();
+		m_InstanceHandles.pop_back();
+		m_HandleIndices[handle] = InvalidHandle;
+		m_FreeHandles.push_back(handle);
+		++m_LayoutRevision;
+	}
+
+	void VulkanGpuScene::Upload()
+	{
+		SN_PROFILE_SCOPE("VulkanGpuScene::Upload");
+		if (m_BatchRevision != m_LayoutRevision)
+			UpdateBatches();
+
+		m_Stats.Instances = static_cast<uint32_t>(m_Instances.size());
+		m_Stats.Materials = static_cast<uint32_t>(m_Materials.size() - m_FreeMaterials.size());
+		m_Stats.Batches = static_cast<uint32_t>(m_Batches.size());
+		m_Stats.UploadedInstances = 0;
+		m_Stats.UploadedMaterials = 0;
+
+		FrameResources* frame = GetFrameResources();
+		// Every frame's buffers miss the updates made since they were last written.
+		if (!m_DirtyInstances.empty())
+		{
+			for (FrameResources& resources : m_Frames)
+			{
+				if (resources.LayoutRevision == m_LayoutRevision)
+					resources.DirtyInstances.insert(resources.DirtyInstances.end(), m_DirtyInstances.begin(), m_DirtyInstances.end());
+			}
+			m_DirtyInstances.clear();
+		}
+		if (frame == nullptr)
+			return;
+
+		// This slot's previous frame has retired, so its readback holds that frame's counts.
+		ReadBackRetiredFrame(*frame);
+		frame->Culled.fill(false);
+		frame->OcclusionCulled = false;
+		frame->ExpectedVisible.fill(UINT32_MAX);
+		m_Uploaded = false;
+		if (m_Instances.empty())
+			return;
+
+		const VkDeviceSize commandBytes = m_Instances.size() * sizeof(VkDrawIndexedIndirectCommand);
+		const VkDeviceSize countBytes = (m_Batches.size() + kOcclusionCountSlots) * sizeof(uint32_t);
+		for (size_t pass = 0; pass < static_cast<size_t>(Pass::Count); ++pass)
+		{
+			EnsureCapacity(frame->Commands[pass], commandBytes, kMinInstanceCapacity * sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, false);
+			EnsureCapacity(
+				frame->Counts[pass],
+				countBytes,
+				kMinBatchCapacity * sizeof(uint32_t),
+				VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				false);
+		}
+		EnsureCapacity(frame->Readback, countBytes * static_cast<size_t>(Pass::Count), kMinBatchCapacity * sizeof(uint32_t) * static_cast<size_t>(Pass::Count), VK_BUFFER_USAGE_TRANSFER_DST_BIT, true);
+		EnsureCapacity(m_OcclusionFlags, m_Instances.size() * sizeof(uint32_t), kMinInstanceCapacity * sizeof(uint32_t), 0, false);
+
+		UploadInstances(*frame);
+		UploadMaterials(*frame);
+
+		frame->BatchCount = static_cast<uint32_t>(m_Batches.size());
+		m_Uploaded = true;
+	}
+
+	void VulkanGpuScene::UpdateBatches()
+	{
+		// Empty batches would keep their geometry alive and still cost a draw.
+		std::vector<uint32_t> remap(m_Batches.size(), InvalidHandle);
+		uint32_t kept = 0;
+		for (uint32_t batch = 0; batch < m_Batches.size(); ++batch)
+		{
+			if (m_Batches[batch].InstanceCount == 0)
+				continue;
+			if (kept != batch)
+				m_Batches[kept] = std::move(m_Batches[batch]);
+			remap[batch] = kept++;
+		}
+		if (kept != m_Batches.size())
+		{
+			m_Batches.resize(kept);
+			for (auto it = m_BatchLookup.begin(); it != m_BatchLookup.end();)
+			{
+				if (remap[it->second] == InvalidHandle)
+				{
+					it = m_BatchLookup.erase(it);
+					continue;
+				}
+				it->second = remap[it->second];
+				++it;
+			}
+			for (Instance& instance : m_Instances)
+				instance.Batch = remap[instance.Batch];
+		}
+
+		// Each batch owns a contiguous command range with room for all of its instances.
+		uint32_t firstCommand = 0;
+		for (Batch& batch : m_Batches)
+		{
+			batch.FirstCommand = firstCommand;
+			firstCommand += batch.InstanceCount;
+		}
+		for (Instance& instance : m_Instances)
+			instance.FirstCommand = m_Batches[instance.Batch].FirstCommand;
+		m_BatchRevision = m_LayoutRevision;
+	}
+
+	void VulkanGpuScene::UploadInstances(FrameResources& frame)
+	{
+		const VkDeviceSize instanceBytes = m_Instances.size() * sizeof(Instance);
+		const VulkanStorageBuffer* previous = frame.Instances.get();
+		EnsureCapacity(frame.Instances, instanceBytes, kMinInstanceCapacity * sizeof(Instance), 0, true);
+
+		// A few updates are copied one by one, anything close to the whole scene in one go.
+		const bool full = frame.Instances.get() != previous
+			|| frame.LayoutRevision != m_LayoutRevision
+			|| frame.DirtyInstances.size() * 2 >= m_Instances.size();
+		uint8_t* mapped = static_cast<uint8_t*>(frame.Instances->GetMappedData());
+		if (full)
+		{
+			memcpy(mapped, m_Instances.data(), instanceBytes);
+			frame.Instances->FlushMappedRange(0, instanceBytes);
+			m_Stats.UploadedInstances = static_cast<uint32_t>(m_Instances.size());
+		}
+		else if (!frame.DirtyInstances.empty())
+		{
+			uint32_t first = UINT32_MAX;
+			uint32_t last = 0;
+			for (uint32_t handle : frame.DirtyInstances)
+			{
+				const uint32_t index = m_HandleIndices[handle];
+				if (index == InvalidHandle)
+					continue;
+
+				memcpy(mapped + index * sizeof(Instance), &m_Instances[index], sizeof(Instance));
+				first = std::min(first, index);
+				last = std::max(last, index);
+				++m_Stats.UploadedInstances;
+			}
+			if (first <= last)
+				frame.Instances->FlushMappedRange(first * sizeof(Instance), (last - first + 1) * sizeof(Instance));
+		}
+
+		frame.LayoutRevision = m_LayoutRevision;
+		frame.DirtyInstances.clear();
+	}
+
+	void VulkanGpuScene::UploadMaterials(FrameResources& frame)
+	{
+		// Instances always index a material; an empty scene still gets one to read.
+		const VkDeviceSize materialBytes = std::max<size_t>(m_Materials.size(), 1) * sizeof(Material);
+		const VulkanStorageBuffer* previous = frame.Materials.get();
+		EnsureCapacity(frame.Materials, materialBytes, kMinMaterialCapacity * sizeof(Material), 0, true);
+		if (frame.Materials.get() == previous && frame.MaterialRevision == m_MaterialRevision)
+			return;
+
+		if (m_Materials.empty())
+		{
+			const Material fallback{};
+			memcpy(frame.Materials->GetMappedData(), &fallback, sizeof(Material));
+		}
+		else
+		{
+			memcpy(frame.Materials->GetMappedData(), m_Materials.data(), materialBytes);
+		}
+		frame.Materials->FlushMappedRange(0, materialBytes);
+		frame.MaterialRevision = m_MaterialRevision;
+		m_Stats.UploadedMaterials = static_cast<uint32_t>(m_Materials.size());
+	}
+
+	void VulkanGpuScene::Cull(Pass pass, const Ref<Shader>& cullShader, const Planes& planes, bool frustumCulling, bool occlusionCulling)
+	{
+		SN_PROFILE_SCOPE("VulkanGpuScene::Cull");
+		VulkanContext* context = VulkanContext::GetCurrent();
+		VulkanRendererAPI* api = VulkanRendererAPI::GetCurrent();
+		FrameResources* frame = GetFrameResources();
+		if (!m_Uploaded || cullShader == nullptr || context == nullptr || api == nullptr || frame == nullptr)
+			return;
+
+		const VkCommandBuffer commandBuffer = context->GetActiveFrameCommandBuffer();
+		if (commandBuffer == VK_NULL_HANDLE)
+			return;
+
+		// The fill and copies below are recorded directly, so earlier draws have to be recorded first.
+		api->Flush();
+
+		CullPhase phase = CullPhaseFrustum;
+		if (pass == Pass::GeometryLate)
+			phase = CullPhaseLate;
+		else if (pass == Pass::Geometry && occlusionCulling)
+			phase = CullPhaseEarly;
+		if (phase == CullPhaseLate && !frame->OcclusionCulled)
+			return;
+
+		const size_t passIndex = static_cast<size_t>(pass);
+		const VulkanStorageBuffer& counts = *frame->Counts[passIndex];
+		const VkDeviceSize countBytes = (frame->BatchCount + kOcclusionCountSlots) * sizeof(uint32_t);
+		// The previous pass may still be reading the counts as indirect parameters.
+		RecordBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+			VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+			VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+			VK_ACCESS_2_TRANSFER_WRITE_BIT);
+		vkCmdFillBuffer(commandBuffer, counts.GetBuffer(), 0, countBytes, 0);
+		RecordBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+			VK_ACCESS_2_TRANSFER_WRITE_BIT,
+			VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+			VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+
+		frame->Instances->Bind(InstanceBinding);
+		frame->Materials->Bind(MaterialBinding);
+		frame->Commands[passIndex]->Bind(CommandBinding);
+		frame->Counts[passIndex]->Bind(CountBinding);
+		m_OcclusionFlags->Bind(OcclusionFlagBinding);
+		m_HiZ.Bind();
+
+		const uint32_t instanceCount = static_cast<uint32_t>(m_Instances.size());
+		cullShader->Bind();
+		for (uint32_t i = 0; i < planes.size(); ++i)
+			cullShader->SetFloat4("push.plane" + std::to_string(i), planes[i]);
+		cullShader->SetInt("push.instanceCount", static_cast<int>(instanceCount));
+		cullShader->SetInt("push.frustumCulling", frustumCulling ? 1 : 0);
+		cullShader->SetInt("push.phase", static_cast<int>(phase));
+		cullShader->SetInt("push.batchCount", static_cast<int>(frame->BatchCount));
+		cullShader->DispatchCompute((instanceCount + kCullWorkgroupSize - 1) / kCullWorkgroupSize, 1, 1);
+		cullShader->Unbind();
+
+		frame->Culled[passIndex] = true;
+		frame->OcclusionCulled |= phase == CullPhaseEarly;
+
+		// The counts are read back for the occlusion stats and validation. The dispatch barrier
+		// already covers transfer reads of them.
+		VkBufferCopy copy{};
+		copy.srcOffset = 0;
+		copy.dstOffset = passIndex * countBytes;
+		copy.size = countBytes;
+		vkCmdCopyBuffer(commandBuffer, counts.GetBuffer(), frame->Readback->GetBuffer(), 1, &copy);
+		RecordBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+			VK_ACCESS_2_TRANSFER_WRITE_BIT,
+			VK_PIPELINE_STAGE_2_HOST_BIT,
+			VK_ACCESS_2_HOST_READ_BIT);
+		// The CPU cannot tell occlusion, but the early phase still has to account for every
+		// frustum survivor, drawn or flagged; late phase counts are not validated.
+		if (m_Validate && phase != CullPhaseLate)
+			frame->ExpectedVisible[passIndex] = CountVisibleOnCpu(planes, frustumCulling);
+	}
+
+	void VulkanGpuScene::Draw(Pass pass)
+	{
+		SN_PROFILE_SCOPE("VulkanGpuScene::Draw");
+		VulkanRendererAPI* api = VulkanRendererAPI::GetCurrent();
+		FrameResources* frame = GetFrameResources();
+		const size_t passIndex = static_cast<size_t>(pass);
+		if (api == nullptr || frame == nullptr || !frame->Culled[passIndex])
+			return;
+
+		frame->Instances->Bind(InstanceBinding);
+		frame->Materials->Bind(MaterialBinding);
+
+		const VkBuffer commands = frame->Commands[passIndex]->GetBuffer();
+		const VkBuffer counts = frame->Counts[passIndex]->GetBuffer();
+		for (uint32_t batchIndex = 0; batchIndex < m_Batches.size(); ++batchIndex)
+		{
+			const Batch& batch = m_Batches[batchIndex];
+			api->DrawIndexedIndirectCount(
+				batch.Geometry,
+				commands,
+				batch.FirstCommand * sizeof(VkDrawIndexedIndirectCommand),
+				counts,
+				batchIndex * sizeof(uint32_t),
+				batch.InstanceCount);
+		}
+	}
+
+	VulkanGpuScene::FrameResources* VulkanGpuScene::GetFrameResources()
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr)
+			return nullptr;
+
+		const uint32_t framesInFlight = context->GetFramesInFlight();
+		const uint32_t frameIndex = context->GetCurrentFrameIndex();
+		if (frameIndex >= framesInFlight)
+			return nullptr;
+		if (m_Frames.size() < framesInFlight)
+			m_Frames.resize(framesInFlight);
+
+		return &m_Frames[frameIndex];
+	}
+
+	void VulkanGpuScene::ReadBackRetiredFrame(FrameResources& frame)
+	{
+		if (!frame.Readback || frame.BatchCount == 0)
+			return;
+
+		const uint32_t stride = frame.BatchCount + kOcclusionCountSlots;
+		frame.Readback->InvalidateMappedRange(0, stride * sizeof(uint32_t) * static_cast<size_t>(Pass::Count));
+		const uint32_t* readback = static_cast<const uint32_t*>(frame.Readback->GetMappedData());
+		const auto sumBatches = [&frame, readback, stride](Pass pass)
+		{
+			uint32_t total = 0;
+			for (uint32_t batch = 0; batch < frame.BatchCount; ++batch)
+				total += readback[static_cast<size_t>(pass) * stride + batch];
+			return total;
+		};
+
+		if (frame.OcclusionCulled)
+		{
+			const uint32_t* early = readback + static_cast<size_t>(Pass::Geometry) * stride + frame.BatchCount;
+			const uint32_t* late = readback + static_cast<size_t>(Pass::GeometryLate) * stride + frame.BatchCount;
+			const bool lateCulled = frame.Culled[static_cast<size_t>(Pass::GeometryLate)];
+			m_Stats.EarlyOccluded = early[0];
+			m_Stats.LateVisible = lateCulled ? sumBatches(Pass::GeometryLate) : 0;
+			m_Stats.Occluded = lateCulled ? late[0] : early[0];
+			m_Stats.OccludedTriangles = lateCulled ? late[1] : early[1];
+		}
+
+		bool validated = false;
+		bool mismatched = false;
+		for (size_t pass = 0; pass < static_cast<size_t>(Pass::Count); ++pass)
+		{
+			if (!frame.Culled[pass] || frame.ExpectedVisible[pass] == UINT32_MAX)
+				continue;
+
+			// Instances the early phase hid are still frustum survivors.
+			uint32_t gpuVisible = sumBatches(static_cast<Pass>(pass));
+			if (frame.OcclusionCulled && pass == static_cast<size_t>(Pass::Geometry))
+				gpuVisible += readback[pass * stride + frame.BatchCount];
+
+			m_Stats.GpuVisible[pass] = gpuVisible;
+			m_Stats.CpuVisible[pass] = frame.ExpectedVisible[pass];
+			mismatched |= gpuVisible != frame.ExpectedVisible[pass];
+			validated = true;
+		}
+
+		if (validated)
+		{
+			++m_Stats.ValidatedFrames;
+			if (mismatched)
+			{
+				++m_Stats.MismatchedFrames;
+				SN_CORE_WARN(
+					"GPU culling kept {}/{} instances (shadow/geometry), the CPU reference {}/{}.",
+					m_Stats.GpuVisible[0], m_Stats.GpuVisible[1], m_Stats.CpuVisible[0], m_Stats.CpuVisible[1]);
+			}
+		}
+
+	}
+
+	uint32_t VulkanGpuScene::CountVisibleOnCpu(const Planes& planes, bool frustumCulling) const
+	{
+		if (!frustumCulling)
+			return static_cast<uint32_t>(m_Instances.size());
+
+		return static_cast<uint32_t>(std::count_if(m_Instances.begin(), m_Instances.end(), [&planes](const Instance& instance)
+		{
+			return IsInstanceVisible(instance, planes);
+		}));
+	}
+
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+#include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/VertexArray.h"
+#include "Platform/Vulkan/VulkanHiZPyramid.h"
+#include "Platform/Vulkan/VulkanStorageBuffer.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Syndra {
+
+	// Scene instances for GPU-driven rendering. The renderer keeps one instance per mesh (world matrix,
+	// local bounding sphere, pool index range and material) for as long as the mesh is drawn and only
+	// updates the ones that changed; Upload() writes just those into the frame's buffers. A compute pass
+	// culls the instances against a frustum and appends the survivors to per-batch indirect command
+	// ranges, and every batch of meshes sharing the same pool buffers is drawn with one
+	// vkCmdDrawIndexedIndirectCount, so the recording cost no longer grows with the instance count.
+	//
+	// Shaders read the instances at storage binding InstanceBinding (gl_InstanceIndex is the instance
+	// index) and materials at MaterialBinding. With validation enabled the survivors are also counted
+	// on the CPU with the same math and compared with the GPU counts once the frame has retired.
+	//
+	// The geometry pass can also cull by occlusion in two phases: Geometry tests the frustum survivors
+	// against the Hi-Z pyramid (GetHiZ(), built from the previous frame's depth) and remembers the
+	// instances it hides, and GeometryLate re-tests only those against the pyramid rebuilt from the
+	// early phase's depth, drawing the ones that turned out to be visible.
+	class VulkanGpuScene
+	{
+	public:
+		enum class Pass : uint32_t
+		{
+			Shadow = 0,
+			Geometry,
+			GeometryLate,
+			Count
+		};
+
+		static constexpr uint32_t InstanceBinding = 10;
+		static constexpr uint32_t MaterialBinding = 11;
+		static constexpr uint32_t CommandBinding = 12;
+		static constexpr uint32_t CountBinding = 13;
+		static constexpr uint32_t OcclusionFlagBinding = 15;
+		static constexpr uint32_t InvalidHandle = UINT32_MAX;
+
+		// std430 layouts shared with the shaders.
+		struct Instance
+		{
+			glm::mat4 Transform = glm::mat4(1.0f);
+			glm::vec4 BoundingSphere = glm::vec4(0.0f);	// local center and radius; 0 radius is never culled
+			uint32_t FirstIndex = 0;
+			uint32_t IndexCount = 0;
+			int32_t VertexOffset = 0;
+			uint32_t MaterialIndex = 0;
+			int32_t EntityID = -1;
+			uint32_t Batch = 0;
+			uint32_t FirstCommand = 0;
+			uint32_t Padding = 0;
+		};
+
+		struct Material
+		{
+			glm::vec4 Color = glm::vec4(0.8f, 0.8f, 0.8f, 1.0f);
+			float Roughness = 0.6f;
+			float Metallic = 0.0f;
+			float AO = 1.0f;
+			float Tiling = 1.0f;
+			// Bindless table indices, -1 when the map is unused.
+			int32_t AlbedoMapIndex = -1;
+			int32_t MetallicMapIndex = -1;
+			int32_t NormalMapIndex = -1;
+			int32_t RoughnessMapIndex = -1;
+			int32_t AOMapIndex = -1;
+			int32_t Padding[3] = {};
+		};
+
+		struct Stats
+		{
+			uint32_t Instances = 0;
+			uint32_t Materials = 0;
+			uint32_t Batches = 0;
+			// Instances and materials the last Upload() wrote into its frame's buffers.
+			uint32_t UploadedInstances = 0;
+			uint32_t UploadedMaterials = 0;
+			// Survivors of each pass in the last validated frame.
+			std::array<uint32_t, static_cast<size_t>(Pass::Count)> GpuVisible{};
+			std::array<uint32_t, static_cast<size_t>(Pass::Count)> CpuVisible{};
+			uint32_t ValidatedFrames = 0;
+			uint32_t MismatchedFrames = 0;
+			// Occlusion results of the last retired frame that culled by occlusion.
+			uint32_t EarlyOccluded = 0;
+			uint32_t LateVisible = 0;
+			uint32_t Occluded = 0;
+			uint64_t OccludedTriangles = 0;
+		};
+
+		// Frustum planes as (normal, distance), a point p is inside when dot(normal, p) + distance >= 0.
+		using Planes = std::array<glm::vec4, 6>;
+
+		// True when the device can draw with indirect counts (see VulkanContext::CreateLogicalDevice).
+		static bool IsSupported();
+
+		~VulkanGpuScene();
+
+		// Materials are referenced by index and keep it until removed; freed indices are reused.
+		uint32_t AddMaterial(const Material& material);
+		void UpdateMaterial(uint32_t index, const Material& material);
+		void RemoveMaterial(uint32_t index);
+		// Adds vertexArray's pool range as an instance and returns its handle, or InvalidHandle when
+		// it has no pool range yet. Handles stay valid until the instance is removed.
+		uint32_t AddInstance(const Ref<VertexArray>& vertexArray, const glm::mat4& transform, const glm::vec4& boundingSphere, uint32_t materialIndex, int32_t entityID);
+		void UpdateInstance(uint32_t handle, const glm::mat4& transform, uint32_t materialIndex);
+		void RemoveInstance(uint32_t handle);
+		// Brings this frame's buffers up to date: everything after instances were added or removed or
+		// the buffers grew, otherwise only the instances and materials changed since they were last
+		// written. Call once a frame, after the last change and before Cull().
+		void Upload();
+
+		// Records the culling dispatch of pass. Must run outside the pass's rendering, before Draw().
+		// occlusionCulling makes Geometry the early phase; GeometryLate always is the late phase and
+		// needs the pyramid rebuilt after the early phase was drawn.
+		void Cull(Pass pass, const Ref<Shader>& cullShader, const Planes& planes, bool frustumCulling, bool occlusionCulling = false);
+		// Draws the survivors of pass with the bound shader and framebuffer.
+		void Draw(Pass pass);
+
+		void SetValidation(bool enabled) { m_Validate = enabled; }
+		bool IsValidationEnabled() const { return m_Validate; }
+		const Stats& GetStats() const { return m_Stats; }
+		VulkanHiZPyramid& GetHiZ() { return m_HiZ; }
+
+	private:
+		struct Batch
+		{
+			// Any mesh of the batch; its pool buffers and layout are what the draws bind.
+			Ref<VertexArray> Geometry;
+			uint32_t InstanceCount = 0;
+			uint32_t FirstCommand = 0;
+		};
+
+		struct BatchKey
+		{
+			VkBuffer VertexBuffer = VK_NULL_HANDLE;
+			VkBuffer IndexBuffer = VK_NULL_HANDLE;
+			uint32_t Stride = 0;
+
+			bool operator==(const BatchKey& other) const
+			{
+				return VertexBuffer == other.VertexBuffer && IndexBuffer == other.IndexBuffer && Stride == other.Stride;
+			}
+		};
+
+		struct BatchKeyHasher
+		{
+			size_t operator()(const BatchKey& key) const
+			{
+				size_t hash = std::hash<VkBuffer>{}(key.VertexBuffer);
+				hash ^= std::hash<VkBuffer>{}(key.IndexBuffer) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				hash ^= std::hash<uint32_t>{}(key.Stride) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				return hash;
+			}
+		};
+
+		// Buffers of one frame in flight. The CPU writes instances and materials while earlier frames
+		// still read theirs; the readback holds the counts of every pass for validation. The revisions
+		// are those of the layout and materials the buffers hold, and DirtyInstances the handles
+		// updated since.
+		struct FrameResources
+		{
+			Scope<VulkanStorageBuffer> Instances;
+			Scope<VulkanStorageBuffer> Materials;
+			std::array<Scope<VulkanStorageBuffer>, static_cast<size_t>(Pass::Count)> Commands;
+			std::array<Scope<VulkanStorageBuffer>, static_cast<size_t>(Pass::Count)> Counts;
+			Scope<VulkanStorageBuffer> Readback;
+			uint32_t BatchCount = 0;
+			std::array<bool, static_cast<size_t>(Pass::Count)> Culled{};
+			bool OcclusionCulled = false;
+			// CPU reference counts, UINT32_MAX for passes that were not validated.
+			std::array<uint32_t, static_cast<size_t>(Pass::Count)> ExpectedVisible{};
+			uint64_t LayoutRevision = 0;
+			uint64_t MaterialRevision = 0;
+			std::vector<uint32_t> DirtyInstances;
+		};
+
+		FrameResources* GetFrameResources();
+		// Drops empty batches and lays out the command range of every batch after the layout changed.
+		void UpdateBatches();
+		// Writes the instances and materials 'frame' is missing into its buffers.
+		void UploadInstances(FrameResources& frame);
+		void UploadMaterials(FrameResources& frame);
+		// Reads the counts of the frame that last used this slot, validating them when requested.
+		void ReadBackRetiredFrame(FrameResources& frame);
+		uint32_t CountVisibleOnCpu(const Planes& planes, bool frustumCulling) const;
+
+	private:
+		// Packed, as the shaders index them; a removal moves the last instance into the hole.
+		std::vector<Instance> m_Instances;
+		std::vector<uint32_t> m_InstanceHandles;
+		// Packed index of every handle, InvalidHandle for free handles.
+		std::vector<uint32_t> m_HandleIndices;
+		std::vector<uint32_t> m_FreeHandles;
+		std::vector<uint32_t> m_DirtyInstances;
+		std::vector<Material> m_Materials;
+		std::vector<uint32_t> m_FreeMaterials;
+		std::vector<Batch> m_Batches;
+		std::unordered_map<BatchKey, uint32_t, BatchKeyHasher> m_BatchLookup;
+		std::vector<FrameResources> m_Frames;
+		// Bumped when instances are added or removed, which moves instances and command ranges.
+		uint64_t m_LayoutRevision = 1;
+		uint64_t m_BatchRevision = 0;
+		uint64_t m_MaterialRevision = 1;
+		// Only the GPU touches these, in submission order, so every frame in flight shares them.
+		Scope<VulkanStorageBuffer> m_OcclusionFlags;
+		VulkanHiZPyramid m_HiZ;
+		bool m_Uploaded = false;
+		bool m_Validate = false;
+		Stats m_Stats;
+	};
+
+}
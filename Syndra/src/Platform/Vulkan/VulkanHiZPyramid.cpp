@@ -0,0 +1,97 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanHiZPyramid.h"
+
+#include "Engine/Core/Instrument.h"
+#include "Engine/Renderer/Texture.h"
+
+#include <algorithm>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr uint32_t kBuildWorkgroupSize = 8;
+
+	}
+
+	VulkanHiZPyramid::VulkanHiZPyramid()
+	{
+		m_UniformBuffer = UniformBuffer::Create(sizeof(Uniforms), UniformBinding);
+	}
+
+	VulkanHiZPyramid::~VulkanHiZPyramid()
+	{
+		VulkanStorageBuffer::Unbind(StorageBinding);
+	}
+
+	void VulkanHiZPyramid::Build(const Ref<Shader>& buildShader, uint32_t depthRendererID, uint32_t width, uint32_t height, const glm::mat4& viewProjection)
+	{
+		SN_PROFILE_SCOPE("VulkanHiZPyramid::Build");
+		if (buildShader == nullptr || depthRendererID == 0 || width == 0 || height == 0)
+		{
+			Invalidate();
+			return;
+		}
+
+		Uniforms uniforms;
+		uniforms.ViewProjection = viewProjection;
+		uint32_t levelWidth = width;
+		uint32_t levelHeight = height;
+		uint32_t texelCount = 0;
+		uint32_t levelCount = 0;
+		do
+		{
+			levelWidth = (levelWidth + 1) / 2;
+			levelHeight = (levelHeight + 1) / 2;
+			uniforms.Levels[levelCount] = glm::ivec4(levelWidth, levelHeight, texelCount, 0);
+			texelCount += levelWidth * levelHeight;
+			++levelCount;
+		} while ((levelWidth > 1 || levelHeight > 1) && levelCount < MaxLevels);
+		uniforms.Size = glm::ivec4(width, height, levelCount, 1);
+
+		const VkDeviceSize requiredBytes = static_cast<VkDeviceSize>(texelCount) * sizeof(float);
+		if (!m_Buffer || m_Buffer->GetSize() < requiredBytes)
+			m_Buffer = CreateScope<VulkanStorageBuffer>(requiredBytes, 0, false);
+		m_Buffer->Bind(StorageBinding);
+
+		// Level 0 reads the attachment, every other level the one before it.
+		Texture2D::BindTexture(depthRendererID, 0);
+		buildShader->Bind();
+		for (uint32_t level = 0; level < levelCount; ++level)
+		{
+			const glm::ivec4 source = (level == 0)
+				? glm::ivec4(width, height, -1, 0)
+				: uniforms.Levels[level - 1];
+			const glm::ivec4& target = uniforms.Levels[level];
+			buildShader->SetInt("push.sourceWidth", source.x);
+			buildShader->SetInt("push.sourceHeight", source.y);
+			buildShader->SetInt("push.sourceOffset", source.z);
+			buildShader->SetInt("push.width", target.x);
+			buildShader->SetInt("push.height", target.y);
+			buildShader->SetInt("push.offset", target.z);
+			buildShader->DispatchCompute(
+				(static_cast<uint32_t>(target.x) + kBuildWorkgroupSize - 1) / kBuildWorkgroupSize,
+				(static_cast<uint32_t>(target.y) + kBuildWorkgroupSize - 1) / kBuildWorkgroupSize,
+				1);
+		}
+		buildShader->Unbind();
+
+		m_Uniforms = uniforms;
+	}
+
+	void VulkanHiZPyramid::Invalidate()
+	{
+		m_Uniforms.Size = glm::ivec4(0);
+	}
+
+	void VulkanHiZPyramid::Bind()
+	{
+		// Culling shaders declare the pyramid even when they do not test against it.
+		if (!m_Buffer)
+			m_Buffer = CreateScope<VulkanStorageBuffer>(sizeof(float), 0, false);
+		m_Buffer->Bind(StorageBinding);
+		m_UniformBuffer->SetData(&m_Uniforms, sizeof(Uniforms));
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+#include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/UniformBuffer.h"
+#include "Platform/Vulkan/VulkanStorageBuffer.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace Syndra {
+
+	// Hierarchical-Z pyramid of a depth attachment. Level 0 is half the attachment's resolution and
+	// every level keeps the farthest depth of the 2x2 texels above it, so one texel bounds the depth
+	// of everything rendered into the pixels it covers. The levels are packed into one storage buffer
+	// that compute shaders read at StorageBinding; the Occlusion uniform block at UniformBinding
+	// describes the layout and the view-projection the depth was rendered with.
+	class VulkanHiZPyramid
+	{
+	public:
+		static constexpr uint32_t StorageBinding = 14;
+		static constexpr uint32_t UniformBinding = 9;
+		static constexpr uint32_t MaxLevels = 16;
+
+		// std140 layout of the Occlusion uniform block.
+		struct Uniforms
+		{
+			glm::mat4 ViewProjection = glm::mat4(1.0f);	// Vulkan clip space
+			glm::ivec4 Size = glm::ivec4(0);			// attachment width, height, level count, valid
+			glm::ivec4 Levels[MaxLevels] = {};			// width, height, first texel
+		};
+
+		VulkanHiZPyramid();
+		~VulkanHiZPyramid();
+
+		// Records one compute dispatch per level, downsampling the depth attachment depthRendererID
+		// (width x height, rendered with viewProjection). Must run outside rendering.
+		void Build(const Ref<Shader>& buildShader, uint32_t depthRendererID, uint32_t width, uint32_t height, const glm::mat4& viewProjection);
+		// Drops the pyramid, e.g. when the attachment is recreated; tests pass until the next Build.
+		void Invalidate();
+		// Binds the pyramid and its uniforms for a culling dispatch, valid or not.
+		void Bind();
+
+		bool IsValid() const { return m_Uniforms.Size.w != 0; }
+		uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_Uniforms.Size.z); }
+		VkDeviceSize GetSize() const { return m_Buffer ? m_Buffer->GetSize() : 0; }
+
+	private:
+		Scope<VulkanStorageBuffer> m_Buffer;
+		Ref<UniformBuffer> m_UniformBuffer;
+		Uniforms m_Uniforms;
+	};
+
+}
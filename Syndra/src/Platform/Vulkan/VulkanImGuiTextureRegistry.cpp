@@ -2,6 +2,8 @@
 
 #include "Platform/Vulkan/VulkanImGuiTextureRegistry.h"
 
+#include "Platform/Vulkan/VulkanDrawPacket.h"
+
 #include <unordered_map>
 
 namespace {
@@ -24,6 +26,9 @@ namespace Syndra {
 			return;
 
 		GetRegistry()[rendererID] = VulkanImGuiTextureInfo{ sampler, imageView, imageLayout };
+		// Draw packets hold descriptor sets written with the previous view. Layout updates are left
+		// out on purpose: attachments flip layouts every pass and settle back before they are sampled.
+		VulkanDrawPacket::InvalidateAll();
 	}
 
 	void VulkanImGuiTextureRegistry::UpdateTextureLayout(uint32_t rendererID, VkImageLayout imageLayout)
@@ -44,7 +49,8 @@ namespace Syndra {
 		if (rendererID == 0)
 			return;
 
-		GetRegistry().erase(rendererID);
+		if (GetRegistry().erase(rendererID) > 0)
+			VulkanDrawPacket::InvalidateAll();
 	}
 
 	bool VulkanImGuiTextureRegistry::ContainsTexture(uint32_t rendererID)
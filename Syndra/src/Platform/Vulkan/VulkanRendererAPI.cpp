@@ -3,15 +3,20 @@
 #include "Platform/Vulkan/VulkanRendererAPI.h"
 
 #include "Engine/Core/Instrument.h"
+#include "Engine/Core/JobSystem.h"
+#include "Platform/Vulkan/VulkanBindlessTextureTable.h"
 #include "Platform/Vulkan/VulkanBuffer.h"
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanFrameBuffer.h"
 #include "Platform/Vulkan/VulkanImGuiTextureRegistry.h"
 #include "Platform/Vulkan/VulkanShader.h"
+#include "Platform/Vulkan/VulkanStorageBuffer.h"
 #include "Platform/Vulkan/VulkanTexture.h"
 #include "Platform/Vulkan/VulkanUniformBuffer.h"
 #include "Platform/Vulkan/VulkanVertexArray.h"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
 
 namespace Syndra {
@@ -24,6 +29,98 @@ namespace Syndra {
 		constexpr uint32_t kDescriptorPoolMinTypeCount = 128;
 		constexpr uint32_t kDescriptorPoolFrameMinSets = 4096;
 		constexpr uint32_t kDescriptorPoolFrameMinTypeCount = 4096;
+		// Smaller batches are cheaper to record inline than to hand out to workers.
+		constexpr uint32_t kParallelRecordingMinDraws = 128;
+		constexpr uint32_t kParallelRecordingMinChunkDraws = 64;
+		// Draw packet sets live until the packet is rebuilt, so their pools are sized for many of them.
+		constexpr uint32_t kPacketDescriptorPoolSets = 1024;
+		constexpr uint32_t kPacketDescriptorPoolTypeCount = 4096;
+
+		struct RecordingSettings
+		{
+			bool ParallelRecording = true;
+			uint64_t FrameSerial = std::numeric_limits<uint64_t>::max();
+			VulkanRendererAPI::RecordingStats Current;
+			VulkanRendererAPI::RecordingStats Last;
+		};
+
+		RecordingSettings& GetRecordingSettings()
+		{
+			static RecordingSettings settings;
+			return settings;
+		}
+
+		VulkanRendererAPI::RecordingStats& GetCurrentRecordingStats(uint64_t frameSerial)
+		{
+			RecordingSettings& settings = GetRecordingSettings();
+			if (settings.FrameSerial != frameSerial)
+			{
+				settings.Last = settings.Current;
+				settings.Current = {};
+				settings.FrameSerial = frameSerial;
+			}
+
+			return settings.Current;
+		}
+
+		// Allocates the sets of every layout of shader except the shared bindless texture set, which
+		// is put in its place in outSets (a frame list for transient sets, a heap one for packets).
+		template<typename DescriptorSetContainer>
+		bool AllocateShaderDescriptorSets(
+			VkDevice device,
+			VkDescriptorPool pool,
+			const VulkanShader* shader,
+			DescriptorSetContainer& outSets,
+			uint32_t& outAllocatedSets)
+		{
+			const auto& descriptorSetLayouts = shader->GetDescriptorSetLayouts();
+			const uint32_t bindlessSet = shader->GetBindlessTextureSet();
+			const uint32_t setCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+
+			FrameVector<VkDescriptorSetLayout> ownedLayouts;
+			ownedLayouts.reserve(setCount);
+			for (uint32_t set = 0; set < setCount; ++set)
+			{
+				if (set != bindlessSet)
+					ownedLayouts.push_back(descriptorSetLayouts[set]);
+			}
+
+			FrameVector<VkDescriptorSet> ownedSets(ownedLayouts.size(), VK_NULL_HANDLE);
+			if (!ownedLayouts.empty())
+			{
+				VkDescriptorSetAllocateInfo allocInfo{};
+				allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+				allocInfo.descriptorPool = pool;
+				allocInfo.descriptorSetCount = static_cast<uint32_t>(ownedLayouts.size());
+				allocInfo.pSetLayouts = ownedLayouts.data();
+				if (vkAllocateDescriptorSets(device, &allocInfo, ownedSets.data()) != VK_SUCCESS)
+					return false;
+			}
+
+			outSets.resize(setCount, VK_NULL_HANDLE);
+			for (uint32_t set = 0, owned = 0; set < setCount; ++set)
+				outSets[set] = (set == bindlessSet) ? VulkanBindlessTextureTable::GetDescriptorSet() : ownedSets[owned++];
+			outAllocatedSets = static_cast<uint32_t>(ownedSets.size());
+			return true;
+		}
+
+		// Replaces the texture slots of a bindless shader's push constants with table indices of the
+		// textures bound to those slots; -1 tells the shader the slot is empty.
+		void PatchBindlessTextureIndices(const VulkanShader* shader, uint8_t* pushConstantData, uint32_t pushConstantSize)
+		{
+			const auto& indexOffsets = shader->GetBindlessTextureIndexOffsets();
+			for (uint32_t slot = 0; slot < indexOffsets.size(); ++slot)
+			{
+				if (indexOffsets[slot] + sizeof(int32_t) > pushConstantSize)
+					continue;
+
+				const uint32_t rendererID = VulkanTexture2D::GetBoundTexture(slot);
+				const int32_t index = (rendererID != 0)
+					? VulkanBindlessTextureTable::GetIndex(rendererID)
+					: VulkanBindlessTextureTable::InvalidIndex;
+				memcpy(pushConstantData + indexOffsets[slot], &index, sizeof(index));
+			}
+		}
 
 		struct PipelineKey
 		{
@@ -86,6 +183,45 @@ namespace Syndra {
 			pipelineCache.clear();
 		}
 
+		std::unordered_map<const VulkanShader*, VkPipeline>& GetComputePipelineCache()
+		{
+			static std::unordered_map<const VulkanShader*, VkPipeline> cache;
+			return cache;
+		}
+
+		void DestroyCachedComputePipelines(VkDevice device)
+		{
+			auto& pipelineCache = GetComputePipelineCache();
+			for (auto& [_, pipeline] : pipelineCache)
+			{
+				if (pipeline != VK_NULL_HANDLE)
+					vkDestroyPipeline(device, pipeline, nullptr);
+			}
+
+			pipelineCache.clear();
+		}
+
+		VkPipeline CreateComputePipeline(VkDevice device, const VulkanShader* shader)
+		{
+			const VkShaderModule computeModule = shader->GetShaderModule(VK_SHADER_STAGE_COMPUTE_BIT);
+			if (computeModule == VK_NULL_HANDLE || shader->GetPipelineLayout() == VK_NULL_HANDLE)
+				return VK_NULL_HANDLE;
+
+			VkComputePipelineCreateInfo pipelineInfo{};
+			pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+			pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+			pipelineInfo.stage.module = computeModule;
+			pipelineInfo.stage.pName = "main";
+			pipelineInfo.layout = shader->GetPipelineLayout();
+
+			VkPipeline pipeline = VK_NULL_HANDLE;
+			if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+				return VK_NULL_HANDLE;
+
+			return pipeline;
+		}
+
 		VkFormat ShaderDataTypeToVulkanFormat(ShaderDataType type)
 		{
 			switch (type)
@@ -116,7 +252,7 @@ namespace Syndra {
 			return hash;
 		}
 
-		void BeginDynamicRendering(VkCommandBuffer commandBuffer, VulkanFrameBuffer* frameBuffer)
+		void BeginDynamicRendering(VkCommandBuffer commandBuffer, VulkanFrameBuffer* frameBuffer, VkRenderingFlags flags = 0)
 		{
 			SN_CORE_ASSERT(frameBuffer != nullptr, "Vulkan framebuffer is required for dynamic rendering.");
 
@@ -151,6 +287,7 @@ namespace Syndra {
 
 			VkRenderingInfo renderingInfo{};
 			renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+			renderingInfo.flags = flags;
 			renderingInfo.renderArea = renderArea;
 			renderingInfo.layerCount = 1;
 			renderingInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachments.size());
@@ -368,29 +505,41 @@ namespace Syndra {
 
 	}
 
+	VulkanRendererAPI* VulkanRendererAPI::s_CurrentRendererAPI = nullptr;
+
 	VulkanRendererAPI::~VulkanRendererAPI()
 	{
 		Flush();
+		if (s_CurrentRendererAPI == this)
+			s_CurrentRendererAPI = nullptr;
 
 		VulkanContext* context = VulkanContext::GetCurrent();
 		if (context != nullptr && context->GetDevice() != VK_NULL_HANDLE)
 		{
 			vkDeviceWaitIdle(context->GetDevice());
 			DestroyCachedPipelines(context->GetDevice());
-			DestroyTransientDescriptorPools(context->GetDevice());
+			DestroyCachedComputePipelines(context->GetDevice());
+			DestroyRecordingResources(context->GetDevice());
+			VulkanBindlessTextureTable::Shutdown();
 		}
 		else
 		{
 			GetPipelineCache().clear();
-			DestroyTransientDescriptorPools(VK_NULL_HANDLE);
+			GetComputePipelineCache().clear();
+			DestroyRecordingResources(VK_NULL_HANDLE);
 		}
+		m_UniformAllocator.Destroy(context);
 
+		// Packets still alive keep their pool until they release their sets.
+		m_PacketDescriptorPool = nullptr;
 		m_FallbackUniformBuffer = nullptr;
 		m_FallbackTexture = nullptr;
 	}
 
 	void VulkanRendererAPI::InvalidateAllGraphicsPipelines()
 	{
+		VulkanDrawPacket::InvalidateAll();
+
 		VulkanContext* context = VulkanContext::GetCurrent();
 		const VkDevice device = (context != nullptr) ? context->GetDevice() : VK_NULL_HANDLE;
 		if (device != VK_NULL_HANDLE)
@@ -408,8 +557,11 @@ namespace Syndra {
 		if (shader == nullptr)
 			return;
 
+		VulkanDrawPacket::InvalidateAll();
 		auto& pipelineCache = GetPipelineCache();
-		if (pipelineCache.empty())
+		auto& computePipelineCache = GetComputePipelineCache();
+		const auto computePipelineIt = computePipelineCache.find(shader);
+		if (pipelineCache.empty() && computePipelineIt == computePipelineCache.end())
 			return;
 
 		VulkanContext* context = VulkanContext::GetCurrent();
@@ -417,6 +569,13 @@ namespace Syndra {
 		if (device != VK_NULL_HANDLE)
 			vkDeviceWaitIdle(device);
 
+		if (computePipelineIt != computePipelineCache.end())
+		{
+			if (device != VK_NULL_HANDLE && computePipelineIt->second != VK_NULL_HANDLE)
+				vkDestroyPipeline(device, computePipelineIt->second, nullptr);
+			computePipelineCache.erase(computePipelineIt);
+		}
+
 		size_t removedPipelineCount = 0;
 		for (auto iterator = pipelineCache.begin(); iterator != pipelineCache.end();)
 		{
@@ -444,6 +603,7 @@ namespace Syndra {
 
 	void VulkanRendererAPI::Init()
 	{
+		s_CurrentRendererAPI = this;
 		if (VulkanContext* context = VulkanContext::GetCurrent())
 		{
 			VkPhysicalDeviceProperties properties{};
@@ -471,9 +631,10 @@ namespace Syndra {
 
 	bool VulkanRendererAPI::EnsureTransientDescriptorPool(
 		VulkanContext* context,
+		RecordingThreadState& threadState,
 		uint32_t frameIndex,
 		uint32_t requiredSetCount,
-		const std::unordered_map<VkDescriptorType, uint32_t>& requiredDescriptorCounts,
+		const DescriptorTypeCounts& requiredDescriptorCounts,
 		bool forceReset)
 	{
 		if (context == nullptr || context->GetDevice() == VK_NULL_HANDLE)
@@ -481,13 +642,13 @@ namespace Syndra {
 		if (frameIndex >= context->GetFramesInFlight())
 			return false;
 
-		if (m_TransientDescriptorPools.size() < context->GetFramesInFlight())
-			m_TransientDescriptorPools.resize(context->GetFramesInFlight());
+		if (threadState.DescriptorPools.size() < context->GetFramesInFlight())
+			threadState.DescriptorPools.resize(context->GetFramesInFlight());
 
-		TransientDescriptorPoolState& poolState = m_TransientDescriptorPools[frameIndex];
+		TransientDescriptorPoolState& poolState = threadState.DescriptorPools[frameIndex];
 
 		const uint32_t desiredMaxSets = std::max(kDescriptorPoolMinSets, requiredSetCount * kDescriptorPoolSetSlack);
-		std::unordered_map<VkDescriptorType, uint32_t> desiredTypeCounts;
+		DescriptorTypeCounts desiredTypeCounts;
 		desiredTypeCounts.reserve(requiredDescriptorCounts.size());
 		for (const auto& [descriptorType, requiredCount] : requiredDescriptorCounts)
 		{
@@ -498,8 +659,9 @@ namespace Syndra {
 		if (!forceReset)
 		{
 			adjustedDesiredMaxSets = std::max(adjustedDesiredMaxSets, kDescriptorPoolFrameMinSets);
-			const std::array<VkDescriptorType, 4> frameBaselineTypes = {
+			const std::array<VkDescriptorType, 5> frameBaselineTypes = {
 				VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+				VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
 				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
 				VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
@@ -531,7 +693,7 @@ namespace Syndra {
 				vkDestroyDescriptorPool(context->GetDevice(), poolState.Pool, nullptr);
 			poolState = {};
 
-			std::vector<VkDescriptorPoolSize> poolSizes;
+			FrameVector<VkDescriptorPoolSize> poolSizes;
 			poolSizes.reserve(desiredTypeCounts.size());
 			for (const auto& [descriptorType, descriptorCount] : desiredTypeCounts)
 			{
@@ -557,7 +719,7 @@ namespace Syndra {
 				return false;
 
 			poolState.MaxSets = adjustedDesiredMaxSets;
-			poolState.TypeCaps = std::move(desiredTypeCounts);
+			poolState.TypeCaps.insert(desiredTypeCounts.begin(), desiredTypeCounts.end());
 			poolState.NeedsReset = false;
 			return true;
 		}
@@ -572,21 +734,330 @@ namespace Syndra {
 		return true;
 	}
 
-	void VulkanRendererAPI::DestroyTransientDescriptorPools(VkDevice device)
+	void VulkanRendererAPI::DestroyRecordingResources(VkDevice device)
 	{
 		if (device != VK_NULL_HANDLE)
 		{
-			for (const auto& poolState : m_TransientDescriptorPools)
+			for (const auto& threadState : m_ThreadStates)
+			{
+				for (const auto& poolState : threadState.DescriptorPools)
+				{
+					if (poolState.Pool != VK_NULL_HANDLE)
+						vkDestroyDescriptorPool(device, poolState.Pool, nullptr);
+				}
+				for (const auto& commandPool : threadState.CommandPools)
+				{
+					if (commandPool.Pool != VK_NULL_HANDLE)
+						vkDestroyCommandPool(device, commandPool.Pool, nullptr);
+				}
+			}
+		}
+
+		m_ThreadStates.clear();
+		m_PendingFrameBuffer = nullptr;
+		m_PendingDraws.clear();
+		m_PendingBindings.clear();
+		m_PendingPushConstants.clear();
+		m_PendingDynamicOffsets.clear();
+		m_SecondaryCommandBuffers.clear();
+	}
+
+	bool VulkanRendererAPI::AcquireDescriptorSets(
+		VulkanContext* context,
+		RecordingThreadState& threadState,
+		const VulkanShader* shader,
+		const DescriptorBindingEntry* bindings,
+		uint32_t bindingCount,
+		bool frameScoped,
+		DescriptorSetList& outDescriptorSets)
+	{
+		outDescriptorSets.clear();
+		const auto& descriptorSetLayouts = shader->GetDescriptorSetLayouts();
+		if (descriptorSetLayouts.empty())
+			return true;
+
+		const uint32_t framesInFlight = context->GetFramesInFlight();
+		const uint32_t frameIndex = context->GetCurrentFrameIndex();
+		if (frameIndex >= framesInFlight)
+			return false;
+		if (threadState.DescriptorPools.size() < framesInFlight)
+			threadState.DescriptorPools.resize(framesInFlight);
+		if (threadState.DescriptorSetCache.size() < framesInFlight)
+			threadState.DescriptorSetCache.resize(framesInFlight);
+
+		// The first use in a frame recycles this frame slot: its previous sets are no longer in flight.
+		const uint64_t frameSerial = context->GetFrameNumber();
+		if (frameScoped && frameSerial != threadState.LastDescriptorFrameSerial)
+		{
+			threadState.DescriptorPools[frameIndex].NeedsReset = true;
+			threadState.DescriptorSetCache[frameIndex].clear();
+			threadState.LastDescriptorFrameSerial = frameSerial;
+		}
+
+		// Filled in place so a cache hit reuses its binding storage instead of allocating a key.
+		DescriptorSetCacheKey& cacheKey = threadState.LookupKey;
+		if (frameScoped)
+		{
+			cacheKey.Shader = shader;
+			cacheKey.PipelineLayout = shader->GetPipelineLayout();
+			cacheKey.Bindings.assign(bindings, bindings + bindingCount);
+
+			const auto& frameCache = threadState.DescriptorSetCache[frameIndex];
+			auto cacheIt = frameCache.find(cacheKey);
+			if (cacheIt != frameCache.end())
 			{
-				if (poolState.Pool != VK_NULL_HANDLE)
-					vkDestroyDescriptorPool(device, poolState.Pool, nullptr);
+				outDescriptorSets.assign(cacheIt->second.begin(), cacheIt->second.end());
+				return true;
 			}
 		}
 
-		m_TransientDescriptorPools.clear();
-		m_DescriptorSetCache.clear();
-		m_LastDescriptorPoolFrameSerial = std::numeric_limits<uint64_t>::max();
-		m_LastDescriptorCacheFrameSerial = std::numeric_limits<uint64_t>::max();
+		const auto& reflectedBindings = shader->GetReflectedBindings();
+		DescriptorTypeCounts descriptorTypeCounts;
+		descriptorTypeCounts.reserve(reflectedBindings.size());
+		for (const auto& reflectedBinding : reflectedBindings)
+			descriptorTypeCounts[reflectedBinding.Type] += reflectedBinding.DescriptorCount;
+
+		if (!EnsureTransientDescriptorPool(
+			context,
+			threadState,
+			frameIndex,
+			static_cast<uint32_t>(descriptorSetLayouts.size()),
+			descriptorTypeCounts,
+			!frameScoped))
+			return false;
+
+		uint32_t allocatedSets = 0;
+		if (!AllocateShaderDescriptorSets(
+			context->GetDevice(),
+			threadState.DescriptorPools[frameIndex].Pool,
+			shader,
+			outDescriptorSets,
+			allocatedSets))
+		{
+			outDescriptorSets.clear();
+			return false;
+		}
+		m_DescriptorSetAllocations.fetch_add(allocatedSets, std::memory_order_relaxed);
+
+		WriteDescriptorSets(context->GetDevice(), bindings, bindingCount, outDescriptorSets.data(), static_cast<uint32_t>(outDescriptorSets.size()));
+
+		// The cache outlives the frame (it is recycled per frame in flight), so it keeps heap copies.
+		if (frameScoped)
+			threadState.DescriptorSetCache[frameIndex].emplace(cacheKey, std::vector<VkDescriptorSet>(outDescriptorSets.begin(), outDescriptorSets.end()));
+		return true;
+	}
+
+	void VulkanRendererAPI::WriteDescriptorSets(VkDevice device, const DescriptorBindingEntry* bindings, uint32_t bindingCount, const VkDescriptorSet* descriptorSets, uint32_t descriptorSetCount)
+	{
+		FrameVector<VkDescriptorBufferInfo> bufferInfos;
+		FrameVector<VkDescriptorImageInfo> imageInfos;
+		FrameVector<VkWriteDescriptorSet> writes;
+		bufferInfos.reserve(bindingCount);
+		imageInfos.reserve(bindingCount);
+		writes.reserve(bindingCount);
+
+		for (uint32_t i = 0; i < bindingCount; ++i)
+		{
+			const DescriptorBindingEntry& descriptorBinding = bindings[i];
+			if (descriptorBinding.Set >= descriptorSetCount)
+				continue;
+
+			if (descriptorBinding.Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+				descriptorBinding.Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+				descriptorBinding.Type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+			{
+				VkDescriptorBufferInfo& bufferInfo = bufferInfos.emplace_back();
+				bufferInfo.buffer = descriptorBinding.Buffer;
+				bufferInfo.offset = descriptorBinding.BufferOffset;
+				bufferInfo.range = descriptorBinding.BufferRange;
+
+				VkWriteDescriptorSet& write = writes.emplace_back();
+				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				write.dstSet = descriptorSets[descriptorBinding.Set];
+				write.dstBinding = descriptorBinding.Binding;
+				write.dstArrayElement = 0;
+				write.descriptorType = descriptorBinding.Type;
+				write.descriptorCount = 1;
+				write.pBufferInfo = &bufferInfo;
+				continue;
+			}
+
+			if (descriptorBinding.Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+			{
+				VkDescriptorImageInfo& imageInfo = imageInfos.emplace_back();
+				imageInfo.sampler = descriptorBinding.Sampler;
+				imageInfo.imageView = descriptorBinding.ImageView;
+				imageInfo.imageLayout = descriptorBinding.ImageLayout;
+
+				VkWriteDescriptorSet& write = writes.emplace_back();
+				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				write.dstSet = descriptorSets[descriptorBinding.Set];
+				write.dstBinding = descriptorBinding.Binding;
+				write.dstArrayElement = 0;
+				write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				write.descriptorCount = 1;
+				write.pImageInfo = &imageInfo;
+			}
+		}
+
+		if (!writes.empty())
+		{
+			vkUpdateDescriptorSets(
+				device,
+				static_cast<uint32_t>(writes.size()),
+				writes.data(),
+				0,
+				nullptr);
+		}
+	}
+
+	VkCommandBuffer VulkanRendererAPI::AcquireSecondaryCommandBuffer(VulkanContext* context, RecordingThreadState& threadState)
+	{
+		const uint32_t framesInFlight = context->GetFramesInFlight();
+		const uint32_t frameIndex = context->GetCurrentFrameIndex();
+		if (frameIndex >= framesInFlight)
+			return VK_NULL_HANDLE;
+		if (threadState.CommandPools.size() < framesInFlight)
+			threadState.CommandPools.resize(framesInFlight);
+
+		SecondaryCommandPool& commandPool = threadState.CommandPools[frameIndex];
+		if (commandPool.Pool == VK_NULL_HANDLE)
+		{
+			VkCommandPoolCreateInfo poolInfo{};
+			poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+			poolInfo.queueFamilyIndex = context->GetGraphicsQueueFamily();
+			if (vkCreateCommandPool(context->GetDevice(), &poolInfo, nullptr, &commandPool.Pool) != VK_SUCCESS)
+			{
+				commandPool.Pool = VK_NULL_HANDLE;
+				return VK_NULL_HANDLE;
+			}
+		}
+
+		const uint64_t frameSerial = context->GetFrameNumber();
+		if (commandPool.FrameSerial != frameSerial)
+		{
+			if (vkResetCommandPool(context->GetDevice(), commandPool.Pool, 0) != VK_SUCCESS)
+				return VK_NULL_HANDLE;
+			commandPool.UsedCommandBuffers = 0;
+			commandPool.FrameSerial = frameSerial;
+		}
+
+		if (commandPool.UsedCommandBuffers == commandPool.CommandBuffers.size())
+		{
+			VkCommandBufferAllocateInfo allocInfo{};
+			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocInfo.commandPool = commandPool.Pool;
+			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			allocInfo.commandBufferCount = 1;
+
+			VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+			if (vkAllocateCommandBuffers(context->GetDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS)
+				return VK_NULL_HANDLE;
+			commandPool.CommandBuffers.push_back(commandBuffer);
+		}
+
+		return commandPool.CommandBuffers[commandPool.UsedCommandBuffers++];
+	}
+
+	void VulkanRendererAPI::RecordDraws(VulkanContext* context, RecordingThreadState& threadState, VkCommandBuffer commandBuffer, uint32_t begin, uint32_t end)
+	{
+		DescriptorSetList descriptorSets;
+		const RecordedDraw* previousDraw = nullptr;
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			const RecordedDraw& draw = m_PendingDraws[i];
+			const uint8_t* pushConstantData = m_PendingPushConstants.data() + draw.PushConstantOffset;
+			const uint32_t* dynamicOffsets = m_PendingDynamicOffsets.data() + draw.DynamicOffsetOffset;
+			if (draw.DescriptorSets != nullptr)
+			{
+				RecordDraw(commandBuffer, draw, draw.DescriptorSets, draw.DescriptorSetCount, dynamicOffsets, pushConstantData, previousDraw);
+				previousDraw = &draw;
+				continue;
+			}
+
+			if (!AcquireDescriptorSets(
+				context,
+				threadState,
+				draw.Shader,
+				m_PendingBindings.data() + draw.BindingOffset,
+				draw.BindingCount,
+				true,
+				descriptorSets))
+				continue;
+
+			RecordDraw(commandBuffer, draw, descriptorSets.data(), static_cast<uint32_t>(descriptorSets.size()), dynamicOffsets, pushConstantData, previousDraw);
+			previousDraw = &draw;
+		}
+	}
+
+	void VulkanRendererAPI::RecordDraw(
+		VkCommandBuffer commandBuffer,
+		const RecordedDraw& draw,
+		const VkDescriptorSet* descriptorSets,
+		uint32_t descriptorSetCount,
+		const uint32_t* dynamicOffsets,
+		const uint8_t* pushConstantData,
+		const RecordedDraw* previousDraw)
+	{
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.Pipeline);
+		vkCmdSetViewport(commandBuffer, 0, 1, &draw.Viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, &draw.Scissor);
+
+		// Meshes share a handful of pool buffers, so consecutive draws rarely need a rebind.
+		if (previousDraw == nullptr || previousDraw->VertexBuffer != draw.VertexBuffer)
+		{
+			const VkDeviceSize vertexBufferOffset = 0;
+			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &draw.VertexBuffer, &vertexBufferOffset);
+		}
+		if (previousDraw == nullptr || previousDraw->IndexBuffer != draw.IndexBuffer)
+			vkCmdBindIndexBuffer(commandBuffer, draw.IndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+		if (descriptorSetCount > 0)
+		{
+			vkCmdBindDescriptorSets(
+				commandBuffer,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				draw.Shader->GetPipelineLayout(),
+				0,
+				descriptorSetCount,
+				descriptorSets,
+				draw.DynamicOffsetCount,
+				draw.DynamicOffsetCount > 0 ? dynamicOffsets : nullptr);
+		}
+
+		for (const auto& range : draw.Shader->GetPushConstantRanges())
+		{
+			if (range.offset >= draw.PushConstantSize)
+				continue;
+
+			const uint32_t pushSize = std::min(range.size, draw.PushConstantSize - range.offset);
+			if (pushSize == 0)
+				continue;
+
+			vkCmdPushConstants(
+				commandBuffer,
+				draw.Shader->GetPipelineLayout(),
+				range.stageFlags,
+				range.offset,
+				pushSize,
+				pushConstantData + range.offset);
+		}
+
+		if (draw.IndirectBuffer != VK_NULL_HANDLE)
+		{
+			vkCmdDrawIndexedIndirectCount(
+				commandBuffer,
+				draw.IndirectBuffer,
+				draw.IndirectOffset,
+				draw.CountBuffer,
+				draw.CountOffset,
+				draw.MaxDrawCount,
+				sizeof(VkDrawIndexedIndirectCommand));
+			return;
+		}
+
+		vkCmdDrawIndexed(commandBuffer, draw.IndexCount, 1, draw.FirstIndex, draw.VertexOffset, 0);
 	}
 
 	void VulkanRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
@@ -613,46 +1084,44 @@ namespace Syndra {
 		}
 	}
 
-	void VulkanRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray)
+	bool VulkanRendererAPI::ResolveDraw(VulkanContext* context, const Ref<VertexArray>& vertexArray, VulkanFrameBuffer*& outFrameBuffer, RecordedDraw& outDraw)
 	{
-		SN_PROFILE_SCOPE("VulkanRendererAPI::DrawIndexed");
-		VulkanContext* context = VulkanContext::GetCurrent();
-		if (context == nullptr || vertexArray == nullptr)
-			return;
+		if (vertexArray == nullptr)
+			return false;
 
 		auto vkVertexArray = std::dynamic_pointer_cast<VulkanVertexArray>(vertexArray);
 		if (!vkVertexArray)
-			return;
+			return false;
 
 		const Ref<IndexBuffer>& indexBufferRef = vkVertexArray->GetIndexBuffer();
 		if (!indexBufferRef)
-			return;
+			return false;
 
 		auto vkIndexBuffer = std::dynamic_pointer_cast<VulkanIndexBuffer>(indexBufferRef);
 		if (!vkIndexBuffer || vkIndexBuffer->GetCount() == 0)
-			return;
+			return false;
 
 		const VulkanShader* shader = VulkanShader::GetBoundShader();
 		if (shader == nullptr)
-			return;
+			return false;
 
 		VulkanFrameBuffer* frameBuffer = VulkanFrameBuffer::GetBoundFrameBuffer();
 		if (frameBuffer == nullptr)
-			return;
+			return false;
 		if (frameBuffer->GetColorAttachmentCount() == 0 && !frameBuffer->HasDepthImage())
-			return;
+			return false;
 
 		const auto& vertexBuffers = vkVertexArray->GetVertexBuffers();
 		if (vertexBuffers.empty())
-			return;
+			return false;
 
 		auto vkVertexBuffer = std::dynamic_pointer_cast<VulkanVertexBuffer>(vertexBuffers[0]);
 		if (!vkVertexBuffer)
-			return;
+			return false;
 
 		const BufferLayout& layout = vkVertexBuffer->GetLayout();
 		if (layout.GetStride() == 0)
-			return;
+			return false;
 
 		const PipelineKey pipelineKey{
 			shader,
@@ -686,313 +1155,485 @@ namespace Syndra {
 					m_BlendEnabled,
 					m_CullEnabled);
 				if (pipeline == VK_NULL_HANDLE)
-					return;
+					return false;
 
 				pipelineCache.emplace(pipelineKey, pipeline);
 			}
 		}
 
-		std::vector<VkDescriptorSet> descriptorSets;
-		const auto& descriptorSetLayouts = shader->GetDescriptorSetLayouts();
-		const auto& reflectedBindings = shader->GetReflectedBindings();
-		const VkCommandBuffer activeFrameCommandBuffer = context->GetActiveFrameCommandBuffer();
-		const bool useFrameCommandBuffer = (activeFrameCommandBuffer != VK_NULL_HANDLE);
-		const uint32_t frameIndex = context->GetCurrentFrameIndex();
-		const uint64_t frameSerial = context->GetFrameNumber();
+		outFrameBuffer = frameBuffer;
+		outDraw = {};
+		outDraw.Shader = shader;
+		outDraw.Pipeline = pipeline;
+		outDraw.VertexBuffer = vkVertexBuffer->GetBuffer();
+		outDraw.IndexBuffer = vkIndexBuffer->GetBuffer();
+		outDraw.IndexCount = vkIndexBuffer->GetCount();
+		outDraw.VertexOffset = vkVertexBuffer->GetBaseVertex();
+		outDraw.FirstIndex = vkIndexBuffer->GetFirstIndex();
+		if (outDraw.VertexBuffer == VK_NULL_HANDLE || outDraw.IndexBuffer == VK_NULL_HANDLE)
+			return false;
 
-		if (useFrameCommandBuffer && frameSerial != m_LastDescriptorPoolFrameSerial)
-		{
-			if (frameIndex >= context->GetFramesInFlight())
-				return;
-			if (m_TransientDescriptorPools.size() < context->GetFramesInFlight())
-				m_TransientDescriptorPools.resize(context->GetFramesInFlight());
+		outDraw.Viewport.x = static_cast<float>(m_ViewportX);
+		outDraw.Viewport.y = static_cast<float>(m_ViewportY);
+		outDraw.Viewport.width = (m_ViewportWidth > 0) ? static_cast<float>(m_ViewportWidth) : static_cast<float>(frameBuffer->GetSpecification().Width);
+		outDraw.Viewport.height = (m_ViewportHeight > 0) ? static_cast<float>(m_ViewportHeight) : static_cast<float>(frameBuffer->GetSpecification().Height);
+		outDraw.Viewport.width = std::min(outDraw.Viewport.width, static_cast<float>(frameBuffer->GetSpecification().Width));
+		outDraw.Viewport.height = std::min(outDraw.Viewport.height, static_cast<float>(frameBuffer->GetSpecification().Height));
+		outDraw.Viewport.minDepth = 0.0f;
+		outDraw.Viewport.maxDepth = 1.0f;
+		outDraw.Scissor.offset = { static_cast<int32_t>(m_ViewportX), static_cast<int32_t>(m_ViewportY) };
+		outDraw.Scissor.extent.width = static_cast<uint32_t>(outDraw.Viewport.width);
+		outDraw.Scissor.extent.height = static_cast<uint32_t>(outDraw.Viewport.height);
+		return true;
+	}
 
-			m_TransientDescriptorPools[frameIndex].NeedsReset = true;
-			m_LastDescriptorPoolFrameSerial = frameSerial;
-		}
+	void VulkanRendererAPI::ResolveBindings(VulkanContext* context, const VulkanShader* shader, std::vector<DescriptorBindingEntry>& outBindings)
+	{
+		const auto& descriptorSetLayouts = shader->GetDescriptorSetLayouts();
+		if (descriptorSetLayouts.empty())
+			return;
 
-		if (useFrameCommandBuffer && frameSerial != m_LastDescriptorCacheFrameSerial)
+		SN_PROFILE_SCOPE("DrawIndexed::DescriptorBindings");
+		auto fallbackUniform = std::dynamic_pointer_cast<VulkanUniformBuffer>(m_FallbackUniformBuffer);
+		for (const auto& reflectedBinding : shader->GetReflectedBindings())
 		{
-			if (frameIndex >= context->GetFramesInFlight())
-				return;
-			if (m_DescriptorSetCache.size() < context->GetFramesInFlight())
-				m_DescriptorSetCache.resize(context->GetFramesInFlight());
+			// Bindless textures are addressed through push constants; see PatchBindlessTextureIndices.
+			if (reflectedBinding.Set >= descriptorSetLayouts.size() || reflectedBinding.Set == shader->GetBindlessTextureSet())
+				continue;
 
-			m_DescriptorSetCache[frameIndex].clear();
-			m_LastDescriptorCacheFrameSerial = frameSerial;
-		}
+			DescriptorBindingEntry descriptorBinding{};
+			descriptorBinding.Set = reflectedBinding.Set;
+			descriptorBinding.Binding = reflectedBinding.Binding;
+			descriptorBinding.Type = reflectedBinding.Type;
 
-		if (!descriptorSetLayouts.empty())
-		{
-			SN_PROFILE_SCOPE("DrawIndexed::DescriptorSets");
-			std::unordered_map<VkDescriptorType, uint32_t> descriptorTypeCounts;
-			descriptorTypeCounts.reserve(reflectedBindings.size());
-			for (const auto& reflectedBinding : reflectedBindings)
-				descriptorTypeCounts[reflectedBinding.Type] += reflectedBinding.DescriptorCount;
-
-			auto fallbackUniform = std::dynamic_pointer_cast<VulkanUniformBuffer>(m_FallbackUniformBuffer);
-			std::vector<DescriptorBindingEntry> descriptorBindings;
-			descriptorBindings.reserve(reflectedBindings.size());
-			for (const auto& reflectedBinding : reflectedBindings)
+			if (reflectedBinding.Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
 			{
-				if (reflectedBinding.Set >= descriptorSetLayouts.size())
+				VulkanUniformBuffer* uniformBuffer = VulkanUniformBuffer::GetUniformBufferForBinding(reflectedBinding.Binding);
+				if (uniformBuffer == nullptr && fallbackUniform)
+					uniformBuffer = fallbackUniform.get();
+
+				VulkanUniformAllocator::Slice slice{};
+				if (uniformBuffer == nullptr || !uniformBuffer->ResolveSlice(context, m_UniformAllocator, slice))
 					continue;
 
-				DescriptorBindingEntry descriptorBinding{};
-				descriptorBinding.Set = reflectedBinding.Set;
-				descriptorBinding.Binding = reflectedBinding.Binding;
-				descriptorBinding.Type = reflectedBinding.Type;
+				descriptorBinding.Buffer = slice.Buffer;
+				descriptorBinding.BufferOffset = 0;
+				descriptorBinding.BufferRange = slice.Size;
+				descriptorBinding.DynamicOffset = static_cast<uint32_t>(slice.Offset);
+				descriptorBinding.UniformBuffer = uniformBuffer;
+				outBindings.push_back(descriptorBinding);
+				continue;
+			}
 
-				if (reflectedBinding.Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+			if (reflectedBinding.Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+			{
+				uint32_t rendererID = VulkanTexture2D::GetBoundTexture(reflectedBinding.Binding);
+				if (rendererID == 0 && m_FallbackTexture)
+					rendererID = m_FallbackTexture->GetRendererID();
+
+				VulkanImGuiTextureInfo textureInfo{};
+				if (!VulkanImGuiTextureRegistry::TryGetTextureInfo(rendererID, textureInfo) && m_FallbackTexture)
 				{
-					VulkanUniformBuffer* uniformBuffer = VulkanUniformBuffer::GetUniformBufferForBinding(reflectedBinding.Binding);
-					if (uniformBuffer == nullptr && fallbackUniform)
-						uniformBuffer = fallbackUniform.get();
-					if (uniformBuffer == nullptr)
-						continue;
-
-					descriptorBinding.Buffer = uniformBuffer->GetBuffer();
-					descriptorBinding.BufferOffset = 0;
-					descriptorBinding.BufferRange = uniformBuffer->GetSize();
-					descriptorBindings.push_back(descriptorBinding);
-					continue;
+					const uint32_t fallbackRendererID = m_FallbackTexture->GetRendererID();
+					VulkanImGuiTextureRegistry::TryGetTextureInfo(fallbackRendererID, textureInfo);
 				}
 
-				if (reflectedBinding.Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
-				{
-					uint32_t rendererID = VulkanTexture2D::GetBoundTexture(reflectedBinding.Binding);
-					if (rendererID == 0 && m_FallbackTexture)
-						rendererID = m_FallbackTexture->GetRendererID();
+				if (textureInfo.Sampler == VK_NULL_HANDLE || textureInfo.ImageView == VK_NULL_HANDLE)
+					continue;
 
-					VulkanImGuiTextureInfo textureInfo{};
-					if (!VulkanImGuiTextureRegistry::TryGetTextureInfo(rendererID, textureInfo) && m_FallbackTexture)
-					{
-						const uint32_t fallbackRendererID = m_FallbackTexture->GetRendererID();
-						VulkanImGuiTextureRegistry::TryGetTextureInfo(fallbackRendererID, textureInfo);
-					}
+				descriptorBinding.Sampler = textureInfo.Sampler;
+				descriptorBinding.ImageView = textureInfo.ImageView;
+				descriptorBinding.ImageLayout = (textureInfo.ImageLayout != VK_IMAGE_LAYOUT_UNDEFINED)
+					? textureInfo.ImageLayout
+					: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				outBindings.push_back(descriptorBinding);
+				continue;
+			}
 
-					if (textureInfo.Sampler == VK_NULL_HANDLE || textureInfo.ImageView == VK_NULL_HANDLE)
-						continue;
+			if (reflectedBinding.Type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+			{
+				const VulkanStorageBuffer* storageBuffer = VulkanStorageBuffer::GetBoundBuffer(reflectedBinding.Binding);
+				if (storageBuffer == nullptr)
+					continue;
 
-					descriptorBinding.Sampler = textureInfo.Sampler;
-					descriptorBinding.ImageView = textureInfo.ImageView;
-					descriptorBinding.ImageLayout = (textureInfo.ImageLayout != VK_IMAGE_LAYOUT_UNDEFINED)
-						? textureInfo.ImageLayout
-						: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-					descriptorBindings.push_back(descriptorBinding);
-				}
+				descriptorBinding.Buffer = storageBuffer->GetBuffer();
+				descriptorBinding.BufferOffset = 0;
+				descriptorBinding.BufferRange = VK_WHOLE_SIZE;
+				outBindings.push_back(descriptorBinding);
 			}
+		}
+	}
 
-			auto allocateAndWriteDescriptorSets = [&](bool forcePoolReset) -> bool
-			{
-				if (!EnsureTransientDescriptorPool(
-					context,
-					frameIndex,
-					static_cast<uint32_t>(descriptorSetLayouts.size()),
-					descriptorTypeCounts,
-					forcePoolReset))
-					return false;
+	void VulkanRendererAPI::CaptureDrawResources(VulkanContext* context, RecordedDraw& draw)
+	{
+		draw.BindingOffset = static_cast<uint32_t>(m_PendingBindings.size());
+		ResolveBindings(context, draw.Shader, m_PendingBindings);
+		draw.BindingCount = static_cast<uint32_t>(m_PendingBindings.size()) - draw.BindingOffset;
 
-				VkDescriptorSetAllocateInfo allocInfo{};
-				allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-				allocInfo.descriptorPool = m_TransientDescriptorPools[frameIndex].Pool;
-				allocInfo.descriptorSetCount = static_cast<uint32_t>(descriptorSetLayouts.size());
-				allocInfo.pSetLayouts = descriptorSetLayouts.data();
+		draw.DynamicOffsetOffset = static_cast<uint32_t>(m_PendingDynamicOffsets.size());
+		for (uint32_t i = draw.BindingOffset; i < draw.BindingOffset + draw.BindingCount; ++i)
+		{
+			if (m_PendingBindings[i].Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+				m_PendingDynamicOffsets.push_back(m_PendingBindings[i].DynamicOffset);
+		}
+		draw.DynamicOffsetCount = static_cast<uint32_t>(m_PendingDynamicOffsets.size()) - draw.DynamicOffsetOffset;
 
-				descriptorSets.resize(descriptorSetLayouts.size(), VK_NULL_HANDLE);
-				if (vkAllocateDescriptorSets(context->GetDevice(), &allocInfo, descriptorSets.data()) != VK_SUCCESS)
-					return false;
+		const auto& pushConstantData = draw.Shader->GetPushConstantData();
+		draw.PushConstantOffset = static_cast<uint32_t>(m_PendingPushConstants.size());
+		draw.PushConstantSize = static_cast<uint32_t>(pushConstantData.size());
+		m_PendingPushConstants.insert(m_PendingPushConstants.end(), pushConstantData.begin(), pushConstantData.end());
+		PatchBindlessTextureIndices(draw.Shader, m_PendingPushConstants.data() + draw.PushConstantOffset, draw.PushConstantSize);
+	}
 
-				std::vector<VkDescriptorBufferInfo> bufferInfos;
-				std::vector<VkDescriptorImageInfo> imageInfos;
-				std::vector<VkWriteDescriptorSet> writes;
-				bufferInfos.reserve(descriptorBindings.size());
-				imageInfos.reserve(descriptorBindings.size());
-				writes.reserve(descriptorBindings.size());
+	void VulkanRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray)
+	{
+		SN_PROFILE_SCOPE("VulkanRendererAPI::DrawIndexed");
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr)
+			return;
 
-				for (const auto& descriptorBinding : descriptorBindings)
-				{
-					if (descriptorBinding.Set >= descriptorSets.size())
-						continue;
+		VulkanFrameBuffer* frameBuffer = nullptr;
+		RecordedDraw draw{};
+		if (!ResolveDraw(context, vertexArray, frameBuffer, draw))
+			return;
 
-					if (descriptorBinding.Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
-					{
-						VkDescriptorBufferInfo& bufferInfo = bufferInfos.emplace_back();
-						bufferInfo.buffer = descriptorBinding.Buffer;
-						bufferInfo.offset = descriptorBinding.BufferOffset;
-						bufferInfo.range = descriptorBinding.BufferRange;
-
-						VkWriteDescriptorSet& write = writes.emplace_back();
-						write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-						write.dstSet = descriptorSets[descriptorBinding.Set];
-						write.dstBinding = descriptorBinding.Binding;
-						write.dstArrayElement = 0;
-						write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-						write.descriptorCount = 1;
-						write.pBufferInfo = &bufferInfo;
-						continue;
-					}
+		// A batch holds the draws of one framebuffer. Outside a frame there is nothing to batch into,
+		// so the draw goes straight into a one-time command buffer below.
+		const VkCommandBuffer frameCommandBuffer = context->GetActiveFrameCommandBuffer();
+		if (m_PendingFrameBuffer != frameBuffer || frameCommandBuffer == VK_NULL_HANDLE)
+			Flush();
 
-					if (descriptorBinding.Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
-					{
-						VkDescriptorImageInfo& imageInfo = imageInfos.emplace_back();
-						imageInfo.sampler = descriptorBinding.Sampler;
-						imageInfo.imageView = descriptorBinding.ImageView;
-						imageInfo.imageLayout = descriptorBinding.ImageLayout;
-
-						VkWriteDescriptorSet& write = writes.emplace_back();
-						write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-						write.dstSet = descriptorSets[descriptorBinding.Set];
-						write.dstBinding = descriptorBinding.Binding;
-						write.dstArrayElement = 0;
-						write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-						write.descriptorCount = 1;
-						write.pImageInfo = &imageInfo;
-					}
-				}
+		// Bound resources are global state that the next draw may change, so they are resolved now.
+		CaptureDrawResources(context, draw);
 
-				if (!writes.empty())
-				{
-					vkUpdateDescriptorSets(
-						context->GetDevice(),
-						static_cast<uint32_t>(writes.size()),
-						writes.data(),
-						0,
-						nullptr);
-				}
+		if (frameCommandBuffer != VK_NULL_HANDLE)
+		{
+			m_PendingDraws.push_back(draw);
+			m_PendingFrameBuffer = frameBuffer;
+			return;
+		}
 
-				return true;
-			};
+		if (m_ThreadStates.empty())
+			m_ThreadStates.resize(1);
+
+		DescriptorSetList descriptorSets;
+		const bool hasDescriptorSets = AcquireDescriptorSets(
+			context,
+			m_ThreadStates[0],
+			draw.Shader,
+			m_PendingBindings.data() + draw.BindingOffset,
+			draw.BindingCount,
+			false,
+			descriptorSets);
+		if (hasDescriptorSets)
+		{
+			SN_PROFILE_SCOPE("DrawIndexed::RecordCommands");
+			VkCommandBuffer commandBuffer = context->BeginSingleTimeCommands();
+			frameBuffer->PrepareForRendering(commandBuffer);
+			BeginDynamicRendering(commandBuffer, frameBuffer);
+			RecordDraw(
+				commandBuffer,
+				draw,
+				descriptorSets.data(),
+				static_cast<uint32_t>(descriptorSets.size()),
+				m_PendingDynamicOffsets.data() + draw.DynamicOffsetOffset,
+				m_PendingPushConstants.data() + draw.PushConstantOffset);
+			vkCmdEndRendering(commandBuffer);
+			frameBuffer->FinalizeAfterRendering(commandBuffer);
+			context->EndSingleTimeCommands(commandBuffer);
+		}
+
+		m_PendingBindings.clear();
+		m_PendingPushConstants.clear();
+		m_PendingDynamicOffsets.clear();
+	}
+
+	bool VulkanRendererAPI::AllocatePacketDescriptorSets(VulkanContext* context, const VulkanShader* shader, VulkanDrawPacket& packet)
+	{
+		if (shader->GetDescriptorSetLayouts().empty())
+			return true;
 
-			if (useFrameCommandBuffer)
+		// A full or fragmented pool is retired to the packets still using it and a fresh one takes over.
+		for (uint32_t attempt = 0; attempt < 2; ++attempt)
+		{
+			if (!m_PacketDescriptorPool)
 			{
-				if (frameIndex >= context->GetFramesInFlight())
-					return;
-				if (m_DescriptorSetCache.size() < context->GetFramesInFlight())
-					m_DescriptorSetCache.resize(context->GetFramesInFlight());
-
-				DescriptorSetCacheKey cacheKey{};
-				cacheKey.Shader = shader;
-				cacheKey.PipelineLayout = shader->GetPipelineLayout();
-				cacheKey.Bindings = descriptorBindings;
-
-				auto& frameCache = m_DescriptorSetCache[frameIndex];
-				auto cacheIt = frameCache.find(cacheKey);
-				if (cacheIt != frameCache.end())
-				{
-					descriptorSets = cacheIt->second;
-				}
-				else
+				const std::array<VkDescriptorPoolSize, 2> poolSizes = { {
+					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, kPacketDescriptorPoolTypeCount },
+					{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kPacketDescriptorPoolTypeCount }
+				} };
+
+				VkDescriptorPoolCreateInfo poolInfo{};
+				poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+				poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+				poolInfo.maxSets = kPacketDescriptorPoolSets;
+				poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+				poolInfo.pPoolSizes = poolSizes.data();
+
+				auto pool = std::make_shared<VulkanPacketDescriptorPool>();
+				pool->Device = context->GetDevice();
+				if (vkCreateDescriptorPool(pool->Device, &poolInfo, nullptr, &pool->Pool) != VK_SUCCESS)
 				{
-					if (!allocateAndWriteDescriptorSets(false))
-						return;
-
-					frameCache.emplace(std::move(cacheKey), descriptorSets);
+					pool->Pool = VK_NULL_HANDLE;
+					break;
 				}
+				m_PacketDescriptorPool = std::move(pool);
 			}
-			else
+
+			uint32_t allocatedSets = 0;
+			if (AllocateShaderDescriptorSets(context->GetDevice(), m_PacketDescriptorPool->Pool, shader, packet.m_DescriptorSets, allocatedSets))
 			{
-				if (!allocateAndWriteDescriptorSets(true))
-					return;
+				packet.m_DescriptorPool = m_PacketDescriptorPool;
+				packet.m_BindlessSetIndex = shader->GetBindlessTextureSet();
+				m_DescriptorSetAllocations.fetch_add(allocatedSets, std::memory_order_relaxed);
+				return true;
 			}
+
+			m_PacketDescriptorPool = nullptr;
 		}
 
-		VkCommandBuffer commandBuffer = activeFrameCommandBuffer;
-		const bool ownsCommandBuffer = (commandBuffer == VK_NULL_HANDLE);
-		if (ownsCommandBuffer && m_ActiveRenderingCommandBuffer != VK_NULL_HANDLE)
-			Flush();
+		packet.m_DescriptorSets.clear();
+		return false;
+	}
+
+	bool VulkanRendererAPI::BuildDrawPacket(const Ref<VertexArray>& vertexArray, VulkanDrawPacket& packet)
+	{
+		SN_PROFILE_SCOPE("VulkanRendererAPI::BuildDrawPacket");
+		packet.Release();
+
+		// Uniform slices resolved outside a frame live in buffers of their own, not in the ring.
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr || context->GetActiveFrameCommandBuffer() == VK_NULL_HANDLE)
+			return false;
+
+		// Stamped before resolving, so a ring growth halfway through leaves the packet stale.
+		const uint64_t generation = VulkanDrawPacket::s_Generation.load(std::memory_order_relaxed);
+		VulkanFrameBuffer* frameBuffer = nullptr;
+		RecordedDraw draw{};
+		if (!ResolveDraw(context, vertexArray, frameBuffer, draw))
+			return false;
 
-		if (ownsCommandBuffer)
-			commandBuffer = context->BeginSingleTimeCommands();
-		else if (m_ActiveRenderingCommandBuffer != VK_NULL_HANDLE &&
-			(m_ActiveRenderingCommandBuffer != commandBuffer || m_ActiveRenderingFrameBuffer != frameBuffer))
+		std::vector<DescriptorBindingEntry> bindings;
+		ResolveBindings(context, draw.Shader, bindings);
+		if (!AllocatePacketDescriptorSets(context, draw.Shader, packet))
+			return false;
+		WriteDescriptorSets(context->GetDevice(), bindings.data(), static_cast<uint32_t>(bindings.size()), packet.m_DescriptorSets.data(), static_cast<uint32_t>(packet.m_DescriptorSets.size()));
+
+		packet.m_Shader = draw.Shader;
+		packet.m_FrameBuffer = frameBuffer;
+		packet.m_Pipeline = draw.Pipeline;
+		packet.m_VertexBuffer = draw.VertexBuffer;
+		packet.m_IndexBuffer = draw.IndexBuffer;
+		packet.m_IndexCount = draw.IndexCount;
+		packet.m_VertexOffset = draw.VertexOffset;
+		packet.m_FirstIndex = draw.FirstIndex;
+		packet.m_Viewport = draw.Viewport;
+		packet.m_Scissor = draw.Scissor;
+		packet.m_PushConstants = draw.Shader->GetPushConstantData();
+		PatchBindlessTextureIndices(draw.Shader, packet.m_PushConstants.data(), static_cast<uint32_t>(packet.m_PushConstants.size()));
+		for (const DescriptorBindingEntry& binding : bindings)
 		{
-			Flush();
+			if (binding.Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+				packet.m_UniformBuffers.push_back(binding.UniformBuffer);
 		}
+		packet.m_Generation = generation;
+
+		++GetCurrentRecordingStats(context->GetFrameNumber()).PacketBuilds;
+		return true;
+	}
+
+	bool VulkanRendererAPI::SubmitDrawPacket(const VulkanDrawPacket& packet)
+	{
+		if (!packet.IsValid())
+			return false;
+
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr || context->GetActiveFrameCommandBuffer() == VK_NULL_HANDLE)
+			return false;
+
+		if (m_PendingFrameBuffer != packet.m_FrameBuffer)
+			Flush();
 
+		// Resolving a slice may grow the uniform ring, which invalidates the packet's descriptor sets.
+		const uint32_t dynamicOffsetOffset = static_cast<uint32_t>(m_PendingDynamicOffsets.size());
+		for (VulkanUniformBuffer* uniformBuffer : packet.m_UniformBuffers)
 		{
-			SN_PROFILE_SCOPE("DrawIndexed::RecordCommands");
-			if (ownsCommandBuffer)
+			VulkanUniformAllocator::Slice slice{};
+			if (!uniformBuffer->ResolveSlice(context, m_UniformAllocator, slice) || !packet.IsValid())
 			{
-				frameBuffer->PrepareForRendering(commandBuffer);
-				BeginDynamicRendering(commandBuffer, frameBuffer);
+				m_PendingDynamicOffsets.resize(dynamicOffsetOffset);
+				return false;
 			}
-			else if (m_ActiveRenderingCommandBuffer == VK_NULL_HANDLE)
+			m_PendingDynamicOffsets.push_back(static_cast<uint32_t>(slice.Offset));
+		}
+
+		RecordedDraw draw{};
+		draw.Shader = packet.m_Shader;
+		draw.Pipeline = packet.m_Pipeline;
+		draw.VertexBuffer = packet.m_VertexBuffer;
+		draw.IndexBuffer = packet.m_IndexBuffer;
+		draw.IndexCount = packet.m_IndexCount;
+		draw.VertexOffset = packet.m_VertexOffset;
+		draw.FirstIndex = packet.m_FirstIndex;
+		draw.Viewport = packet.m_Viewport;
+		draw.Scissor = packet.m_Scissor;
+		draw.DescriptorSets = packet.m_DescriptorSets.data();
+		draw.DescriptorSetCount = static_cast<uint32_t>(packet.m_DescriptorSets.size());
+		draw.DynamicOffsetOffset = dynamicOffsetOffset;
+		draw.DynamicOffsetCount = static_cast<uint32_t>(packet.m_UniformBuffers.size());
+
+		// Push constants are copied so the owner may patch the packet again before the batch is flushed.
+		draw.PushConstantOffset = static_cast<uint32_t>(m_PendingPushConstants.size());
+		draw.PushConstantSize = static_cast<uint32_t>(packet.m_PushConstants.size());
+		m_PendingPushConstants.insert(m_PendingPushConstants.end(), packet.m_PushConstants.begin(), packet.m_PushConstants.end());
+
+		m_PendingDraws.push_back(draw);
+		m_PendingFrameBuffer = packet.m_FrameBuffer;
+		++GetCurrentRecordingStats(context->GetFrameNumber()).PacketDraws;
+		return true;
+	}
+
+	bool VulkanRendererAPI::DrawIndexedIndirectCount(
+		const Ref<VertexArray>& vertexArray,
+		VkBuffer drawBuffer,
+		VkDeviceSize drawOffset,
+		VkBuffer countBuffer,
+		VkDeviceSize countOffset,
+		uint32_t maxDrawCount)
+	{
+		SN_PROFILE_SCOPE("VulkanRendererAPI::DrawIndexedIndirectCount");
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr || !context->SupportsIndirectDrawCount() || context->GetActiveFrameCommandBuffer() == VK_NULL_HANDLE)
+			return false;
+		if (drawBuffer == VK_NULL_HANDLE || countBuffer == VK_NULL_HANDLE || maxDrawCount == 0)
+			return false;
+
+		VulkanFrameBuffer* frameBuffer = nullptr;
+		RecordedDraw draw{};
+		if (!ResolveDraw(context, vertexArray, frameBuffer, draw))
+			return false;
+
+		if (m_PendingFrameBuffer != frameBuffer)
+			Flush();
+
+		CaptureDrawResources(context, draw);
+		// The commands carry their own index ranges and vertex offsets into the pool buffers.
+		draw.IndirectBuffer = drawBuffer;
+		draw.IndirectOffset = drawOffset;
+		draw.CountBuffer = countBuffer;
+		draw.CountOffset = countOffset;
+		draw.MaxDrawCount = maxDrawCount;
+
+		m_PendingDraws.push_back(draw);
+		m_PendingFrameBuffer = frameBuffer;
+		++GetCurrentRecordingStats(context->GetFrameNumber()).IndirectDraws;
+		return true;
+	}
+
+	void VulkanRendererAPI::DispatchCompute(const VulkanShader* shader, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+	{
+		SN_PROFILE_SCOPE("VulkanRendererAPI::DispatchCompute");
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr || shader == nullptr || groupCountX == 0 || groupCountY == 0 || groupCountZ == 0)
+			return;
+
+		// Dispatches cannot be recorded inside dynamic rendering, so the batch so far goes first.
+		Flush();
+
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		auto& pipelineCache = GetComputePipelineCache();
+		auto pipelineIt = pipelineCache.find(shader);
+		if (pipelineIt != pipelineCache.end())
+		{
+			pipeline = pipelineIt->second;
+		}
+		else
+		{
+			pipeline = CreateComputePipeline(context->GetDevice(), shader);
+			if (pipeline == VK_NULL_HANDLE)
 			{
-				frameBuffer->PrepareForRendering(commandBuffer);
-				BeginDynamicRendering(commandBuffer, frameBuffer);
-				m_ActiveRenderingCommandBuffer = commandBuffer;
-				m_ActiveRenderingFrameBuffer = frameBuffer;
+				SN_CORE_ERROR("Failed to create Vulkan compute pipeline for shader '{}'.", shader->GetName());
+				return;
 			}
 
-		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-
-		VkViewport viewport{};
-		viewport.x = static_cast<float>(m_ViewportX);
-		viewport.y = static_cast<float>(m_ViewportY);
-		viewport.width = (m_ViewportWidth > 0) ? static_cast<float>(m_ViewportWidth) : static_cast<float>(frameBuffer->GetSpecification().Width);
-		viewport.height = (m_ViewportHeight > 0) ? static_cast<float>(m_ViewportHeight) : static_cast<float>(frameBuffer->GetSpecification().Height);
-		viewport.width = std::min(viewport.width, static_cast<float>(frameBuffer->GetSpecification().Width));
-		viewport.height = std::min(viewport.height, static_cast<float>(frameBuffer->GetSpecification().Height));
-		viewport.minDepth = 0.0f;
-		viewport.maxDepth = 1.0f;
-		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-
-		VkRect2D scissor{};
-		scissor.offset = { static_cast<int32_t>(m_ViewportX), static_cast<int32_t>(m_ViewportY) };
-		scissor.extent.width = static_cast<uint32_t>(viewport.width);
-		scissor.extent.height = static_cast<uint32_t>(viewport.height);
-		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-		const std::array<VkBuffer, 1> vertexBuffersVk = { vkVertexBuffer->GetBuffer() };
-		const std::array<VkDeviceSize, 1> offsets = { 0 };
-		vkCmdBindVertexBuffers(commandBuffer, 0, static_cast<uint32_t>(vertexBuffersVk.size()), vertexBuffersVk.data(), offsets.data());
-		vkCmdBindIndexBuffer(commandBuffer, vkIndexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
-
-		if (!descriptorSets.empty())
-		{
-			vkCmdBindDescriptorSets(
-				commandBuffer,
-				VK_PIPELINE_BIND_POINT_GRAPHICS,
-				shader->GetPipelineLayout(),
-				0,
-				static_cast<uint32_t>(descriptorSets.size()),
-				descriptorSets.data(),
-				0,
-				nullptr);
+			pipelineCache.emplace(shader, pipeline);
 		}
 
-		const auto& pushConstantRanges = shader->GetPushConstantRanges();
-		const auto& pushConstantData = shader->GetPushConstantData();
-		for (const auto& range : pushConstantRanges)
-		{
-			if (range.offset >= pushConstantData.size())
-				continue;
+		RecordedDraw dispatch{};
+		dispatch.Shader = shader;
+		CaptureDrawResources(context, dispatch);
 
-			const uint32_t availableSize = static_cast<uint32_t>(pushConstantData.size() - range.offset);
-			const uint32_t pushSize = std::min(range.size, availableSize);
-			if (pushSize == 0)
-				continue;
+		if (m_ThreadStates.empty())
+			m_ThreadStates.resize(1);
 
-			vkCmdPushConstants(
-				commandBuffer,
-				shader->GetPipelineLayout(),
-				range.stageFlags,
-				range.offset,
-				pushSize,
-				pushConstantData.data() + range.offset);
-		}
+		const VkCommandBuffer frameCommandBuffer = context->GetActiveFrameCommandBuffer();
+		DescriptorSetList descriptorSets;
+		if (AcquireDescriptorSets(
+			context,
+			m_ThreadStates[0],
+			shader,
+			m_PendingBindings.data() + dispatch.BindingOffset,
+			dispatch.BindingCount,
+			frameCommandBuffer != VK_NULL_HANDLE,
+			descriptorSets))
+		{
+			const VkCommandBuffer commandBuffer = (frameCommandBuffer != VK_NULL_HANDLE) ? frameCommandBuffer : context->BeginSingleTimeCommands();
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+			if (!descriptorSets.empty())
+			{
+				vkCmdBindDescriptorSets(
+					commandBuffer,
+					VK_PIPELINE_BIND_POINT_COMPUTE,
+					shader->GetPipelineLayout(),
+					0,
+					static_cast<uint32_t>(descriptorSets.size()),
+					descriptorSets.data(),
+					dispatch.DynamicOffsetCount,
+					dispatch.DynamicOffsetCount > 0 ? m_PendingDynamicOffsets.data() + dispatch.DynamicOffsetOffset : nullptr);
+			}
 
-			vkCmdDrawIndexed(commandBuffer, vkIndexBuffer->GetCount(), 1, 0, 0, 0);
-			if (ownsCommandBuffer)
+			const uint8_t* pushConstantData = m_PendingPushConstants.data() + dispatch.PushConstantOffset;
+			for (const auto& range : shader->GetPushConstantRanges())
 			{
-				vkCmdEndRendering(commandBuffer);
-				frameBuffer->FinalizeAfterRendering(commandBuffer);
+				if (range.offset >= dispatch.PushConstantSize)
+					continue;
+
+				const uint32_t pushSize = std::min(range.size, dispatch.PushConstantSize - range.offset);
+				if (pushSize > 0)
+					vkCmdPushConstants(commandBuffer, shader->GetPipelineLayout(), range.stageFlags, range.offset, pushSize, pushConstantData + range.offset);
 			}
+
+			vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+
+			VkMemoryBarrier2 barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+			barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+			barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+			barrier.dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+				VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+				VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+				VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+				VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+			barrier.dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+				VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+				VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+				VK_ACCESS_2_TRANSFER_READ_BIT;
+
+			VkDependencyInfo dependencyInfo{};
+			dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+			dependencyInfo.memoryBarrierCount = 1;
+			dependencyInfo.pMemoryBarriers = &barrier;
+			vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+			if (frameCommandBuffer == VK_NULL_HANDLE)
+				context->EndSingleTimeCommands(commandBuffer);
+			else
+				++GetCurrentRecordingStats(context->GetFrameNumber()).Dispatches;
 		}
-		if (ownsCommandBuffer)
-			context->EndSingleTimeCommands(commandBuffer);
 
+		m_PendingBindings.clear();
+		m_PendingPushConstants.clear();
+		m_PendingDynamicOffsets.clear();
 	}
 
 	void VulkanRendererAPI::SetState(RenderState state, bool on)
@@ -1016,14 +1657,127 @@ namespace Syndra {
 
 	void VulkanRendererAPI::Flush()
 	{
-		if (m_ActiveRenderingCommandBuffer == VK_NULL_HANDLE || m_ActiveRenderingFrameBuffer == nullptr)
+		if (m_PendingDraws.empty() || m_PendingFrameBuffer == nullptr)
+		{
+			m_PendingFrameBuffer = nullptr;
 			return;
+		}
 
 		SN_PROFILE_SCOPE("VulkanRendererAPI::Flush");
-		vkCmdEndRendering(m_ActiveRenderingCommandBuffer);
-		m_ActiveRenderingFrameBuffer->FinalizeAfterRendering(m_ActiveRenderingCommandBuffer);
-		m_ActiveRenderingCommandBuffer = VK_NULL_HANDLE;
-		m_ActiveRenderingFrameBuffer = nullptr;
+		VulkanContext* context = VulkanContext::GetCurrent();
+		const VkCommandBuffer commandBuffer = (context != nullptr) ? context->GetActiveFrameCommandBuffer() : VK_NULL_HANDLE;
+		if (commandBuffer == VK_NULL_HANDLE)
+		{
+			SN_CORE_WARN("Dropping {} Vulkan draws that were not flushed before the frame ended.", m_PendingDraws.size());
+		}
+		else
+		{
+			const auto recordStart = std::chrono::steady_clock::now();
+			const RecordingSettings& settings = GetRecordingSettings();
+			RecordingStats& stats = GetCurrentRecordingStats(context->GetFrameNumber());
+
+			const uint32_t drawCount = static_cast<uint32_t>(m_PendingDraws.size());
+			const uint32_t threadCount = JobSystem::GetWorkerCount() + 1;
+			if (m_ThreadStates.size() < threadCount)
+				m_ThreadStates.resize(threadCount);
+
+			VulkanFrameBuffer* frameBuffer = m_PendingFrameBuffer;
+			frameBuffer->PrepareForRendering(commandBuffer);
+
+			const bool parallel = settings.ParallelRecording && JobSystem::IsInitialized() && drawCount >= kParallelRecordingMinDraws;
+			if (parallel)
+			{
+				// A couple of chunks per thread, so that stealing evens out chunks with expensive materials.
+				const uint32_t chunkSize = std::max(kParallelRecordingMinChunkDraws, drawCount / (threadCount * 2));
+				const uint32_t chunkCount = (drawCount + chunkSize - 1) / chunkSize;
+				m_SecondaryCommandBuffers.assign(chunkCount, VK_NULL_HANDLE);
+
+				std::vector<VkFormat> colorAttachmentFormats;
+				colorAttachmentFormats.reserve(frameBuffer->GetColorAttachmentCount());
+				for (uint32_t i = 0; i < frameBuffer->GetColorAttachmentCount(); ++i)
+					colorAttachmentFormats.push_back(frameBuffer->GetColorAttachmentFormat(i));
+
+				VkCommandBufferInheritanceRenderingInfo renderingInheritance{};
+				renderingInheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+				renderingInheritance.colorAttachmentCount = static_cast<uint32_t>(colorAttachmentFormats.size());
+				renderingInheritance.pColorAttachmentFormats = colorAttachmentFormats.empty() ? nullptr : colorAttachmentFormats.data();
+				renderingInheritance.depthAttachmentFormat = frameBuffer->HasDepthImage() ? frameBuffer->GetDepthAttachmentFormat() : VK_FORMAT_UNDEFINED;
+				renderingInheritance.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+				renderingInheritance.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+				VkCommandBufferInheritanceInfo inheritanceInfo{};
+				inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+				inheritanceInfo.pNext = &renderingInheritance;
+
+				VkCommandBufferBeginInfo beginInfo{};
+				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+				beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+				JobSystem::ParallelFor("VulkanRendererAPI::RecordSecondary", drawCount, chunkSize, [&](uint32_t begin, uint32_t end)
+				{
+					RecordingThreadState& threadState = m_ThreadStates[JobSystem::GetThreadIndex()];
+					VkCommandBuffer secondaryCommandBuffer = AcquireSecondaryCommandBuffer(context, threadState);
+					if (secondaryCommandBuffer == VK_NULL_HANDLE)
+						return;
+					if (vkBeginCommandBuffer(secondaryCommandBuffer, &beginInfo) != VK_SUCCESS)
+						return;
+
+					RecordDraws(context, threadState, secondaryCommandBuffer, begin, end);
+					if (vkEndCommandBuffer(secondaryCommandBuffer) == VK_SUCCESS)
+						m_SecondaryCommandBuffers[begin / chunkSize] = secondaryCommandBuffer;
+				});
+
+				m_SecondaryCommandBuffers.erase(
+					std::remove(m_SecondaryCommandBuffers.begin(), m_SecondaryCommandBuffers.end(), VK_NULL_HANDLE),
+					m_SecondaryCommandBuffers.end());
+				if (m_SecondaryCommandBuffers.size() != chunkCount)
+					SN_CORE_WARN("Failed to record {} of {} Vulkan secondary command buffers.", chunkCount - m_SecondaryCommandBuffers.size(), chunkCount);
+
+				BeginDynamicRendering(commandBuffer, frameBuffer, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT);
+				if (!m_SecondaryCommandBuffers.empty())
+					vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(m_SecondaryCommandBuffers.size()), m_SecondaryCommandBuffers.data());
+
+				++stats.ParallelBatches;
+				stats.SecondaryCommandBuffers += static_cast<uint32_t>(m_SecondaryCommandBuffers.size());
+			}
+			else
+			{
+				BeginDynamicRendering(commandBuffer, frameBuffer);
+				RecordDraws(context, m_ThreadStates[0], commandBuffer, 0, drawCount);
+			}
+
+			vkCmdEndRendering(commandBuffer);
+			frameBuffer->FinalizeAfterRendering(commandBuffer);
+
+			++stats.Batches;
+			stats.UniformBytes = m_UniformAllocator.GetFrameUsage();
+			stats.DescriptorSetAllocations += m_DescriptorSetAllocations.exchange(0, std::memory_order_relaxed);
+			stats.Draws += drawCount;
+			stats.RecordMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recordStart).count();
+		}
+
+		m_PendingFrameBuffer = nullptr;
+		m_PendingDraws.clear();
+		m_PendingBindings.clear();
+		m_PendingPushConstants.clear();
+		m_PendingDynamicOffsets.clear();
+		m_SecondaryCommandBuffers.clear();
+	}
+
+	void VulkanRendererAPI::SetParallelRecording(bool enabled)
+	{
+		GetRecordingSettings().ParallelRecording = enabled;
+	}
+
+	bool VulkanRendererAPI::IsParallelRecordingEnabled()
+	{
+		return GetRecordingSettings().ParallelRecording;
+	}
+
+	VulkanRendererAPI::RecordingStats VulkanRendererAPI::GetRecordingStats()
+	{
+		return GetRecordingSettings().Last;
 	}
 
 	void VulkanRendererAPI::WaitForIdle()
@@ -1059,4 +1813,15 @@ namespace Syndra {
 		return info.str();
 	}
 
+	bool VulkanRendererAPI::GetMemoryInfo(GPUMemoryInfo& outInfo)
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context == nullptr || context->GetAllocator() == nullptr)
+			return false;
+
+		context->GetDeviceLocalMemoryBudget(outInfo.Usage, outInfo.Budget);
+		context->GetAllocatorStatistics(outInfo.AllocationBytes, outInfo.BlockBytes);
+		return outInfo.Budget > 0;
+	}
+
 }
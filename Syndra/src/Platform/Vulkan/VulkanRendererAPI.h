@@ -1,12 +1,17 @@
 #pragma once
 
+#include "Engine/Core/FrameAllocator.h"
 #include "Engine/Renderer/RendererAPI.h"
 #include "Engine/Renderer/Texture.h"
 #include "Engine/Renderer/UniformBuffer.h"
+#include "Platform/Vulkan/VulkanDrawPacket.h"
+#include "Platform/Vulkan/VulkanUniformAllocator.h"
 
 #include <volk.h>
 
+#include <atomic>
 #include <limits>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -15,6 +20,7 @@ namespace Syndra {
 	class VulkanContext;
 	class VulkanFrameBuffer;
 	class VulkanShader;
+	class VulkanUniformBuffer;
 
 	class VulkanRendererAPI : public RendererAPI
 	{
@@ -29,11 +35,66 @@ public:
 		void Flush() override;
 		void WaitForIdle() override;
 		std::string GetRendererInfo() override;
+		bool GetMemoryInfo(GPUMemoryInfo& outInfo) override;
 
 		static void InvalidateAllGraphicsPipelines();
 		static void InvalidateShaderPipelines(const VulkanShader* shader);
 
+		struct RecordingStats
+		{
+			uint32_t Draws = 0;
+			uint32_t Batches = 0;				// Flush() calls that recorded draws
+			uint32_t ParallelBatches = 0;		// of those, recorded into secondary command buffers
+			uint32_t SecondaryCommandBuffers = 0;
+			uint32_t PacketDraws = 0;			// draws submitted from retained draw packets
+			uint32_t PacketBuilds = 0;
+			uint32_t IndirectDraws = 0;			// vkCmdDrawIndexedIndirectCount calls
+			uint32_t Dispatches = 0;			// compute dispatches
+			uint64_t UniformBytes = 0;			// constants uploaded to the uniform ring
+			uint32_t DescriptorSetAllocations = 0;	// sets allocated for draws and packets
+			double RecordMs = 0.0;				// CPU time spent in Flush() recording the batches
+		};
+
+		// Draws inside a frame are captured by DrawIndexed() and recorded when the pass is flushed.
+		// Batches of at least kParallelRecordingMinDraws draws are split into chunks that JobSystem
+		// workers record into secondary command buffers, using per-thread command and descriptor
+		// pools; the primary buffer executes them in submission order.
+		static void SetParallelRecording(bool enabled);
+		static bool IsParallelRecordingEnabled();
+		// Totals of the last completed frame.
+		static RecordingStats GetRecordingStats();
+
+		// Resolves the bound shader, framebuffer, render state and resources for vertexArray into
+		// packet, allocating its descriptor sets from a persistent pool. Returns false (leaving the
+		// packet invalid) when the draw could not be resolved or no frame is being recorded.
+		bool BuildDrawPacket(const Ref<VertexArray>& vertexArray, VulkanDrawPacket& packet);
+		// Queues a packet into the current batch without touching any bound state. Only valid inside
+		// a frame; returns false when the packet is stale or cannot be submitted.
+		bool SubmitDrawPacket(const VulkanDrawPacket& packet);
+
+		// Queues an indirect draw of vertexArray's pool buffers with the bound shader, framebuffer and
+		// resources: up to maxDrawCount VkDrawIndexedIndirectCommand records are read from drawBuffer,
+		// and the number actually drawn from the uint32_t at countOffset in countBuffer. Only valid
+		// inside a frame on devices where VulkanContext::SupportsIndirectDrawCount() is true.
+		bool DrawIndexedIndirectCount(
+			const Ref<VertexArray>& vertexArray,
+			VkBuffer drawBuffer,
+			VkDeviceSize drawOffset,
+			VkBuffer countBuffer,
+			VkDeviceSize countOffset,
+			uint32_t maxDrawCount);
+		// Flushes the pending batch, records a dispatch of shader with the currently bound resources
+		// and makes its storage writes visible to indirect, vertex, fragment, compute and transfer reads.
+		void DispatchCompute(const VulkanShader* shader, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+
+		static VulkanRendererAPI* GetCurrent() { return s_CurrentRendererAPI; }
+
 	private:
+		// Scratch for recording a draw or dispatch, in frame memory.
+		using DescriptorSetList = FrameVector<VkDescriptorSet>;
+		using DescriptorTypeCounts = std::unordered_map<VkDescriptorType, uint32_t, std::hash<VkDescriptorType>, std::equal_to<VkDescriptorType>,
+			FrameStlAllocator<std::pair<const VkDescriptorType, uint32_t>>>;
+
 		struct TransientDescriptorPoolState
 		{
 			VkDescriptorPool Pool = VK_NULL_HANDLE;
@@ -53,6 +114,10 @@ public:
 			VkSampler Sampler = VK_NULL_HANDLE;
 			VkImageView ImageView = VK_NULL_HANDLE;
 			VkImageLayout ImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			// Dynamic uniform buffers only: where the slice starts. Bound with the sets, so not part of
+			// the descriptor contents compared below.
+			uint32_t DynamicOffset = 0;
+			VulkanUniformBuffer* UniformBuffer = nullptr;
 
 			bool operator==(const DescriptorBindingEntry& other) const
 			{
@@ -105,13 +170,87 @@ public:
 			}
 		};
 
+		struct SecondaryCommandPool
+		{
+			VkCommandPool Pool = VK_NULL_HANDLE;
+			std::vector<VkCommandBuffer> CommandBuffers;
+			uint32_t UsedCommandBuffers = 0;
+			uint64_t FrameSerial = std::numeric_limits<uint64_t>::max();
+		};
+
+		// Owned by one thread (see JobSystem::GetThreadIndex); indexed by frame in flight.
+		struct RecordingThreadState
+		{
+			std::vector<TransientDescriptorPoolState> DescriptorPools;
+			std::vector<std::unordered_map<DescriptorSetCacheKey, std::vector<VkDescriptorSet>, DescriptorSetCacheKeyHasher>> DescriptorSetCache;
+			uint64_t LastDescriptorFrameSerial = std::numeric_limits<uint64_t>::max();
+			std::vector<SecondaryCommandPool> CommandPools;
+			DescriptorSetCacheKey LookupKey;
+		};
+
+		// A draw captured by DrawIndexed(); bindings and push constants live in the pending arrays.
+		struct RecordedDraw
+		{
+			const VulkanShader* Shader = nullptr;
+			VkPipeline Pipeline = VK_NULL_HANDLE;
+			VkBuffer VertexBuffer = VK_NULL_HANDLE;
+			VkBuffer IndexBuffer = VK_NULL_HANDLE;
+			uint32_t IndexCount = 0;
+			// Where the mesh lives in the shared geometry pool buffers.
+			int32_t VertexOffset = 0;
+			uint32_t FirstIndex = 0;
+			VkViewport Viewport{};
+			VkRect2D Scissor{};
+			uint32_t BindingOffset = 0;
+			uint32_t BindingCount = 0;
+			uint32_t PushConstantOffset = 0;
+			uint32_t PushConstantSize = 0;
+			uint32_t DynamicOffsetOffset = 0;
+			uint32_t DynamicOffsetCount = 0;
+			// Set for draws submitted from a draw packet, which owns its descriptor sets.
+			const VkDescriptorSet* DescriptorSets = nullptr;
+			uint32_t DescriptorSetCount = 0;
+			// Set for indirect draws, which read their commands and count from these buffers.
+			VkBuffer IndirectBuffer = VK_NULL_HANDLE;
+			VkDeviceSize IndirectOffset = 0;
+			VkBuffer CountBuffer = VK_NULL_HANDLE;
+			VkDeviceSize CountOffset = 0;
+			uint32_t MaxDrawCount = 0;
+		};
+
+		bool ResolveDraw(VulkanContext* context, const Ref<VertexArray>& vertexArray, VulkanFrameBuffer*& outFrameBuffer, RecordedDraw& outDraw);
+		void ResolveBindings(VulkanContext* context, const VulkanShader* shader, std::vector<DescriptorBindingEntry>& outBindings);
+		// Appends draw's bindings, dynamic offsets and push constants to the pending arrays.
+		void CaptureDrawResources(VulkanContext* context, RecordedDraw& draw);
+		static void WriteDescriptorSets(VkDevice device, const DescriptorBindingEntry* bindings, uint32_t bindingCount, const VkDescriptorSet* descriptorSets, uint32_t descriptorSetCount);
+		bool AllocatePacketDescriptorSets(VulkanContext* context, const VulkanShader* shader, VulkanDrawPacket& packet);
+
 		bool EnsureTransientDescriptorPool(
 			VulkanContext* context,
+			RecordingThreadState& threadState,
 			uint32_t frameIndex,
 			uint32_t requiredSetCount,
-			const std::unordered_map<VkDescriptorType, uint32_t>& requiredDescriptorCounts,
+			const DescriptorTypeCounts& requiredDescriptorCounts,
 			bool forceReset);
-		void DestroyTransientDescriptorPools(VkDevice device);
+		bool AcquireDescriptorSets(
+			VulkanContext* context,
+			RecordingThreadState& threadState,
+			const VulkanShader* shader,
+			const DescriptorBindingEntry* bindings,
+			uint32_t bindingCount,
+			bool frameScoped,
+			DescriptorSetList& outDescriptorSets);
+		VkCommandBuffer AcquireSecondaryCommandBuffer(VulkanContext* context, RecordingThreadState& threadState);
+		void RecordDraws(VulkanContext* context, RecordingThreadState& threadState, VkCommandBuffer commandBuffer, uint32_t begin, uint32_t end);
+		void RecordDraw(
+			VkCommandBuffer commandBuffer,
+			const RecordedDraw& draw,
+			const VkDescriptorSet* descriptorSets,
+			uint32_t descriptorSetCount,
+			const uint32_t* dynamicOffsets,
+			const uint8_t* pushConstantData,
+			const RecordedDraw* previousDraw = nullptr);
+		void DestroyRecordingResources(VkDevice device);
 
 	private:
 		glm::vec4 m_ClearColor = { 0.07f, 0.07f, 0.09f, 1.0f };
@@ -126,12 +265,22 @@ public:
 
 		Ref<Texture2D> m_FallbackTexture;
 		Ref<UniformBuffer> m_FallbackUniformBuffer;
-		std::vector<TransientDescriptorPoolState> m_TransientDescriptorPools;
-		std::vector<std::unordered_map<DescriptorSetCacheKey, std::vector<VkDescriptorSet>, DescriptorSetCacheKeyHasher>> m_DescriptorSetCache;
-		uint64_t m_LastDescriptorPoolFrameSerial = std::numeric_limits<uint64_t>::max();
-		uint64_t m_LastDescriptorCacheFrameSerial = std::numeric_limits<uint64_t>::max();
-		VkCommandBuffer m_ActiveRenderingCommandBuffer = VK_NULL_HANDLE;
-		VulkanFrameBuffer* m_ActiveRenderingFrameBuffer = nullptr;
+		// Index 0 belongs to the main thread, which also records everything outside parallel batches.
+		std::vector<RecordingThreadState> m_ThreadStates;
+
+		VulkanFrameBuffer* m_PendingFrameBuffer = nullptr;
+		std::vector<RecordedDraw> m_PendingDraws;
+		std::vector<DescriptorBindingEntry> m_PendingBindings;
+		std::vector<uint8_t> m_PendingPushConstants;
+		std::vector<uint32_t> m_PendingDynamicOffsets;
+		std::vector<VkCommandBuffer> m_SecondaryCommandBuffers;
+		// Pool that new draw packets allocate from; replaced when it runs out of space.
+		std::shared_ptr<VulkanPacketDescriptorPool> m_PacketDescriptorPool;
+		VulkanUniformAllocator m_UniformAllocator;
+		// Added by recording threads, moved into the frame's stats by Flush().
+		std::atomic<uint32_t> m_DescriptorSetAllocations{ 0 };
+
+		static VulkanRendererAPI* s_CurrentRendererAPI;
 	};
 
 }
@@ -2,6 +2,7 @@
 
 #include "Platform/Vulkan/VulkanShader.h"
 
+#include "Platform/Vulkan/VulkanBindlessTextureTable.h"
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanRendererAPI.h"
 
@@ -212,12 +213,15 @@ namespace Syndra {
 		SetPushConstantValue(name, glm::value_ptr(value), sizeof(float) * 16, PushConstantMemberType::Mat4);
 	}
 
-	void VulkanShader::DispatchCompute(uint32_t, uint32_t, uint32_t)
+	void VulkanShader::DispatchCompute(uint32_t x, uint32_t y, uint32_t z)
 	{
+		if (VulkanRendererAPI* rendererAPI = VulkanRendererAPI::GetCurrent())
+			rendererAPI->DispatchCompute(this, x, y, z);
 	}
 
 	void VulkanShader::SetMemoryBarrier(MemoryBarrierMode)
 	{
+		// VulkanRendererAPI::DispatchCompute already orders each dispatch before later reads.
 	}
 
 	void VulkanShader::Reload()
@@ -256,6 +260,12 @@ namespace Syndra {
 		VulkanRendererAPI::InvalidateShaderPipelines(this);
 		DestroyVulkanObjects();
 		CompileOrGetVulkanBinaries(shaderSources);
+
+		uint64_t binaryBytes = 0;
+		for (const auto& [stage, spirv] : m_VulkanSPIRV)
+			binaryBytes += spirv.size() * sizeof(uint32_t);
+		m_BinaryMemory.Set(binaryBytes);
+
 		Reflect();
 		CreateShaderModules();
 		BuildDescriptorSetLayoutsAndPipelineLayout();
@@ -421,6 +431,8 @@ namespace Syndra {
 		m_PushConstantRanges.clear();
 		m_PushConstantData.clear();
 		m_VertexInputLocations.clear();
+		m_BindlessTextureSet = kNoBindlessTextureSet;
+		m_BindlessTextureIndexOffsets.clear();
 
 		struct PendingBinding
 		{
@@ -464,7 +476,8 @@ namespace Syndra {
 				pending.Set = set;
 				pending.Binding = binding;
 				pending.Count = 1;
-				pending.Type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+				// Uniform data lives in per-frame ring slices whose offsets are bound with the sets.
+				pending.Type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 				pending.Stages |= stage;
 				pending.Name = resource.name;
 			}
@@ -477,6 +490,9 @@ namespace Syndra {
 				const uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
 				const uint64_t key = MakeBindingKey(set, binding);
 
+				// An unsized array at binding 0 is the bindless texture table; its set is shared.
+				const bool isBindlessTable = !type.array.empty() && type.array[0] == 0 && binding == 0;
+
 				auto& pending = bindingMap[key];
 				pending.Set = set;
 				pending.Binding = binding;
@@ -485,6 +501,12 @@ namespace Syndra {
 				pending.Stages |= stage;
 				pending.Name = resource.name;
 
+				if (isBindlessTable)
+				{
+					m_BindlessTextureSet = set;
+					continue;
+				}
+
 				m_Samplers.push_back({ resource.name, set, binding, true });
 			}
 
@@ -606,12 +628,6 @@ namespace Syndra {
 			return a.Size < b.Size;
 			});
 
-		std::sort(m_Samplers.begin(), m_Samplers.end(), [](const Sampler& a, const Sampler& b) {
-			if (a.set != b.set)
-				return a.set < b.set;
-			return a.binding < b.binding;
-			});
-
 		std::sort(m_VertexInputLocations.begin(), m_VertexInputLocations.end());
 		m_VertexInputLocations.erase(std::unique(m_VertexInputLocations.begin(), m_VertexInputLocations.end()), m_VertexInputLocations.end());
 
@@ -628,6 +644,32 @@ namespace Syndra {
 		for (size_t i = 0; i < m_PushConstantMembers.size(); ++i)
 			m_PushConstantMemberLookup[m_PushConstantMembers[i].Name] = i;
 
+		// Bindless shaders receive their textures as int push constants named <Slot>Index, in slot
+		// order. Each one becomes a logical sampler so materials keep binding textures by slot.
+		if (m_BindlessTextureSet != kNoBindlessTextureSet)
+		{
+			const std::string suffix = "Index";
+			for (const auto& member : m_PushConstantMembers)
+			{
+				if (member.Type != PushConstantMemberType::Int ||
+					member.Name.size() <= suffix.size() ||
+					member.Name.compare(member.Name.size() - suffix.size(), suffix.size(), suffix) != 0)
+				{
+					continue;
+				}
+
+				const uint32_t slot = static_cast<uint32_t>(m_BindlessTextureIndexOffsets.size());
+				m_BindlessTextureIndexOffsets.push_back(member.Offset);
+				m_Samplers.push_back({ member.Name.substr(0, member.Name.size() - suffix.size()), m_BindlessTextureSet, slot, true });
+			}
+		}
+
+		std::sort(m_Samplers.begin(), m_Samplers.end(), [](const Sampler& a, const Sampler& b) {
+			if (a.set != b.set)
+				return a.set < b.set;
+			return a.binding < b.binding;
+			});
+
 		InitializePushConstantStorage();
 	}
 
@@ -659,6 +701,14 @@ namespace Syndra {
 		m_DescriptorSetLayouts.assign(setIndices.empty() ? 0 : (maxSet + 1), VK_NULL_HANDLE);
 		for (uint32_t set = 0; set <= maxSet && !setIndices.empty(); ++set)
 		{
+			if (set == m_BindlessTextureSet)
+			{
+				SN_CORE_ASSERT(perSetBindings[set].size() == 1, "The bindless texture set of shader '{}' must hold nothing but the texture array.", m_Name);
+				m_DescriptorSetLayouts[set] = VulkanBindlessTextureTable::GetSetLayout();
+				SN_CORE_ASSERT(m_DescriptorSetLayouts[set] != VK_NULL_HANDLE, "Vulkan bindless texture table is unavailable.");
+				continue;
+			}
+
 			auto found = perSetBindings.find(set);
 			std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
 			if (found != perSetBindings.end())
@@ -745,6 +795,17 @@ namespace Syndra {
 		memcpy(m_PushConstantData.data() + member->Offset, data, size);
 	}
 
+	bool VulkanShader::TryGetPushConstantMember(const std::string& name, uint32_t& outOffset, uint32_t& outSize) const
+	{
+		const PushConstantMemberInfo* member = FindPushConstantMember(name);
+		if (member == nullptr || member->Offset + member->Size > m_PushConstantData.size())
+			return false;
+
+		outOffset = member->Offset;
+		outSize = member->Size;
+		return true;
+	}
+
 	const VulkanShader::PushConstantMemberInfo* VulkanShader::FindPushConstantMember(const std::string& name) const
 	{
 		std::string normalizedName = NormalizePushConstantName(name);
@@ -818,10 +879,11 @@ namespace Syndra {
 		}
 		m_ShaderModules.clear();
 
-		for (VkDescriptorSetLayout descriptorSetLayout : m_DescriptorSetLayouts)
+		for (uint32_t set = 0; set < m_DescriptorSetLayouts.size(); ++set)
 		{
-			if (descriptorSetLayout != VK_NULL_HANDLE)
-				vkDestroyDescriptorSetLayout(context->GetDevice(), descriptorSetLayout, nullptr);
+			// The bindless layout belongs to VulkanBindlessTextureTable.
+			if (m_DescriptorSetLayouts[set] != VK_NULL_HANDLE && set != m_BindlessTextureSet)
+				vkDestroyDescriptorSetLayout(context->GetDevice(), m_DescriptorSetLayouts[set], nullptr);
 		}
 		m_DescriptorSetLayouts.clear();
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/Shader.h"
 
 #include <volk.h>
@@ -37,6 +38,8 @@ namespace Syndra {
 			PushConstantMemberType Type = PushConstantMemberType::Unknown;
 		};
 
+		static constexpr uint32_t kNoBindlessTextureSet = UINT32_MAX;
+
 		explicit VulkanShader(const std::string& filepath);
 		VulkanShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
 		~VulkanShader() override;
@@ -67,6 +70,13 @@ namespace Syndra {
 		const std::vector<uint8_t>& GetPushConstantData() const { return m_PushConstantData; }
 		const std::vector<uint32_t>& GetVertexInputLocations() const { return m_VertexInputLocations; }
 		VkShaderModule GetShaderModule(VkShaderStageFlagBits stage) const;
+		// Byte range of a push constant member inside GetPushConstantData(), for callers that patch
+		// a retained copy of the data instead of going through the named setters every frame.
+		bool TryGetPushConstantMember(const std::string& name, uint32_t& outOffset, uint32_t& outSize) const;
+		// Set index of the shared bindless texture table, or kNoBindlessTextureSet. Texture slot i is
+		// passed as the table index at push constant offset GetBindlessTextureIndexOffsets()[i].
+		uint32_t GetBindlessTextureSet() const { return m_BindlessTextureSet; }
+		const std::vector<uint32_t>& GetBindlessTextureIndexOffsets() const { return m_BindlessTextureIndexOffsets; }
 		static const VulkanShader* GetBoundShader() { return s_BoundShader; }
 
 	private:
@@ -97,6 +107,7 @@ namespace Syndra {
 		std::string m_Name;
 
 		std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>> m_VulkanSPIRV;
+		TrackedMemory m_BinaryMemory{ MemoryDomain::Cpu, MemoryCategory::Shaders };
 		std::unordered_map<VkShaderStageFlagBits, VkShaderModule> m_ShaderModules;
 		std::vector<ReflectedBinding> m_ReflectedBindings;
 		std::vector<ReflectedPushConstantRange> m_ReflectedPushConstantRanges;
@@ -105,6 +116,8 @@ namespace Syndra {
 		std::unordered_map<std::string, size_t> m_PushConstantMemberLookup;
 		std::vector<uint8_t> m_PushConstantData;
 		std::vector<uint32_t> m_VertexInputLocations;
+		uint32_t m_BindlessTextureSet = kNoBindlessTextureSet;
+		std::vector<uint32_t> m_BindlessTextureIndexOffsets;
 
 		VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
 		std::vector<VkDescriptorSetLayout> m_DescriptorSetLayouts;
@@ -0,0 +1,117 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanStorageBuffer.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "vk_mem_alloc.h"
+
+#include <unordered_map>
+
+namespace Syndra {
+
+	namespace {
+
+		std::unordered_map<uint32_t, const VulkanStorageBuffer*>& GetStorageBufferBindings()
+		{
+			static std::unordered_map<uint32_t, const VulkanStorageBuffer*> bindings;
+			return bindings;
+		}
+
+	}
+
+	VulkanStorageBuffer::VulkanStorageBuffer(VkDeviceSize size, VkBufferUsageFlags extraUsage, bool hostVisible)
+		: m_Size(size)
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		SN_CORE_ASSERT(context != nullptr && size > 0, "Vulkan storage buffers need a context and a non-zero size.");
+
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | extraUsage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo allocationCreateInfo{};
+		if (hostVisible)
+		{
+			// Written by the CPU every frame, or read back when only transfers write it.
+			allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+			allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT |
+				(((extraUsage & VK_BUFFER_USAGE_TRANSFER_DST_BIT) != 0)
+					? VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT
+					: VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+		}
+		else
+		{
+			allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+		}
+
+		VmaAllocationInfo allocationInfo{};
+		const VkResult result = vmaCreateBuffer(context->GetAllocator(), &bufferInfo, &allocationCreateInfo, &m_Buffer, &m_Allocation, &allocationInfo);
+		SN_CORE_ASSERT(result == VK_SUCCESS, "Failed to create Vulkan storage buffer.");
+		m_GpuMemory.Set(allocationInfo.size);
+		if (hostVisible)
+			m_MappedData = allocationInfo.pMappedData;
+	}
+
+	VulkanStorageBuffer::~VulkanStorageBuffer()
+	{
+		auto& bindings = GetStorageBufferBindings();
+		for (auto iterator = bindings.begin(); iterator != bindings.end();)
+		{
+			if (iterator->second == this)
+				iterator = bindings.erase(iterator);
+			else
+				++iterator;
+		}
+
+		VulkanContext* context = VulkanContext::GetCurrent();
+		if (context != nullptr && context->GetAllocator() != nullptr && m_Buffer != VK_NULL_HANDLE)
+		{
+			context->DeferRelease([allocator = context->GetAllocator(), buffer = m_Buffer, allocation = m_Allocation]()
+			{
+				vmaDestroyBuffer(allocator, buffer, allocation);
+			});
+		}
+
+		m_Buffer = VK_NULL_HANDLE;
+		m_Allocation = nullptr;
+		m_MappedData = nullptr;
+	}
+
+	void VulkanStorageBuffer::FlushMappedRange(VkDeviceSize offset, VkDeviceSize size) const
+	{
+		if (m_MappedData == nullptr || size == 0)
+			return;
+
+		if (VulkanContext* context = VulkanContext::GetCurrent())
+			vmaFlushAllocation(context->GetAllocator(), m_Allocation, offset, size);
+	}
+
+	void VulkanStorageBuffer::InvalidateMappedRange(VkDeviceSize offset, VkDeviceSize size) const
+	{
+		if (m_MappedData == nullptr || size == 0)
+			return;
+
+		if (VulkanContext* context = VulkanContext::GetCurrent())
+			vmaInvalidateAllocation(context->GetAllocator(), m_Allocation, offset, size);
+	}
+
+	void VulkanStorageBuffer::Bind(uint32_t binding) const
+	{
+		GetStorageBufferBindings()[binding] = this;
+	}
+
+	void VulkanStorageBuffer::Unbind(uint32_t binding)
+	{
+		GetStorageBufferBindings().erase(binding);
+	}
+
+	const VulkanStorageBuffer* VulkanStorageBuffer::GetBoundBuffer(uint32_t binding)
+	{
+		const auto& bindings = GetStorageBufferBindings();
+		const auto iterator = bindings.find(binding);
+		return (iterator != bindings.end()) ? iterator->second : nullptr;
+	}
+
+}
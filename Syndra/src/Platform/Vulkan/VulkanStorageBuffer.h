@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Engine/Core/MemoryTracker.h"
+
+#include <volk.h>
+
+#include <cstdint>
+
+struct VmaAllocation_T;
+
+namespace Syndra {
+
+	using VmaAllocation = VmaAllocation_T*;
+
+	// A shader storage buffer, either persistently mapped for data the CPU rewrites every frame or
+	// device-local for data only the GPU writes. Like uniform buffers, storage buffers are bound to
+	// a binding number: any shader that declares a storage block at that binding reads the buffer
+	// bound there when its draw or dispatch is captured. Destruction waits for the frames in flight.
+	class VulkanStorageBuffer
+	{
+	public:
+		VulkanStorageBuffer(VkDeviceSize size, VkBufferUsageFlags extraUsage, bool hostVisible);
+		~VulkanStorageBuffer();
+
+		VulkanStorageBuffer(const VulkanStorageBuffer&) = delete;
+		VulkanStorageBuffer& operator=(const VulkanStorageBuffer&) = delete;
+
+		VkBuffer GetBuffer() const { return m_Buffer; }
+		VkDeviceSize GetSize() const { return m_Size; }
+		// Null for device-local buffers.
+		void* GetMappedData() const { return m_MappedData; }
+		// Makes host writes to a mapped buffer visible to the device.
+		void FlushMappedRange(VkDeviceSize offset, VkDeviceSize size) const;
+		// Makes device writes to a mapped buffer visible to the host.
+		void InvalidateMappedRange(VkDeviceSize offset, VkDeviceSize size) const;
+
+		void Bind(uint32_t binding) const;
+		static void Unbind(uint32_t binding);
+		static const VulkanStorageBuffer* GetBoundBuffer(uint32_t binding);
+
+	private:
+		VkBuffer m_Buffer = VK_NULL_HANDLE;
+		VmaAllocation m_Allocation = nullptr;
+		void* m_MappedData = nullptr;
+		VkDeviceSize m_Size = 0;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::StorageBuffers };
+	};
+
+}
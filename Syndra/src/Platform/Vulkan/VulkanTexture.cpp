@@ -2,6 +2,7 @@
 
 #include "Platform/Vulkan/VulkanTexture.h"
 
+#include "Platform/Vulkan/VulkanBindlessTextureTable.h"
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanImGuiTextureRegistry.h"
 #include "stb_image.h"
@@ -47,12 +48,32 @@ namespace {
 		}
 	}
 
+	VkFormat PickCookedTextureFormat(Syndra::TextureCompression compression, bool sRGB)
+	{
+		switch (compression)
+		{
+		case Syndra::TextureCompression::BC1: return sRGB ? VK_FORMAT_BC1_RGBA_SRGB_BLOCK : VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case Syndra::TextureCompression::BC3: return sRGB ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+		case Syndra::TextureCompression::BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+		case Syndra::TextureCompression::BC7: return sRGB ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+		default:                              return PickTextureFormat(sRGB);
+		}
+	}
+
 	uint32_t CalculateMipLevels(uint32_t width, uint32_t height)
 	{
 		const uint32_t maxDimension = std::max(width, height);
 		return static_cast<uint32_t>(std::floor(std::log2(static_cast<float>(std::max(1u, maxDimension))))) + 1;
 	}
 
+	uint64_t CalculateMipChainSize(uint32_t width, uint32_t height, uint32_t levels, uint32_t bytesPerPixel)
+	{
+		uint64_t size = 0;
+		for (uint32_t level = 0; level < levels; ++level)
+			size += static_cast<uint64_t>(std::max(1u, width >> level)) * std::max(1u, height >> level) * bytesPerPixel;
+		return size;
+	}
+
 	void CmdImageBarrier(
 		VkCommandBuffer commandBuffer,
 		VkImage image,
@@ -280,6 +301,7 @@ namespace {
 			&mappedInfo);
 		SN_CORE_ASSERT(stagingResult == VK_SUCCESS, "Failed to create Vulkan staging buffer.");
 		SN_CORE_ASSERT(mappedInfo.pMappedData != nullptr, "Staging allocation must be mapped.");
+		const Syndra::TrackedMemory stagingMemory(Syndra::MemoryDomain::Gpu, Syndra::MemoryCategory::Staging, mappedInfo.size);
 		memcpy(mappedInfo.pMappedData, data, static_cast<size_t>(dataSize));
 		vmaFlushAllocation(context->GetAllocator(), stagingAllocation, 0, dataSize);
 
@@ -309,6 +331,79 @@ namespace {
 		vmaDestroyBuffer(context->GetAllocator(), stagingBuffer, stagingAllocation);
 	}
 
+	// Uploads the whole mip chain through a single staging buffer and submission.
+	void UploadCookedLevels(
+		Syndra::VulkanContext* context,
+		VkImage image,
+		const Syndra::CookedTexture& cookedTexture)
+	{
+		SN_CORE_ASSERT(context != nullptr, "Vulkan context is required for image upload.");
+
+		const VkDeviceSize totalSize = static_cast<VkDeviceSize>(cookedTexture.GetSizeInBytes());
+		SN_CORE_ASSERT(totalSize > 0, "Cooked texture upload size must be greater than zero.");
+
+		VkBuffer stagingBuffer = VK_NULL_HANDLE;
+		VmaAllocation stagingAllocation = nullptr;
+
+		VkBufferCreateInfo stagingBufferInfo{};
+		stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		stagingBufferInfo.size = totalSize;
+		stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		stagingBufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo stagingAllocationInfo{};
+		stagingAllocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+		stagingAllocationInfo.flags =
+			VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+			VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		VmaAllocationInfo mappedInfo{};
+		const VkResult stagingResult = vmaCreateBuffer(
+			context->GetAllocator(),
+			&stagingBufferInfo,
+			&stagingAllocationInfo,
+			&stagingBuffer,
+			&stagingAllocation,
+			&mappedInfo);
+		SN_CORE_ASSERT(stagingResult == VK_SUCCESS, "Failed to create Vulkan staging buffer.");
+		SN_CORE_ASSERT(mappedInfo.pMappedData != nullptr, "Staging allocation must be mapped.");
+		const Syndra::TrackedMemory stagingMemory(Syndra::MemoryDomain::Gpu, Syndra::MemoryCategory::Staging, mappedInfo.size);
+
+		std::vector<VkBufferImageCopy> regions;
+		regions.reserve(cookedTexture.Levels.size());
+		VkDeviceSize offset = 0;
+		for (uint32_t mip = 0; mip < static_cast<uint32_t>(cookedTexture.Levels.size()); ++mip)
+		{
+			const Syndra::CookedTextureLevel& level = cookedTexture.Levels[mip];
+			memcpy(static_cast<uint8_t*>(mappedInfo.pMappedData) + offset, level.Data.data(), level.Data.size());
+
+			VkBufferImageCopy region{};
+			region.bufferOffset = offset;
+			region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			region.imageSubresource.mipLevel = mip;
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = 1;
+			region.imageOffset = { 0, 0, 0 };
+			region.imageExtent = { level.Width, level.Height, 1 };
+			regions.push_back(region);
+
+			offset += level.Data.size();
+		}
+		vmaFlushAllocation(context->GetAllocator(), stagingAllocation, 0, totalSize);
+
+		const VkCommandBuffer commandBuffer = context->BeginSingleTimeCommands();
+		vkCmdCopyBufferToImage(
+			commandBuffer,
+			stagingBuffer,
+			image,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			static_cast<uint32_t>(regions.size()),
+			regions.data());
+		context->EndSingleTimeCommands(commandBuffer);
+
+		vmaDestroyBuffer(context->GetAllocator(), stagingBuffer, stagingAllocation);
+	}
+
 }
 
 namespace Syndra {
@@ -405,6 +500,13 @@ namespace Syndra {
 		CreateTextureResources(PickTextureFormat(sRGB), data, dataSize);
 	}
 
+	VulkanTexture2D::VulkanTexture2D(const std::string& path, const CookedTexture& cookedTexture)
+		: m_Path(path), m_Width(cookedTexture.Width), m_Height(cookedTexture.Height), m_RendererID(AllocateTextureRendererID())
+	{
+		SN_CORE_ASSERT(cookedTexture.IsValid(), "VulkanTexture2D requires a valid cooked texture.");
+		CreateCookedTextureResources(cookedTexture);
+	}
+
 	VulkanTexture2D::~VulkanTexture2D()
 	{
 		DestroyTextureResources();
@@ -415,6 +517,12 @@ namespace Syndra {
 		if (data == nullptr || size == 0)
 			return;
 
+		if (m_Compressed || m_FirstResidentLevel != 0)
+		{
+			SN_CORE_WARN("VulkanTexture2D::SetData is not supported for block-compressed or streamed texture '{}'.", m_Path);
+			return;
+		}
+
 		const uint32_t expectedSize = m_Width * m_Height * FormatBytesPerPixel(m_Format);
 		SN_CORE_ASSERT(size == expectedSize, "VulkanTexture2D::SetData requires the full texture data.");
 
@@ -496,6 +604,12 @@ namespace Syndra {
 		GetBoundTextureSlots().clear();
 	}
 
+	bool VulkanTexture2D::SupportsBlockCompression()
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		return context != nullptr && context->SupportsTextureCompressionBC();
+	}
+
 	void VulkanTexture2D::CreateTextureResources(VkFormat format, const void* initialData, uint32_t dataSize)
 	{
 		DestroyTextureResources();
@@ -521,6 +635,7 @@ namespace Syndra {
 			SN_CORE_WARN("Texture '{}' uses a single mip level because format {} does not support blit mip generation.",
 				m_Path.empty() ? "<generated>" : m_Path,
 				static_cast<uint32_t>(format));
+		m_TotalMipLevels = m_MipLevels;
 
 		VkImageCreateInfo imageInfo{};
 		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -552,6 +667,8 @@ namespace Syndra {
 			&m_Allocation,
 			nullptr);
 		SN_CORE_ASSERT(imageResult == VK_SUCCESS, "Failed to create Vulkan texture image.");
+		m_GpuMemory.Set(context->GetAllocationSize(m_Allocation));
+		m_SizeInBytes = CalculateMipChainSize(m_Width, m_Height, m_MipLevels, FormatBytesPerPixel(format));
 
 		VkImageViewCreateInfo viewInfo{};
 		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -628,11 +745,175 @@ namespace Syndra {
 		}
 
 		VulkanImGuiTextureRegistry::RegisterTexture(m_RendererID, m_Sampler, m_ImageView, m_ImageLayout);
+		VulkanBindlessTextureTable::Register(m_RendererID, m_Sampler, m_ImageView);
+	}
+
+	void VulkanTexture2D::CreateCookedTextureResources(const CookedTexture& cookedTexture)
+	{
+		DestroyTextureResources();
+
+		VulkanContext* context = VulkanContext::GetCurrent();
+		SN_CORE_ASSERT(context != nullptr, "Vulkan context is required for texture creation.");
+
+		m_Format = PickCookedTextureFormat(cookedTexture.Compression, cookedTexture.SRGB);
+		m_Compressed = cookedTexture.IsCompressed();
+		m_Streamable = !cookedTexture.CachePath.empty();
+		m_TotalMipLevels = cookedTexture.GetLevelCount();
+
+		VkFormatProperties formatProperties{};
+		vkGetPhysicalDeviceFormatProperties(context->GetPhysicalDevice(), m_Format, &formatProperties);
+		const bool canLinearFilter = (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0;
+
+		CreateCookedImage(cookedTexture, m_Image, m_Allocation, m_ImageView);
+		m_GpuMemory.Set(context->GetAllocationSize(m_Allocation));
+		m_ImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		m_MipLevels = static_cast<uint32_t>(cookedTexture.Levels.size());
+		m_FirstResidentLevel = cookedTexture.FirstLevel;
+		m_SizeInBytes = cookedTexture.GetSizeInBytes();
+
+		VkSamplerCreateInfo samplerInfo{};
+		samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerInfo.magFilter = canLinearFilter ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+		samplerInfo.minFilter = canLinearFilter ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+		samplerInfo.mipmapMode = canLinearFilter ? VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		samplerInfo.mipLodBias = 0.0f;
+		samplerInfo.maxAnisotropy = 1.0f;
+		samplerInfo.minLod = 0.0f;
+		// The view's level count changes while streaming, so let it clamp the LOD instead.
+		samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+		samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+		samplerInfo.unnormalizedCoordinates = VK_FALSE;
+		const VkResult samplerResult = vkCreateSampler(context->GetDevice(), &samplerInfo, nullptr, &m_Sampler);
+		SN_CORE_ASSERT(samplerResult == VK_SUCCESS, "Failed to create Vulkan cooked texture sampler.");
+
+		VulkanImGuiTextureRegistry::RegisterTexture(m_RendererID, m_Sampler, m_ImageView, m_ImageLayout);
+		VulkanBindlessTextureTable::Register(m_RendererID, m_Sampler, m_ImageView);
+	}
+
+	void VulkanTexture2D::CreateCookedImage(const CookedTexture& cookedTexture, VkImage& outImage, VmaAllocation& outAllocation, VkImageView& outImageView) const
+	{
+		VulkanContext* context = VulkanContext::GetCurrent();
+		SN_CORE_ASSERT(context != nullptr, "Vulkan context is required for texture creation.");
+
+		const uint32_t mipLevels = static_cast<uint32_t>(cookedTexture.Levels.size());
+
+		// Only the resident part of the chain is allocated; Levels[0] becomes mip 0 of the image.
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.extent.width = cookedTexture.Levels[0].Width;
+		imageInfo.extent.height = cookedTexture.Levels[0].Height;
+		imageInfo.extent.depth = 1;
+		imageInfo.mipLevels = mipLevels;
+		imageInfo.arrayLayers = 1;
+		imageInfo.format = m_Format;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo allocationCreateInfo{};
+		allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+		const VkResult imageResult = vmaCreateImage(
+			context->GetAllocator(),
+			&imageInfo,
+			&allocationCreateInfo,
+			&outImage,
+			&outAllocation,
+			nullptr);
+		SN_CORE_ASSERT(imageResult == VK_SUCCESS, "Failed to create Vulkan cooked texture image.");
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = outImage;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = m_Format;
+		viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		viewInfo.subresourceRange.baseMipLevel = 0;
+		viewInfo.subresourceRange.levelCount = mipLevels;
+		viewInfo.subresourceRange.baseArrayLayer = 0;
+		viewInfo.subresourceRange.layerCount = 1;
+		const VkResult viewResult = vkCreateImageView(context->GetDevice(), &viewInfo, nullptr, &outImageView);
+		SN_CORE_ASSERT(viewResult == VK_SUCCESS, "Failed to create Vulkan cooked texture image view.");
+
+		TransitionImageLayout(
+			context,
+			outImage,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_IMAGE_LAYOUT_UNDEFINED,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			0,
+			mipLevels);
+
+		// Every level is precomputed by the cooker, so no blit chain is needed here.
+		UploadCookedLevels(context, outImage, cookedTexture);
+
+		TransitionImageLayout(
+			context,
+			outImage,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			0,
+			mipLevels);
+	}
+
+	bool VulkanTexture2D::UpdateResidentLevels(const CookedTexture& levels)
+	{
+		if (!m_Streamable || !levels.IsValid())
+			return false;
+
+		if (levels.Width != m_Width || levels.Height != m_Height || levels.GetLevelCount() != m_TotalMipLevels ||
+			PickCookedTextureFormat(levels.Compression, levels.SRGB) != m_Format)
+		{
+			SN_CORE_WARN("Streamed mips for '{}' do not match the resident texture.", m_Path);
+			return false;
+		}
+
+		if (levels.FirstLevel == m_FirstResidentLevel)
+			return true;
+
+		VulkanContext* context = VulkanContext::GetCurrent();
+		SN_CORE_ASSERT(context != nullptr, "Vulkan context is required for texture streaming.");
+
+		VkImage image = VK_NULL_HANDLE;
+		VmaAllocation allocation = nullptr;
+		VkImageView imageView = VK_NULL_HANDLE;
+		CreateCookedImage(levels, image, allocation, imageView);
+
+		// Frames still in flight may sample the previous image, so it is released once they retire.
+		context->DeferRelease([device = context->GetDevice(), allocator = context->GetAllocator(),
+			oldImage = m_Image, oldAllocation = m_Allocation, oldImageView = m_ImageView]()
+			{
+				vkDestroyImageView(device, oldImageView, nullptr);
+				vmaDestroyImage(allocator, oldImage, oldAllocation);
+			});
+
+		m_Image = image;
+		m_Allocation = allocation;
+		m_GpuMemory.Set(context->GetAllocationSize(m_Allocation));
+		m_ImageView = imageView;
+		m_ImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		m_MipLevels = static_cast<uint32_t>(levels.Levels.size());
+		m_FirstResidentLevel = levels.FirstLevel;
+		m_SizeInBytes = levels.GetSizeInBytes();
+
+		// Same renderer ID, new view: descriptors are rebuilt from the registry on the next bind, and
+		// the bindless table moves the texture to a fresh slot.
+		VulkanImGuiTextureRegistry::RegisterTexture(m_RendererID, m_Sampler, m_ImageView, m_ImageLayout);
+		VulkanBindlessTextureTable::Register(m_RendererID, m_Sampler, m_ImageView);
+		return true;
 	}
 
 	void VulkanTexture2D::DestroyTextureResources()
 	{
 		VulkanImGuiTextureRegistry::UnregisterTexture(m_RendererID);
+		VulkanBindlessTextureTable::Unregister(m_RendererID);
 
 		VulkanContext* context = VulkanContext::GetCurrent();
 		if (context == nullptr)
@@ -660,10 +941,12 @@ namespace Syndra {
 			vmaDestroyImage(context->GetAllocator(), m_Image, m_Allocation);
 			m_Image = VK_NULL_HANDLE;
 			m_Allocation = nullptr;
+			m_GpuMemory.Reset();
 		}
 
 		m_ImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 		m_MipLevels = 1;
+		m_FirstResidentLevel = 0;
 	}
 
 	void VulkanTexture2D::TransitionLayout(VkImageLayout newLayout)
@@ -774,6 +1057,7 @@ namespace Syndra {
 			&m_Allocation,
 			nullptr);
 		SN_CORE_ASSERT(imageResult == VK_SUCCESS, "Failed to create Vulkan 1D texture image.");
+		m_GpuMemory.Set(context->GetAllocationSize(m_Allocation));
 
 		VkImageViewCreateInfo viewInfo{};
 		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -847,6 +1131,7 @@ namespace Syndra {
 			vmaDestroyImage(context->GetAllocator(), m_Image, m_Allocation);
 			m_Image = VK_NULL_HANDLE;
 			m_Allocation = nullptr;
+			m_GpuMemory.Reset();
 		}
 
 		m_ImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
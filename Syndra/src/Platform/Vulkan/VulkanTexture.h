@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Engine/Core/MemoryTracker.h"
 #include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/TextureCooker.h"
 
 #include <volk.h>
 
@@ -16,6 +18,7 @@ namespace Syndra {
 		VulkanTexture2D(uint32_t width, uint32_t height);
 		VulkanTexture2D(const std::string& path, bool sRGB, bool HDR);
 		VulkanTexture2D(uint32_t width, uint32_t height, const unsigned char* data, bool sRGB);
+		VulkanTexture2D(const std::string& path, const CookedTexture& cookedTexture);
 		~VulkanTexture2D() override;
 
 		uint32_t GetWidth() const override { return m_Width; }
@@ -26,6 +29,11 @@ namespace Syndra {
 		bool operator==(const Texture& other) const override;
 		void Bind(uint32_t slot = 0) const override;
 		std::string GetPath() const override { return m_Path; }
+		uint64_t GetSizeInBytes() const override { return m_SizeInBytes; }
+
+		uint32_t GetMipLevelCount() const override { return m_TotalMipLevels; }
+		uint32_t GetFirstResidentLevel() const override { return m_FirstResidentLevel; }
+		bool UpdateResidentLevels(const CookedTexture& levels) override;
 
 		VkImageView GetImageView() const { return m_ImageView; }
 		VkSampler GetSampler() const { return m_Sampler; }
@@ -34,9 +42,12 @@ namespace Syndra {
 		static void BindTexture(uint32_t rendererID, uint32_t slot);
 		static uint32_t GetBoundTexture(uint32_t slot);
 		static void ResetBoundTextures();
+		static bool SupportsBlockCompression();
 
 	private:
 		void CreateTextureResources(VkFormat format, const void* initialData, uint32_t dataSize);
+		void CreateCookedTextureResources(const CookedTexture& cookedTexture);
+		void CreateCookedImage(const CookedTexture& cookedTexture, VkImage& outImage, VmaAllocation& outAllocation, VkImageView& outImageView) const;
 		void DestroyTextureResources();
 		void TransitionLayout(VkImageLayout newLayout);
 
@@ -45,11 +56,17 @@ namespace Syndra {
 		uint32_t m_Width = 0;
 		uint32_t m_Height = 0;
 		uint32_t m_MipLevels = 1;
+		uint32_t m_TotalMipLevels = 1;
+		uint32_t m_FirstResidentLevel = 0;
 		uint32_t m_RendererID = 0;
+		bool m_Compressed = false;
+		bool m_Streamable = false;
+		uint64_t m_SizeInBytes = 0;
 
 		VkFormat m_Format = VK_FORMAT_UNDEFINED;
 		VkImage m_Image = VK_NULL_HANDLE;
 		VmaAllocation m_Allocation = nullptr;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::Textures };
 		VkImageView m_ImageView = VK_NULL_HANDLE;
 		VkSampler m_Sampler = VK_NULL_HANDLE;
 		VkImageLayout m_ImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -89,6 +106,7 @@ namespace Syndra {
 
 		VkImage m_Image = VK_NULL_HANDLE;
 		VmaAllocation m_Allocation = nullptr;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::Textures };
 		VkImageView m_ImageView = VK_NULL_HANDLE;
 		VkSampler m_Sampler = VK_NULL_HANDLE;
 		VkImageLayout m_ImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -0,0 +1,187 @@
+#include "lpch.h"
+
+#include "Platform/Vulkan/VulkanUniformAllocator.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanDrawPacket.h"
+#include "vk_mem_alloc.h"
+
+#include <algorithm>
+
+namespace Syndra {
+
+	namespace {
+
+		constexpr VkDeviceSize kInitialRegionSize = 256 * 1024;
+
+		VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		bool CreateMappedUniformBuffer(VmaAllocator allocator, VkDeviceSize size, VkBuffer& outBuffer, VmaAllocation& outAllocation, uint8_t*& outMappedData)
+		{
+			VkBufferCreateInfo bufferInfo{};
+			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferInfo.size = size;
+			bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+			bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+			VmaAllocationCreateInfo allocationCreateInfo{};
+			allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+			allocationCreateInfo.flags =
+				VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+				VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+			VmaAllocationInfo allocationInfo{};
+			if (vmaCreateBuffer(allocator, &bufferInfo, &allocationCreateInfo, &outBuffer, &outAllocation, &allocationInfo) != VK_SUCCESS)
+			{
+				outBuffer = VK_NULL_HANDLE;
+				outAllocation = nullptr;
+				return false;
+			}
+
+			outMappedData = static_cast<uint8_t*>(allocationInfo.pMappedData);
+			if (outMappedData == nullptr)
+			{
+				vmaDestroyBuffer(allocator, outBuffer, outAllocation);
+				outBuffer = VK_NULL_HANDLE;
+				outAllocation = nullptr;
+				return false;
+			}
+
+			return true;
+		}
+
+	}
+
+	VulkanUniformAllocator::~VulkanUniformAllocator()
+	{
+		SN_CORE_ASSERT(m_Buffer == VK_NULL_HANDLE, "VulkanUniformAllocator destroyed without Destroy().");
+	}
+
+	bool VulkanUniformAllocator::Upload(VulkanContext* context, const void* data, VkDeviceSize size, Slice& outSlice)
+	{
+		if (context == nullptr || data == nullptr || size == 0)
+			return false;
+
+		if (context->GetActiveFrameCommandBuffer() == VK_NULL_HANDLE)
+			return UploadDedicated(context, data, size, outSlice);
+
+		if (m_Alignment == 0)
+		{
+			VkPhysicalDeviceProperties properties{};
+			vkGetPhysicalDeviceProperties(context->GetPhysicalDevice(), &properties);
+			m_Alignment = std::max<VkDeviceSize>({
+				properties.limits.minUniformBufferOffsetAlignment,
+				properties.limits.nonCoherentAtomSize,
+				16 });
+		}
+
+		const uint64_t frameSerial = context->GetFrameNumber();
+		if (m_FrameSerial != frameSerial)
+		{
+			m_FrameSerial = frameSerial;
+			m_FrameIndex = context->GetCurrentFrameIndex();
+			if (m_FrameIndex < m_RegionHeads.size())
+				m_RegionHeads[m_FrameIndex] = 0;
+		}
+
+		const VkDeviceSize alignedSize = AlignUp(size, m_Alignment);
+		const bool fits = m_Buffer != VK_NULL_HANDLE &&
+			m_RegionHeads.size() == context->GetFramesInFlight() &&
+			m_RegionHeads[m_FrameIndex] + alignedSize <= m_RegionSize;
+		if (!fits && !Grow(context, std::max(m_RegionSize * 2, alignedSize)))
+			return false;
+
+		const VkDeviceSize offset = m_FrameIndex * m_RegionSize + m_RegionHeads[m_FrameIndex];
+		m_RegionHeads[m_FrameIndex] += alignedSize;
+
+		memcpy(m_MappedData + offset, data, static_cast<size_t>(size));
+		vmaFlushAllocation(context->GetAllocator(), m_Allocation, offset, alignedSize);
+
+		outSlice.Buffer = m_Buffer;
+		outSlice.Offset = offset;
+		outSlice.Size = size;
+		return true;
+	}
+
+	bool VulkanUniformAllocator::Grow(VulkanContext* context, VkDeviceSize minRegionSize)
+	{
+		const VkDeviceSize regionSize = AlignUp(std::max(minRegionSize, kInitialRegionSize), m_Alignment);
+		const uint32_t framesInFlight = context->GetFramesInFlight();
+
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VmaAllocation allocation = nullptr;
+		uint8_t* mappedData = nullptr;
+		if (!CreateMappedUniformBuffer(context->GetAllocator(), regionSize * framesInFlight, buffer, allocation, mappedData))
+		{
+			SN_CORE_ERROR("Failed to allocate a {} KiB Vulkan uniform ring buffer.", (regionSize * framesInFlight) / 1024);
+			return false;
+		}
+
+		// Slices already handed out keep pointing at the old buffer until their frames complete.
+		if (m_Buffer != VK_NULL_HANDLE)
+		{
+			context->DeferRelease([allocator = context->GetAllocator(), oldBuffer = m_Buffer, oldAllocation = m_Allocation]()
+			{
+				vmaDestroyBuffer(allocator, oldBuffer, oldAllocation);
+			});
+			SN_CORE_TRACE("Vulkan uniform ring buffer grown to {} KiB per frame.", regionSize / 1024);
+		}
+
+		m_Buffer = buffer;
+		m_Allocation = allocation;
+		m_GpuMemory.Set(context->GetAllocationSize(allocation));
+		m_MappedData = mappedData;
+		m_RegionSize = regionSize;
+		m_RegionHeads.assign(framesInFlight, 0);
+		m_FrameIndex = std::min(m_FrameIndex, framesInFlight - 1);
+		++m_Epoch;
+
+		// Retained descriptor sets reference the buffer itself.
+		VulkanDrawPacket::InvalidateAll();
+		return true;
+	}
+
+	bool VulkanUniformAllocator::UploadDedicated(VulkanContext* context, const void* data, VkDeviceSize size, Slice& outSlice)
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VmaAllocation allocation = nullptr;
+		uint8_t* mappedData = nullptr;
+		if (!CreateMappedUniformBuffer(context->GetAllocator(), size, buffer, allocation, mappedData))
+			return false;
+
+		memcpy(mappedData, data, static_cast<size_t>(size));
+		vmaFlushAllocation(context->GetAllocator(), allocation, 0, VK_WHOLE_SIZE);
+		context->DeferRelease([allocator = context->GetAllocator(), buffer, allocation]()
+		{
+			vmaDestroyBuffer(allocator, buffer, allocation);
+		});
+
+		outSlice.Buffer = buffer;
+		outSlice.Offset = 0;
+		outSlice.Size = size;
+		return true;
+	}
+
+	VkDeviceSize VulkanUniformAllocator::GetFrameUsage() const
+	{
+		return (m_FrameIndex < m_RegionHeads.size()) ? m_RegionHeads[m_FrameIndex] : 0;
+	}
+
+	void VulkanUniformAllocator::Destroy(VulkanContext* context)
+	{
+		if (m_Buffer != VK_NULL_HANDLE && context != nullptr && context->GetAllocator() != nullptr)
+			vmaDestroyBuffer(context->GetAllocator(), m_Buffer, m_Allocation);
+
+		m_Buffer = VK_NULL_HANDLE;
+		m_Allocation = nullptr;
+		m_GpuMemory.Reset();
+		m_MappedData = nullptr;
+		m_RegionSize = 0;
+		m_RegionHeads.clear();
+		m_FrameSerial = UINT64_MAX;
+	}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Engine/Core/MemoryTracker.h"
+
+#include <volk.h>
+
+#include <cstdint>
+#include <vector>
+
+struct VmaAllocation_T;
+
+namespace Syndra {
+
+	using VmaAllocation = VmaAllocation_T*;
+
+	class VulkanContext;
+
+	// Linear allocator for shader constants. One persistently mapped buffer is split into a region
+	// per frame in flight; a region is rewound the first time it is used in a frame, after that
+	// frame's fence has been waited on, so a slice never aliases constants the GPU may still read.
+	// Slices are bound as dynamic uniform buffers: descriptor sets only see the buffer, the slice
+	// offset is supplied when the sets are bound.
+	class VulkanUniformAllocator
+	{
+	public:
+		struct Slice
+		{
+			VkBuffer Buffer = VK_NULL_HANDLE;
+			VkDeviceSize Offset = 0;
+			VkDeviceSize Size = 0;
+		};
+
+		VulkanUniformAllocator() = default;
+		~VulkanUniformAllocator();
+
+		VulkanUniformAllocator(const VulkanUniformAllocator&) = delete;
+		VulkanUniformAllocator& operator=(const VulkanUniformAllocator&) = delete;
+
+		// Copies 'size' bytes into a fresh slice. Outside a frame the slice gets a buffer of its own,
+		// released once the GPU is done with it.
+		bool Upload(VulkanContext* context, const void* data, VkDeviceSize size, Slice& outSlice);
+		void Destroy(VulkanContext* context);
+
+		// Changes whenever the ring buffer is replaced; slices from an older epoch must be re-uploaded.
+		uint64_t GetEpoch() const { return m_Epoch; }
+		VkDeviceSize GetCapacity() const { return m_RegionSize * m_RegionHeads.size(); }
+		// Bytes handed out in the current frame.
+		VkDeviceSize GetFrameUsage() const;
+
+	private:
+		bool Grow(VulkanContext* context, VkDeviceSize minRegionSize);
+		bool UploadDedicated(VulkanContext* context, const void* data, VkDeviceSize size, Slice& outSlice);
+
+	private:
+		VkBuffer m_Buffer = VK_NULL_HANDLE;
+		VmaAllocation m_Allocation = nullptr;
+		TrackedMemory m_GpuMemory{ MemoryDomain::Gpu, MemoryCategory::UniformBuffers };
+		uint8_t* m_MappedData = nullptr;
+		VkDeviceSize m_RegionSize = 0;
+		VkDeviceSize m_Alignment = 0;
+		std::vector<VkDeviceSize> m_RegionHeads;
+		uint32_t m_FrameIndex = 0;
+		uint64_t m_FrameSerial = UINT64_MAX;
+		uint64_t m_Epoch = 0;
+	};
+
+}
@@ -1,15 +1,20 @@
 #pragma once
 
 #include "Engine/Renderer/UniformBuffer.h"
+#include "Platform/Vulkan/VulkanUniformAllocator.h"
 
 #include <volk.h>
 
-struct VmaAllocation_T;
+#include <vector>
 
 namespace Syndra {
 
-	using VmaAllocation = VmaAllocation_T*;
+	class VulkanContext;
 
+	// Owns no GPU memory: SetData() only updates a CPU copy, and each draw that reads the buffer
+	// binds a slice of the per-frame uniform ring holding the contents it saw. Updating the buffer
+	// between draws therefore gives every draw its own constants, and destroying it never races the
+	// frames still in flight.
 	class VulkanUniformBuffer : public UniformBuffer
 	{
 	public:
@@ -18,17 +23,22 @@ namespace Syndra {
 
 		void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
 
-		VkBuffer GetBuffer() const { return m_Buffer; }
+		// Slice holding the current contents, uploaded on first use after a change or in a new frame.
+		bool ResolveSlice(VulkanContext* context, VulkanUniformAllocator& allocator, VulkanUniformAllocator::Slice& outSlice);
+
 		uint32_t GetBinding() const { return m_Binding; }
 		uint32_t GetSize() const { return m_Size; }
 		static VulkanUniformBuffer* GetUniformBufferForBinding(uint32_t binding);
 
 	private:
-		VkBuffer m_Buffer = VK_NULL_HANDLE;
-		VmaAllocation m_Allocation = nullptr;
-		void* m_MappedData = nullptr;
+		std::vector<uint8_t> m_Data;
 		uint32_t m_Size = 0;
 		uint32_t m_Binding = 0;
+
+		VulkanUniformAllocator::Slice m_Slice;
+		uint64_t m_SliceFrame = UINT64_MAX;
+		uint64_t m_SliceEpoch = 0;
+		bool m_Dirty = true;
 	};
 
 }
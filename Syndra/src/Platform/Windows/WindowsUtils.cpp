@@ -56,4 +56,18 @@ namespace Syndra {
 		return std::nullopt;
 	}
 
+	double ProcessInfo::GetCpuTime()
+	{
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+			return 0.0;
+
+		// FILETIME counts 100 ns intervals.
+		const auto seconds = [](const FILETIME& time)
+		{
+			return static_cast<double>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1e-7;
+		};
+		return seconds(kernelTime) + seconds(userTime);
+	}
+
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "Engine/Core/Instrument.h"
 
 #include "Engine/Renderer/RendererAPI.h"
+#include "Engine/Renderer/RenderThread.h"
 #include "Engine/Utils/AssetPath.h"
 #include "Platform/OpenGL/OpenGLContext.h"
 #include "Platform/Vulkan/VulkanContext.h"
@@ -227,6 +228,16 @@ namespace Syndra {
 		glfwPollEvents();
 	}
 
+	void WindowsWindow::WaitEvents(double timeoutSeconds)
+	{
+		glfwWaitEventsTimeout(timeoutSeconds);
+	}
+
+	void WindowsWindow::PostEmptyEvent()
+	{
+		glfwPostEmptyEvent();
+	}
+
 	void WindowsWindow::BeginFrame()
 	{
 		if (m_Context)
@@ -242,9 +253,22 @@ namespace Syndra {
 		}
 	}
 
+	void WindowsWindow::MakeContextCurrent()
+	{
+		if (m_Context)
+			m_Context->MakeCurrent();
+	}
+
+	void WindowsWindow::ReleaseContext()
+	{
+		if (m_Context)
+			m_Context->ReleaseCurrent();
+	}
+
 	void WindowsWindow::SetVSync(bool enabled)
 	{
 		//SN_PROFILE_FUNCTION();
+		RenderThread::Synchronize();
 		if (m_Context)
 			m_Context->SetVSync(enabled);
 
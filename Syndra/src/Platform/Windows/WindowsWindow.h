@@ -15,8 +15,12 @@ namespace Syndra{
 		virtual ~WindowsWindow();
 
 		void OnUpdate() override;
+		void WaitEvents(double timeoutSeconds) override;
+		void PostEmptyEvent() override;
 		void BeginFrame() override;
 		void EndFrame() override;
+		void MakeContextCurrent() override;
+		void ReleaseContext() override;
 
 		unsigned int GetWidth() const override { return m_Data.Width; }
 		unsigned int GetHeight() const override { return m_Data.Height; }
@@ -22,7 +22,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <stdint.h>
-#include "Engine/Core/core.h"
+#include "Engine/Core/Core.h"
 
 #include "Engine/Core/Log.h"
 
@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+# Runs Syndra-Bench on the CPU drivers (lavapipe for Vulkan, llvmpipe for OpenGL) so results
+# are comparable between CI runs on machines without a GPU. 'null' needs no driver at all and
+# measures the engine's CPU side only.
+#
+# Usage: scripts/run_bench.sh [vulkan|opengl|null] [extra Syndra-Bench arguments...]
+#
+# SYNDRA_BENCH_WORKERS="1 2 4 8" runs once per job system worker count (--workers) and writes
+# one report per run next to the default one, suffixed with -workers<n>.
+# Pass --parallel-recording=off to record every Vulkan batch on the main thread instead; a
+# run with it and one without show what parallel recording saves in the reports' recordMs.
+set -euo pipefail
+
+RENDERER="${1:-vulkan}"
+shift || true
+
+REPO_ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+CONFIGURATION="${SYNDRA_BENCH_CONFIGURATION:-release}"
+BENCH="${REPO_ROOT}/bin/${CONFIGURATION}-linux-x86_64/Syndra-Bench/Syndra-Bench"
+OUTPUT="${SYNDRA_BENCH_OUTPUT:-${REPO_ROOT}/bench-${RENDERER}.json}"
+
+if [[ ! -x "${BENCH}" ]]; then
+	echo "Syndra-Bench not found at ${BENCH}; build the Syndra-Bench target first." >&2
+	exit 1
+fi
+
+if [[ "${RENDERER}" == "vulkan" ]]; then
+	# Pick lavapipe even when a hardware ICD is installed.
+	for icd in /usr/share/vulkan/icd.d/lvp_icd*.json; do
+		if [[ -f "${icd}" ]]; then
+			export VK_DRIVER_FILES="${icd}"
+			export VK_ICD_FILENAMES="${icd}"
+			break
+		fi
+	done
+elif [[ "${RENDERER}" == "opengl" ]]; then
+	export LIBGL_ALWAYS_SOFTWARE=1
+	export GALLIUM_DRIVER=llvmpipe
+fi
+
+cd "${REPO_ROOT}/Syndra-Editor"
+if [[ -z "${SYNDRA_BENCH_WORKERS:-}" ]]; then
+	exec "${BENCH}" --renderer="${RENDERER}" --output="${OUTPUT}" "$@"
+fi
+
+for workers in ${SYNDRA_BENCH_WORKERS}; do
+	"${BENCH}" --renderer="${RENDERER}" --workers="${workers}" --output="${OUTPUT%.json}-workers${workers}.json" "$@"
+done